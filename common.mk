@@ -52,4 +52,20 @@ TOOLCHAIN=GCC_ARM
 # for your IDE.
 CONFIG=Debug
 
+# IPC latency instrumentation (see README.md). It changes the message layout,
+# so it is set here for all cores. 0 compiles it out completely.
+IPC_STATS?=0
+DEFINES+=IPC_STATS_ENABLE=$(IPC_STATS)
+
+# IPC event trace (see README.md). The message layout is the same either way;
+# 0 compiles the hooks out.
+IPC_TRACE?=0
+DEFINES+=IPC_TRACE_ENABLE=$(IPC_TRACE)
+
+# Message CRC and sequence gap detection (see ipc_msg.h). The wire format is
+# the same either way; 0 compiles the checks out.
+IPC_MSG_CRC?=0
+IPC_MSG_SEQ?=0
+DEFINES+=IPC_MSG_CRC_ENABLE=$(IPC_MSG_CRC) IPC_MSG_SEQ_ENABLE=$(IPC_MSG_SEQ)
+
 include ../common_app.mk
@@ -0,0 +1,332 @@
+/******************************************************************************
+* File Name:   bench.h
+*
+* Description: Configuration and results shared by the benchmark driver
+*              and the benchmark core images.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include "cy_pdl.h"
+#include "ipc_topology.h"
+#include "ipc_ring.h"
+#include "ipc_credit.h"
+#include "ipc_stats.h"
+#include "ipc_msg.h"
+#include "ipc_adapt.h"
+#include "ipc_pubsub.h"
+#include "ipc_seqlock.h"
+#include "ipc_stream.h"
+#include "ipc_handoff.h"
+#include "ipc_work.h"
+#include "ipc_rpc.h"
+#include "ipc_consumer.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+#define BENCH_MAX_MSG_SIZE              (1024UL)        /* Largest payload in bytes */
+#define BENCH_MAX_PRODUCERS             (2UL)           /* CM7_0 and CM7_1 */
+#define BENCH_RING_DEPTH                (32UL)          /* Ring of each producer in queued mode */
+#define BENCH_WORK_DEPTH                (8UL)           /* Deferred consumer: work queue depth */
+#define BENCH_DRAIN_BUDGET              (4UL)           /* Messages taken from one producer ring before the next, as CM0_DRAIN_BUDGET */
+#define BENCH_BACKLOG_DEPTH             (16UL)          /* Producer backlog of CY_IPC_CREDIT_POLICY_QUEUE */
+
+/* Clients of the consumer endpoints, the packet type is the producer index */
+#define BENCH_CLIENT_MSG                (0UL)           /* Message with payload */
+#define BENCH_CLIENT_DOORBELL           (1UL)           /* Ring doorbell */
+#define BENCH_CLIENT_CNT                (2UL)
+
+/* Control lane probe: CM7_0 pings the control endpoint every SysTick */
+#define BENCH_CLIENT_CTL                (0UL)           /* Ping on the control endpoint */
+#define BENCH_CTL_CLIENT_CNT            (1UL)
+#define BENCH_CTL_PERIOD_US             (1000UL)        /* SysTick period of CM7_0 */
+
+/* Adaptive consumer, in Cy_IPC_Stats_Clock() ticks (ns on the host) */
+#define BENCH_POLL_WINDOW               (1000000UL)     /* 1 ms rate window */
+#define BENCH_POLL_ENTER_RATE           (20UL)          /* Polls from 20k msgs/s */
+#define BENCH_POLL_EXIT_RATE            (10UL)          /* Back to interrupts below 10k msgs/s */
+#define BENCH_POLL_BUDGET               (2000UL)        /* Empty polls in a row that end polling */
+
+/* Fan-out: CM7_1 publishes, subscriber n receives on endpoint 0, 1, 3, 4 */
+#define BENCH_MAX_SUBSCRIBERS           (4UL)
+#define BENCH_TOPIC_DEPTH               (8UL)           /* Publications in flight, must be a power of two */
+#define BENCH_FANOUT_CLIENT_MSG         (0UL)           /* Unicast copy, pktType is the subscriber */
+#define BENCH_FANOUT_CLIENT_TOPIC       (1UL)           /* Topic to subscribe to */
+#define BENCH_FANOUT_CLIENT_CNT         (2UL)
+
+/* Seqlock stress: CM7_1 writes, reader 0 is CM0+ polling, reader 1 is CM7_0
+ * on the doorbell, reader 2 is the SysTick of CM7_1, which interrupts the
+ * writer on its own core */
+#define BENCH_SEQLOCK_READERS           (3UL)
+#define BENCH_SEQLOCK_CLIENT_STATE      (0UL)           /* State region to read */
+#define BENCH_SEQLOCK_TICK_US           (100UL)         /* SysTick period of CM7_1 */
+
+/* Stream: CM7_0 commits a sample block every block period, CM0+ consumes */
+#define BENCH_STREAM_CLIENT             (0UL)           /* Stream to consume */
+
+/* Handoff: CM7_0 hands messages to CM7_1 out of a pool, cached or not */
+#define BENCH_HANDOFF_CLIENT_MSG        (0UL)           /* Message out of the pool */
+#define BENCH_HANDOFF_CLIENT_POOL       (1UL)           /* Pool to set up first */
+#define BENCH_HANDOFF_CLIENT_CNT        (2UL)
+#define BENCH_HANDOFF_POOL_SIZE         (2048UL)        /* Power of two, holds the largest message */
+
+/* Offload: CM0+ submits jobs to CM7_0 and CM7_1, which send back completions */
+#define BENCH_OFFLOAD_CLIENT_QUEUE      (0UL)           /* Queue to work on, on the worker endpoint */
+#define BENCH_OFFLOAD_CLIENT_DONE       (0UL)           /* Completion, on the CM0+ endpoint */
+#define BENCH_OFFLOAD_WINDOW            (32UL)          /* Jobs in flight, at most 32 */
+#define BENCH_OFFLOAD_POOL_SIZE         (4096UL)        /* Non-cacheable pool of the queue, power of two */
+
+/* RPC: CM7_0 calls CM0+ on the control endpoints, a doorbell each way */
+#define BENCH_RPC_CLIENT_REQUEST        (0UL)           /* Requests queued, on the CM0+ control endpoint */
+#define BENCH_RPC_CLIENT_RESPONSE       (0UL)           /* Responses queued, on the CM7_0 control endpoint */
+
+/* Replay: sends per producer taken from an ipc_trace capture */
+#define BENCH_REPLAY_MAX_SENDS          (2048UL)
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef enum
+{
+    BENCH_MODE_BLOCKING,        /* Every message through the pipe, wait for its release */
+    BENCH_MODE_QUEUED,          /* Messages through a ring, the pipe only rings the doorbell */
+    BENCH_MODE_UNICAST,         /* Fan-out: a copy through the pipe to each subscriber, wait for each release */
+    BENCH_MODE_PUBSUB,          /* Fan-out: published once on a topic, one notify for all subscribers */
+    BENCH_MODE_SEQLOCK,         /* Shared state: CM7_1 updates a seqlock snapshot of msgSize bytes, the others read it */
+    BENCH_MODE_REPLAY,          /* As blocking, at the times and sizes of the sends in benchReplay */
+    BENCH_MODE_STREAM,          /* CM7_0 streams blocks of msgSize bytes at rate bytes/s to CM0+ */
+    BENCH_MODE_HANDOFF,         /* As blocking from CM7_0 to CM7_1, with the cache maintenance of handoff */
+    BENCH_MODE_OFFLOAD,         /* CM0+ submits jobs of work ns to the CM7 workers, which steal from each other */
+    BENCH_MODE_RPC,             /* CM7_0 keeps batch calls in flight to CM0+, answered out of order */
+} cy_en_bench_mode_t;
+
+typedef enum
+{
+    BENCH_RX_ISR,               /* Consumer handles messages in the pipe ISR */
+    BENCH_RX_DEFERRED,          /* Consumer ISR only queues the work, its main loop does it */
+    BENCH_RX_ADAPTIVE,          /* Consumer polls from its main loop while the rate is high, like CM0_ADAPTIVE_POLL */
+    BENCH_RX_PACED,             /* Stream mode: consumer takes a block every work ns on its own clock */
+} cy_en_bench_rx_t;
+
+typedef struct
+{
+    cy_en_bench_mode_t mode;
+    uint32_t producers;         /* 1 or 2 */
+    uint32_t msgSize;           /* Payload bytes per message */
+    uint32_t batch;             /* Queued mode: messages per doorbell; RPC mode: calls in flight */
+    uint32_t rate;              /* Queued mode: msgs/s per producer, 0 for as fast as the ring takes them;
+                                 * stream mode: bytes/s */
+    cy_en_bench_rx_t rx;
+    bool control;               /* CM7_0 pings the control lane */
+    cy_en_ipc_credit_policy_t policy; /* Queued mode: send without credit */
+    uint32_t window;            /* Queued mode: credits granted by the consumer, at most BENCH_RING_DEPTH */
+    uint32_t work;              /* Consumer busy time per message in ns, 0 for none */
+    uint32_t subscribers;       /* Fan-out modes: 1 .. BENCH_MAX_SUBSCRIBERS, 0 for the producer/consumer modes */
+    uint32_t buffers;           /* Stream mode: block buffers, 2 .. CY_IPC_STREAM_MAX_BUFFERS */
+    cy_en_ipc_handoff_mode_t handoff; /* Handoff mode: pool strategy of both cores */
+    uint32_t workers;           /* Offload mode: 1 for CM7_0, 2 for CM7_0 and CM7_1 */
+    bool pinned;                /* Offload mode: every job goes to CM7_0, CM7_1 only steals */
+    atomic_bool recording;      /* Consumer counts messages while set */
+} cy_stc_bench_config_t;
+
+/* Fan-out mode, written by one subscriber only */
+typedef struct
+{
+    volatile uint32_t delivered;    /* Publications received while recording */
+    volatile uint32_t errors;       /* Lost, duplicate or corrupt publications */
+    cy_stc_ipc_stats_t latency;     /* Stage NOTIFY: publish to subscriber, ns */
+} cy_stc_bench_sub_result_t;
+
+/* Seqlock stress, written by one reader only */
+typedef struct
+{
+    volatile uint32_t reads;        /* Consistent snapshots while recording */
+    volatile uint32_t retries;      /* Copies torn by an update, detected and retried */
+    volatile uint32_t busy;         /* Reads given up after CY_IPC_SEQLOCK_MAX_RETRIES torn copies */
+    volatile uint32_t torn;         /* CM0+: plain copies without the seqlock that mixed two updates */
+    volatile uint32_t errors;       /* Snapshots accepted although torn, or older than the one before */
+} cy_stc_bench_reader_result_t;
+
+/* Written by the consumer only, fan-out and seqlock results by the core of each role */
+typedef struct
+{
+    volatile uint32_t messages;
+    volatile uint64_t bytes;
+    volatile uint32_t errors;   /* Lost, duplicate or corrupt messages, rejected by Cy_IPC_Msg_Check(), or beyond the credit */
+    cy_stc_ipc_stats_t latency; /* Stage NOTIFY: send to consumer, stage RELEASE: channel hold, ns */
+    cy_stc_ipc_stats_t control; /* Stage NOTIFY: control ping send to consumer, ns */
+    cy_stc_ipc_adapt_t adapt;   /* Adaptive consumer: mode and time spent in each */
+    cy_stc_ipc_consumer_producer_t producer[BENCH_MAX_PRODUCERS]; /* Queued mode: grants, and the stalls and drops of each producer */
+    cy_stc_ipc_stats_t publish;     /* Fan-out modes, stage SEND: publisher time per publication, ns */
+    volatile uint32_t pubStalls;    /* Pub/sub mode: claims that found every slot referenced */
+    cy_stc_bench_sub_result_t subscriber[BENCH_MAX_SUBSCRIBERS];
+    volatile uint32_t updates;      /* Seqlock mode: snapshots written by CM7_1 while recording */
+    cy_stc_bench_reader_result_t reader[BENCH_SEQLOCK_READERS];
+    volatile uint32_t blocks;       /* Stream mode: blocks completed by CM7_0 while recording */
+    volatile uint32_t overruns;     /* Stream mode: blocks dropped by CM7_0 while recording */
+    volatile uint32_t underruns;    /* Stream mode: blocks due at CM0+ while none was ready */
+    volatile uint32_t lost;         /* Stream mode: blocks CM0+ found missing while recording */
+    cy_stc_ipc_stream_t *stream;    /* Stream mode: the stream, final once CM7_0 stopped after the recording */
+    volatile uint32_t ruleErrors;   /* Handoff mode: alignment and maintenance rules CM7_0 found broken */
+    volatile uint32_t jobs[BENCH_MAX_PRODUCERS]; /* Offload mode: completions of each worker while recording */
+    volatile uint32_t stolenJobs;   /* Offload mode: completed jobs a worker stole while recording */
+    cy_stc_ipc_work_t *work;        /* Offload mode: the queue, for its counters */
+} cy_stc_bench_result_t;
+
+/* Replay mode: one captured send */
+typedef struct
+{
+    uint32_t at;                /* ns from the start of the capture */
+    uint32_t size;              /* Payload bytes, at most BENCH_MAX_MSG_SIZE */
+} cy_stc_bench_replay_send_t;
+
+/* Replay mode: the sends of each producer, repeated every period */
+typedef struct
+{
+    uint32_t period;            /* ns */
+    uint32_t count[BENCH_MAX_PRODUCERS];
+    cy_stc_bench_replay_send_t send[BENCH_MAX_PRODUCERS][BENCH_REPLAY_MAX_SENDS];
+} cy_stc_bench_replay_t;
+
+/* Every message is in the format of ipc_msg.h, with the lock time in the
+ * gap before the payload: it changes on every send retry, so it must stay
+ * out of the CRC. The header pktType is the producer index. */
+typedef struct
+{
+    cy_stc_ipc_msg_hdr_t hdr;   /* length: sent, seq and the payload bytes */
+    uint32_t locked;            /* Cy_IPC_Stats_Clock() when the channel was locked */
+    IPC_STATS_STAMP_MEMBER      /* Not used, keeps the payload where ipc_msg.h expects it */
+    CY_ALIGN(CY_IPC_MSG_PAYLOAD_ALIGN) uint32_t sent; /* Cy_IPC_Stats_Clock() at send */
+    uint32_t seq;               /* Per producer, detects loss */
+    uint8_t payload[BENCH_MAX_MSG_SIZE];
+} cy_stc_bench_msg_t;
+
+typedef struct
+{
+    cy_stc_ipc_msg_hdr_t hdr;
+    uint32_t locked;
+    IPC_STATS_STAMP_MEMBER
+    CY_ALIGN(CY_IPC_MSG_PAYLOAD_ALIGN) cy_stc_ipc_ring_t *ring;
+    cy_stc_ipc_credit_t *credit;
+} cy_stc_bench_doorbell_t;
+
+/* Handoff mode: CM7_0 hands its pool to CM7_1, which maps it the same way */
+typedef struct
+{
+    cy_stc_ipc_msg_hdr_t hdr;
+    uint32_t locked;
+    IPC_STATS_STAMP_MEMBER
+    CY_ALIGN(CY_IPC_MSG_PAYLOAD_ALIGN) uint8_t *base;
+    uint32_t size;
+} cy_stc_bench_pool_t;
+
+/* Offload mode: a completion, sent by the worker that ran the job */
+typedef struct
+{
+    cy_stc_ipc_msg_hdr_t hdr;
+    uint32_t locked;
+    IPC_STATS_STAMP_MEMBER
+    CY_ALIGN(CY_IPC_MSG_PAYLOAD_ALIGN) cy_stc_ipc_work_done_t done;
+} cy_stc_bench_done_t;
+
+typedef struct
+{
+    cy_stc_ipc_msg_hdr_t hdr;   /* No payload */
+    uint32_t sent;              /* Cy_IPC_Stats_Clock() at send */
+} cy_stc_bench_ctl_t;
+
+IPC_PORT_STATIC_ASSERT(offsetof(cy_stc_bench_msg_t, sent) == CY_IPC_MSG_PAYLOAD_OFFSET, "Bench message payload offset");
+IPC_PORT_STATIC_ASSERT(offsetof(cy_stc_bench_doorbell_t, ring) == CY_IPC_MSG_PAYLOAD_OFFSET, "Bench doorbell payload offset");
+IPC_PORT_STATIC_ASSERT(offsetof(cy_stc_bench_pool_t, base) == CY_IPC_MSG_PAYLOAD_OFFSET, "Bench pool payload offset");
+IPC_PORT_STATIC_ASSERT(offsetof(cy_stc_bench_done_t, done) == CY_IPC_MSG_PAYLOAD_OFFSET, "Bench completion payload offset");
+
+/* Payload length of a message with size data bytes, and its bytes up to the end */
+#define BENCH_MSG_LENGTH(size)          (offsetof(cy_stc_bench_msg_t, payload) - CY_IPC_MSG_PAYLOAD_OFFSET + (size))
+#define BENCH_MSG_BYTES(size)           (offsetof(cy_stc_bench_msg_t, payload) + (size))
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+/* Fan-out roles, bench_fanout.c: CM7_1 publishes, CM0+ and CM7_0 subscribe */
+void Bench_Fanout_Publish(void);
+void Bench_Fanout_Subscribe(cy_en_ipc_core_t core);
+
+/* Seqlock stress roles, bench_seqlock.c: CM7_1 writes, every core reads */
+void Bench_Seqlock_Write(void);
+void Bench_Seqlock_Read(cy_en_ipc_core_t core);
+
+/* Streaming roles, bench_stream.c: CM7_0 produces, CM0+ consumes */
+void Bench_Stream_Produce(void);
+void Bench_Stream_Consume(void);
+void Bench_Stream_Wait(uint32_t due);
+
+/* Handoff roles, bench_handoff.c: CM7_0 sends, CM7_1 receives */
+void Bench_Handoff_Send(void);
+void Bench_Handoff_Receive(void);
+
+/* Offload roles, bench_offload.c: CM0+ submits, CM7_0 and CM7_1 work */
+void Bench_Offload_Submit(void);
+void Bench_Offload_Work(uint32_t index);
+
+/* RPC roles, bench_rpc.c: CM7_0 calls, CM0+ serves */
+void Bench_Rpc_Serve(void);
+void Bench_Rpc_Call(void);
+
+
+/*******************************************************************************
+* Global variables, owned by the driver
+*******************************************************************************/
+extern cy_stc_bench_config_t benchConfig;
+extern cy_stc_bench_result_t benchResult;
+extern cy_stc_bench_replay_t benchReplay;
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* BENCH_H */
+
+/* [] END OF FILE */
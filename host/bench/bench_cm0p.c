@@ -0,0 +1,652 @@
+/******************************************************************************
+* File Name:   bench_cm0p.c
+*
+* Description: Benchmark consumer image for CM0+. Receives the messages of
+*              one or two producers through the same dispatch path as the
+*              application and the same consumer, ipc_consumer.c, checks
+*              them and records their latency and how long they held the
+*              channel. In deferred mode the ISR only queues the work and
+*              the main loop consumes.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "cy_pdl.h"
+#include "bench.h"
+#include "ipc_dispatch.h"
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void Bench_Cm0_IpcIsr(void);
+void Bench_Cm0_EnableIrq(bool enable);
+void Bench_Cm0_Served(uint32_t ep);
+void Bench_Cm0_CtlIsr(void);
+void Bench_Cm0_CtlCallback(uint32_t *msgData);
+void Bench_Cm0_RecvMsgCallback(uint32_t *msgData);
+void Bench_Cm0_MsgHandler(uint32_t *msgData, void *context);
+void Bench_Cm0_DoorbellHandler(uint32_t *msgData, void *context);
+void Bench_Cm0_DeferMsgHandler(uint32_t *msgData, void *context);
+void Bench_Cm0_DeferDoorbellHandler(uint32_t *msgData, void *context);
+void Bench_Cm0_Attach(cy_stc_bench_doorbell_t const *doorbell);
+void Bench_Cm0_RingMsg(void *msg, uint32_t producer, uint32_t received);
+void Bench_Cm0_WorkItem(void *item);
+void Bench_Cm0_Consume(cy_stc_bench_msg_t const *msg, uint32_t producer);
+
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static cy_stc_ipc_dispatch_t benchDispatch;
+static uint32_t benchNextSeq[BENCH_MAX_PRODUCERS];
+static cy_stc_ipc_msg_rx_t benchRx[BENCH_MAX_PRODUCERS];
+static cy_stc_bench_msg_t benchPopped;      /* Ring element being consumed */
+static uint32_t benchLocked;                /* Lock time of the message in the channel */
+static bool benchHeld;                      /* The ISR took a message */
+
+/* Consumer endpoints, one per producer, served round-robin by the ISR */
+static const uint32_t benchConsumerEp[BENCH_MAX_PRODUCERS] =
+{
+    CY_IPC_EP_CYPIPE_CM0_ADDR,
+    CY_IPC_EP_CYPIPE_CM0_CM7_1_ADDR
+};
+
+/* Deferred consumer: messages copied by the ISR */
+static cy_stc_ipc_ring_t benchWork;
+static CY_ALIGN(IPC_PORT_CACHE_LINE) uint8_t benchWorkBuf[BENCH_WORK_DEPTH * BENCH_MSG_BYTES(BENCH_MAX_MSG_SIZE)];
+static cy_stc_bench_msg_t benchWorkItem;    /* Work item being consumed */
+
+/* The consumer of proj_cm0p/main.c; the work queue is set for deferred mode */
+static cy_stc_ipc_consumer_config_t benchConsumerConfig =
+{
+    benchConsumerEp,
+    benchResult.producer,
+    BENCH_MAX_PRODUCERS,
+    BENCH_DRAIN_BUDGET,
+    NULL,
+    BENCH_WORK_DEPTH,
+    &benchPopped,
+    &benchWorkItem,
+    &Bench_Cm0_RingMsg,
+    &Bench_Cm0_WorkItem,
+    &Bench_Cm0_EnableIrq,
+    &Bench_Cm0_Served,
+    NULL
+};
+static cy_stc_ipc_consumer_t benchConsumer;
+
+static const cy_stc_ipc_adapt_config_t benchAdaptConfig =
+{
+    BENCH_POLL_WINDOW,
+    BENCH_POLL_ENTER_RATE,
+    BENCH_POLL_EXIT_RATE,
+    BENCH_POLL_BUDGET
+};
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* Sets up the consumer endpoint, starts the producers and waits for
+* messages. In the fan-out modes it runs the subscribers of CM0+ instead,
+* in the seqlock mode its reader and in the stream mode its consumer. In
+* the handoff mode it only starts the CM7 cores, in the offload mode it
+* submits the jobs.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int
+*******************************************************************************/
+int main(void)
+{
+    uint32_t interruptState;
+    uint32_t i;
+    bool deferred = (BENCH_RX_DEFERRED == benchConfig.rx);
+    static cy_stc_ipc_pipe_ep_t IpcPipeEpArray[CY_IPC_MAX_ENDPOINTS];
+    static cy_ipc_pipe_callback_ptr_t ep0CbArray[BENCH_CLIENT_CNT];
+    static cy_ipc_pipe_callback_ptr_t ep3CbArray[BENCH_CTL_CLIENT_CNT];
+    static cy_ipc_pipe_callback_ptr_t ep5CbArray[BENCH_CLIENT_CNT];
+
+    static const cy_stc_ipc_pipe_config_t benchPipe0Config =
+    {
+        CY_IPC_CYPIPE_EP_CONFIG(0),
+        CY_IPC_CYPIPE_EP_CONFIG(1),
+        BENCH_CLIENT_CNT,
+        ep0CbArray,
+        &Bench_Cm0_IpcIsr
+    };
+
+    /* CM7_1 has its own consumer endpoint, same ISR */
+    static const cy_stc_ipc_pipe_config_t benchPipe1Config =
+    {
+        CY_IPC_CYPIPE_EP_CONFIG(5),
+        CY_IPC_CYPIPE_EP_CONFIG(2),
+        BENCH_CLIENT_CNT,
+        ep5CbArray,
+        &Bench_Cm0_IpcIsr
+    };
+
+    /* Control lane, preempts the drain in Bench_Cm0_IpcIsr() */
+    static const cy_stc_ipc_pipe_config_t benchPipe2Config =
+    {
+        CY_IPC_CYPIPE_EP_CONFIG(3),
+        CY_IPC_CYPIPE_EP_CONFIG(4),
+        BENCH_CTL_CLIENT_CNT,
+        ep3CbArray,
+        &Bench_Cm0_CtlIsr
+    };
+
+    /* Fan-out: CM0+ and CM7_0 subscribe, CM7_1 publishes */
+    if (0UL != benchConfig.subscribers)
+    {
+        Bench_Fanout_Subscribe(CY_IPC_CORE_CM0P);
+        Cy_SysEnableCM7(CORE_CM7_0, CY_CORTEX_M7_0_APPL_ADDR);
+        Cy_SysEnableCM7(CORE_CM7_1, CY_CORTEX_M7_1_APPL_ADDR);
+        for (;;)
+        {
+            __WFI();
+        }
+    }
+
+    /* Seqlock stress: CM7_1 writes, the others read */
+    if (BENCH_MODE_SEQLOCK == benchConfig.mode)
+    {
+        Cy_SysEnableCM7(CORE_CM7_0, CY_CORTEX_M7_0_APPL_ADDR);
+        Cy_SysEnableCM7(CORE_CM7_1, CY_CORTEX_M7_1_APPL_ADDR);
+        Bench_Seqlock_Read(CY_IPC_CORE_CM0P);
+    }
+
+    /* Stream: CM7_0 produces, CM0+ consumes */
+    if (BENCH_MODE_STREAM == benchConfig.mode)
+    {
+        Cy_SysEnableCM7(CORE_CM7_0, CY_CORTEX_M7_0_APPL_ADDR);
+        Bench_Stream_Consume();
+        for (;;)
+        {
+            __WFI();
+        }
+    }
+
+    /* Handoff: CM7_0 sends to CM7_1, CM0+ only boots them */
+    if (BENCH_MODE_HANDOFF == benchConfig.mode)
+    {
+        Cy_SysEnableCM7(CORE_CM7_0, CY_CORTEX_M7_0_APPL_ADDR);
+        Cy_SysEnableCM7(CORE_CM7_1, CY_CORTEX_M7_1_APPL_ADDR);
+        for (;;)
+        {
+            __WFI();
+        }
+    }
+
+    /* Offload: CM0+ submits, CM7_0 works, and CM7_1 with two workers */
+    if (BENCH_MODE_OFFLOAD == benchConfig.mode)
+    {
+        Cy_SysEnableCM7(CORE_CM7_0, CY_CORTEX_M7_0_APPL_ADDR);
+        if (benchConfig.workers > 1UL)
+        {
+            Cy_SysEnableCM7(CORE_CM7_1, CY_CORTEX_M7_1_APPL_ADDR);
+        }
+        Bench_Offload_Submit();
+        for (;;)
+        {
+            __WFI();
+        }
+    }
+
+    /* RPC: CM7_0 calls, CM0+ serves */
+    if (BENCH_MODE_RPC == benchConfig.mode)
+    {
+        Cy_SysEnableCM7(CORE_CM7_0, CY_CORTEX_M7_0_APPL_ADDR);
+        Bench_Rpc_Serve();
+        for (;;)
+        {
+            __WFI();
+        }
+    }
+
+    __enable_irq();
+
+    Cy_IPC_Pipe_Config(IpcPipeEpArray);
+
+    (void)Cy_IPC_Ring_Init(&benchWork, benchWorkBuf, BENCH_MSG_BYTES(benchConfig.msgSize), BENCH_WORK_DEPTH);
+    benchConsumerConfig.work = deferred ? &benchWork : NULL;
+    Cy_IPC_Consumer_Init(&benchConsumer, &benchConsumerConfig);
+
+    Cy_IPC_Dispatch_Init(&benchDispatch);
+    for (i = 0UL; i < BENCH_MAX_PRODUCERS; i++)
+    {
+        (void)Cy_IPC_Dispatch_Register(&benchDispatch, BENCH_CLIENT_MSG, i,
+                                       deferred ? &Bench_Cm0_DeferMsgHandler : &Bench_Cm0_MsgHandler, NULL);
+        (void)Cy_IPC_Dispatch_Register(&benchDispatch, BENCH_CLIENT_DOORBELL, i,
+                                       deferred ? &Bench_Cm0_DeferDoorbellHandler : &Bench_Cm0_DoorbellHandler, NULL);
+    }
+
+    Cy_IPC_Pipe_Init(&benchPipe0Config);
+    Cy_IPC_Pipe_Init(&benchPipe1Config);
+    for (i = 0UL; i < BENCH_CLIENT_CNT; i++)
+    {
+        (void)Cy_IPC_Pipe_RegisterCallback(CY_IPC_EP_CYPIPE_CM0_ADDR, &Bench_Cm0_RecvMsgCallback, i);
+        (void)Cy_IPC_Pipe_RegisterCallback(CY_IPC_EP_CYPIPE_CM0_CM7_1_ADDR, &Bench_Cm0_RecvMsgCallback, i);
+    }
+    Cy_IPC_Pipe_Init(&benchPipe2Config);
+    (void)Cy_IPC_Pipe_RegisterCallback(CY_IPC_EP_CYPIPE_CM0_CTL_ADDR, &Bench_Cm0_CtlCallback, BENCH_CLIENT_CTL);
+
+    Cy_IPC_Adapt_Init(&benchResult.adapt, &benchAdaptConfig, Cy_IPC_Stats_Clock());
+
+    Cy_SysEnableCM7(CORE_CM7_0, CY_CORTEX_M7_0_APPL_ADDR);
+    if (benchConfig.producers > 1UL)
+    {
+        Cy_SysEnableCM7(CORE_CM7_1, CY_CORTEX_M7_1_APPL_ADDR);
+    }
+
+    for (;;)
+    {
+        if (BENCH_RX_ADAPTIVE == benchConfig.rx)
+        {
+            Cy_IPC_Consumer_RunAdaptive(&benchConsumer, &benchResult.adapt);
+            continue;
+        }
+
+        if (deferred)
+        {
+            Cy_IPC_Consumer_RunDeferred(&benchConsumer);
+        }
+
+        interruptState = Cy_SysLib_EnterCriticalSection();
+        if (Cy_IPC_Consumer_IsIdle(&benchConsumer))
+        {
+            __WFI();
+        }
+        Cy_SysLib_ExitCriticalSection(interruptState);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_Cm0_IpcIsr
+********************************************************************************
+* Summary:
+* Pipe interrupt of both consumer endpoints, served by Cy_IPC_Consumer_Isr()
+* like Cy_SysIpcPipeIsrCm0() in the application.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Cm0_IpcIsr(void)
+{
+    Cy_IPC_Consumer_Isr(&benchConsumer);
+}
+
+/*******************************************************************************
+* Function Name: Bench_Cm0_Served
+********************************************************************************
+* Summary:
+* Records how long the channel of an endpoint was held: the release follows
+* the client callback within ExecuteCallback.
+*
+* Parameters:
+*  ep: Endpoint just served
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Cm0_Served(uint32_t ep)
+{
+    (void)ep;
+    if (benchHeld && atomic_load_explicit(&benchConfig.recording, memory_order_relaxed))
+    {
+        Cy_IPC_Stats_Record(&benchResult.latency, CY_IPC_STATS_STAGE_RELEASE, Cy_IPC_Stats_Clock() - benchLocked);
+    }
+    benchHeld = false;
+}
+
+/*******************************************************************************
+* Function Name: Bench_Cm0_EnableIrq
+********************************************************************************
+* Summary:
+* Enables or disables the interrupts of both consumer endpoints.
+*
+* Parameters:
+*  enable: true to enable, false to disable
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Cm0_EnableIrq(bool enable)
+{
+    if (enable)
+    {
+        NVIC_EnableIRQ(CY_IPC_CYPIPE_MUX(0));
+        NVIC_EnableIRQ(CY_IPC_CYPIPE_MUX(5));
+    }
+    else
+    {
+        NVIC_DisableIRQ(CY_IPC_CYPIPE_MUX(0));
+        NVIC_DisableIRQ(CY_IPC_CYPIPE_MUX(5));
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_Cm0_CtlIsr
+********************************************************************************
+* Summary:
+* Pipe interrupt of the control endpoint. Its priority is higher than that
+* of the consumer endpoint, so it preempts a drain in progress.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Cm0_CtlIsr(void)
+{
+    Cy_IPC_Pipe_ExecuteCallback(CY_IPC_EP_CYPIPE_CM0_CTL_ADDR);
+}
+
+/*******************************************************************************
+* Function Name: Bench_Cm0_CtlCallback
+********************************************************************************
+* Summary:
+* Records the latency of a control ping while the driver is recording.
+*
+* Parameters:
+*  msgData: Control ping
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Cm0_CtlCallback(uint32_t *msgData)
+{
+    cy_stc_bench_ctl_t const *ping = (cy_stc_bench_ctl_t const *)msgData;
+
+    if (atomic_load_explicit(&benchConfig.recording, memory_order_relaxed))
+    {
+        Cy_IPC_Stats_Record(&benchResult.control, CY_IPC_STATS_STAGE_NOTIFY, Cy_IPC_Stats_Clock() - ping->sent);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_Cm0_RecvMsgCallback
+********************************************************************************
+* Summary:
+* Client callback of every slot, routes the message like
+* Pipe0_cm0_RecvMsgCallback() does in the application.
+*
+* Parameters:
+*  msgData: Received message
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Cm0_RecvMsgCallback(uint32_t *msgData)
+{
+    benchLocked = ((cy_stc_bench_doorbell_t const *)msgData)->locked;
+    benchHeld = true;
+    (void)Cy_IPC_Dispatch_Message(&benchDispatch, msgData);
+}
+
+/*******************************************************************************
+* Function Name: Bench_Cm0_MsgHandler
+********************************************************************************
+* Summary:
+* Consumes a message passed through the pipe.
+*
+* Parameters:
+*  msgData: Received message
+*  context: Not used
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Cm0_MsgHandler(uint32_t *msgData, void *context)
+{
+    cy_stc_bench_msg_t const *msg = (cy_stc_bench_msg_t const *)msgData;
+
+    (void)context;
+    Bench_Cm0_Consume(msg, msg->hdr.pktType);
+}
+
+/*******************************************************************************
+* Function Name: Bench_Cm0_DoorbellHandler
+********************************************************************************
+* Summary:
+* Drains the rings of the producers, which an adaptive consumer then polls.
+*
+* Parameters:
+*  msgData: Doorbell message
+*  context: Not used
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Cm0_DoorbellHandler(uint32_t *msgData, void *context)
+{
+    cy_stc_bench_doorbell_t const *doorbell = (cy_stc_bench_doorbell_t const *)msgData;
+
+    (void)context;
+    Bench_Cm0_Attach(doorbell);
+    Cy_IPC_Consumer_Drain(&benchConsumer, benchConsumer.received);
+}
+
+/*******************************************************************************
+* Function Name: Bench_Cm0_Attach
+********************************************************************************
+* Summary:
+* Notes the ring of the producer that rang, and grants the window of
+* benchConfig on its first doorbell. More messages than the window in the
+* ring means that the producer overran its credit, which counts as an
+* error.
+*
+* Parameters:
+*  doorbell: Doorbell message
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Cm0_Attach(cy_stc_bench_doorbell_t const *doorbell)
+{
+    uint32_t producer = doorbell->hdr.pktType;
+
+    if (producer >= BENCH_MAX_PRODUCERS)
+    {
+        return;
+    }
+
+    if (Cy_IPC_Ring_Count(doorbell->ring) > benchConfig.window)
+    {
+        benchResult.errors++;
+    }
+    Cy_IPC_Consumer_Attach(&benchConsumer, producer, doorbell->ring, doorbell->credit, benchConfig.window);
+}
+
+/*******************************************************************************
+* Function Name: Bench_Cm0_DeferMsgHandler
+********************************************************************************
+* Summary:
+* Deferred consumer: copies the message into the work queue. Should it be
+* full, the message is consumed here, while the callback holds the channel.
+*
+* Parameters:
+*  msgData: Received message
+*  context: Not used
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Cm0_DeferMsgHandler(uint32_t *msgData, void *context)
+{
+    cy_stc_bench_msg_t const *msg = (cy_stc_bench_msg_t const *)msgData;
+
+    (void)context;
+    if (!Cy_IPC_Consumer_Defer(&benchConsumer, msgData))
+    {
+        Bench_Cm0_Consume(msg, msg->hdr.pktType);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_Cm0_DeferDoorbellHandler
+********************************************************************************
+* Summary:
+* Deferred consumer: notes the ring of the producer that rang; the main loop
+* drains the rings.
+*
+* Parameters:
+*  msgData: Doorbell message
+*  context: Not used
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Cm0_DeferDoorbellHandler(uint32_t *msgData, void *context)
+{
+    cy_stc_bench_doorbell_t const *doorbell = (cy_stc_bench_doorbell_t const *)msgData;
+
+    (void)context;
+    Bench_Cm0_Attach(doorbell);
+    Cy_IPC_Consumer_DrainLater(&benchConsumer, benchConsumer.received);
+}
+
+/*******************************************************************************
+* Function Name: Bench_Cm0_RingMsg
+********************************************************************************
+* Summary:
+* Consumes a message drained from the ring of a producer.
+*
+* Parameters:
+*  msg: Ring element (cy_stc_bench_msg_t)
+*  producer: Producer index
+*  received: Not used
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Cm0_RingMsg(void *msg, uint32_t producer, uint32_t received)
+{
+    (void)received;
+    Bench_Cm0_Consume((cy_stc_bench_msg_t const *)msg, producer);
+}
+
+/*******************************************************************************
+* Function Name: Bench_Cm0_WorkItem
+********************************************************************************
+* Summary:
+* Consumes a message taken off the work queue by the main loop.
+*
+* Parameters:
+*  item: Work item (cy_stc_bench_msg_t)
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Cm0_WorkItem(void *item)
+{
+    cy_stc_bench_msg_t const *msg = (cy_stc_bench_msg_t const *)item;
+
+    Bench_Cm0_Consume(msg, msg->hdr.pktType);
+}
+
+/*******************************************************************************
+* Function Name: Bench_Cm0_Consume
+********************************************************************************
+* Summary:
+* Checks the message with Cy_IPC_Msg_Check(), so CRC and sequence checks are
+* part of the measurement when enabled, reads the whole payload, checks
+* sequence and content, and records the latency while the driver is
+* recording. benchConfig.work then keeps the consumer busy, so that the
+* producers outrun it.
+*
+* Parameters:
+*  msg: Message
+*  producer: Producer index
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Cm0_Consume(cy_stc_bench_msg_t const *msg, uint32_t producer)
+{
+    uint32_t now = Cy_IPC_Stats_Clock();
+    uint32_t size = benchConfig.msgSize;
+    uint32_t sum = 0UL;
+    uint32_t i;
+
+    /* Replayed sends differ in size, the header tells */
+    if (BENCH_MODE_REPLAY == benchConfig.mode)
+    {
+        size = (uint32_t)msg->hdr.length - BENCH_MSG_LENGTH(0UL);
+    }
+
+    if ((producer >= BENCH_MAX_PRODUCERS) || (size > BENCH_MAX_MSG_SIZE) ||
+        (CY_IPC_MSG_SUCCESS != Cy_IPC_Msg_Check(msg, BENCH_MSG_LENGTH(size), &benchRx[producer])) ||
+        (BENCH_MSG_LENGTH(size) != msg->hdr.length))
+    {
+        benchResult.errors++;
+        return;
+    }
+
+    Cy_IPC_Adapt_Arrived(&benchResult.adapt, 1UL);
+
+    for (i = 0UL; i < size; i++)
+    {
+        sum += msg->payload[i];
+    }
+
+    if ((msg->seq != benchNextSeq[producer]) || (sum != (size * (msg->seq & 0xFFUL))))
+    {
+        benchResult.errors++;
+    }
+    benchNextSeq[producer] = msg->seq + 1UL;
+
+    if (atomic_load_explicit(&benchConfig.recording, memory_order_relaxed))
+    {
+        benchResult.messages++;
+        benchResult.bytes += size;
+        Cy_IPC_Stats_Record(&benchResult.latency, CY_IPC_STATS_STAGE_NOTIFY, now - msg->sent);
+    }
+
+    while ((Cy_IPC_Stats_Clock() - now) < benchConfig.work)
+    {
+    }
+}
+
+/* [] END OF FILE */
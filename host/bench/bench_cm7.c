@@ -0,0 +1,590 @@
+/******************************************************************************
+* File Name:   bench_cm7.c
+*
+* Description: Benchmark producer image, built once for CM7_0 (BENCH_CM7=0)
+*              and once for CM7_1 (BENCH_CM7=1). Sends messages to CM0+ as
+*              fast as the selected send mode allows.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+#include "cy_pdl.h"
+#include "bench.h"
+#include "ipc_batch.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Own endpoint, and the consumer endpoint of CM0+ that serves this producer */
+#if (BENCH_CM7 == 0)
+#define BENCH_EP_ADDR                   CY_IPC_EP_CYPIPE_CM7_0_ADDR
+#define BENCH_EP_CONFIG                 CY_IPC_CYPIPE_EP_CONFIG(1)
+#define BENCH_CM0_ADDR                  CY_IPC_EP_CYPIPE_CM0_ADDR
+#define BENCH_CM0_CONFIG                CY_IPC_CYPIPE_EP_CONFIG(0)
+#else
+#define BENCH_EP_ADDR                   CY_IPC_EP_CYPIPE_CM7_1_ADDR
+#define BENCH_EP_CONFIG                 CY_IPC_CYPIPE_EP_CONFIG(2)
+#define BENCH_CM0_ADDR                  CY_IPC_EP_CYPIPE_CM0_CM7_1_ADDR
+#define BENCH_CM0_CONFIG                CY_IPC_CYPIPE_EP_CONFIG(5)
+#endif /* BENCH_CM7 */
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void Bench_Cm7_IpcIsr(void);
+void Bench_Cm7_SendBlocking(void);
+void Bench_Cm7_Transfer(uint32_t size);
+void Bench_Cm7_Replay(void);
+void Bench_Cm7_SendQueued(void);
+void Bench_Cm7_RingDoorbell(void);
+void Bench_Cm7_Flush(void);
+void Bench_Cm7_Pace(uint32_t start, uint32_t seq);
+void Bench_Cm7_Wait(uint32_t due);
+#if (BENCH_CM7 == 0)
+void Bench_Cm7_CtlIsr(void);
+void Bench_Cm7_CtlTick(void);
+#endif /* BENCH_CM7 */
+
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static cy_stc_bench_msg_t benchMsg;
+static cy_stc_ipc_msg_tx_t benchTx;
+static cy_stc_bench_doorbell_t benchDoorbell;
+static cy_stc_ipc_ring_t benchRing;
+static CY_ALIGN(IPC_PORT_CACHE_LINE) uint8_t benchRingBuf[BENCH_RING_DEPTH * BENCH_MSG_BYTES(BENCH_MAX_MSG_SIZE)];
+static cy_stc_ipc_batch_t benchBatch;
+static cy_stc_ipc_credit_t benchCredit;
+static cy_stc_ipc_credit_tx_t benchCreditTx;
+static cy_stc_ipc_ring_t benchBacklog;
+static CY_ALIGN(IPC_PORT_CACHE_LINE) uint8_t benchBacklogBuf[BENCH_BACKLOG_DEPTH * BENCH_MSG_BYTES(BENCH_MAX_MSG_SIZE)];
+#if (BENCH_CM7 == 0)
+static cy_stc_bench_ctl_t benchCtl;
+#endif /* BENCH_CM7 */
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* Sets up the producer endpoint and sends in the configured mode forever.
+* In the fan-out modes CM7_1 publishes and CM7_0 runs its subscribers, in
+* the seqlock mode CM7_1 writes and CM7_0 reads, in the stream mode CM7_0
+* produces, in the handoff mode CM7_0 sends to CM7_1, in the offload mode
+* both run jobs.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int
+*******************************************************************************/
+int main(void)
+{
+    static cy_stc_ipc_pipe_ep_t IpcPipeEpArray[CY_IPC_MAX_ENDPOINTS];
+    static cy_ipc_pipe_callback_ptr_t epCbArray[1];
+
+    static const cy_stc_ipc_pipe_config_t benchPipeConfig =
+    {
+        BENCH_EP_CONFIG,
+        BENCH_CM0_CONFIG,
+        1UL,
+        epCbArray,
+        &Bench_Cm7_IpcIsr
+    };
+
+#if (BENCH_CM7 == 0)
+    /* Control lane: only releases come back, no client */
+    static const cy_stc_ipc_pipe_config_t benchPipe2Config =
+    {
+        CY_IPC_CYPIPE_EP_CONFIG(4),
+        CY_IPC_CYPIPE_EP_CONFIG(3),
+        0UL,
+        NULL,
+        &Bench_Cm7_CtlIsr
+    };
+#endif /* BENCH_CM7 */
+
+    if (0UL != benchConfig.subscribers)
+    {
+#if (BENCH_CM7 == 0)
+        Bench_Fanout_Subscribe(CY_IPC_CORE_CM7_0);
+        for (;;)
+        {
+            __WFI();
+        }
+#else
+        Bench_Fanout_Publish();
+#endif /* BENCH_CM7 */
+    }
+
+    if (BENCH_MODE_SEQLOCK == benchConfig.mode)
+    {
+#if (BENCH_CM7 == 0)
+        Bench_Seqlock_Read(CY_IPC_CORE_CM7_0);
+        for (;;)
+        {
+            __WFI();
+        }
+#else
+        Bench_Seqlock_Write();
+#endif /* BENCH_CM7 */
+    }
+
+#if (BENCH_CM7 == 0)
+    if (BENCH_MODE_STREAM == benchConfig.mode)
+    {
+        Bench_Stream_Produce();
+    }
+#endif /* BENCH_CM7 */
+
+    if (BENCH_MODE_HANDOFF == benchConfig.mode)
+    {
+#if (BENCH_CM7 == 0)
+        Bench_Handoff_Send();
+#else
+        Bench_Handoff_Receive();
+        for (;;)
+        {
+            __WFI();
+        }
+#endif /* BENCH_CM7 */
+    }
+
+    if (BENCH_MODE_OFFLOAD == benchConfig.mode)
+    {
+        Bench_Offload_Work(BENCH_CM7);
+    }
+
+#if (BENCH_CM7 == 0)
+    if (BENCH_MODE_RPC == benchConfig.mode)
+    {
+        Bench_Rpc_Call();
+    }
+#endif /* BENCH_CM7 */
+
+    __enable_irq();
+
+    Cy_IPC_Pipe_Config(IpcPipeEpArray);
+    Cy_IPC_Pipe_Init(&benchPipeConfig);
+
+#if (BENCH_CM7 == 0)
+    /* Pings preempt the send loop, which keeps the bulk lane saturated */
+    Cy_IPC_Pipe_Init(&benchPipe2Config);
+    Cy_IPC_Msg_InitHeader(&benchCtl.hdr, BENCH_CLIENT_CTL, 0UL, 0UL, 0UL);
+    if (benchConfig.control)
+    {
+        Cy_SysTick_Init(CY_SYSTICK_CLOCK_SOURCE_CLK_CPU, ((SystemCoreClock / 1000000UL) * BENCH_CTL_PERIOD_US) - 1UL);
+        Cy_SysTick_SetCallback(0UL, &Bench_Cm7_CtlTick);
+    }
+#endif /* BENCH_CM7 */
+
+    Cy_IPC_Msg_InitHeader(&benchMsg.hdr, BENCH_CLIENT_MSG, BENCH_CM7, 0UL, BENCH_MSG_LENGTH(benchConfig.msgSize));
+    benchMsg.seq = 0UL;
+
+    if (BENCH_MODE_BLOCKING == benchConfig.mode)
+    {
+        Bench_Cm7_SendBlocking();
+    }
+    else if (BENCH_MODE_REPLAY == benchConfig.mode)
+    {
+        Bench_Cm7_Replay();
+    }
+    else
+    {
+        Bench_Cm7_SendQueued();
+    }
+
+    return 0;
+}
+
+/*******************************************************************************
+* Function Name: Bench_Cm7_IpcIsr
+********************************************************************************
+* Summary:
+* Pipe interrupt of the producer endpoint. Moves backlog messages into the
+* ring with the credit returned by the drain, and rings again if a batch
+* filled up while the doorbell was in flight.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Cm7_IpcIsr(void)
+{
+    Cy_IPC_Pipe_ExecuteCallback(BENCH_EP_ADDR);
+
+    if (BENCH_MODE_QUEUED == benchConfig.mode)
+    {
+        Bench_Cm7_Flush();
+        if (Cy_IPC_Batch_IsDue(&benchBatch, 0UL))
+        {
+            Bench_Cm7_RingDoorbell();
+        }
+    }
+}
+
+#if (BENCH_CM7 == 0)
+/*******************************************************************************
+* Function Name: Bench_Cm7_CtlIsr
+********************************************************************************
+* Summary:
+* Pipe interrupt of the control endpoint, takes the release of a ping.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Cm7_CtlIsr(void)
+{
+    Cy_IPC_Pipe_ExecuteCallback(CY_IPC_EP_CYPIPE_CM7_0_CTL_ADDR);
+}
+
+/*******************************************************************************
+* Function Name: Bench_Cm7_CtlTick
+********************************************************************************
+* Summary:
+* SysTick callback, pings CM0+ on the control lane. A tick is skipped while
+* the previous ping is not released.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Cm7_CtlTick(void)
+{
+    if (!Cy_IPC_Pipe_EndpointIsBusy(CY_IPC_EP_CYPIPE_CM7_0_CTL_ADDR))
+    {
+        benchCtl.sent = Cy_IPC_Stats_Clock();
+        (void)Cy_IPC_Pipe_SendMessage(CY_IPC_EP_CYPIPE_CM0_CTL_ADDR, CY_IPC_EP_CYPIPE_CM7_0_CTL_ADDR, &benchCtl, NULL);
+    }
+}
+#endif /* BENCH_CM7 */
+
+/*******************************************************************************
+* Function Name: Bench_Cm7_SendBlocking
+********************************************************************************
+* Summary:
+* Sends every message through the pipe and waits for its release before the
+* message buffer is reused.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Cm7_SendBlocking(void)
+{
+    for (;;)
+    {
+        Bench_Cm7_Transfer(benchConfig.msgSize);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_Cm7_Transfer
+********************************************************************************
+* Summary:
+* Sends one message of size payload bytes through the pipe and waits for its
+* release. Retries while the consumer channel is still locked.
+*
+* Parameters:
+*  size: Payload bytes, at most BENCH_MAX_MSG_SIZE
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Cm7_Transfer(uint32_t size)
+{
+    uint32_t interruptState;
+
+    benchMsg.hdr.length = (uint16_t)BENCH_MSG_LENGTH(size);
+    (void)memset(benchMsg.payload, (int)(benchMsg.seq & 0xFFUL), size);
+    benchMsg.sent = Cy_IPC_Stats_Clock();
+    Cy_IPC_Msg_Seal(&benchMsg, &benchTx);
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    benchMsg.locked = Cy_IPC_Stats_Clock();
+    while (CY_IPC_PIPE_SUCCESS != Cy_IPC_Pipe_SendMessage(BENCH_CM0_ADDR, BENCH_EP_ADDR, &benchMsg, NULL))
+    {
+        Cy_SysLib_ExitCriticalSection(interruptState);
+        interruptState = Cy_SysLib_EnterCriticalSection();
+        benchMsg.locked = Cy_IPC_Stats_Clock();
+    }
+
+    /* Blocking send: the buffer is owned by CM0+ until the release */
+    while (Cy_IPC_Pipe_EndpointIsBusy(BENCH_EP_ADDR))
+    {
+        __WFI();
+        Cy_SysLib_ExitCriticalSection(interruptState);
+        interruptState = Cy_SysLib_EnterCriticalSection();
+    }
+    Cy_SysLib_ExitCriticalSection(interruptState);
+
+    Cy_IPC_Msg_Sent(&benchTx);
+    benchMsg.seq++;
+}
+
+/*******************************************************************************
+* Function Name: Bench_Cm7_Replay
+********************************************************************************
+* Summary:
+* Replays the sends of this producer in benchReplay as blocking sends, each
+* at its captured time and size, and starts over every period. A send that
+* fell behind goes out at once, as in the capture a busy sender would have
+* sent it late too. A producer without sends sleeps.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Cm7_Replay(void)
+{
+    uint32_t count = benchReplay.count[BENCH_CM7];
+    uint32_t start = Cy_IPC_Stats_Clock();
+    uint32_t i;
+
+    while (0UL == count)
+    {
+        __WFI();
+    }
+
+    for (;;)
+    {
+        for (i = 0UL; i < count; i++)
+        {
+            Bench_Cm7_Wait(start + benchReplay.send[BENCH_CM7][i].at);
+            Bench_Cm7_Transfer(benchReplay.send[BENCH_CM7][i].size);
+        }
+        start += benchReplay.period;
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_Cm7_SendQueued
+********************************************************************************
+* Summary:
+* Pushes messages into the ring as far as the consumer grants credit, and
+* rings the doorbell every batch, paced to benchConfig.rate if set. Without
+* credit, benchConfig.policy decides: a blocked send waits in WFI while the
+* doorbell is in flight, a queued one waits in the backlog, a dropped one is
+* gone and the next message takes its sequence number.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Cm7_SendQueued(void)
+{
+    cy_en_ipc_credit_status_t status;
+    uint32_t interruptState;
+    uint32_t start = Cy_IPC_Stats_Clock();
+    bool noCredit;
+
+    (void)Cy_IPC_Ring_Init(&benchRing, benchRingBuf, BENCH_MSG_BYTES(benchConfig.msgSize), BENCH_RING_DEPTH);
+    (void)Cy_IPC_Ring_Init(&benchBacklog, benchBacklogBuf, BENCH_MSG_BYTES(benchConfig.msgSize), BENCH_BACKLOG_DEPTH);
+    Cy_IPC_Credit_InitTx(&benchCreditTx, &benchCredit, &benchRing, benchConfig.policy, &benchBacklog, benchConfig.window);
+    Cy_IPC_Batch_Init(&benchBatch, benchConfig.batch, UINT32_MAX);
+
+    Cy_IPC_Msg_InitHeader(&benchDoorbell.hdr, BENCH_CLIENT_DOORBELL, BENCH_CM7, 0UL,
+                          sizeof(benchDoorbell.ring) + sizeof(benchDoorbell.credit));
+    benchDoorbell.ring = &benchRing;
+    benchDoorbell.credit = &benchCredit;
+    Cy_IPC_Msg_Seal(&benchDoorbell, NULL);
+
+    for (;;)
+    {
+        if (0UL != benchConfig.rate)
+        {
+            Bench_Cm7_Pace(start, benchMsg.seq);
+        }
+
+        (void)memset(benchMsg.payload, (int)(benchMsg.seq & 0xFFUL), benchConfig.msgSize);
+        benchMsg.sent = Cy_IPC_Stats_Clock();
+        Cy_IPC_Msg_Seal(&benchMsg, &benchTx);
+
+        /* The release interrupt flushes the backlog too */
+        interruptState = Cy_SysLib_EnterCriticalSection();
+        Bench_Cm7_Flush();
+        status = Cy_IPC_Credit_Send(&benchCreditTx, &benchMsg);
+        if (CY_IPC_CREDIT_SUCCESS == status)
+        {
+            (void)Cy_IPC_Batch_Add(&benchBatch, 0UL);
+        }
+        if (Cy_IPC_Batch_IsDue(&benchBatch, 0UL))
+        {
+            Bench_Cm7_RingDoorbell();
+        }
+        Cy_SysLib_ExitCriticalSection(interruptState);
+
+        if ((CY_IPC_CREDIT_SUCCESS == status) || (CY_IPC_CREDIT_QUEUED == status))
+        {
+            Cy_IPC_Msg_Sent(&benchTx);
+            benchMsg.seq++;
+        }
+        else
+        {
+            /* Out of credit: the consumer grants before it releases, or
+             * right after when it defers the work; recheck masked. Each
+             * producer has its own consumer channel, so a refused doorbell
+             * is the previous one still in it, and its release is coming.
+             * A producer that drops does not wait for the release, it
+             * only backs off. */
+            interruptState = Cy_SysLib_EnterCriticalSection();
+            Bench_Cm7_RingDoorbell();
+            noCredit = (0UL == Cy_IPC_Credit_Available(&benchCreditTx));
+            if (noCredit && (CY_IPC_CREDIT_BLOCKED == status) && Cy_IPC_Pipe_EndpointIsBusy(BENCH_EP_ADDR))
+            {
+                __WFI();
+                noCredit = false;
+            }
+            Cy_SysLib_ExitCriticalSection(interruptState);
+
+            if (noCredit)
+            {
+                Cy_SysLib_DelayUs(1U);
+            }
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_Cm7_RingDoorbell
+********************************************************************************
+* Summary:
+* Tells CM0+ to drain the ring. Must be called with interrupts masked. A busy
+* pipe is not an error: the release interrupt rings again.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Cm7_RingDoorbell(void)
+{
+    /* A doorbell in flight keeps its lock time */
+    if (!Cy_IPC_Pipe_EndpointIsBusy(BENCH_EP_ADDR))
+    {
+        benchDoorbell.locked = Cy_IPC_Stats_Clock();
+    }
+
+    if (CY_IPC_PIPE_SUCCESS == Cy_IPC_Pipe_SendMessage(BENCH_CM0_ADDR, BENCH_EP_ADDR, &benchDoorbell, NULL))
+    {
+        Cy_IPC_Batch_Sent(&benchBatch);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_Cm7_Flush
+********************************************************************************
+* Summary:
+* Moves backlog messages into the ring as far as the consumer has granted
+* credit, and adds them to the batch. Must be called with interrupts masked.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Cm7_Flush(void)
+{
+    uint32_t moved;
+
+    for (moved = Cy_IPC_Credit_Flush(&benchCreditTx); 0UL != moved; moved--)
+    {
+        (void)Cy_IPC_Batch_Add(&benchBatch, 0UL);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_Cm7_Pace
+********************************************************************************
+* Summary:
+* Sleeps until a message is due at benchConfig.rate. A producer that fell
+* behind sends at once, so the average rate holds.
+*
+* Parameters:
+*  start: Cy_IPC_Stats_Clock() at the first message, ns on the host
+*  seq: Sequence number of the message
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Cm7_Pace(uint32_t start, uint32_t seq)
+{
+    Bench_Cm7_Wait(start + (uint32_t)(((uint64_t)seq * 1000000000ULL) / benchConfig.rate));
+}
+
+/*******************************************************************************
+* Function Name: Bench_Cm7_Wait
+********************************************************************************
+* Summary:
+* Sleeps until a time, returns at once if it has passed.
+*
+* Parameters:
+*  due: Cy_IPC_Stats_Clock() to wait for, ns on the host
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Cm7_Wait(uint32_t due)
+{
+    int32_t ahead;
+
+    while ((ahead = (int32_t)(due - Cy_IPC_Stats_Clock())) > 0)
+    {
+        Cy_SysLib_DelayUs((uint16_t)((ahead < 60000000L) ? (((uint32_t)ahead / 1000UL) + 1UL) : 60000UL));
+    }
+}
+
+/* [] END OF FILE */
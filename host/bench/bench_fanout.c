@@ -0,0 +1,451 @@
+/******************************************************************************
+* File Name:   bench_fanout.c
+*
+* Description: Benchmark fan-out roles, linked into every benchmark image.
+*              CM7_1 publishes each message to 1 to 4 subscribers on CM0+
+*              and CM7_0, either as a copy through the pipe to each one
+*              in turn, or once on a pub/sub topic with a single notify
+*              for all of them.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+#include "cy_pdl.h"
+#include "bench.h"
+#include "ipc_messages.h"
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void Bench_Fanout_PubIsr(void);
+void Bench_Fanout_Isr0(void);
+void Bench_Fanout_Isr1(void);
+void Bench_Fanout_Isr2(void);
+void Bench_Fanout_Isr3(void);
+void Bench_Fanout_Send(uint32_t sub, void *msg);
+void Bench_Fanout_Fill(cy_stc_bench_msg_t *msg, uint32_t seq);
+void Bench_Fanout_Callback(uint32_t *msgData);
+void Bench_Fanout_Service(uint32_t sub);
+void Bench_Fanout_Consume(uint32_t sub, cy_stc_bench_msg_t const *msg);
+
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static cy_stc_ipc_pipe_ep_t benchFanoutEpArray[CY_IPC_MAX_ENDPOINTS];
+static cy_ipc_pipe_callback_ptr_t benchFanoutCb[BENCH_MAX_SUBSCRIBERS][BENCH_FANOUT_CLIENT_CNT];
+
+/* Subscriber n receives on the first endpoint of its config */
+static const cy_stc_ipc_pipe_config_t benchFanoutConfig[BENCH_MAX_SUBSCRIBERS] =
+{
+    { CY_IPC_CYPIPE_EP_CONFIG(0), CY_IPC_CYPIPE_EP_CONFIG(2), BENCH_FANOUT_CLIENT_CNT, benchFanoutCb[0], &Bench_Fanout_Isr0 },
+    { CY_IPC_CYPIPE_EP_CONFIG(1), CY_IPC_CYPIPE_EP_CONFIG(2), BENCH_FANOUT_CLIENT_CNT, benchFanoutCb[1], &Bench_Fanout_Isr1 },
+    { CY_IPC_CYPIPE_EP_CONFIG(3), CY_IPC_CYPIPE_EP_CONFIG(2), BENCH_FANOUT_CLIENT_CNT, benchFanoutCb[2], &Bench_Fanout_Isr2 },
+    { CY_IPC_CYPIPE_EP_CONFIG(4), CY_IPC_CYPIPE_EP_CONFIG(2), BENCH_FANOUT_CLIENT_CNT, benchFanoutCb[3], &Bench_Fanout_Isr3 },
+};
+
+/* The publisher sends from EP2, only releases come back */
+static const cy_stc_ipc_pipe_config_t benchFanoutPubConfig[BENCH_MAX_SUBSCRIBERS] =
+{
+    { CY_IPC_CYPIPE_EP_CONFIG(2), CY_IPC_CYPIPE_EP_CONFIG(0), 0UL, NULL, &Bench_Fanout_PubIsr },
+    { CY_IPC_CYPIPE_EP_CONFIG(2), CY_IPC_CYPIPE_EP_CONFIG(1), 0UL, NULL, &Bench_Fanout_PubIsr },
+    { CY_IPC_CYPIPE_EP_CONFIG(2), CY_IPC_CYPIPE_EP_CONFIG(3), 0UL, NULL, &Bench_Fanout_PubIsr },
+    { CY_IPC_CYPIPE_EP_CONFIG(2), CY_IPC_CYPIPE_EP_CONFIG(4), 0UL, NULL, &Bench_Fanout_PubIsr },
+};
+
+static const cy_en_ipc_core_t benchFanoutCore[BENCH_MAX_SUBSCRIBERS] =
+{
+    CY_IPC_CORE_CM0P, CY_IPC_CORE_CM7_0, CY_IPC_CORE_CM0P, CY_IPC_CORE_CM7_0
+};
+
+static const uint32_t benchFanoutNotify[BENCH_MAX_SUBSCRIBERS] =
+{
+    CY_IPC_CYPIPE_INTR_MASK_EP0, CY_IPC_CYPIPE_INTR_MASK_EP1, CY_IPC_CYPIPE_INTR_MASK_EP3, CY_IPC_CYPIPE_INTR_MASK_EP4
+};
+
+/* Publisher */
+static cy_stc_bench_msg_t benchFanoutMsg;       /* Unicast: the copy in the channel */
+static cy_stc_ipc_topicmsg_t benchFanoutTopicMsg;
+static cy_stc_ipc_pubsub_topic_t benchFanoutTopic;
+static CY_ALIGN(IPC_PORT_CACHE_LINE) uint8_t benchFanoutTopicMem[CY_IPC_PUBSUB_STORAGE_SIZE(BENCH_MSG_BYTES(BENCH_MAX_MSG_SIZE), BENCH_TOPIC_DEPTH)];
+
+/* Subscribers, each used by the image that runs it */
+static cy_stc_ipc_pubsub_sub_t benchFanoutSub[BENCH_MAX_SUBSCRIBERS];
+static uint32_t benchFanoutNextSeq[BENCH_MAX_SUBSCRIBERS];
+
+
+/*******************************************************************************
+* Function Name: Bench_Fanout_Publish
+********************************************************************************
+* Summary:
+* Publisher role of CM7_1. Publishes messages of benchConfig.msgSize bytes
+* to benchConfig.subscribers subscribers forever. Unicast sends a copy to
+* each subscriber in turn and waits for its release; pub/sub first hands the
+* topic to every subscriber, then writes each message once into a claimed
+* slot and notifies all subscribers with one notify event. The publisher
+* time of each publication is recorded as stage SEND.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Fanout_Publish(void)
+{
+    cy_stc_bench_msg_t *msg;
+    uint32_t size = benchConfig.msgSize;
+    uint32_t notifyMask = 0UL;
+    uint32_t start;
+    uint32_t seq;
+    uint32_t sub;
+
+    __enable_irq();
+
+    Cy_IPC_Pipe_Config(benchFanoutEpArray);
+    for (sub = 0UL; sub < benchConfig.subscribers; sub++)
+    {
+        Cy_IPC_Pipe_Init(&benchFanoutPubConfig[sub]);
+    }
+
+    if (BENCH_MODE_PUBSUB == benchConfig.mode)
+    {
+        (void)Cy_IPC_PubSub_Init(&benchFanoutTopic, benchFanoutTopicMem, BENCH_MSG_BYTES(size), BENCH_TOPIC_DEPTH);
+
+        /* Every subscriber has asked for its slot once its topic message is released */
+        Cy_IPC_Msg_InitTopic(&benchFanoutTopicMsg, BENCH_FANOUT_CLIENT_TOPIC, 0UL, 0UL);
+        benchFanoutTopicMsg.payload.topic = &benchFanoutTopic;
+        for (sub = 0UL; sub < benchConfig.subscribers; sub++)
+        {
+            benchFanoutTopicMsg.payload.subscriber = sub;
+            Cy_IPC_Msg_Seal(&benchFanoutTopicMsg, NULL);
+            Bench_Fanout_Send(sub, &benchFanoutTopicMsg);
+        }
+    }
+
+    Cy_IPC_Msg_InitHeader(&benchFanoutMsg.hdr, BENCH_FANOUT_CLIENT_MSG, 0UL, 0UL, BENCH_MSG_LENGTH(size));
+
+    for (seq = 0UL; ; seq++)
+    {
+        if (BENCH_MODE_UNICAST == benchConfig.mode)
+        {
+            start = Cy_IPC_Stats_Clock();
+            Bench_Fanout_Fill(&benchFanoutMsg, seq);
+            for (sub = 0UL; sub < benchConfig.subscribers; sub++)
+            {
+                benchFanoutMsg.hdr.pktType = (uint8_t)sub;
+                Cy_IPC_Msg_Seal(&benchFanoutMsg, NULL);
+                Bench_Fanout_Send(sub, &benchFanoutMsg);
+            }
+        }
+        else
+        {
+            /* Subscribers do not signal their releases, back off and retry */
+            msg = (cy_stc_bench_msg_t *)Cy_IPC_PubSub_Claim(&benchFanoutTopic);
+            while (NULL == msg)
+            {
+                Cy_SysLib_DelayUs(1U);
+                msg = (cy_stc_bench_msg_t *)Cy_IPC_PubSub_Claim(&benchFanoutTopic);
+            }
+
+            start = Cy_IPC_Stats_Clock();
+            Bench_Fanout_Fill(msg, seq);
+            (void)Cy_IPC_PubSub_Publish(&benchFanoutTopic, BENCH_MSG_BYTES(size), &notifyMask);
+            Cy_IPC_Drv_AcquireNotify(Cy_IPC_Drv_GetIpcBaseAddress(CY_IPC_CHAN_CYPIPE_EP2), notifyMask);
+            benchResult.pubStalls = IPC_PORT_LOAD_RELAXED(&benchFanoutTopic.stalls);
+        }
+
+        if (atomic_load_explicit(&benchConfig.recording, memory_order_relaxed))
+        {
+            Cy_IPC_Stats_Record(&benchResult.publish, CY_IPC_STATS_STAGE_SEND, Cy_IPC_Stats_Clock() - start);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_Fanout_Subscribe
+********************************************************************************
+* Summary:
+* Subscriber role of CM0+ and CM7_0: sets up the endpoints of the
+* subscribers that run on the core. The caller then sleeps, the subscribers
+* run in their pipe interrupts.
+*
+* Parameters:
+*  core: Core that calls
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Fanout_Subscribe(cy_en_ipc_core_t core)
+{
+    uint32_t interruptState;
+    uint32_t sub;
+    uint32_t ep;
+
+    __enable_irq();
+
+    Cy_IPC_Pipe_Config(benchFanoutEpArray);
+
+    /* The publisher may already be sending, the callbacks must be in place
+     * when the interrupt is enabled */
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    for (sub = 0UL; sub < benchConfig.subscribers; sub++)
+    {
+        if (core == benchFanoutCore[sub])
+        {
+            ep = benchFanoutConfig[sub].ep0ConfigData.epAddress;
+            Cy_IPC_Pipe_Init(&benchFanoutConfig[sub]);
+            (void)Cy_IPC_Pipe_RegisterCallback(ep, &Bench_Fanout_Callback, BENCH_FANOUT_CLIENT_MSG);
+            (void)Cy_IPC_Pipe_RegisterCallback(ep, &Bench_Fanout_Callback, BENCH_FANOUT_CLIENT_TOPIC);
+        }
+    }
+    Cy_SysLib_ExitCriticalSection(interruptState);
+}
+
+/*******************************************************************************
+* Function Name: Bench_Fanout_PubIsr
+********************************************************************************
+* Summary:
+* Pipe interrupt of the publisher endpoint, takes the releases.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Fanout_PubIsr(void)
+{
+    Cy_IPC_Pipe_ExecuteCallback(CY_IPC_EP_CYPIPE_CM7_1_ADDR);
+}
+
+/*******************************************************************************
+* Function Name: Bench_Fanout_Isr0
+********************************************************************************
+* Summary:
+* Pipe interrupts of the subscriber endpoints, one per subscriber.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Fanout_Isr0(void)
+{
+    Bench_Fanout_Service(0UL);
+}
+
+void Bench_Fanout_Isr1(void)
+{
+    Bench_Fanout_Service(1UL);
+}
+
+void Bench_Fanout_Isr2(void)
+{
+    Bench_Fanout_Service(2UL);
+}
+
+void Bench_Fanout_Isr3(void)
+{
+    Bench_Fanout_Service(3UL);
+}
+
+/*******************************************************************************
+* Function Name: Bench_Fanout_Send
+********************************************************************************
+* Summary:
+* Sends a message to a subscriber through the pipe and waits for its
+* release, like Bench_Cm7_SendBlocking().
+*
+* Parameters:
+*  sub: Subscriber
+*  msg: Message
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Fanout_Send(uint32_t sub, void *msg)
+{
+    uint32_t ep = benchFanoutConfig[sub].ep0ConfigData.epAddress;
+    uint32_t interruptState;
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    while (CY_IPC_PIPE_SUCCESS != Cy_IPC_Pipe_SendMessage(ep, CY_IPC_EP_CYPIPE_CM7_1_ADDR, msg, NULL))
+    {
+        Cy_SysLib_ExitCriticalSection(interruptState);
+        interruptState = Cy_SysLib_EnterCriticalSection();
+    }
+
+    while (Cy_IPC_Pipe_EndpointIsBusy(CY_IPC_EP_CYPIPE_CM7_1_ADDR))
+    {
+        __WFI();
+        Cy_SysLib_ExitCriticalSection(interruptState);
+        interruptState = Cy_SysLib_EnterCriticalSection();
+    }
+    Cy_SysLib_ExitCriticalSection(interruptState);
+}
+
+/*******************************************************************************
+* Function Name: Bench_Fanout_Fill
+********************************************************************************
+* Summary:
+* Writes the payload, sequence number and send time of a publication.
+*
+* Parameters:
+*  msg: Message, in the channel buffer or in a claimed slot
+*  seq: Sequence number
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Fanout_Fill(cy_stc_bench_msg_t *msg, uint32_t seq)
+{
+    (void)memset(msg->payload, (int)(seq & 0xFFUL), benchConfig.msgSize);
+    msg->seq = seq;
+    msg->sent = Cy_IPC_Stats_Clock();
+}
+
+/*******************************************************************************
+* Function Name: Bench_Fanout_Callback
+********************************************************************************
+* Summary:
+* Client callback of the subscriber endpoints. Consumes a unicast copy, or
+* subscribes to the topic in the slot the message assigns.
+*
+* Parameters:
+*  msgData: Received message
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Fanout_Callback(uint32_t *msgData)
+{
+    cy_stc_bench_msg_t const *msg = (cy_stc_bench_msg_t const *)msgData;
+    cy_stc_ipc_topicmsg_t const *topicMsg = Cy_IPC_Msg_GetTopic(msgData);
+    uint32_t sub;
+
+    if (BENCH_FANOUT_CLIENT_TOPIC == msg->hdr.clientID)
+    {
+        if (NULL != topicMsg)
+        {
+            sub = topicMsg->payload.subscriber;
+            (void)Cy_IPC_PubSub_Subscribe(&benchFanoutSub[sub], topicMsg->payload.topic, sub, benchFanoutNotify[sub]);
+        }
+        return;
+    }
+
+    sub = msg->hdr.pktType;
+    if ((sub >= BENCH_MAX_SUBSCRIBERS) ||
+        (CY_IPC_MSG_SUCCESS != Cy_IPC_Msg_Check(msg, BENCH_MSG_LENGTH(benchConfig.msgSize), NULL)))
+    {
+        benchResult.subscriber[0].errors++;
+        return;
+    }
+    Bench_Fanout_Consume(sub, msg);
+}
+
+/*******************************************************************************
+* Function Name: Bench_Fanout_Service
+********************************************************************************
+* Summary:
+* Pipe interrupt of a subscriber: handles the message in the channel, then
+* takes every new publication of the topic and releases it.
+*
+* Parameters:
+*  sub: Subscriber
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Fanout_Service(uint32_t sub)
+{
+    cy_stc_bench_msg_t const *msg;
+
+    Cy_IPC_Pipe_ExecuteCallback(benchFanoutConfig[sub].ep0ConfigData.epAddress);
+
+    msg = (cy_stc_bench_msg_t const *)Cy_IPC_PubSub_Receive(&benchFanoutSub[sub], NULL);
+    while (NULL != msg)
+    {
+        Bench_Fanout_Consume(sub, msg);
+        Cy_IPC_PubSub_Release(&benchFanoutSub[sub]);
+        msg = (cy_stc_bench_msg_t const *)Cy_IPC_PubSub_Receive(&benchFanoutSub[sub], NULL);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_Fanout_Consume
+********************************************************************************
+* Summary:
+* Reads the whole payload in place, checks sequence and content, and
+* records the latency from the send time while the driver is recording.
+*
+* Parameters:
+*  sub: Subscriber
+*  msg: Publication
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Fanout_Consume(uint32_t sub, cy_stc_bench_msg_t const *msg)
+{
+    cy_stc_bench_sub_result_t *result = &benchResult.subscriber[sub];
+    uint32_t now = Cy_IPC_Stats_Clock();
+    uint32_t size = benchConfig.msgSize;
+    uint32_t sum = 0UL;
+    uint32_t i;
+
+    for (i = 0UL; i < size; i++)
+    {
+        sum += msg->payload[i];
+    }
+
+    if ((msg->seq != benchFanoutNextSeq[sub]) || (sum != (size * (msg->seq & 0xFFUL))))
+    {
+        result->errors++;
+    }
+    benchFanoutNextSeq[sub] = msg->seq + 1UL;
+
+    if (atomic_load_explicit(&benchConfig.recording, memory_order_relaxed))
+    {
+        result->delivered++;
+        Cy_IPC_Stats_Record(&result->latency, CY_IPC_STATS_STAGE_NOTIFY, now - msg->sent);
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,412 @@
+/******************************************************************************
+* File Name:   bench_handoff.c
+*
+* Description: Cache-aware handoff benchmark, linked into every benchmark
+*              image. CM7_0 checks the alignment and maintenance rules of
+*              ipc_handoff, then sends messages out of a handoff pool to
+*              CM7_1, blocking on each release; the pool is cached and
+*              maintained by line, or mapped non-cacheable. CM7_1 checks
+*              every message. The host cache stub counts the lines each
+*              core maintains.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "cy_pdl.h"
+#include "cy_host.h"
+#include "bench.h"
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void Bench_Handoff_SenderIsr(void);
+void Bench_Handoff_ReceiverIsr(void);
+void Bench_Handoff_PoolCallback(uint32_t *msgData);
+void Bench_Handoff_MsgCallback(uint32_t *msgData);
+void Bench_Handoff_Transfer(void *msg);
+uint32_t Bench_Handoff_CheckRules(void);
+
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static cy_stc_ipc_pipe_ep_t benchHandoffEpArray[CY_IPC_MAX_ENDPOINTS];
+static cy_ipc_pipe_callback_ptr_t benchHandoffCb[BENCH_HANDOFF_CLIENT_CNT];
+
+/* The sender sends from EP1, only releases come back */
+static const cy_stc_ipc_pipe_config_t benchHandoffSenderConfig =
+    { CY_IPC_CYPIPE_EP_CONFIG(1), CY_IPC_CYPIPE_EP_CONFIG(2), 0UL, NULL, &Bench_Handoff_SenderIsr };
+
+/* The receiver takes the pool, then the messages on EP2 */
+static const cy_stc_ipc_pipe_config_t benchHandoffReceiverConfig =
+    { CY_IPC_CYPIPE_EP_CONFIG(2), CY_IPC_CYPIPE_EP_CONFIG(1), BENCH_HANDOFF_CLIENT_CNT, benchHandoffCb,
+      &Bench_Handoff_ReceiverIsr };
+
+/* Sender */
+static cy_stc_ipc_handoff_t benchHandoff;
+static CY_ALIGN(BENCH_HANDOFF_POOL_SIZE) uint8_t benchHandoffPool[BENCH_HANDOFF_POOL_SIZE];
+static cy_stc_bench_pool_t benchHandoffPoolMsg;
+static cy_stc_ipc_msg_tx_t benchHandoffTx;
+
+/* Receiver */
+static cy_stc_ipc_handoff_t benchHandoffRx;
+static cy_stc_ipc_msg_rx_t benchHandoffSeq;
+static uint32_t benchHandoffNext;
+
+
+/*******************************************************************************
+* Function Name: Bench_Handoff_Send
+********************************************************************************
+* Summary:
+* Sender role of CM7_0. Checks the handoff rules, sets up its pool in the
+* configured mode and hands it to CM7_1, then sends message n out of the
+* pool forever, with n + i in payload byte i, and waits for each release
+* before it writes the message again.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Handoff_Send(void)
+{
+    uint32_t size = benchConfig.msgSize;
+    cy_stc_bench_msg_t *msg = NULL;
+    uint32_t n;
+    uint32_t i;
+
+    __enable_irq();
+
+    benchResult.ruleErrors = Bench_Handoff_CheckRules();
+
+    Cy_IPC_Pipe_Config(benchHandoffEpArray);
+    Cy_IPC_Pipe_Init(&benchHandoffSenderConfig);
+
+    if (CY_IPC_HANDOFF_SUCCESS == Cy_IPC_Handoff_Init(&benchHandoff, benchHandoffPool, sizeof(benchHandoffPool),
+                                                      benchConfig.handoff))
+    {
+        msg = (cy_stc_bench_msg_t *)Cy_IPC_Handoff_Alloc(&benchHandoff, sizeof(cy_stc_bench_msg_t));
+    }
+    if (NULL == msg)
+    {
+        benchResult.ruleErrors++;
+        for (;;)
+        {
+            __WFI();
+        }
+    }
+
+    /* The release mask is set up front: the pipe rewrites it after the
+     * message has been handed off, it must not change */
+    Cy_IPC_Msg_InitHeader(&benchHandoffPoolMsg.hdr, BENCH_HANDOFF_CLIENT_POOL, 0UL, CY_IPC_CYPIPE_INTR_MASK_EP1,
+                          sizeof(benchHandoffPoolMsg.base) + sizeof(benchHandoffPoolMsg.size));
+    benchHandoffPoolMsg.base = benchHandoff.base;
+    benchHandoffPoolMsg.size = benchHandoff.size;
+    Cy_IPC_Msg_Seal(&benchHandoffPoolMsg, NULL);
+    Cy_IPC_Handoff_SendMsg(&benchHandoff, &benchHandoffPoolMsg);
+    Bench_Handoff_Transfer(&benchHandoffPoolMsg);
+
+    Cy_IPC_Msg_InitHeader(&msg->hdr, BENCH_HANDOFF_CLIENT_MSG, 0UL, CY_IPC_CYPIPE_INTR_MASK_EP1, BENCH_MSG_LENGTH(size));
+    for (n = 0UL; ; n++)
+    {
+        msg->seq = n;
+        for (i = 0UL; i < size; i++)
+        {
+            msg->payload[i] = (uint8_t)(n + i);
+        }
+        msg->sent = Cy_IPC_Stats_Clock();
+        Cy_IPC_Msg_Seal(msg, &benchHandoffTx);
+        Cy_IPC_Handoff_SendMsg(&benchHandoff, msg);
+
+        Bench_Handoff_Transfer(msg);
+        Cy_IPC_Msg_Sent(&benchHandoffTx);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_Handoff_Receive
+********************************************************************************
+* Summary:
+* Receiver role of CM7_1. Sets up the endpoint that receives the pool and
+* the messages, then returns; the caller sleeps. Until the pool arrives it
+* maintains every buffer by line.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Handoff_Receive(void)
+{
+    uint32_t interruptState;
+
+    __enable_irq();
+
+    (void)Cy_IPC_Handoff_Init(&benchHandoffRx, NULL, 0UL, CY_IPC_HANDOFF_CACHED);
+
+    Cy_IPC_Pipe_Config(benchHandoffEpArray);
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    Cy_IPC_Pipe_Init(&benchHandoffReceiverConfig);
+    (void)Cy_IPC_Pipe_RegisterCallback(CY_IPC_EP_CYPIPE_CM7_1_ADDR, &Bench_Handoff_MsgCallback, BENCH_HANDOFF_CLIENT_MSG);
+    (void)Cy_IPC_Pipe_RegisterCallback(CY_IPC_EP_CYPIPE_CM7_1_ADDR, &Bench_Handoff_PoolCallback, BENCH_HANDOFF_CLIENT_POOL);
+    Cy_SysLib_ExitCriticalSection(interruptState);
+}
+
+/*******************************************************************************
+* Function Name: Bench_Handoff_SenderIsr
+********************************************************************************
+* Summary:
+* Pipe interrupt of the sender endpoint, takes the releases.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Handoff_SenderIsr(void)
+{
+    Cy_IPC_Pipe_ExecuteCallback(CY_IPC_EP_CYPIPE_CM7_0_ADDR);
+}
+
+/*******************************************************************************
+* Function Name: Bench_Handoff_ReceiverIsr
+********************************************************************************
+* Summary:
+* Pipe interrupt of the receiver endpoint.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Handoff_ReceiverIsr(void)
+{
+    Cy_IPC_Pipe_ExecuteCallback(CY_IPC_EP_CYPIPE_CM7_1_ADDR);
+}
+
+/*******************************************************************************
+* Function Name: Bench_Handoff_PoolCallback
+********************************************************************************
+* Summary:
+* Client callback of the receiver: CM7_0 hands over its pool, which CM7_1
+* maps in the configured mode as well.
+*
+* Parameters:
+*  msgData: Pool message
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Handoff_PoolCallback(uint32_t *msgData)
+{
+    cy_stc_bench_pool_t const *msg = (cy_stc_bench_pool_t const *)msgData;
+
+    Cy_IPC_Handoff_ReceiveMsg(&benchHandoffRx, msg, sizeof(msg->base) + sizeof(msg->size));
+    if ((CY_IPC_MSG_SUCCESS != Cy_IPC_Msg_Check(msg, sizeof(msg->base) + sizeof(msg->size), NULL)) ||
+        (CY_IPC_HANDOFF_SUCCESS != Cy_IPC_Handoff_Init(&benchHandoffRx, msg->base, msg->size, benchConfig.handoff)))
+    {
+        benchResult.errors++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_Handoff_MsgCallback
+********************************************************************************
+* Summary:
+* Client callback of the receiver: discards the lines of the message in
+* cached mode, checks it with Cy_IPC_Msg_Check(), reads the whole payload
+* and checks sequence and content. Counts it while the driver is
+* recording. No latency is recorded: the histogram is cleaned on every
+* update, which would add to the lines the case measures.
+*
+* Parameters:
+*  msgData: Message out of the pool of CM7_0
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Handoff_MsgCallback(uint32_t *msgData)
+{
+    cy_stc_bench_msg_t const *msg = (cy_stc_bench_msg_t const *)msgData;
+    uint32_t size = benchConfig.msgSize;
+    bool valid;
+    uint32_t i;
+
+    Cy_IPC_Handoff_ReceiveMsg(&benchHandoffRx, msg, BENCH_MSG_LENGTH(BENCH_MAX_MSG_SIZE));
+
+    valid = (CY_IPC_MSG_SUCCESS == Cy_IPC_Msg_Check(msg, BENCH_MSG_LENGTH(size), &benchHandoffSeq)) &&
+            (BENCH_MSG_LENGTH(size) == msg->hdr.length) && (msg->seq == benchHandoffNext);
+    for (i = 0UL; valid && (i < size); i++)
+    {
+        valid = (msg->payload[i] == (uint8_t)(msg->seq + i));
+    }
+    benchHandoffNext = msg->seq + 1UL;
+
+    if (!valid)
+    {
+        benchResult.errors++;
+    }
+    else if (atomic_load_explicit(&benchConfig.recording, memory_order_relaxed))
+    {
+        benchResult.messages++;
+        benchResult.bytes += size;
+    }
+    else
+    {
+        /* Warm-up */
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_Handoff_Transfer
+********************************************************************************
+* Summary:
+* Sends a handed-off message to CM7_1 and waits for its release.
+*
+* Parameters:
+*  msg: Message
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Handoff_Transfer(void *msg)
+{
+    uint32_t interruptState;
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    while (CY_IPC_PIPE_SUCCESS != Cy_IPC_Pipe_SendMessage(CY_IPC_EP_CYPIPE_CM7_1_ADDR, CY_IPC_EP_CYPIPE_CM7_0_ADDR,
+                                                          msg, NULL))
+    {
+        Cy_SysLib_ExitCriticalSection(interruptState);
+        interruptState = Cy_SysLib_EnterCriticalSection();
+    }
+    while (Cy_IPC_Pipe_EndpointIsBusy(CY_IPC_EP_CYPIPE_CM7_0_ADDR))
+    {
+        __WFI();
+        Cy_SysLib_ExitCriticalSection(interruptState);
+        interruptState = Cy_SysLib_EnterCriticalSection();
+    }
+    Cy_SysLib_ExitCriticalSection(interruptState);
+}
+
+/*******************************************************************************
+* Function Name: Bench_Handoff_CheckRules
+********************************************************************************
+* Summary:
+* Checks the rules of ipc_handoff on a scratch buffer, against the lines
+* the cache stub of CM7_0 sees: pools that break the alignment of their
+* mode are refused, an unaligned range is widened to the lines it touches
+* and no further, a message is maintained up to its length only, and
+* nothing inside a non-cacheable pool is maintained. Returns the number
+* of rules broken.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  Rules broken
+*******************************************************************************/
+uint32_t Bench_Handoff_CheckRules(void)
+{
+    static CY_ALIGN(256) uint8_t scratch[256];
+    cy_stc_host_dcache_stats_t before;
+    cy_stc_host_dcache_stats_t after;
+    cy_stc_ipc_handoff_t handoff;
+    uint32_t outside = 0UL;
+    uint32_t errors = 0UL;
+    uint32_t lines;
+
+    /* Line arithmetic */
+    errors += (1UL != Cy_IPC_Handoff_Lines(scratch, CY_IPC_HANDOFF_ALIGN)) ? 1UL : 0UL;
+    errors += (2UL != Cy_IPC_Handoff_Lines(&scratch[CY_IPC_HANDOFF_ALIGN - 4UL], 8UL)) ? 1UL : 0UL;
+    errors += (0UL != Cy_IPC_Handoff_Lines(scratch, 0UL)) ? 1UL : 0UL;
+    errors += !Cy_IPC_Handoff_OwnsLines(scratch, CY_IPC_HANDOFF_ALIGN) ? 1UL : 0UL;
+    errors += Cy_IPC_Handoff_OwnsLines(&scratch[8], CY_IPC_HANDOFF_ALIGN) ? 1UL : 0UL;
+    errors += Cy_IPC_Handoff_OwnsLines(scratch, CY_IPC_HANDOFF_ALIGN + 8UL) ? 1UL : 0UL;
+
+    /* Pools the mode cannot use */
+    errors += (CY_IPC_HANDOFF_ERROR_ALIGN != Cy_IPC_Handoff_Init(&handoff, &scratch[8], CY_IPC_HANDOFF_ALIGN,
+                                                                 CY_IPC_HANDOFF_CACHED)) ? 1UL : 0UL;
+    errors += (CY_IPC_HANDOFF_ERROR_ALIGN != Cy_IPC_Handoff_Init(&handoff, scratch, 96UL,
+                                                                 CY_IPC_HANDOFF_NONCACHEABLE)) ? 1UL : 0UL;
+    errors += (CY_IPC_HANDOFF_ERROR_ALIGN != Cy_IPC_Handoff_Init(&handoff, &scratch[128], 128UL + CY_IPC_HANDOFF_MIN_UNCACHED,
+                                                                 CY_IPC_HANDOFF_NONCACHEABLE)) ? 1UL : 0UL;
+    errors += (CY_IPC_HANDOFF_ERROR_ALIGN != Cy_IPC_Handoff_Init(&handoff, scratch, CY_IPC_HANDOFF_MIN_UNCACHED / 2UL,
+                                                                 CY_IPC_HANDOFF_NONCACHEABLE)) ? 1UL : 0UL;
+    errors += (CY_IPC_HANDOFF_ERROR_BAD_PARAM != Cy_IPC_Handoff_Init(&handoff, NULL, 0UL,
+                                                                     CY_IPC_HANDOFF_NONCACHEABLE)) ? 1UL : 0UL;
+    errors += (CY_IPC_HANDOFF_ERROR_BAD_PARAM != Cy_IPC_Handoff_Init(&handoff, scratch, 0UL,
+                                                                     CY_IPC_HANDOFF_CACHED)) ? 1UL : 0UL;
+
+    /* An unaligned range is widened to the two lines it straddles */
+    errors += (CY_IPC_HANDOFF_SUCCESS != Cy_IPC_Handoff_Init(&handoff, NULL, 0UL, CY_IPC_HANDOFF_CACHED)) ? 1UL : 0UL;
+    Cy_Host_GetDCacheStats(CY_HOST_CORE_CM7_0, &before);
+    Cy_IPC_Handoff_Send(&handoff, &scratch[CY_IPC_HANDOFF_ALIGN - 4UL], 8UL);
+    Cy_Host_GetDCacheStats(CY_HOST_CORE_CM7_0, &after);
+    errors += ((2UL != (after.cleanLines - before.cleanLines)) || ((uintptr_t)scratch != after.lastStart) ||
+               ((2UL * CY_IPC_HANDOFF_ALIGN) != after.lastSize)) ? 1UL : 0UL;
+    Cy_IPC_Handoff_Receive(&handoff, &scratch[CY_IPC_HANDOFF_ALIGN - 4UL], 8UL);
+    Cy_Host_GetDCacheStats(CY_HOST_CORE_CM7_0, &before);
+    errors += (2UL != (before.invalidateLines - after.invalidateLines)) ? 1UL : 0UL;
+
+    /* A message is discarded up to its length, header line first */
+    Cy_IPC_Msg_InitHeader((cy_stc_ipc_msg_hdr_t *)scratch, 0UL, 0UL, 0UL, 100UL);
+    lines = Cy_IPC_Handoff_Lines(scratch, CY_IPC_MSG_PAYLOAD_OFFSET + 100UL);
+    Cy_IPC_Handoff_ReceiveMsg(&handoff, scratch, sizeof(scratch));
+    Cy_Host_GetDCacheStats(CY_HOST_CORE_CM7_0, &after);
+    errors += ((lines != (after.invalidateLines - before.invalidateLines)) ||
+               (((lines > 1UL) ? 2UL : 1UL) != (after.invalidates - before.invalidates))) ? 1UL : 0UL;
+
+    /* Nothing inside a non-cacheable pool is maintained, everything outside is */
+    errors += (CY_IPC_HANDOFF_SUCCESS != Cy_IPC_Handoff_Init(&handoff, scratch, sizeof(scratch),
+                                                             CY_IPC_HANDOFF_NONCACHEABLE)) ? 1UL : 0UL;
+    Cy_IPC_Handoff_Send(&handoff, &scratch[CY_IPC_HANDOFF_ALIGN], CY_IPC_HANDOFF_ALIGN);
+    Cy_IPC_Handoff_Receive(&handoff, &scratch[CY_IPC_HANDOFF_ALIGN], CY_IPC_HANDOFF_ALIGN);
+    Cy_Host_GetDCacheStats(CY_HOST_CORE_CM7_0, &before);
+    errors += ((after.cleanLines != before.cleanLines) || (after.invalidateLines != before.invalidateLines)) ? 1UL : 0UL;
+    Cy_IPC_Handoff_Send(&handoff, &outside, sizeof(outside));
+    Cy_Host_GetDCacheStats(CY_HOST_CORE_CM7_0, &after);
+    errors += ((1UL != (after.cleanLines - before.cleanLines)) || (0UL != after.uncachedLines)) ? 1UL : 0UL;
+
+    return errors;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,1809 @@
+/******************************************************************************
+* File Name:   bench_main.c
+*
+* Description: Benchmark driver. Sweeps send mode, consumer mode (ISR or
+*              deferred), producer count, message size and batch size.
+*              Each case runs the benchmark images on the host emulator in
+*              a child process. Prints msgs/s, bytes/s, latency and channel
+*              hold time percentiles as CSV or JSON, and fails when a case
+*              regresses against a baseline CSV. With -x it sweeps the
+*              offered message rate instead, for an ISR and an adaptive
+*              consumer, to show where polling starts to pay off. With -s
+*              it saturates a slowed consumer once per credit policy and
+*              fails unless the policy held and no message was lost. With
+*              -p it publishes to 1 to 4 subscribers, as a copy to each one
+*              and once on a pub/sub topic, to show the fan-out cost. With
+*              -w it reads a seqlock snapshot on three cores while CM7_1
+*              rewrites it, and fails on any torn snapshot. With -R it
+*              replays the sends of CM7_0 and CM7_1 captured in ipc_trace
+*              ring dumps, -S times faster, against each consumer mode.
+*              With -d it streams sample blocks from CM7_0 to CM0+ at a
+*              fixed rate in bytes/s, against consumers faster and slower
+*              than the stream, and fails unless the overruns, underruns
+*              and lost blocks show it. With -c it hands messages of each
+*              size from CM7_0 to CM7_1 out of a cached and a
+*              non-cacheable pool, prints the lines maintained per message
+*              with a CM7 cycle model of both, and fails on maintenance
+*              beyond the lines of a message. With -o it has CM0+ offload
+*              jobs of each length to one and to two CM7 workers through
+*              the work-stealing queue, spread or all to CM7_0, prints the
+*              jobs/s and the speedup of two workers, and fails unless the
+*              second worker takes a share, by stealing when the jobs are
+*              pinned, and two workers scale on the longest jobs. The
+*              default sweep ends with two RPC rows, CM7_0 calling CM0+
+*              with one call in flight and with a full window.
+*              Usage: ipc_bench [-t seconds] [-f csv|json] [-b baseline.csv]
+*                               [-r throughput%] [-l latency%] [-x] [-s] [-p]
+*                               [-w] [-d] [-c] [-o] [-R [-S speed] dump.bin...]
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include "cy_host.h"
+#include "bench.h"
+#include "trace.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BENCH_RUN_TIME_S                (0.25)  /* Measured time per case */
+#define BENCH_WARMUP_S                  (0.05)  /* Not measured, rings and caches fill */
+#define BENCH_TIMEOUT_S                 (5U)    /* A case that takes longer than this hung */
+#define BENCH_THROUGHPUT_THRESHOLD      (10.0)  /* Allowed msgs/s drop in % */
+#define BENCH_LATENCY_THRESHOLD         (50.0)  /* Allowed p99 latency rise in % */
+#define BENCH_MAX_ROWS                  (64UL)
+#define BENCH_STRESS_WINDOW             (8UL)   /* Credits per producer in the stress run */
+#define BENCH_STRESS_WORK_NS            (20000UL) /* Consumer time per message in the stress run */
+#define BENCH_REPLAY_MAX_PERIOD_NS      (2000000000.0) /* Longest replayed capture, the producers pace with 32-bit ns */
+#define BENCH_STREAM_RATE               (2048000UL) /* Stream bytes/s, a 1024-byte block every 500 us */
+#define BENCH_STREAM_BLOCK_SIZE         (1024UL)
+#define BENCH_OFFLOAD_MIN_SPEEDUP       (1.5)   /* Two workers against one, on the longest jobs */
+
+/* Handoff: cost model of a message on the CM7, in cycles. The host cannot
+ * time cache operations, so the lines the stub counted are priced with
+ * these assumed figures, to be replaced by measurements on the device */
+#define BENCH_CM7_LINE                  (32UL)  /* CM7 D-cache line, bytes */
+#define BENCH_CYCLES_MAINT_OP           (40UL)  /* Call, loop set-up and DSB/ISB of one clean or invalidate */
+#define BENCH_CYCLES_CLEAN_LINE         (12UL)  /* Write a dirty line back to SRAM */
+#define BENCH_CYCLES_DISCARD_LINE       (16UL)  /* Invalidate a line and refill it on the first read */
+#define BENCH_CYCLES_CACHED_WORD        (1UL)   /* Word access that hits the cache */
+#define BENCH_CYCLES_UNCACHED_WRITE     (1UL)   /* Word write to non-cacheable SRAM, buffered */
+#define BENCH_CYCLES_UNCACHED_READ      (8UL)   /* Word read from non-cacheable SRAM */
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef struct
+{
+    cy_en_bench_mode_t mode;
+    cy_en_bench_rx_t rx;
+    uint32_t producers;
+    uint32_t msgSize;
+    uint32_t batch;
+    uint32_t rate;              /* Offered msgs/s per producer, 0 for unpaced */
+    bool control;               /* Control lane pings */
+    cy_en_ipc_credit_policy_t policy;
+    uint32_t window;            /* Credits per producer */
+    uint32_t work;              /* Consumer ns per message */
+    uint32_t subscribers;       /* Fan-out modes */
+    double msgsPerS;
+    double bytesPerS;
+    uint32_t p50;               /* ns */
+    uint32_t p99;               /* ns */
+    uint32_t max;               /* ns */
+    uint32_t holdP50;           /* ns a consumer channel was locked per message */
+    uint32_t holdP99;           /* ns */
+    uint32_t ctlP50;            /* ns from send to consumer of a control lane ping */
+    uint32_t ctlP99;            /* ns */
+    uint32_t busy;              /* Sends that found a consumer channel locked */
+    uint32_t errors;
+    double irqsPerMsg;          /* Consumer interrupts per message */
+    double cpuPct;              /* Consumer CPU time in % of the run time */
+    double pollPct;             /* Adaptive consumer: time in poll mode in % */
+    uint32_t stalls;            /* Producers out of credit, whole run */
+    uint32_t queued;            /* Messages that waited in a producer backlog, whole run */
+    uint32_t drops;             /* Messages dropped for lack of credit, whole run */
+    uint32_t pubP50;            /* ns the publisher spent per publication */
+    uint32_t pubP99;            /* ns */
+    double updatesPerS;         /* Seqlock snapshots written */
+    uint32_t retries;           /* Seqlock copies torn and retried */
+    uint32_t readBusy;          /* Seqlock reads given up */
+    uint32_t torn;              /* Plain copies that mixed two updates */
+    uint32_t idleReaders;       /* Seqlock readers without a snapshot */
+    double offeredPerS;         /* Replay: captured sends per second, all producers; stream: bytes/s produced */
+    uint32_t buffers;           /* Stream: block buffers */
+    uint32_t load;              /* Stream: consumer time per block in % of the block period */
+    uint32_t overruns;          /* Stream: blocks dropped by the producer */
+    uint32_t underruns;         /* Stream: blocks due at the consumer while none was ready */
+    uint32_t lost;              /* Stream: blocks the consumer found missing */
+    uint32_t unaccounted;       /* Stream: blocks dropped in the whole run but not seen missing or still ahead */
+    cy_en_ipc_handoff_mode_t handoff; /* Handoff: pool strategy */
+    uint32_t handedOff;         /* Handoff: messages received */
+    uint32_t msgLines;          /* Handoff: lines of one message, host cache line */
+    uint32_t cleanLines;        /* Handoff: lines written back by CM7_0 and CM7_1 */
+    uint32_t invalLines;        /* Handoff: lines discarded by CM7_0 and CM7_1 */
+    uint32_t maintOps;          /* Handoff: clean and invalidate calls */
+    uint32_t uncachedLines;     /* Handoff: lines maintained inside a non-cacheable pool, whole run */
+    uint32_t ruleErrors;        /* Handoff: rules of ipc_handoff that CM7_0 found broken */
+    double modelCycles;         /* Handoff: modelled CM7 cycles per message */
+    uint32_t workers;           /* Offload: CM7 workers */
+    bool pinned;                /* Offload: every job submitted to CM7_0 */
+    uint32_t jobs[BENCH_MAX_PRODUCERS]; /* Offload: jobs each worker completed */
+    uint32_t stolen;            /* Offload: completed jobs that were stolen */
+    uint32_t sleeps;            /* Offload: times the workers went to sleep, whole run */
+    uint32_t doorbells;         /* Offload: doorbells a worker rang for another, whole run */
+    double speedup;             /* Offload: jobs/s against the one-worker case of the same jobs */
+} cy_stc_bench_row_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+/* main() of each benchmark image, renamed by the host Makefile */
+int Bench_Main_Cm0p(void);
+int Bench_Main_Cm7_0(void);
+int Bench_Main_Cm7_1(void);
+
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+cy_stc_bench_config_t benchConfig;
+cy_stc_bench_result_t benchResult;
+cy_stc_bench_replay_t benchReplay;
+
+static const uint32_t benchSizes[] = { 8UL, 64UL, 256UL, 1024UL };
+static const uint32_t benchBatches[] = { 1UL, 8UL };
+static char const *const benchModeNames[] = { "blocking", "queued", "unicast", "pubsub", "seqlock", "replay", "stream",
+                                               "handoff", "offload", "rpc" };
+static char const *const benchRxNames[] = { "isr", "deferred", "adaptive", "paced" };
+static char const *const benchPolicyNames[] = { "block", "queue", "drop" };
+static char const *const benchHandoffNames[] = { "cached", "noncacheable" };
+
+/* Offered rates of the crossover sweep, msgs/s; 0 is unpaced */
+static const uint32_t benchRates[] = { 1000UL, 5000UL, 10000UL, 20000UL, 50000UL, 100000UL, 200000UL, 0UL };
+
+/* Stream sweep: buffers, and consumer time per block in % of the block period */
+static const uint32_t benchStreamBuffers[] = { 2UL, 4UL };
+static const uint32_t benchStreamLoads[] = { 50UL, 90UL, 150UL, 300UL };
+
+/* Offload sweep: job length, ns */
+static const uint32_t benchOffloadWork[] = { 10000UL, 100000UL, 1000000UL };
+
+
+/*******************************************************************************
+* Function Name: Bench_Sleep
+********************************************************************************
+* Summary:
+* Sleeps for a time in seconds.
+*
+*******************************************************************************/
+static void Bench_Sleep(double seconds)
+{
+    struct timespec ts;
+
+    ts.tv_sec = (time_t)seconds;
+    ts.tv_nsec = (long)((seconds - (double)ts.tv_sec) * 1e9);
+    while (0 != nanosleep(&ts, &ts))
+    {
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_Now
+********************************************************************************
+* Summary:
+* Returns the monotonic time in seconds.
+*
+*******************************************************************************/
+static double Bench_Now(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9);
+}
+
+/*******************************************************************************
+* Function Name: Bench_GetFanout
+********************************************************************************
+* Summary:
+* Fills the row of a fan-out case: a publication counts once every
+* subscriber has it, latency is that of the slowest subscriber.
+*
+*******************************************************************************/
+static void Bench_GetFanout(cy_stc_bench_row_t *row, double elapsed)
+{
+    cy_stc_ipc_stats_summary_t summary;
+    uint32_t delivered = UINT32_MAX;
+    uint32_t i;
+
+    row->p50 = 0UL;
+    row->p99 = 0UL;
+    row->max = 0UL;
+    for (i = 0UL; i < row->subscribers; i++)
+    {
+        cy_stc_bench_sub_result_t *sub = &benchResult.subscriber[i];
+
+        delivered = (sub->delivered < delivered) ? sub->delivered : delivered;
+        row->errors += sub->errors;
+        Cy_IPC_Stats_GetSummary(&sub->latency, CY_IPC_STATS_STAGE_NOTIFY, &summary);
+        row->p50 = (summary.p50 > row->p50) ? summary.p50 : row->p50;
+        row->p99 = (summary.p99 > row->p99) ? summary.p99 : row->p99;
+        row->max = (summary.max > row->max) ? summary.max : row->max;
+    }
+
+    row->msgsPerS = (double)delivered / elapsed;
+    row->bytesPerS = row->msgsPerS * (double)row->msgSize * (double)row->subscribers;
+    Cy_IPC_Stats_GetSummary(&benchResult.publish, CY_IPC_STATS_STAGE_SEND, &summary);
+    row->pubP50 = summary.p50;
+    row->pubP99 = summary.p99;
+    row->stalls = benchResult.pubStalls;
+}
+
+/*******************************************************************************
+* Function Name: Bench_GetSeqlock
+********************************************************************************
+* Summary:
+* Fills the row of a seqlock case from the counts of all readers.
+*
+*******************************************************************************/
+static void Bench_GetSeqlock(cy_stc_bench_row_t *row, double elapsed)
+{
+    uint32_t reads = 0UL;
+    uint32_t i;
+
+    row->retries = 0UL;
+    row->readBusy = 0UL;
+    row->torn = 0UL;
+    row->idleReaders = 0UL;
+    for (i = 0UL; i < BENCH_SEQLOCK_READERS; i++)
+    {
+        cy_stc_bench_reader_result_t *reader = &benchResult.reader[i];
+
+        reads += reader->reads;
+        row->retries += reader->retries;
+        row->readBusy += reader->busy;
+        row->torn += reader->torn;
+        row->errors += reader->errors;
+        if (0UL == reader->reads)
+        {
+            row->idleReaders++;
+        }
+    }
+
+    row->msgsPerS = (double)reads / elapsed;
+    row->updatesPerS = (double)benchResult.updates / elapsed;
+}
+
+/*******************************************************************************
+* Function Name: Bench_GetStream
+********************************************************************************
+* Summary:
+* Fills the row of a stream case: the rate the producer completed blocks
+* at, and its overruns against the underruns and gaps of the consumer.
+* The producer has stopped, so the final counts of the stream must add up:
+* every block it dropped is a gap the consumer found, or lies ahead of the
+* next block the consumer expects.
+*
+*******************************************************************************/
+static void Bench_GetStream(cy_stc_bench_row_t *row, double elapsed)
+{
+    cy_stc_ipc_stream_t const *stream = benchResult.stream;
+    uint32_t ahead;
+
+    row->offeredPerS = ((double)benchResult.blocks * (double)row->msgSize) / elapsed;
+    row->overruns = benchResult.overruns;
+    row->underruns = benchResult.underruns;
+    row->lost = benchResult.lost;
+    row->unaccounted = 0UL;
+    if (NULL != stream)
+    {
+        /* Numbered from next on: the committed blocks not released, and drops */
+        ahead = (stream->seq - stream->next) - (IPC_PORT_LOAD_RELAXED(&stream->filled) - IPC_PORT_LOAD_RELAXED(&stream->consumed));
+        row->unaccounted = stream->overruns - (stream->lost + ahead);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_GetDCache
+********************************************************************************
+* Summary:
+* Reads the cache maintenance of CM7_0 and CM7_1 together.
+*
+*******************************************************************************/
+static void Bench_GetDCache(cy_stc_host_dcache_stats_t *stats)
+{
+    cy_stc_host_dcache_stats_t cm7_1;
+
+    Cy_Host_GetDCacheStats(CY_HOST_CORE_CM7_0, stats);
+    Cy_Host_GetDCacheStats(CY_HOST_CORE_CM7_1, &cm7_1);
+    stats->cleans += cm7_1.cleans;
+    stats->cleanLines += cm7_1.cleanLines;
+    stats->invalidates += cm7_1.invalidates;
+    stats->invalidateLines += cm7_1.invalidateLines;
+    stats->uncachedLines += cm7_1.uncachedLines;
+}
+
+/*******************************************************************************
+* Function Name: Bench_GetConsumerChannels
+********************************************************************************
+* Summary:
+* Reads the channels of both consumer endpoints together, EP0 of CM7_0 and
+* EP5 of CM7_1.
+*
+*******************************************************************************/
+static void Bench_GetConsumerChannels(cy_stc_host_chan_stats_t *stats)
+{
+    cy_stc_host_chan_stats_t cm7_1;
+
+    Cy_Host_GetChannelStats(CY_IPC_CHAN_CYPIPE_EP0, stats);
+    Cy_Host_GetChannelStats(CY_IPC_CHAN_CYPIPE_EP5, &cm7_1);
+    stats->sends += cm7_1.sends;
+    stats->busy += cm7_1.busy;
+    stats->releases += cm7_1.releases;
+}
+
+/*******************************************************************************
+* Function Name: Bench_GetHandoff
+********************************************************************************
+* Summary:
+* Fills the row of a handoff case: the lines maintained while recording,
+* and the cost of one message in the CM7 model. Host lines are converted
+* to CM7 lines of the same message, the words of a message are written
+* once and read once.
+*
+*******************************************************************************/
+static void Bench_GetHandoff(cy_stc_bench_row_t *row, cy_stc_host_dcache_stats_t const *before,
+                             cy_stc_host_dcache_stats_t const *after)
+{
+    double cm7Lines = (double)((BENCH_MSG_BYTES(row->msgSize) + BENCH_CM7_LINE - 1UL) / BENCH_CM7_LINE);
+    double words = (double)(BENCH_MSG_BYTES(row->msgSize) / sizeof(uint32_t));
+    double messages;
+    double scale;
+
+    row->handedOff = benchResult.messages;
+    row->msgLines = CY_IPC_HANDOFF_SIZE(BENCH_MSG_BYTES(row->msgSize)) / CY_IPC_HANDOFF_ALIGN;
+    row->cleanLines = after->cleanLines - before->cleanLines;
+    row->invalLines = after->invalidateLines - before->invalidateLines;
+    row->maintOps = (after->cleans - before->cleans) + (after->invalidates - before->invalidates);
+    row->uncachedLines = after->uncachedLines;
+    row->ruleErrors = benchResult.ruleErrors;
+
+    messages = (0UL != row->handedOff) ? (double)row->handedOff : 1.0;
+    scale = cm7Lines / (double)row->msgLines;
+    row->modelCycles = (((double)row->maintOps * (double)BENCH_CYCLES_MAINT_OP) +
+                        ((double)row->cleanLines * scale * (double)BENCH_CYCLES_CLEAN_LINE) +
+                        ((double)row->invalLines * scale * (double)BENCH_CYCLES_DISCARD_LINE)) / messages;
+    row->modelCycles += words * ((CY_IPC_HANDOFF_CACHED == row->handoff) ?
+                                 (2.0 * (double)BENCH_CYCLES_CACHED_WORD) :
+                                 (double)(BENCH_CYCLES_UNCACHED_WRITE + BENCH_CYCLES_UNCACHED_READ));
+}
+
+/*******************************************************************************
+* Function Name: Bench_GetOffload
+********************************************************************************
+* Summary:
+* Fills the row of an offload case: the jobs of each worker and the stolen
+* ones while recording, and from the queue the sleeps and doorbells of the
+* workers over the whole run. The driver links no queue code, it reads
+* the counters directly, as Cy_IPC_Work_GetStats() does.
+*
+*******************************************************************************/
+static void Bench_GetOffload(cy_stc_bench_row_t *row)
+{
+    uint32_t i;
+
+    row->stolen = benchResult.stolenJobs;
+    row->sleeps = 0UL;
+    row->doorbells = 0UL;
+    for (i = 0UL; i < BENCH_MAX_PRODUCERS; i++)
+    {
+        row->jobs[i] = benchResult.jobs[i];
+        if ((NULL != benchResult.work) && (i < row->workers))
+        {
+            row->sleeps += benchResult.work->deque[i].sleeps;
+            row->doorbells += benchResult.work->deque[i].rung;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_LoadReplay
+********************************************************************************
+* Summary:
+* Fills benchReplay with the pipe messages of CM7_0 and CM7_1 that got the
+* channel in a capture, at their send time, speed times faster, and with
+* their payload size up to BENCH_MAX_MSG_SIZE. The first replayed send is
+* at 0, the schedule repeats at the end of the capture. A core with sends
+* becomes the next producer. Returns false if the dumps cannot be read,
+* have no clock rate or no such sends, or the schedule is too long.
+*
+*******************************************************************************/
+static bool Bench_LoadReplay(char const *const paths[], uint32_t count, double speed, uint32_t *producers)
+{
+    cy_stc_trace_t trace;
+    cy_stc_trace_msg_t *msgs;
+    uint32_t producer[CY_IPC_CORE_CM7_1 + 1UL] = { BENCH_MAX_PRODUCERS, BENCH_MAX_PRODUCERS, BENCH_MAX_PRODUCERS };
+    int64_t first = INT64_MAX;
+    double scale;
+    double period;
+    uint32_t messages;
+    uint32_t i;
+    bool ok = false;
+
+    (void)memset(&benchReplay, 0, sizeof(benchReplay));
+    *producers = 0UL;
+    if (!Trace_Load(&trace, paths, count))
+    {
+        return false;
+    }
+    if ((0UL == trace.clockHz) || (speed <= 0.0))
+    {
+        (void)fprintf(stderr, "replay needs dumps with a clock rate, and a speed above 0\n");
+        Trace_Free(&trace);
+        return false;
+    }
+    scale = 1e9 / ((double)trace.clockHz * speed);
+
+    messages = Trace_Messages(&trace, &msgs);
+    for (i = 0UL; i < messages; i++)
+    {
+        cy_stc_trace_msg_t const *m = &msgs[i];
+
+        if (((CY_IPC_CORE_CM7_0 == m->core) || (CY_IPC_CORE_CM7_1 == m->core)) &&
+            ((TRACE_NO_TIME != m->t[TRACE_STAGE_LOCK]) || (TRACE_NO_TIME != m->t[TRACE_STAGE_DONE])))
+        {
+            if (BENCH_MAX_PRODUCERS == producer[m->core])
+            {
+                producer[m->core] = (*producers)++;
+            }
+            first = (m->t[TRACE_STAGE_SEND] < first) ? m->t[TRACE_STAGE_SEND] : first;
+        }
+    }
+
+    period = (0UL != *producers) ? (((double)(trace.event[trace.count - 1UL].t - first) * scale) + 1.0) : 0.0;
+    if (0UL == *producers)
+    {
+        (void)fprintf(stderr, "no sends of CM7_0 or CM7_1 to replay\n");
+    }
+    else if (period > BENCH_REPLAY_MAX_PERIOD_NS)
+    {
+        (void)fprintf(stderr, "capture of %.3f s is too long to replay, raise the speed\n", period * 1e-9);
+    }
+    else
+    {
+        benchReplay.period = (uint32_t)period;
+        for (i = 0UL; i < messages; i++)
+        {
+            cy_stc_trace_msg_t const *m = &msgs[i];
+            uint32_t p = (m->core <= CY_IPC_CORE_CM7_1) ? producer[m->core] : BENCH_MAX_PRODUCERS;
+            uint32_t bytes = (m->bytes < BENCH_MAX_MSG_SIZE) ? m->bytes : BENCH_MAX_MSG_SIZE;
+
+            if ((p < BENCH_MAX_PRODUCERS) && (benchReplay.count[p] < BENCH_REPLAY_MAX_SENDS) &&
+                ((TRACE_NO_TIME != m->t[TRACE_STAGE_LOCK]) || (TRACE_NO_TIME != m->t[TRACE_STAGE_DONE])))
+            {
+                benchReplay.send[p][benchReplay.count[p]].at = (uint32_t)((double)(m->t[TRACE_STAGE_SEND] - first) * scale);
+                benchReplay.send[p][benchReplay.count[p]].size = bytes;
+                benchReplay.count[p]++;
+            }
+        }
+        ok = true;
+    }
+
+    free(msgs);
+    Trace_Free(&trace);
+    return ok;
+}
+
+/*******************************************************************************
+* Function Name: Bench_RunChild
+********************************************************************************
+* Summary:
+* Runs one case in the calling (child) process and fills the row. The
+* emulator threads cannot be stopped, so every case gets a fresh process.
+*
+*******************************************************************************/
+static void Bench_RunChild(cy_stc_bench_row_t *row, double seconds)
+{
+    static cy_host_entry_t const entry[CY_HOST_CORE_COUNT] =
+    {
+        &Bench_Main_Cm0p,
+        &Bench_Main_Cm7_0,
+        &Bench_Main_Cm7_1,
+    };
+    cy_stc_host_chan_stats_t before;
+    cy_stc_host_chan_stats_t after;
+    cy_stc_host_core_stats_t coreBefore;
+    cy_stc_host_core_stats_t coreAfter;
+    cy_stc_host_dcache_stats_t cacheBefore;
+    cy_stc_host_dcache_stats_t cacheAfter;
+    cy_stc_ipc_stats_summary_t summary;
+    double start;
+    double elapsed;
+    uint64_t adaptTicks;
+    uint32_t i;
+
+    benchConfig.mode = row->mode;
+    benchConfig.producers = row->producers;
+    benchConfig.msgSize = row->msgSize;
+    benchConfig.batch = row->batch;
+    benchConfig.rate = row->rate;
+    benchConfig.rx = row->rx;
+    benchConfig.control = row->control;
+    benchConfig.policy = row->policy;
+    benchConfig.window = row->window;
+    benchConfig.work = row->work;
+    benchConfig.subscribers = row->subscribers;
+    benchConfig.buffers = row->buffers;
+    benchConfig.handoff = row->handoff;
+    benchConfig.workers = row->workers;
+    benchConfig.pinned = row->pinned;
+    atomic_init(&benchConfig.recording, false);
+    Cy_IPC_Stats_Init(&benchResult.latency);
+    Cy_IPC_Stats_Init(&benchResult.control);
+    Cy_IPC_Stats_Init(&benchResult.publish);
+    for (i = 0UL; i < BENCH_MAX_SUBSCRIBERS; i++)
+    {
+        Cy_IPC_Stats_Init(&benchResult.subscriber[i].latency);
+    }
+
+    Cy_Host_Init(entry);
+    Cy_Host_StartCore(CY_HOST_CORE_CM0P);
+
+    Bench_Sleep(BENCH_WARMUP_S);
+    Bench_GetConsumerChannels(&before);
+    Cy_Host_GetCoreStats(CY_HOST_CORE_CM0P, &coreBefore);
+    Bench_GetDCache(&cacheBefore);
+    start = Bench_Now();
+    atomic_store(&benchConfig.recording, true);
+
+    Bench_Sleep(seconds);
+
+    atomic_store(&benchConfig.recording, false);
+    elapsed = Bench_Now() - start;
+    Bench_GetConsumerChannels(&after);
+    Cy_Host_GetCoreStats(CY_HOST_CORE_CM0P, &coreAfter);
+    Bench_GetDCache(&cacheAfter);
+
+    /* Let a message that was being recorded finish */
+    Bench_Sleep(0.01);
+    Cy_IPC_Stats_GetSummary(&benchResult.latency, CY_IPC_STATS_STAGE_NOTIFY, &summary);
+
+    row->msgsPerS = (double)benchResult.messages / elapsed;
+    row->bytesPerS = (double)benchResult.bytes / elapsed;
+    row->p50 = summary.p50;
+    row->p99 = summary.p99;
+    row->max = summary.max;
+    Cy_IPC_Stats_GetSummary(&benchResult.latency, CY_IPC_STATS_STAGE_RELEASE, &summary);
+    row->holdP50 = summary.p50;
+    row->holdP99 = summary.p99;
+    Cy_IPC_Stats_GetSummary(&benchResult.control, CY_IPC_STATS_STAGE_NOTIFY, &summary);
+    row->ctlP50 = summary.p50;
+    row->ctlP99 = summary.p99;
+    row->busy = after.busy - before.busy;
+    row->errors = benchResult.errors;
+    row->irqsPerMsg = (0UL != benchResult.messages) ?
+                      ((double)(coreAfter.interrupts - coreBefore.interrupts) / (double)benchResult.messages) : 0.0;
+    row->cpuPct = ((double)(coreAfter.cpuNs - coreBefore.cpuNs) * 1e-9 * 100.0) / elapsed;
+
+    /* Whole run, including the warm-up */
+    adaptTicks = benchResult.adapt.ticks[CY_IPC_ADAPT_MODE_IRQ] + benchResult.adapt.ticks[CY_IPC_ADAPT_MODE_POLL];
+    row->pollPct = (0ULL != adaptTicks) ?
+                   (((double)benchResult.adapt.ticks[CY_IPC_ADAPT_MODE_POLL] * 100.0) / (double)adaptTicks) : 0.0;
+
+    /* As of the last grant, whole run */
+    row->stalls = 0UL;
+    row->queued = 0UL;
+    row->drops = 0UL;
+    for (i = 0UL; i < BENCH_MAX_PRODUCERS; i++)
+    {
+        row->stalls += benchResult.producer[i].credit.stalls;
+        row->queued += benchResult.producer[i].credit.queued;
+        row->drops += benchResult.producer[i].credit.drops;
+    }
+
+    if (0UL != row->subscribers)
+    {
+        Bench_GetFanout(row, elapsed);
+    }
+    if (BENCH_MODE_SEQLOCK == row->mode)
+    {
+        Bench_GetSeqlock(row, elapsed);
+    }
+    if (BENCH_MODE_STREAM == row->mode)
+    {
+        Bench_GetStream(row, elapsed);
+    }
+    if (BENCH_MODE_HANDOFF == row->mode)
+    {
+        Bench_GetHandoff(row, &cacheBefore, &cacheAfter);
+    }
+    if (BENCH_MODE_OFFLOAD == row->mode)
+    {
+        Bench_GetOffload(row);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_Run
+********************************************************************************
+* Summary:
+* Runs one case in a child process. Returns false if the child crashed or
+* hung.
+*
+*******************************************************************************/
+static bool Bench_Run(cy_stc_bench_row_t *row, cy_stc_bench_row_t *shared, double seconds)
+{
+    pid_t pid;
+    int status;
+
+    *shared = *row;
+    (void)fflush(NULL);
+
+    pid = fork();
+    if (pid < 0)
+    {
+        return false;
+    }
+    if (0 == pid)
+    {
+        (void)alarm((unsigned int)(seconds + BENCH_WARMUP_S) + BENCH_TIMEOUT_S);
+        Bench_RunChild(shared, seconds);
+        _exit(EXIT_SUCCESS);
+    }
+
+    if ((pid != waitpid(pid, &status, 0)) || !WIFEXITED(status) || (EXIT_SUCCESS != WEXITSTATUS(status)))
+    {
+        return false;
+    }
+
+    *row = *shared;
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: Bench_Print
+********************************************************************************
+* Summary:
+* Prints the results as CSV or as a JSON array.
+*
+*******************************************************************************/
+static void Bench_Print(cy_stc_bench_row_t const *rows, uint32_t count, bool json)
+{
+    uint32_t i;
+
+    if (json)
+    {
+        (void)printf("[\n");
+    }
+    else
+    {
+        (void)printf("mode,rx,producers,msg_size,batch,msgs_per_s,bytes_per_s,lat_p50_ns,lat_p99_ns,lat_max_ns,"
+                     "hold_p50_ns,hold_p99_ns,ctl_p50_ns,ctl_p99_ns,busy,irqs_per_msg,errors\n");
+    }
+
+    for (i = 0UL; i < count; i++)
+    {
+        cy_stc_bench_row_t const *row = &rows[i];
+
+        if (json)
+        {
+            (void)printf("  {\"mode\": \"%s\", \"rx\": \"%s\", \"producers\": %u, \"msg_size\": %u, \"batch\": %u, "
+                         "\"msgs_per_s\": %.0f, \"bytes_per_s\": %.0f, \"lat_p50_ns\": %u, \"lat_p99_ns\": %u, "
+                         "\"lat_max_ns\": %u, \"hold_p50_ns\": %u, \"hold_p99_ns\": %u, \"ctl_p50_ns\": %u, \"ctl_p99_ns\": %u, \"busy\": %u, "
+                         "\"irqs_per_msg\": %.3f, \"errors\": %u}%s\n",
+                         benchModeNames[row->mode], benchRxNames[row->rx], (unsigned int)row->producers,
+                         (unsigned int)row->msgSize, (unsigned int)row->batch, row->msgsPerS, row->bytesPerS,
+                         (unsigned int)row->p50, (unsigned int)row->p99, (unsigned int)row->max,
+                         (unsigned int)row->holdP50, (unsigned int)row->holdP99, (unsigned int)row->ctlP50,
+                         (unsigned int)row->ctlP99, (unsigned int)row->busy, row->irqsPerMsg, (unsigned int)row->errors,
+                         ((i + 1UL) < count) ? "," : "");
+        }
+        else
+        {
+            (void)printf("%s,%s,%u,%u,%u,%.0f,%.0f,%u,%u,%u,%u,%u,%u,%u,%u,%.3f,%u\n",
+                         benchModeNames[row->mode], benchRxNames[row->rx], (unsigned int)row->producers,
+                         (unsigned int)row->msgSize, (unsigned int)row->batch, row->msgsPerS, row->bytesPerS,
+                         (unsigned int)row->p50, (unsigned int)row->p99, (unsigned int)row->max,
+                         (unsigned int)row->holdP50, (unsigned int)row->holdP99, (unsigned int)row->ctlP50,
+                         (unsigned int)row->ctlP99, (unsigned int)row->busy, row->irqsPerMsg, (unsigned int)row->errors);
+        }
+    }
+
+    if (json)
+    {
+        (void)printf("]\n");
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_PrintRates
+********************************************************************************
+* Summary:
+* Prints the results of the rate sweep as CSV or as a JSON array.
+*
+*******************************************************************************/
+static void Bench_PrintRates(cy_stc_bench_row_t const *rows, uint32_t count, bool json)
+{
+    uint32_t i;
+
+    if (json)
+    {
+        (void)printf("[\n");
+    }
+    else
+    {
+        (void)printf("rate,rx,msgs_per_s,lat_p50_ns,lat_p99_ns,irqs_per_msg,cpu_pct,poll_pct,errors\n");
+    }
+
+    for (i = 0UL; i < count; i++)
+    {
+        cy_stc_bench_row_t const *row = &rows[i];
+
+        if (json)
+        {
+            (void)printf("  {\"rate\": %u, \"rx\": \"%s\", \"msgs_per_s\": %.0f, \"lat_p50_ns\": %u, \"lat_p99_ns\": %u, "
+                         "\"irqs_per_msg\": %.3f, \"cpu_pct\": %.1f, \"poll_pct\": %.1f, \"errors\": %u}%s\n",
+                         (unsigned int)row->rate, benchRxNames[row->rx], row->msgsPerS, (unsigned int)row->p50,
+                         (unsigned int)row->p99, row->irqsPerMsg, row->cpuPct, row->pollPct,
+                         (unsigned int)row->errors, ((i + 1UL) < count) ? "," : "");
+        }
+        else
+        {
+            (void)printf("%u,%s,%.0f,%u,%u,%.3f,%.1f,%.1f,%u\n",
+                         (unsigned int)row->rate, benchRxNames[row->rx], row->msgsPerS, (unsigned int)row->p50,
+                         (unsigned int)row->p99, row->irqsPerMsg, row->cpuPct, row->pollPct,
+                         (unsigned int)row->errors);
+        }
+    }
+
+    if (json)
+    {
+        (void)printf("]\n");
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_PrintStress
+********************************************************************************
+* Summary:
+* Prints the results of the flow control stress run as CSV or as a JSON
+* array.
+*
+*******************************************************************************/
+static void Bench_PrintStress(cy_stc_bench_row_t const *rows, uint32_t count, bool json)
+{
+    uint32_t i;
+
+    if (json)
+    {
+        (void)printf("[\n");
+    }
+    else
+    {
+        (void)printf("policy,producers,window,work_ns,msgs_per_s,lat_p50_ns,lat_p99_ns,stalls,queued,drops,errors\n");
+    }
+
+    for (i = 0UL; i < count; i++)
+    {
+        cy_stc_bench_row_t const *row = &rows[i];
+
+        if (json)
+        {
+            (void)printf("  {\"policy\": \"%s\", \"producers\": %u, \"window\": %u, \"work_ns\": %u, \"msgs_per_s\": %.0f, "
+                         "\"lat_p50_ns\": %u, \"lat_p99_ns\": %u, \"stalls\": %u, \"queued\": %u, \"drops\": %u, "
+                         "\"errors\": %u}%s\n",
+                         benchPolicyNames[row->policy], (unsigned int)row->producers, (unsigned int)row->window,
+                         (unsigned int)row->work, row->msgsPerS, (unsigned int)row->p50, (unsigned int)row->p99,
+                         (unsigned int)row->stalls, (unsigned int)row->queued, (unsigned int)row->drops,
+                         (unsigned int)row->errors, ((i + 1UL) < count) ? "," : "");
+        }
+        else
+        {
+            (void)printf("%s,%u,%u,%u,%.0f,%u,%u,%u,%u,%u,%u\n",
+                         benchPolicyNames[row->policy], (unsigned int)row->producers, (unsigned int)row->window,
+                         (unsigned int)row->work, row->msgsPerS, (unsigned int)row->p50, (unsigned int)row->p99,
+                         (unsigned int)row->stalls, (unsigned int)row->queued, (unsigned int)row->drops,
+                         (unsigned int)row->errors);
+        }
+    }
+
+    if (json)
+    {
+        (void)printf("]\n");
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_PrintFanout
+********************************************************************************
+* Summary:
+* Prints the results of the fan-out sweep as CSV or as a JSON array.
+*
+*******************************************************************************/
+static void Bench_PrintFanout(cy_stc_bench_row_t const *rows, uint32_t count, bool json)
+{
+    uint32_t i;
+
+    if (json)
+    {
+        (void)printf("[\n");
+    }
+    else
+    {
+        (void)printf("mode,subscribers,msg_size,pubs_per_s,lat_p50_ns,lat_p99_ns,lat_max_ns,pub_p50_ns,pub_p99_ns,stalls,errors\n");
+    }
+
+    for (i = 0UL; i < count; i++)
+    {
+        cy_stc_bench_row_t const *row = &rows[i];
+
+        if (json)
+        {
+            (void)printf("  {\"mode\": \"%s\", \"subscribers\": %u, \"msg_size\": %u, \"pubs_per_s\": %.0f, "
+                         "\"lat_p50_ns\": %u, \"lat_p99_ns\": %u, \"lat_max_ns\": %u, \"pub_p50_ns\": %u, "
+                         "\"pub_p99_ns\": %u, \"stalls\": %u, \"errors\": %u}%s\n",
+                         benchModeNames[row->mode], (unsigned int)row->subscribers, (unsigned int)row->msgSize,
+                         row->msgsPerS, (unsigned int)row->p50, (unsigned int)row->p99, (unsigned int)row->max,
+                         (unsigned int)row->pubP50, (unsigned int)row->pubP99, (unsigned int)row->stalls,
+                         (unsigned int)row->errors, ((i + 1UL) < count) ? "," : "");
+        }
+        else
+        {
+            (void)printf("%s,%u,%u,%.0f,%u,%u,%u,%u,%u,%u,%u\n",
+                         benchModeNames[row->mode], (unsigned int)row->subscribers, (unsigned int)row->msgSize,
+                         row->msgsPerS, (unsigned int)row->p50, (unsigned int)row->p99, (unsigned int)row->max,
+                         (unsigned int)row->pubP50, (unsigned int)row->pubP99, (unsigned int)row->stalls,
+                         (unsigned int)row->errors);
+        }
+    }
+
+    if (json)
+    {
+        (void)printf("]\n");
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_PrintSeqlock
+********************************************************************************
+* Summary:
+* Prints the results of the seqlock stress as CSV or as a JSON array.
+*
+*******************************************************************************/
+static void Bench_PrintSeqlock(cy_stc_bench_row_t const *rows, uint32_t count, bool json)
+{
+    uint32_t i;
+
+    if (json)
+    {
+        (void)printf("[\n");
+    }
+    else
+    {
+        (void)printf("snapshot_size,updates_per_s,reads_per_s,retries,busy,unprotected_torn,errors\n");
+    }
+
+    for (i = 0UL; i < count; i++)
+    {
+        cy_stc_bench_row_t const *row = &rows[i];
+
+        if (json)
+        {
+            (void)printf("  {\"snapshot_size\": %u, \"updates_per_s\": %.0f, \"reads_per_s\": %.0f, \"retries\": %u, "
+                         "\"busy\": %u, \"unprotected_torn\": %u, \"errors\": %u}%s\n",
+                         (unsigned int)row->msgSize, row->updatesPerS, row->msgsPerS, (unsigned int)row->retries,
+                         (unsigned int)row->readBusy, (unsigned int)row->torn, (unsigned int)row->errors,
+                         ((i + 1UL) < count) ? "," : "");
+        }
+        else
+        {
+            (void)printf("%u,%.0f,%.0f,%u,%u,%u,%u\n",
+                         (unsigned int)row->msgSize, row->updatesPerS, row->msgsPerS, (unsigned int)row->retries,
+                         (unsigned int)row->readBusy, (unsigned int)row->torn, (unsigned int)row->errors);
+        }
+    }
+
+    if (json)
+    {
+        (void)printf("]\n");
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_PrintReplay
+********************************************************************************
+* Summary:
+* Prints the results of a replayed capture as CSV or as a JSON array.
+*
+*******************************************************************************/
+static void Bench_PrintReplay(cy_stc_bench_row_t const *rows, uint32_t count, bool json)
+{
+    uint32_t i;
+
+    if (json)
+    {
+        (void)printf("[\n");
+    }
+    else
+    {
+        (void)printf("rx,producers,offered_per_s,msgs_per_s,bytes_per_s,lat_p50_ns,lat_p99_ns,lat_max_ns,"
+                     "hold_p50_ns,hold_p99_ns,busy,irqs_per_msg,cpu_pct,errors\n");
+    }
+
+    for (i = 0UL; i < count; i++)
+    {
+        cy_stc_bench_row_t const *row = &rows[i];
+
+        if (json)
+        {
+            (void)printf("  {\"rx\": \"%s\", \"producers\": %u, \"offered_per_s\": %.0f, \"msgs_per_s\": %.0f, "
+                         "\"bytes_per_s\": %.0f, \"lat_p50_ns\": %u, \"lat_p99_ns\": %u, \"lat_max_ns\": %u, "
+                         "\"hold_p50_ns\": %u, \"hold_p99_ns\": %u, \"busy\": %u, \"irqs_per_msg\": %.3f, "
+                         "\"cpu_pct\": %.1f, \"errors\": %u}%s\n",
+                         benchRxNames[row->rx], (unsigned int)row->producers, row->offeredPerS, row->msgsPerS,
+                         row->bytesPerS, (unsigned int)row->p50, (unsigned int)row->p99, (unsigned int)row->max,
+                         (unsigned int)row->holdP50, (unsigned int)row->holdP99, (unsigned int)row->busy,
+                         row->irqsPerMsg, row->cpuPct, (unsigned int)row->errors, ((i + 1UL) < count) ? "," : "");
+        }
+        else
+        {
+            (void)printf("%s,%u,%.0f,%.0f,%.0f,%u,%u,%u,%u,%u,%u,%.3f,%.1f,%u\n",
+                         benchRxNames[row->rx], (unsigned int)row->producers, row->offeredPerS, row->msgsPerS,
+                         row->bytesPerS, (unsigned int)row->p50, (unsigned int)row->p99, (unsigned int)row->max,
+                         (unsigned int)row->holdP50, (unsigned int)row->holdP99, (unsigned int)row->busy,
+                         row->irqsPerMsg, row->cpuPct, (unsigned int)row->errors);
+        }
+    }
+
+    if (json)
+    {
+        (void)printf("]\n");
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_PrintStream
+********************************************************************************
+* Summary:
+* Prints the results of the stream sweep as CSV or as a JSON array.
+*
+*******************************************************************************/
+static void Bench_PrintStream(cy_stc_bench_row_t const *rows, uint32_t count, bool json)
+{
+    uint32_t i;
+
+    if (json)
+    {
+        (void)printf("[\n");
+    }
+    else
+    {
+        (void)printf("buffers,rx,consumer_pct,rate_bytes_per_s,offered_bytes_per_s,bytes_per_s,blocks_per_s,"
+                     "overruns,underruns,lost,errors\n");
+    }
+
+    for (i = 0UL; i < count; i++)
+    {
+        cy_stc_bench_row_t const *row = &rows[i];
+
+        if (json)
+        {
+            (void)printf("  {\"buffers\": %u, \"rx\": \"%s\", \"consumer_pct\": %u, \"rate_bytes_per_s\": %u, "
+                         "\"offered_bytes_per_s\": %.0f, \"bytes_per_s\": %.0f, \"blocks_per_s\": %.0f, "
+                         "\"overruns\": %u, \"underruns\": %u, \"lost\": %u, \"errors\": %u}%s\n",
+                         (unsigned int)row->buffers, benchRxNames[row->rx], (unsigned int)row->load,
+                         (unsigned int)row->rate, row->offeredPerS, row->bytesPerS, row->msgsPerS,
+                         (unsigned int)row->overruns, (unsigned int)row->underruns, (unsigned int)row->lost,
+                         (unsigned int)row->errors, ((i + 1UL) < count) ? "," : "");
+        }
+        else
+        {
+            (void)printf("%u,%s,%u,%u,%.0f,%.0f,%.0f,%u,%u,%u,%u\n",
+                         (unsigned int)row->buffers, benchRxNames[row->rx], (unsigned int)row->load,
+                         (unsigned int)row->rate, row->offeredPerS, row->bytesPerS, row->msgsPerS,
+                         (unsigned int)row->overruns, (unsigned int)row->underruns, (unsigned int)row->lost,
+                         (unsigned int)row->errors);
+        }
+    }
+
+    if (json)
+    {
+        (void)printf("]\n");
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_PrintHandoff
+********************************************************************************
+* Summary:
+* Prints the results of the handoff sweep as CSV or as a JSON array, with
+* the lines maintained per message.
+*
+*******************************************************************************/
+static void Bench_PrintHandoff(cy_stc_bench_row_t const *rows, uint32_t count, bool json)
+{
+    uint32_t i;
+
+    if (json)
+    {
+        (void)printf("[\n");
+    }
+    else
+    {
+        (void)printf("strategy,msg_size,msgs_per_s,msg_lines,clean_lines_per_msg,inval_lines_per_msg,"
+                     "ops_per_msg,uncached_lines,model_cycles_per_msg,errors\n");
+    }
+
+    for (i = 0UL; i < count; i++)
+    {
+        cy_stc_bench_row_t const *row = &rows[i];
+        double messages = (0UL != row->handedOff) ? (double)row->handedOff : 1.0;
+
+        if (json)
+        {
+            (void)printf("  {\"strategy\": \"%s\", \"msg_size\": %u, \"msgs_per_s\": %.0f, "
+                         "\"msg_lines\": %u, \"clean_lines_per_msg\": %.2f, \"inval_lines_per_msg\": %.2f, "
+                         "\"ops_per_msg\": %.2f, \"uncached_lines\": %u, \"model_cycles_per_msg\": %.0f, "
+                         "\"errors\": %u}%s\n",
+                         benchHandoffNames[row->handoff], (unsigned int)row->msgSize, row->msgsPerS,
+                         (unsigned int)row->msgLines, (double)row->cleanLines / messages,
+                         (double)row->invalLines / messages, (double)row->maintOps / messages,
+                         (unsigned int)row->uncachedLines, row->modelCycles, (unsigned int)row->errors,
+                         ((i + 1UL) < count) ? "," : "");
+        }
+        else
+        {
+            (void)printf("%s,%u,%.0f,%u,%.2f,%.2f,%.2f,%u,%.0f,%u\n",
+                         benchHandoffNames[row->handoff], (unsigned int)row->msgSize, row->msgsPerS,
+                         (unsigned int)row->msgLines, (double)row->cleanLines / messages,
+                         (double)row->invalLines / messages, (double)row->maintOps / messages,
+                         (unsigned int)row->uncachedLines, row->modelCycles, (unsigned int)row->errors);
+        }
+    }
+
+    if (json)
+    {
+        (void)printf("]\n");
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_PrintOffload
+********************************************************************************
+* Summary:
+* Prints the results of the offload sweep as CSV or as a JSON array, with
+* the share of the second worker in % of the jobs.
+*
+*******************************************************************************/
+static void Bench_PrintOffload(cy_stc_bench_row_t const *rows, uint32_t count, bool json)
+{
+    uint32_t i;
+
+    if (json)
+    {
+        (void)printf("[\n");
+    }
+    else
+    {
+        (void)printf("workers,placement,job_us,jobs_per_s,speedup,worker1_pct,stolen,sleeps,doorbells,errors\n");
+    }
+
+    for (i = 0UL; i < count; i++)
+    {
+        cy_stc_bench_row_t const *row = &rows[i];
+        uint32_t jobs = row->jobs[0] + row->jobs[1];
+        double share = (0UL != jobs) ? (((double)row->jobs[1] * 100.0) / (double)jobs) : 0.0;
+
+        if (json)
+        {
+            (void)printf("  {\"workers\": %u, \"placement\": \"%s\", \"job_us\": %u, \"jobs_per_s\": %.0f, "
+                         "\"speedup\": %.2f, \"worker1_pct\": %.1f, \"stolen\": %u, \"sleeps\": %u, "
+                         "\"doorbells\": %u, \"errors\": %u}%s\n",
+                         (unsigned int)row->workers, row->pinned ? "cm7_0" : "any", (unsigned int)(row->work / 1000UL),
+                         row->msgsPerS, row->speedup,
+                         share, (unsigned int)row->stolen, (unsigned int)row->sleeps, (unsigned int)row->doorbells,
+                         (unsigned int)row->errors, ((i + 1UL) < count) ? "," : "");
+        }
+        else
+        {
+            (void)printf("%u,%s,%u,%.0f,%.2f,%.1f,%u,%u,%u,%u\n",
+                         (unsigned int)row->workers, row->pinned ? "cm7_0" : "any", (unsigned int)(row->work / 1000UL),
+                         row->msgsPerS, row->speedup,
+                         share, (unsigned int)row->stolen, (unsigned int)row->sleeps, (unsigned int)row->doorbells,
+                         (unsigned int)row->errors);
+        }
+    }
+
+    if (json)
+    {
+        (void)printf("]\n");
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_CheckStress
+********************************************************************************
+* Summary:
+* Checks that a stress case saturated the consumer and that the policy did
+* what it says: a blocked producer neither queues nor drops, a queueing one
+* queues and a dropping one drops. Returns the reason of a failure, or NULL.
+*
+*******************************************************************************/
+static char const *Bench_CheckStress(cy_stc_bench_row_t const *row)
+{
+    if (0UL == row->stalls)
+    {
+        return "producers never ran out of credit";
+    }
+    if ((CY_IPC_CREDIT_POLICY_BLOCK == row->policy) && ((0UL != row->queued) || (0UL != row->drops)))
+    {
+        return "blocking producer queued or dropped";
+    }
+    if ((CY_IPC_CREDIT_POLICY_QUEUE == row->policy) && (0UL == row->queued))
+    {
+        return "nothing queued";
+    }
+    if ((CY_IPC_CREDIT_POLICY_DROP == row->policy) && ((0UL == row->drops) || (0UL != row->queued)))
+    {
+        return "nothing dropped, or queued";
+    }
+
+    return NULL;
+}
+
+/*******************************************************************************
+* Function Name: Bench_CheckStream
+********************************************************************************
+* Summary:
+* Checks that a stream case saw what its consumer speed implies: a
+* consumer slower than the stream overruns it, a paced one faster than the
+* stream underruns, one woken by the doorbell never does, and every block
+* the producer dropped reaches the consumer as a gap. Returns the reason of
+* a failure, or NULL.
+*
+*******************************************************************************/
+static char const *Bench_CheckStream(cy_stc_bench_row_t const *row)
+{
+    if ((row->load > 100UL) && (0UL == row->overruns))
+    {
+        return "slow consumer without overruns";
+    }
+    if ((BENCH_RX_PACED == row->rx) && (row->load < 100UL) && (0UL == row->underruns))
+    {
+        return "fast paced consumer without underruns";
+    }
+    if ((BENCH_RX_PACED != row->rx) && (0UL != row->underruns))
+    {
+        return "doorbell consumer underran";
+    }
+    if (0UL != row->unaccounted)
+    {
+        return "dropped blocks not seen as lost";
+    }
+
+    return NULL;
+}
+
+/*******************************************************************************
+* Function Name: Bench_CheckHandoff
+********************************************************************************
+* Summary:
+* Checks that a handoff case kept to the rules: CM7_0 found none broken,
+* nothing inside a non-cacheable pool was maintained, and a cached pool
+* was cleaned and discarded by exactly the lines of each message. The
+* recording may cut one message on each side. Returns the reason of a
+* failure, or NULL.
+*
+*******************************************************************************/
+static char const *Bench_CheckHandoff(cy_stc_bench_row_t const *row)
+{
+    uint64_t expected = (uint64_t)row->msgLines * row->handedOff;
+    uint64_t slack = 2ULL * row->msgLines;
+
+    if (0UL != row->ruleErrors)
+    {
+        return "handoff rules broken";
+    }
+    if (0UL != row->uncachedLines)
+    {
+        return "maintenance inside the non-cacheable pool";
+    }
+    if ((CY_IPC_HANDOFF_NONCACHEABLE == row->handoff) && ((0UL != row->cleanLines) || (0UL != row->invalLines)))
+    {
+        return "non-cacheable pool maintained";
+    }
+    if ((CY_IPC_HANDOFF_CACHED == row->handoff) &&
+        (((row->cleanLines + slack) < expected) || (row->cleanLines > (expected + slack)) ||
+         ((row->invalLines + slack) < expected) || (row->invalLines > (expected + slack))))
+    {
+        return "lines maintained do not match the messages";
+    }
+
+    return NULL;
+}
+
+/*******************************************************************************
+* Function Name: Bench_CheckOffload
+********************************************************************************
+* Summary:
+* Sets the speedup of an offload case against the one-worker case of the
+* same jobs that ran before it, and checks that a second worker took jobs,
+* all of them stolen when the jobs are pinned to the first, and, on the
+* longest jobs, that two workers scale. Returns the reason of a failure,
+* or NULL.
+*
+*******************************************************************************/
+static char const *Bench_CheckOffload(cy_stc_bench_row_t *rows, uint32_t index)
+{
+    cy_stc_bench_row_t *row = &rows[index];
+    uint32_t longest = benchOffloadWork[(sizeof(benchOffloadWork) / sizeof(benchOffloadWork[0])) - 1UL];
+    uint32_t i;
+
+    row->speedup = 1.0;
+    for (i = 0UL; i < index; i++)
+    {
+        if ((1UL == rows[i].workers) && (rows[i].work == row->work) && (0.0 != rows[i].msgsPerS))
+        {
+            row->speedup = row->msgsPerS / rows[i].msgsPerS;
+        }
+    }
+
+    if (row->workers < 2UL)
+    {
+        return NULL;
+    }
+    if (0UL == row->jobs[1])
+    {
+        return "second worker ran no jobs";
+    }
+    if (row->pinned && (row->stolen < row->jobs[1]))
+    {
+        return "second worker ran pinned jobs it did not steal";
+    }
+    if ((row->work == longest) && (row->speedup < BENCH_OFFLOAD_MIN_SPEEDUP))
+    {
+        return "two workers do not scale";
+    }
+
+    return NULL;
+}
+
+/*******************************************************************************
+* Function Name: Bench_Fail
+********************************************************************************
+* Summary:
+* Reports a failed case.
+*
+*******************************************************************************/
+static void Bench_Fail(cy_stc_bench_row_t const *row, char const *reason)
+{
+    (void)fprintf(stderr, "FAILED %s,%s,%u,%u,%u: %s\n", benchModeNames[row->mode], benchRxNames[row->rx],
+                  (unsigned int)row->producers, (unsigned int)row->msgSize, (unsigned int)row->batch, reason);
+}
+
+/*******************************************************************************
+* Function Name: Bench_Check
+********************************************************************************
+* Summary:
+* Compares the results with a baseline CSV written by this program. Cases
+* missing from the baseline are not checked. Returns the number of
+* regressions.
+*
+*******************************************************************************/
+static uint32_t Bench_Check(cy_stc_bench_row_t const *rows, uint32_t count, char const *path,
+                            double throughputThreshold, double latencyThreshold)
+{
+    FILE *file = fopen(path, "r");
+    char line[256];
+    char mode[16];
+    char rx[16];
+    unsigned int producers;
+    unsigned int msgSize;
+    unsigned int batch;
+    unsigned int p99;
+    double msgsPerS;
+    uint32_t regressions = 0UL;
+    uint32_t i;
+
+    if (NULL == file)
+    {
+        (void)fprintf(stderr, "cannot open baseline %s\n", path);
+        return 1UL;
+    }
+
+    while (NULL != fgets(line, sizeof(line), file))
+    {
+        if (7 != sscanf(line, "%15[^,],%15[^,],%u,%u,%u,%lf,%*f,%*u,%u", mode, rx, &producers, &msgSize, &batch, &msgsPerS, &p99))
+        {
+            continue;   /* Header or malformed line */
+        }
+
+        for (i = 0UL; i < count; i++)
+        {
+            cy_stc_bench_row_t const *row = &rows[i];
+
+            if ((0 != strcmp(mode, benchModeNames[row->mode])) || (0 != strcmp(rx, benchRxNames[row->rx])) ||
+                (producers != row->producers) || (msgSize != row->msgSize) || (batch != row->batch))
+            {
+                continue;
+            }
+
+            if (row->msgsPerS < (msgsPerS * (1.0 - (throughputThreshold / 100.0))))
+            {
+                (void)fprintf(stderr, "REGRESSION %s,%s,%u,%u,%u: %.0f msgs/s, baseline %.0f\n",
+                              mode, rx, producers, msgSize, batch, row->msgsPerS, msgsPerS);
+                regressions++;
+            }
+            if ((double)row->p99 > ((double)p99 * (1.0 + (latencyThreshold / 100.0))))
+            {
+                (void)fprintf(stderr, "REGRESSION %s,%s,%u,%u,%u: p99 %u ns, baseline %u ns\n",
+                              mode, rx, producers, msgSize, batch, (unsigned int)row->p99, p99);
+                regressions++;
+            }
+        }
+    }
+
+    (void)fclose(file);
+    return regressions;
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* Runs the sweep, prints the results and checks them.
+*
+* Parameters:
+*  argc, argv: See the file description.
+*
+* Return:
+*  EXIT_SUCCESS, or EXIT_FAILURE if a case failed, lost or corrupted
+*  messages, or regressed.
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+    static cy_stc_bench_row_t rows[BENCH_MAX_ROWS];
+    cy_stc_bench_row_t *shared;
+    double seconds = BENCH_RUN_TIME_S;
+    double throughputThreshold = BENCH_THROUGHPUT_THRESHOLD;
+    double latencyThreshold = BENCH_LATENCY_THRESHOLD;
+    char const *baseline = NULL;
+    bool json = false;
+    bool rates = false;
+    bool stress = false;
+    bool fanout = false;
+    bool seqlock = false;
+    bool stream = false;
+    bool cache = false;
+    bool offload = false;
+    bool replay = false;
+    double speed = 1.0;
+    uint32_t replayProducers = 0UL;
+    char const *reason;
+    bool failed = false;
+    uint32_t count = 0UL;
+    uint32_t mode;
+    uint32_t rx;
+    uint32_t producers;
+    uint32_t size;
+    uint32_t batch;
+    uint32_t rate;
+    uint32_t policy;
+    uint32_t subscribers;
+    uint32_t buffers;
+    uint32_t load;
+    uint32_t handoff;
+    uint32_t workers;
+    uint32_t pinned;
+    uint32_t work;
+    uint32_t i;
+    int opt;
+
+    while (-1 != (opt = getopt(argc, argv, "t:f:b:r:l:xspwdcoRS:")))
+    {
+        switch (opt)
+        {
+            case 't': seconds = strtod(optarg, NULL); break;
+            case 'f': json = (0 == strcmp(optarg, "json")); break;
+            case 'b': baseline = optarg; break;
+            case 'r': throughputThreshold = strtod(optarg, NULL); break;
+            case 'l': latencyThreshold = strtod(optarg, NULL); break;
+            case 'x': rates = true; break;
+            case 's': stress = true; break;
+            case 'p': fanout = true; break;
+            case 'w': seqlock = true; break;
+            case 'd': stream = true; break;
+            case 'c': cache = true; break;
+            case 'o': offload = true; break;
+            case 'R': replay = true; break;
+            case 'S': speed = strtod(optarg, NULL); break;
+            default:
+                (void)fprintf(stderr, "usage: %s [-t seconds] [-f csv|json] [-b baseline.csv] "
+                              "[-r throughput%%] [-l latency%%] [-x] [-s] [-p] [-w] [-d] [-c] [-o] [-R [-S speed] dump.bin...]\n",
+                              argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if (replay && !Bench_LoadReplay((char const *const *)&argv[optind], (uint32_t)(argc - optind), speed,
+                                    &replayProducers))
+    {
+        return EXIT_FAILURE;
+    }
+    if (seconds <= 0.0)
+    {
+        seconds = BENCH_RUN_TIME_S;
+    }
+
+    shared = mmap(NULL, sizeof(*shared), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (MAP_FAILED == shared)
+    {
+        return EXIT_FAILURE;
+    }
+
+    /* Replay: the captured sends against each consumer mode */
+    for (rx = BENCH_RX_ISR; replay && (rx <= BENCH_RX_ADAPTIVE); rx++)
+    {
+        rows[count].mode = BENCH_MODE_REPLAY;
+        rows[count].rx = (cy_en_bench_rx_t)rx;
+        rows[count].producers = replayProducers;
+        rows[count].msgSize = BENCH_MAX_MSG_SIZE;
+        rows[count].batch = 1UL;
+        rows[count].rate = 0UL;
+        rows[count].control = false;
+        rows[count].policy = CY_IPC_CREDIT_POLICY_BLOCK;
+        rows[count].window = BENCH_RING_DEPTH;
+        rows[count].work = 0UL;
+        rows[count].subscribers = 0UL;
+        rows[count].offeredPerS = ((double)(benchReplay.count[0] + benchReplay.count[1]) * 1e9) / (double)benchReplay.period;
+        count++;
+    }
+
+    /* Rate sweep: one queued producer of small messages without batching,
+     * and no control pings, so every consumer interrupt is a doorbell */
+    for (rate = 0UL; !replay && rates && (rate < (sizeof(benchRates) / sizeof(benchRates[0]))); rate++)
+    {
+        for (rx = BENCH_RX_ISR; rx <= BENCH_RX_ADAPTIVE; rx += (BENCH_RX_ADAPTIVE - BENCH_RX_ISR))
+        {
+            rows[count].mode = BENCH_MODE_QUEUED;
+            rows[count].rx = (cy_en_bench_rx_t)rx;
+            rows[count].producers = 1UL;
+            rows[count].msgSize = 64UL;
+            rows[count].batch = 1UL;
+            rows[count].rate = benchRates[rate];
+            rows[count].control = false;
+            rows[count].policy = CY_IPC_CREDIT_POLICY_BLOCK;
+            rows[count].window = BENCH_RING_DEPTH;
+            rows[count].work = 0UL;
+            rows[count].subscribers = 0UL;
+            count++;
+        }
+    }
+
+    /* Flow control stress: both producers unpaced against a consumer that
+     * takes BENCH_STRESS_WORK_NS per message, once per policy */
+    for (policy = CY_IPC_CREDIT_POLICY_BLOCK; !replay && !rates && stress && (policy <= CY_IPC_CREDIT_POLICY_DROP); policy++)
+    {
+        rows[count].mode = BENCH_MODE_QUEUED;
+        rows[count].rx = BENCH_RX_ISR;
+        rows[count].producers = BENCH_MAX_PRODUCERS;
+        rows[count].msgSize = 64UL;
+        rows[count].batch = 1UL;
+        rows[count].rate = 0UL;
+        rows[count].control = false;
+        rows[count].policy = (cy_en_ipc_credit_policy_t)policy;
+        rows[count].window = BENCH_STRESS_WINDOW;
+        rows[count].work = BENCH_STRESS_WORK_NS;
+        rows[count].subscribers = 0UL;
+        count++;
+    }
+
+    /* Fan-out: CM7_1 publishes 64-byte messages unpaced, every subscriber
+     * takes them in its pipe interrupt */
+    for (mode = BENCH_MODE_UNICAST; !replay && !rates && !stress && fanout && (mode <= BENCH_MODE_PUBSUB); mode++)
+    {
+        for (subscribers = 1UL; subscribers <= BENCH_MAX_SUBSCRIBERS; subscribers++)
+        {
+            rows[count].mode = (cy_en_bench_mode_t)mode;
+            rows[count].rx = BENCH_RX_ISR;
+            rows[count].producers = 1UL;
+            rows[count].msgSize = 64UL;
+            rows[count].batch = 1UL;
+            rows[count].rate = 0UL;
+            rows[count].control = false;
+            rows[count].policy = CY_IPC_CREDIT_POLICY_BLOCK;
+            rows[count].window = BENCH_RING_DEPTH;
+            rows[count].work = 0UL;
+            rows[count].subscribers = subscribers;
+            count++;
+        }
+    }
+
+    /* Seqlock stress: CM7_1 rewrites a snapshot of each size unpaced */
+    for (size = 0UL; !replay && !rates && !stress && !fanout && seqlock && (size < (sizeof(benchSizes) / sizeof(benchSizes[0]))); size++)
+    {
+        rows[count].mode = BENCH_MODE_SEQLOCK;
+        rows[count].rx = BENCH_RX_ISR;
+        rows[count].producers = 1UL;
+        rows[count].msgSize = benchSizes[size];
+        rows[count].batch = 1UL;
+        rows[count].rate = 0UL;
+        rows[count].control = false;
+        rows[count].policy = CY_IPC_CREDIT_POLICY_BLOCK;
+        rows[count].window = BENCH_RING_DEPTH;
+        rows[count].work = 0UL;
+        rows[count].subscribers = 0UL;
+        count++;
+    }
+
+    /* Stream: CM7_0 streams at BENCH_STREAM_RATE, CM0+ consumes on the
+     * doorbell or paced, in the given time per block */
+    for (buffers = 0UL; !replay && !rates && !stress && !fanout && !seqlock && stream &&
+                        (buffers < (sizeof(benchStreamBuffers) / sizeof(benchStreamBuffers[0]))); buffers++)
+    {
+        for (rx = BENCH_RX_ISR; rx <= BENCH_RX_PACED; rx += (BENCH_RX_PACED - BENCH_RX_ISR))
+        {
+            for (load = 0UL; load < (sizeof(benchStreamLoads) / sizeof(benchStreamLoads[0])); load++)
+            {
+                rows[count].mode = BENCH_MODE_STREAM;
+                rows[count].rx = (cy_en_bench_rx_t)rx;
+                rows[count].producers = 1UL;
+                rows[count].msgSize = BENCH_STREAM_BLOCK_SIZE;
+                rows[count].batch = 1UL;
+                rows[count].rate = BENCH_STREAM_RATE;
+                rows[count].control = false;
+                rows[count].policy = CY_IPC_CREDIT_POLICY_BLOCK;
+                rows[count].window = BENCH_RING_DEPTH;
+                rows[count].work = (uint32_t)(((uint64_t)BENCH_STREAM_BLOCK_SIZE * 10000000ULL * benchStreamLoads[load]) /
+                                              BENCH_STREAM_RATE);
+                rows[count].subscribers = 0UL;
+                rows[count].buffers = benchStreamBuffers[buffers];
+                rows[count].load = benchStreamLoads[load];
+                count++;
+            }
+        }
+    }
+
+    /* Handoff: CM7_0 sends each size to CM7_1 out of each kind of pool */
+    for (handoff = CY_IPC_HANDOFF_CACHED; !replay && !rates && !stress && !fanout && !seqlock && !stream && cache &&
+                                          (handoff <= CY_IPC_HANDOFF_NONCACHEABLE); handoff++)
+    {
+        for (size = 0UL; size < (sizeof(benchSizes) / sizeof(benchSizes[0])); size++)
+        {
+            rows[count].mode = BENCH_MODE_HANDOFF;
+            rows[count].rx = BENCH_RX_ISR;
+            rows[count].producers = 1UL;
+            rows[count].msgSize = benchSizes[size];
+            rows[count].batch = 1UL;
+            rows[count].rate = 0UL;
+            rows[count].control = false;
+            rows[count].policy = CY_IPC_CREDIT_POLICY_BLOCK;
+            rows[count].window = BENCH_RING_DEPTH;
+            rows[count].work = 0UL;
+            rows[count].subscribers = 0UL;
+            rows[count].handoff = (cy_en_ipc_handoff_mode_t)handoff;
+            count++;
+        }
+    }
+
+    /* Offload: CM0+ keeps BENCH_OFFLOAD_WINDOW jobs of each length in
+     * flight, on one worker, then on two, spread by the queue or pinned to
+     * CM7_0 so that CM7_1 has to steal */
+    for (work = 0UL; !replay && !rates && !stress && !fanout && !seqlock && !stream && !cache && offload &&
+                     (work < (sizeof(benchOffloadWork) / sizeof(benchOffloadWork[0]))); work++)
+    {
+        for (workers = 1UL; workers <= BENCH_MAX_PRODUCERS; workers++)
+        {
+            /* Pinned only with a worker to steal */
+            for (pinned = 0UL; pinned < ((workers > 1UL) ? 2UL : 1UL); pinned++)
+            {
+                rows[count].mode = BENCH_MODE_OFFLOAD;
+                rows[count].rx = BENCH_RX_ISR;
+                rows[count].producers = workers;
+                rows[count].msgSize = sizeof(cy_stc_ipc_work_done_t);
+                rows[count].batch = 1UL;
+                rows[count].rate = 0UL;
+                rows[count].control = false;
+                rows[count].policy = CY_IPC_CREDIT_POLICY_BLOCK;
+                rows[count].window = BENCH_RING_DEPTH;
+                rows[count].work = benchOffloadWork[work];
+                rows[count].subscribers = 0UL;
+                rows[count].workers = workers;
+                rows[count].pinned = (0UL != pinned);
+                count++;
+            }
+        }
+    }
+
+    for (mode = BENCH_MODE_BLOCKING; !replay && !rates && !stress && !fanout && !seqlock && !stream && !cache &&
+                                     !offload && (mode <= BENCH_MODE_QUEUED); mode++)
+    {
+        /* The adaptive consumer is covered by the rate sweep */
+        for (rx = BENCH_RX_ISR; rx <= BENCH_RX_DEFERRED; rx++)
+        {
+            for (producers = 1UL; producers <= BENCH_MAX_PRODUCERS; producers++)
+            {
+                for (size = 0UL; size < (sizeof(benchSizes) / sizeof(benchSizes[0])); size++)
+                {
+                    /* A blocking send has no batch */
+                    for (batch = 0UL; batch < ((BENCH_MODE_QUEUED == mode) ? (sizeof(benchBatches) / sizeof(benchBatches[0])) : 1UL); batch++)
+                    {
+                        rows[count].mode = (cy_en_bench_mode_t)mode;
+                        rows[count].rx = (cy_en_bench_rx_t)rx;
+                        rows[count].producers = producers;
+                        rows[count].msgSize = benchSizes[size];
+                        rows[count].batch = benchBatches[batch];
+                        rows[count].rate = 0UL;
+                        rows[count].control = true;
+                        rows[count].policy = CY_IPC_CREDIT_POLICY_BLOCK;
+                        rows[count].window = BENCH_RING_DEPTH;
+                        rows[count].work = 0UL;
+                        rows[count].subscribers = 0UL;
+                        count++;
+                    }
+                }
+            }
+        }
+    }
+
+    /* RPC round trip: one call in flight for the latency, a full window of
+     * CY_IPC_RPC_MAX_PENDING for the throughput */
+    for (batch = 1UL; !replay && !rates && !stress && !fanout && !seqlock && !stream && !cache && !offload &&
+                      (batch <= CY_IPC_RPC_MAX_PENDING); batch *= CY_IPC_RPC_MAX_PENDING)
+    {
+        rows[count].mode = BENCH_MODE_RPC;
+        rows[count].rx = BENCH_RX_ISR;
+        rows[count].producers = 1UL;
+        rows[count].msgSize = sizeof(cy_stc_ipc_rpc_msg_t);
+        rows[count].batch = batch;
+        rows[count].rate = 0UL;
+        rows[count].control = false;
+        rows[count].policy = CY_IPC_CREDIT_POLICY_BLOCK;
+        rows[count].window = BENCH_RING_DEPTH;
+        rows[count].work = 0UL;
+        rows[count].subscribers = 0UL;
+        count++;
+    }
+
+    for (i = 0UL; i < count; i++)
+    {
+        if (!Bench_Run(&rows[i], shared, seconds))
+        {
+            Bench_Fail(&rows[i], "crashed or hung");
+            failed = true;
+        }
+        else if (0UL != rows[i].errors)
+        {
+            Bench_Fail(&rows[i], "lost or corrupt messages, or credit overrun");
+            failed = true;
+        }
+        else if (stress && (NULL != (reason = Bench_CheckStress(&rows[i]))))
+        {
+            Bench_Fail(&rows[i], reason);
+            failed = true;
+        }
+        else if (seqlock && (0UL != rows[i].idleReaders))
+        {
+            Bench_Fail(&rows[i], "a reader got no snapshot");
+            failed = true;
+        }
+        else if (stream && (NULL != (reason = Bench_CheckStream(&rows[i]))))
+        {
+            Bench_Fail(&rows[i], reason);
+            failed = true;
+        }
+        else if (cache && (NULL != (reason = Bench_CheckHandoff(&rows[i]))))
+        {
+            Bench_Fail(&rows[i], reason);
+            failed = true;
+        }
+        else if (offload && (NULL != (reason = Bench_CheckOffload(rows, i))))
+        {
+            Bench_Fail(&rows[i], reason);
+            failed = true;
+        }
+        else
+        {
+            /* Passed */
+        }
+    }
+
+    if (replay)
+    {
+        Bench_PrintReplay(rows, count, json);
+    }
+    else if (rates)
+    {
+        Bench_PrintRates(rows, count, json);
+    }
+    else if (stress)
+    {
+        Bench_PrintStress(rows, count, json);
+    }
+    else if (fanout)
+    {
+        Bench_PrintFanout(rows, count, json);
+    }
+    else if (seqlock)
+    {
+        Bench_PrintSeqlock(rows, count, json);
+    }
+    else if (stream)
+    {
+        Bench_PrintStream(rows, count, json);
+    }
+    else if (cache)
+    {
+        Bench_PrintHandoff(rows, count, json);
+    }
+    else if (offload)
+    {
+        Bench_PrintOffload(rows, count, json);
+    }
+    else
+    {
+        Bench_Print(rows, count, json);
+    }
+
+    if ((NULL != baseline) && (0UL != Bench_Check(rows, count, baseline, throughputThreshold, latencyThreshold)))
+    {
+        failed = true;
+    }
+
+    for (i = 0UL; i < count; i++)
+    {
+        if (0.0 == rows[i].msgsPerS)
+        {
+            Bench_Fail(&rows[i], "no messages");
+            failed = true;
+        }
+    }
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/* [] END OF FILE */
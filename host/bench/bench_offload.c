@@ -0,0 +1,467 @@
+/******************************************************************************
+* File Name:   bench_offload.c
+*
+* Description: Work offload benchmark, linked into every benchmark image.
+*              CM0+ keeps a window of jobs submitted to the work queue;
+*              CM7_0, and CM7_1 with two workers, run them, steal from
+*              each other when out of work, sleep until their doorbell
+*              when there is none, and send every completion back
+*              through the pipe. A job models compute by sleeping, so
+*              that the scaling shows on a host with fewer CPUs.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "cy_pdl.h"
+#include "bench.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BENCH_OFFLOAD_HASH              (2654435761UL)  /* Result of a job: its argument times this */
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void Bench_Offload_SubmitterIsr(void);
+void Bench_Offload_WorkerIsr(void);
+void Bench_Offload_QueueCallback(uint32_t *msgData);
+void Bench_Offload_DoneCallback(uint32_t *msgData);
+void Bench_Offload_Fill(void);
+void Bench_Offload_Transfer(uint32_t toAddr, uint32_t fromAddr, void *msg);
+uint32_t Bench_Offload_Hash(uint32_t arg);
+
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static cy_stc_ipc_pipe_ep_t benchOffloadEpArray[CY_IPC_MAX_ENDPOINTS];
+static cy_ipc_pipe_callback_ptr_t benchOffloadCb[1];
+
+/* The submitter takes the completions of both workers on EP0 */
+static const cy_stc_ipc_pipe_config_t benchOffloadSubmitterConfig[BENCH_MAX_PRODUCERS] =
+{
+    { CY_IPC_CYPIPE_EP_CONFIG(0), CY_IPC_CYPIPE_EP_CONFIG(1), 1UL, benchOffloadCb, &Bench_Offload_SubmitterIsr },
+    { CY_IPC_CYPIPE_EP_CONFIG(0), CY_IPC_CYPIPE_EP_CONFIG(2), 1UL, benchOffloadCb, &Bench_Offload_SubmitterIsr },
+};
+
+/* Worker n takes the queue on EP n + 1, then only releases and doorbells */
+static const cy_stc_ipc_pipe_config_t benchOffloadWorkerConfig[BENCH_MAX_PRODUCERS] =
+{
+    { CY_IPC_CYPIPE_EP_CONFIG(1), CY_IPC_CYPIPE_EP_CONFIG(0), 1UL, benchOffloadCb, &Bench_Offload_WorkerIsr },
+    { CY_IPC_CYPIPE_EP_CONFIG(2), CY_IPC_CYPIPE_EP_CONFIG(0), 1UL, benchOffloadCb, &Bench_Offload_WorkerIsr },
+};
+
+static const uint32_t benchOffloadEp[BENCH_MAX_PRODUCERS] =
+    { CY_IPC_EP_CYPIPE_CM7_0_ADDR, CY_IPC_EP_CYPIPE_CM7_1_ADDR };
+static const uint32_t benchOffloadChan[BENCH_MAX_PRODUCERS] =
+    { CY_IPC_CHAN_CYPIPE_EP1, CY_IPC_CHAN_CYPIPE_EP2 };
+static const uint32_t benchOffloadNotify[BENCH_MAX_PRODUCERS] =
+    { CY_IPC_CYPIPE_INTR_MASK_EP1, CY_IPC_CYPIPE_INTR_MASK_EP2 };
+static const uint32_t benchOffloadIntr[BENCH_MAX_PRODUCERS] =
+    { CY_IPC_INTR_CYPIPE_EP1, CY_IPC_INTR_CYPIPE_EP2 };
+
+static const cy_ipc_work_method_t benchOffloadMethods[] = { &Bench_Offload_Hash };
+
+/* Submitter: the queue in its pool, and the argument of the job in each slot of the window */
+static CY_ALIGN(BENCH_OFFLOAD_POOL_SIZE) uint8_t benchOffloadPool[BENCH_OFFLOAD_POOL_SIZE];
+static cy_stc_bench_pool_t benchOffloadQueueMsg;
+static uint32_t benchOffloadFree;           /* Slots of the window without a job in flight */
+static uint32_t benchOffloadArg[BENCH_OFFLOAD_WINDOW];
+static uint32_t benchOffloadNext;           /* Argument of the next job */
+static cy_stc_ipc_msg_rx_t benchOffloadSeq[BENCH_MAX_PRODUCERS];
+
+/* Worker */
+static uint32_t benchOffloadEpAddr;
+static uint32_t benchOffloadEpIntr;
+static cy_stc_ipc_work_t *volatile benchOffloadRx;
+static cy_stc_ipc_handoff_t benchOffloadHandoff;
+static cy_stc_ipc_work_worker_t benchOffloadWorker;
+static cy_stc_bench_done_t benchOffloadDone;
+static cy_stc_ipc_msg_tx_t benchOffloadTx;
+
+IPC_PORT_STATIC_ASSERT(sizeof(cy_stc_ipc_work_t) <= BENCH_OFFLOAD_POOL_SIZE, "Work queue exceeds its pool");
+IPC_PORT_STATIC_ASSERT(BENCH_OFFLOAD_WINDOW <= 32UL, "Offload window exceeds the slot mask");
+
+
+/*******************************************************************************
+* Function Name: Bench_Offload_Submit
+********************************************************************************
+* Summary:
+* Submitter role of CM0+. Sets up the queue in its pool for the configured
+* workers and hands it to each of them, then fills the window of jobs and
+* returns; the caller sleeps. Each completion submits the next job.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Offload_Submit(void)
+{
+    cy_stc_ipc_work_t *work = (cy_stc_ipc_work_t *)benchOffloadPool;
+    uint32_t interruptState;
+    uint32_t i;
+
+    __enable_irq();
+
+    Cy_IPC_Pipe_Config(benchOffloadEpArray);
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    for (i = 0UL; i < benchConfig.workers; i++)
+    {
+        Cy_IPC_Pipe_Init(&benchOffloadSubmitterConfig[i]);
+    }
+    (void)Cy_IPC_Pipe_RegisterCallback(CY_IPC_EP_CYPIPE_CM0_ADDR, &Bench_Offload_DoneCallback, BENCH_OFFLOAD_CLIENT_DONE);
+    Cy_SysLib_ExitCriticalSection(interruptState);
+
+    if (CY_IPC_WORK_SUCCESS != Cy_IPC_Work_Init(work, benchConfig.workers, benchOffloadNotify))
+    {
+        benchResult.errors++;
+        return;
+    }
+    benchResult.work = work;
+
+    Cy_IPC_Msg_InitHeader(&benchOffloadQueueMsg.hdr, BENCH_OFFLOAD_CLIENT_QUEUE, 0UL, CY_IPC_CYPIPE_INTR_MASK_EP0,
+                          sizeof(benchOffloadQueueMsg.base) + sizeof(benchOffloadQueueMsg.size));
+    benchOffloadQueueMsg.base = benchOffloadPool;
+    benchOffloadQueueMsg.size = sizeof(benchOffloadPool);
+    Cy_IPC_Msg_Seal(&benchOffloadQueueMsg, NULL);
+    for (i = 0UL; i < benchConfig.workers; i++)
+    {
+        Bench_Offload_Transfer(benchOffloadEp[i], CY_IPC_EP_CYPIPE_CM0_ADDR, &benchOffloadQueueMsg);
+    }
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    benchOffloadFree = (BENCH_OFFLOAD_WINDOW < 32UL) ? ((1UL << BENCH_OFFLOAD_WINDOW) - 1UL) : 0xFFFFFFFFUL;
+    Bench_Offload_Fill();
+    Cy_SysLib_ExitCriticalSection(interruptState);
+}
+
+/*******************************************************************************
+* Function Name: Bench_Offload_Work
+********************************************************************************
+* Summary:
+* Worker role of a CM7. Waits for the queue, maps its pool non-cacheable,
+* then runs jobs forever: its own, or stolen from the other worker. Rings
+* the doorbell of an idle worker when it leaves jobs to steal, sends each
+* completion to CM0+ and waits for its release, and sleeps when there is
+* no job anywhere.
+*
+* Parameters:
+*  index: Worker, 0 for CM7_0 and 1 for CM7_1
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Offload_Work(uint32_t index)
+{
+    cy_stc_ipc_work_t *work;
+    cy_en_ipc_work_status_t status;
+    uint32_t interruptState;
+    uint32_t notifyMask;
+
+    __enable_irq();
+
+    benchOffloadEpAddr = benchOffloadEp[index];
+    benchOffloadEpIntr = benchOffloadIntr[index];
+    Cy_IPC_Pipe_Config(benchOffloadEpArray);
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    Cy_IPC_Pipe_Init(&benchOffloadWorkerConfig[index]);
+    (void)Cy_IPC_Pipe_RegisterCallback(benchOffloadEpAddr, &Bench_Offload_QueueCallback, BENCH_OFFLOAD_CLIENT_QUEUE);
+    Cy_SysLib_ExitCriticalSection(interruptState);
+
+    while (NULL == (work = benchOffloadRx))
+    {
+        __WFI();
+    }
+
+    if (CY_IPC_WORK_SUCCESS != Cy_IPC_Work_InitWorker(&benchOffloadWorker, work, index, benchOffloadMethods,
+                                                      sizeof(benchOffloadMethods) / sizeof(benchOffloadMethods[0])))
+    {
+        benchResult.errors++;
+        for (;;)
+        {
+            __WFI();
+        }
+    }
+
+    /* The release mask is set up front: the pipe rewrites it after the
+     * message has been sealed, it must not change */
+    Cy_IPC_Msg_InitHeader(&benchOffloadDone.hdr, BENCH_OFFLOAD_CLIENT_DONE, index, benchOffloadNotify[index],
+                          sizeof(benchOffloadDone.done));
+    for (;;)
+    {
+        status = Cy_IPC_Work_Run(&benchOffloadWorker, &benchOffloadDone.done, &notifyMask);
+        if (0UL != notifyMask)
+        {
+            Cy_IPC_Drv_AcquireNotify(Cy_IPC_Drv_GetIpcBaseAddress(benchOffloadChan[index]), notifyMask);
+        }
+
+        if (CY_IPC_WORK_SUCCESS == status)
+        {
+            Cy_IPC_Msg_Seal(&benchOffloadDone, &benchOffloadTx);
+            Bench_Offload_Transfer(CY_IPC_EP_CYPIPE_CM0_ADDR, benchOffloadEpAddr, &benchOffloadDone);
+            Cy_IPC_Msg_Sent(&benchOffloadTx);
+        }
+        else
+        {
+            /* A doorbell after the last look still ends the WFI */
+            interruptState = Cy_SysLib_EnterCriticalSection();
+            if (Cy_IPC_Work_Sleep(&benchOffloadWorker))
+            {
+                __WFI();
+            }
+            Cy_SysLib_ExitCriticalSection(interruptState);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_Offload_SubmitterIsr
+********************************************************************************
+* Summary:
+* Pipe interrupt of the submitter endpoint: completions and the releases
+* of the queue messages.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Offload_SubmitterIsr(void)
+{
+    Cy_IPC_Pipe_ExecuteCallback(CY_IPC_EP_CYPIPE_CM0_ADDR);
+}
+
+/*******************************************************************************
+* Function Name: Bench_Offload_WorkerIsr
+********************************************************************************
+* Summary:
+* Pipe interrupt of a worker endpoint: the queue message, the releases of
+* the completions, and doorbells, which only wake the worker. The channel of
+* the worker is shared with EP0, where the completions wait, so once the
+* queue is in, the doorbells are taken before the pipe driver reads it.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Offload_WorkerIsr(void)
+{
+    if (NULL != benchOffloadRx)
+    {
+        (void)Cy_IPC_Cypipe_TakeNotify(benchOffloadEpIntr);
+    }
+    Cy_IPC_Pipe_ExecuteCallback(benchOffloadEpAddr);
+}
+
+/*******************************************************************************
+* Function Name: Bench_Offload_QueueCallback
+********************************************************************************
+* Summary:
+* Client callback of a worker: CM0+ hands over the queue, whose pool the
+* worker maps non-cacheable, as the queue requires between the CM7 cores.
+*
+* Parameters:
+*  msgData: Queue message
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Offload_QueueCallback(uint32_t *msgData)
+{
+    cy_stc_bench_pool_t const *msg = (cy_stc_bench_pool_t const *)msgData;
+
+    if ((CY_IPC_MSG_SUCCESS != Cy_IPC_Msg_Check(msg, sizeof(msg->base) + sizeof(msg->size), NULL)) ||
+        (CY_IPC_HANDOFF_SUCCESS != Cy_IPC_Handoff_Init(&benchOffloadHandoff, msg->base, msg->size,
+                                                       CY_IPC_HANDOFF_NONCACHEABLE)))
+    {
+        benchResult.errors++;
+        return;
+    }
+    benchOffloadRx = (cy_stc_ipc_work_t *)msg->base;
+}
+
+/*******************************************************************************
+* Function Name: Bench_Offload_DoneCallback
+********************************************************************************
+* Summary:
+* Client callback of the submitter: checks a completion against the job in
+* its slot of the window, frees the slot and submits the next job. Counts
+* it, per worker and as stolen or not, while the driver is recording.
+*
+* Parameters:
+*  msgData: Completion
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Offload_DoneCallback(uint32_t *msgData)
+{
+    cy_stc_bench_done_t const *msg = (cy_stc_bench_done_t const *)msgData;
+    cy_stc_ipc_work_done_t const *done = &msg->done;
+    uint32_t worker = msg->hdr.pktType;
+    uint32_t slot = done->id;
+    bool valid;
+
+    valid = (worker < benchConfig.workers) &&
+            (CY_IPC_MSG_SUCCESS == Cy_IPC_Msg_Check(msg, sizeof(msg->done), &benchOffloadSeq[worker])) &&
+            (done->worker == worker) && (slot < BENCH_OFFLOAD_WINDOW) &&
+            (0UL == (benchOffloadFree & (1UL << slot))) && ((uint8_t)CY_IPC_WORK_SUCCESS == done->status) &&
+            ((uint8_t)CY_IPC_CORE_CM0P == done->core) && (done->result == (uint32_t)(benchOffloadArg[slot] * BENCH_OFFLOAD_HASH));
+    if (!valid)
+    {
+        benchResult.errors++;
+        return;
+    }
+
+    if (atomic_load_explicit(&benchConfig.recording, memory_order_relaxed))
+    {
+        benchResult.messages++;
+        benchResult.jobs[worker]++;
+        benchResult.stolenJobs += done->stolen;
+    }
+
+    benchOffloadFree |= 1UL << slot;
+    Bench_Offload_Fill();
+}
+
+/*******************************************************************************
+* Function Name: Bench_Offload_Fill
+********************************************************************************
+* Summary:
+* Submits a job for every free slot of the window, to CM7_0 if pinned,
+* and rings the doorbell of a worker that sleeps. Call with interrupts
+* masked.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Offload_Fill(void)
+{
+    cy_stc_ipc_work_job_t job = { 0U, (uint8_t)CY_IPC_CORE_CM0P, 0U, 0UL, 0UL };
+    uint32_t notifyMask;
+    uint32_t slot;
+
+    for (slot = 0UL; (0UL != benchOffloadFree) && (slot < BENCH_OFFLOAD_WINDOW); slot++)
+    {
+        if (0UL == (benchOffloadFree & (1UL << slot)))
+        {
+            continue;
+        }
+
+        job.id = slot;
+        job.arg = benchOffloadNext;
+        if (CY_IPC_WORK_SUCCESS != Cy_IPC_Work_SubmitRemote(benchResult.work,
+                                                            benchConfig.pinned ? 0UL : CY_IPC_WORK_ANY_WORKER,
+                                                            &job, &notifyMask))
+        {
+            break;
+        }
+        benchOffloadArg[slot] = benchOffloadNext++;
+        benchOffloadFree &= ~(1UL << slot);
+
+        if (0UL != notifyMask)
+        {
+            Cy_IPC_Drv_AcquireNotify(Cy_IPC_Drv_GetIpcBaseAddress(CY_IPC_CHAN_CYPIPE_EP0), notifyMask);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_Offload_Transfer
+********************************************************************************
+* Summary:
+* Sends a message and waits for its release.
+*
+* Parameters:
+*  toAddr: Receiver endpoint
+*  fromAddr: Sender endpoint
+*  msg: Message
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Offload_Transfer(uint32_t toAddr, uint32_t fromAddr, void *msg)
+{
+    uint32_t interruptState;
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    while (CY_IPC_PIPE_SUCCESS != Cy_IPC_Pipe_SendMessage(toAddr, fromAddr, msg, NULL))
+    {
+        Cy_SysLib_ExitCriticalSection(interruptState);
+        interruptState = Cy_SysLib_EnterCriticalSection();
+    }
+    while (Cy_IPC_Pipe_EndpointIsBusy(fromAddr))
+    {
+        __WFI();
+        Cy_SysLib_ExitCriticalSection(interruptState);
+        interruptState = Cy_SysLib_EnterCriticalSection();
+    }
+    Cy_SysLib_ExitCriticalSection(interruptState);
+}
+
+/*******************************************************************************
+* Function Name: Bench_Offload_Hash
+********************************************************************************
+* Summary:
+* The one method of the benchmark jobs: busy for benchConfig.work ns, but
+* asleep, so that two workers can overlap on a host with fewer CPUs than
+* emulated cores.
+*
+* Parameters:
+*  arg: Argument of the job
+*
+* Return:
+*  The argument times BENCH_OFFLOAD_HASH.
+*******************************************************************************/
+uint32_t Bench_Offload_Hash(uint32_t arg)
+{
+    Bench_Stream_Wait(Cy_IPC_Stats_Clock() + benchConfig.work);
+
+    return (uint32_t)(arg * BENCH_OFFLOAD_HASH);
+}
+
+/* [] END OF FILE */
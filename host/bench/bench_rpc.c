@@ -0,0 +1,437 @@
+/******************************************************************************
+* File Name:   bench_rpc.c
+*
+* Description: RPC benchmark, linked into every benchmark image. CM7_0
+*              keeps a window of calls in flight to CM0+ on the control
+*              lane, as Pipe2_cm7_0_Call(): requests and responses travel
+*              in two rings owned by CM7_0, the pipe carries a doorbell
+*              each way. CM0+ serves each drain in reverse order, so the
+*              responses to a window complete out of order. CM7_0 checks
+*              every result and records the round trip of each call.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "cy_pdl.h"
+#include "bench.h"
+#include "ipc_messages.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BENCH_RPC_HASH                  (2654435761UL)  /* Result of a call: its argument times this */
+#define BENCH_RPC_ID_SLOT_Msk           (CY_IPC_RPC_MAX_PENDING - 1UL)
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void Bench_Rpc_ServerIsr(void);
+void Bench_Rpc_CallerIsr(void);
+void Bench_Rpc_RequestCallback(uint32_t *msgData);
+void Bench_Rpc_ResponseCallback(uint32_t *msgData);
+void Bench_Rpc_RingRequest(void);
+void Bench_Rpc_RingResponse(void);
+void Bench_Rpc_Done(uint32_t id, cy_en_ipc_rpc_status_t status, uint32_t result, void *context);
+static cy_en_ipc_rpc_status_t Bench_Rpc_Hash(uint32_t arg, uint32_t *result);
+
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static cy_stc_ipc_pipe_ep_t benchRpcEpArray[CY_IPC_MAX_ENDPOINTS];
+static cy_ipc_pipe_callback_ptr_t benchRpcCb[1];
+
+/* The server takes the requests on EP3, the caller the responses on EP4 */
+static const cy_stc_ipc_pipe_config_t benchRpcServerConfig =
+    { CY_IPC_CYPIPE_EP_CONFIG(3), CY_IPC_CYPIPE_EP_CONFIG(4), 1UL, benchRpcCb, &Bench_Rpc_ServerIsr };
+static const cy_stc_ipc_pipe_config_t benchRpcCallerConfig =
+    { CY_IPC_CYPIPE_EP_CONFIG(4), CY_IPC_CYPIPE_EP_CONFIG(3), 1UL, benchRpcCb, &Bench_Rpc_CallerIsr };
+
+static const cy_ipc_rpc_method_t benchRpcMethods[] = { &Bench_Rpc_Hash };
+
+/* Server */
+static const cy_stc_ipc_rpc_server_t benchRpcServer =
+{
+    benchRpcMethods,
+    sizeof(benchRpcMethods) / sizeof(benchRpcMethods[0]),
+    BENCH_RPC_CLIENT_RESPONSE,
+    0UL,
+    CY_IPC_CYPIPE_INTR_MASK_EP3
+};
+static cy_stc_ipc_rpcdoorbellmsg_t benchRpcResponseMsg;
+static volatile bool benchRpcResponseDue;   /* A response doorbell found the pipe busy */
+
+/* Caller: both rings, and the argument and send time of the call in each slot */
+static cy_stc_ipc_rpc_client_t benchRpc;
+static cy_stc_ipc_ring_t benchRpcRequestRing;
+static cy_stc_ipc_ring_t benchRpcResponseRing;
+static CY_ALIGN(IPC_PORT_CACHE_LINE) uint8_t benchRpcRequestBuf[CY_IPC_RING_STORAGE_SIZE(sizeof(cy_stc_ipc_rpc_msg_t), CY_IPC_RPC_MAX_PENDING)];
+static CY_ALIGN(IPC_PORT_CACHE_LINE) uint8_t benchRpcResponseBuf[CY_IPC_RING_STORAGE_SIZE(sizeof(cy_stc_ipc_rpc_msg_t), CY_IPC_RPC_MAX_PENDING)];
+static cy_stc_ipc_rpcdoorbellmsg_t benchRpcRequestMsg;
+static uint32_t benchRpcInFlight;
+static uint32_t benchRpcNext;               /* Argument of the next call */
+static uint32_t benchRpcArg[CY_IPC_RPC_MAX_PENDING];
+static uint32_t benchRpcSent[CY_IPC_RPC_MAX_PENDING];
+
+
+/*******************************************************************************
+* Function Name: Bench_Rpc_Serve
+********************************************************************************
+* Summary:
+* Server role of CM0+. Sets up the control endpoint and returns; the caller
+* sleeps. Each request doorbell serves the requests queued by CM7_0.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Rpc_Serve(void)
+{
+    uint32_t interruptState;
+
+    __enable_irq();
+
+    Cy_IPC_Msg_InitRpcDoorbell(&benchRpcResponseMsg, BENCH_RPC_CLIENT_RESPONSE, 0UL, CY_IPC_CYPIPE_INTR_MASK_EP3);
+    Cy_IPC_Msg_Seal(&benchRpcResponseMsg, NULL);
+
+    Cy_IPC_Pipe_Config(benchRpcEpArray);
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    Cy_IPC_Pipe_Init(&benchRpcServerConfig);
+    (void)Cy_IPC_Pipe_RegisterCallback(CY_IPC_EP_CYPIPE_CM0_CTL_ADDR, &Bench_Rpc_RequestCallback, BENCH_RPC_CLIENT_REQUEST);
+    Cy_SysLib_ExitCriticalSection(interruptState);
+}
+
+/*******************************************************************************
+* Function Name: Bench_Rpc_Call
+********************************************************************************
+* Summary:
+* Caller role of CM7_0. Sets up both rings and the control endpoint, then
+* keeps benchConfig.batch calls in flight forever, and sleeps while the
+* window is full.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Rpc_Call(void)
+{
+    cy_stc_ipc_rpc_msg_t request;
+    uint32_t interruptState;
+    uint32_t id;
+    bool queued;
+
+    __enable_irq();
+
+    if ((CY_IPC_RING_SUCCESS != Cy_IPC_Ring_Init(&benchRpcRequestRing, benchRpcRequestBuf, sizeof(cy_stc_ipc_rpc_msg_t),
+                                                 CY_IPC_RPC_MAX_PENDING)) ||
+        (CY_IPC_RING_SUCCESS != Cy_IPC_Ring_Init(&benchRpcResponseRing, benchRpcResponseBuf, sizeof(cy_stc_ipc_rpc_msg_t),
+                                                 CY_IPC_RPC_MAX_PENDING)))
+    {
+        benchResult.errors++;
+        for (;;)
+        {
+            __WFI();
+        }
+    }
+    Cy_IPC_Rpc_InitClient(&benchRpc, BENCH_RPC_CLIENT_REQUEST, 0UL, CY_IPC_CYPIPE_INTR_MASK_EP4);
+
+    Cy_IPC_Msg_InitRpcDoorbell(&benchRpcRequestMsg, BENCH_RPC_CLIENT_REQUEST, 0UL, CY_IPC_CYPIPE_INTR_MASK_EP4);
+    benchRpcRequestMsg.payload.request = &benchRpcRequestRing;
+    benchRpcRequestMsg.payload.response = &benchRpcResponseRing;
+    Cy_IPC_Msg_Seal(&benchRpcRequestMsg, NULL);
+
+    Cy_IPC_Pipe_Config(benchRpcEpArray);
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    Cy_IPC_Pipe_Init(&benchRpcCallerConfig);
+    (void)Cy_IPC_Pipe_RegisterCallback(CY_IPC_EP_CYPIPE_CM7_0_CTL_ADDR, &Bench_Rpc_ResponseCallback, BENCH_RPC_CLIENT_RESPONSE);
+    Cy_SysLib_ExitCriticalSection(interruptState);
+
+    for (;;)
+    {
+        queued = false;
+        interruptState = Cy_SysLib_EnterCriticalSection();
+        while ((benchRpcInFlight < benchConfig.batch) &&
+               (CY_IPC_RPC_SUCCESS == Cy_IPC_Rpc_Prepare(&benchRpc, 0UL, benchRpcNext, &Bench_Rpc_Done, NULL,
+                                                         &request, &id)))
+        {
+            benchRpcArg[id & BENCH_RPC_ID_SLOT_Msk] = benchRpcNext++;
+            benchRpcSent[id & BENCH_RPC_ID_SLOT_Msk] = Cy_IPC_Stats_Clock();
+            if (CY_IPC_RING_SUCCESS != Cy_IPC_Ring_Push(&benchRpcRequestRing, &request))
+            {
+                (void)Cy_IPC_Rpc_Cancel(&benchRpc, id);
+                benchResult.errors++;
+                break;
+            }
+            benchRpcInFlight++;
+            queued = true;
+        }
+        if (queued)
+        {
+            Bench_Rpc_RingRequest();
+        }
+        __WFI();
+        Cy_SysLib_ExitCriticalSection(interruptState);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_Rpc_ServerIsr
+********************************************************************************
+* Summary:
+* Pipe interrupt of the server endpoint: request doorbells, and the
+* releases of the response doorbells, after which a busy one rings again.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Rpc_ServerIsr(void)
+{
+    Cy_IPC_Pipe_ExecuteCallback(CY_IPC_EP_CYPIPE_CM0_CTL_ADDR);
+
+    if (benchRpcResponseDue)
+    {
+        Bench_Rpc_RingResponse();
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_Rpc_CallerIsr
+********************************************************************************
+* Summary:
+* Pipe interrupt of the caller endpoint: response doorbells, and the
+* releases of the request doorbells. CM0+ drains the requests before it
+* releases, anything left was queued since.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Rpc_CallerIsr(void)
+{
+    Cy_IPC_Pipe_ExecuteCallback(CY_IPC_EP_CYPIPE_CM7_0_CTL_ADDR);
+
+    if (0UL != Cy_IPC_Ring_Count(&benchRpcRequestRing))
+    {
+        Bench_Rpc_RingRequest();
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_Rpc_RequestCallback
+********************************************************************************
+* Summary:
+* Client callback of the server: takes every queued request, serves them
+* last first and pushes the responses, then rings the response doorbell.
+*
+* Parameters:
+*  msgData: Request doorbell
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Rpc_RequestCallback(uint32_t *msgData)
+{
+    const cy_stc_ipc_rpcdoorbellmsg_t *pDoorbell = Cy_IPC_Msg_GetRpcDoorbell(msgData);
+    cy_stc_ipc_rpc_msg_t request[CY_IPC_RPC_MAX_PENDING];
+    cy_stc_ipc_rpc_msg_t response;
+    uint32_t count = 0UL;
+
+    if (NULL == pDoorbell)
+    {
+        benchResult.errors++;
+        return;
+    }
+
+    while ((count < CY_IPC_RPC_MAX_PENDING) &&
+           (CY_IPC_RING_SUCCESS == Cy_IPC_Ring_Pop(pDoorbell->payload.request, &request[count])))
+    {
+        count++;
+    }
+
+    if (0UL != count)
+    {
+        while (0UL != count)
+        {
+            count--;
+            Cy_IPC_Rpc_Serve(&benchRpcServer, &request[count], &response);
+            /* The response ring is as deep as the calls in flight, a full one is a bug */
+            if (CY_IPC_RING_SUCCESS != Cy_IPC_Ring_Push(pDoorbell->payload.response, &response))
+            {
+                benchResult.errors++;
+            }
+        }
+        benchRpcResponseDue = true;
+        Bench_Rpc_RingResponse();
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_Rpc_ResponseCallback
+********************************************************************************
+* Summary:
+* Client callback of the caller: completes every queued response. A
+* response that matches no call in flight is an error.
+*
+* Parameters:
+*  msgData: Response doorbell
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Rpc_ResponseCallback(uint32_t *msgData)
+{
+    cy_stc_ipc_rpc_msg_t response;
+
+    (void)msgData;
+    while (CY_IPC_RING_SUCCESS == Cy_IPC_Ring_Pop(&benchRpcResponseRing, &response))
+    {
+        if (CY_IPC_RPC_SUCCESS != Cy_IPC_Rpc_Complete(&benchRpc, &response))
+        {
+            benchResult.errors++;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_Rpc_RingRequest
+********************************************************************************
+* Summary:
+* Tells CM0+ to serve the queued requests. A busy pipe is not an error, the
+* caller ISR rings again after the release.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Rpc_RingRequest(void)
+{
+    (void)Cy_IPC_Pipe_SendMessage(CY_IPC_EP_CYPIPE_CM0_CTL_ADDR, CY_IPC_EP_CYPIPE_CM7_0_CTL_ADDR,
+                                  (void *)&benchRpcRequestMsg, NULL);
+}
+
+/*******************************************************************************
+* Function Name: Bench_Rpc_RingResponse
+********************************************************************************
+* Summary:
+* Tells CM7_0 to complete the pushed responses. If the pipe is busy, the
+* server ISR rings again after the release.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Rpc_RingResponse(void)
+{
+    if (CY_IPC_PIPE_SUCCESS == Cy_IPC_Pipe_SendMessage(CY_IPC_EP_CYPIPE_CM7_0_CTL_ADDR, CY_IPC_EP_CYPIPE_CM0_CTL_ADDR,
+                                                       (void *)&benchRpcResponseMsg, NULL))
+    {
+        benchRpcResponseDue = false;
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_Rpc_Done
+********************************************************************************
+* Summary:
+* Completion callback of every call: checks the result against the argument
+* of its slot, records the round trip while the driver is recording, and
+* frees a place in the window.
+*
+* Parameters:
+*  id: Request ID
+*  status: Status returned by CM0+
+*  result: Argument times BENCH_RPC_HASH
+*  context: Not used
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Rpc_Done(uint32_t id, cy_en_ipc_rpc_status_t status, uint32_t result, void *context)
+{
+    uint32_t slot = id & BENCH_RPC_ID_SLOT_Msk;
+
+    (void)context;
+    if ((CY_IPC_RPC_SUCCESS != status) || (result != (uint32_t)(benchRpcArg[slot] * BENCH_RPC_HASH)))
+    {
+        benchResult.errors++;
+    }
+
+    if (atomic_load_explicit(&benchConfig.recording, memory_order_relaxed))
+    {
+        benchResult.messages++;
+        benchResult.bytes += 2UL * sizeof(cy_stc_ipc_rpc_msg_t);
+        Cy_IPC_Stats_Record(&benchResult.latency, CY_IPC_STATS_STAGE_NOTIFY, Cy_IPC_Stats_Clock() - benchRpcSent[slot]);
+    }
+
+    benchRpcInFlight--;
+}
+
+/*******************************************************************************
+* Function Name: Bench_Rpc_Hash
+********************************************************************************
+* Summary:
+* The one method of the benchmark server.
+*
+* Parameters:
+*  arg: Argument of the call
+*  result: Receives the argument times BENCH_RPC_HASH
+*
+* Return:
+*  CY_IPC_RPC_SUCCESS
+*******************************************************************************/
+static cy_en_ipc_rpc_status_t Bench_Rpc_Hash(uint32_t arg, uint32_t *result)
+{
+    *result = (uint32_t)(arg * BENCH_RPC_HASH);
+
+    return CY_IPC_RPC_SUCCESS;
+}
+
+/* [] END OF FILE */
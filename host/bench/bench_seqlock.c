@@ -0,0 +1,423 @@
+/******************************************************************************
+* File Name:   bench_seqlock.c
+*
+* Description: Seqlock torn-read stress, linked into every benchmark image.
+*              CM7_1 rewrites a snapshot in a seqlock state region as fast
+*              as it can; CM0+ polls it, CM7_0 reads it on every doorbell
+*              and the SysTick of CM7_1 reads it in between the writer's
+*              updates. Every snapshot a reader accepts is checked to come
+*              from a single update.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+#include "cy_pdl.h"
+#include "bench.h"
+#include "ipc_messages.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BENCH_SEQLOCK_WORDS             (BENCH_MAX_MSG_SIZE / sizeof(uint32_t))
+
+/* Readers */
+#define BENCH_SEQLOCK_READER_CM0        (0UL)
+#define BENCH_SEQLOCK_READER_CM7_0      (1UL)
+#define BENCH_SEQLOCK_READER_TICK       (2UL)
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void Bench_Seqlock_WriterIsr(void);
+void Bench_Seqlock_ReaderIsr(void);
+void Bench_Seqlock_Tick(void);
+void Bench_Seqlock_Callback(uint32_t *msgData);
+void Bench_Seqlock_Check(uint32_t reader, uint32_t const *words, uint32_t seq);
+bool Bench_Seqlock_IsWhole(uint32_t const *words);
+
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static cy_stc_ipc_pipe_ep_t benchSeqlockEpArray[CY_IPC_MAX_ENDPOINTS];
+static cy_ipc_pipe_callback_ptr_t benchSeqlockCb[1];
+
+/* The writer sends from EP2, only releases come back */
+static const cy_stc_ipc_pipe_config_t benchSeqlockWriterConfig[] =
+{
+    { CY_IPC_CYPIPE_EP_CONFIG(2), CY_IPC_CYPIPE_EP_CONFIG(0), 0UL, NULL, &Bench_Seqlock_WriterIsr },
+    { CY_IPC_CYPIPE_EP_CONFIG(2), CY_IPC_CYPIPE_EP_CONFIG(1), 0UL, NULL, &Bench_Seqlock_WriterIsr },
+};
+
+/* Readers receive the state message, CM7_0 its doorbell too */
+static const cy_stc_ipc_pipe_config_t benchSeqlockReaderConfig[] =
+{
+    { CY_IPC_CYPIPE_EP_CONFIG(0), CY_IPC_CYPIPE_EP_CONFIG(2), 1UL, benchSeqlockCb, &Bench_Seqlock_ReaderIsr },
+    { CY_IPC_CYPIPE_EP_CONFIG(1), CY_IPC_CYPIPE_EP_CONFIG(2), 1UL, benchSeqlockCb, &Bench_Seqlock_ReaderIsr },
+};
+
+/* Writer */
+static cy_stc_ipc_seqlock_t benchSeqlock;
+static CY_ALIGN(IPC_PORT_CACHE_LINE) uint32_t benchSeqlockData[BENCH_SEQLOCK_WORDS];
+static cy_stc_ipc_statemsg_t benchSeqlockMsg;
+
+/* Reader, each image reads with its own copy */
+static cy_stc_ipc_seqlock_t *volatile benchSeqlockState;
+static uint32_t benchSeqlockEp;
+static uint32_t benchSeqlockLastSeq[BENCH_SEQLOCK_READERS];
+static uint32_t benchSeqlockCopy[BENCH_SEQLOCK_WORDS];
+static uint32_t benchSeqlockIsrCopy[BENCH_SEQLOCK_WORDS];
+
+
+/*******************************************************************************
+* Function Name: Bench_Seqlock_Write
+********************************************************************************
+* Summary:
+* Writer role of CM7_1. Hands the state region to CM0+ and CM7_0, then
+* rewrites the snapshot forever: update n stores n + i into word i, and
+* rings the doorbell of CM7_0. Its SysTick reads the region meanwhile.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Seqlock_Write(void)
+{
+    uint32_t words = benchConfig.msgSize / sizeof(uint32_t);
+    uint32_t interruptState;
+    uint32_t notifyMask;
+    uint32_t *data;
+    uint32_t n;
+    uint32_t i;
+
+    __enable_irq();
+
+    (void)Cy_IPC_Seqlock_Init(&benchSeqlock, benchSeqlockData, benchConfig.msgSize, CY_IPC_CYPIPE_INTR_MASK_EP1);
+
+    Cy_IPC_Pipe_Config(benchSeqlockEpArray);
+    Cy_IPC_Msg_InitState(&benchSeqlockMsg, BENCH_SEQLOCK_CLIENT_STATE, 0UL, 0UL);
+    benchSeqlockMsg.payload.state = &benchSeqlock;
+    Cy_IPC_Msg_Seal(&benchSeqlockMsg, NULL);
+    for (i = 0UL; i < (sizeof(benchSeqlockWriterConfig) / sizeof(benchSeqlockWriterConfig[0])); i++)
+    {
+        Cy_IPC_Pipe_Init(&benchSeqlockWriterConfig[i]);
+
+        interruptState = Cy_SysLib_EnterCriticalSection();
+        while (CY_IPC_PIPE_SUCCESS != Cy_IPC_Pipe_SendMessage(benchSeqlockWriterConfig[i].ep1ConfigData.epAddress,
+                                                              CY_IPC_EP_CYPIPE_CM7_1_ADDR, &benchSeqlockMsg, NULL))
+        {
+            Cy_SysLib_ExitCriticalSection(interruptState);
+            interruptState = Cy_SysLib_EnterCriticalSection();
+        }
+        while (Cy_IPC_Pipe_EndpointIsBusy(CY_IPC_EP_CYPIPE_CM7_1_ADDR))
+        {
+            __WFI();
+            Cy_SysLib_ExitCriticalSection(interruptState);
+            interruptState = Cy_SysLib_EnterCriticalSection();
+        }
+        Cy_SysLib_ExitCriticalSection(interruptState);
+    }
+
+    benchSeqlockState = &benchSeqlock;
+    Cy_SysTick_Init(CY_SYSTICK_CLOCK_SOURCE_CLK_CPU, ((SystemCoreClock / 1000000UL) * BENCH_SEQLOCK_TICK_US) - 1UL);
+    Cy_SysTick_SetCallback(0UL, &Bench_Seqlock_Tick);
+
+    for (n = 1UL; ; n++)
+    {
+        data = (uint32_t *)Cy_IPC_Seqlock_BeginWrite(&benchSeqlock);
+        for (i = 0UL; i < words; i++)
+        {
+            data[i] = n + i;
+        }
+        notifyMask = Cy_IPC_Seqlock_EndWrite(&benchSeqlock);
+        Cy_IPC_Drv_AcquireNotify(Cy_IPC_Drv_GetIpcBaseAddress(CY_IPC_CHAN_CYPIPE_EP2), notifyMask);
+
+        if (atomic_load_explicit(&benchConfig.recording, memory_order_relaxed))
+        {
+            benchResult.updates++;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_Seqlock_Read
+********************************************************************************
+* Summary:
+* Reader role of CM0+ and CM7_0. Sets up the endpoint that receives the
+* state region. CM0+ then polls the region forever, one attempt at a time,
+* and also takes a plain copy without the seqlock to show the torn reads
+* it prevents. CM7_0 returns and reads on the doorbell; the caller sleeps.
+*
+* Parameters:
+*  core: Core that calls
+*
+* Return:
+*  None, never on CM0+
+*******************************************************************************/
+void Bench_Seqlock_Read(cy_en_ipc_core_t core)
+{
+    uint32_t reader = (CY_IPC_CORE_CM0P == core) ? BENCH_SEQLOCK_READER_CM0 : BENCH_SEQLOCK_READER_CM7_0;
+    cy_stc_bench_reader_result_t *result = &benchResult.reader[reader];
+    cy_stc_ipc_seqlock_t *state;
+    uint32_t interruptState;
+    uint32_t seq;
+
+    __enable_irq();
+
+    Cy_IPC_Pipe_Config(benchSeqlockEpArray);
+    benchSeqlockEp = benchSeqlockReaderConfig[reader].ep0ConfigData.epAddress;
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    Cy_IPC_Pipe_Init(&benchSeqlockReaderConfig[reader]);
+    (void)Cy_IPC_Pipe_RegisterCallback(benchSeqlockEp, &Bench_Seqlock_Callback, BENCH_SEQLOCK_CLIENT_STATE);
+    Cy_SysLib_ExitCriticalSection(interruptState);
+
+    if (BENCH_SEQLOCK_READER_CM0 != reader)
+    {
+        return;
+    }
+
+    while (NULL == (state = benchSeqlockState))
+    {
+        __WFI();
+    }
+
+    for (;;)
+    {
+        if (CY_IPC_SEQLOCK_SUCCESS == Cy_IPC_Seqlock_TryRead(state, benchSeqlockCopy, &seq))
+        {
+            Bench_Seqlock_Check(reader, benchSeqlockCopy, seq);
+        }
+        else if (atomic_load_explicit(&benchConfig.recording, memory_order_relaxed))
+        {
+            result->retries++;
+        }
+        else
+        {
+            /* Not recording */
+        }
+
+        (void)memcpy(benchSeqlockCopy, state->data, state->size);
+        if (!Bench_Seqlock_IsWhole(benchSeqlockCopy) &&
+            atomic_load_explicit(&benchConfig.recording, memory_order_relaxed))
+        {
+            result->torn++;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_Seqlock_WriterIsr
+********************************************************************************
+* Summary:
+* Pipe interrupt of the writer endpoint, takes the releases.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Seqlock_WriterIsr(void)
+{
+    Cy_IPC_Pipe_ExecuteCallback(CY_IPC_EP_CYPIPE_CM7_1_ADDR);
+}
+
+/*******************************************************************************
+* Function Name: Bench_Seqlock_ReaderIsr
+********************************************************************************
+* Summary:
+* Pipe interrupt of a reader endpoint: takes the state message, and on
+* CM7_0 reads the region on every doorbell.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Seqlock_ReaderIsr(void)
+{
+    cy_stc_bench_reader_result_t *result = &benchResult.reader[BENCH_SEQLOCK_READER_CM7_0];
+    cy_stc_ipc_seqlock_t *state;
+    uint32_t seq;
+
+    Cy_IPC_Pipe_ExecuteCallback(benchSeqlockEp);
+
+    state = benchSeqlockState;
+    if ((CY_IPC_EP_CYPIPE_CM7_0_ADDR != benchSeqlockEp) || (NULL == state))
+    {
+        return;
+    }
+
+    if (CY_IPC_SEQLOCK_SUCCESS == Cy_IPC_Seqlock_Read(state, benchSeqlockIsrCopy, &seq))
+    {
+        Bench_Seqlock_Check(BENCH_SEQLOCK_READER_CM7_0, benchSeqlockIsrCopy, seq);
+    }
+    else if (atomic_load_explicit(&benchConfig.recording, memory_order_relaxed))
+    {
+        result->busy++;
+    }
+    else
+    {
+        /* Not recording */
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_Seqlock_Tick
+********************************************************************************
+* Summary:
+* SysTick of CM7_1: reads the region on the writer's own core. An update it
+* interrupted cannot complete before it returns, so Cy_IPC_Seqlock_Read()
+* gives up instead of spinning.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Seqlock_Tick(void)
+{
+    cy_stc_bench_reader_result_t *result = &benchResult.reader[BENCH_SEQLOCK_READER_TICK];
+    uint32_t seq;
+
+    if (CY_IPC_SEQLOCK_SUCCESS == Cy_IPC_Seqlock_Read(&benchSeqlock, benchSeqlockIsrCopy, &seq))
+    {
+        Bench_Seqlock_Check(BENCH_SEQLOCK_READER_TICK, benchSeqlockIsrCopy, seq);
+    }
+    else if (atomic_load_explicit(&benchConfig.recording, memory_order_relaxed))
+    {
+        result->busy++;
+    }
+    else
+    {
+        /* Not recording */
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_Seqlock_Callback
+********************************************************************************
+* Summary:
+* Client callback of the reader endpoints: the writer hands out its region.
+*
+* Parameters:
+*  msgData: State message
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Seqlock_Callback(uint32_t *msgData)
+{
+    cy_stc_ipc_statemsg_t const *msg = Cy_IPC_Msg_GetState(msgData);
+
+    if (NULL != msg)
+    {
+        benchSeqlockState = msg->payload.state;
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_Seqlock_Check
+********************************************************************************
+* Summary:
+* Checks an accepted snapshot: it is whole, it is the update its sequence
+* number says, and it is not older than the snapshot the reader took
+* before. Counts it while the driver is recording.
+*
+* Parameters:
+*  reader: Reader
+*  words: Snapshot
+*  seq: Sequence number of the snapshot
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Seqlock_Check(uint32_t reader, uint32_t const *words, uint32_t seq)
+{
+    cy_stc_bench_reader_result_t *result = &benchResult.reader[reader];
+    bool valid = Bench_Seqlock_IsWhole(words) && (words[0] == (seq / 2UL)) &&
+                 ((int32_t)(seq - benchSeqlockLastSeq[reader]) >= 0);
+
+    benchSeqlockLastSeq[reader] = seq;
+    if (!atomic_load_explicit(&benchConfig.recording, memory_order_relaxed))
+    {
+        return;
+    }
+
+    result->reads++;
+    if (!valid)
+    {
+        result->errors++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_Seqlock_IsWhole
+********************************************************************************
+* Summary:
+* Returns true if every word of a copy comes from the same update. The
+* first snapshot is all zero.
+*
+* Parameters:
+*  words: Copy of the snapshot
+*
+* Return:
+*  true if whole
+*******************************************************************************/
+bool Bench_Seqlock_IsWhole(uint32_t const *words)
+{
+    uint32_t count = benchConfig.msgSize / sizeof(uint32_t);
+    uint32_t i;
+
+    for (i = 1UL; i < count; i++)
+    {
+        if (words[i] != ((0UL == words[0]) ? 0UL : (words[0] + i)))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* [] END OF FILE */
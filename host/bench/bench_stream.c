@@ -0,0 +1,394 @@
+/******************************************************************************
+* File Name:   bench_stream.c
+*
+* Description: Streaming channel benchmark, linked into every benchmark
+*              image. CM7_0 completes a sample block every block period of
+*              the configured rate and commits it to a stream; CM0+
+*              consumes either on the doorbell, busy for a set time per
+*              block, or on its own clock. Every block is checked, and
+*              the overruns, underruns and lost blocks are counted.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "cy_pdl.h"
+#include "bench.h"
+#include "ipc_messages.h"
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void Bench_Stream_ProducerIsr(void);
+void Bench_Stream_ConsumerIsr(void);
+void Bench_Stream_Callback(uint32_t *msgData);
+void Bench_Stream_Take(cy_stc_ipc_stream_t *stream);
+
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static cy_stc_ipc_pipe_ep_t benchStreamEpArray[CY_IPC_MAX_ENDPOINTS];
+static cy_ipc_pipe_callback_ptr_t benchStreamCb[1];
+
+/* The producer sends from EP1, only the release of the stream message comes back */
+static const cy_stc_ipc_pipe_config_t benchStreamProducerConfig =
+    { CY_IPC_CYPIPE_EP_CONFIG(1), CY_IPC_CYPIPE_EP_CONFIG(0), 0UL, NULL, &Bench_Stream_ProducerIsr };
+
+/* The consumer receives the stream message, then the doorbells */
+static const cy_stc_ipc_pipe_config_t benchStreamConsumerConfig =
+    { CY_IPC_CYPIPE_EP_CONFIG(0), CY_IPC_CYPIPE_EP_CONFIG(1), 1UL, benchStreamCb, &Bench_Stream_ConsumerIsr };
+
+/* Producer */
+static cy_stc_ipc_stream_t benchStream;
+static CY_ALIGN(IPC_PORT_CACHE_LINE) uint8_t benchStreamBuf[CY_IPC_STREAM_MAX_BUFFERS * BENCH_MAX_MSG_SIZE];
+static cy_stc_ipc_streammsg_t benchStreamMsg;
+
+/* Consumer */
+static cy_stc_ipc_stream_t *volatile benchStreamRx;
+static uint32_t benchStreamNext;
+
+
+/*******************************************************************************
+* Function Name: Bench_Stream_Produce
+********************************************************************************
+* Summary:
+* Producer role of CM7_0. Hands the stream to CM0+, then completes block n
+* at the end of its block period forever, with n + i in word i as the
+* samples, and rings the doorbell of every block committed. A producer
+* that fell behind commits at once, so the average rate holds. Stops when
+* the driver ends the recording, so that it can check the final counts.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Stream_Produce(void)
+{
+    uint32_t words = benchConfig.msgSize / sizeof(uint32_t);
+    cy_en_ipc_stream_status_t status;
+    uint32_t interruptState;
+    uint32_t notifyMask;
+    bool recording;
+    bool recorded = false;
+    uint32_t period;
+    uint32_t due;
+    uint32_t *data;
+    uint32_t n;
+    uint32_t i;
+
+    __enable_irq();
+
+    (void)Cy_IPC_Stream_Init(&benchStream, benchStreamBuf, benchConfig.msgSize, benchConfig.buffers,
+                             benchConfig.rate, CY_IPC_CYPIPE_INTR_MASK_EP0);
+    period = Cy_IPC_Stream_PeriodUs(&benchStream) * 1000UL;
+
+    Cy_IPC_Pipe_Config(benchStreamEpArray);
+    Cy_IPC_Pipe_Init(&benchStreamProducerConfig);
+    Cy_IPC_Msg_InitStream(&benchStreamMsg, BENCH_STREAM_CLIENT, 0UL, 0UL);
+    benchStreamMsg.payload.stream = &benchStream;
+    Cy_IPC_Msg_Seal(&benchStreamMsg, NULL);
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    while (CY_IPC_PIPE_SUCCESS != Cy_IPC_Pipe_SendMessage(CY_IPC_EP_CYPIPE_CM0_ADDR, CY_IPC_EP_CYPIPE_CM7_0_ADDR,
+                                                          &benchStreamMsg, NULL))
+    {
+        Cy_SysLib_ExitCriticalSection(interruptState);
+        interruptState = Cy_SysLib_EnterCriticalSection();
+    }
+    while (Cy_IPC_Pipe_EndpointIsBusy(CY_IPC_EP_CYPIPE_CM7_0_ADDR))
+    {
+        __WFI();
+        Cy_SysLib_ExitCriticalSection(interruptState);
+        interruptState = Cy_SysLib_EnterCriticalSection();
+    }
+    Cy_SysLib_ExitCriticalSection(interruptState);
+    benchResult.stream = &benchStream;
+
+    due = Cy_IPC_Stats_Clock();
+    for (n = 0UL; ; n++)
+    {
+        recording = atomic_load_explicit(&benchConfig.recording, memory_order_relaxed);
+        if (recorded && !recording)
+        {
+            break;
+        }
+        recorded = recorded || recording;
+
+        due += period;
+        Bench_Stream_Wait(due);
+
+        data = (uint32_t *)Cy_IPC_Stream_Fill(&benchStream);
+        for (i = 0UL; i < words; i++)
+        {
+            data[i] = n + i;
+        }
+        status = Cy_IPC_Stream_Commit(&benchStream, benchConfig.msgSize, &notifyMask);
+        if (0UL != notifyMask)
+        {
+            Cy_IPC_Drv_AcquireNotify(Cy_IPC_Drv_GetIpcBaseAddress(CY_IPC_CHAN_CYPIPE_EP1), notifyMask);
+        }
+
+        if (recording)
+        {
+            benchResult.blocks++;
+            if (CY_IPC_STREAM_OVERRUN == status)
+            {
+                benchResult.overruns++;
+            }
+        }
+    }
+
+    for (;;)
+    {
+        __WFI();
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_Stream_Consume
+********************************************************************************
+* Summary:
+* Consumer role of CM0+. Sets up the endpoint that receives the stream. A
+* doorbell consumer returns and drains the stream in its pipe interrupt;
+* the caller sleeps. A paced consumer waits for the first block, then
+* takes a block every benchConfig.work ns forever, as a sink clocked
+* independently of the producer would.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None, never for a paced consumer
+*******************************************************************************/
+void Bench_Stream_Consume(void)
+{
+    cy_stc_ipc_stream_t *stream;
+    uint32_t interruptState;
+    uint32_t due;
+
+    __enable_irq();
+
+    Cy_IPC_Pipe_Config(benchStreamEpArray);
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    Cy_IPC_Pipe_Init(&benchStreamConsumerConfig);
+    (void)Cy_IPC_Pipe_RegisterCallback(CY_IPC_EP_CYPIPE_CM0_ADDR, &Bench_Stream_Callback, BENCH_STREAM_CLIENT);
+    Cy_SysLib_ExitCriticalSection(interruptState);
+
+    if (BENCH_RX_PACED != benchConfig.rx)
+    {
+        return;
+    }
+
+    while ((NULL == (stream = benchStreamRx)) || (0UL == Cy_IPC_Stream_Pending(stream)))
+    {
+        __WFI();
+    }
+
+    due = Cy_IPC_Stats_Clock();
+    for (;;)
+    {
+        Bench_Stream_Take(stream);
+        due += benchConfig.work;
+        Bench_Stream_Wait(due);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_Stream_ProducerIsr
+********************************************************************************
+* Summary:
+* Pipe interrupt of the producer endpoint, takes the release of the stream
+* message.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Stream_ProducerIsr(void)
+{
+    Cy_IPC_Pipe_ExecuteCallback(CY_IPC_EP_CYPIPE_CM7_0_ADDR);
+}
+
+/*******************************************************************************
+* Function Name: Bench_Stream_ConsumerIsr
+********************************************************************************
+* Summary:
+* Pipe interrupt of the consumer endpoint: takes the stream message, and
+* for a doorbell consumer drains every block committed so far. Blocks
+* committed while it drains raise the interrupt again.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Stream_ConsumerIsr(void)
+{
+    cy_stc_ipc_stream_t *stream;
+
+    Cy_IPC_Pipe_ExecuteCallback(CY_IPC_EP_CYPIPE_CM0_ADDR);
+
+    stream = benchStreamRx;
+    if ((BENCH_RX_PACED == benchConfig.rx) || (NULL == stream))
+    {
+        return;
+    }
+
+    while (0UL != Cy_IPC_Stream_Pending(stream))
+    {
+        Bench_Stream_Take(stream);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_Stream_Callback
+********************************************************************************
+* Summary:
+* Client callback of the consumer endpoint: the producer hands out its
+* stream.
+*
+* Parameters:
+*  msgData: Stream message
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Stream_Callback(uint32_t *msgData)
+{
+    cy_stc_ipc_streammsg_t const *msg = Cy_IPC_Msg_GetStream(msgData);
+
+    if (NULL != msg)
+    {
+        benchStreamRx = msg->payload.stream;
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_Stream_Take
+********************************************************************************
+* Summary:
+* Consumes one block: checks its length, its samples and that it comes
+* after the block before, keeps a doorbell consumer in it for
+* benchConfig.work ns, and releases it. Counts it, the blocks missing
+* before it, or the underrun if there was none, while the driver is
+* recording.
+*
+* Parameters:
+*  stream: Stream
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Stream_Take(cy_stc_ipc_stream_t *stream)
+{
+    bool recording = atomic_load_explicit(&benchConfig.recording, memory_order_relaxed);
+    uint32_t now = Cy_IPC_Stats_Clock();
+    uint32_t const *words;
+    uint32_t length = 0UL;
+    uint32_t seq = 0UL;
+    uint32_t lost;
+    uint32_t i;
+
+    words = (uint32_t const *)Cy_IPC_Stream_Acquire(stream, &length, &seq);
+    if (NULL == words)
+    {
+        if (recording)
+        {
+            benchResult.underruns++;
+        }
+        return;
+    }
+
+    if ((length != benchConfig.msgSize) || ((int32_t)(seq - benchStreamNext) < 0))
+    {
+        benchResult.errors++;
+    }
+    for (i = 0UL; i < (length / sizeof(uint32_t)); i++)
+    {
+        if (words[i] != (seq + i))
+        {
+            benchResult.errors++;
+            break;
+        }
+    }
+    benchStreamNext = seq + 1UL;
+
+    /* Busy, but asleep: the producer keeps its pace on a host with fewer
+     * CPUs than emulated cores */
+    if (BENCH_RX_PACED != benchConfig.rx)
+    {
+        Bench_Stream_Wait(now + benchConfig.work);
+    }
+
+    lost = stream->lost;
+    Cy_IPC_Stream_Release(stream);
+    if (recording)
+    {
+        benchResult.messages++;
+        benchResult.bytes += length;
+        benchResult.lost += stream->lost - lost;
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_Stream_Wait
+********************************************************************************
+* Summary:
+* Sleeps until a time, returns at once if it has passed.
+*
+* Parameters:
+*  due: Cy_IPC_Stats_Clock() to wait for, ns on the host
+*
+* Return:
+*  None
+*******************************************************************************/
+void Bench_Stream_Wait(uint32_t due)
+{
+    int32_t ahead;
+
+    while ((ahead = (int32_t)(due - Cy_IPC_Stats_Clock())) > 0)
+    {
+        Cy_SysLib_DelayUs((uint16_t)((ahead < 60000000L) ? (((uint32_t)ahead / 1000UL) + 1UL) : 60000UL));
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,435 @@
+/******************************************************************************
+* File Name:   dispatch_main.c
+*
+* Description: Compares the per-message cost of the CM0+ dispatch table of
+*              ipc_dispatch.c against the pktType switch it replaced. Both
+*              are reached through a pipe callback pointer, as from the
+*              PDL, and drive the three LED states of client CM0_ID0. The
+*              pktType is fixed, cycles through the states, or is random.
+*              Prints msgs/s and the p50, p99 and worst time of one
+*              message, averaged over a batch, as CSV or JSON.
+*              Usage: ipc_bench_dispatch [-t seconds] [-f csv|json]
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "ipc_dispatch.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BENCH_DISPATCH_RUN_TIME_S       (0.25)  /* Measured time per case */
+#define BENCH_DISPATCH_MSGS             (4096UL) /* Messages prepared per case, a power of 2 */
+#define BENCH_DISPATCH_BATCH            (64UL)  /* Messages per timing, hides the clock read */
+#define BENCH_DISPATCH_SAMPLES          (1UL << 20) /* Batch timings kept per case, in ns */
+#define BENCH_DISPATCH_STATES           (3UL)   /* LED states, pktType 0 .. 2 */
+#define BENCH_DISPATCH_CLIENT           (0UL)   /* CY_CLIENT_CYPIPE0_CM0_ID0 */
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef enum
+{
+    BENCH_DISPATCH_SWITCH,              /* switch on pktType in the pipe callback */
+    BENCH_DISPATCH_TABLE,               /* Cy_IPC_Dispatch_Message() */
+} cy_en_bench_dispatch_kind_t;
+
+typedef enum
+{
+    BENCH_DISPATCH_FIXED,               /* Always pktType 0 */
+    BENCH_DISPATCH_CYCLE,               /* pktType 0, 1, 2, 0, ... */
+    BENCH_DISPATCH_RANDOM,              /* Random pktType, defeats the branch predictor */
+} cy_en_bench_dispatch_mix_t;
+
+typedef struct
+{
+    uint32_t header;                    /* clientID, pktType and release mask, as in cy_stc_ipc_msg_hdr_t */
+    uint32_t data;
+} cy_stc_bench_dispatch_msg_t;
+
+typedef struct
+{
+    bool led1;                          /* LED1 state */
+    bool led2;                          /* LED2 state */
+    uint32_t index;                     /* Counter in benchDispatchHits */
+} cy_stc_bench_dispatch_led_t;
+
+typedef struct
+{
+    cy_en_bench_dispatch_kind_t kind;
+    cy_en_bench_dispatch_mix_t mix;
+    double msgsPerS;
+    double p50;                         /* ns per message */
+    double p99;
+    double max;
+} cy_stc_bench_dispatch_row_t;
+
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static cy_stc_ipc_dispatch_t benchDispatch;
+static cy_stc_bench_dispatch_msg_t benchDispatchMsgs[BENCH_DISPATCH_MSGS];
+static uint32_t benchDispatchSample[BENCH_DISPATCH_SAMPLES];
+
+/* Stand-ins for the LED pins, and messages delivered per LED state */
+static volatile bool benchDispatchLed1;
+static volatile bool benchDispatchLed2;
+static volatile uint32_t benchDispatchHits[BENCH_DISPATCH_STATES];
+
+static const cy_stc_bench_dispatch_led_t benchDispatchLedStates[BENCH_DISPATCH_STATES] =
+{
+    { true,  false, 0UL },              /* Led 1 On,  Led 2 Off */
+    { false, true,  1UL },              /* Led 1 Off, Led 2 On  */
+    { false, false, 2UL },              /* Led 1 Off, Led 2 Off */
+};
+
+static char const *const benchDispatchKindNames[] = { "switch", "table" };
+static char const *const benchDispatchMixNames[] = { "fixed", "cycle", "random" };
+
+/* Pipe callback of the case; volatile, so the call stays indirect as from the PDL */
+static void (*volatile benchDispatchCallback)(uint32_t *msgData);
+
+
+/*******************************************************************************
+* Function Name: Bench_DispatchNowNs
+********************************************************************************
+* Summary:
+* Returns the monotonic time in ns.
+*
+*******************************************************************************/
+static inline uint64_t Bench_DispatchNowNs(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+/*******************************************************************************
+* Function Name: Bench_DispatchSwitchCallback
+********************************************************************************
+* Summary:
+* The pipe callback of CM0+ before the dispatch table: one switch on the
+* pktType of the message.
+*
+*******************************************************************************/
+static void Bench_DispatchSwitchCallback(uint32_t *msgData)
+{
+    uint32_t pktType = (*msgData & CY_IPC_DISPATCH_TYPE_Msk) >> CY_IPC_DISPATCH_TYPE_Pos;
+
+    switch (pktType)
+    {
+        case 0:
+            benchDispatchLed1 = true;   /* Led 1 On */
+            benchDispatchLed2 = false;  /* Led 2 Off */
+            break;
+        case 1:
+            benchDispatchLed1 = false;  /* Led 1 Off */
+            benchDispatchLed2 = true;   /* Led 2 On */
+            break;
+        case 2:
+            benchDispatchLed1 = false;  /* Led 1 Off */
+            benchDispatchLed2 = false;  /* Led 2 Off */
+            break;
+        default:
+            return;
+    }
+    benchDispatchHits[pktType]++;
+}
+
+/*******************************************************************************
+* Function Name: Bench_DispatchLedHandler
+********************************************************************************
+* Summary:
+* Table handler of the LED states, registered once per pktType with the
+* state as context, as Pipe0_cm0_LedHandler.
+*
+*******************************************************************************/
+static void Bench_DispatchLedHandler(uint32_t *msgData, void *context)
+{
+    cy_stc_bench_dispatch_led_t const *state = (cy_stc_bench_dispatch_led_t const *)context;
+
+    (void)msgData;
+    benchDispatchLed1 = state->led1;
+    benchDispatchLed2 = state->led2;
+    benchDispatchHits[state->index]++;
+}
+
+/*******************************************************************************
+* Function Name: Bench_DispatchTableCallback
+********************************************************************************
+* Summary:
+* The pipe callback of CM0+ with the dispatch table, as
+* Pipe0_cm0_RecvMsgCallback.
+*
+*******************************************************************************/
+static void Bench_DispatchTableCallback(uint32_t *msgData)
+{
+    (void)Cy_IPC_Dispatch_Message(&benchDispatch, msgData);
+}
+
+/*******************************************************************************
+* Function Name: Bench_DispatchPrepare
+********************************************************************************
+* Summary:
+* Fills the messages of one mix. The random mix uses a fixed xorshift seed,
+* so both dispatchers see the same sequence.
+*
+*******************************************************************************/
+static void Bench_DispatchPrepare(cy_en_bench_dispatch_mix_t mix)
+{
+    uint32_t seed = 0x2545F491UL;
+    uint32_t pktType;
+    uint32_t i;
+
+    for (i = 0UL; i < BENCH_DISPATCH_MSGS; i++)
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+
+        switch (mix)
+        {
+            case BENCH_DISPATCH_CYCLE:  pktType = i % BENCH_DISPATCH_STATES; break;
+            case BENCH_DISPATCH_RANDOM: pktType = seed % BENCH_DISPATCH_STATES; break;
+            default:                    pktType = 0UL; break;
+        }
+
+        benchDispatchMsgs[i].header = (BENCH_DISPATCH_CLIENT << CY_IPC_DISPATCH_CLIENT_Pos) |
+                                      (pktType << CY_IPC_DISPATCH_TYPE_Pos);
+        benchDispatchMsgs[i].data = i;
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_DispatchCompare
+********************************************************************************
+* Summary:
+* qsort() comparison of two timings.
+*
+*******************************************************************************/
+static int Bench_DispatchCompare(void const *a, void const *b)
+{
+    uint32_t x = *(uint32_t const *)a;
+    uint32_t y = *(uint32_t const *)b;
+
+    return (x > y) - (x < y);
+}
+
+/*******************************************************************************
+* Function Name: Bench_DispatchRun
+********************************************************************************
+* Summary:
+* Runs one case and fills its results. Returns false if a message was not
+* delivered to the handler of its pktType.
+*
+*******************************************************************************/
+static bool Bench_DispatchRun(cy_stc_bench_dispatch_row_t *row, double seconds)
+{
+    uint32_t expected[BENCH_DISPATCH_STATES] = { 0UL };
+    uint32_t samples = 0UL;
+    uint32_t msgs = 0UL;
+    uint32_t next = 0UL;
+    uint64_t start;
+    uint64_t end;
+    uint64_t now;
+    uint32_t i;
+
+    Bench_DispatchPrepare(row->mix);
+    (void)memset((void *)benchDispatchHits, 0, sizeof(benchDispatchHits));
+    Cy_IPC_Dispatch_Init(&benchDispatch);
+    for (i = 0UL; i < BENCH_DISPATCH_STATES; i++)
+    {
+        (void)Cy_IPC_Dispatch_Register(&benchDispatch, BENCH_DISPATCH_CLIENT, i, &Bench_DispatchLedHandler,
+                                       (void *)&benchDispatchLedStates[i]);
+    }
+    benchDispatchCallback = (BENCH_DISPATCH_SWITCH == row->kind) ? &Bench_DispatchSwitchCallback
+                                                                 : &Bench_DispatchTableCallback;
+
+    now = Bench_DispatchNowNs();
+    end = now + (uint64_t)(seconds * 1e9);
+
+    while (now < end)
+    {
+        start = now;
+        for (i = 0UL; i < BENCH_DISPATCH_BATCH; i++)
+        {
+            benchDispatchCallback(&benchDispatchMsgs[next].header);
+            next = (next + 1UL) & (BENCH_DISPATCH_MSGS - 1UL);
+        }
+        now = Bench_DispatchNowNs();
+
+        msgs += BENCH_DISPATCH_BATCH;
+        if (samples < BENCH_DISPATCH_SAMPLES)
+        {
+            benchDispatchSample[samples++] = (uint32_t)(now - start);
+        }
+    }
+
+    /* Both dispatchers must deliver every message to the same LED state */
+    for (i = 0UL; i < msgs; i++)
+    {
+        expected[(benchDispatchMsgs[i & (BENCH_DISPATCH_MSGS - 1UL)].header & CY_IPC_DISPATCH_TYPE_Msk) >>
+                 CY_IPC_DISPATCH_TYPE_Pos]++;
+    }
+    for (i = 0UL; i < BENCH_DISPATCH_STATES; i++)
+    {
+        if (benchDispatchHits[i] != expected[i])
+        {
+            return false;
+        }
+    }
+
+    qsort(benchDispatchSample, samples, sizeof(benchDispatchSample[0]), Bench_DispatchCompare);
+    row->msgsPerS = (double)msgs / seconds;
+    row->p50 = (0UL != samples) ? ((double)benchDispatchSample[samples / 2UL] / BENCH_DISPATCH_BATCH) : 0.0;
+    row->p99 = (0UL != samples) ? ((double)benchDispatchSample[(samples * 99UL) / 100UL] / BENCH_DISPATCH_BATCH) : 0.0;
+    row->max = (0UL != samples) ? ((double)benchDispatchSample[samples - 1UL] / BENCH_DISPATCH_BATCH) : 0.0;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: Bench_DispatchPrint
+********************************************************************************
+* Summary:
+* Prints the results as CSV or as a JSON array.
+*
+*******************************************************************************/
+static void Bench_DispatchPrint(cy_stc_bench_dispatch_row_t const *rows, uint32_t count, bool json)
+{
+    uint32_t i;
+
+    if (json)
+    {
+        (void)printf("[\n");
+    }
+    else
+    {
+        (void)printf("dispatcher,mix,msgs_per_s,msg_p50_ns,msg_p99_ns,msg_max_ns\n");
+    }
+
+    for (i = 0UL; i < count; i++)
+    {
+        cy_stc_bench_dispatch_row_t const *row = &rows[i];
+
+        if (json)
+        {
+            (void)printf("  {\"dispatcher\": \"%s\", \"mix\": \"%s\", \"msgs_per_s\": %.0f, \"msg_p50_ns\": %.2f, "
+                         "\"msg_p99_ns\": %.2f, \"msg_max_ns\": %.2f}%s\n",
+                         benchDispatchKindNames[row->kind], benchDispatchMixNames[row->mix], row->msgsPerS,
+                         row->p50, row->p99, row->max,
+                         ((i + 1UL) < count) ? "," : "");
+        }
+        else
+        {
+            (void)printf("%s,%s,%.0f,%.2f,%.2f,%.2f\n",
+                         benchDispatchKindNames[row->kind], benchDispatchMixNames[row->mix], row->msgsPerS,
+                         row->p50, row->p99, row->max);
+        }
+    }
+
+    if (json)
+    {
+        (void)printf("]\n");
+    }
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* Runs every case and prints the results. Fails if a dispatcher lost or
+* misrouted a message.
+*
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+    static cy_stc_bench_dispatch_row_t rows[3UL * 2UL];
+    double seconds = BENCH_DISPATCH_RUN_TIME_S;
+    bool json = false;
+    bool failed = false;
+    uint32_t count = 0UL;
+    uint32_t kind;
+    uint32_t mix;
+    int opt;
+
+    while (-1 != (opt = getopt(argc, argv, "t:f:")))
+    {
+        switch (opt)
+        {
+            case 't': seconds = strtod(optarg, NULL); break;
+            case 'f': json = (0 == strcmp(optarg, "json")); break;
+            default:
+                (void)fprintf(stderr, "usage: %s [-t seconds] [-f csv|json]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if (seconds <= 0.0)
+    {
+        seconds = BENCH_DISPATCH_RUN_TIME_S;
+    }
+
+    for (mix = BENCH_DISPATCH_FIXED; mix <= BENCH_DISPATCH_RANDOM; mix++)
+    {
+        for (kind = BENCH_DISPATCH_SWITCH; kind <= BENCH_DISPATCH_TABLE; kind++)
+        {
+            rows[count].kind = (cy_en_bench_dispatch_kind_t)kind;
+            rows[count].mix = (cy_en_bench_dispatch_mix_t)mix;
+            if (!Bench_DispatchRun(&rows[count], seconds))
+            {
+                (void)fprintf(stderr, "FAIL: %s, %s: a message reached the wrong handler\n",
+                              benchDispatchKindNames[kind], benchDispatchMixNames[mix]);
+                failed = true;
+            }
+            count++;
+        }
+    }
+
+    Bench_DispatchPrint(rows, count, json);
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/* [] END OF FILE */
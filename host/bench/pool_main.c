@@ -0,0 +1,423 @@
+/******************************************************************************
+* File Name:   pool_main.c
+*
+* Description: Compares the block pool of ipc_pool.c against malloc() and
+*              free(). Each thread allocates and frees blocks in pairs, or
+*              in bursts of BENCH_POOL_BURST blocks, for 1 and 4 threads
+*              and blocks of 64 and 1024 bytes. Prints pairs/s and the
+*              p50, p99 and worst time of one pair as CSV or JSON.
+*              Usage: ipc_bench_pool [-t seconds] [-f csv|json]
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "ipc_pool.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BENCH_POOL_RUN_TIME_S           (0.25)  /* Measured time per case */
+#define BENCH_POOL_MAX_THREADS          (4UL)
+#define BENCH_POOL_MAX_BLOCK            (1024UL)
+#define BENCH_POOL_BURST                (32UL)  /* Blocks held at once in a burst */
+#define BENCH_POOL_SAMPLES              (1UL << 20) /* Pair timings kept per thread */
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef enum
+{
+    BENCH_POOL_IPC,                     /* Cy_IPC_Pool_Alloc() and Cy_IPC_Pool_Free() */
+    BENCH_POOL_MALLOC,                  /* malloc() and free() */
+} cy_en_bench_pool_alloc_t;
+
+typedef enum
+{
+    BENCH_POOL_PAIR,                    /* Free each block right after its allocation */
+    BENCH_POOL_BURST_OF,                /* Allocate BENCH_POOL_BURST blocks, then free them */
+} cy_en_bench_pool_pattern_t;
+
+typedef struct
+{
+    cy_en_bench_pool_alloc_t alloc;
+    cy_en_bench_pool_pattern_t pattern;
+    uint32_t threads;
+    uint32_t blockSize;
+    double pairsPerS;
+    uint32_t p50;                       /* ns per pair */
+    uint32_t p99;
+    uint32_t max;
+    uint32_t failed;                    /* Allocations that returned NULL */
+} cy_stc_bench_pool_row_t;
+
+typedef struct
+{
+    cy_stc_bench_pool_row_t const *row;
+    double seconds;
+    uint32_t pairs;
+    uint32_t failed;
+    uint32_t samples;
+    uint32_t *sample;                   /* ns per pair, in pairs per burst for bursts */
+} cy_stc_bench_pool_thread_t;
+
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static cy_stc_ipc_pool_t benchPool;
+CY_ALIGN(IPC_PORT_CACHE_LINE) static uint8_t benchPoolMem[CY_IPC_POOL_STORAGE_SIZE(BENCH_POOL_MAX_BLOCK, BENCH_POOL_MAX_THREADS * BENCH_POOL_BURST)];
+
+static const uint32_t benchPoolThreads[] = { 1UL, BENCH_POOL_MAX_THREADS };
+static const uint32_t benchPoolSizes[] = { 64UL, BENCH_POOL_MAX_BLOCK };
+static char const *const benchPoolAllocNames[] = { "pool", "malloc" };
+static char const *const benchPoolPatternNames[] = { "pair", "burst" };
+
+/* Starts the threads of a case together */
+static pthread_barrier_t benchPoolStart;
+
+
+/*******************************************************************************
+* Function Name: Bench_PoolNowNs
+********************************************************************************
+* Summary:
+* Returns the monotonic time in ns.
+*
+*******************************************************************************/
+static inline uint64_t Bench_PoolNowNs(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+/*******************************************************************************
+* Function Name: Bench_PoolAlloc
+********************************************************************************
+* Summary:
+* Allocates one block and writes its first word, as a sender would.
+*
+*******************************************************************************/
+static inline void *Bench_PoolAlloc(cy_stc_bench_pool_row_t const *row)
+{
+    void *block = (BENCH_POOL_IPC == row->alloc) ? Cy_IPC_Pool_Alloc(&benchPool) : malloc(row->blockSize);
+
+    if (NULL != block)
+    {
+        *(volatile uint32_t *)block = row->blockSize;
+    }
+
+    return block;
+}
+
+/*******************************************************************************
+* Function Name: Bench_PoolFree
+********************************************************************************
+* Summary:
+* Frees one block.
+*
+*******************************************************************************/
+static inline void Bench_PoolFree(cy_stc_bench_pool_row_t const *row, void *block)
+{
+    if (BENCH_POOL_IPC == row->alloc)
+    {
+        (void)Cy_IPC_Pool_Free(&benchPool, block);
+    }
+    else
+    {
+        free(block);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_PoolThread
+********************************************************************************
+* Summary:
+* Allocates and frees for the duration of the case, timing every pair, or
+* every burst with its time spread over the pairs of the burst.
+*
+*******************************************************************************/
+static void *Bench_PoolThread(void *arg)
+{
+    cy_stc_bench_pool_thread_t *thread = (cy_stc_bench_pool_thread_t *)arg;
+    cy_stc_bench_pool_row_t const *row = thread->row;
+    uint32_t burst = (BENCH_POOL_PAIR == row->pattern) ? 1UL : BENCH_POOL_BURST;
+    void *held[BENCH_POOL_BURST];
+    uint64_t end;
+    uint64_t start;
+    uint64_t now;
+    uint32_t i;
+
+    (void)pthread_barrier_wait(&benchPoolStart);
+    now = Bench_PoolNowNs();
+    end = now + (uint64_t)(thread->seconds * 1e9);
+
+    while (now < end)
+    {
+        start = now;
+        for (i = 0UL; i < burst; i++)
+        {
+            held[i] = Bench_PoolAlloc(row);
+            if (NULL == held[i])
+            {
+                thread->failed++;
+            }
+        }
+        for (i = 0UL; i < burst; i++)
+        {
+            if (NULL != held[i])
+            {
+                Bench_PoolFree(row, held[i]);
+            }
+        }
+        now = Bench_PoolNowNs();
+
+        thread->pairs += burst;
+        if (thread->samples < BENCH_POOL_SAMPLES)
+        {
+            thread->sample[thread->samples++] = (uint32_t)((now - start) / burst);
+        }
+    }
+
+    return NULL;
+}
+
+/*******************************************************************************
+* Function Name: Bench_PoolCompare
+********************************************************************************
+* Summary:
+* qsort() comparison of two timings.
+*
+*******************************************************************************/
+static int Bench_PoolCompare(void const *a, void const *b)
+{
+    uint32_t x = *(uint32_t const *)a;
+    uint32_t y = *(uint32_t const *)b;
+
+    return (x > y) - (x < y);
+}
+
+/*******************************************************************************
+* Function Name: Bench_PoolRun
+********************************************************************************
+* Summary:
+* Runs one case and fills its results.
+*
+*******************************************************************************/
+static bool Bench_PoolRun(cy_stc_bench_pool_row_t *row, double seconds)
+{
+    static cy_stc_bench_pool_thread_t thread[BENCH_POOL_MAX_THREADS];
+    static uint32_t all[BENCH_POOL_MAX_THREADS * BENCH_POOL_SAMPLES];
+    pthread_t id[BENCH_POOL_MAX_THREADS];
+    cy_stc_ipc_pool_config_t config =
+    {
+        .storage = benchPoolMem,
+        .blockSize = row->blockSize,
+        .blockCount = row->threads * BENCH_POOL_BURST,
+        .remoteBuf = NULL,
+        .remoteDepth = 0UL,
+    };
+    uint32_t samples = 0UL;
+    uint32_t pairs = 0UL;
+    uint32_t i;
+
+    if ((CY_IPC_POOL_SUCCESS != Cy_IPC_Pool_Init(&benchPool, &config)) ||
+        (0 != pthread_barrier_init(&benchPoolStart, NULL, (unsigned)row->threads)))
+    {
+        return false;
+    }
+
+    for (i = 0UL; i < row->threads; i++)
+    {
+        thread[i] = (cy_stc_bench_pool_thread_t){ .row = row, .seconds = seconds,
+                                                  .sample = &all[i * BENCH_POOL_SAMPLES] };
+        if (0 != pthread_create(&id[i], NULL, Bench_PoolThread, &thread[i]))
+        {
+            return false;
+        }
+    }
+
+    row->failed = 0UL;
+    for (i = 0UL; i < row->threads; i++)
+    {
+        (void)pthread_join(id[i], NULL);
+        (void)memmove(&all[samples], thread[i].sample, thread[i].samples * sizeof(all[0]));
+        samples += thread[i].samples;
+        pairs += thread[i].pairs;
+        row->failed += thread[i].failed;
+    }
+    (void)pthread_barrier_destroy(&benchPoolStart);
+
+    qsort(all, samples, sizeof(all[0]), Bench_PoolCompare);
+    row->pairsPerS = (double)pairs / seconds;
+    row->p50 = (0UL != samples) ? all[samples / 2UL] : 0UL;
+    row->p99 = (0UL != samples) ? all[(samples * 99UL) / 100UL] : 0UL;
+    row->max = (0UL != samples) ? all[samples - 1UL] : 0UL;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: Bench_PoolPrint
+********************************************************************************
+* Summary:
+* Prints the results as CSV or as a JSON array.
+*
+*******************************************************************************/
+static void Bench_PoolPrint(cy_stc_bench_pool_row_t const *rows, uint32_t count, bool json)
+{
+    uint32_t i;
+
+    if (json)
+    {
+        (void)printf("[\n");
+    }
+    else
+    {
+        (void)printf("allocator,pattern,threads,block_size,pairs_per_s,pair_p50_ns,pair_p99_ns,pair_max_ns,failed\n");
+    }
+
+    for (i = 0UL; i < count; i++)
+    {
+        cy_stc_bench_pool_row_t const *row = &rows[i];
+
+        if (json)
+        {
+            (void)printf("  {\"allocator\": \"%s\", \"pattern\": \"%s\", \"threads\": %u, \"block_size\": %u, "
+                         "\"pairs_per_s\": %.0f, \"pair_p50_ns\": %u, \"pair_p99_ns\": %u, \"pair_max_ns\": %u, "
+                         "\"failed\": %u}%s\n",
+                         benchPoolAllocNames[row->alloc], benchPoolPatternNames[row->pattern],
+                         (unsigned int)row->threads, (unsigned int)row->blockSize, row->pairsPerS,
+                         (unsigned int)row->p50, (unsigned int)row->p99, (unsigned int)row->max,
+                         (unsigned int)row->failed, ((i + 1UL) < count) ? "," : "");
+        }
+        else
+        {
+            (void)printf("%s,%s,%u,%u,%.0f,%u,%u,%u,%u\n",
+                         benchPoolAllocNames[row->alloc], benchPoolPatternNames[row->pattern],
+                         (unsigned int)row->threads, (unsigned int)row->blockSize, row->pairsPerS,
+                         (unsigned int)row->p50, (unsigned int)row->p99, (unsigned int)row->max,
+                         (unsigned int)row->failed);
+        }
+    }
+
+    if (json)
+    {
+        (void)printf("]\n");
+    }
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* Runs every case and prints the results. Fails if the pool ran out of
+* blocks, which it is sized never to do.
+*
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+    static cy_stc_bench_pool_row_t rows[2UL * 2UL * 2UL * 2UL];
+    double seconds = BENCH_POOL_RUN_TIME_S;
+    bool json = false;
+    bool failed = false;
+    uint32_t count = 0UL;
+    uint32_t pattern;
+    uint32_t threads;
+    uint32_t size;
+    uint32_t alloc;
+    int opt;
+
+    while (-1 != (opt = getopt(argc, argv, "t:f:")))
+    {
+        switch (opt)
+        {
+            case 't': seconds = strtod(optarg, NULL); break;
+            case 'f': json = (0 == strcmp(optarg, "json")); break;
+            default:
+                (void)fprintf(stderr, "usage: %s [-t seconds] [-f csv|json]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if (seconds <= 0.0)
+    {
+        seconds = BENCH_POOL_RUN_TIME_S;
+    }
+
+    for (pattern = BENCH_POOL_PAIR; pattern <= BENCH_POOL_BURST_OF; pattern++)
+    {
+        for (threads = 0UL; threads < (sizeof(benchPoolThreads) / sizeof(benchPoolThreads[0])); threads++)
+        {
+            for (size = 0UL; size < (sizeof(benchPoolSizes) / sizeof(benchPoolSizes[0])); size++)
+            {
+                for (alloc = BENCH_POOL_IPC; alloc <= BENCH_POOL_MALLOC; alloc++)
+                {
+                    rows[count].alloc = (cy_en_bench_pool_alloc_t)alloc;
+                    rows[count].pattern = (cy_en_bench_pool_pattern_t)pattern;
+                    rows[count].threads = benchPoolThreads[threads];
+                    rows[count].blockSize = benchPoolSizes[size];
+                    if (!Bench_PoolRun(&rows[count], seconds))
+                    {
+                        (void)fprintf(stderr, "case %u could not be set up\n", (unsigned int)count);
+                        return EXIT_FAILURE;
+                    }
+                    if ((BENCH_POOL_IPC == alloc) && (0UL != rows[count].failed))
+                    {
+                        (void)fprintf(stderr, "FAIL: pool, %u threads, %u bytes: %u allocations failed\n",
+                                      (unsigned int)rows[count].threads, (unsigned int)rows[count].blockSize,
+                                      (unsigned int)rows[count].failed);
+                        failed = true;
+                    }
+                    count++;
+                }
+            }
+        }
+    }
+
+    Bench_PoolPrint(rows, count, json);
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/* [] END OF FILE */
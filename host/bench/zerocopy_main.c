@@ -0,0 +1,495 @@
+/******************************************************************************
+* File Name:   zerocopy_main.c
+*
+* Description: Compares zero-copy descriptor handoff through ipc_shbuf.c
+*              against a copied payload, for payloads of 64 B to 64 KB. A
+*              sender and a receiver thread stand in for CM7_0 and CM0+.
+*              With a copy, the payload goes through the ring by value, in
+*              and out. With a descriptor, the sender fills a pool buffer
+*              in place and sends its offset and length, and the receiver
+*              processes the payload in place and hands the buffer back.
+*              Prints msgs/s, MB/s and the time each side spends per
+*              message as CSV or JSON.
+*              Usage: ipc_bench_zerocopy [-t seconds] [-f csv|json]
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "ipc_ring.h"
+#include "ipc_shbuf.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BENCH_ZC_RUN_TIME_S             (0.25)  /* Measured time per case */
+#define BENCH_ZC_MAX_PAYLOAD            (65536UL)
+#define BENCH_ZC_DEPTH                  (8UL)   /* Messages in flight, both transfers */
+#define BENCH_ZC_SLOT_SIZE(payload)     CY_IPC_RING_STORAGE_SIZE(payload, 1UL)
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef enum
+{
+    BENCH_ZC_COPY,                      /* Payload copied into the ring and out of it */
+    BENCH_ZC_DESCRIPTOR,                /* Offset and length of a pool buffer */
+} cy_en_bench_zc_transfer_t;
+
+/* Descriptor message, as cy_stc_ipc_desc_msg_t, and its release */
+typedef struct
+{
+    uint32_t offset;
+    uint32_t length;
+    uint32_t seq;
+} cy_stc_bench_zc_desc_t;
+
+typedef struct
+{
+    cy_en_bench_zc_transfer_t transfer;
+    uint32_t payload;
+    double msgsPerS;
+    double mbPerS;
+    double txNs;                        /* Sender time per message */
+    double rxNs;                        /* Receiver time per message */
+    uint32_t copied;                    /* Payload bytes copied per message */
+    uint32_t errors;                    /* Payloads that did not arrive intact */
+} cy_stc_bench_zc_row_t;
+
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static const uint32_t benchZcPayloads[] = { 64UL, 256UL, 1024UL, 4096UL, 16384UL, BENCH_ZC_MAX_PAYLOAD };
+static char const *const benchZcTransferNames[] = { "copy", "descriptor" };
+
+/* Copy: the ring holds whole payloads */
+static cy_stc_ipc_ring_t benchZcCopyRing;
+CY_ALIGN(IPC_PORT_CACHE_LINE) static uint8_t benchZcCopyBuf[BENCH_ZC_DEPTH * BENCH_ZC_MAX_PAYLOAD];
+
+/* Descriptor: the sender owns the pool, descriptors go out and releases come back */
+static cy_stc_ipc_shbuf_t benchZcPool;
+CY_ALIGN(IPC_PORT_CACHE_LINE) static uint8_t benchZcPoolBuf[BENCH_ZC_DEPTH * BENCH_ZC_MAX_PAYLOAD];
+static cy_stc_ipc_ring_t benchZcDescRing;
+static cy_stc_ipc_ring_t benchZcReleaseRing;
+CY_ALIGN(IPC_PORT_CACHE_LINE) static uint8_t benchZcDescBuf[CY_IPC_RING_STORAGE_SIZE(sizeof(cy_stc_bench_zc_desc_t), BENCH_ZC_DEPTH)];
+CY_ALIGN(IPC_PORT_CACHE_LINE) static uint8_t benchZcReleaseBuf[CY_IPC_RING_STORAGE_SIZE(sizeof(cy_stc_bench_zc_desc_t), BENCH_ZC_DEPTH)];
+
+/* Local frames of the copy: built by the sender, received into by the receiver */
+CY_ALIGN(IPC_PORT_CACHE_LINE) static uint8_t benchZcTxFrame[BENCH_ZC_MAX_PAYLOAD];
+CY_ALIGN(IPC_PORT_CACHE_LINE) static uint8_t benchZcRxFrame[BENCH_ZC_MAX_PAYLOAD];
+
+static cy_stc_bench_zc_row_t *benchZcRow;
+static double benchZcSeconds;
+static volatile uint32_t benchZcSent;
+static volatile bool benchZcDone;
+static uint64_t benchZcTxNs;
+static uint64_t benchZcRxNs;
+static uint32_t benchZcReceived;
+
+
+/*******************************************************************************
+* Function Name: Bench_ZcNowNs
+********************************************************************************
+* Summary:
+* Returns the monotonic time in ns.
+*
+*******************************************************************************/
+static inline uint64_t Bench_ZcNowNs(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+/*******************************************************************************
+* Function Name: Bench_ZcFill
+********************************************************************************
+* Summary:
+* Writes the payload of message n: word i is n + i.
+*
+*******************************************************************************/
+static inline void Bench_ZcFill(uint8_t *payload, uint32_t length, uint32_t n)
+{
+    uint32_t *word = (uint32_t *)payload;
+    uint32_t i;
+
+    for (i = 0UL; i < (length / sizeof(uint32_t)); i++)
+    {
+        word[i] = n + i;
+    }
+}
+
+/*******************************************************************************
+* Function Name: Bench_ZcConsume
+********************************************************************************
+* Summary:
+* Processes a received payload as CM0+ does, by summing it, and checks it
+* against message n.
+*
+*******************************************************************************/
+static inline bool Bench_ZcConsume(uint8_t const *payload, uint32_t length, uint32_t n)
+{
+    uint32_t const *word = (uint32_t const *)payload;
+    uint32_t words = length / sizeof(uint32_t);
+    uint32_t sum = 0UL;
+    uint32_t i;
+
+    for (i = 0UL; i < words; i++)
+    {
+        sum += word[i];
+    }
+
+    /* Sum of n + i over the words, modulo 2^32 */
+    return (sum == ((words * n) + ((words * (words - 1UL)) / 2UL))) && (word[words - 1UL] == (n + words - 1UL));
+}
+
+/*******************************************************************************
+* Function Name: Bench_ZcReclaim
+********************************************************************************
+* Summary:
+* Descriptor sender: returns every released buffer to the pool, as
+* Pipe0_cm7_0_ReleaseCallback. Returns the number of buffers reclaimed.
+*
+*******************************************************************************/
+static uint32_t Bench_ZcReclaim(void)
+{
+    cy_stc_bench_zc_desc_t desc;
+    uint32_t count = 0UL;
+
+    while (CY_IPC_RING_SUCCESS == Cy_IPC_Ring_Pop(&benchZcReleaseRing, &desc))
+    {
+        Cy_IPC_ShBuf_Free(&benchZcPool, desc.offset, desc.length);
+        count++;
+    }
+
+    return count;
+}
+
+/*******************************************************************************
+* Function Name: Bench_ZcSender
+********************************************************************************
+* Summary:
+* Sends for the duration of the case. Only the work on a message is timed:
+* building it and handing it to the ring, and reclaiming released buffers.
+* Waiting for room is not.
+*
+*******************************************************************************/
+static void *Bench_ZcSender(void *arg)
+{
+    uint32_t length = benchZcRow->payload;
+    cy_stc_bench_zc_desc_t desc = { .length = length };
+    uint32_t inFlight = 0UL;
+    uint32_t sent = 0UL;
+    uint64_t work = 0ULL;
+    uint64_t start;
+    uint64_t end;
+    uint64_t now;
+
+    (void)arg;
+    now = Bench_ZcNowNs();
+    end = now + (uint64_t)(benchZcSeconds * 1e9);
+
+    while (now < end)
+    {
+        if (BENCH_ZC_COPY == benchZcRow->transfer)
+        {
+            while (Cy_IPC_Ring_Count(&benchZcCopyRing) >= BENCH_ZC_DEPTH)
+            {
+                (void)sched_yield();
+            }
+
+            start = Bench_ZcNowNs();
+            Bench_ZcFill(benchZcTxFrame, length, sent);
+            (void)Cy_IPC_Ring_Push(&benchZcCopyRing, benchZcTxFrame);
+            now = Bench_ZcNowNs();
+        }
+        else
+        {
+            start = Bench_ZcNowNs();
+            inFlight -= Bench_ZcReclaim();
+            while ((inFlight >= BENCH_ZC_DEPTH) ||
+                   (CY_IPC_SHBUF_SUCCESS != Cy_IPC_ShBuf_Alloc(&benchZcPool, length, &desc.offset)))
+            {
+                work += Bench_ZcNowNs() - start;
+                (void)sched_yield();
+                start = Bench_ZcNowNs();
+                inFlight -= Bench_ZcReclaim();
+            }
+
+            Bench_ZcFill(&benchZcPool.base[desc.offset], length, sent);
+            Cy_IPC_ShBuf_Publish(&benchZcPool, desc.offset, length);
+            desc.seq = sent;
+            (void)Cy_IPC_Ring_Push(&benchZcDescRing, &desc);
+            inFlight++;
+            now = Bench_ZcNowNs();
+        }
+
+        work += now - start;
+        sent++;
+        benchZcSent = sent;
+    }
+
+    benchZcTxNs = work;
+    benchZcDone = true;
+
+    return NULL;
+}
+
+/*******************************************************************************
+* Function Name: Bench_ZcReceiver
+********************************************************************************
+* Summary:
+* Receives until the sender is done and every message has arrived. Only the
+* work on a message is timed: taking it, processing its payload and, for a
+* descriptor, releasing the buffer.
+*
+*******************************************************************************/
+static void *Bench_ZcReceiver(void *arg)
+{
+    uint32_t length = benchZcRow->payload;
+    cy_stc_bench_zc_desc_t const *pDesc;
+    cy_stc_bench_zc_desc_t desc;
+    uint8_t const *payload;
+    uint32_t received = 0UL;
+    uint64_t work = 0ULL;
+    uint64_t start;
+
+    (void)arg;
+    while (!benchZcDone || (received != benchZcSent))
+    {
+        if (0UL == Cy_IPC_Ring_Count((BENCH_ZC_COPY == benchZcRow->transfer) ? &benchZcCopyRing : &benchZcDescRing))
+        {
+            (void)sched_yield();
+            continue;
+        }
+
+        start = Bench_ZcNowNs();
+        if (BENCH_ZC_COPY == benchZcRow->transfer)
+        {
+            (void)Cy_IPC_Ring_Pop(&benchZcCopyRing, benchZcRxFrame);
+            if (!Bench_ZcConsume(benchZcRxFrame, length, received))
+            {
+                benchZcRow->errors++;
+            }
+        }
+        else
+        {
+            pDesc = (cy_stc_bench_zc_desc_t const *)Cy_IPC_Ring_Peek(&benchZcDescRing);
+            desc = *pDesc;
+            (void)Cy_IPC_Ring_Pop(&benchZcDescRing, NULL);
+            payload = (uint8_t const *)Cy_IPC_ShBuf_Access(&benchZcPool, desc.offset, desc.length);
+            if ((NULL == payload) || (desc.seq != received) || !Bench_ZcConsume(payload, length, received))
+            {
+                benchZcRow->errors++;
+            }
+            (void)Cy_IPC_Ring_Push(&benchZcReleaseRing, &desc);
+        }
+        work += Bench_ZcNowNs() - start;
+        received++;
+    }
+
+    benchZcRxNs = work;
+    benchZcReceived = received;
+
+    return NULL;
+}
+
+/*******************************************************************************
+* Function Name: Bench_ZcRun
+********************************************************************************
+* Summary:
+* Runs one case and fills its results.
+*
+*******************************************************************************/
+static bool Bench_ZcRun(cy_stc_bench_zc_row_t *row, double seconds)
+{
+    uint32_t slotSize = BENCH_ZC_SLOT_SIZE(row->payload);
+    pthread_t sender;
+    pthread_t receiver;
+
+    if ((CY_IPC_RING_SUCCESS != Cy_IPC_Ring_Init(&benchZcCopyRing, benchZcCopyBuf, row->payload, BENCH_ZC_DEPTH)) ||
+        (CY_IPC_SHBUF_SUCCESS != Cy_IPC_ShBuf_Init(&benchZcPool, benchZcPoolBuf, BENCH_ZC_DEPTH * slotSize, slotSize)) ||
+        (CY_IPC_RING_SUCCESS != Cy_IPC_Ring_Init(&benchZcDescRing, benchZcDescBuf, sizeof(cy_stc_bench_zc_desc_t),
+                                                 BENCH_ZC_DEPTH)) ||
+        (CY_IPC_RING_SUCCESS != Cy_IPC_Ring_Init(&benchZcReleaseRing, benchZcReleaseBuf, sizeof(cy_stc_bench_zc_desc_t),
+                                                 BENCH_ZC_DEPTH)))
+    {
+        return false;
+    }
+
+    benchZcRow = row;
+    benchZcSeconds = seconds;
+    benchZcSent = 0UL;
+    benchZcDone = false;
+    row->errors = 0UL;
+
+    if ((0 != pthread_create(&receiver, NULL, Bench_ZcReceiver, NULL)) ||
+        (0 != pthread_create(&sender, NULL, Bench_ZcSender, NULL)))
+    {
+        return false;
+    }
+    (void)pthread_join(sender, NULL);
+    (void)pthread_join(receiver, NULL);
+
+    row->msgsPerS = (double)benchZcReceived / seconds;
+    row->mbPerS = (row->msgsPerS * (double)row->payload) / 1e6;
+    row->txNs = (0UL != benchZcReceived) ? ((double)benchZcTxNs / (double)benchZcReceived) : 0.0;
+    row->rxNs = (0UL != benchZcReceived) ? ((double)benchZcRxNs / (double)benchZcReceived) : 0.0;
+    row->copied = (BENCH_ZC_COPY == row->transfer) ? (2UL * row->payload) : 0UL;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: Bench_ZcPrint
+********************************************************************************
+* Summary:
+* Prints the results as CSV or as a JSON array.
+*
+*******************************************************************************/
+static void Bench_ZcPrint(cy_stc_bench_zc_row_t const *rows, uint32_t count, bool json)
+{
+    uint32_t i;
+
+    if (json)
+    {
+        (void)printf("[\n");
+    }
+    else
+    {
+        (void)printf("transfer,payload,msgs_per_s,mb_per_s,tx_ns_per_msg,rx_ns_per_msg,copied_bytes_per_msg,errors\n");
+    }
+
+    for (i = 0UL; i < count; i++)
+    {
+        cy_stc_bench_zc_row_t const *row = &rows[i];
+
+        if (json)
+        {
+            (void)printf("  {\"transfer\": \"%s\", \"payload\": %u, \"msgs_per_s\": %.0f, \"mb_per_s\": %.1f, "
+                         "\"tx_ns_per_msg\": %.1f, \"rx_ns_per_msg\": %.1f, \"copied_bytes_per_msg\": %u, "
+                         "\"errors\": %u}%s\n",
+                         benchZcTransferNames[row->transfer], (unsigned int)row->payload, row->msgsPerS,
+                         row->mbPerS, row->txNs, row->rxNs, (unsigned int)row->copied,
+                         (unsigned int)row->errors, ((i + 1UL) < count) ? "," : "");
+        }
+        else
+        {
+            (void)printf("%s,%u,%.0f,%.1f,%.1f,%.1f,%u,%u\n",
+                         benchZcTransferNames[row->transfer], (unsigned int)row->payload, row->msgsPerS,
+                         row->mbPerS, row->txNs, row->rxNs, (unsigned int)row->copied,
+                         (unsigned int)row->errors);
+        }
+    }
+
+    if (json)
+    {
+        (void)printf("]\n");
+    }
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* Runs every case and prints the results. Fails if a payload did not arrive
+* intact.
+*
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+    static cy_stc_bench_zc_row_t rows[2UL * (sizeof(benchZcPayloads) / sizeof(benchZcPayloads[0]))];
+    double seconds = BENCH_ZC_RUN_TIME_S;
+    bool json = false;
+    bool failed = false;
+    uint32_t count = 0UL;
+    uint32_t transfer;
+    uint32_t size;
+    int opt;
+
+    while (-1 != (opt = getopt(argc, argv, "t:f:")))
+    {
+        switch (opt)
+        {
+            case 't': seconds = strtod(optarg, NULL); break;
+            case 'f': json = (0 == strcmp(optarg, "json")); break;
+            default:
+                (void)fprintf(stderr, "usage: %s [-t seconds] [-f csv|json]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if (seconds <= 0.0)
+    {
+        seconds = BENCH_ZC_RUN_TIME_S;
+    }
+
+    for (size = 0UL; size < (sizeof(benchZcPayloads) / sizeof(benchZcPayloads[0])); size++)
+    {
+        for (transfer = BENCH_ZC_COPY; transfer <= BENCH_ZC_DESCRIPTOR; transfer++)
+        {
+            rows[count].transfer = (cy_en_bench_zc_transfer_t)transfer;
+            rows[count].payload = benchZcPayloads[size];
+            if (!Bench_ZcRun(&rows[count], seconds))
+            {
+                (void)fprintf(stderr, "case %u could not be set up\n", (unsigned int)count);
+                return EXIT_FAILURE;
+            }
+            if (0UL != rows[count].errors)
+            {
+                (void)fprintf(stderr, "FAIL: %s, %u bytes: %u payloads damaged\n", benchZcTransferNames[transfer],
+                              (unsigned int)rows[count].payload, (unsigned int)rows[count].errors);
+                failed = true;
+            }
+            count++;
+        }
+    }
+
+    Bench_ZcPrint(rows, count, json);
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/* [] END OF FILE */
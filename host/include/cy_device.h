@@ -0,0 +1,119 @@
+/******************************************************************************
+* File Name:   cy_device.h
+*
+* Description: Host emulation of the device header: IPC channel and
+*              interrupt counts, CPU interrupt lines and the core-control
+*              functions used by the applications.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CY_DEVICE_H
+#define CY_DEVICE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* IPC hardware
+*******************************************************************************/
+/* Values of the XMC7200 PDL (CPUSS_IPC_IPC_NR, CPUSS_IPC_IPC_IRQ_NR and
+ * cy_ipc_drv.h), so the topology checks fail on the host as on the device */
+#define CY_IPC_CHANNELS                 (8UL)   /* IPC structures (channels) */
+#define CY_IPC_INTERRUPTS               (8UL)   /* IPC interrupt structures */
+
+/* Channels 0 .. 3 are the system calls of CM0+, CM7_0, CM7_1 and the DAP,
+ * channel 4 the semaphores. Interrupt structure 0 is the system call one. */
+#define CY_IPC_CHAN_USER                (5UL)   /* First channel free for the application */
+#define CY_IPC_INTR_USER                (1UL)   /* First interrupt structure free for the application */
+
+
+/*******************************************************************************
+* Interrupts
+*******************************************************************************/
+/* CPU interrupt lines. System interrupts are routed to them by Cy_SysInt_Init(). */
+typedef enum
+{
+    NvicMux0_IRQn = 0,
+    NvicMux1_IRQn = 1,
+    NvicMux2_IRQn = 2,
+    NvicMux3_IRQn = 3,
+    NvicMux4_IRQn = 4,
+    NvicMux5_IRQn = 5,
+    NvicMux6_IRQn = 6,
+    NvicMux7_IRQn = 7,
+} IRQn_Type;
+
+/* System interrupt sources */
+typedef enum
+{
+    cpuss_interrupts_ipc_0_IRQn = 0,    /* IPC interrupt structure 0, up to CY_IPC_INTERRUPTS - 1 */
+    cy_host_systick_IRQn = 31,          /* Core-local SysTick of the emulator */
+} cy_en_intr_t;
+
+typedef void (*cy_israddress)(void);
+
+void __enable_irq(void);
+void __disable_irq(void);
+void __WFI(void);
+
+
+/*******************************************************************************
+* Cores
+*******************************************************************************/
+#define CORE_CM7_0                      (1UL)
+#define CORE_CM7_1                      (2UL)
+
+/* Images are linked together on the host, the start address is not used */
+#define CY_CORTEX_M7_0_APPL_ADDR        (0UL)
+#define CY_CORTEX_M7_1_APPL_ADDR        (0UL)
+
+extern uint32_t SystemCoreClock;
+
+void Cy_SysEnableCM7(uint32_t core, uint32_t vectorTableOffset);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CY_DEVICE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,119 @@
+/******************************************************************************
+* File Name:   cy_host.h
+*
+* Description: Control interface of the host emulator. Each core image
+*              runs on its own thread; interrupts are delivered to that
+*              thread as a signal, so they preempt the core like on the
+*              device.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CY_HOST_H
+#define CY_HOST_H
+
+#include "cy_pdl.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+#define CY_HOST_GPIO_COUNT              (8UL)   /* Pins recorded by the emulator */
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef enum
+{
+    CY_HOST_CORE_CM0P,                  /* Boots first, like on the device */
+    CY_HOST_CORE_CM7_0 = CORE_CM7_0,
+    CY_HOST_CORE_CM7_1 = CORE_CM7_1,
+    CY_HOST_CORE_COUNT,
+} cy_en_host_core_t;
+
+/* main() of a core image, renamed at compile time */
+typedef int (*cy_host_entry_t)(void);
+
+typedef struct
+{
+    uint32_t interrupts;                /* Interrupt handlers run */
+    uint32_t sleeps;                    /* WFI calls that waited */
+    uint64_t cpuNs;                     /* CPU time of the core thread, 0 before it starts */
+} cy_stc_host_core_stats_t;
+
+typedef struct
+{
+    uint32_t sends;                     /* Messages sent */
+    uint32_t busy;                      /* Acquire attempts that found the lock held */
+    uint32_t releases;                  /* Lock releases */
+} cy_stc_host_chan_stats_t;
+
+
+/* Data cache maintenance of a CM7, counted by the stub of ipc_port.h */
+typedef struct
+{
+    uint32_t cleans;                    /* Clean operations */
+    uint32_t cleanLines;                /* Lines written back */
+    uint32_t invalidates;               /* Invalidate operations */
+    uint32_t invalidateLines;           /* Lines discarded */
+    uint32_t uncachedLines;             /* Lines maintained in the region the core mapped non-cacheable */
+    uintptr_t lastStart;                /* Range of the last operation, widened to whole lines */
+    uint32_t lastSize;
+} cy_stc_host_dcache_stats_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void Cy_Host_Init(cy_host_entry_t const entry[CY_HOST_CORE_COUNT]);
+void Cy_Host_StartCore(cy_en_host_core_t core);
+void Cy_Host_RaiseIrq(uint32_t intrSrc);
+void Cy_Host_GetCoreStats(cy_en_host_core_t core, cy_stc_host_core_stats_t *stats);
+void Cy_Host_GetChannelStats(uint32_t channel, cy_stc_host_chan_stats_t *stats);
+void Cy_Host_GetDCacheStats(cy_en_host_core_t core, cy_stc_host_dcache_stats_t *stats);
+bool Cy_Host_GetGpio(uint32_t pin, uint32_t *writes);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CY_HOST_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,129 @@
+/******************************************************************************
+* File Name:   cy_ipc_drv.h
+*
+* Description: Host emulation of the IPC driver. Each IPC structure is a
+*              lock with a data register; each interrupt structure holds
+*              the notify and release events of all channels and raises
+*              its system interrupt on the core it is routed to.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CY_IPC_DRV_H
+#define CY_IPC_DRV_H
+
+#include <stdatomic.h>
+#include "cy_syslib.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+#define CY_IPC_NO_NOTIFICATION          (0UL)
+
+/* Layout of the interrupt registers */
+#define IPC_INTR_STRUCT_INTR_RELEASE_Pos    (0UL)
+#define IPC_INTR_STRUCT_INTR_RELEASE_Msk    (0x0000FFFFUL)
+#define IPC_INTR_STRUCT_INTR_NOTIFY_Pos     (16UL)
+#define IPC_INTR_STRUCT_INTR_NOTIFY_Msk     (0xFFFF0000UL)
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef enum
+{
+    CY_IPC_DRV_SUCCESS = 0x00UL,        /* Lock acquired or released */
+    CY_IPC_DRV_ERROR   = 0x01UL,        /* Lock held by someone else, or not held */
+} cy_en_ipc_drv_status_t;
+
+/* IPC structure (channel) */
+typedef struct
+{
+    atomic_uint_least32_t acquire;      /* 1 while the lock is held */
+    atomic_uintptr_t data;              /* Message pointer */
+    atomic_uint_least32_t sends;        /* Messages sent */
+    atomic_uint_least32_t busy;         /* Acquire attempts that found the lock held */
+    atomic_uint_least32_t releases;     /* Lock releases */
+} IPC_STRUCT_Type;
+
+/* IPC interrupt structure */
+typedef struct
+{
+    atomic_uint_least32_t intr;         /* [31:16] notify, [15:0] release events per channel */
+    atomic_uint_least32_t intrMask;     /* Same layout, events that raise the interrupt */
+} IPC_INTR_STRUCT_Type;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+IPC_STRUCT_Type *Cy_IPC_Drv_GetIpcBaseAddress(uint32_t ipcIndex);
+IPC_INTR_STRUCT_Type *Cy_IPC_Drv_GetIntrBaseAddr(uint32_t ipcIntrIndex);
+
+cy_en_ipc_drv_status_t Cy_IPC_Drv_LockAcquire(IPC_STRUCT_Type *base);
+cy_en_ipc_drv_status_t Cy_IPC_Drv_LockRelease(IPC_STRUCT_Type *base, uint32_t releaseEventIntr);
+bool Cy_IPC_Drv_IsLockAcquired(IPC_STRUCT_Type const *base);
+void Cy_IPC_Drv_AcquireNotify(IPC_STRUCT_Type *base, uint32_t notifyEventIntr);
+
+cy_en_ipc_drv_status_t Cy_IPC_Drv_SendMsgPtr(IPC_STRUCT_Type *base, uint32_t notifyEventIntr, void const *msgPtr);
+cy_en_ipc_drv_status_t Cy_IPC_Drv_ReadMsgPtr(IPC_STRUCT_Type const *base, void **msgPtr);
+
+void Cy_IPC_Drv_SetInterruptMask(IPC_INTR_STRUCT_Type *base, uint32_t ipcReleaseMask, uint32_t ipcNotifyMask);
+uint32_t Cy_IPC_Drv_GetInterruptStatusMasked(IPC_INTR_STRUCT_Type const *base);
+void Cy_IPC_Drv_ClearInterrupt(IPC_INTR_STRUCT_Type *base, uint32_t ipcReleaseMask, uint32_t ipcNotifyMask);
+
+/* Splits a masked interrupt status into channel masks */
+static inline uint32_t Cy_IPC_Drv_ExtractAcquireMask(uint32_t intMask)
+{
+    return _FLD2VAL(IPC_INTR_STRUCT_INTR_NOTIFY, intMask);
+}
+
+static inline uint32_t Cy_IPC_Drv_ExtractReleaseMask(uint32_t intMask)
+{
+    return _FLD2VAL(IPC_INTR_STRUCT_INTR_RELEASE, intMask);
+}
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CY_IPC_DRV_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,152 @@
+/******************************************************************************
+* File Name:   cy_ipc_pipe.h
+*
+* Description: Host emulation of the PDL IPC pipe. Same types and
+*              functions as the PDL, so the applications build unchanged.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CY_IPC_PIPE_H
+#define CY_IPC_PIPE_H
+
+#include "cy_ipc_drv.h"
+#include "cy_sysint.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+/* First word of every message */
+#define CY_IPC_PIPE_MSG_CLIENT_Msk      (0x000000FFUL)  /* Client ID */
+#define CY_IPC_PIPE_MSG_CLIENT_Pos      (0UL)
+#define CY_IPC_PIPE_MSG_USR_Msk         (0x0000FF00UL)  /* User data */
+#define CY_IPC_PIPE_MSG_USR_Pos         (8UL)
+#define CY_IPC_PIPE_MSG_RELEASE_Msk     (0xFFFF0000UL)  /* Release interrupt mask, set by the sender */
+#define CY_IPC_PIPE_MSG_RELEASE_Pos     (16UL)
+
+/* Endpoint configuration word */
+#define CY_IPC_PIPE_CFG_IMASK_Msk       (0xFFFF0000UL)  /* Channels the endpoint takes events from */
+#define CY_IPC_PIPE_CFG_IMASK_Pos       (16UL)
+#define CY_IPC_PIPE_CFG_INTR_Msk        (0x0000FF00UL)  /* Interrupt structure */
+#define CY_IPC_PIPE_CFG_INTR_Pos        (8UL)
+#define CY_IPC_PIPE_CFG_CHAN_Msk        (0x000000FFUL)  /* Channel */
+#define CY_IPC_PIPE_CFG_CHAN_Pos        (0UL)
+
+#define CY_IPC_PIPE_ENDPOINT_BUSY       (1UL)
+#define CY_IPC_PIPE_ENDPOINT_NOTBUSY    (0UL)
+
+#define CY_IPC_PIPE_RTN                 (0x0200UL)
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef enum
+{
+    CY_IPC_PIPE_SUCCESS             = 0x00UL,
+    CY_IPC_PIPE_ERROR_NO_IPC        = (CY_IPC_PIPE_RTN | 0x01UL),
+    CY_IPC_PIPE_ERROR_SEND_BUSY     = (CY_IPC_PIPE_RTN | 0x02UL),
+    CY_IPC_PIPE_ERROR_NO_CALLBACK   = (CY_IPC_PIPE_RTN | 0x03UL),
+    CY_IPC_PIPE_ERROR_DIR_ERROR     = (CY_IPC_PIPE_RTN | 0x04UL),
+    CY_IPC_PIPE_ERROR_BAD_HANDLE    = (CY_IPC_PIPE_RTN | 0x05UL),
+} cy_en_ipc_pipe_status_t;
+
+typedef void (*cy_ipc_pipe_callback_ptr_t)(uint32_t *msgPtr);
+typedef void (*cy_ipc_pipe_relcallback_ptr_t)(void);
+typedef void (*cy_ipc_pipe_isr_ptr_t)(void);
+typedef cy_ipc_pipe_callback_ptr_t *cy_ipc_pipe_callback_array_ptr_t;
+
+typedef struct
+{
+    uint32_t ipcNotifierNumber;         /* Interrupt structure of the endpoint */
+    uint32_t ipcNotifierPriority;       /* Priority of the CPU line */
+    IRQn_Type ipcNotifierMuxNumber;     /* CPU line */
+    uint32_t epAddress;                 /* Index in the endpoint array */
+    uint32_t epConfig;                  /* Channel, interrupt and interrupt mask */
+} cy_stc_ipc_pipe_ep_config_t;
+
+typedef struct
+{
+    cy_stc_ipc_pipe_ep_config_t ep0ConfigData;  /* Receiver endpoint of this core */
+    cy_stc_ipc_pipe_ep_config_t ep1ConfigData;  /* Remote endpoint */
+    uint32_t endpointClientsCount;
+    cy_ipc_pipe_callback_array_ptr_t endpointsCallbacksArray;
+    cy_ipc_pipe_isr_ptr_t userPipeIsrHandler;
+} cy_stc_ipc_pipe_config_t;
+
+/* Endpoint state, one array per core */
+typedef struct
+{
+    uint32_t ipcChan;
+    uint32_t intrChan;
+    uint32_t pipeIntMask;
+    IRQn_Type pipeIntrSrc;
+    IPC_STRUCT_Type *ipcPtr;
+    IPC_INTR_STRUCT_Type *ipcIntrPtr;
+    volatile uint32_t busy;
+    uint32_t clientCount;
+    cy_ipc_pipe_callback_array_ptr_t callbackArray;
+    cy_ipc_pipe_relcallback_ptr_t releaseCallbackPtr;
+    cy_ipc_pipe_relcallback_ptr_t defaultReleaseCallbackPtr;
+} cy_stc_ipc_pipe_ep_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void Cy_IPC_Pipe_Config(cy_stc_ipc_pipe_ep_t *theEpArray);
+void Cy_IPC_Pipe_Init(cy_stc_ipc_pipe_config_t const *config);
+void Cy_IPC_Pipe_EndpointInit(uint32_t epAddr, cy_ipc_pipe_callback_array_ptr_t cbArray, uint32_t cbCnt,
+                              uint32_t epConfig, cy_stc_sysint_t const *epInterrupt);
+cy_en_ipc_pipe_status_t Cy_IPC_Pipe_SendMessage(uint32_t toAddr, uint32_t fromAddr, void *msgPtr,
+                                                cy_ipc_pipe_relcallback_ptr_t callBackPtr);
+cy_en_ipc_pipe_status_t Cy_IPC_Pipe_RegisterCallback(uint32_t epAddr, cy_ipc_pipe_callback_ptr_t callBackPtr,
+                                                     uint32_t clientId);
+void Cy_IPC_Pipe_RegisterCallbackRel(uint32_t epAddr, cy_ipc_pipe_relcallback_ptr_t callBackPtr);
+void Cy_IPC_Pipe_ExecuteCallback(uint32_t epAddr);
+bool Cy_IPC_Pipe_EndpointIsBusy(uint32_t epAddr);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CY_IPC_PIPE_H */
+
+/* [] END OF FILE */
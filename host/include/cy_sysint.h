@@ -0,0 +1,93 @@
+/******************************************************************************
+* File Name:   cy_sysint.h
+*
+* Description: Host emulation of the PDL interrupt routing and SysTick.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CY_SYSINT_H
+#define CY_SYSINT_H
+
+#include "cy_device.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Interrupt routing
+*******************************************************************************/
+#define CY_SYSINT_INTRSRC_MUXIRQ_SHIFT  (16UL)  /* CPU line in bits [31:16] of intrSrc */
+
+typedef enum
+{
+    CY_SYSINT_SUCCESS,
+    CY_SYSINT_BAD_PARAM,
+} cy_en_sysint_status_t;
+
+typedef struct
+{
+    uint32_t intrSrc;       /* Bits [31:16] CPU line, bits [15:0] system interrupt */
+    uint32_t intrPriority;  /* 0 highest, a handler is preempted by a higher priority */
+} cy_stc_sysint_t;
+
+cy_en_sysint_status_t Cy_SysInt_Init(cy_stc_sysint_t const *config, cy_israddress userIsr);
+void NVIC_EnableIRQ(IRQn_Type irqn);
+void NVIC_DisableIRQ(IRQn_Type irqn);
+
+
+/*******************************************************************************
+* SysTick
+*******************************************************************************/
+#define CY_SYS_SYST_NUM_OF_CALLBACKS    (5UL)
+
+typedef enum
+{
+    CY_SYSTICK_CLOCK_SOURCE_CLK_LF,     /* 32.768 kHz */
+    CY_SYSTICK_CLOCK_SOURCE_CLK_CPU,    /* SystemCoreClock */
+} cy_en_systick_clock_source_t;
+
+void Cy_SysTick_Init(cy_en_systick_clock_source_t clockSource, uint32_t interval);
+cy_israddress Cy_SysTick_SetCallback(uint32_t number, cy_israddress function);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CY_SYSINT_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,72 @@
+/******************************************************************************
+* File Name:   cy_syspm.h
+*
+* Description: Host emulation of the PDL power modes. Deep sleep of a CPU
+*              is a plain wait for interrupt on the host.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CY_SYSPM_H
+#define CY_SYSPM_H
+
+#include "cy_device.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+typedef enum
+{
+    CY_SYSPM_WAIT_FOR_INTERRUPT,    /* Wait for an interrupt */
+    CY_SYSPM_WAIT_FOR_EVENT         /* Wait for an event, treated as an interrupt on the host */
+} cy_en_syspm_waitfor_t;
+
+typedef enum
+{
+    CY_SYSPM_SUCCESS = 0x0U,        /* The CPU woke from the low power mode */
+    CY_SYSPM_FAIL = 0x1U            /* The low power mode was not entered */
+} cy_en_syspm_status_t;
+
+cy_en_syspm_status_t Cy_SysPm_CpuEnterDeepSleep(cy_en_syspm_waitfor_t waitFor);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CY_SYSPM_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,945 @@
+/******************************************************************************
+* File Name:   cy_host.c
+*
+* Description: Core threads, interrupt delivery, SysTick and the system
+*              library of the host emulator. Each core image runs on its
+*              own thread. An interrupt sets a pending bit on the core and
+*              signals its thread; the handler runs in the signal context
+*              unless the core has interrupts masked, in which case it
+*              runs when they are unmasked again. A handler is preempted by
+*              one of a higher priority, like on the NVIC.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "cy_host.h"
+#include "cy_ipc_drv.h"
+#include "cybsp.h"
+#include "cyhal.h"
+#include "ipc_port.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define CY_HOST_IRQ_SIGNAL              (SIGUSR1)       /* Delivers interrupts to a core thread */
+#define CY_HOST_IRQ_COUNT               (32UL)          /* System interrupts, bit index in the pending mask */
+#define CY_HOST_IRQ_SYSTICK             ((uint32_t)cy_host_systick_IRQn)
+#define CY_HOST_NO_CORE                 (UINT32_MAX)
+#define CY_HOST_PRIO_SYSTICK            (7UL)           /* Lowest of the 3 priority bits, as set by SysTick_Config() */
+#define CY_HOST_PRIO_THREAD             (256)           /* Below every interrupt priority */
+
+#define CY_HOST_NS_PER_S                (1000000000ULL)
+#define CY_HOST_NS_PER_MS               (1000000ULL)
+#define CY_HOST_CLK_LF_HZ               (32768ULL)
+#define CY_HOST_TICKER_MAX_NS           (CY_HOST_NS_PER_MS) /* Ticker polls for new SysTicks this often */
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef struct
+{
+    cy_host_entry_t entry;                          /* main() of the image */
+    atomic_bool started;
+    pthread_t thread;
+    cy_israddress vector[CY_HOST_IRQ_COUNT];        /* Handlers of the routed system interrupts */
+    IRQn_Type line[CY_HOST_IRQ_COUNT];              /* CPU line of each system interrupt */
+    uint8_t priority[CY_HOST_IRQ_COUNT];            /* Lower value preempts higher */
+    atomic_uint_least32_t pending;                  /* Raised, not yet handled */
+    volatile uint32_t enabled;                      /* Unmasked in the NVIC, own thread only */
+    volatile sig_atomic_t primask;                  /* Interrupts masked, own thread only */
+    volatile sig_atomic_t runPriority;              /* Priority of the running handler, CY_HOST_PRIO_THREAD if none */
+    cy_israddress sysTickCallbacks[CY_SYS_SYST_NUM_OF_CALLBACKS];
+    atomic_uint_least64_t sysTickPeriod;            /* ns, 0 while SysTick is off */
+    uint64_t sysTickDue;                            /* Ticker thread only */
+    atomic_uint_least32_t interrupts;
+    atomic_uint_least32_t sleeps;
+    clockid_t cpuClock;                             /* CPU time of the thread */
+    atomic_bool cpuClockValid;                      /* Set once the thread has started */
+    atomic_uint_least32_t cleans;                   /* D-cache stub, see Cy_Host_GetDCacheStats() */
+    atomic_uint_least32_t cleanLines;
+    atomic_uint_least32_t invalidates;
+    atomic_uint_least32_t invalidateLines;
+    atomic_uint_least32_t uncachedLines;
+    atomic_uintptr_t lastStart;
+    atomic_uint_least32_t lastSize;
+    uintptr_t uncachedBase;                         /* Region mapped non-cacheable, own thread only */
+    uint32_t uncachedSize;
+} cy_stc_host_core_t;
+
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+uint32_t SystemCoreClock = 100000000UL;             /* Nominal, scales the SysTick interval */
+
+static cy_stc_host_core_t cy_host_cores[CY_HOST_CORE_COUNT];
+static atomic_uint_least32_t cy_host_route[CY_HOST_IRQ_COUNT];  /* Core of each system interrupt */
+static _Thread_local cy_stc_host_core_t *cy_host_self;          /* Core of the calling thread */
+static atomic_uint_least32_t cy_host_gpio[CY_HOST_GPIO_COUNT];
+static atomic_uint_least32_t cy_host_gpioWrites[CY_HOST_GPIO_COUNT];
+
+
+/*******************************************************************************
+* Function Name: cy_host_now
+********************************************************************************
+* Summary:
+* Returns the monotonic time in ns.
+*
+*******************************************************************************/
+static uint64_t cy_host_now(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * CY_HOST_NS_PER_S) + (uint64_t)ts.tv_nsec;
+}
+
+/*******************************************************************************
+* Function Name: cy_host_sleep_until
+********************************************************************************
+* Summary:
+* Sleeps until a monotonic time in ns. Interrupts of the calling core still
+* run while it sleeps.
+*
+*******************************************************************************/
+static void cy_host_sleep_until(uint64_t deadline)
+{
+    struct timespec ts;
+
+    ts.tv_sec = (time_t)(deadline / CY_HOST_NS_PER_S);
+    ts.tv_nsec = (long)(deadline % CY_HOST_NS_PER_S);
+    while (EINTR == clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL))
+    {
+    }
+}
+
+/*******************************************************************************
+* Function Name: cy_host_pend
+********************************************************************************
+* Summary:
+* Marks an interrupt pending on a core and signals its thread. The signal is
+* skipped if the interrupt was already pending; it is handled by the pass
+* that clears the bit.
+*
+*******************************************************************************/
+static void cy_host_pend(cy_stc_host_core_t *core, uint32_t irq)
+{
+    uint32_t bit = 1UL << irq;
+
+    if (0UL == (atomic_fetch_or(&core->pending, bit) & bit))
+    {
+        (void)pthread_kill(core->thread, CY_HOST_IRQ_SIGNAL);
+    }
+}
+
+/*******************************************************************************
+* Function Name: cy_host_next
+********************************************************************************
+* Summary:
+* Returns the pending, enabled interrupt of the calling core that preempts
+* the running context, or CY_HOST_IRQ_COUNT if there is none. Of equal
+* priorities the lower interrupt number wins, like on the NVIC.
+*
+*******************************************************************************/
+static uint32_t cy_host_next(cy_stc_host_core_t *core)
+{
+    uint32_t lines = (uint32_t)atomic_load(&core->pending) & core->enabled;
+    uint32_t next = CY_HOST_IRQ_COUNT;
+    int best = core->runPriority;
+    uint32_t irq;
+
+    if (0 != core->primask)
+    {
+        return CY_HOST_IRQ_COUNT;
+    }
+
+    for (irq = 0UL; (0UL != lines) && (irq < CY_HOST_IRQ_COUNT); irq++)
+    {
+        if ((0UL != (lines & (1UL << irq))) && ((int)core->priority[irq] < best))
+        {
+            best = (int)core->priority[irq];
+            next = irq;
+        }
+        lines &= ~(1UL << irq);
+    }
+
+    return next;
+}
+
+/*******************************************************************************
+* Function Name: cy_host_dispatch
+********************************************************************************
+* Summary:
+* Runs the handlers of the pending, enabled interrupts of the calling core
+* that preempt the running context, highest priority first. The priority is
+* raised before the pending bit is claimed, so a signal taken in between
+* only lets a higher priority in. A handler nests through the signal of an
+* interrupt of a higher priority raised while it runs.
+*
+*******************************************************************************/
+static void cy_host_dispatch(cy_stc_host_core_t *core)
+{
+    sig_atomic_t saved = core->runPriority;
+    uint32_t irq;
+    uint32_t bit;
+
+    while (CY_HOST_IRQ_COUNT != (irq = cy_host_next(core)))
+    {
+        bit = 1UL << irq;
+
+        core->runPriority = (sig_atomic_t)core->priority[irq];
+        atomic_signal_fence(memory_order_seq_cst);
+
+        /* A nested handler may have taken it since */
+        if (0UL != ((uint32_t)atomic_fetch_and(&core->pending, ~bit) & bit))
+        {
+            if (NULL != core->vector[irq])
+            {
+                (void)atomic_fetch_add_explicit(&core->interrupts, 1UL, memory_order_relaxed);
+                core->vector[irq]();
+            }
+        }
+
+        atomic_signal_fence(memory_order_seq_cst);
+        core->runPriority = saved;
+        atomic_signal_fence(memory_order_seq_cst);
+    }
+}
+
+/*******************************************************************************
+* Function Name: cy_host_unmasked
+********************************************************************************
+* Summary:
+* Runs what became pending while the calling core had interrupts masked, or
+* while a handler of the same or a higher priority was running.
+*
+*******************************************************************************/
+static void cy_host_unmasked(cy_stc_host_core_t *core)
+{
+    if (CY_HOST_IRQ_COUNT != cy_host_next(core))
+    {
+        cy_host_dispatch(core);
+    }
+}
+
+/*******************************************************************************
+* Function Name: cy_host_signal_handler
+********************************************************************************
+* Summary:
+* Entry of an interrupt on a core thread. Installed with SA_NODEFER, so it
+* runs nested within a handler of a lower priority.
+*
+*******************************************************************************/
+static void cy_host_signal_handler(int sig)
+{
+    cy_stc_host_core_t *core = cy_host_self;
+    int savedErrno = errno;
+
+    (void)sig;
+
+    if (NULL != core)
+    {
+        cy_host_unmasked(core);
+    }
+
+    errno = savedErrno;
+}
+
+/*******************************************************************************
+* Function Name: cy_host_systick_isr
+********************************************************************************
+* Summary:
+* SysTick handler, runs the callbacks of the calling core.
+*
+*******************************************************************************/
+static void cy_host_systick_isr(void)
+{
+    uint32_t i;
+
+    for (i = 0UL; i < CY_SYS_SYST_NUM_OF_CALLBACKS; i++)
+    {
+        if (NULL != cy_host_self->sysTickCallbacks[i])
+        {
+            cy_host_self->sysTickCallbacks[i]();
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: cy_host_ticker_thread
+********************************************************************************
+* Summary:
+* Raises the SysTick of every core that started it. Ticks missed while the
+* host was busy are dropped, like on the device.
+*
+*******************************************************************************/
+static void *cy_host_ticker_thread(void *arg)
+{
+    uint64_t now;
+    uint64_t next;
+    uint64_t period;
+    uint32_t i;
+
+    (void)arg;
+
+    for (;;)
+    {
+        now = cy_host_now();
+        next = now + CY_HOST_TICKER_MAX_NS;
+
+        for (i = 0UL; i < CY_HOST_CORE_COUNT; i++)
+        {
+            cy_stc_host_core_t *core = &cy_host_cores[i];
+
+            period = atomic_load(&core->sysTickPeriod);
+            if (0ULL == period)
+            {
+                core->sysTickDue = 0ULL;
+                continue;
+            }
+
+            if (0ULL == core->sysTickDue)
+            {
+                core->sysTickDue = now + period;
+            }
+            else if (now >= core->sysTickDue)
+            {
+                cy_host_pend(core, CY_HOST_IRQ_SYSTICK);
+                core->sysTickDue += period;
+                if (core->sysTickDue <= now)
+                {
+                    core->sysTickDue = now + period;
+                }
+            }
+            else
+            {
+                /* Not due */
+            }
+
+            if (core->sysTickDue < next)
+            {
+                next = core->sysTickDue;
+            }
+        }
+
+        cy_host_sleep_until(next);
+    }
+
+    return NULL;
+}
+
+/*******************************************************************************
+* Function Name: cy_host_core_thread
+********************************************************************************
+* Summary:
+* Runs the image of a core. Returning from main() halts the core; its
+* interrupts keep running.
+*
+*******************************************************************************/
+static void *cy_host_core_thread(void *arg)
+{
+    cy_stc_host_core_t *core = (cy_stc_host_core_t *)arg;
+    sigset_t irqSet;
+
+    core->thread = pthread_self();
+    cy_host_self = core;
+    if (0 == pthread_getcpuclockid(core->thread, &core->cpuClock))
+    {
+        atomic_store(&core->cpuClockValid, true);
+    }
+
+    (void)sigemptyset(&irqSet);
+    (void)sigaddset(&irqSet, CY_HOST_IRQ_SIGNAL);
+    (void)pthread_sigmask(SIG_UNBLOCK, &irqSet, NULL);
+
+    (void)core->entry();
+
+    for (;;)
+    {
+        __WFI();
+    }
+
+    return NULL;
+}
+
+/*******************************************************************************
+* Function Name: Cy_Host_Init
+********************************************************************************
+* Summary:
+* Resets all cores and starts the SysTick timer. No core runs until it is
+* started.
+*
+* Parameters:
+*  entry: main() of each core image.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_Host_Init(cy_host_entry_t const entry[CY_HOST_CORE_COUNT])
+{
+    struct sigaction action;
+    sigset_t irqSet;
+    pthread_t ticker;
+    uint32_t i;
+
+    for (i = 0UL; i < CY_HOST_CORE_COUNT; i++)
+    {
+        cy_host_cores[i].entry = entry[i];
+        atomic_init(&cy_host_cores[i].started, false);
+        atomic_init(&cy_host_cores[i].pending, 0UL);
+        cy_host_cores[i].runPriority = CY_HOST_PRIO_THREAD;
+        atomic_init(&cy_host_cores[i].sysTickPeriod, 0ULL);
+        atomic_init(&cy_host_cores[i].interrupts, 0UL);
+        atomic_init(&cy_host_cores[i].sleeps, 0UL);
+        atomic_init(&cy_host_cores[i].cpuClockValid, false);
+    }
+    for (i = 0UL; i < CY_HOST_IRQ_COUNT; i++)
+    {
+        atomic_init(&cy_host_route[i], CY_HOST_NO_CORE);
+    }
+
+    (void)memset(&action, 0, sizeof(action));
+    action.sa_handler = &cy_host_signal_handler;
+    action.sa_flags = SA_RESTART | SA_NODEFER;
+    (void)sigemptyset(&action.sa_mask);
+    if (0 != sigaction(CY_HOST_IRQ_SIGNAL, &action, NULL))
+    {
+        Cy_SysLib_AssertFailed(__FILE__, (uint32_t)__LINE__);
+    }
+
+    /* Only core threads take interrupts; threads created from here inherit the mask */
+    (void)sigemptyset(&irqSet);
+    (void)sigaddset(&irqSet, CY_HOST_IRQ_SIGNAL);
+    (void)pthread_sigmask(SIG_BLOCK, &irqSet, NULL);
+
+    if (0 != pthread_create(&ticker, NULL, &cy_host_ticker_thread, NULL))
+    {
+        Cy_SysLib_AssertFailed(__FILE__, (uint32_t)__LINE__);
+    }
+    (void)pthread_detach(ticker);
+}
+
+/*******************************************************************************
+* Function Name: Cy_Host_StartCore
+********************************************************************************
+* Summary:
+* Starts a core image on its own thread. Starting a core twice, or one
+* without an image, does nothing.
+*
+* Parameters:
+*  core: Core to start.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_Host_StartCore(cy_en_host_core_t core)
+{
+    pthread_t thread;
+
+    if ((core >= CY_HOST_CORE_COUNT) || (NULL == cy_host_cores[core].entry) ||
+        atomic_exchange(&cy_host_cores[core].started, true))
+    {
+        return;
+    }
+
+    if (0 != pthread_create(&thread, NULL, &cy_host_core_thread, &cy_host_cores[core]))
+    {
+        Cy_SysLib_AssertFailed(__FILE__, (uint32_t)__LINE__);
+    }
+    (void)pthread_detach(thread);
+}
+
+/*******************************************************************************
+* Function Name: Cy_Host_RaiseIrq
+********************************************************************************
+* Summary:
+* Raises a system interrupt on the core it is routed to. Can be called from
+* any thread; an interrupt that is not routed is dropped.
+*
+* Parameters:
+*  intrSrc: System interrupt.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_Host_RaiseIrq(uint32_t intrSrc)
+{
+    uint32_t core;
+
+    if (intrSrc >= CY_HOST_IRQ_COUNT)
+    {
+        return;
+    }
+
+    core = (uint32_t)atomic_load(&cy_host_route[intrSrc]);
+    if (CY_HOST_NO_CORE != core)
+    {
+        cy_host_pend(&cy_host_cores[core], intrSrc);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Cy_Host_GetCoreStats
+********************************************************************************
+* Summary:
+* Reads the interrupt and sleep counters and the CPU time of a core. Can be
+* called from any thread.
+*
+* Parameters:
+*  core: Core.
+*  stats: Receives the counters.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_Host_GetCoreStats(cy_en_host_core_t core, cy_stc_host_core_stats_t *stats)
+{
+    struct timespec ts;
+
+    stats->interrupts = (uint32_t)atomic_load_explicit(&cy_host_cores[core].interrupts, memory_order_relaxed);
+    stats->sleeps = (uint32_t)atomic_load_explicit(&cy_host_cores[core].sleeps, memory_order_relaxed);
+    stats->cpuNs = 0ULL;
+    if (atomic_load(&cy_host_cores[core].cpuClockValid) && (0 == clock_gettime(cy_host_cores[core].cpuClock, &ts)))
+    {
+        stats->cpuNs = ((uint64_t)ts.tv_sec * CY_HOST_NS_PER_S) + (uint64_t)ts.tv_nsec;
+    }
+}
+
+/*******************************************************************************
+* Function Name: Cy_Host_GetDCacheStats
+********************************************************************************
+* Summary:
+* Reads the data cache maintenance a core has done through the stub of
+* ipc_port.h. Can be called from any thread.
+*
+* Parameters:
+*  core: Core.
+*  stats: Receives the counters.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_Host_GetDCacheStats(cy_en_host_core_t core, cy_stc_host_dcache_stats_t *stats)
+{
+    cy_stc_host_core_t *pCore = &cy_host_cores[core];
+
+    stats->cleans = (uint32_t)atomic_load_explicit(&pCore->cleans, memory_order_relaxed);
+    stats->cleanLines = (uint32_t)atomic_load_explicit(&pCore->cleanLines, memory_order_relaxed);
+    stats->invalidates = (uint32_t)atomic_load_explicit(&pCore->invalidates, memory_order_relaxed);
+    stats->invalidateLines = (uint32_t)atomic_load_explicit(&pCore->invalidateLines, memory_order_relaxed);
+    stats->uncachedLines = (uint32_t)atomic_load_explicit(&pCore->uncachedLines, memory_order_relaxed);
+    stats->lastStart = atomic_load_explicit(&pCore->lastStart, memory_order_relaxed);
+    stats->lastSize = (uint32_t)atomic_load_explicit(&pCore->lastSize, memory_order_relaxed);
+}
+
+/*******************************************************************************
+* Function Name: Cy_Host_GetGpio
+********************************************************************************
+* Summary:
+* Reads the output state of a pin.
+*
+* Parameters:
+*  pin: Pin, 0 .. CY_HOST_GPIO_COUNT - 1.
+*  writes: Receives the number of writes to the pin, can be NULL.
+*
+* Return:
+*  Output state.
+*
+*******************************************************************************/
+bool Cy_Host_GetGpio(uint32_t pin, uint32_t *writes)
+{
+    CY_ASSERT(pin < CY_HOST_GPIO_COUNT);
+
+    if (NULL != writes)
+    {
+        *writes = (uint32_t)atomic_load_explicit(&cy_host_gpioWrites[pin], memory_order_relaxed);
+    }
+    return (0UL != atomic_load_explicit(&cy_host_gpio[pin], memory_order_relaxed));
+}
+
+
+/*******************************************************************************
+* CMSIS and device functions
+*******************************************************************************/
+void __enable_irq(void)
+{
+    Cy_SysLib_ExitCriticalSection(0UL);
+}
+
+void __disable_irq(void)
+{
+    (void)Cy_SysLib_EnterCriticalSection();
+}
+
+/*******************************************************************************
+* Function Name: __WFI
+********************************************************************************
+* Summary:
+* Sleeps until an enabled interrupt is pending. Like on the device it also
+* wakes with interrupts masked; the handler then runs once they are unmasked.
+*
+*******************************************************************************/
+void __WFI(void)
+{
+    cy_stc_host_core_t *core = cy_host_self;
+    sigset_t irqSet;
+    sigset_t savedSet;
+    sigset_t waitSet;
+
+    if (NULL == core)
+    {
+        return;
+    }
+
+    (void)sigemptyset(&irqSet);
+    (void)sigaddset(&irqSet, CY_HOST_IRQ_SIGNAL);
+    (void)pthread_sigmask(SIG_BLOCK, &irqSet, &savedSet);
+
+    if (0UL == (atomic_load(&core->pending) & core->enabled))
+    {
+        waitSet = savedSet;
+        (void)sigdelset(&waitSet, CY_HOST_IRQ_SIGNAL);
+        (void)atomic_fetch_add_explicit(&core->sleeps, 1UL, memory_order_relaxed);
+        (void)sigsuspend(&waitSet);
+    }
+
+    (void)pthread_sigmask(SIG_SETMASK, &savedSet, NULL);
+    cy_host_unmasked(core);
+}
+
+void Cy_SysEnableCM7(uint32_t core, uint32_t vectorTableOffset)
+{
+    (void)vectorTableOffset;
+    Cy_Host_StartCore((cy_en_host_core_t)core);
+}
+
+
+/*******************************************************************************
+* System library
+*******************************************************************************/
+void Cy_SysLib_AssertFailed(char const *file, uint32_t line)
+{
+    (void)fprintf(stderr, "CY_ASSERT failed: %s:%u\n", file, (unsigned int)line);
+    abort();
+}
+
+void Cy_SysLib_Delay(uint32_t milliseconds)
+{
+    cy_host_sleep_until(cy_host_now() + ((uint64_t)milliseconds * CY_HOST_NS_PER_MS));
+}
+
+void Cy_SysLib_DelayUs(uint16_t microseconds)
+{
+    cy_host_sleep_until(cy_host_now() + ((uint64_t)microseconds * (CY_HOST_NS_PER_MS / 1000ULL)));
+}
+
+uint32_t Cy_SysLib_EnterCriticalSection(void)
+{
+    cy_stc_host_core_t *core = cy_host_self;
+    uint32_t savedIntrStatus;
+
+    if (NULL == core)
+    {
+        return 0UL;
+    }
+
+    savedIntrStatus = (uint32_t)core->primask;
+    core->primask = 1;
+    atomic_signal_fence(memory_order_seq_cst);
+
+    return savedIntrStatus;
+}
+
+void Cy_SysLib_ExitCriticalSection(uint32_t savedIntrStatus)
+{
+    cy_stc_host_core_t *core = cy_host_self;
+
+    if (NULL == core)
+    {
+        return;
+    }
+
+    atomic_signal_fence(memory_order_seq_cst);
+    core->primask = (0UL != savedIntrStatus) ? 1 : 0;
+    atomic_signal_fence(memory_order_seq_cst);
+    cy_host_unmasked(core);
+}
+
+/*******************************************************************************
+* Function Name: Cy_SysPm_CpuEnterDeepSleep
+********************************************************************************
+* Summary:
+* The host has no low power modes: the core waits for an enabled interrupt
+* as with __WFI() and wakes with the interrupt pending.
+*
+*******************************************************************************/
+cy_en_syspm_status_t Cy_SysPm_CpuEnterDeepSleep(cy_en_syspm_waitfor_t waitFor)
+{
+    (void)waitFor;
+    __WFI();
+
+    return CY_SYSPM_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Interrupt routing and SysTick
+*******************************************************************************/
+cy_en_sysint_status_t Cy_SysInt_Init(cy_stc_sysint_t const *config, cy_israddress userIsr)
+{
+    cy_stc_host_core_t *core = cy_host_self;
+    uint32_t intrSrc = config->intrSrc & ((1UL << CY_SYSINT_INTRSRC_MUXIRQ_SHIFT) - 1UL);
+
+    if ((NULL == core) || (intrSrc >= CY_HOST_IRQ_COUNT) || (CY_HOST_IRQ_SYSTICK == intrSrc))
+    {
+        return CY_SYSINT_BAD_PARAM;
+    }
+
+    core->vector[intrSrc] = userIsr;
+    core->line[intrSrc] = (IRQn_Type)(config->intrSrc >> CY_SYSINT_INTRSRC_MUXIRQ_SHIFT);
+    core->priority[intrSrc] = (uint8_t)config->intrPriority;
+    atomic_store(&cy_host_route[intrSrc], (uint32_t)(core - cy_host_cores));
+
+    return CY_SYSINT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: NVIC_EnableIRQ
+********************************************************************************
+* Summary:
+* Enables the system interrupts routed to a CPU line of the calling core.
+* IPC interrupts are level triggered: a structure that still has events
+* pending raises its line again once it is enabled.
+*
+*******************************************************************************/
+void NVIC_EnableIRQ(IRQn_Type irqn)
+{
+    cy_stc_host_core_t *core = cy_host_self;
+    uint32_t self = (uint32_t)(core - cy_host_cores);
+    uint32_t irq;
+
+    for (irq = 0UL; irq < CY_HOST_IRQ_COUNT; irq++)
+    {
+        if ((self == atomic_load(&cy_host_route[irq])) && (irqn == core->line[irq]))
+        {
+            if ((0UL == (core->enabled & (1UL << irq))) && (irq < CY_IPC_INTERRUPTS) &&
+                (0UL != Cy_IPC_Drv_GetInterruptStatusMasked(Cy_IPC_Drv_GetIntrBaseAddr(irq - (uint32_t)cpuss_interrupts_ipc_0_IRQn))))
+            {
+                cy_host_pend(core, irq);
+            }
+            core->enabled |= (1UL << irq);
+        }
+    }
+    cy_host_unmasked(core);
+}
+
+void NVIC_DisableIRQ(IRQn_Type irqn)
+{
+    cy_stc_host_core_t *core = cy_host_self;
+    uint32_t self = (uint32_t)(core - cy_host_cores);
+    uint32_t irq;
+
+    for (irq = 0UL; irq < CY_HOST_IRQ_COUNT; irq++)
+    {
+        if ((self == atomic_load(&cy_host_route[irq])) && (irqn == core->line[irq]))
+        {
+            core->enabled &= ~(1UL << irq);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: Cy_SysTick_Init
+********************************************************************************
+* Summary:
+* Starts the SysTick of the calling core and clears its callbacks. The
+* period is (interval + 1) cycles of the selected clock.
+*
+*******************************************************************************/
+void Cy_SysTick_Init(cy_en_systick_clock_source_t clockSource, uint32_t interval)
+{
+    cy_stc_host_core_t *core = cy_host_self;
+    uint64_t hz = (CY_SYSTICK_CLOCK_SOURCE_CLK_LF == clockSource) ? CY_HOST_CLK_LF_HZ : (uint64_t)SystemCoreClock;
+    uint32_t i;
+
+    for (i = 0UL; i < CY_SYS_SYST_NUM_OF_CALLBACKS; i++)
+    {
+        core->sysTickCallbacks[i] = NULL;
+    }
+    core->vector[CY_HOST_IRQ_SYSTICK] = &cy_host_systick_isr;
+    core->priority[CY_HOST_IRQ_SYSTICK] = (uint8_t)CY_HOST_PRIO_SYSTICK;
+    core->enabled |= (1UL << CY_HOST_IRQ_SYSTICK);
+
+    atomic_store(&core->sysTickPeriod, (((uint64_t)interval + 1ULL) * CY_HOST_NS_PER_S) / hz);
+}
+
+cy_israddress Cy_SysTick_SetCallback(uint32_t number, cy_israddress function)
+{
+    cy_stc_host_core_t *core = cy_host_self;
+    cy_israddress previous;
+
+    CY_ASSERT(number < CY_SYS_SYST_NUM_OF_CALLBACKS);
+
+    previous = core->sysTickCallbacks[number];
+    core->sysTickCallbacks[number] = function;
+
+    return previous;
+}
+
+
+/*******************************************************************************
+* BSP and HAL
+*******************************************************************************/
+cy_rslt_t cybsp_init(void)
+{
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cyhal_gpio_init(cyhal_gpio_t pin, cyhal_gpio_direction_t direction, cyhal_gpio_drive_mode_t drive_mode,
+                          bool init_val)
+{
+    (void)direction;
+    (void)drive_mode;
+
+    if (pin >= CY_HOST_GPIO_COUNT)
+    {
+        return (cy_rslt_t)1UL;
+    }
+
+    atomic_store_explicit(&cy_host_gpio[pin], init_val ? 1UL : 0UL, memory_order_relaxed);
+    return CY_RSLT_SUCCESS;
+}
+
+void cyhal_gpio_write(cyhal_gpio_t pin, bool value)
+{
+    if (pin < CY_HOST_GPIO_COUNT)
+    {
+        atomic_store_explicit(&cy_host_gpio[pin], value ? 1UL : 0UL, memory_order_relaxed);
+        (void)atomic_fetch_add_explicit(&cy_host_gpioWrites[pin], 1UL, memory_order_relaxed);
+    }
+}
+
+void cyhal_system_delay_ms(uint32_t milliseconds)
+{
+    Cy_SysLib_Delay(milliseconds);
+}
+
+
+/*******************************************************************************
+* Data cache stub of ipc_port.h. The host has coherent caches, so nothing is
+* maintained; each CM7 counts the lines it would write back or discard.
+* CM0+ has no D-cache and other threads are not cores, their calls are
+* dropped.
+*******************************************************************************/
+/*******************************************************************************
+* Function Name: cy_host_dcache_core
+********************************************************************************
+* Summary:
+* Returns the calling core if it has a D-cache and records the range of its
+* operation, NULL otherwise.
+*
+*******************************************************************************/
+static cy_stc_host_core_t *cy_host_dcache_core(uintptr_t start, uint32_t size)
+{
+    cy_stc_host_core_t *core = cy_host_self;
+
+    /* The port widens every range to whole lines */
+    CY_ASSERT((0UL == (start & (IPC_PORT_CACHE_LINE - 1UL))) && (0UL == (size & (IPC_PORT_CACHE_LINE - 1UL))));
+
+    if ((NULL == core) || (&cy_host_cores[CY_HOST_CORE_CM0P] == core))
+    {
+        return NULL;
+    }
+
+    atomic_store_explicit(&core->lastStart, start, memory_order_relaxed);
+    atomic_store_explicit(&core->lastSize, size, memory_order_relaxed);
+    if ((0UL != core->uncachedSize) && (start < (core->uncachedBase + core->uncachedSize)) &&
+        ((start + size) > core->uncachedBase))
+    {
+        (void)atomic_fetch_add_explicit(&core->uncachedLines, size / IPC_PORT_CACHE_LINE, memory_order_relaxed);
+    }
+
+    return core;
+}
+
+void Cy_IPC_Port_StubCleanDCache(uintptr_t start, uint32_t size)
+{
+    cy_stc_host_core_t *core = cy_host_dcache_core(start, size);
+
+    if (NULL != core)
+    {
+        (void)atomic_fetch_add_explicit(&core->cleans, 1UL, memory_order_relaxed);
+        (void)atomic_fetch_add_explicit(&core->cleanLines, size / IPC_PORT_CACHE_LINE, memory_order_relaxed);
+    }
+}
+
+void Cy_IPC_Port_StubInvalidateDCache(uintptr_t start, uint32_t size)
+{
+    cy_stc_host_core_t *core = cy_host_dcache_core(start, size);
+
+    if (NULL != core)
+    {
+        (void)atomic_fetch_add_explicit(&core->invalidates, 1UL, memory_order_relaxed);
+        (void)atomic_fetch_add_explicit(&core->invalidateLines, size / IPC_PORT_CACHE_LINE, memory_order_relaxed);
+    }
+}
+
+void Cy_IPC_Port_StubSetNonCacheable(uintptr_t base, uint32_t size)
+{
+    cy_stc_host_core_t *core = cy_host_self;
+
+    if (NULL != core)
+    {
+        core->uncachedBase = base;
+        core->uncachedSize = size;
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,369 @@
+/******************************************************************************
+* File Name:   cy_ipc_drv.c
+*
+* Description: Host emulation of the IPC driver.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "cy_ipc_drv.h"
+#include "cy_host.h"
+
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static IPC_STRUCT_Type cy_ipc_drv_chan[CY_IPC_CHANNELS];
+static IPC_INTR_STRUCT_Type cy_ipc_drv_intr[CY_IPC_INTERRUPTS];
+
+
+/*******************************************************************************
+* Function Name: ipc_drv_raise
+********************************************************************************
+* Summary:
+* Sets events in the interrupt structures of intrMask and raises the system
+* interrupt of each structure that has one of them unmasked.
+*
+*******************************************************************************/
+static void ipc_drv_raise(uint32_t intrMask, uint32_t events)
+{
+    uint32_t i;
+
+    for (i = 0UL; i < CY_IPC_INTERRUPTS; i++)
+    {
+        if (0UL != (intrMask & (1UL << i)))
+        {
+            (void)atomic_fetch_or(&cy_ipc_drv_intr[i].intr, events);
+            if (0UL != (events & atomic_load(&cy_ipc_drv_intr[i].intrMask)))
+            {
+                Cy_Host_RaiseIrq((uint32_t)cpuss_interrupts_ipc_0_IRQn + i);
+            }
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: ipc_drv_chan_index
+********************************************************************************
+* Summary:
+* Returns the channel number of an IPC structure.
+*
+*******************************************************************************/
+static inline uint32_t ipc_drv_chan_index(IPC_STRUCT_Type const *base)
+{
+    return (uint32_t)(base - cy_ipc_drv_chan);
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Drv_GetIpcBaseAddress
+********************************************************************************
+* Summary:
+* Returns the IPC structure of a channel.
+*
+* Parameters:
+*  ipcIndex: Channel, 0 .. CY_IPC_CHANNELS - 1.
+*
+* Return:
+*  IPC structure.
+*
+*******************************************************************************/
+IPC_STRUCT_Type *Cy_IPC_Drv_GetIpcBaseAddress(uint32_t ipcIndex)
+{
+    CY_ASSERT(ipcIndex < CY_IPC_CHANNELS);
+
+    return &cy_ipc_drv_chan[ipcIndex];
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Drv_GetIntrBaseAddr
+********************************************************************************
+* Summary:
+* Returns an IPC interrupt structure.
+*
+* Parameters:
+*  ipcIntrIndex: Interrupt structure, 0 .. CY_IPC_INTERRUPTS - 1.
+*
+* Return:
+*  IPC interrupt structure.
+*
+*******************************************************************************/
+IPC_INTR_STRUCT_Type *Cy_IPC_Drv_GetIntrBaseAddr(uint32_t ipcIntrIndex)
+{
+    CY_ASSERT(ipcIntrIndex < CY_IPC_INTERRUPTS);
+
+    return &cy_ipc_drv_intr[ipcIntrIndex];
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Drv_LockAcquire
+********************************************************************************
+* Summary:
+* Tries once to acquire the lock of a channel.
+*
+* Parameters:
+*  base: IPC structure.
+*
+* Return:
+*  CY_IPC_DRV_SUCCESS, or CY_IPC_DRV_ERROR if the lock is held.
+*
+*******************************************************************************/
+cy_en_ipc_drv_status_t Cy_IPC_Drv_LockAcquire(IPC_STRUCT_Type *base)
+{
+    uint_least32_t expected = 0UL;
+
+    if (!atomic_compare_exchange_strong_explicit(&base->acquire, &expected, 1UL,
+                                                 memory_order_acquire, memory_order_relaxed))
+    {
+        (void)atomic_fetch_add_explicit(&base->busy, 1UL, memory_order_relaxed);
+        return CY_IPC_DRV_ERROR;
+    }
+
+    return CY_IPC_DRV_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Drv_LockRelease
+********************************************************************************
+* Summary:
+* Releases the lock of a channel and sends a release event to the interrupt
+* structures of releaseEventIntr.
+*
+* Parameters:
+*  base: IPC structure.
+*  releaseEventIntr: Mask of interrupt structures.
+*
+* Return:
+*  CY_IPC_DRV_SUCCESS, or CY_IPC_DRV_ERROR if the lock was not held.
+*
+*******************************************************************************/
+cy_en_ipc_drv_status_t Cy_IPC_Drv_LockRelease(IPC_STRUCT_Type *base, uint32_t releaseEventIntr)
+{
+    if (0UL == atomic_exchange_explicit(&base->acquire, 0UL, memory_order_release))
+    {
+        return CY_IPC_DRV_ERROR;
+    }
+
+    (void)atomic_fetch_add_explicit(&base->releases, 1UL, memory_order_relaxed);
+    ipc_drv_raise(releaseEventIntr, _VAL2FLD(IPC_INTR_STRUCT_INTR_RELEASE, 1UL << ipc_drv_chan_index(base)));
+
+    return CY_IPC_DRV_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Drv_IsLockAcquired
+********************************************************************************
+* Summary:
+* Returns true while the lock of a channel is held.
+*
+* Parameters:
+*  base: IPC structure.
+*
+* Return:
+*  Lock state.
+*
+*******************************************************************************/
+bool Cy_IPC_Drv_IsLockAcquired(IPC_STRUCT_Type const *base)
+{
+    return (0UL != atomic_load_explicit(&base->acquire, memory_order_acquire));
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Drv_AcquireNotify
+********************************************************************************
+* Summary:
+* Sends a notify event to the interrupt structures of notifyEventIntr.
+*
+* Parameters:
+*  base: IPC structure.
+*  notifyEventIntr: Mask of interrupt structures.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Drv_AcquireNotify(IPC_STRUCT_Type *base, uint32_t notifyEventIntr)
+{
+    ipc_drv_raise(notifyEventIntr, _VAL2FLD(IPC_INTR_STRUCT_INTR_NOTIFY, 1UL << ipc_drv_chan_index(base)));
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Drv_SendMsgPtr
+********************************************************************************
+* Summary:
+* Acquires the channel, writes the message pointer and notifies the
+* interrupt structures of notifyEventIntr. The lock stays held until the
+* receiver releases it.
+*
+* Parameters:
+*  base: IPC structure.
+*  notifyEventIntr: Mask of interrupt structures.
+*  msgPtr: Message.
+*
+* Return:
+*  CY_IPC_DRV_SUCCESS, or CY_IPC_DRV_ERROR if the channel is busy.
+*
+*******************************************************************************/
+cy_en_ipc_drv_status_t Cy_IPC_Drv_SendMsgPtr(IPC_STRUCT_Type *base, uint32_t notifyEventIntr, void const *msgPtr)
+{
+    if (CY_IPC_DRV_SUCCESS != Cy_IPC_Drv_LockAcquire(base))
+    {
+        return CY_IPC_DRV_ERROR;
+    }
+
+    atomic_store_explicit(&base->data, (uintptr_t)msgPtr, memory_order_relaxed);
+    (void)atomic_fetch_add_explicit(&base->sends, 1UL, memory_order_relaxed);
+    Cy_IPC_Drv_AcquireNotify(base, notifyEventIntr);
+
+    return CY_IPC_DRV_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Drv_ReadMsgPtr
+********************************************************************************
+* Summary:
+* Reads the message pointer of a channel that is locked.
+*
+* Parameters:
+*  base: IPC structure.
+*  msgPtr: Receives the message.
+*
+* Return:
+*  CY_IPC_DRV_SUCCESS, or CY_IPC_DRV_ERROR if the channel is not locked.
+*
+*******************************************************************************/
+cy_en_ipc_drv_status_t Cy_IPC_Drv_ReadMsgPtr(IPC_STRUCT_Type const *base, void **msgPtr)
+{
+    if (!Cy_IPC_Drv_IsLockAcquired(base))
+    {
+        return CY_IPC_DRV_ERROR;
+    }
+
+    *msgPtr = (void *)atomic_load_explicit(&base->data, memory_order_relaxed);
+
+    return CY_IPC_DRV_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Drv_SetInterruptMask
+********************************************************************************
+* Summary:
+* Selects the channels whose release and notify events raise the interrupt.
+* Events that are already pending raise it at once.
+*
+* Parameters:
+*  base: IPC interrupt structure.
+*  ipcReleaseMask: Channels for release events.
+*  ipcNotifyMask: Channels for notify events.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Drv_SetInterruptMask(IPC_INTR_STRUCT_Type *base, uint32_t ipcReleaseMask, uint32_t ipcNotifyMask)
+{
+    uint32_t mask = _VAL2FLD(IPC_INTR_STRUCT_INTR_RELEASE, ipcReleaseMask) |
+                    _VAL2FLD(IPC_INTR_STRUCT_INTR_NOTIFY, ipcNotifyMask);
+
+    atomic_store(&base->intrMask, mask);
+    if (0UL != (mask & atomic_load(&base->intr)))
+    {
+        Cy_Host_RaiseIrq((uint32_t)cpuss_interrupts_ipc_0_IRQn + (uint32_t)(base - cy_ipc_drv_intr));
+    }
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Drv_GetInterruptStatusMasked
+********************************************************************************
+* Summary:
+* Returns the pending events that are not masked.
+*
+* Parameters:
+*  base: IPC interrupt structure.
+*
+* Return:
+*  Bits [31:16] notify, bits [15:0] release events per channel.
+*
+*******************************************************************************/
+uint32_t Cy_IPC_Drv_GetInterruptStatusMasked(IPC_INTR_STRUCT_Type const *base)
+{
+    return (uint32_t)(atomic_load(&base->intr) & atomic_load(&base->intrMask));
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Drv_ClearInterrupt
+********************************************************************************
+* Summary:
+* Clears pending release and notify events.
+*
+* Parameters:
+*  base: IPC interrupt structure.
+*  ipcReleaseMask: Channels of the release events to clear.
+*  ipcNotifyMask: Channels of the notify events to clear.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Drv_ClearInterrupt(IPC_INTR_STRUCT_Type *base, uint32_t ipcReleaseMask, uint32_t ipcNotifyMask)
+{
+    (void)atomic_fetch_and(&base->intr, ~(_VAL2FLD(IPC_INTR_STRUCT_INTR_RELEASE, ipcReleaseMask) |
+                                          _VAL2FLD(IPC_INTR_STRUCT_INTR_NOTIFY, ipcNotifyMask)));
+}
+
+/*******************************************************************************
+* Function Name: Cy_Host_GetChannelStats
+********************************************************************************
+* Summary:
+* Reads the traffic counters of a channel. Can be called from any thread.
+*
+* Parameters:
+*  channel: Channel, 0 .. CY_IPC_CHANNELS - 1.
+*  stats: Receives the counters.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_Host_GetChannelStats(uint32_t channel, cy_stc_host_chan_stats_t *stats)
+{
+    IPC_STRUCT_Type *base = Cy_IPC_Drv_GetIpcBaseAddress(channel);
+
+    stats->sends = (uint32_t)atomic_load_explicit(&base->sends, memory_order_relaxed);
+    stats->busy = (uint32_t)atomic_load_explicit(&base->busy, memory_order_relaxed);
+    stats->releases = (uint32_t)atomic_load_explicit(&base->releases, memory_order_relaxed);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,346 @@
+/******************************************************************************
+* File Name:   cy_ipc_pipe.c
+*
+* Description: Host emulation of the PDL IPC pipe. Follows the PDL: a
+*              message is sent on the channel of the receiving endpoint,
+*              the receiver releases the channel after the client
+*              callback, and the sender clears its busy flag after the
+*              release callback.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "cy_ipc_pipe.h"
+
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+/* Every core has its own endpoint array, like the PDL linked into each image */
+static _Thread_local cy_stc_ipc_pipe_ep_t *cy_ipc_pipe_epArray;
+
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Pipe_Config
+********************************************************************************
+* Summary:
+* Sets the endpoint array of the calling core.
+*
+* Parameters:
+*  theEpArray: CY_IPC_MAX_ENDPOINTS endpoints.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Pipe_Config(cy_stc_ipc_pipe_ep_t *theEpArray)
+{
+    cy_ipc_pipe_epArray = theEpArray;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Pipe_Init
+********************************************************************************
+* Summary:
+* Initializes both endpoints of a pipe and routes the interrupt of the
+* receiver endpoint to the calling core.
+*
+* Parameters:
+*  config: Pipe configuration.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Pipe_Init(cy_stc_ipc_pipe_config_t const *config)
+{
+    cy_stc_sysint_t ipc_intr_cypipeConfig;
+
+    CY_ASSERT(NULL != config);
+
+    ipc_intr_cypipeConfig.intrSrc = ((uint32_t)config->ep0ConfigData.ipcNotifierMuxNumber << CY_SYSINT_INTRSRC_MUXIRQ_SHIFT) |
+                                    ((uint32_t)cpuss_interrupts_ipc_0_IRQn + config->ep0ConfigData.ipcNotifierNumber);
+    ipc_intr_cypipeConfig.intrPriority = config->ep0ConfigData.ipcNotifierPriority;
+
+    Cy_IPC_Pipe_EndpointInit(config->ep0ConfigData.epAddress, config->endpointsCallbacksArray,
+                             config->endpointClientsCount, config->ep0ConfigData.epConfig, &ipc_intr_cypipeConfig);
+    Cy_IPC_Pipe_EndpointInit(config->ep1ConfigData.epAddress, NULL, 0UL, config->ep1ConfigData.epConfig, NULL);
+
+    (void)Cy_SysInt_Init(&ipc_intr_cypipeConfig, config->userPipeIsrHandler);
+    NVIC_EnableIRQ(config->ep0ConfigData.ipcNotifierMuxNumber);
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Pipe_EndpointInit
+********************************************************************************
+* Summary:
+* Initializes an endpoint of the calling core and sets the interrupt mask of
+* its interrupt structure.
+*
+* Parameters:
+*  epAddr: Endpoint index.
+*  cbArray: Client callbacks, NULL for a remote endpoint.
+*  cbCnt: Number of clients.
+*  epConfig: Channel, interrupt and interrupt mask.
+*  epInterrupt: Interrupt of a receiver endpoint, NULL for a remote endpoint.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Pipe_EndpointInit(uint32_t epAddr, cy_ipc_pipe_callback_array_ptr_t cbArray, uint32_t cbCnt,
+                              uint32_t epConfig, cy_stc_sysint_t const *epInterrupt)
+{
+    cy_stc_ipc_pipe_ep_t *endpoint;
+
+    CY_ASSERT(NULL != cy_ipc_pipe_epArray);
+
+    endpoint = &cy_ipc_pipe_epArray[epAddr];
+
+    endpoint->ipcChan = _FLD2VAL(CY_IPC_PIPE_CFG_CHAN, epConfig);
+    endpoint->intrChan = _FLD2VAL(CY_IPC_PIPE_CFG_INTR, epConfig);
+    endpoint->pipeIntMask = _FLD2VAL(CY_IPC_PIPE_CFG_IMASK, epConfig);
+
+    endpoint->ipcPtr = Cy_IPC_Drv_GetIpcBaseAddress(endpoint->ipcChan);
+    endpoint->ipcIntrPtr = Cy_IPC_Drv_GetIntrBaseAddr(endpoint->intrChan);
+
+    /* Only allow notify and release interrupts from the channels of the pipes */
+    Cy_IPC_Drv_SetInterruptMask(endpoint->ipcIntrPtr, endpoint->pipeIntMask, endpoint->pipeIntMask);
+
+    endpoint->clientCount = cbCnt;
+    endpoint->callbackArray = cbArray;
+    endpoint->busy = CY_IPC_PIPE_ENDPOINT_NOTBUSY;
+
+    if (NULL != epInterrupt)
+    {
+        endpoint->pipeIntrSrc = (IRQn_Type)(epInterrupt->intrSrc >> CY_SYSINT_INTRSRC_MUXIRQ_SHIFT);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Pipe_SendMessage
+********************************************************************************
+* Summary:
+* Sends a message to another endpoint. The release mask of the first message
+* word is set to the interrupt of the sender. Call with interrupts masked
+* when the sender endpoint is also used from interrupts.
+*
+* Parameters:
+*  toAddr: Receiver endpoint.
+*  fromAddr: Sender endpoint.
+*  msgPtr: Message, the first word carries the client ID.
+*  callBackPtr: Called on the sender when the receiver releases the channel.
+*
+* Return:
+*  CY_IPC_PIPE_SUCCESS, or CY_IPC_PIPE_ERROR_SEND_BUSY if the sender endpoint
+*  has a message in flight or the channel is locked.
+*
+*******************************************************************************/
+cy_en_ipc_pipe_status_t Cy_IPC_Pipe_SendMessage(uint32_t toAddr, uint32_t fromAddr, void *msgPtr,
+                                                cy_ipc_pipe_relcallback_ptr_t callBackPtr)
+{
+    cy_stc_ipc_pipe_ep_t *fromEp;
+    cy_stc_ipc_pipe_ep_t *toEp;
+    uint32_t releaseMask;
+    uint32_t notifyMask;
+
+    CY_ASSERT(NULL != msgPtr);
+
+    fromEp = &cy_ipc_pipe_epArray[fromAddr];
+    toEp = &cy_ipc_pipe_epArray[toAddr];
+
+    if (CY_IPC_PIPE_ENDPOINT_NOTBUSY != fromEp->busy)
+    {
+        return CY_IPC_PIPE_ERROR_SEND_BUSY;
+    }
+
+    fromEp->busy = CY_IPC_PIPE_ENDPOINT_BUSY;
+    fromEp->releaseCallbackPtr = callBackPtr;
+
+    releaseMask = _VAL2FLD(CY_IPC_PIPE_MSG_RELEASE, 1UL << fromEp->intrChan);
+    *(uint32_t *)msgPtr = (*(uint32_t *)msgPtr & ~CY_IPC_PIPE_MSG_RELEASE_Msk) | releaseMask;
+
+    notifyMask = 1UL << toEp->intrChan;
+    if (CY_IPC_DRV_SUCCESS != Cy_IPC_Drv_SendMsgPtr(toEp->ipcPtr, notifyMask, msgPtr))
+    {
+        fromEp->releaseCallbackPtr = NULL;
+        fromEp->busy = CY_IPC_PIPE_ENDPOINT_NOTBUSY;
+        return CY_IPC_PIPE_ERROR_SEND_BUSY;
+    }
+
+    return CY_IPC_PIPE_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Pipe_RegisterCallback
+********************************************************************************
+* Summary:
+* Registers the callback of a client on an endpoint of the calling core.
+*
+* Parameters:
+*  epAddr: Endpoint index.
+*  callBackPtr: Client callback.
+*  clientId: Client ID.
+*
+* Return:
+*  CY_IPC_PIPE_SUCCESS, or CY_IPC_PIPE_ERROR_BAD_HANDLE for an unknown client.
+*
+*******************************************************************************/
+cy_en_ipc_pipe_status_t Cy_IPC_Pipe_RegisterCallback(uint32_t epAddr, cy_ipc_pipe_callback_ptr_t callBackPtr,
+                                                     uint32_t clientId)
+{
+    cy_stc_ipc_pipe_ep_t *endpoint = &cy_ipc_pipe_epArray[epAddr];
+
+    if (clientId >= endpoint->clientCount)
+    {
+        return CY_IPC_PIPE_ERROR_BAD_HANDLE;
+    }
+
+    endpoint->callbackArray[clientId] = callBackPtr;
+
+    return CY_IPC_PIPE_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Pipe_RegisterCallbackRel
+********************************************************************************
+* Summary:
+* Registers the release callback used when a message was sent without one.
+*
+* Parameters:
+*  epAddr: Endpoint index.
+*  callBackPtr: Default release callback.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Pipe_RegisterCallbackRel(uint32_t epAddr, cy_ipc_pipe_relcallback_ptr_t callBackPtr)
+{
+    cy_ipc_pipe_epArray[epAddr].defaultReleaseCallbackPtr = callBackPtr;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Pipe_ExecuteCallback
+********************************************************************************
+* Summary:
+* Handles the pending events of an endpoint; called from its interrupt. A
+* notify runs the client callback and releases the channel. A release runs
+* the release callback, then clears the busy flag.
+*
+* Parameters:
+*  epAddr: Endpoint index.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Pipe_ExecuteCallback(uint32_t epAddr)
+{
+    cy_stc_ipc_pipe_ep_t *endpoint = &cy_ipc_pipe_epArray[epAddr];
+    uint32_t *msgPtr = NULL;
+    uint32_t shadowIntr;
+    uint32_t releaseMask;
+    uint32_t clientID;
+    cy_ipc_pipe_callback_ptr_t callbackPtr;
+
+    shadowIntr = Cy_IPC_Drv_GetInterruptStatusMasked(endpoint->ipcIntrPtr);
+
+    if (0UL != Cy_IPC_Drv_ExtractAcquireMask(shadowIntr))
+    {
+        Cy_IPC_Drv_ClearInterrupt(endpoint->ipcIntrPtr, CY_IPC_NO_NOTIFICATION, Cy_IPC_Drv_ExtractAcquireMask(shadowIntr));
+
+        if (CY_IPC_DRV_SUCCESS == Cy_IPC_Drv_ReadMsgPtr(endpoint->ipcPtr, (void **)&msgPtr))
+        {
+            releaseMask = _FLD2VAL(CY_IPC_PIPE_MSG_RELEASE, *msgPtr);
+            clientID = _FLD2VAL(CY_IPC_PIPE_MSG_CLIENT, *msgPtr);
+
+            if (clientID < endpoint->clientCount)
+            {
+                callbackPtr = endpoint->callbackArray[clientID];
+                if (NULL != callbackPtr)
+                {
+                    callbackPtr(msgPtr);
+                }
+            }
+
+            /* Must always release the channel */
+            (void)Cy_IPC_Drv_LockRelease(endpoint->ipcPtr, releaseMask);
+        }
+    }
+
+    if (0UL != Cy_IPC_Drv_ExtractReleaseMask(shadowIntr))
+    {
+        Cy_IPC_Drv_ClearInterrupt(endpoint->ipcIntrPtr, Cy_IPC_Drv_ExtractReleaseMask(shadowIntr), CY_IPC_NO_NOTIFICATION);
+
+        if (NULL != endpoint->releaseCallbackPtr)
+        {
+            endpoint->releaseCallbackPtr();
+            endpoint->releaseCallbackPtr = NULL;
+        }
+        else if (NULL != endpoint->defaultReleaseCallbackPtr)
+        {
+            endpoint->defaultReleaseCallbackPtr();
+        }
+        else
+        {
+            /* No release callback */
+        }
+
+        /* Cleared only after the release callback */
+        endpoint->busy = CY_IPC_PIPE_ENDPOINT_NOTBUSY;
+    }
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Pipe_EndpointIsBusy
+********************************************************************************
+* Summary:
+* Returns true while a message sent from the endpoint is not yet released.
+*
+* Parameters:
+*  epAddr: Endpoint index.
+*
+* Return:
+*  Busy state.
+*
+*******************************************************************************/
+bool Cy_IPC_Pipe_EndpointIsBusy(uint32_t epAddr)
+{
+    return (CY_IPC_PIPE_ENDPOINT_NOTBUSY != cy_ipc_pipe_epArray[epAddr].busy);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,149 @@
+/******************************************************************************
+* File Name:   host_main.c
+*
+* Description: Runs the CM0+, CM7_0 and CM7_1 images on the host emulator
+*              for a fixed time and prints the pipe traffic and the cache
+*              maintenance of the CM7 cores.
+*              Usage: ipc_host [seconds]
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "cy_host.h"
+#include "cybsp.h"
+#include "ipc_topology.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define HOST_RUN_TIME_S                 (2.0)   /* Default run time */
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+/* main() of each image, renamed by the host Makefile */
+int Cy_Host_Main_Cm0p(void);
+int Cy_Host_Main_Cm7_0(void);
+int Cy_Host_Main_Cm7_1(void);
+
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static char const *const hostCoreNames[CY_HOST_CORE_COUNT] = { "CM0+", "CM7_0", "CM7_1" };
+
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* Boots CM0+, which enables the CM7 cores, lets the system run and prints
+* the interrupts of each core and the messages of each user IPC channel.
+*
+* Parameters:
+*  argc, argv: Optional run time in seconds.
+*
+* Return:
+*  EXIT_SUCCESS
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+    static cy_host_entry_t const entry[CY_HOST_CORE_COUNT] =
+    {
+        &Cy_Host_Main_Cm0p,
+        &Cy_Host_Main_Cm7_0,
+        &Cy_Host_Main_Cm7_1,
+    };
+    double seconds = (argc > 1) ? strtod(argv[1], NULL) : HOST_RUN_TIME_S;
+    struct timespec runTime;
+    cy_stc_host_core_stats_t coreStats;
+    cy_stc_host_chan_stats_t chanStats;
+    cy_stc_host_dcache_stats_t dcacheStats;
+    uint32_t writes;
+    uint32_t i;
+
+    if (seconds <= 0.0)
+    {
+        seconds = HOST_RUN_TIME_S;
+    }
+
+    Cy_Host_Init(entry);
+    Cy_Host_StartCore(CY_HOST_CORE_CM0P);
+
+    runTime.tv_sec = (time_t)seconds;
+    runTime.tv_nsec = (long)((seconds - (double)runTime.tv_sec) * 1e9);
+    while (0 != nanosleep(&runTime, &runTime))
+    {
+    }
+
+    (void)printf("run time %.3f s\n", seconds);
+    for (i = 0UL; i < CY_HOST_CORE_COUNT; i++)
+    {
+        Cy_Host_GetCoreStats((cy_en_host_core_t)i, &coreStats);
+        (void)printf("%-6s interrupts %10u  %12.0f/s  sleeps %10u\n", hostCoreNames[i],
+                     (unsigned int)coreStats.interrupts, (double)coreStats.interrupts / seconds,
+                     (unsigned int)coreStats.sleeps);
+    }
+    /* The endpoints share channels, so the messages are counted per channel */
+    for (i = CY_IPC_CHAN_USER; i < CY_IPC_CHANNELS; i++)
+    {
+        Cy_Host_GetChannelStats(i, &chanStats);
+        (void)printf("U%u     sends      %10u  %12.0f/s  busy   %10u  releases %10u\n", (unsigned int)(i - CY_IPC_CHAN_USER),
+                     (unsigned int)chanStats.sends, (double)chanStats.sends / seconds,
+                     (unsigned int)chanStats.busy, (unsigned int)chanStats.releases);
+    }
+    /* CM0+ has no D-cache */
+    for (i = (uint32_t)CY_HOST_CORE_CM7_0; i < CY_HOST_CORE_COUNT; i++)
+    {
+        Cy_Host_GetDCacheStats((cy_en_host_core_t)i, &dcacheStats);
+        (void)printf("%-6s cleaned    %10u lines  invalidated %10u lines  uncached %u\n", hostCoreNames[i],
+                     (unsigned int)dcacheStats.cleanLines, (unsigned int)dcacheStats.invalidateLines,
+                     (unsigned int)dcacheStats.uncachedLines);
+    }
+    (void)Cy_Host_GetGpio(CYBSP_USER_LED, &writes);
+    (void)printf("LED    writes     %10u\n", (unsigned int)writes);
+
+    /* The cores never return; exiting ends their threads */
+    return EXIT_SUCCESS;
+}
+
+/* [] END OF FILE */
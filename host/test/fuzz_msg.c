@@ -0,0 +1,418 @@
+/******************************************************************************
+* File Name:   fuzz_msg.c
+*
+* Description: Fuzz test of the message header checks of ipc_msg.h. Seals
+*              random messages, mutates their header, length, payload, CRC
+*              and sequence, and compares the verdict of Cy_IPC_Msg_Check()
+*              with a reference model. Every message ends at a guard page,
+*              so a read past the longest accepted payload faults. Built
+*              with the CRC and sequence checks enabled.
+*              Usage: fuzz_msg [iterations] [seed]
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "ipc_msg.h"
+#include "test.h"
+
+#if !IPC_MSG_CRC_ENABLE || !IPC_MSG_SEQ_ENABLE
+#error "fuzz_msg needs IPC_MSG_CRC_ENABLE and IPC_MSG_SEQ_ENABLE"
+#endif
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define FUZZ_MSG_ITERATIONS             (100000UL) /* Override with argv[1] */
+#define FUZZ_MSG_SEED                   (1UL)      /* Override with argv[2] */
+#define FUZZ_MSG_MAX_LENGTH             (2048UL)   /* Longest payload a receiver accepts */
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef enum
+{
+    FUZZ_MSG_NONE,                  /* Sent as sealed */
+    FUZZ_MSG_HEADER_BIT,            /* One bit of the header flipped */
+    FUZZ_MSG_PAYLOAD_BIT,           /* One bit of the payload flipped */
+    FUZZ_MSG_PAYLOAD_BURST,         /* Up to 16 consecutive payload bits flipped */
+    FUZZ_MSG_LENGTH,                /* Any length, also beyond the buffer */
+    FUZZ_MSG_CRC,                   /* Any CRC */
+    FUZZ_MSG_VERSION,               /* Any version */
+    FUZZ_MSG_SEQUENCE,              /* Any sequence: duplicate, reordered or ahead */
+    FUZZ_MSG_RANDOM,                /* Random header words */
+    FUZZ_MSG_KINDS,
+} fuzz_msg_kind_t;
+
+/* Typed message, to check the accessors of CY_IPC_MSG_DEFINE */
+CY_IPC_MSG_DEFINE(Fuzz, fuzz_msg_typed_t, uint32_t value; uint8_t bytes[6];)
+
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static uint64_t fuzzMsgState;
+static uint8_t *fuzzMsgEnd;         /* First byte of the guard page */
+static uint32_t fuzzMsgCount[FUZZ_MSG_KINDS];
+static uint32_t fuzzMsgRejected[FUZZ_MSG_KINDS];
+static char const *const fuzzMsgKindNames[] =
+{
+    "none", "header bit", "payload bit", "payload burst", "length", "crc", "version", "sequence", "random header"
+};
+
+
+/*******************************************************************************
+* Function Name: Fuzz_MsgRandom
+********************************************************************************
+* Summary:
+* Returns the next number of a xorshift64 generator, so a seed replays a run.
+*
+*******************************************************************************/
+static uint32_t Fuzz_MsgRandom(void)
+{
+    fuzzMsgState ^= fuzzMsgState << 13;
+    fuzzMsgState ^= fuzzMsgState >> 7;
+    fuzzMsgState ^= fuzzMsgState << 17;
+
+    return (uint32_t)(fuzzMsgState >> 16);
+}
+
+/*******************************************************************************
+* Function Name: Fuzz_MsgExpectSequence
+********************************************************************************
+* Summary:
+* Reference model of the receiver side of a stream.
+*
+*******************************************************************************/
+static cy_en_ipc_msg_status_t Fuzz_MsgExpectSequence(cy_stc_ipc_msg_rx_t *model, uint32_t sequence)
+{
+    uint32_t distance = (sequence - model->expected) & 0xFFFFUL;
+
+    if (model->synced && (distance >= 0x8000UL))
+    {
+        return CY_IPC_MSG_ERROR_STALE;
+    }
+    if (!model->synced)
+    {
+        distance = 0UL;
+    }
+    model->synced = true;
+    model->expected = (uint16_t)(sequence + 1UL);
+
+    return (0UL != distance) ? CY_IPC_MSG_GAP : CY_IPC_MSG_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: Fuzz_MsgExpect
+********************************************************************************
+* Summary:
+* Reference model of Cy_IPC_Msg_Check(). The CRC is computed bit by bit,
+* independently of the table of ipc_msg.c.
+*
+*******************************************************************************/
+static cy_en_ipc_msg_status_t Fuzz_MsgExpect(uint8_t const *msg, uint32_t maxLength, cy_stc_ipc_msg_rx_t *model)
+{
+    cy_stc_ipc_msg_hdr_t hdr;
+    uint16_t crc = 0xFFFFU;
+    uint32_t i;
+    uint32_t bit;
+
+    (void)memcpy(&hdr, msg, sizeof(hdr));
+    if (CY_IPC_MSG_VERSION != hdr.version)
+    {
+        return CY_IPC_MSG_ERROR_VERSION;
+    }
+    if (hdr.length > maxLength)
+    {
+        return CY_IPC_MSG_ERROR_LENGTH;
+    }
+    if (0U != (hdr.flags & CY_IPC_MSG_FLAG_CRC))
+    {
+        for (i = 0UL; i < hdr.length; i++)
+        {
+            crc ^= (uint16_t)((uint16_t)msg[CY_IPC_MSG_PAYLOAD_OFFSET + i] << 8);
+            for (bit = 0UL; bit < 8UL; bit++)
+            {
+                crc = (0U != (crc & 0x8000U)) ? (uint16_t)((crc << 1) ^ 0x1021U) : (uint16_t)(crc << 1);
+            }
+        }
+        if (crc != hdr.crc)
+        {
+            return CY_IPC_MSG_ERROR_CRC;
+        }
+    }
+    if (0U != (hdr.flags & CY_IPC_MSG_FLAG_SEQ))
+    {
+        return Fuzz_MsgExpectSequence(model, hdr.sequence);
+    }
+
+    return CY_IPC_MSG_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: Fuzz_MsgMutate
+********************************************************************************
+* Summary:
+* Applies one mutation to a sealed message.
+*
+*******************************************************************************/
+static void Fuzz_MsgMutate(uint8_t *msg, fuzz_msg_kind_t kind, uint32_t length)
+{
+    cy_stc_ipc_msg_hdr_t *hdr = (cy_stc_ipc_msg_hdr_t *)(void *)msg;
+    uint32_t bit;
+    uint32_t bits;
+    uint32_t i;
+
+    switch (kind)
+    {
+        case FUZZ_MSG_HEADER_BIT:
+            bit = Fuzz_MsgRandom() % (uint32_t)(sizeof(*hdr) * 8UL);
+            msg[bit / 8UL] ^= (uint8_t)(1U << (bit % 8UL));
+            break;
+
+        case FUZZ_MSG_PAYLOAD_BIT:
+            bit = Fuzz_MsgRandom() % (length * 8UL);
+            msg[CY_IPC_MSG_PAYLOAD_OFFSET + (bit / 8UL)] ^= (uint8_t)(1U << (bit % 8UL));
+            break;
+
+        case FUZZ_MSG_PAYLOAD_BURST:
+            bits = ((length * 8UL) < 16UL) ? (length * 8UL) : 16UL;
+            bits = 2UL + (Fuzz_MsgRandom() % (bits - 1UL));
+            bit = Fuzz_MsgRandom() % ((length * 8UL) - bits + 1UL);
+            /* First and last bit of the burst always flip */
+            for (i = 0UL; i < bits; i++)
+            {
+                if ((0UL == i) || ((bits - 1UL) == i) || (0UL != (Fuzz_MsgRandom() & 1UL)))
+                {
+                    msg[CY_IPC_MSG_PAYLOAD_OFFSET + ((bit + i) / 8UL)] ^= (uint8_t)(1U << ((bit + i) % 8UL));
+                }
+            }
+            break;
+
+        case FUZZ_MSG_LENGTH:
+            hdr->length = (uint16_t)Fuzz_MsgRandom();
+            break;
+
+        case FUZZ_MSG_CRC:
+            hdr->crc = (uint16_t)Fuzz_MsgRandom();
+            break;
+
+        case FUZZ_MSG_VERSION:
+            hdr->version = (uint8_t)Fuzz_MsgRandom();
+            break;
+
+        case FUZZ_MSG_SEQUENCE:
+            hdr->sequence = (uint16_t)Fuzz_MsgRandom();
+            break;
+
+        case FUZZ_MSG_RANDOM:
+            for (i = 0UL; i < sizeof(*hdr); i += 2UL)
+            {
+                if (0UL != (Fuzz_MsgRandom() & 1UL))
+                {
+                    msg[i] = (uint8_t)Fuzz_MsgRandom();
+                    msg[i + 1UL] = (uint8_t)Fuzz_MsgRandom();
+                }
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+/*******************************************************************************
+* Function Name: Fuzz_MsgOne
+********************************************************************************
+* Summary:
+* Seals a random message at the end of the readable memory, mutates it and
+* checks it against the model. The receiver accepts maxLength bytes of
+* payload, and the guard page follows right after them.
+*
+*******************************************************************************/
+static void Fuzz_MsgOne(cy_stc_ipc_msg_tx_t *tx, cy_stc_ipc_msg_rx_t *rx, cy_stc_ipc_msg_rx_t *model)
+{
+    uint32_t maxLength = 4UL * (1UL + (Fuzz_MsgRandom() % (FUZZ_MSG_MAX_LENGTH / 4UL)));
+    uint32_t length = 1UL + (Fuzz_MsgRandom() % maxLength);
+    uint8_t *msg = fuzzMsgEnd - (CY_IPC_MSG_PAYLOAD_OFFSET + maxLength);
+    fuzz_msg_kind_t kind = (fuzz_msg_kind_t)(Fuzz_MsgRandom() % (uint32_t)FUZZ_MSG_KINDS);
+    cy_stc_ipc_msg_rx_t before = *rx;
+    cy_en_ipc_msg_status_t expected;
+    cy_en_ipc_msg_status_t status;
+    uint32_t i;
+
+    Cy_IPC_Msg_InitHeader((cy_stc_ipc_msg_hdr_t *)(void *)msg, Fuzz_MsgRandom() & 0xFFUL, Fuzz_MsgRandom() & 0xFFUL,
+                          Fuzz_MsgRandom() & 0xFFFFUL, length);
+    for (i = 0UL; i < maxLength; i++)
+    {
+        msg[CY_IPC_MSG_PAYLOAD_OFFSET + i] = (uint8_t)Fuzz_MsgRandom();
+    }
+    Cy_IPC_Msg_Seal(msg, tx);
+    TEST_CHECK(CY_IPC_MSG_FLAG_CRC == (((cy_stc_ipc_msg_hdr_t *)(void *)msg)->flags & CY_IPC_MSG_FLAG_CRC));
+
+    Fuzz_MsgMutate(msg, kind, length);
+    expected = Fuzz_MsgExpect(msg, maxLength, model);
+    status = Cy_IPC_Msg_Check(msg, maxLength, rx);
+
+    fuzzMsgCount[kind]++;
+    if ((CY_IPC_MSG_SUCCESS != status) && (CY_IPC_MSG_GAP != status))
+    {
+        fuzzMsgRejected[kind]++;
+    }
+
+    if (expected != status)
+    {
+        (void)fprintf(stderr, "kind %u length %u max %u: status %u, expected %u\n", (unsigned)kind,
+                      (unsigned)length, (unsigned)maxLength, (unsigned)status, (unsigned)expected);
+        TEST_CHECK(expected == status);
+    }
+
+    if (FUZZ_MSG_NONE == kind)
+    {
+        TEST_CHECK(CY_IPC_MSG_SUCCESS == status);
+    }
+
+    /* CRC-16 catches every error of up to 16 bits in a row */
+    if ((FUZZ_MSG_PAYLOAD_BIT == kind) || (FUZZ_MSG_PAYLOAD_BURST == kind))
+    {
+        TEST_CHECK(CY_IPC_MSG_ERROR_CRC == status);
+    }
+
+    /* A rejected message leaves the stream alone */
+    if ((CY_IPC_MSG_SUCCESS != status) && (CY_IPC_MSG_GAP != status) && (CY_IPC_MSG_ERROR_STALE != status))
+    {
+        TEST_CHECK((before.expected == rx->expected) && (before.gaps == rx->gaps) && (before.stale == rx->stale));
+    }
+
+    /* The sender carries on where a mutated sequence moved the stream, so
+     * the next intact message is in order */
+    Cy_IPC_Msg_Sent(tx);
+    tx->next = model->expected;
+}
+
+/*******************************************************************************
+* Function Name: Fuzz_MsgTyped
+********************************************************************************
+* Summary:
+* Checks that the typed accessor only accepts its own version and length.
+*
+*******************************************************************************/
+static void Fuzz_MsgTyped(void)
+{
+    uint8_t *msg = fuzzMsgEnd - sizeof(fuzz_msg_typed_t);
+    cy_stc_ipc_msg_hdr_t *hdr = (cy_stc_ipc_msg_hdr_t *)(void *)msg;
+    uint32_t length;
+
+    Cy_IPC_Msg_InitFuzz((fuzz_msg_typed_t *)(void *)msg, 0UL, 0UL, 0UL);
+    TEST_CHECK((void const *)msg == (void const *)Cy_IPC_Msg_GetFuzz((uint32_t const *)(void const *)msg));
+
+    for (length = 0UL; length <= 0xFFFFUL; length++)
+    {
+        hdr->length = (uint16_t)length;
+        if ((NULL != Cy_IPC_Msg_GetFuzz((uint32_t const *)(void const *)msg)) !=
+            (sizeof(((fuzz_msg_typed_t *)0)->payload) == length))
+        {
+            TEST_CHECK(false);
+            break;
+        }
+    }
+
+    hdr->length = (uint16_t)sizeof(((fuzz_msg_typed_t *)0)->payload);
+    hdr->version = CY_IPC_MSG_VERSION + 1U;
+    TEST_CHECK(NULL == Cy_IPC_Msg_GetFuzz((uint32_t const *)(void const *)msg));
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* Maps the message memory in front of a guard page and runs the iterations.
+*
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+    uint32_t iterations = FUZZ_MSG_ITERATIONS;
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t size = ((CY_IPC_MSG_PAYLOAD_OFFSET + FUZZ_MSG_MAX_LENGTH + page - 1U) / page) * page;
+    cy_stc_ipc_msg_tx_t tx = { 0U };
+    cy_stc_ipc_msg_rx_t rx = { 0 };
+    cy_stc_ipc_msg_rx_t model = { 0 };
+    uint8_t *memory;
+    uint32_t i;
+
+    fuzzMsgState = FUZZ_MSG_SEED;
+    if (argc > 1)
+    {
+        iterations = (uint32_t)strtoul(argv[1], NULL, 0);
+    }
+    if (argc > 2)
+    {
+        fuzzMsgState = strtoull(argv[2], NULL, 0);
+    }
+    if (0U == fuzzMsgState)
+    {
+        fuzzMsgState = FUZZ_MSG_SEED;
+    }
+
+    memory = mmap(NULL, size + page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if ((MAP_FAILED == memory) || (0 != mprotect(memory + size, page, PROT_NONE)))
+    {
+        (void)fprintf(stderr, "no guard page\n");
+        return EXIT_FAILURE;
+    }
+    fuzzMsgEnd = memory + size;
+
+    Fuzz_MsgTyped();
+    for (i = 0UL; i < iterations; i++)
+    {
+        Fuzz_MsgOne(&tx, &rx, &model);
+    }
+
+    for (i = 0UL; i < (uint32_t)FUZZ_MSG_KINDS; i++)
+    {
+        (void)printf("%-14s %7u messages, %7u rejected\n", fuzzMsgKindNames[i], (unsigned)fuzzMsgCount[i],
+                     (unsigned)fuzzMsgRejected[i]);
+    }
+    (void)printf("stream: %u gaps, %u lost, %u stale\n", (unsigned)rx.gaps, (unsigned)rx.lost, (unsigned)rx.stale);
+
+    return Test_Result("fuzz_msg");
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,120 @@
+/******************************************************************************
+* File Name:   test.h
+*
+* Description: Helpers of the host tests in host/test. Each test is a plain
+*              program that runs the shared sources on Linux threads,
+*              prints one line per failed check and exits non-zero if any
+*              check failed.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef TEST_H
+#define TEST_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sched.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Records a failure and carries on, so one run reports every broken check */
+#define TEST_CHECK(cond) \
+    do { if (!(cond)) { Test_Fail(__FILE__, __LINE__, #cond); } } while (0)
+
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static uint32_t testFailures;
+
+
+/*******************************************************************************
+* Function Name: Test_Fail
+********************************************************************************
+* Summary:
+* Prints a failed check and counts it.
+*
+*******************************************************************************/
+static inline void Test_Fail(char const *file, int line, char const *expr)
+{
+    (void)fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expr);
+    testFailures++;
+}
+
+/*******************************************************************************
+* Function Name: Test_Yield
+********************************************************************************
+* Summary:
+* Lets the other thread run while a test thread waits for it, so the tests
+* also make progress on a single CPU.
+*
+*******************************************************************************/
+static inline void Test_Yield(void)
+{
+    (void)sched_yield();
+}
+
+/*******************************************************************************
+* Function Name: Test_Result
+********************************************************************************
+* Summary:
+* Prints the verdict of a test program.
+*
+* Return:
+*  Exit status of the program
+*
+*******************************************************************************/
+static inline int Test_Result(char const *name)
+{
+    (void)printf("%s: %s (%u failed checks)\n", name, (0UL == testFailures) ? "PASS" : "FAIL", (unsigned)testFailures);
+    return (0UL == testFailures) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* TEST_H */
+
+/* [] END OF FILE */
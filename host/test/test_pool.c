@@ -0,0 +1,502 @@
+/******************************************************************************
+* File Name:   test_pool.c
+*
+* Description: Test of the lock-free block pool of ipc_pool.c. Checks the
+*              parameter checks, exhaustion and the rejection of foreign
+*              pointers, replays the ABA interleaving of the free list
+*              step by step, then lets four threads allocate, fill, check
+*              and free blocks of a small pool concurrently. A block handed
+*              out twice shows up as a foreign pattern in it. Last, one
+*              allocating thread hands blocks to a second one that returns
+*              them through the remote free ring.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <pthread.h>
+#include <string.h>
+#include "ipc_pool.h"
+#include "test.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TEST_POOL_BLOCK_SIZE            (48UL)
+#define TEST_POOL_BLOCKS                (8UL)   /* Few blocks, so they are reused all the time */
+#define TEST_POOL_REMOTE_DEPTH          (8UL)
+#define TEST_POOL_THREADS               (4UL)
+#define TEST_POOL_HOLD                  (3UL)   /* Blocks a thread holds at once */
+#define TEST_POOL_ROUNDS                (1000000UL) /* Per thread, override with argv[1] */
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t id;                    /* Thread number, 1 .. TEST_POOL_THREADS */
+    uint32_t rounds;
+    bool useRemote;                 /* Hand every fourth block to the remote freeing thread */
+    uint32_t allocs;                /* Blocks allocated */
+    uint32_t empty;                 /* Allocations that found the pool empty */
+    uint32_t remote;                /* Blocks handed to the remote freeing thread */
+} test_pool_thread_t;
+
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static cy_stc_ipc_pool_t testPool;
+CY_ALIGN(IPC_PORT_CACHE_LINE) static uint8_t testPoolMem[CY_IPC_POOL_STORAGE_SIZE(TEST_POOL_BLOCK_SIZE, TEST_POOL_BLOCKS)];
+CY_ALIGN(IPC_PORT_CACHE_LINE) static uint32_t testPoolRemote[CY_IPC_RING_STORAGE_SIZE(sizeof(uint32_t), TEST_POOL_REMOTE_DEPTH) / sizeof(uint32_t)];
+
+/* Offset + 1 of the block on its way to the remote freeing thread, 0 if none */
+static cy_ipc_atomic32_t testPoolHandoff;
+static cy_ipc_atomic32_t testPoolDone;
+
+
+/*******************************************************************************
+* Function Name: Test_PoolConfig
+********************************************************************************
+* Summary:
+* Returns the configuration of the test pool.
+*
+*******************************************************************************/
+static cy_stc_ipc_pool_config_t Test_PoolConfig(bool remote)
+{
+    cy_stc_ipc_pool_config_t config =
+    {
+        .storage = testPoolMem,
+        .blockSize = TEST_POOL_BLOCK_SIZE,
+        .blockCount = TEST_POOL_BLOCKS,
+        .remoteBuf = remote ? testPoolRemote : NULL,
+        .remoteDepth = TEST_POOL_REMOTE_DEPTH,
+    };
+
+    return config;
+}
+
+/*******************************************************************************
+* Function Name: Test_PoolFill
+********************************************************************************
+* Summary:
+* Writes the pattern of owner into a whole block.
+*
+*******************************************************************************/
+static void Test_PoolFill(void *block, uint32_t owner)
+{
+    uint32_t *word = (uint32_t *)block;
+    uint32_t i;
+
+    for (i = 0UL; i < (TEST_POOL_BLOCK_SIZE / sizeof(uint32_t)); i++)
+    {
+        word[i] = (owner << 24) ^ i;
+    }
+}
+
+/*******************************************************************************
+* Function Name: Test_PoolHolds
+********************************************************************************
+* Summary:
+* Checks that a block still holds the pattern of owner.
+*
+*******************************************************************************/
+static bool Test_PoolHolds(void const *block, uint32_t owner)
+{
+    uint32_t const *word = (uint32_t const *)block;
+    uint32_t i;
+
+    for (i = 0UL; i < (TEST_POOL_BLOCK_SIZE / sizeof(uint32_t)); i++)
+    {
+        if (word[i] != ((owner << 24) ^ i))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: Test_PoolParams
+********************************************************************************
+* Summary:
+* Checks the parameter checks, exhaustion and foreign pointers.
+*
+*******************************************************************************/
+static void Test_PoolParams(void)
+{
+    cy_stc_ipc_pool_config_t config;
+    cy_stc_ipc_pool_stats_t stats;
+    void *block[TEST_POOL_BLOCKS];
+    uint32_t i;
+    uint32_t j;
+
+    config = Test_PoolConfig(false);
+    TEST_CHECK(CY_IPC_POOL_ERROR_BAD_PARAM == Cy_IPC_Pool_Init(NULL, &config));
+    TEST_CHECK(CY_IPC_POOL_ERROR_BAD_PARAM == Cy_IPC_Pool_Init(&testPool, NULL));
+    config.storage = &testPoolMem[4];
+    TEST_CHECK(CY_IPC_POOL_ERROR_BAD_PARAM == Cy_IPC_Pool_Init(&testPool, &config));
+    config = Test_PoolConfig(false);
+    config.blockSize = 2UL;
+    TEST_CHECK(CY_IPC_POOL_ERROR_BAD_PARAM == Cy_IPC_Pool_Init(&testPool, &config));
+    config = Test_PoolConfig(false);
+    config.blockCount = 0UL;
+    TEST_CHECK(CY_IPC_POOL_ERROR_BAD_PARAM == Cy_IPC_Pool_Init(&testPool, &config));
+    config.blockCount = CY_IPC_POOL_MAX_BLOCKS + 1UL;
+    TEST_CHECK(CY_IPC_POOL_ERROR_BAD_PARAM == Cy_IPC_Pool_Init(&testPool, &config));
+    config = Test_PoolConfig(true);
+    config.remoteDepth = TEST_POOL_BLOCKS / 2UL;
+    TEST_CHECK(CY_IPC_POOL_ERROR_BAD_PARAM == Cy_IPC_Pool_Init(&testPool, &config));
+    config = Test_PoolConfig(true);
+    config.remoteBuf = &testPoolRemote[1];
+    TEST_CHECK(CY_IPC_POOL_ERROR_BAD_PARAM == Cy_IPC_Pool_Init(&testPool, &config));
+
+    config = Test_PoolConfig(false);
+    TEST_CHECK(CY_IPC_POOL_SUCCESS == Cy_IPC_Pool_Init(&testPool, &config));
+    TEST_CHECK(CY_IPC_POOL_ERROR_BAD_PARAM == Cy_IPC_Pool_FreeRemote(&testPool, testPoolMem));
+
+    /* Every block once, line aligned and inside the storage */
+    for (i = 0UL; i < TEST_POOL_BLOCKS; i++)
+    {
+        block[i] = Cy_IPC_Pool_Alloc(&testPool);
+        TEST_CHECK(NULL != block[i]);
+        TEST_CHECK(0UL == ((uintptr_t)block[i] & (IPC_PORT_CACHE_LINE - 1UL)));
+        TEST_CHECK(((uint8_t *)block[i] >= testPoolMem) &&
+                   ((uint8_t *)block[i] + TEST_POOL_BLOCK_SIZE <= &testPoolMem[sizeof(testPoolMem)]));
+        for (j = 0UL; j < i; j++)
+        {
+            TEST_CHECK(block[i] != block[j]);
+        }
+    }
+    TEST_CHECK(NULL == Cy_IPC_Pool_Alloc(&testPool));
+
+    Cy_IPC_Pool_GetStats(&testPool, &stats);
+    TEST_CHECK(TEST_POOL_BLOCKS == stats.inUse);
+    TEST_CHECK(TEST_POOL_BLOCKS == stats.highWater);
+    TEST_CHECK(1UL == stats.allocFail);
+
+    /* Pointers that are not the start of a block of this pool */
+    TEST_CHECK(CY_IPC_POOL_ERROR_BAD_PARAM == Cy_IPC_Pool_Free(&testPool, (uint8_t *)block[0] + 4));
+    TEST_CHECK(CY_IPC_POOL_ERROR_BAD_PARAM == Cy_IPC_Pool_Free(&testPool, testPoolRemote));
+    TEST_CHECK(CY_IPC_POOL_ERROR_BAD_PARAM == Cy_IPC_Pool_Free(&testPool, &testPoolMem[sizeof(testPoolMem)]));
+
+    for (i = 0UL; i < TEST_POOL_BLOCKS; i++)
+    {
+        TEST_CHECK(CY_IPC_POOL_SUCCESS == Cy_IPC_Pool_Free(&testPool, block[i]));
+    }
+    Cy_IPC_Pool_GetStats(&testPool, &stats);
+    TEST_CHECK(0UL == stats.inUse);
+}
+
+/*******************************************************************************
+* Function Name: Test_PoolAba
+********************************************************************************
+* Summary:
+* Replays the ABA interleaving on one thread. An allocator reads the head,
+* block A with link B, and stalls. Meanwhile A and B are allocated and A is
+* freed again, so the head is A once more but B is in use. The exchange of
+* the stalled allocator must fail, or B would be handed out twice.
+*
+*******************************************************************************/
+static void Test_PoolAba(void)
+{
+    cy_stc_ipc_pool_config_t config = Test_PoolConfig(false);
+    uint32_t stalledHead;
+    uint32_t stalledNext;
+    uint32_t expected;
+    void *a;
+    void *b;
+
+    TEST_CHECK(CY_IPC_POOL_SUCCESS == Cy_IPC_Pool_Init(&testPool, &config));
+
+    /* The stalled allocator: head A, the link of A is B */
+    stalledHead = IPC_PORT_LOAD_ACQUIRE(&testPool.freeHead);
+    stalledNext = *(uint32_t const *)(void const *)testPoolMem;
+    TEST_CHECK(0UL == (stalledHead & 0xFFFFUL));
+    TEST_CHECK(1UL == stalledNext);
+
+    a = Cy_IPC_Pool_Alloc(&testPool);
+    b = Cy_IPC_Pool_Alloc(&testPool);
+    TEST_CHECK((void *)testPoolMem == a);
+    TEST_CHECK(CY_IPC_POOL_SUCCESS == Cy_IPC_Pool_Free(&testPool, a));
+
+    /* Same first block, different word */
+    TEST_CHECK((stalledHead & 0xFFFFUL) == (IPC_PORT_LOAD_RELAXED(&testPool.freeHead) & 0xFFFFUL));
+    expected = stalledHead;
+    TEST_CHECK(!atomic_compare_exchange_strong(&testPool.freeHead, &expected,
+                                               (stalledHead & 0xFFFF0000UL) + 0x10000UL + stalledNext));
+
+    /* And B is not on the free list */
+    a = Cy_IPC_Pool_Alloc(&testPool);
+    TEST_CHECK((void *)testPoolMem == a);
+    TEST_CHECK(b != Cy_IPC_Pool_Alloc(&testPool));
+}
+
+/*******************************************************************************
+* Function Name: Test_PoolWorker
+********************************************************************************
+* Summary:
+* Holds up to TEST_POOL_HOLD blocks, each filled with the pattern of this
+* thread, and checks the pattern before freeing the block. With the remote
+* free ring, every fourth block goes back through the remote freeing thread
+* instead.
+*
+*******************************************************************************/
+static void *Test_PoolWorker(void *arg)
+{
+    test_pool_thread_t *thread = (test_pool_thread_t *)arg;
+    void *held[TEST_POOL_HOLD] = { NULL };
+    uint32_t round;
+    uint32_t slot;
+    void *block;
+
+    for (round = 0UL; round < thread->rounds; round++)
+    {
+        slot = round % TEST_POOL_HOLD;
+
+        if (NULL != held[slot])
+        {
+            if (!Test_PoolHolds(held[slot], thread->id))
+            {
+                (void)fprintf(stderr, "thread %u round %u: block %p changed while held\n",
+                              (unsigned)thread->id, (unsigned)round, held[slot]);
+                TEST_CHECK(Test_PoolHolds(held[slot], thread->id));
+                break;
+            }
+
+            if (thread->useRemote && (0UL == (round & 3UL)) &&
+                (0UL == IPC_PORT_LOAD_ACQUIRE(&testPoolHandoff)))
+            {
+                IPC_PORT_STORE_RELEASE(&testPoolHandoff, (uint32_t)((uint8_t *)held[slot] - testPoolMem) + 1UL);
+                thread->remote++;
+            }
+            else
+            {
+                TEST_CHECK(CY_IPC_POOL_SUCCESS == Cy_IPC_Pool_Free(&testPool, held[slot]));
+            }
+            held[slot] = NULL;
+        }
+
+        block = Cy_IPC_Pool_Alloc(&testPool);
+        if (NULL == block)
+        {
+            thread->empty++;
+            Test_Yield();
+            continue;
+        }
+        Test_PoolFill(block, thread->id);
+        held[slot] = block;
+        thread->allocs++;
+
+        if (0UL == (round & 15UL))
+        {
+            Test_Yield();
+        }
+    }
+
+    for (slot = 0UL; slot < TEST_POOL_HOLD; slot++)
+    {
+        if (NULL != held[slot])
+        {
+            TEST_CHECK(CY_IPC_POOL_SUCCESS == Cy_IPC_Pool_Free(&testPool, held[slot]));
+        }
+    }
+
+    return NULL;
+}
+
+/*******************************************************************************
+* Function Name: Test_PoolRemote
+********************************************************************************
+* Summary:
+* The core without exclusive access: returns the handed-over blocks through
+* the remote free ring.
+*
+*******************************************************************************/
+static void *Test_PoolRemote(void *arg)
+{
+    uint32_t *freed = (uint32_t *)arg;
+    uint32_t offset;
+    bool done;
+
+    do
+    {
+        done = (0UL != IPC_PORT_LOAD_ACQUIRE(&testPoolDone));
+        offset = IPC_PORT_LOAD_ACQUIRE(&testPoolHandoff);
+        if (0UL != offset)
+        {
+            while (CY_IPC_POOL_SUCCESS != Cy_IPC_Pool_FreeRemote(&testPool, &testPoolMem[offset - 1UL]))
+            {
+                Test_Yield();
+            }
+            IPC_PORT_STORE_RELEASE(&testPoolHandoff, 0UL);
+            (*freed)++;
+        }
+        Test_Yield();
+    } while (!done);
+
+    return NULL;
+}
+
+/*******************************************************************************
+* Function Name: Test_PoolCheckAll
+********************************************************************************
+* Summary:
+* Checks that every block came back to the free list exactly once.
+*
+*******************************************************************************/
+static void Test_PoolCheckAll(void)
+{
+    cy_stc_ipc_pool_stats_t stats;
+    void *block[TEST_POOL_BLOCKS];
+    uint32_t i;
+    uint32_t j;
+
+    (void)Cy_IPC_Pool_Reclaim(&testPool);
+    Cy_IPC_Pool_GetStats(&testPool, &stats);
+    TEST_CHECK(0UL == stats.inUse);
+    TEST_CHECK(stats.highWater <= TEST_POOL_BLOCKS);
+    for (i = 0UL; i < TEST_POOL_BLOCKS; i++)
+    {
+        block[i] = Cy_IPC_Pool_Alloc(&testPool);
+        TEST_CHECK(NULL != block[i]);
+        for (j = 0UL; j < i; j++)
+        {
+            TEST_CHECK(block[i] != block[j]);
+        }
+    }
+    TEST_CHECK(NULL == Cy_IPC_Pool_Alloc(&testPool));
+}
+
+/*******************************************************************************
+* Function Name: Test_PoolStress
+********************************************************************************
+* Summary:
+* Runs TEST_POOL_THREADS allocating threads on one pool. They hold more
+* blocks together than the pool has, so it runs empty and every block is
+* reused all the time, which is where an ABA on the free list hands a
+* block out twice.
+*
+*******************************************************************************/
+static void Test_PoolStress(uint32_t rounds)
+{
+    cy_stc_ipc_pool_config_t config = Test_PoolConfig(false);
+    test_pool_thread_t thread[TEST_POOL_THREADS];
+    pthread_t worker[TEST_POOL_THREADS];
+    uint32_t allocs = 0UL;
+    uint32_t empty = 0UL;
+    uint32_t i;
+
+    TEST_CHECK(CY_IPC_POOL_SUCCESS == Cy_IPC_Pool_Init(&testPool, &config));
+
+    for (i = 0UL; i < TEST_POOL_THREADS; i++)
+    {
+        thread[i] = (test_pool_thread_t){ .id = i + 1UL, .rounds = rounds };
+        TEST_CHECK(0 == pthread_create(&worker[i], NULL, Test_PoolWorker, &thread[i]));
+    }
+    for (i = 0UL; i < TEST_POOL_THREADS; i++)
+    {
+        (void)pthread_join(worker[i], NULL);
+        allocs += thread[i].allocs;
+        empty += thread[i].empty;
+    }
+
+    TEST_CHECK(empty > 0UL);
+    Test_PoolCheckAll();
+
+    (void)printf("%u threads: %u allocations, %u found the pool empty\n",
+                 (unsigned)TEST_POOL_THREADS, (unsigned)allocs, (unsigned)empty);
+}
+
+/*******************************************************************************
+* Function Name: Test_PoolRemoteStress
+********************************************************************************
+* Summary:
+* Runs one allocating thread, the only consumer of the remote free ring,
+* against the remote freeing thread.
+*
+*******************************************************************************/
+static void Test_PoolRemoteStress(uint32_t rounds)
+{
+    cy_stc_ipc_pool_config_t config = Test_PoolConfig(true);
+    test_pool_thread_t thread = { .id = 1UL, .rounds = rounds, .useRemote = true };
+    pthread_t worker;
+    pthread_t remote;
+    uint32_t freed = 0UL;
+
+    TEST_CHECK(CY_IPC_POOL_SUCCESS == Cy_IPC_Pool_Init(&testPool, &config));
+
+    TEST_CHECK(0 == pthread_create(&remote, NULL, Test_PoolRemote, &freed));
+    TEST_CHECK(0 == pthread_create(&worker, NULL, Test_PoolWorker, &thread));
+    (void)pthread_join(worker, NULL);
+    IPC_PORT_STORE_RELEASE(&testPoolDone, 1UL);
+    (void)pthread_join(remote, NULL);
+
+    TEST_CHECK(thread.remote == freed);
+    TEST_CHECK(freed > 0UL);
+    Test_PoolCheckAll();
+
+    (void)printf("remote free: %u allocations, %u found the pool empty, %u freed remotely\n",
+                 (unsigned)thread.allocs, (unsigned)thread.empty, (unsigned)freed);
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* Runs the checks. argv[1] overrides the rounds per thread.
+*
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+    uint32_t rounds = TEST_POOL_ROUNDS;
+
+    if (argc > 1)
+    {
+        rounds = (uint32_t)strtoul(argv[1], NULL, 0);
+    }
+
+    Test_PoolParams();
+    Test_PoolAba();
+    Test_PoolStress(rounds);
+    Test_PoolRemoteStress(rounds);
+
+    return Test_Result("test_pool");
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,287 @@
+/******************************************************************************
+* File Name:   test_ring.c
+*
+* Description: Two-thread stress test of the SPSC ring of ipc_ring.c. A
+*              producer thread pushes numbered elements as fast as the
+*              ring takes them while a consumer thread pops them, with
+*              Pop and Peek alternating, and checks that every element
+*              arrives once, in order and intact. Also checks the
+*              parameter checks of Cy_IPC_Ring_Init and that the ring
+*              never writes past its elements into the padding.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <pthread.h>
+#include <string.h>
+#include "ipc_ring.h"
+#include "test.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TEST_RING_MAX_DEPTH             (64UL)
+#define TEST_RING_PAD                   (0xA5U) /* Fill of the storage behind the elements */
+#define TEST_RING_COUNT                 (1000000UL) /* Elements per depth, override with argv[1] */
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+/* 12 bytes, so the slots do not fall on line boundaries */
+typedef struct
+{
+    uint32_t seq;
+    uint32_t inverse;               /* ~seq */
+    uint32_t mix;                   /* seq * golden ratio, catches a half-written slot */
+} test_ring_elem_t;
+
+typedef struct
+{
+    cy_stc_ipc_ring_t *ring;
+    uint32_t count;
+    uint32_t fullSpins;             /* Pushes refused because the ring was full */
+    uint32_t emptySpins;            /* Pops refused because the ring was empty */
+    uint32_t maxCount;              /* Highest Cy_IPC_Ring_Count seen by the consumer */
+} test_ring_run_t;
+
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static cy_stc_ipc_ring_t testRing;
+CY_ALIGN(IPC_PORT_CACHE_LINE) static uint8_t testRingBuf[CY_IPC_RING_STORAGE_SIZE(sizeof(test_ring_elem_t), TEST_RING_MAX_DEPTH)];
+static const uint32_t testRingDepths[] = { 1UL, 2UL, 8UL, TEST_RING_MAX_DEPTH };
+
+
+/*******************************************************************************
+* Function Name: Test_RingElem
+********************************************************************************
+* Summary:
+* Builds the element with sequence number seq.
+*
+*******************************************************************************/
+static test_ring_elem_t Test_RingElem(uint32_t seq)
+{
+    test_ring_elem_t elem = { seq, ~seq, (uint32_t)(seq * 2654435761UL) };
+
+    return elem;
+}
+
+/*******************************************************************************
+* Function Name: Test_RingProducer
+********************************************************************************
+* Summary:
+* Pushes run->count numbered elements.
+*
+*******************************************************************************/
+static void *Test_RingProducer(void *arg)
+{
+    test_ring_run_t *run = (test_ring_run_t *)arg;
+    test_ring_elem_t elem;
+    uint32_t seq;
+
+    for (seq = 0UL; seq < run->count; seq++)
+    {
+        elem = Test_RingElem(seq);
+        while (CY_IPC_RING_SUCCESS != Cy_IPC_Ring_Push(run->ring, &elem))
+        {
+            run->fullSpins++;
+            Test_Yield();
+        }
+    }
+
+    return NULL;
+}
+
+/*******************************************************************************
+* Function Name: Test_RingConsumer
+********************************************************************************
+* Summary:
+* Takes run->count elements, every other one in place with Peek, and checks
+* their order and content.
+*
+*******************************************************************************/
+static void *Test_RingConsumer(void *arg)
+{
+    test_ring_run_t *run = (test_ring_run_t *)arg;
+    test_ring_elem_t expected;
+    test_ring_elem_t elem;
+    const void *slot;
+    uint32_t pending;
+    uint32_t seq;
+
+    for (seq = 0UL; seq < run->count; seq++)
+    {
+        expected = Test_RingElem(seq);
+
+        if (0UL != (seq & 1UL))
+        {
+            while (NULL == (slot = Cy_IPC_Ring_Peek(run->ring)))
+            {
+                run->emptySpins++;
+                Test_Yield();
+            }
+            (void)memcpy(&elem, slot, sizeof(elem));
+            TEST_CHECK(CY_IPC_RING_SUCCESS == Cy_IPC_Ring_Pop(run->ring, NULL));
+        }
+        else
+        {
+            while (CY_IPC_RING_SUCCESS != Cy_IPC_Ring_Pop(run->ring, &elem))
+            {
+                run->emptySpins++;
+                Test_Yield();
+            }
+        }
+
+        if (0 != memcmp(&elem, &expected, sizeof(elem)))
+        {
+            (void)fprintf(stderr, "element %u: got seq %u inverse %08x mix %08x\n",
+                          (unsigned)seq, (unsigned)elem.seq, (unsigned)elem.inverse, (unsigned)elem.mix);
+            TEST_CHECK(0 == memcmp(&elem, &expected, sizeof(elem)));
+            break;
+        }
+
+        pending = Cy_IPC_Ring_Count(run->ring);
+        if (pending > run->maxCount)
+        {
+            run->maxCount = pending;
+        }
+    }
+
+    return NULL;
+}
+
+/*******************************************************************************
+* Function Name: Test_RingInit
+********************************************************************************
+* Summary:
+* Checks the parameter checks of Cy_IPC_Ring_Init.
+*
+*******************************************************************************/
+static void Test_RingInit(void)
+{
+    test_ring_elem_t elem = Test_RingElem(0UL);
+
+    TEST_CHECK(CY_IPC_RING_ERROR_BAD_PARAM == Cy_IPC_Ring_Init(NULL, testRingBuf, sizeof(elem), 4UL));
+    TEST_CHECK(CY_IPC_RING_ERROR_BAD_PARAM == Cy_IPC_Ring_Init(&testRing, NULL, sizeof(elem), 4UL));
+    TEST_CHECK(CY_IPC_RING_ERROR_BAD_PARAM == Cy_IPC_Ring_Init(&testRing, &testRingBuf[4], sizeof(elem), 4UL));
+    TEST_CHECK(CY_IPC_RING_ERROR_BAD_PARAM == Cy_IPC_Ring_Init(&testRing, testRingBuf, 0UL, 4UL));
+    TEST_CHECK(CY_IPC_RING_ERROR_BAD_PARAM == Cy_IPC_Ring_Init(&testRing, testRingBuf, sizeof(elem), 0UL));
+    TEST_CHECK(CY_IPC_RING_ERROR_BAD_PARAM == Cy_IPC_Ring_Init(&testRing, testRingBuf, sizeof(elem), 6UL));
+
+    TEST_CHECK(CY_IPC_RING_SUCCESS == Cy_IPC_Ring_Init(&testRing, testRingBuf, sizeof(elem), 4UL));
+    TEST_CHECK(CY_IPC_RING_ERROR_EMPTY == Cy_IPC_Ring_Pop(&testRing, NULL));
+    TEST_CHECK(NULL == Cy_IPC_Ring_Peek(&testRing));
+    TEST_CHECK(CY_IPC_RING_SUCCESS == Cy_IPC_Ring_Push(&testRing, &elem));
+    TEST_CHECK(CY_IPC_RING_SUCCESS == Cy_IPC_Ring_Push(&testRing, &elem));
+    TEST_CHECK(CY_IPC_RING_SUCCESS == Cy_IPC_Ring_Push(&testRing, &elem));
+    TEST_CHECK(CY_IPC_RING_SUCCESS == Cy_IPC_Ring_Push(&testRing, &elem));
+    TEST_CHECK(CY_IPC_RING_ERROR_FULL == Cy_IPC_Ring_Push(&testRing, &elem));
+    TEST_CHECK(4UL == Cy_IPC_Ring_Count(&testRing));
+
+    /* Padded to whole lines, also for element sizes that do not divide one */
+    TEST_CHECK(0UL == (CY_IPC_RING_STORAGE_SIZE(12UL, 3UL) % IPC_PORT_CACHE_LINE));
+    TEST_CHECK(CY_IPC_RING_STORAGE_SIZE(12UL, 3UL) >= 36UL);
+    TEST_CHECK(IPC_PORT_CACHE_LINE == CY_IPC_RING_STORAGE_SIZE(1UL, IPC_PORT_CACHE_LINE));
+}
+
+/*******************************************************************************
+* Function Name: Test_RingStress
+********************************************************************************
+* Summary:
+* Runs one producer and one consumer thread over a ring of the given depth.
+*
+*******************************************************************************/
+static void Test_RingStress(uint32_t depth, uint32_t count)
+{
+    test_ring_run_t run = { &testRing, count, 0UL, 0UL, 0UL };
+    uint32_t used = depth * (uint32_t)sizeof(test_ring_elem_t);
+    pthread_t producer;
+    pthread_t consumer;
+    uint32_t i;
+
+    (void)memset(testRingBuf, TEST_RING_PAD, sizeof(testRingBuf));
+    TEST_CHECK(CY_IPC_RING_SUCCESS == Cy_IPC_Ring_Init(&testRing, testRingBuf, sizeof(test_ring_elem_t), depth));
+
+    TEST_CHECK(0 == pthread_create(&consumer, NULL, Test_RingConsumer, &run));
+    TEST_CHECK(0 == pthread_create(&producer, NULL, Test_RingProducer, &run));
+    (void)pthread_join(producer, NULL);
+    (void)pthread_join(consumer, NULL);
+
+    TEST_CHECK(0UL == Cy_IPC_Ring_Count(&testRing));
+    TEST_CHECK(run.maxCount <= depth);
+    for (i = used; i < sizeof(testRingBuf); i++)
+    {
+        if (TEST_RING_PAD != testRingBuf[i])
+        {
+            TEST_CHECK(TEST_RING_PAD == testRingBuf[i]);
+            break;
+        }
+    }
+
+    (void)printf("depth %2u: %u elements, %u full, %u empty, max pending %u\n", (unsigned)depth,
+                 (unsigned)count, (unsigned)run.fullSpins, (unsigned)run.emptySpins, (unsigned)run.maxCount);
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* Runs the checks. argv[1] overrides the number of elements per depth.
+*
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+    uint32_t count = TEST_RING_COUNT;
+    uint32_t i;
+
+    if (argc > 1)
+    {
+        count = (uint32_t)strtoul(argv[1], NULL, 0);
+    }
+
+    Test_RingInit();
+    for (i = 0UL; i < (sizeof(testRingDepths) / sizeof(testRingDepths[0])); i++)
+    {
+        Test_RingStress(testRingDepths[i], count);
+    }
+
+    return Test_Result("test_ring");
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,727 @@
+/******************************************************************************
+* File Name:   test_rpc.c
+*
+* Description: Loopback test of the RPC layer of ipc_rpc.c, requests and
+*              responses carried in two rings as between CM7_0 and CM0+.
+*              Covers polled and callback completion, responses in reverse
+*              order, a full window, unknown methods, cancel before and
+*              after the response, stale responses to a reused slot, and
+*              the wrap of the 16-bit IDs, then races a server thread that
+*              answers out of order and a completing thread against a
+*              caller that cancels at random.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <pthread.h>
+#include <time.h>
+#include "ipc_rpc.h"
+#include "ipc_ring.h"
+#include "test.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TEST_RPC_HASH                   (2654435761UL)  /* Result of method 0: its argument times this */
+#define TEST_RPC_ID_SLOT_Msk            (CY_IPC_RPC_MAX_PENDING - 1UL)
+#define TEST_RPC_IDS                    (0x10000UL)     /* Request IDs are 16 bits */
+#define TEST_RPC_RACE_CALLS             (200000UL)      /* Override with argv[1] */
+#define TEST_RPC_STALL_S                (2)             /* No call finished for this long: a response was lost */
+
+/* Race: what became of each request ID */
+#define TEST_RPC_FATE_OPEN              (0UL)
+#define TEST_RPC_FATE_DONE              (1UL)
+#define TEST_RPC_FATE_CANCELLED         (2UL)
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t id;
+    bool poll;                      /* Completed by Cy_IPC_Rpc_Poll(), not a callback */
+} test_rpc_call_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static cy_en_ipc_rpc_status_t Test_RpcHash(uint32_t arg, uint32_t *result);
+
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static const cy_ipc_rpc_method_t testRpcMethods[] = { &Test_RpcHash, NULL };
+static const cy_stc_ipc_rpc_server_t testRpcServer =
+{
+    testRpcMethods,
+    sizeof(testRpcMethods) / sizeof(testRpcMethods[0]),
+    0UL,
+    0UL,
+    0UL
+};
+
+static cy_stc_ipc_rpc_client_t testRpc;
+static cy_stc_ipc_ring_t testRpcRequestRing;
+static cy_stc_ipc_ring_t testRpcResponseRing;
+CY_ALIGN(IPC_PORT_CACHE_LINE) static uint8_t testRpcRequestBuf[CY_IPC_RING_STORAGE_SIZE(sizeof(cy_stc_ipc_rpc_msg_t), CY_IPC_RPC_MAX_PENDING)];
+CY_ALIGN(IPC_PORT_CACHE_LINE) static uint8_t testRpcResponseBuf[CY_IPC_RING_STORAGE_SIZE(sizeof(cy_stc_ipc_rpc_msg_t), CY_IPC_RPC_MAX_PENDING)];
+
+/* Completion callbacks, in the order they ran */
+static uint32_t testRpcDoneId[CY_IPC_RPC_MAX_PENDING];
+static uint32_t testRpcDoneResult[CY_IPC_RPC_MAX_PENDING];
+static uint32_t testRpcDoneCount;
+
+/* Race: argument and fate of every request ID */
+static uint32_t testRpcArg[TEST_RPC_IDS];
+static cy_ipc_atomic32_t testRpcFate[TEST_RPC_IDS];
+static cy_ipc_atomic32_t testRpcStop;
+static uint32_t testRpcCallbacks;   /* Written by the completing thread */
+static uint32_t testRpcStale;       /* Written by the completing thread */
+
+
+/*******************************************************************************
+* Function Name: Test_RpcHash
+********************************************************************************
+* Summary:
+* Method 0 of the server.
+*
+*******************************************************************************/
+static cy_en_ipc_rpc_status_t Test_RpcHash(uint32_t arg, uint32_t *result)
+{
+    *result = (uint32_t)(arg * TEST_RPC_HASH);
+
+    return CY_IPC_RPC_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: Test_RpcRandom
+********************************************************************************
+* Summary:
+* Returns the next number of a xorshift32 generator.
+*
+*******************************************************************************/
+static uint32_t Test_RpcRandom(uint32_t *state)
+{
+    uint32_t x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+
+    return x;
+}
+
+/*******************************************************************************
+* Function Name: Test_RpcInit
+********************************************************************************
+* Summary:
+* Empties both rings and frees every slot.
+*
+*******************************************************************************/
+static void Test_RpcInit(void)
+{
+    TEST_CHECK(CY_IPC_RING_SUCCESS == Cy_IPC_Ring_Init(&testRpcRequestRing, testRpcRequestBuf,
+                                                       sizeof(cy_stc_ipc_rpc_msg_t), CY_IPC_RPC_MAX_PENDING));
+    TEST_CHECK(CY_IPC_RING_SUCCESS == Cy_IPC_Ring_Init(&testRpcResponseRing, testRpcResponseBuf,
+                                                       sizeof(cy_stc_ipc_rpc_msg_t), CY_IPC_RPC_MAX_PENDING));
+    Cy_IPC_Rpc_InitClient(&testRpc, 0UL, 0UL, 0UL);
+    testRpcDoneCount = 0UL;
+}
+
+/*******************************************************************************
+* Function Name: Test_RpcCall
+********************************************************************************
+* Summary:
+* Prepares a call and queues its request, as Pipe2_cm7_0_Call(). Returns
+* the status of Cy_IPC_Rpc_Prepare().
+*
+*******************************************************************************/
+static cy_en_ipc_rpc_status_t Test_RpcCall(uint32_t method, uint32_t arg, cy_ipc_rpc_callback_t callback, uint32_t *id)
+{
+    cy_stc_ipc_rpc_msg_t request;
+    cy_en_ipc_rpc_status_t status;
+
+    status = Cy_IPC_Rpc_Prepare(&testRpc, method, arg, callback, NULL, &request, id);
+    if (CY_IPC_RPC_SUCCESS == status)
+    {
+        TEST_CHECK(CY_IPC_RING_SUCCESS == Cy_IPC_Ring_Push(&testRpcRequestRing, &request));
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: Test_RpcServe
+********************************************************************************
+* Summary:
+* The serving core: takes every queued request and pushes the responses,
+* last request first.
+*
+*******************************************************************************/
+static void Test_RpcServe(void)
+{
+    cy_stc_ipc_rpc_msg_t request[CY_IPC_RPC_MAX_PENDING];
+    cy_stc_ipc_rpc_msg_t response;
+    uint32_t count = 0UL;
+
+    while ((count < CY_IPC_RPC_MAX_PENDING) &&
+           (CY_IPC_RING_SUCCESS == Cy_IPC_Ring_Pop(&testRpcRequestRing, &request[count])))
+    {
+        count++;
+    }
+    while (0UL != count)
+    {
+        count--;
+        Cy_IPC_Rpc_Serve(&testRpcServer, &request[count], &response);
+        TEST_CHECK(CY_IPC_RING_SUCCESS == Cy_IPC_Ring_Push(&testRpcResponseRing, &response));
+    }
+}
+
+/*******************************************************************************
+* Function Name: Test_RpcDeliver
+********************************************************************************
+* Summary:
+* The response interrupt of the caller: completes every queued response.
+* Returns the number of responses rejected as unknown.
+*
+*******************************************************************************/
+static uint32_t Test_RpcDeliver(void)
+{
+    cy_stc_ipc_rpc_msg_t response;
+    cy_en_ipc_rpc_status_t status;
+    uint32_t unknown = 0UL;
+
+    while (CY_IPC_RING_SUCCESS == Cy_IPC_Ring_Pop(&testRpcResponseRing, &response))
+    {
+        status = Cy_IPC_Rpc_Complete(&testRpc, &response);
+        if (CY_IPC_RPC_ERROR_UNKNOWN_ID == status)
+        {
+            unknown++;
+        }
+        else
+        {
+            TEST_CHECK(CY_IPC_RPC_SUCCESS == status);
+        }
+    }
+
+    return unknown;
+}
+
+/*******************************************************************************
+* Function Name: Test_RpcDone
+********************************************************************************
+* Summary:
+* Completion callback: records the call.
+*
+*******************************************************************************/
+static void Test_RpcDone(uint32_t id, cy_en_ipc_rpc_status_t status, uint32_t result, void *context)
+{
+    (void)context;
+    TEST_CHECK(CY_IPC_RPC_SUCCESS == status);
+    if (testRpcDoneCount < CY_IPC_RPC_MAX_PENDING)
+    {
+        testRpcDoneId[testRpcDoneCount] = id;
+        testRpcDoneResult[testRpcDoneCount] = result;
+    }
+    testRpcDoneCount++;
+}
+
+/*******************************************************************************
+* Function Name: Test_RpcBasic
+********************************************************************************
+* Summary:
+* Checks a polled call, a bad method code and methods the server does not
+* have.
+*
+*******************************************************************************/
+static void Test_RpcBasic(void)
+{
+    cy_stc_ipc_rpc_msg_t request;
+    uint32_t id;
+    uint32_t result = 0UL;
+
+    Test_RpcInit();
+
+    TEST_CHECK(CY_IPC_RPC_SUCCESS == Test_RpcCall(0UL, 7UL, NULL, &id));
+    TEST_CHECK(CY_IPC_RPC_PENDING == Cy_IPC_Rpc_Poll(&testRpc, id, &result));
+    Test_RpcServe();
+    TEST_CHECK(CY_IPC_RPC_PENDING == Cy_IPC_Rpc_Poll(&testRpc, id, &result));
+    TEST_CHECK(0UL == Test_RpcDeliver());
+    TEST_CHECK(CY_IPC_RPC_SUCCESS == Cy_IPC_Rpc_Poll(&testRpc, id, &result));
+    TEST_CHECK((uint32_t)(7UL * TEST_RPC_HASH) == result);
+
+    /* The result is returned once */
+    TEST_CHECK(CY_IPC_RPC_ERROR_UNKNOWN_ID == Cy_IPC_Rpc_Poll(&testRpc, id, &result));
+
+    /* The method code travels in 16 bits */
+    TEST_CHECK(CY_IPC_RPC_ERROR_BAD_PARAM == Cy_IPC_Rpc_Prepare(&testRpc, 0x10000UL, 0UL, NULL, NULL, &request, &id));
+
+    /* A NULL entry and one past the table */
+    TEST_CHECK(CY_IPC_RPC_SUCCESS == Test_RpcCall(1UL, 0UL, NULL, &id));
+    Test_RpcServe();
+    TEST_CHECK(0UL == Test_RpcDeliver());
+    TEST_CHECK(CY_IPC_RPC_ERROR_NO_METHOD == Cy_IPC_Rpc_Poll(&testRpc, id, &result));
+    TEST_CHECK(CY_IPC_RPC_SUCCESS == Test_RpcCall(0xFFFFUL, 0UL, NULL, &id));
+    Test_RpcServe();
+    TEST_CHECK(0UL == Test_RpcDeliver());
+    TEST_CHECK(CY_IPC_RPC_ERROR_NO_METHOD == Cy_IPC_Rpc_Poll(&testRpc, id, &result));
+}
+
+/*******************************************************************************
+* Function Name: Test_RpcOutOfOrder
+********************************************************************************
+* Summary:
+* Fills the window with callback and polled calls, and has the server
+* answer them last first. Every call gets its own result, and the window
+* is free again afterwards.
+*
+*******************************************************************************/
+static void Test_RpcOutOfOrder(void)
+{
+    uint32_t id[CY_IPC_RPC_MAX_PENDING];
+    uint32_t extra;
+    uint32_t result;
+    uint32_t callbacks = 0UL;
+    uint32_t i;
+
+    Test_RpcInit();
+
+    /* Even calls complete by callback, odd ones are polled */
+    for (i = 0UL; i < CY_IPC_RPC_MAX_PENDING; i++)
+    {
+        TEST_CHECK(CY_IPC_RPC_SUCCESS == Test_RpcCall(0UL, 100UL + i, (0UL == (i & 1UL)) ? &Test_RpcDone : NULL, &id[i]));
+    }
+    TEST_CHECK(CY_IPC_RPC_ERROR_NO_SLOT == Test_RpcCall(0UL, 0UL, NULL, &extra));
+
+    Test_RpcServe();
+    TEST_CHECK(0UL == Test_RpcDeliver());
+
+    /* The callbacks ran in the order of the responses, the reverse of the calls */
+    TEST_CHECK((CY_IPC_RPC_MAX_PENDING / 2UL) == testRpcDoneCount);
+    for (i = CY_IPC_RPC_MAX_PENDING; i > 0UL; i--)
+    {
+        if (0UL == ((i - 1UL) & 1UL))
+        {
+            TEST_CHECK(id[i - 1UL] == testRpcDoneId[callbacks]);
+            TEST_CHECK((uint32_t)((100UL + i - 1UL) * TEST_RPC_HASH) == testRpcDoneResult[callbacks]);
+            callbacks++;
+        }
+    }
+
+    for (i = 1UL; i < CY_IPC_RPC_MAX_PENDING; i += 2UL)
+    {
+        TEST_CHECK(CY_IPC_RPC_SUCCESS == Cy_IPC_Rpc_Poll(&testRpc, id[i], &result));
+        TEST_CHECK((uint32_t)((100UL + i) * TEST_RPC_HASH) == result);
+    }
+
+    /* All slots free */
+    for (i = 0UL; i < CY_IPC_RPC_MAX_PENDING; i++)
+    {
+        TEST_CHECK(CY_IPC_RPC_SUCCESS == Test_RpcCall(0UL, i, NULL, &id[i]));
+    }
+}
+
+/*******************************************************************************
+* Function Name: Test_RpcCancel
+********************************************************************************
+* Summary:
+* Cancels a call before its response, which is then rejected without a
+* callback, and a polled call after its response, whose result is dropped.
+*
+*******************************************************************************/
+static void Test_RpcCancel(void)
+{
+    uint32_t id;
+    uint32_t result;
+
+    Test_RpcInit();
+
+    TEST_CHECK(CY_IPC_RPC_SUCCESS == Test_RpcCall(0UL, 1UL, &Test_RpcDone, &id));
+    TEST_CHECK(CY_IPC_RPC_SUCCESS == Cy_IPC_Rpc_Cancel(&testRpc, id));
+    TEST_CHECK(CY_IPC_RPC_ERROR_UNKNOWN_ID == Cy_IPC_Rpc_Cancel(&testRpc, id));
+    TEST_CHECK(CY_IPC_RPC_ERROR_UNKNOWN_ID == Cy_IPC_Rpc_Poll(&testRpc, id, &result));
+    Test_RpcServe();
+    TEST_CHECK(1UL == Test_RpcDeliver());
+    TEST_CHECK(0UL == testRpcDoneCount);
+
+    TEST_CHECK(CY_IPC_RPC_SUCCESS == Test_RpcCall(0UL, 2UL, NULL, &id));
+    Test_RpcServe();
+    TEST_CHECK(0UL == Test_RpcDeliver());
+    TEST_CHECK(CY_IPC_RPC_SUCCESS == Cy_IPC_Rpc_Cancel(&testRpc, id));
+    TEST_CHECK(CY_IPC_RPC_ERROR_UNKNOWN_ID == Cy_IPC_Rpc_Poll(&testRpc, id, &result));
+
+    /* A callback call that completed has freed its slot */
+    TEST_CHECK(CY_IPC_RPC_SUCCESS == Test_RpcCall(0UL, 3UL, &Test_RpcDone, &id));
+    Test_RpcServe();
+    TEST_CHECK(0UL == Test_RpcDeliver());
+    TEST_CHECK(1UL == testRpcDoneCount);
+    TEST_CHECK(CY_IPC_RPC_ERROR_UNKNOWN_ID == Cy_IPC_Rpc_Cancel(&testRpc, id));
+}
+
+/*******************************************************************************
+* Function Name: Test_RpcStale
+********************************************************************************
+* Summary:
+* Reuses the slot of a cancelled call, then delivers the late response of
+* the old call, a duplicate response, and one of a generation not issued
+* yet. Only the response to the current ID completes the slot.
+*
+*******************************************************************************/
+static void Test_RpcStale(void)
+{
+    cy_stc_ipc_rpc_msg_t late;
+    cy_stc_ipc_rpc_msg_t current;
+    cy_stc_ipc_rpc_msg_t forged;
+    uint32_t oldId;
+    uint32_t id;
+    uint32_t result;
+
+    Test_RpcInit();
+
+    TEST_CHECK(CY_IPC_RPC_SUCCESS == Test_RpcCall(0UL, 1UL, NULL, &oldId));
+    Test_RpcServe();
+    TEST_CHECK(CY_IPC_RING_SUCCESS == Cy_IPC_Ring_Pop(&testRpcResponseRing, &late));
+    TEST_CHECK(CY_IPC_RPC_SUCCESS == Cy_IPC_Rpc_Cancel(&testRpc, oldId));
+
+    /* Same slot, next generation */
+    TEST_CHECK(CY_IPC_RPC_SUCCESS == Test_RpcCall(0UL, 2UL, NULL, &id));
+    TEST_CHECK((id & TEST_RPC_ID_SLOT_Msk) == (oldId & TEST_RPC_ID_SLOT_Msk));
+    TEST_CHECK(id != oldId);
+
+    TEST_CHECK(CY_IPC_RPC_ERROR_UNKNOWN_ID == Cy_IPC_Rpc_Complete(&testRpc, &late));
+    TEST_CHECK(CY_IPC_RPC_PENDING == Cy_IPC_Rpc_Poll(&testRpc, id, &result));
+
+    forged = late;
+    forged.id = (uint16_t)((id + CY_IPC_RPC_MAX_PENDING) & (TEST_RPC_IDS - 1UL));
+    TEST_CHECK(CY_IPC_RPC_ERROR_UNKNOWN_ID == Cy_IPC_Rpc_Complete(&testRpc, &forged));
+    TEST_CHECK(CY_IPC_RPC_PENDING == Cy_IPC_Rpc_Poll(&testRpc, id, &result));
+
+    Test_RpcServe();
+    TEST_CHECK(CY_IPC_RING_SUCCESS == Cy_IPC_Ring_Pop(&testRpcResponseRing, &current));
+    TEST_CHECK(CY_IPC_RPC_SUCCESS == Cy_IPC_Rpc_Complete(&testRpc, &current));
+    TEST_CHECK(CY_IPC_RPC_ERROR_UNKNOWN_ID == Cy_IPC_Rpc_Complete(&testRpc, &current));
+    TEST_CHECK(CY_IPC_RPC_SUCCESS == Cy_IPC_Rpc_Poll(&testRpc, id, &result));
+    TEST_CHECK((uint32_t)(2UL * TEST_RPC_HASH) == result);
+}
+
+/*******************************************************************************
+* Function Name: Test_RpcWrap
+********************************************************************************
+* Summary:
+* Reuses one slot until its 16-bit ID wraps, and checks that every
+* generation completes and that the ID keeps its slot bits.
+*
+*******************************************************************************/
+static void Test_RpcWrap(void)
+{
+    uint32_t lastId = 0UL;
+    uint32_t wraps = 0UL;
+    uint32_t id;
+    uint32_t result;
+    uint32_t i;
+
+    Test_RpcInit();
+
+    for (i = 0UL; i < ((TEST_RPC_IDS / CY_IPC_RPC_MAX_PENDING) + 2UL); i++)
+    {
+        TEST_CHECK(CY_IPC_RPC_SUCCESS == Test_RpcCall(0UL, i, NULL, &id));
+        TEST_CHECK((id < TEST_RPC_IDS) && (0UL == (id & TEST_RPC_ID_SLOT_Msk)));
+        if (id < lastId)
+        {
+            wraps++;
+        }
+        lastId = id;
+
+        Test_RpcServe();
+        TEST_CHECK(0UL == Test_RpcDeliver());
+        TEST_CHECK(CY_IPC_RPC_SUCCESS == Cy_IPC_Rpc_Poll(&testRpc, id, &result));
+        TEST_CHECK((uint32_t)(i * TEST_RPC_HASH) == result);
+    }
+    TEST_CHECK(1UL == wraps);
+}
+
+/*******************************************************************************
+* Function Name: Test_RpcServer
+********************************************************************************
+* Summary:
+* Race: the serving core, answering each drain of the request ring last
+* first.
+*
+*******************************************************************************/
+static void *Test_RpcServer(void *arg)
+{
+    cy_stc_ipc_rpc_msg_t request[CY_IPC_RPC_MAX_PENDING];
+    cy_stc_ipc_rpc_msg_t response;
+    uint32_t count;
+
+    (void)arg;
+    while (0UL == IPC_PORT_LOAD_ACQUIRE(&testRpcStop))
+    {
+        count = 0UL;
+        while ((count < CY_IPC_RPC_MAX_PENDING) &&
+               (CY_IPC_RING_SUCCESS == Cy_IPC_Ring_Pop(&testRpcRequestRing, &request[count])))
+        {
+            count++;
+        }
+        if (0UL == count)
+        {
+            Test_Yield();
+        }
+        while (0UL != count)
+        {
+            count--;
+            Cy_IPC_Rpc_Serve(&testRpcServer, &request[count], &response);
+            while ((CY_IPC_RING_SUCCESS != Cy_IPC_Ring_Push(&testRpcResponseRing, &response)) &&
+                   (0UL == IPC_PORT_LOAD_ACQUIRE(&testRpcStop)))
+            {
+                Test_Yield();
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/*******************************************************************************
+* Function Name: Test_RpcRaceDone
+********************************************************************************
+* Summary:
+* Race: completion callback. The call must not have been cancelled, and
+* must get the result of its own argument.
+*
+*******************************************************************************/
+static void Test_RpcRaceDone(uint32_t id, cy_en_ipc_rpc_status_t status, uint32_t result, void *context)
+{
+    uint32_t expected = TEST_RPC_FATE_OPEN;
+
+    (void)context;
+    TEST_CHECK(CY_IPC_RPC_SUCCESS == status);
+    TEST_CHECK((uint32_t)(testRpcArg[id] * TEST_RPC_HASH) == result);
+    TEST_CHECK(Cy_IPC_Port_CompareExchange(&testRpcFate[id], &expected, TEST_RPC_FATE_DONE));
+    testRpcCallbacks++;
+}
+
+/*******************************************************************************
+* Function Name: Test_RpcCompleter
+********************************************************************************
+* Summary:
+* Race: the response interrupt of the caller, on its own thread.
+*
+*******************************************************************************/
+static void *Test_RpcCompleter(void *arg)
+{
+    cy_stc_ipc_rpc_msg_t response;
+
+    (void)arg;
+    while (0UL == IPC_PORT_LOAD_ACQUIRE(&testRpcStop))
+    {
+        if (CY_IPC_RING_SUCCESS == Cy_IPC_Ring_Pop(&testRpcResponseRing, &response))
+        {
+            if (CY_IPC_RPC_SUCCESS != Cy_IPC_Rpc_Complete(&testRpc, &response))
+            {
+                testRpcStale++;
+            }
+        }
+        else
+        {
+            Test_Yield();
+        }
+    }
+
+    return NULL;
+}
+
+/*******************************************************************************
+* Function Name: Test_RpcRace
+********************************************************************************
+* Summary:
+* Keeps up to a full window of calls in flight, half polled and half by
+* callback, and cancels one at random, while the server and the completing
+* thread run. Every call must end exactly once, as a callback, a polled
+* result or a cancel, and only responses to cancelled calls may be stale.
+*
+*******************************************************************************/
+static void Test_RpcRace(uint32_t count)
+{
+    pthread_t server;
+    pthread_t completer;
+    test_rpc_call_t open[CY_IPC_RPC_MAX_PENDING];
+    cy_stc_ipc_rpc_msg_t request;
+    cy_en_ipc_rpc_status_t status;
+    uint32_t openCount = 0UL;
+    uint32_t issued = 0UL;
+    uint32_t polled = 0UL;
+    uint32_t cancelled = 0UL;
+    uint32_t random = 0x2545F491UL;
+    uint32_t expected;
+    uint32_t result;
+    uint32_t id;
+    uint32_t i;
+    bool progress;
+    time_t lastProgress = time(NULL);
+
+    Test_RpcInit();
+    for (i = 0UL; i < TEST_RPC_IDS; i++)
+    {
+        IPC_PORT_STORE_RELAXED(&testRpcFate[i], TEST_RPC_FATE_OPEN);
+    }
+    IPC_PORT_STORE_RELAXED(&testRpcStop, 0UL);
+    TEST_CHECK(0 == pthread_create(&server, NULL, Test_RpcServer, NULL));
+    TEST_CHECK(0 == pthread_create(&completer, NULL, Test_RpcCompleter, NULL));
+
+    while ((issued < count) || (0UL != openCount))
+    {
+        progress = false;
+
+        /* Retire the calls that ended */
+        for (i = 0UL; i < openCount; )
+        {
+            if (open[i].poll)
+            {
+                status = Cy_IPC_Rpc_Poll(&testRpc, open[i].id, &result);
+                if (CY_IPC_RPC_PENDING != status)
+                {
+                    expected = TEST_RPC_FATE_OPEN;
+                    TEST_CHECK(CY_IPC_RPC_SUCCESS == status);
+                    TEST_CHECK((uint32_t)(testRpcArg[open[i].id] * TEST_RPC_HASH) == result);
+                    TEST_CHECK(Cy_IPC_Port_CompareExchange(&testRpcFate[open[i].id], &expected, TEST_RPC_FATE_DONE));
+                    polled++;
+                    open[i] = open[--openCount];
+                    progress = true;
+                    continue;
+                }
+            }
+            else if (TEST_RPC_FATE_DONE == IPC_PORT_LOAD_ACQUIRE(&testRpcFate[open[i].id]))
+            {
+                open[i] = open[--openCount];
+                progress = true;
+                continue;
+            }
+            i++;
+        }
+
+        /* Cancel one now and then; it may be completing already */
+        if ((0UL != openCount) && (0UL == (Test_RpcRandom(&random) & 7UL)))
+        {
+            i = Test_RpcRandom(&random) % openCount;
+            if (CY_IPC_RPC_SUCCESS == Cy_IPC_Rpc_Cancel(&testRpc, open[i].id))
+            {
+                expected = TEST_RPC_FATE_OPEN;
+                TEST_CHECK(Cy_IPC_Port_CompareExchange(&testRpcFate[open[i].id], &expected, TEST_RPC_FATE_CANCELLED));
+                cancelled++;
+                open[i] = open[--openCount];
+                progress = true;
+            }
+        }
+
+        /* Every open call holds at most one slot, so a slot is free; the
+         * requests of cancelled calls can still fill the ring */
+        if ((issued < count) && (openCount < CY_IPC_RPC_MAX_PENDING) &&
+            (Cy_IPC_Ring_Count(&testRpcRequestRing) < CY_IPC_RPC_MAX_PENDING))
+        {
+            open[openCount].poll = (0UL != (Test_RpcRandom(&random) & 1UL));
+            status = Cy_IPC_Rpc_Prepare(&testRpc, 0UL, issued, open[openCount].poll ? NULL : &Test_RpcRaceDone,
+                                        NULL, &request, &id);
+            TEST_CHECK(CY_IPC_RPC_SUCCESS == status);
+            if (CY_IPC_RPC_SUCCESS == status)
+            {
+                testRpcArg[id] = issued;
+                IPC_PORT_STORE_RELAXED(&testRpcFate[id], TEST_RPC_FATE_OPEN);
+                open[openCount++].id = id;
+                TEST_CHECK(CY_IPC_RING_SUCCESS == Cy_IPC_Ring_Push(&testRpcRequestRing, &request));
+            }
+            issued++;
+            progress = true;
+        }
+
+        if (progress)
+        {
+            lastProgress = time(NULL);
+        }
+        else if ((time(NULL) - lastProgress) > TEST_RPC_STALL_S)
+        {
+            (void)fprintf(stderr, "calls stuck after %u issued: %u open\n", (unsigned)issued, (unsigned)openCount);
+            TEST_CHECK(0UL == openCount);
+            break;
+        }
+        else
+        {
+            Test_Yield();
+        }
+    }
+
+    IPC_PORT_STORE_RELEASE(&testRpcStop, 1UL);
+    (void)pthread_join(server, NULL);
+    (void)pthread_join(completer, NULL);
+
+    TEST_CHECK(issued == (testRpcCallbacks + polled + cancelled));
+    TEST_CHECK(testRpcStale <= cancelled);
+    (void)printf("race: %u calls, %u callbacks, %u polled, %u cancelled, %u stale responses\n", (unsigned)issued,
+                 (unsigned)testRpcCallbacks, (unsigned)polled, (unsigned)cancelled, (unsigned)testRpcStale);
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* Runs the checks. argv[1] overrides the calls of the race.
+*
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+    uint32_t count = TEST_RPC_RACE_CALLS;
+
+    if (argc > 1)
+    {
+        count = (uint32_t)strtoul(argv[1], NULL, 0);
+    }
+
+    Test_RpcBasic();
+    Test_RpcOutOfOrder();
+    Test_RpcCancel();
+    Test_RpcStale();
+    Test_RpcWrap();
+    Test_RpcRace(count);
+
+    return Test_Result("test_rpc");
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,424 @@
+/******************************************************************************
+* File Name:   test_sched.c
+*
+* Description: Test of the cooperative scheduler of ipc_sched.c on a
+*              simulated tick. Covers job order, triggers, periods across
+*              the wrap-around of the tick counter, skipped missed periods,
+*              the idle time, and a release that arrives while a job finds
+*              the pipe busy, first replayed on one thread, then raced from
+*              a second thread.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <pthread.h>
+#include <time.h>
+#include "ipc_sched.h"
+#include "test.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TEST_SCHED_PERIOD               (10UL)
+#define TEST_SCHED_RACE_RUNS            (200000UL) /* Override with argv[1] */
+#define TEST_SCHED_STALL_S              (2)     /* No run for this long: a release was lost */
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t id;
+    uint32_t runs;
+    uint32_t lastTick;              /* testSchedNow at the last run */
+    cy_en_ipc_sched_result_t result; /* Returned by the next runs */
+    bool unblockDuring;             /* Call Cy_IPC_Sched_Unblock() from inside the job */
+} test_sched_job_t;
+
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static cy_stc_ipc_sched_t testSched;
+static uint32_t testSchedNow;       /* The simulated tick */
+static uint32_t testSchedOrder[8];  /* Job IDs in the order they ran */
+static uint32_t testSchedOrderCount;
+
+/* Race: the job has backed off and waits for the release thread */
+static cy_ipc_atomic32_t testSchedWaiting;
+static cy_ipc_atomic32_t testSchedStop;
+
+
+/*******************************************************************************
+* Function Name: Test_SchedJob
+********************************************************************************
+* Summary:
+* Records a run and returns the result the test asked for.
+*
+*******************************************************************************/
+static cy_en_ipc_sched_result_t Test_SchedJob(void *context)
+{
+    test_sched_job_t *job = (test_sched_job_t *)context;
+
+    job->runs++;
+    job->lastTick = testSchedNow;
+    if (testSchedOrderCount < (sizeof(testSchedOrder) / sizeof(testSchedOrder[0])))
+    {
+        testSchedOrder[testSchedOrderCount++] = job->id;
+    }
+
+    /* The release interrupt preempts the job after it found the pipe busy */
+    if (job->unblockDuring)
+    {
+        Cy_IPC_Sched_Unblock(&testSched);
+    }
+
+    return job->result;
+}
+
+/*******************************************************************************
+* Function Name: Test_SchedRunAt
+********************************************************************************
+* Summary:
+* Advances the simulated tick and runs one pass.
+*
+*******************************************************************************/
+static bool Test_SchedRunAt(uint32_t now)
+{
+    testSchedNow = now;
+    return Cy_IPC_Sched_RunOnce(&testSched, now);
+}
+
+/*******************************************************************************
+* Function Name: Test_SchedOrder
+********************************************************************************
+* Summary:
+* Checks job registration, the order of a pass, coalesced triggers and a job
+* that asks to run again.
+*
+*******************************************************************************/
+static void Test_SchedOrder(void)
+{
+    test_sched_job_t low = { .id = 1UL, .result = CY_IPC_SCHED_DONE };
+    test_sched_job_t high = { .id = 5UL, .result = CY_IPC_SCHED_DONE };
+
+    Cy_IPC_Sched_Init(&testSched);
+    TEST_CHECK(CY_IPC_SCHED_ERROR_BAD_PARAM == Cy_IPC_Sched_AddJob(&testSched, CY_IPC_SCHED_MAX_JOBS, Test_SchedJob, &low, 0UL, 0UL));
+    TEST_CHECK(CY_IPC_SCHED_ERROR_BAD_PARAM == Cy_IPC_Sched_AddJob(&testSched, 1UL, NULL, &low, 0UL, 0UL));
+    TEST_CHECK(CY_IPC_SCHED_SUCCESS == Cy_IPC_Sched_AddJob(&testSched, 1UL, Test_SchedJob, &low, CY_IPC_SCHED_ON_DEMAND, 0UL));
+    TEST_CHECK(CY_IPC_SCHED_SUCCESS == Cy_IPC_Sched_AddJob(&testSched, 5UL, Test_SchedJob, &high, CY_IPC_SCHED_ON_DEMAND, 0UL));
+
+    /* Nothing to do: the caller may sleep until an interrupt */
+    TEST_CHECK(!Test_SchedRunAt(0UL));
+    TEST_CHECK(CY_IPC_SCHED_FOREVER == Cy_IPC_Sched_IdleTime(&testSched, 0UL));
+
+    /* Lower ID first, repeated triggers run once */
+    testSchedOrderCount = 0UL;
+    Cy_IPC_Sched_Trigger(&testSched, 5UL);
+    Cy_IPC_Sched_Trigger(&testSched, 5UL);
+    Cy_IPC_Sched_Trigger(&testSched, 1UL);
+    Cy_IPC_Sched_Trigger(&testSched, CY_IPC_SCHED_MAX_JOBS);
+    TEST_CHECK(0UL == Cy_IPC_Sched_IdleTime(&testSched, 0UL));
+    TEST_CHECK(!Test_SchedRunAt(0UL));
+    TEST_CHECK(2UL == testSchedOrderCount);
+    TEST_CHECK((1UL == testSchedOrder[0]) && (5UL == testSchedOrder[1]));
+    TEST_CHECK((1UL == low.runs) && (1UL == high.runs));
+
+    /* AGAIN: pending after the pass, runs once more in the next one */
+    low.result = CY_IPC_SCHED_AGAIN;
+    Cy_IPC_Sched_Trigger(&testSched, 1UL);
+    TEST_CHECK(Test_SchedRunAt(0UL));
+    TEST_CHECK(2UL == low.runs);
+    low.result = CY_IPC_SCHED_DONE;
+    TEST_CHECK(!Test_SchedRunAt(0UL));
+    TEST_CHECK(3UL == low.runs);
+    TEST_CHECK(!Test_SchedRunAt(0UL));
+    TEST_CHECK(3UL == low.runs);
+}
+
+/*******************************************************************************
+* Function Name: Test_SchedWrap
+********************************************************************************
+* Summary:
+* Runs a periodic job across the wrap-around of the tick counter.
+*
+*******************************************************************************/
+static void Test_SchedWrap(void)
+{
+    test_sched_job_t job = { .id = 0UL, .result = CY_IPC_SCHED_DONE };
+    uint32_t start = UINT32_MAX - 15UL;     /* Due at UINT32_MAX - 5, then at 4 */
+
+    Cy_IPC_Sched_Init(&testSched);
+    TEST_CHECK(CY_IPC_SCHED_SUCCESS == Cy_IPC_Sched_AddJob(&testSched, 0UL, Test_SchedJob, &job, TEST_SCHED_PERIOD, start));
+
+    TEST_CHECK(10UL == Cy_IPC_Sched_IdleTime(&testSched, start));
+    (void)Test_SchedRunAt(UINT32_MAX - 6UL);
+    TEST_CHECK(0UL == job.runs);
+    TEST_CHECK(1UL == Cy_IPC_Sched_IdleTime(&testSched, UINT32_MAX - 6UL));
+
+    (void)Test_SchedRunAt(UINT32_MAX - 5UL);
+    TEST_CHECK(1UL == job.runs);
+
+    /* Past the wrap, the next run is still 10 ticks after the last */
+    (void)Test_SchedRunAt(UINT32_MAX);
+    (void)Test_SchedRunAt(0UL);
+    (void)Test_SchedRunAt(3UL);
+    TEST_CHECK(1UL == job.runs);
+    TEST_CHECK(1UL == Cy_IPC_Sched_IdleTime(&testSched, 3UL));
+    (void)Test_SchedRunAt(4UL);
+    TEST_CHECK(2UL == job.runs);
+    TEST_CHECK(4UL == job.lastTick);
+    TEST_CHECK(TEST_SCHED_PERIOD == Cy_IPC_Sched_IdleTime(&testSched, 4UL));
+
+    /* Half the counter range is not mistaken for a tick in the past */
+    TEST_CHECK(0UL == Cy_IPC_Sched_IdleTime(&testSched, 14UL + 0x7FFFFFFFUL));
+}
+
+/*******************************************************************************
+* Function Name: Test_SchedMissed
+********************************************************************************
+* Summary:
+* Checks that a job that falls behind by less than one period keeps its
+* phase, and one that falls behind by several periods runs once and skips
+* the rest instead of running back to back.
+*
+*******************************************************************************/
+static void Test_SchedMissed(void)
+{
+    test_sched_job_t job = { .id = 0UL, .result = CY_IPC_SCHED_DONE };
+    uint32_t now;
+
+    Cy_IPC_Sched_Init(&testSched);
+    TEST_CHECK(CY_IPC_SCHED_SUCCESS == Cy_IPC_Sched_AddJob(&testSched, 0UL, Test_SchedJob, &job, TEST_SCHED_PERIOD, 0UL));
+
+    /* Late by 3: the next run stays at 20 */
+    (void)Test_SchedRunAt(13UL);
+    TEST_CHECK(1UL == job.runs);
+    TEST_CHECK(7UL == Cy_IPC_Sched_IdleTime(&testSched, 13UL));
+
+    /* Late by 3.5 periods: one run now, the next a full period later */
+    (void)Test_SchedRunAt(55UL);
+    TEST_CHECK(2UL == job.runs);
+    for (now = 56UL; now < 65UL; now++)
+    {
+        (void)Test_SchedRunAt(now);
+    }
+    TEST_CHECK(2UL == job.runs);
+    (void)Test_SchedRunAt(65UL);
+    TEST_CHECK(3UL == job.runs);
+}
+
+/*******************************************************************************
+* Function Name: Test_SchedBlocked
+********************************************************************************
+* Summary:
+* Checks that a job that backed off waits for the release even when it is
+* due or triggered, and that a release during the job is not lost.
+*
+*******************************************************************************/
+static void Test_SchedBlocked(void)
+{
+    test_sched_job_t job = { .id = 2UL, .result = CY_IPC_SCHED_BLOCKED };
+
+    Cy_IPC_Sched_Init(&testSched);
+    TEST_CHECK(CY_IPC_SCHED_SUCCESS == Cy_IPC_Sched_AddJob(&testSched, 2UL, Test_SchedJob, &job, TEST_SCHED_PERIOD, 0UL));
+
+    /* Backs off at its period; neither the next period nor a trigger runs it */
+    TEST_CHECK(!Test_SchedRunAt(10UL));
+    TEST_CHECK(1UL == job.runs);
+    TEST_CHECK(1UL == testSched.backoffs);
+    TEST_CHECK(CY_IPC_SCHED_FOREVER == Cy_IPC_Sched_IdleTime(&testSched, 10UL));
+    Cy_IPC_Sched_Trigger(&testSched, 2UL);
+    (void)Test_SchedRunAt(20UL);
+    (void)Test_SchedRunAt(21UL);
+    TEST_CHECK(1UL == job.runs);
+
+    /* The release makes it runnable */
+    job.result = CY_IPC_SCHED_DONE;
+    Cy_IPC_Sched_Unblock(&testSched);
+    TEST_CHECK(0UL == Cy_IPC_Sched_IdleTime(&testSched, 22UL));
+    (void)Test_SchedRunAt(22UL);
+    TEST_CHECK(2UL == job.runs);
+
+    /* Release while the job runs, after it found the pipe busy: the job
+     * must not wait for a release that already happened */
+    job.result = CY_IPC_SCHED_BLOCKED;
+    job.unblockDuring = true;
+    Cy_IPC_Sched_Trigger(&testSched, 2UL);
+    TEST_CHECK(Test_SchedRunAt(23UL));
+    TEST_CHECK(3UL == job.runs);
+    TEST_CHECK(0UL == IPC_PORT_LOAD_RELAXED(&testSched.blocked));
+    TEST_CHECK(0UL == Cy_IPC_Sched_IdleTime(&testSched, 23UL));
+    job.result = CY_IPC_SCHED_DONE;
+    job.unblockDuring = false;
+    TEST_CHECK(!Test_SchedRunAt(24UL));
+    TEST_CHECK(4UL == job.runs);
+}
+
+/*******************************************************************************
+* Function Name: Test_SchedRaceJob
+********************************************************************************
+* Summary:
+* Finds the pipe busy every time and hands the release to the other thread.
+*
+*******************************************************************************/
+static cy_en_ipc_sched_result_t Test_SchedRaceJob(void *context)
+{
+    uint32_t *runs = (uint32_t *)context;
+
+    (*runs)++;
+    IPC_PORT_STORE_RELEASE(&testSchedWaiting, 1UL);
+    if (0UL == (*runs & 7UL))
+    {
+        Test_Yield();
+    }
+
+    return CY_IPC_SCHED_BLOCKED;
+}
+
+/*******************************************************************************
+* Function Name: Test_SchedRelease
+********************************************************************************
+* Summary:
+* The release interrupt: one release for each back-off, at any point of the
+* pass that follows it.
+*
+*******************************************************************************/
+static void *Test_SchedRelease(void *arg)
+{
+    uint32_t count = 0UL;
+
+    (void)arg;
+    while (0UL == IPC_PORT_LOAD_ACQUIRE(&testSchedStop))
+    {
+        if (0UL != IPC_PORT_LOAD_ACQUIRE(&testSchedWaiting))
+        {
+            IPC_PORT_STORE_RELAXED(&testSchedWaiting, 0UL);
+            if (0UL != (++count & 3UL))
+            {
+                Test_Yield();
+            }
+            Cy_IPC_Sched_Unblock(&testSched);
+        }
+        else
+        {
+            Test_Yield();
+        }
+    }
+
+    return NULL;
+}
+
+/*******************************************************************************
+* Function Name: Test_SchedRace
+********************************************************************************
+* Summary:
+* Races the release thread against the scheduler thread. Every back-off is
+* followed by exactly one release, so a lost release leaves the job blocked
+* for good.
+*
+*******************************************************************************/
+static void Test_SchedRace(uint32_t count)
+{
+    pthread_t release;
+    uint32_t runs = 0UL;
+    uint32_t lastRuns = 0UL;
+    time_t lastProgress = time(NULL);
+
+    Cy_IPC_Sched_Init(&testSched);
+    IPC_PORT_STORE_RELAXED(&testSchedWaiting, 0UL);
+    IPC_PORT_STORE_RELAXED(&testSchedStop, 0UL);
+    TEST_CHECK(CY_IPC_SCHED_SUCCESS == Cy_IPC_Sched_AddJob(&testSched, 0UL, Test_SchedRaceJob, &runs, CY_IPC_SCHED_ON_DEMAND, 0UL));
+    TEST_CHECK(0 == pthread_create(&release, NULL, Test_SchedRelease, NULL));
+
+    Cy_IPC_Sched_Trigger(&testSched, 0UL);
+    while (runs < count)
+    {
+        (void)Cy_IPC_Sched_RunOnce(&testSched, 0UL);
+        if (runs != lastRuns)
+        {
+            lastRuns = runs;
+            lastProgress = time(NULL);
+        }
+        else if ((time(NULL) - lastProgress) > TEST_SCHED_STALL_S)
+        {
+            (void)fprintf(stderr, "job stuck after %u runs: blocked %08x pending %08x\n", (unsigned)runs,
+                          (unsigned)IPC_PORT_LOAD_RELAXED(&testSched.blocked),
+                          (unsigned)IPC_PORT_LOAD_RELAXED(&testSched.pending));
+            TEST_CHECK(runs == count);
+            break;
+        }
+        else
+        {
+            Test_Yield();
+        }
+    }
+
+    IPC_PORT_STORE_RELEASE(&testSchedStop, 1UL);
+    (void)pthread_join(release, NULL);
+
+    (void)printf("race: %u back-offs, %u releases\n", (unsigned)testSched.backoffs,
+                 (unsigned)IPC_PORT_LOAD_RELAXED(&testSched.releases));
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* Runs the checks. argv[1] overrides the back-offs of the race.
+*
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+    uint32_t count = TEST_SCHED_RACE_RUNS;
+
+    if (argc > 1)
+    {
+        count = (uint32_t)strtoul(argv[1], NULL, 0);
+    }
+
+    Test_SchedOrder();
+    Test_SchedWrap();
+    Test_SchedMissed();
+    Test_SchedBlocked();
+    Test_SchedRace(count);
+
+    return Test_Result("test_sched");
+}
+
+/* [] END OF FILE */
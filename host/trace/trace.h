@@ -0,0 +1,126 @@
+/******************************************************************************
+* File Name:   trace.h
+*
+* Description: Loads the ring dumps written by Cy_IPC_Trace_Save(), merges
+*              them on one time base and rebuilds the life of every pipe
+*              message from its events. Used by the trace tool and by the
+*              replay mode of the benchmark.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "cy_pdl.h"
+#include "ipc_topology.h"
+#include "ipc_trace.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+#define TRACE_NO_CORE                   (0xFFUL)        /* Sender of a message whose send was not captured */
+#define TRACE_NO_TIME                   (INT64_MIN)     /* Stage not captured */
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+/* Event on the merged time base */
+typedef struct
+{
+    int64_t t;                  /* Ticks since the first event */
+    cy_stc_ipc_trace_rec_t rec;
+} cy_stc_trace_event_t;
+
+/* All dumps of one capture, events sorted by time */
+typedef struct
+{
+    cy_stc_trace_event_t *event;
+    uint32_t count;
+    uint32_t clockHz;           /* 0: times are in ticks of an unknown clock */
+    uint32_t rings;             /* Dumps loaded */
+    uint32_t lost;              /* Events overwritten before the dump, all rings */
+} cy_stc_trace_t;
+
+/* Stages of a message, in the order they happen */
+typedef enum
+{
+    TRACE_STAGE_SEND,           /* First send attempt */
+    TRACE_STAGE_LOCK,           /* Channel locked, receiver notified */
+    TRACE_STAGE_ISR,            /* Receiver pipe ISR entered */
+    TRACE_STAGE_HANDLER,        /* Receiver handler entered */
+    TRACE_STAGE_DONE,           /* Receiver handler returned */
+    TRACE_STAGE_RELEASE,        /* Sender release callback */
+    TRACE_STAGE_COUNT,
+} cy_en_trace_stage_t;
+
+/* One pipe message, rebuilt from the events of sender and receiver */
+typedef struct
+{
+    uint8_t core;               /* Sender, or TRACE_NO_CORE */
+    uint8_t receiver;           /* Core that handled it, or TRACE_NO_CORE */
+    uint8_t ep;                 /* Endpoint address of the receiver */
+    uint8_t client;
+    uint32_t msg;               /* Address */
+    uint32_t bytes;             /* Payload bytes */
+    uint32_t busy;              /* Send attempts refused */
+    uint32_t errors;            /* Rejected by the receiver */
+    int64_t t[TRACE_STAGE_COUNT]; /* Or TRACE_NO_TIME */
+} cy_stc_trace_msg_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+bool Trace_Load(cy_stc_trace_t *trace, char const *const paths[], uint32_t count);
+void Trace_Free(cy_stc_trace_t *trace);
+uint32_t Trace_Messages(cy_stc_trace_t const *trace, cy_stc_trace_msg_t **msgs);
+double Trace_Us(cy_stc_trace_t const *trace, int64_t ticks);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* TRACE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,466 @@
+/******************************************************************************
+* File Name:   trace_file.c
+*
+* Description: Loads the ring dumps written by Cy_IPC_Trace_Save(), merges
+*              them on one time base and rebuilds the life of every pipe
+*              message from its events.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "trace.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TRACE_MAX_DEPTH                 (1UL << 20)     /* Larger rings are taken as a corrupt dump */
+
+
+/*******************************************************************************
+* Function Name: Trace_LoadRing
+********************************************************************************
+* Summary:
+* Appends the events of one dump to the trace, oldest first. Times are
+* unwrapped along the ring, so a capture may be longer than the clock
+* period, and put on the time base of the first dump loaded. Returns false
+* if the file cannot be read or is not a dump.
+*
+*******************************************************************************/
+static bool Trace_LoadRing(cy_stc_trace_t *trace, char const *path, uint32_t *ref, bool *haveRef)
+{
+    FILE *file = fopen(path, "rb");
+    cy_stc_ipc_trace_hdr_t hdr;
+    cy_stc_ipc_trace_rec_t *rec = NULL;
+    cy_stc_trace_event_t *event;
+    uint32_t head;
+    uint32_t kept;
+    uint32_t prev = 0UL;
+    int64_t t = 0;
+    bool first = true;
+    bool ok = false;
+    uint32_t i;
+
+    if (NULL == file)
+    {
+        (void)fprintf(stderr, "cannot open %s\n", path);
+        return false;
+    }
+
+    if ((1U != fread(&hdr, sizeof(hdr), 1U, file)) || (CY_IPC_TRACE_MAGIC != hdr.magic) ||
+        (CY_IPC_TRACE_VERSION != hdr.version) || (sizeof(cy_stc_ipc_trace_rec_t) != hdr.recordSize) ||
+        (0UL == hdr.depth) || (hdr.depth > TRACE_MAX_DEPTH) || (0UL != (hdr.depth & (hdr.depth - 1UL))))
+    {
+        (void)fprintf(stderr, "%s: not an IPC trace dump\n", path);
+        goto done;
+    }
+
+    rec = malloc(hdr.depth * sizeof(*rec));
+    event = realloc(trace->event, (trace->count + hdr.depth) * sizeof(*event));
+    if ((NULL == rec) || (NULL == event))
+    {
+        goto done;
+    }
+    trace->event = event;
+    if (hdr.depth != fread(rec, sizeof(*rec), hdr.depth, file))
+    {
+        (void)fprintf(stderr, "%s: truncated\n", path);
+        goto done;
+    }
+
+    if ((0UL == trace->rings) || (hdr.clockHz != trace->clockHz))
+    {
+        /* Dumps of different clocks cannot be compared, fall back to ticks */
+        trace->clockHz = (0UL == trace->rings) ? hdr.clockHz : 0UL;
+    }
+
+    head = IPC_PORT_LOAD_RELAXED(&hdr.head);
+    kept = (head < hdr.depth) ? head : hdr.depth;
+    trace->lost += head - kept;
+
+    for (i = head - kept; i != head; i++)
+    {
+        cy_stc_ipc_trace_rec_t const *r = &rec[i & (hdr.depth - 1UL)];
+
+        if (r->event >= (uint8_t)CY_IPC_TRACE_EVENT_COUNT)
+        {
+            continue;   /* Claimed but not yet written when dumped */
+        }
+
+        if (!*haveRef)
+        {
+            *ref = r->time;
+            *haveRef = true;
+        }
+        t = first ? (int64_t)(int32_t)(r->time - *ref) : (t + (int32_t)(r->time - prev));
+        prev = r->time;
+        first = false;
+
+        trace->event[trace->count].t = t;
+        trace->event[trace->count].rec = *r;
+        trace->count++;
+    }
+
+    trace->rings++;
+    ok = true;
+
+done:
+    free(rec);
+    (void)fclose(file);
+    return ok;
+}
+
+/*******************************************************************************
+* Function Name: Trace_Compare
+********************************************************************************
+* Summary:
+* qsort() order of the merged events: by time, ties by core.
+*
+*******************************************************************************/
+static int Trace_Compare(const void *a, const void *b)
+{
+    cy_stc_trace_event_t const *ea = (cy_stc_trace_event_t const *)a;
+    cy_stc_trace_event_t const *eb = (cy_stc_trace_event_t const *)b;
+
+    if (ea->t != eb->t)
+    {
+        return (ea->t < eb->t) ? -1 : 1;
+    }
+    return (int)ea->rec.core - (int)eb->rec.core;
+}
+
+/*******************************************************************************
+* Function Name: Trace_Load
+********************************************************************************
+* Summary:
+* Loads the dumps of one capture, one per core, and merges their events in
+* time order, the first at time 0. All cores must have recorded with the
+* same clock.
+*
+* Parameters:
+*  trace: Filled in, release with Trace_Free().
+*  paths: Dump files.
+*  count: Number of dump files.
+*
+* Return:
+*  false if a file cannot be read or is not a dump
+*
+*******************************************************************************/
+bool Trace_Load(cy_stc_trace_t *trace, char const *const paths[], uint32_t count)
+{
+    uint32_t ref = 0UL;
+    bool haveRef = false;
+    uint32_t i;
+
+    (void)memset(trace, 0, sizeof(*trace));
+    for (i = 0UL; i < count; i++)
+    {
+        if (!Trace_LoadRing(trace, paths[i], &ref, &haveRef))
+        {
+            Trace_Free(trace);
+            return false;
+        }
+    }
+
+    if (0UL != trace->count)
+    {
+        qsort(trace->event, trace->count, sizeof(*trace->event), &Trace_Compare);
+    }
+
+    /* The capture starts at 0 */
+    for (i = trace->count; i-- > 0UL;)
+    {
+        trace->event[i].t -= trace->event[0].t;
+    }
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: Trace_Free
+********************************************************************************
+* Summary:
+* Releases the events of a trace.
+*
+* Parameters:
+*  trace: Loaded by Trace_Load().
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Trace_Free(cy_stc_trace_t *trace)
+{
+    free(trace->event);
+    (void)memset(trace, 0, sizeof(*trace));
+}
+
+/*******************************************************************************
+* Function Name: Trace_Find
+********************************************************************************
+* Summary:
+* Returns the latest send of a message on the channel of a sender core and
+* receiver endpoint that has not got the channel yet, or NULL.
+*
+*******************************************************************************/
+static cy_stc_trace_msg_t *Trace_FindSend(cy_stc_trace_msg_t *msgs, uint32_t count, uint32_t core, uint32_t ep,
+                                          uint32_t msg)
+{
+    uint32_t i;
+
+    for (i = count; i-- > 0UL;)
+    {
+        cy_stc_trace_msg_t *m = &msgs[i];
+
+        if ((core == m->core) && (ep == m->ep) && (msg == m->msg) && (TRACE_NO_TIME == m->t[TRACE_STAGE_LOCK]))
+        {
+            return m;
+        }
+    }
+    return NULL;
+}
+
+/*******************************************************************************
+* Function Name: Trace_FindHandled
+********************************************************************************
+* Summary:
+* Returns the message a handler of a receiver endpoint entered at time t
+* took: the oldest send of the same address to the endpoint before t that
+* is not handled yet, or NULL. A handler overwritten in the ring of the
+* receiver leaves its send unhandled, so the match is only exact while the
+* receiver ring covers the sends of the other rings.
+*
+*******************************************************************************/
+static cy_stc_trace_msg_t *Trace_FindHandled(cy_stc_trace_msg_t *msgs, uint32_t count, uint32_t ep, uint32_t msg,
+                                             int64_t t)
+{
+    uint32_t i;
+
+    for (i = 0UL; i < count; i++)
+    {
+        cy_stc_trace_msg_t *m = &msgs[i];
+
+        if ((ep == m->ep) && (msg == m->msg) && (TRACE_NO_TIME == m->t[TRACE_STAGE_DONE]) &&
+            (TRACE_NO_TIME != m->t[TRACE_STAGE_SEND]) && (m->t[TRACE_STAGE_SEND] <= t))
+        {
+            return m;
+        }
+    }
+    return NULL;
+}
+
+/*******************************************************************************
+* Function Name: Trace_Messages
+********************************************************************************
+* Summary:
+* Rebuilds the pipe messages of a trace. A send opens a message on the
+* channel of its sender and receiver endpoint; a send of the same buffer
+* that has not got the channel yet is a retry. The receiver matches its
+* handler to the oldest unhandled send of the same address to its
+* endpoint, as a receiver takes the messages of an endpoint in order; the ISR is the last one
+* of that endpoint before the handler. The release callback closes the
+* oldest message of the channel that got through and is not released. A handler without a
+* captured send still gets a message, with core TRACE_NO_CORE.
+*
+* Parameters:
+*  trace: Loaded by Trace_Load().
+*  msgs: Set to the messages in send order, release with free().
+*
+* Return:
+*  Number of messages
+*
+*******************************************************************************/
+uint32_t Trace_Messages(cy_stc_trace_t const *trace, cy_stc_trace_msg_t **msgs)
+{
+    int64_t lastIsr[CY_IPC_MAX_ENDPOINTS];
+    uint8_t isrCore[CY_IPC_MAX_ENDPOINTS];
+    cy_stc_trace_msg_t *list = calloc((0UL != trace->count) ? trace->count : 1UL, sizeof(*list));
+    cy_stc_trace_msg_t *m;
+    uint32_t count = 0UL;
+    uint32_t i;
+    uint32_t s;
+
+    *msgs = list;
+    if (NULL == list)
+    {
+        return 0UL;
+    }
+    for (i = 0UL; i < CY_IPC_MAX_ENDPOINTS; i++)
+    {
+        lastIsr[i] = TRACE_NO_TIME;
+        isrCore[i] = (uint8_t)TRACE_NO_CORE;
+    }
+
+    for (i = 0UL; i < trace->count; i++)
+    {
+        cy_stc_trace_event_t const *e = &trace->event[i];
+        cy_stc_ipc_trace_rec_t const *r = &e->rec;
+
+        if (r->ep >= CY_IPC_MAX_ENDPOINTS)
+        {
+            continue;
+        }
+
+        switch ((cy_en_ipc_trace_event_t)r->event)
+        {
+            case CY_IPC_TRACE_SEND:
+                m = Trace_FindSend(list, count, r->core, r->ep, r->msg);
+                if (NULL == m)
+                {
+                    m = &list[count++];
+                    m->core = r->core;
+                    m->receiver = (uint8_t)TRACE_NO_CORE;
+                    m->ep = r->ep;
+                    m->client = r->client;
+                    m->msg = r->msg;
+                    m->bytes = r->arg;
+                    for (s = 0UL; s < (uint32_t)TRACE_STAGE_COUNT; s++)
+                    {
+                        m->t[s] = TRACE_NO_TIME;
+                    }
+                    m->t[TRACE_STAGE_SEND] = e->t;
+                }
+                break;
+
+            case CY_IPC_TRACE_BUSY:
+                m = Trace_FindSend(list, count, r->core, r->ep, r->msg);
+                if (NULL != m)
+                {
+                    m->busy++;
+                }
+                break;
+
+            case CY_IPC_TRACE_LOCK:
+                m = Trace_FindSend(list, count, r->core, r->ep, r->msg);
+                if (NULL != m)
+                {
+                    m->t[TRACE_STAGE_LOCK] = e->t;
+                }
+                break;
+
+            case CY_IPC_TRACE_ISR:
+                lastIsr[r->ep] = e->t;
+                isrCore[r->ep] = r->core;
+                break;
+
+            case CY_IPC_TRACE_ERROR:
+                if (0UL != r->msg)
+                {
+                    m = Trace_FindHandled(list, count, r->ep, r->msg, e->t);
+                    if (NULL != m)
+                    {
+                        m->errors++;
+                    }
+                }
+                break;
+
+            case CY_IPC_TRACE_CALLBACK:
+                m = Trace_FindHandled(list, count, r->ep, r->msg, e->t - (int64_t)r->arg);
+                if (NULL == m)
+                {
+                    m = &list[count++];
+                    m->core = (uint8_t)TRACE_NO_CORE;
+                    m->ep = r->ep;
+                    m->client = r->client;
+                    m->msg = r->msg;
+                    for (s = 0UL; s < (uint32_t)TRACE_STAGE_COUNT; s++)
+                    {
+                        m->t[s] = TRACE_NO_TIME;
+                    }
+                }
+                m->receiver = r->core;
+                m->t[TRACE_STAGE_DONE] = e->t;
+                m->t[TRACE_STAGE_HANDLER] = e->t - (int64_t)r->arg;
+                if ((isrCore[r->ep] == r->core) && (lastIsr[r->ep] <= m->t[TRACE_STAGE_HANDLER]) &&
+                    ((TRACE_NO_TIME == m->t[TRACE_STAGE_SEND]) || (lastIsr[r->ep] >= m->t[TRACE_STAGE_SEND])))
+                {
+                    m->t[TRACE_STAGE_ISR] = lastIsr[r->ep];
+                }
+                break;
+
+            case CY_IPC_TRACE_RELEASE:
+                /* The oldest message of the channel that got through. The
+                 * release may preempt the sender before it records the lock,
+                 * then only the handler shows it. */
+                m = NULL;
+                for (s = 0UL; s < count; s++)
+                {
+                    if ((r->core == list[s].core) && (r->ep == list[s].ep) &&
+                        ((TRACE_NO_TIME != list[s].t[TRACE_STAGE_LOCK]) || (TRACE_NO_TIME != list[s].t[TRACE_STAGE_DONE])) &&
+                        (TRACE_NO_TIME == list[s].t[TRACE_STAGE_RELEASE]))
+                    {
+                        m = &list[s];
+                        break;
+                    }
+                }
+                if (NULL != m)
+                {
+                    m->t[TRACE_STAGE_RELEASE] = e->t;
+                }
+                break;
+
+            default:
+                /* NOTIFY is not part of a pipe message */
+                break;
+        }
+    }
+
+    return count;
+}
+
+/*******************************************************************************
+* Function Name: Trace_Us
+********************************************************************************
+* Summary:
+* Converts ticks of the trace clock to microseconds. Returns the ticks
+* unchanged if the clock is not known.
+*
+* Parameters:
+*  trace: Loaded by Trace_Load().
+*  ticks: Time or duration.
+*
+* Return:
+*  Microseconds, or ticks
+*
+*******************************************************************************/
+double Trace_Us(cy_stc_trace_t const *trace, int64_t ticks)
+{
+    return (0UL != trace->clockHz) ? (((double)ticks * 1e6) / (double)trace->clockHz) : (double)ticks;
+}
+
+/* [] END OF FILE */
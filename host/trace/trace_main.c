@@ -0,0 +1,391 @@
+/******************************************************************************
+* File Name:   trace_main.c
+*
+* Description: Offline analysis of an IPC trace. Merges the ring dumps of
+*              all cores, rebuilds the life of every pipe message from send
+*              to release, and prints a summary per core and per channel
+*              and the messages that stalled, naming the stage that took
+*              the time. With -m it prints the timeline of every message
+*              as CSV instead.
+*              Usage: ipc_trace [-m] [-s stall_us] dump.bin...
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "trace.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TRACE_STALL_US                  (100.0) /* Messages slower than this from send to release */
+#define TRACE_CORES                     (3UL)
+
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static char const *const traceCoreNames[TRACE_CORES] = { "CM0+", "CM7_0", "CM7_1" };
+static char const *const traceStageNames[TRACE_STAGE_COUNT] = { "send", "lock", "isr", "handler", "done", "release" };
+
+
+/*******************************************************************************
+* Function Name: Trace_CoreName
+********************************************************************************
+* Summary:
+* Returns the name of a core, "?" if not known.
+*
+*******************************************************************************/
+static char const *Trace_CoreName(uint32_t core)
+{
+    return (core < TRACE_CORES) ? traceCoreNames[core] : "?";
+}
+
+/*******************************************************************************
+* Function Name: Trace_PrintTime
+********************************************************************************
+* Summary:
+* Prints a CSV field of a time, empty if the stage was not captured.
+*
+*******************************************************************************/
+static void Trace_PrintTime(cy_stc_trace_t const *trace, int64_t t)
+{
+    if (TRACE_NO_TIME == t)
+    {
+        (void)printf(",");
+    }
+    else
+    {
+        (void)printf(",%.3f", Trace_Us(trace, t));
+    }
+}
+
+/*******************************************************************************
+* Function Name: Trace_PrintTimelines
+********************************************************************************
+* Summary:
+* Prints every message with the time of each stage as CSV.
+*
+*******************************************************************************/
+static void Trace_PrintTimelines(cy_stc_trace_t const *trace, cy_stc_trace_msg_t const *msgs, uint32_t count)
+{
+    char const *unit = (0UL != trace->clockHz) ? "us" : "ticks";
+    uint32_t i;
+    uint32_t s;
+
+    (void)printf("sender,receiver,ep,client,msg,bytes,busy,errors");
+    for (s = 0UL; s < (uint32_t)TRACE_STAGE_COUNT; s++)
+    {
+        (void)printf(",%s_%s", traceStageNames[s], unit);
+    }
+    (void)printf("\n");
+
+    for (i = 0UL; i < count; i++)
+    {
+        cy_stc_trace_msg_t const *m = &msgs[i];
+
+        (void)printf("%s,%s,%u,%u,0x%08x,%u,%u,%u", Trace_CoreName(m->core), Trace_CoreName(m->receiver),
+                     (unsigned int)m->ep, (unsigned int)m->client, (unsigned int)m->msg, (unsigned int)m->bytes,
+                     (unsigned int)m->busy, (unsigned int)m->errors);
+        for (s = 0UL; s < (uint32_t)TRACE_STAGE_COUNT; s++)
+        {
+            Trace_PrintTime(trace, m->t[s]);
+        }
+        (void)printf("\n");
+    }
+}
+
+/*******************************************************************************
+* Function Name: Trace_Stall
+********************************************************************************
+* Summary:
+* Finds the stage of a message that took longest, as the time from the
+* previous captured stage. A message that was not released waits for it
+* until the end of the capture. The sender records the lock when the send
+* returns, which may be after the receiver took the message, so a stage
+* counts as done no later than the stages after it. Returns the total time
+* from the first captured stage to the last one, or to the end.
+*
+*******************************************************************************/
+static int64_t Trace_Stall(cy_stc_trace_msg_t const *m, int64_t end, uint32_t *stage, int64_t *longest)
+{
+    int64_t t[TRACE_STAGE_COUNT];
+    int64_t first = TRACE_NO_TIME;
+    int64_t prev = TRACE_NO_TIME;
+    int64_t next = INT64_MAX;
+    uint32_t s;
+
+    for (s = (uint32_t)TRACE_STAGE_COUNT; s-- > 0UL;)
+    {
+        t[s] = m->t[s];
+        if (((uint32_t)TRACE_STAGE_RELEASE == s) && (TRACE_NO_TIME == t[s]) && (TRACE_NO_CORE != m->core))
+        {
+            t[s] = end;     /* Never released */
+        }
+        if (TRACE_NO_TIME != t[s])
+        {
+            t[s] = (t[s] < next) ? t[s] : next;
+            next = t[s];
+        }
+    }
+
+    *stage = (uint32_t)TRACE_STAGE_SEND;
+    *longest = 0;
+    for (s = 0UL; s < (uint32_t)TRACE_STAGE_COUNT; s++)
+    {
+        if (TRACE_NO_TIME == t[s])
+        {
+            continue;
+        }
+
+        if (TRACE_NO_TIME == first)
+        {
+            first = t[s];
+        }
+        else if ((t[s] - prev) > *longest)
+        {
+            *longest = t[s] - prev;
+            *stage = s;
+        }
+        prev = t[s];
+    }
+
+    return (TRACE_NO_TIME != first) ? (prev - first) : 0;
+}
+
+/*******************************************************************************
+* Function Name: Trace_PrintSummary
+********************************************************************************
+* Summary:
+* Prints the events of each core, then per channel the messages, refused
+* sends, rejected and unreleased messages, and the mean and worst time from
+* send to handler, in the handler, and from send to release. Then lists
+* the messages slower than stall from send to release, or not released
+* for longer than that at the end of the capture, with the stage that took
+* the time.
+*
+*******************************************************************************/
+static void Trace_PrintSummary(cy_stc_trace_t const *trace, cy_stc_trace_msg_t const *msgs, uint32_t count,
+                               double stall)
+{
+    typedef struct
+    {
+        uint32_t messages;
+        uint32_t busy;
+        uint32_t errors;
+        uint32_t unreleased;
+        uint32_t n[3];
+        double sum[3];
+        double max[3];
+    } trace_channel_t;
+
+    static trace_channel_t channel[TRACE_CORES + 1UL][CY_IPC_MAX_ENDPOINTS];
+    uint32_t events[TRACE_CORES + 1UL][CY_IPC_TRACE_EVENT_COUNT];
+    char const *unit = (0UL != trace->clockHz) ? "us" : "ticks";
+    int64_t end = (0UL != trace->count) ? trace->event[trace->count - 1UL].t : 0;
+    uint32_t stalls = 0UL;
+    uint32_t i;
+    uint32_t c;
+    uint32_t k;
+
+    (void)memset(events, 0, sizeof(events));
+    for (i = 0UL; i < trace->count; i++)
+    {
+        c = (trace->event[i].rec.core < TRACE_CORES) ? trace->event[i].rec.core : TRACE_CORES;
+        events[c][trace->event[i].rec.event]++;
+    }
+
+    (void)printf("rings,events,overwritten,span_%s\n%u,%u,%u,%.3f\n\n", unit, (unsigned int)trace->rings,
+                 (unsigned int)trace->count, (unsigned int)trace->lost,
+                 Trace_Us(trace, (0UL != trace->count) ? (end - trace->event[0].t) : 0));
+
+    (void)printf("core,send,lock,busy,notify,isr,callback,release,error\n");
+    for (c = 0UL; c < TRACE_CORES; c++)
+    {
+        (void)printf("%s", traceCoreNames[c]);
+        for (k = 0UL; k < (uint32_t)CY_IPC_TRACE_EVENT_COUNT; k++)
+        {
+            (void)printf(",%u", (unsigned int)events[c][k]);
+        }
+        (void)printf("\n");
+    }
+
+    (void)memset(channel, 0, sizeof(channel));
+    for (i = 0UL; i < count; i++)
+    {
+        cy_stc_trace_msg_t const *m = &msgs[i];
+        trace_channel_t *ch = &channel[(m->core < TRACE_CORES) ? m->core : TRACE_CORES][m->ep];
+        int64_t from[3] = { m->t[TRACE_STAGE_SEND], m->t[TRACE_STAGE_HANDLER], m->t[TRACE_STAGE_SEND] };
+        int64_t to[3] = { m->t[TRACE_STAGE_HANDLER], m->t[TRACE_STAGE_DONE], m->t[TRACE_STAGE_RELEASE] };
+
+        ch->messages++;
+        ch->busy += m->busy;
+        ch->errors += m->errors;
+        if ((TRACE_NO_CORE != m->core) && (TRACE_NO_TIME == m->t[TRACE_STAGE_RELEASE]))
+        {
+            ch->unreleased++;
+        }
+        for (k = 0UL; k < 3UL; k++)
+        {
+            if ((TRACE_NO_TIME != from[k]) && (TRACE_NO_TIME != to[k]))
+            {
+                double d = Trace_Us(trace, to[k] - from[k]);
+
+                ch->n[k]++;
+                ch->sum[k] += d;
+                ch->max[k] = (d > ch->max[k]) ? d : ch->max[k];
+            }
+        }
+    }
+
+    (void)printf("\nsender,ep,messages,busy,errors,unreleased,latency_mean_%s,latency_max_%s,"
+                 "handler_mean_%s,handler_max_%s,hold_mean_%s,hold_max_%s\n", unit, unit, unit, unit, unit, unit);
+    for (c = 0UL; c <= TRACE_CORES; c++)
+    {
+        for (k = 0UL; k < CY_IPC_MAX_ENDPOINTS; k++)
+        {
+            trace_channel_t const *ch = &channel[c][k];
+
+            if (0UL == ch->messages)
+            {
+                continue;
+            }
+            (void)printf("%s,%u,%u,%u,%u,%u", Trace_CoreName(c), (unsigned int)k, (unsigned int)ch->messages,
+                         (unsigned int)ch->busy, (unsigned int)ch->errors, (unsigned int)ch->unreleased);
+            for (i = 0UL; i < 3UL; i++)
+            {
+                /* Empty if no message had both stages */
+                if (0UL != ch->n[i])
+                {
+                    (void)printf(",%.3f,%.3f", ch->sum[i] / (double)ch->n[i], ch->max[i]);
+                }
+                else
+                {
+                    (void)printf(",,");
+                }
+            }
+            (void)printf("\n");
+        }
+    }
+
+    (void)printf("\nstall,sender,ep,client,msg,send_%s,total_%s,stage,stage_%s\n", unit, unit, unit);
+    for (i = 0UL; i < count; i++)
+    {
+        cy_stc_trace_msg_t const *m = &msgs[i];
+        uint32_t stage;
+        int64_t longest;
+        double total = Trace_Us(trace, Trace_Stall(m, end, &stage, &longest));
+        bool unreleased = (TRACE_NO_CORE != m->core) && (TRACE_NO_TIME == m->t[TRACE_STAGE_RELEASE]);
+
+        if (total <= stall)
+        {
+            continue;
+        }
+        (void)printf("%s,%s,%u,%u,0x%08x,%.3f,%.3f,%s,%.3f\n", unreleased ? "unreleased" : "slow",
+                     Trace_CoreName(m->core), (unsigned int)m->ep, (unsigned int)m->client, (unsigned int)m->msg,
+                     Trace_Us(trace, m->t[TRACE_STAGE_SEND]), total, traceStageNames[stage],
+                     Trace_Us(trace, longest));
+        stalls++;
+    }
+    if (0UL == stalls)
+    {
+        (void)printf("none\n");
+    }
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* Loads the dumps and prints the summary or the timelines.
+*
+* Parameters:
+*  argc, argv: See the file description.
+*
+* Return:
+*  EXIT_SUCCESS, or EXIT_FAILURE if a dump cannot be read.
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+    cy_stc_trace_t trace;
+    cy_stc_trace_msg_t *msgs;
+    double stall = TRACE_STALL_US;
+    bool timelines = false;
+    uint32_t count;
+    int opt;
+
+    while (-1 != (opt = getopt(argc, argv, "ms:")))
+    {
+        switch (opt)
+        {
+            case 'm': timelines = true; break;
+            case 's': stall = strtod(optarg, NULL); break;
+            default:
+                (void)fprintf(stderr, "usage: %s [-m] [-s stall_us] dump.bin...\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if (optind >= argc)
+    {
+        (void)fprintf(stderr, "usage: %s [-m] [-s stall_us] dump.bin...\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (!Trace_Load(&trace, (char const *const *)&argv[optind], (uint32_t)(argc - optind)))
+    {
+        return EXIT_FAILURE;
+    }
+
+    count = Trace_Messages(&trace, &msgs);
+    if (timelines)
+    {
+        Trace_PrintTimelines(&trace, msgs, count);
+    }
+    else
+    {
+        Trace_PrintSummary(&trace, msgs, count, stall);
+    }
+
+    free(msgs);
+    Trace_Free(&trace);
+    return EXIT_SUCCESS;
+}
+
+/* [] END OF FILE */
@@ -43,78 +43,216 @@
 #include "cy_pdl.h"
 #include "cyhal.h"
 #include "cybsp.h"
+#include "ipc_topology.h"
+#include "ipc_stats.h"
+#include "ipc_trace.h"
+#include "ipc_ring.h"
+#include "ipc_credit.h"
+#include "ipc_shbuf.h"
+#include "ipc_dispatch.h"
+#include "ipc_rpc.h"
+#include "ipc_pubsub.h"
+#include "ipc_seqlock.h"
+#include "ipc_messages.h"
+#include "ipc_adapt.h"
+#include "ipc_consumer.h"
 
 /****************************************************************************
 * Constants
 *****************************************************************************/
-#define CM7_DUAL                1
-
-#define CY_IPC_MAX_ENDPOINTS            (2UL) /* 2 endpoints */
-#define CY_IPC_CYPIPE_CLIENT_CNT        (8UL)
-
-#define CY_IPC_CHAN_CYPIPE_EP0          (CY_IPC_CHAN_USER) /* IPC data channel for CYPIPE EP0 */
-#define CY_IPC_CYPIPE_CHAN_MASK_EP0     (0x0001UL << CY_IPC_CHAN_CYPIPE_EP0)
-#define CY_IPC_INTR_CYPIPE_EP0          (CY_IPC_INTR_USER)   /* IPC Intr for EP0 */
-#define CY_IPC_CYPIPE_INTR_MASK_EP0     (0x0001UL << CY_IPC_INTR_CYPIPE_EP0)   /* IPC Intr Mask for EP0 */
-#define CY_IPC_INTR_CYPIPE_PRIOR_EP0    (1UL)   /* Notifier Priority */
-#define CY_IPC_INTR_CYPIPE_MUX_EP0      (NvicMux3_IRQn)   /* Intr Mux for CM0P */
-#define CY_IPC_EP_CYPIPE_CM0_ADDR       (0UL)   /* EP0 Index of Endpoint Array */
-#define CY_CLIENT_CYPIPE0_CM0_ID0       (0UL)   /* EP0 Pipe0 (CM0 <--> CM7_0) Index of client cb Array */
-
-#define CY_IPC_CHAN_CYPIPE_EP1          (CY_IPC_CHAN_USER + 1UL) /* IPC data channel for CYPIPE EP1 */
-#define CY_IPC_CYPIPE_CHAN_MASK_EP1     (0x0001UL << CY_IPC_CHAN_CYPIPE_EP1)
-#define CY_IPC_INTR_CYPIPE_EP1          (CY_IPC_INTR_USER + 1UL)   /* IPC Intr for EP1 */
-#define CY_IPC_CYPIPE_INTR_MASK_EP1     (0x0001UL << CY_IPC_INTR_CYPIPE_EP1)   /* IPC Intr Mask for EP0 */
-#define CY_IPC_INTR_CYPIPE_PRIOR_EP1    (1UL)   /* Notifier Priority */
-#define CY_IPC_INTR_CYPIPE_MUX_EP1      (NvicMux4_IRQn)   /* Intr Mux for CM7_0 */
-#define CY_IPC_EP_CYPIPE_CM7_0_ADDR     (1UL)   /* EP1 Index of Endpoint Array */
-#define CY_CLIENT_CYPIPE0_CM7_0_ID0     (2UL)   /* EP1 Pipe0 (CM7_0 <--> CM0) Index of client cb Array */
+#define CM7_DUAL                1       /* 0: CM7_0 is the only producer */
+#define CM0_PRODUCER_CNT        (2UL)   /* CM7_0 and CM7_1 */
+#define CM0_DRAIN_BUDGET        (4UL)   /* Messages taken from one producer before moving to the next */
+#define CM0_CREDIT_WINDOW       (16UL)  /* Messages a producer may have in its ring, at most the ring depth */
+#define CM0_DEFERRED_WORK       0       /* 1: the pipe ISR only queues the work, the main loop runs the handlers */
+#define CM0_WORK_DEPTH          (8UL)   /* Deferred work queue depth, must be a power of two */
+#define CM0_ADAPTIVE_POLL       0       /* 1: the main loop polls the bulk lane while its message rate is high */
+#define CM0_POLL_WINDOW         (100000UL) /* Rate window in IPC_STATS_CLOCK() ticks */
+#define CM0_POLL_ENTER_RATE     (64UL)  /* Messages per window that switch to polling */
+#define CM0_POLL_EXIT_RATE      (16UL)  /* Messages per window below which the pipe interrupt is used again */
+#define CM0_POLL_BUDGET         (1000UL) /* Empty polls in a row that end polling */
 
+#if CM0_ADAPTIVE_POLL && CM0_DEFERRED_WORK
+#error "CM0_ADAPTIVE_POLL and CM0_DEFERRED_WORK both move the bulk lane to the main loop, enable one"
+#endif
 
-/****************************************************************************
-* The pipe configuration defines the IPC channel number, interrupt
-* number, and the pipe interrupt mask for the endpoint.
-*
-* The format of the endPoint configuration
-*   Bits[31:16] Interrupt Mask
-*   Bits[15:8 ] IPC interrupt
-*   Bits[ 7:0 ] IPC channel
-*
-*   Pipe addresses
-*   CyPipe defines
-*****************************************************************************/
-#define CY_IPC_CYPIPE_INTR_MASK   ( CY_IPC_CYPIPE_CHAN_MASK_EP0 | CY_IPC_CYPIPE_CHAN_MASK_EP1)
-
-#define CY_IPC_CYPIPE_CONFIG_EP0  ( (CY_IPC_CYPIPE_INTR_MASK << CY_IPC_PIPE_CFG_IMASK_Pos) \
-                                   | (CY_IPC_INTR_CYPIPE_EP0 << CY_IPC_PIPE_CFG_INTR_Pos) \
-                                    | CY_IPC_CHAN_CYPIPE_EP0)
-
-#define CY_IPC_CYPIPE_CONFIG_EP1  ( (CY_IPC_CYPIPE_INTR_MASK << CY_IPC_PIPE_CFG_IMASK_Pos) \
-                                   | (CY_IPC_INTR_CYPIPE_EP1 << CY_IPC_PIPE_CFG_INTR_Pos) \
-                                    | CY_IPC_CHAN_CYPIPE_EP1)
+/* Every client slot of EP0 and EP5 goes through the dispatch table */
+IPC_PORT_STATIC_ASSERT(CY_IPC_CYPIPE_CLIENT_CNT_EP0 <= CY_IPC_DISPATCH_MAX_CLIENTS, "EP0 has more clients than the dispatch table");
+IPC_PORT_STATIC_ASSERT(CY_IPC_CYPIPE_CLIENT_CNT_EP5 <= CY_IPC_DISPATCH_MAX_CLIENTS, "EP5 has more clients than the dispatch table");
 
 /*******************************************************************************
 * Global variables
 ********************************************************************************/
+/* Deferred message, copied out of the channel by the pipe ISR */
 typedef struct
 {
-    uint8_t  clientID;      /* Client ID */
-    uint8_t  pktType;       /* Message Type */
-    uint16_t intrRelMask;   /* Mask */
-} cy_stc_ipc_testmsg_t;
+    cy_stc_ipc_testmsg_t msg;   /* Message copy */
+    uint32_t received;          /* Pipe ISR entry time, used with IPC_STATS_ENABLE */
+} cy_stc_cm0_work_t;
+
+typedef struct
+{
+    bool led1;              /* LED1 state */
+    bool led2;              /* LED2 state */
+} cy_stc_led_state_t;
+
+/* LED states selected by pktType of client CM0_ID0 */
+static const cy_stc_led_state_t cm0LedStates[] =
+{
+    { CYBSP_LED_STATE_ON,  CYBSP_LED_STATE_OFF }, /* Led 1 On,  Led 2 Off */
+    { CYBSP_LED_STATE_OFF, CYBSP_LED_STATE_ON  }, /* Led 1 Off, Led 2 On  */
+    { CYBSP_LED_STATE_OFF, CYBSP_LED_STATE_OFF }, /* Led 1 Off, Led 2 Off */
+};
+
+static cy_stc_ipc_dispatch_t cm0Dispatch;   /* (clientID, pktType) handlers of the bulk lane */
+static cy_stc_ipc_dispatch_t cm0ControlDispatch; /* (clientID, pktType) handlers of the control lane */
+static cy_stc_ipc_consumer_producer_t cm0Producers[CM0_PRODUCER_CNT]; /* CM7_0, CM7_1 */
+static cy_stc_ipc_msg_rx_t cm0ProducerRx[CM0_PRODUCER_CNT]; /* Sequence of the ring messages */
+static const uint32_t cm0ProducerIdx[CM0_PRODUCER_CNT] = { 0UL, 1UL }; /* Doorbell handler contexts */
+
+/* Bulk receive endpoints, one per producer, served round-robin by the pipe ISR */
+static const uint32_t cm0BulkEndpoints[CM0_PRODUCER_CNT] =
+{
+    CY_IPC_EP_CYPIPE_CM0_ADDR,
+    CY_IPC_EP_CYPIPE_CM0_CM7_1_ADDR
+};
+static cy_stc_ipc_testmsg_t cm0RingMsg;     /* Message drained from a producer ring */
+static cy_stc_ipc_consumer_t cm0Consumer;   /* Receive side of the bulk lane */
+static uint32_t cm0ControlIsrEntry;         /* Control pipe ISR entry time, set with IPC_STATS_ENABLE */
+static volatile uint32_t cm0FrameCount;     /* Payloads received by descriptor */
+static volatile uint32_t cm0FrameChecksum;  /* Byte sum of the last payload */
+static volatile uint32_t cm0MsgErrors;      /* Messages dropped by Cy_IPC_Msg_Check() */
+#if IPC_TRACE_ENABLE
+static cy_stc_ipc_trace_t cm0Trace;         /* Events of this core, read by a debugger; CM0+ has no D-cache */
+#endif /* IPC_TRACE_ENABLE */
+
+static cy_en_ipc_rpc_status_t Cm0_GetFrameCount(uint32_t arg, uint32_t *result);
+static cy_en_ipc_rpc_status_t Cm0_GetFrameChecksum(uint32_t arg, uint32_t *result);
+
+/* Indexed by cy_en_ipc_rpc_method_t */
+static const cy_ipc_rpc_method_t cm0RpcMethods[] =
+{
+    &Cm0_GetFrameCount,
+    &Cm0_GetFrameChecksum,
+};
 
-typedef enum
+static const cy_stc_ipc_rpc_server_t cm0RpcServer =
 {
+    cm0RpcMethods,
+    sizeof(cm0RpcMethods) / sizeof(cm0RpcMethods[0]),
+    0UL,                    /* Responses travel in the ring, not through a pipe client */
     CY_IPC_PKT_FROM_CM0_TO_CM7_0,
-    CY_IPC_PKT_FROM_CM7_0_TO_CM0,
-} cy_en_ipc_pktType_t;
+    CY_IPC_CYPIPE_INTR_MASK_EP3
+};
+
+/* Response served last; held while the response ring is full */
+static cy_stc_ipc_rpc_msg_t cm0RpcResponse;
+static bool cm0RpcResponseHeld;
+
+/* LED topic of CM7_0, read in the control pipe ISR */
+static cy_stc_ipc_pubsub_sub_t cm0LedSub;
+static volatile uint32_t cm0PublishedLed;  /* LED state published last by CM7_0 */
+
+/* State region of CM7_0, read in the control pipe ISR when its doorbell rings */
+static cy_stc_ipc_seqlock_t *volatile cm0Cm7_0State;
+static cy_stc_ipc_cm7_0state_t cm0Cm7_0Snapshot;   /* Latest consistent snapshot */
+static uint32_t cm0Cm7_0StateSeq;                   /* Sequence number of the snapshot */
+static volatile uint32_t cm0StateBusy;              /* Reads that found CM7_0 updating every time */
+
+#if CM7_DUAL
+/* Hands the LED topic on to CM7_1, which has no pipe to CM7_0. CM7_1 asks
+ * with a topic message of its own; CM0+ writes the topic into it once it has
+ * both, then rings EP2. */
+static cy_stc_ipc_pubsub_topic_t *volatile cm0LedTopic;    /* Handed out by CM7_0 */
+static cy_stc_ipc_topicmsg_t *volatile cm0Cm7_1TopicRequest; /* Unanswered request of CM7_1 */
+#endif /* CM7_DUAL */
+
+#if CM0_DEFERRED_WORK
+/* Single producer (pipe ISR), single consumer (main loop) */
+static cy_stc_ipc_ring_t cm0WorkQueue;
+CY_ALIGN(IPC_PORT_CACHE_LINE) static uint8_t cm0WorkBuf[CY_IPC_RING_STORAGE_SIZE(sizeof(cy_stc_cm0_work_t), CM0_WORK_DEPTH)];
+static cy_stc_cm0_work_t cm0WorkItem;      /* Work item taken off the queue */
+#endif /* CM0_DEFERRED_WORK */
+
+#if CM0_ADAPTIVE_POLL
+static const cy_stc_ipc_adapt_config_t cm0AdaptConfig =
+{
+    CM0_POLL_WINDOW,
+    CM0_POLL_ENTER_RATE,
+    CM0_POLL_EXIT_RATE,
+    CM0_POLL_BUDGET
+};
+
+/* Receive mode of the bulk lane, and the time spent in each mode */
+static cy_stc_ipc_adapt_t cm0Adapt;
+#endif /* CM0_ADAPTIVE_POLL */
+
+void Cm0_HandleRingMsg(void *msg, uint32_t producer, uint32_t received);
+#if CM0_DEFERRED_WORK
+void Cm0_HandleWork(void *item);
+#endif /* CM0_DEFERRED_WORK */
+void Cm0_EnableBulkIrq(bool enable);
+
+static const cy_stc_ipc_consumer_config_t cm0ConsumerConfig =
+{
+    cm0BulkEndpoints,
+    cm0Producers,
+    CM0_PRODUCER_CNT,
+    CM0_DRAIN_BUDGET,
+#if CM0_DEFERRED_WORK
+    &cm0WorkQueue,
+    CM0_WORK_DEPTH,
+#else
+    NULL,
+    0UL,
+#endif /* CM0_DEFERRED_WORK */
+    &cm0RingMsg,
+#if CM0_DEFERRED_WORK
+    &cm0WorkItem,
+#else
+    NULL,
+#endif /* CM0_DEFERRED_WORK */
+    &Cm0_HandleRingMsg,
+#if CM0_DEFERRED_WORK
+    &Cm0_HandleWork,
+#else
+    NULL,
+#endif /* CM0_DEFERRED_WORK */
+    &Cm0_EnableBulkIrq,
+    NULL,
+#if IPC_TRACE_ENABLE
+    &cm0Trace
+#else
+    NULL
+#endif /* IPC_TRACE_ENABLE */
+};
 
 
 /*******************************************************************************
 * Function Prototypes
 ********************************************************************************/
 void Pipe0_cm0_RecvMsgCallback(uint32_t * msgData);
+void Pipe2_cm0_RecvMsgCallback(uint32_t * msgData);
+void Cm0_Dispatch(cy_stc_ipc_dispatch_t *dispatch, uint32_t * msgData, uint32_t received, cy_stc_ipc_msg_rx_t *rx);
+void Pipe0_cm0_LedHandler(uint32_t * msgData, void * context);
+void Pipe0_cm0_RingDoorbellHandler(uint32_t * msgData, void * context);
+void Pipe1_cm0_LoadHandler(uint32_t * msgData, void * context);
+void Pipe0_cm0_RecvDescHandler(uint32_t * msgData, void * context);
+void Pipe2_cm0_RpcRequestHandler(uint32_t * msgData, void * context);
+void Pipe2_cm0_RingRpcDoorbell(void);
+void Pipe2_cm0_TopicHandler(uint32_t * msgData, void * context);
+#if CM7_DUAL
+void Pipe1_cm0_TopicRequestHandler(uint32_t * msgData, void * context);
+void Cm0_HandOnTopic(void);
+#endif /* CM7_DUAL */
+void Cm0_ReceiveLedTopic(void);
+void Pipe2_cm0_StateHandler(uint32_t * msgData, void * context);
+void Cm0_ReadCm7_0State(void);
+#if CM0_DEFERRED_WORK
+void Pipe0_cm0_DeferMsgCallback(uint32_t * msgData);
+#endif /* CM0_DEFERRED_WORK */
 void Cy_SysIpcPipeIsrCm0(void);
+void Cy_SysIpcPipeIsrCm0Control(void);
 
 /*******************************************************************************
 * Function Name: main
@@ -132,33 +270,26 @@ void Cy_SysIpcPipeIsrCm0(void);
 int main(void)
 {
     cy_rslt_t result;
+    uint32_t i;
+#if CM0_DEFERRED_WORK
+    uint32_t interruptState;
+#endif /* CM0_DEFERRED_WORK */
     static cy_stc_ipc_pipe_ep_t IpcPipeEpArray[CY_IPC_MAX_ENDPOINTS]; /* Create an array of endpoint structures */
-    static cy_ipc_pipe_callback_ptr_t ep0CbArray[CY_IPC_CYPIPE_CLIENT_CNT]; /* CB Array for EP0 */
+    static cy_ipc_pipe_callback_ptr_t ep0CbArray[CY_IPC_CYPIPE_CLIENT_CNT_EP0]; /* CB Array for EP0 */
+    static cy_ipc_pipe_callback_ptr_t ep3CbArray[CY_IPC_CYPIPE_CLIENT_CNT_EP3]; /* CB Array for EP3 */
+    static cy_ipc_pipe_callback_ptr_t ep5CbArray[CY_IPC_CYPIPE_CLIENT_CNT_EP5]; /* CB Array for EP5 */
 
     /* Pipe0 endpoint-0 and endpoint-1. CM0 <--> CM7_0 */
     static const cy_stc_ipc_pipe_config_t systemIpcPipe0ConfigCm0 =
-    {
-        /* receiver endpoint */
-        {
-            CY_IPC_INTR_CYPIPE_EP0,        /* .ipcNotifierNumber    */
-            CY_IPC_INTR_CYPIPE_PRIOR_EP0,  /* .ipcNotifierPriority  */
-            CY_IPC_INTR_CYPIPE_MUX_EP0,    /* .ipcNotifierMuxNumber */
-            CY_IPC_EP_CYPIPE_CM0_ADDR,     /* .epAddress            */
-            CY_IPC_CYPIPE_CONFIG_EP0       /* .epConfig             */
-        },
-        /* sender endpoint */
-        {
-            CY_IPC_INTR_CYPIPE_EP1,        /* .ipcNotifierNumber    */
-            CY_IPC_INTR_CYPIPE_PRIOR_EP1,  /* .ipcNotifierPriority  */
-            CY_IPC_INTR_CYPIPE_MUX_EP1,    /* .ipcNotifierMuxNumber */
-            CY_IPC_EP_CYPIPE_CM7_0_ADDR,   /* .epAddress            */
-            CY_IPC_CYPIPE_CONFIG_EP1       /* .epConfig             */
-        },
-
-        CY_IPC_CYPIPE_CLIENT_CNT, /* .endpointClientsCount     */
-        ep0CbArray,               /* .endpointsCallbacksArray  */
-        &Cy_SysIpcPipeIsrCm0      /* .userPipeIsrHandler       */
-    };
+        CY_IPC_CYPIPE_PIPE_CONFIG(0, 1, ep0CbArray, &Cy_SysIpcPipeIsrCm0);
+
+    /* Pipe1 endpoint-5 and endpoint-2. CM0 <--> CM7_1, same ISR as Pipe0 */
+    static const cy_stc_ipc_pipe_config_t systemIpcPipe1ConfigCm0 =
+        CY_IPC_CYPIPE_PIPE_CONFIG(5, 2, ep5CbArray, &Cy_SysIpcPipeIsrCm0);
+
+    /* Pipe2 endpoint-3 and endpoint-4. CM0 <--> CM7_0 control lane, preempts both pipes above */
+    static const cy_stc_ipc_pipe_config_t systemIpcPipe2ConfigCm0 =
+        CY_IPC_CYPIPE_PIPE_CONFIG(3, 4, ep3CbArray, &Cy_SysIpcPipeIsrCm0Control);
 
     /* Initialize the device and board peripherals */
     result = cybsp_init();
@@ -167,14 +298,70 @@ int main(void)
         CY_ASSERT(0);
     }
 
+#if IPC_TRACE_ENABLE
+    Cy_IPC_Trace_Init(&cm0Trace, CY_IPC_CORE_CM0P);
+#endif /* IPC_TRACE_ENABLE */
+
     /* enable interrupts */
     __enable_irq();
 
     Cy_IPC_Pipe_Config(IpcPipeEpArray);
 
+    /* Handlers can also be added or removed later while the pipe is running */
+    Cy_IPC_Dispatch_Init(&cm0Dispatch);
+    for (i = 0UL; i < (sizeof(cm0LedStates) / sizeof(cm0LedStates[0])); i++)
+    {
+        (void)Cy_IPC_Dispatch_Register(&cm0Dispatch, CY_CLIENT_CYPIPE0_CM0_ID0, i, &Pipe0_cm0_LedHandler, (void *)&cm0LedStates[i]);
+    }
+    (void)Cy_IPC_Dispatch_Register(&cm0Dispatch, CY_CLIENT_CYPIPE0_CM0_ID1, CY_IPC_PKT_FROM_CM7_0_TO_CM0, &Pipe0_cm0_RingDoorbellHandler, (void *)&cm0ProducerIdx[0]);
+    (void)Cy_IPC_Dispatch_Register(&cm0Dispatch, CY_CLIENT_CYPIPE0_CM0_ID2, CY_IPC_PKT_FROM_CM7_0_TO_CM0, &Pipe0_cm0_RecvDescHandler, NULL);
+    (void)Cy_IPC_Dispatch_Register(&cm0Dispatch, CY_CLIENT_CYPIPE1_CM0_ID4, CY_IPC_PKT_FROM_CM7_1_TO_CM0, &Pipe0_cm0_RingDoorbellHandler, (void *)&cm0ProducerIdx[1]);
+    (void)Cy_IPC_Dispatch_Register(&cm0Dispatch, CY_CLIENT_CYPIPE1_CM0_ID5, CY_IPC_PKT_FROM_CM7_1_TO_CM0, &Pipe1_cm0_LoadHandler, NULL);
+#if CM7_DUAL
+    (void)Cy_IPC_Dispatch_Register(&cm0Dispatch, CY_CLIENT_CYPIPE1_CM0_ID6, CY_IPC_PKT_FROM_CM7_1_TO_CM0, &Pipe1_cm0_TopicRequestHandler, NULL);
+#endif /* CM7_DUAL */
+
+    Cy_IPC_Dispatch_Init(&cm0ControlDispatch);
+    (void)Cy_IPC_Dispatch_Register(&cm0ControlDispatch, CY_CLIENT_CYPIPE2_CM0_ID0, CY_IPC_PKT_FROM_CM7_0_TO_CM0, &Pipe2_cm0_RpcRequestHandler, NULL);
+    (void)Cy_IPC_Dispatch_Register(&cm0ControlDispatch, CY_CLIENT_CYPIPE2_CM0_ID1, CY_IPC_PKT_FROM_CM7_0_TO_CM0, &Pipe2_cm0_TopicHandler, NULL);
+    (void)Cy_IPC_Dispatch_Register(&cm0ControlDispatch, CY_CLIENT_CYPIPE2_CM0_ID2, CY_IPC_PKT_FROM_CM7_0_TO_CM0, &Pipe2_cm0_StateHandler, NULL);
+
+#if CM0_DEFERRED_WORK
+    (void)Cy_IPC_Ring_Init(&cm0WorkQueue, cm0WorkBuf, sizeof(cy_stc_cm0_work_t), CM0_WORK_DEPTH);
+#endif /* CM0_DEFERRED_WORK */
+    Cy_IPC_Consumer_Init(&cm0Consumer, &cm0ConsumerConfig);
+
     Cy_IPC_Pipe_Init(&systemIpcPipe0ConfigCm0); /* PIPE-0 EP0 <--> EP1 */
-    Cy_IPC_Pipe_RegisterCallback(CY_IPC_EP_CYPIPE_CM0_ADDR, &Pipe0_cm0_RecvMsgCallback, (uint32_t)CY_CLIENT_CYPIPE0_CM0_ID0);
+    Cy_IPC_Pipe_Init(&systemIpcPipe1ConfigCm0); /* PIPE-1 EP5 <--> EP2 */
+    for (i = 0UL; i < CY_IPC_CYPIPE_CLIENT_CNT_EP0; i++)
+    {
+        Cy_IPC_Pipe_RegisterCallback(CY_IPC_EP_CYPIPE_CM0_ADDR, &Pipe0_cm0_RecvMsgCallback, i);
+    }
+    for (i = 0UL; i < CY_IPC_CYPIPE_CLIENT_CNT_EP5; i++)
+    {
+        Cy_IPC_Pipe_RegisterCallback(CY_IPC_EP_CYPIPE_CM0_CM7_1_ADDR, &Pipe0_cm0_RecvMsgCallback, i);
+    }
+    Cy_IPC_Pipe_Init(&systemIpcPipe2ConfigCm0); /* PIPE-2 EP3 <--> EP4 */
+    Cy_IPC_Pipe_RegisterCallback(CY_IPC_EP_CYPIPE_CM0_CTL_ADDR, &Pipe2_cm0_RecvMsgCallback, CY_CLIENT_CYPIPE2_CM0_ID0);
+    Cy_IPC_Pipe_RegisterCallback(CY_IPC_EP_CYPIPE_CM0_CTL_ADDR, &Pipe2_cm0_RecvMsgCallback, CY_CLIENT_CYPIPE2_CM0_ID1);
+    Cy_IPC_Pipe_RegisterCallback(CY_IPC_EP_CYPIPE_CM0_CTL_ADDR, &Pipe2_cm0_RecvMsgCallback, CY_CLIENT_CYPIPE2_CM0_ID2);
+#if CM0_DEFERRED_WORK
+    /* Self-contained messages are copied and released at once. Doorbells only
+     * note the ring in the ISR. Descriptors stay in the ISR: their sender
+     * relies on the release meaning that the payload is consumed. */
+    Cy_IPC_Pipe_RegisterCallback(CY_IPC_EP_CYPIPE_CM0_ADDR, &Pipe0_cm0_DeferMsgCallback, CY_CLIENT_CYPIPE0_CM0_ID0);
+    Cy_IPC_Pipe_RegisterCallback(CY_IPC_EP_CYPIPE_CM0_CM7_1_ADDR, &Pipe0_cm0_DeferMsgCallback, CY_CLIENT_CYPIPE1_CM0_ID5);
+#endif /* CM0_DEFERRED_WORK */
+
 
+#if IPC_STATS_ENABLE || IPC_TRACE_ENABLE || CM0_ADAPTIVE_POLL
+    /* Shared timestamp counter, must run before the CM7 cores send */
+    Cy_IPC_Stats_StartClock();
+#endif /* IPC_STATS_ENABLE || IPC_TRACE_ENABLE || CM0_ADAPTIVE_POLL */
+
+#if CM0_ADAPTIVE_POLL
+    Cy_IPC_Adapt_Init(&cm0Adapt, &cm0AdaptConfig, IPC_STATS_CLOCK());
+#endif /* CM0_ADAPTIVE_POLL */
 
     /* Enable CM7_0/1. CY_CORTEX_M7_APPL_ADDR is calculated in linker script, check it in case of problems. */
     Cy_SysEnableCM7(CORE_CM7_0, CY_CORTEX_M7_0_APPL_ADDR);
@@ -191,7 +378,24 @@ int main(void)
 
     for(;;)
     {
+#if CM0_DEFERRED_WORK
+        Cy_IPC_Consumer_RunDeferred(&cm0Consumer);
 
+        /* Sleep unless the pipe ISR queued work since the run */
+        interruptState = Cy_SysLib_EnterCriticalSection();
+        if (Cy_IPC_Consumer_IsIdle(&cm0Consumer))
+        {
+            __WFI();
+        }
+        Cy_SysLib_ExitCriticalSection(interruptState);
+#endif /* CM0_DEFERRED_WORK */
+#if CM0_ADAPTIVE_POLL
+        Cy_IPC_Consumer_RunAdaptive(&cm0Consumer, &cm0Adapt);
+#endif /* CM0_ADAPTIVE_POLL */
+#if !CM0_DEFERRED_WORK && !CM0_ADAPTIVE_POLL
+        /* Every message is handled in the pipe ISRs */
+        __WFI();
+#endif /* !CM0_DEFERRED_WORK && !CM0_ADAPTIVE_POLL */
     }
 }
 
@@ -199,44 +403,626 @@ int main(void)
 * Function Name: Pipe0_cm0_RecvMsgCallback
 ********************************************************************************
 * Summary:
-* Called when the Pipe0 endpoint-0 (CM0) has received a message..
+* Called when the Pipe0 endpoint-0 or the Pipe1 endpoint-5 (CM0) has received
+* a message. Every client slot of both endpoints points here; the message is
+* routed to the handler registered for its (clientID, pktType).
 *
 * Parameters:
-*  None
+*  msgData: Received message
 *
 * Return:
 *  None
 *******************************************************************************/
 void Pipe0_cm0_RecvMsgCallback(uint32_t * msgData)
 {
+#if CM0_ADAPTIVE_POLL
+    Cy_IPC_Adapt_Arrived(&cm0Adapt, 1UL);
+#endif /* CM0_ADAPTIVE_POLL */
+    Cm0_Dispatch(&cm0Dispatch, msgData, cm0Consumer.received, NULL);
+}
+
+/*******************************************************************************
+* Function Name: Pipe2_cm0_RecvMsgCallback
+********************************************************************************
+* Summary:
+* Called when the Pipe2 endpoint-3 (CM0 control lane) has received a message.
+* Runs in the control pipe ISR, which can preempt the handlers of the bulk
+* lane.
+*
+* Parameters:
+*  msgData: Received message
+*
+* Return:
+*  None
+*******************************************************************************/
+void Pipe2_cm0_RecvMsgCallback(uint32_t * msgData)
+{
+    Cm0_Dispatch(&cm0ControlDispatch, msgData, cm0ControlIsrEntry, NULL);
+}
+
+#if CM0_DEFERRED_WORK
+/*******************************************************************************
+* Function Name: Pipe0_cm0_DeferMsgCallback
+********************************************************************************
+* Summary:
+* Copies the message into the work queue; the channel is released as soon as
+* this returns and the main loop runs the handler. Should the queue be full,
+* the bulk interrupts stay disabled until the main loop has made room, and
+* the message is handled here, while the callback still holds the channel.
+*
+* Parameters:
+*  msgData: Received message
+*
+* Return:
+*  None
+*******************************************************************************/
+void Pipe0_cm0_DeferMsgCallback(uint32_t * msgData)
+{
+    cy_stc_cm0_work_t work;
+
+    work.msg = *(cy_stc_ipc_testmsg_t *)msgData;
+    work.received = cm0Consumer.received;
+    if (!Cy_IPC_Consumer_Defer(&cm0Consumer, &work))
+    {
+        Cm0_Dispatch(&cm0Dispatch, msgData, work.received, NULL);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Cm0_HandleWork
+********************************************************************************
+* Summary:
+* Runs the handler of a message taken off the work queue by the main loop.
+*
+* Parameters:
+*  item: Work item (cy_stc_cm0_work_t)
+*
+* Return:
+*  None
+*******************************************************************************/
+void Cm0_HandleWork(void *item)
+{
+    cy_stc_cm0_work_t *pWork = (cy_stc_cm0_work_t *)item;
+
+    Cm0_Dispatch(&cm0Dispatch, (uint32_t *)&pWork->msg, pWork->received, NULL);
+}
+#endif /* CM0_DEFERRED_WORK */
+
+/*******************************************************************************
+* Function Name: Cm0_Dispatch
+********************************************************************************
+* Summary:
+* Routes a message to its handler. The message is checked in place first; a
+* message with a bad header, CRC or a stale sequence is dropped and counted in
+* cm0MsgErrors. With IPC_STATS_ENABLE the NOTIFY, ISR and CALLBACK stages are
+* recorded in the stats block of the sender; for deferred work the ISR stage
+* includes the time spent in the work queue. The sender stamps each lane with
+* its own stats block.
+*
+* Parameters:
+*  dispatch: Handler table of the lane
+*  msgData: Message received through the pipe or popped from a ring
+*  received: Entry time of the pipe ISR that received it
+*  rx: Stream of a ring message, NULL for a pipe message
+*
+* Return:
+*  None
+*******************************************************************************/
+void Cm0_Dispatch(cy_stc_ipc_dispatch_t *dispatch, uint32_t * msgData, uint32_t received, cy_stc_ipc_msg_rx_t *rx)
+{
+    cy_en_ipc_msg_status_t msgStatus = Cy_IPC_Msg_Check(msgData, CY_IPC_MESSAGES_MAX_LENGTH, rx);
+#if IPC_STATS_ENABLE
+    cy_stc_ipc_stats_t *pStats = ((const cy_stc_ipc_msg_t *)msgData)->stamp.stats;
+    IPC_STATS_TIME(start);
+#endif /* IPC_STATS_ENABLE */
+#if IPC_TRACE_ENABLE
+    uint32_t client = ((const cy_stc_ipc_msg_hdr_t *)msgData)->clientID;
+    uint32_t ep = (&cm0ControlDispatch == dispatch) ? CY_IPC_EP_CYPIPE_CM0_CTL_ADDR :
+                  ((CY_CLIENT_CYPIPE1_CM0_ID4 == client) || (CY_CLIENT_CYPIPE1_CM0_ID5 == client) ||
+                   (CY_CLIENT_CYPIPE1_CM0_ID6 == client)) ? CY_IPC_EP_CYPIPE_CM0_CM7_1_ADDR :
+                  CY_IPC_EP_CYPIPE_CM0_ADDR;
+    IPC_TRACE_TIME(handlerStart);
+#endif /* IPC_TRACE_ENABLE */
+
+    if ((CY_IPC_MSG_SUCCESS != msgStatus) && (CY_IPC_MSG_GAP != msgStatus))
+    {
+        IPC_TRACE(&cm0Trace, CY_IPC_TRACE_ERROR, ep, client, msgData, (uint32_t)msgStatus);
+        cm0MsgErrors++;
+        return;
+    }
+
+#if IPC_STATS_ENABLE
+    Cy_IPC_Stats_Received(msgData, received, start);
+#else
+    (void)received;
+#endif /* IPC_STATS_ENABLE */
 
-    cy_stc_ipc_testmsg_t *pData = (cy_stc_ipc_testmsg_t*)msgData;
+    (void)Cy_IPC_Dispatch_Message(dispatch, msgData);
 
-    switch(pData->pktType)
+#if IPC_STATS_ENABLE
+    if (NULL != pStats)
     {
-        case 0:
-            cyhal_gpio_write(CYBSP_USER_LED, CYBSP_LED_STATE_ON);   /* Led 1 On */
-            cyhal_gpio_write(CYBSP_USER_LED2, CYBSP_LED_STATE_OFF); /* Led 2 Off */
-            break;
-        case 1:
-            cyhal_gpio_write(CYBSP_USER_LED, CYBSP_LED_STATE_OFF);  /* Led 1 Off */
-            cyhal_gpio_write(CYBSP_USER_LED2, CYBSP_LED_STATE_ON);  /* Led 2 On */
-            break;
-        case 2:
-            cyhal_gpio_write(CYBSP_USER_LED, CYBSP_LED_STATE_OFF);  /* Led 1 Off */
-            cyhal_gpio_write(CYBSP_USER_LED2, CYBSP_LED_STATE_OFF); /* Led 2 Off */
-            break;
-        default:
-            break;
+        IPC_STATS_RECORD(pStats, CY_IPC_STATS_STAGE_CALLBACK, start);
     }
+#endif /* IPC_STATS_ENABLE */
+
+    IPC_TRACE_CALLBACK(&cm0Trace, ep, client, msgData, handlerStart);
+}
+
+/*******************************************************************************
+* Function Name: Pipe0_cm0_LedHandler
+********************************************************************************
+* Summary:
+* Sets the LEDs to the state registered for the received pktType.
+*
+* Parameters:
+*  msgData: Received message
+*  context: LED state (cy_stc_led_state_t)
+*
+* Return:
+*  None
+*******************************************************************************/
+void Pipe0_cm0_LedHandler(uint32_t * msgData, void * context)
+{
+    const cy_stc_led_state_t *pState = (const cy_stc_led_state_t *)context;
+
+    (void)msgData;
+    cyhal_gpio_write(CYBSP_USER_LED, pState->led1);
+    cyhal_gpio_write(CYBSP_USER_LED2, pState->led2);
+}
+
+/*******************************************************************************
+* Function Name: Pipe0_cm0_RingDoorbellHandler
+********************************************************************************
+* Summary:
+* Called when CM7_0 or CM7_1 rings the doorbell of its shared ring. The ring
+* of every producer is drained before the channel is released, or by the main
+* loop with CM0_DEFERRED_WORK. The first doorbell of a producer grants it
+* CM0_CREDIT_WINDOW credits.
+*
+* Parameters:
+*  msgData: Doorbell message
+*  context: Index of the producer that rang (uint32_t)
+*
+* Return:
+*  None
+*******************************************************************************/
+void Pipe0_cm0_RingDoorbellHandler(uint32_t * msgData, void * context)
+{
+    const cy_stc_ipc_doorbellmsg_t *pDoorbell = Cy_IPC_Msg_GetDoorbell(msgData);
+
+    if (NULL == pDoorbell)
+    {
+        return;
+    }
+
+    Cy_IPC_Consumer_Attach(&cm0Consumer, *(const uint32_t *)context, pDoorbell->payload.ring,
+                           pDoorbell->payload.credit, CM0_CREDIT_WINDOW);
+#if CM0_DEFERRED_WORK
+    Cy_IPC_Consumer_DrainLater(&cm0Consumer, cm0Consumer.received);
+#else
+    Cy_IPC_Consumer_Drain(&cm0Consumer, cm0Consumer.received);
+#endif /* CM0_DEFERRED_WORK */
+}
+
+/*******************************************************************************
+* Function Name: Cm0_HandleRingMsg
+********************************************************************************
+* Summary:
+* Routes a message drained from the ring of a producer. The drain in
+* shared/source/ipc_consumer.c takes the rings round-robin, CM0_DRAIN_BUDGET
+* messages at a time, and grants the credits back.
+*
+* Parameters:
+*  msg: Ring message (cy_stc_ipc_testmsg_t)
+*  producer: Index of the producer
+*  received: Entry time of the pipe ISR that took the doorbell
+*
+* Return:
+*  None
+*******************************************************************************/
+void Cm0_HandleRingMsg(void *msg, uint32_t producer, uint32_t received)
+{
+#if CM0_ADAPTIVE_POLL
+    Cy_IPC_Adapt_Arrived(&cm0Adapt, 1UL);
+#endif /* CM0_ADAPTIVE_POLL */
+    Cm0_Dispatch(&cm0Dispatch, (uint32_t *)msg, received, &cm0ProducerRx[producer]);
+}
 
+/*******************************************************************************
+* Function Name: Pipe1_cm0_LoadHandler
+********************************************************************************
+* Summary:
+* Consumes the load messages streamed by CM7_1. They carry no data; the drain
+* counts them per producer in cm0Producers.
+*
+* Parameters:
+*  msgData: Received message
+*  context: Not used
+*
+* Return:
+*  None
+*******************************************************************************/
+void Pipe1_cm0_LoadHandler(uint32_t * msgData, void * context)
+{
+    (void)msgData;
+    (void)context;
+}
+
+/*******************************************************************************
+* Function Name: Pipe0_cm0_RecvDescHandler
+********************************************************************************
+* Summary:
+* Called when CM7_0 passes a payload by descriptor. The payload is processed
+* in place in the shared buffer pool; ownership returns to CM7_0 when the
+* channel is released after this callback.
+*
+* Parameters:
+*  msgData: Buffer descriptor message
+*  context: Not used
+*
+* Return:
+*  None
+*******************************************************************************/
+void Pipe0_cm0_RecvDescHandler(uint32_t * msgData, void * context)
+{
+    const cy_stc_ipc_descmsg_t *pDesc = Cy_IPC_Msg_GetDesc(msgData);
+    const uint8_t *payload = NULL;
+    uint32_t sum = 0UL;
+    uint32_t i;
+
+    if (NULL != pDesc)
+    {
+        payload = Cy_IPC_ShBuf_Access(pDesc->payload.pool, pDesc->payload.offset, pDesc->payload.length);
+    }
+    if (NULL != payload)
+    {
+        for (i = 0UL; i < pDesc->payload.length; i++)
+        {
+            sum += payload[i];
+        }
+        cm0FrameChecksum = sum;
+        cm0FrameCount++;
+    }
+    (void)context;
+}
+
+/*******************************************************************************
+* Function Name: Pipe2_cm0_RpcRequestHandler
+********************************************************************************
+* Summary:
+* Serves every queued RPC request from CM7_0 and queues the responses. The
+* response ring is as deep as the number of requests CM7_0 can have
+* outstanding, so it should never be full. If it is, the response is held
+* and draining stops; the held response is pushed first on the next
+* doorbell, and the requests behind it wait in their ring. CM7_0 is rung
+* either way, so it completes the responses that filled the ring.
+*
+* Parameters:
+*  msgData: RPC doorbell (cy_stc_ipc_rpcdoorbellmsg_t)
+*  context: Not used
+*
+* Return:
+*  None
+*******************************************************************************/
+void Pipe2_cm0_RpcRequestHandler(uint32_t * msgData, void * context)
+{
+    const cy_stc_ipc_rpcdoorbellmsg_t *pDoorbell = Cy_IPC_Msg_GetRpcDoorbell(msgData);
+    cy_stc_ipc_rpc_msg_t request;
+    bool served = false;
+
+    if (NULL != pDoorbell)
+    {
+        if (cm0RpcResponseHeld && (CY_IPC_RING_SUCCESS == Cy_IPC_Ring_Push(pDoorbell->payload.response, &cm0RpcResponse)))
+        {
+            cm0RpcResponseHeld = false;
+            served = true;
+        }
+
+        while (!cm0RpcResponseHeld && (CY_IPC_RING_SUCCESS == Cy_IPC_Ring_Pop(pDoorbell->payload.request, &request)))
+        {
+            Cy_IPC_Rpc_Serve(&cm0RpcServer, &request, &cm0RpcResponse);
+            cm0RpcResponseHeld = (CY_IPC_RING_SUCCESS != Cy_IPC_Ring_Push(pDoorbell->payload.response, &cm0RpcResponse));
+            served = true;
+        }
+    }
+
+    if (served || cm0RpcResponseHeld)
+    {
+        Pipe2_cm0_RingRpcDoorbell();
+    }
+    (void)context;
+}
+
+/*******************************************************************************
+* Function Name: Pipe2_cm0_TopicHandler
+********************************************************************************
+* Summary:
+* CM7_0 hands out its LED topic. CM0+ subscribes in the slot given by the
+* message, notified on the control interrupt, and hands the topic on to
+* CM7_1 as soon as CM7_1 has asked for it.
+*
+* Parameters:
+*  msgData: Topic message
+*  context: Not used
+*
+* Return:
+*  None
+*******************************************************************************/
+void Pipe2_cm0_TopicHandler(uint32_t * msgData, void * context)
+{
+    const cy_stc_ipc_topicmsg_t *pTopic = Cy_IPC_Msg_GetTopic(msgData);
+
+    (void)context;
+    if ((NULL == pTopic) ||
+        (CY_IPC_PUBSUB_SUCCESS != Cy_IPC_PubSub_Subscribe(&cm0LedSub, pTopic->payload.topic, pTopic->payload.subscriber, CY_IPC_CYPIPE_INTR_MASK_EP3)))
+    {
+        return;
+    }
+
+#if CM7_DUAL
+    cm0LedTopic = pTopic->payload.topic;
+    Cm0_HandOnTopic();
+#endif /* CM7_DUAL */
+}
+
+#if CM7_DUAL
+/*******************************************************************************
+* Function Name: Pipe1_cm0_TopicRequestHandler
+********************************************************************************
+* Summary:
+* CM7_1 asks for the LED topic. Its message stays with CM0+ after the
+* release: it is answered in place, now or once CM7_0 has handed out the
+* topic.
+*
+* Parameters:
+*  msgData: Topic message of CM7_1
+*  context: Not used
+*
+* Return:
+*  None
+*******************************************************************************/
+void Pipe1_cm0_TopicRequestHandler(uint32_t * msgData, void * context)
+{
+    (void)context;
+    if (NULL != Cy_IPC_Msg_GetTopic(msgData))
+    {
+        cm0Cm7_1TopicRequest = (cy_stc_ipc_topicmsg_t *)msgData;
+        Cm0_HandOnTopic();
+    }
+}
+
+/*******************************************************************************
+* Function Name: Cm0_HandOnTopic
+********************************************************************************
+* Summary:
+* Answers the topic request of CM7_1 once the topic is known: writes the
+* topic and the subscriber slot of CM7_1 into the request and rings EP2.
+* Called from the control pipe ISR and from the bulk pipe ISR, which the
+* former preempts; whichever comes second answers, exactly once. The
+* doorbell cannot be refused, so nothing is left to retry.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Cm0_HandOnTopic(void)
+{
+    cy_stc_ipc_topicmsg_t *pRequest = NULL;
+    uint32_t interruptState;
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    if ((NULL != cm0LedTopic) && (NULL != cm0Cm7_1TopicRequest))
+    {
+        pRequest = cm0Cm7_1TopicRequest;
+        cm0Cm7_1TopicRequest = NULL;
+    }
+    Cy_SysLib_ExitCriticalSection(interruptState);
+
+    if (NULL != pRequest)
+    {
+        pRequest->payload.topic = cm0LedTopic;
+        pRequest->payload.subscriber = CY_IPC_TOPIC_LED_SUB_CM7_1;
+        Cy_IPC_Msg_Seal(pRequest, NULL);
+        IPC_TRACE(&cm0Trace, CY_IPC_TRACE_NOTIFY, CY_IPC_EP_CYPIPE_CM7_1_ADDR, CY_CLIENT_CYPIPE1_CM0_ID6, pRequest, CY_IPC_CYPIPE_INTR_MASK_EP2);
+        Cy_IPC_Drv_AcquireNotify(Cy_IPC_Drv_GetIpcBaseAddress(CY_IPC_CHAN_CYPIPE_EP2), CY_IPC_CYPIPE_INTR_MASK_EP2);
+    }
+}
+#endif /* CM7_DUAL */
+
+/*******************************************************************************
+* Function Name: Cm0_ReceiveLedTopic
+********************************************************************************
+* Summary:
+* Takes the LED states published by CM7_0 since the last notification and
+* releases them, so CM7_0 can reuse their slots.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Cm0_ReceiveLedTopic(void)
+{
+    const cy_stc_ipc_ledstate_t *pState;
+    uint32_t length = 0UL;
+
+    pState = (const cy_stc_ipc_ledstate_t *)Cy_IPC_PubSub_Receive(&cm0LedSub, &length);
+    while (NULL != pState)
+    {
+        if (sizeof(*pState) == length)
+        {
+            cm0PublishedLed = pState->led;
+        }
+        Cy_IPC_PubSub_Release(&cm0LedSub);
+        pState = (const cy_stc_ipc_ledstate_t *)Cy_IPC_PubSub_Receive(&cm0LedSub, &length);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Pipe2_cm0_StateHandler
+********************************************************************************
+* Summary:
+* CM7_0 hands out its state region. CM0+ reads it from then on whenever the
+* doorbell of the region rings.
+*
+* Parameters:
+*  msgData: State message
+*  context: Not used
+*
+* Return:
+*  None
+*******************************************************************************/
+void Pipe2_cm0_StateHandler(uint32_t * msgData, void * context)
+{
+    const cy_stc_ipc_statemsg_t *pState = Cy_IPC_Msg_GetState(msgData);
+
+    (void)context;
+    if ((NULL != pState) && (NULL != pState->payload.state))
+    {
+        cm0Cm7_0State = pState->payload.state;
+        Cm0_ReadCm7_0State();
+    }
+}
+
+/*******************************************************************************
+* Function Name: Cm0_ReadCm7_0State
+********************************************************************************
+* Summary:
+* Copies the latest state of CM7_0 if it changed since the last copy. A copy
+* torn by an update in progress is retried; if CM7_0 keeps updating, the
+* old snapshot stays and the next doorbell tries again.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Cm0_ReadCm7_0State(void)
+{
+    cy_stc_ipc_seqlock_t *state = cm0Cm7_0State;
+    cy_stc_ipc_cm7_0state_t snapshot;
+    uint32_t seq;
+
+    if ((NULL == state) || !Cy_IPC_Seqlock_Changed(state, cm0Cm7_0StateSeq))
+    {
+        return;
+    }
+
+    if (CY_IPC_SEQLOCK_SUCCESS == Cy_IPC_Seqlock_Read(state, &snapshot, &seq))
+    {
+        cm0Cm7_0Snapshot = snapshot;
+        cm0Cm7_0StateSeq = seq;
+    }
+    else
+    {
+        cm0StateBusy++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: Pipe2_cm0_RingRpcDoorbell
+********************************************************************************
+* Summary:
+* Tells CM7_0 that responses are queued. This is a bare notify on the
+* interrupt of EP4 without a message, so it never finds the pipe busy. CM7_0
+* drains the whole ring, so notifies that coalesce lose nothing.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Pipe2_cm0_RingRpcDoorbell(void)
+{
+    IPC_TRACE(&cm0Trace, CY_IPC_TRACE_NOTIFY, CY_IPC_EP_CYPIPE_CM7_0_CTL_ADDR, CY_IPC_TRACE_NO_CLIENT, NULL, CY_IPC_CYPIPE_INTR_MASK_EP4);
+    Cy_IPC_Drv_AcquireNotify(Cy_IPC_Drv_GetIpcBaseAddress(CY_IPC_CHAN_CYPIPE_EP4), CY_IPC_CYPIPE_INTR_MASK_EP4);
+}
+
+/*******************************************************************************
+* Function Name: Cm0_GetFrameCount
+********************************************************************************
+* Summary:
+* RPC method CY_IPC_RPC_METHOD_GET_FRAME_COUNT.
+*
+* Parameters:
+*  arg: Not used
+*  result: Receives the number of payloads received by descriptor
+*
+* Return:
+*  CY_IPC_RPC_SUCCESS
+*******************************************************************************/
+static cy_en_ipc_rpc_status_t Cm0_GetFrameCount(uint32_t arg, uint32_t *result)
+{
+    (void)arg;
+    *result = cm0FrameCount;
+
+    return CY_IPC_RPC_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: Cm0_GetFrameChecksum
+********************************************************************************
+* Summary:
+* RPC method CY_IPC_RPC_METHOD_GET_FRAME_CHECKSUM.
+*
+* Parameters:
+*  arg: Not used
+*  result: Receives the byte sum of the last payload
+*
+* Return:
+*  CY_IPC_RPC_SUCCESS
+*******************************************************************************/
+static cy_en_ipc_rpc_status_t Cm0_GetFrameChecksum(uint32_t arg, uint32_t *result)
+{
+    (void)arg;
+    *result = cm0FrameChecksum;
+
+    return CY_IPC_RPC_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: Cm0_EnableBulkIrq
+********************************************************************************
+* Summary:
+* Enables or disables the CPU interrupts of both bulk endpoints, EP0 and EP5.
+* A message that arrives while they are disabled stays in its channel.
+*
+* Parameters:
+*  enable: true to enable, false to disable
+*
+* Return:
+*  None
+*******************************************************************************/
+void Cm0_EnableBulkIrq(bool enable)
+{
+    if (enable)
+    {
+        NVIC_EnableIRQ(CY_IPC_CYPIPE_MUX(0));
+        NVIC_EnableIRQ(CY_IPC_CYPIPE_MUX(5));
+    }
+    else
+    {
+        NVIC_DisableIRQ(CY_IPC_CYPIPE_MUX(0));
+        NVIC_DisableIRQ(CY_IPC_CYPIPE_MUX(5));
+    }
 }
 
 /*******************************************************************************
 * Function Name: Cy_SysIpcPipeIsrCm0
 ********************************************************************************
 * Summary:
-* This is the interrupt service routine.
+* This is the interrupt service routine of both bulk endpoints, EP0 (CM7_0)
+* and EP5 (CM7_1). They have the same priority, and the interrupt controller
+* would always take the lower interrupt number first; instead each entry
+* takes the waiting message of both endpoints, starting with the one served
+* second last time, so a saturating producer cannot starve the other. The
+* service itself is Cy_IPC_Consumer_Isr(), shared with the host bench.
 *
 * Parameters:
 *  None
@@ -246,7 +1032,36 @@ void Pipe0_cm0_RecvMsgCallback(uint32_t * msgData)
 *******************************************************************************/
 void Cy_SysIpcPipeIsrCm0(void)
 {
-    Cy_IPC_Pipe_ExecuteCallback(CY_IPC_EP_CYPIPE_CM0_ADDR);
+    Cy_IPC_Consumer_Isr(&cm0Consumer);
+}
+
+/*******************************************************************************
+* Function Name: Cy_SysIpcPipeIsrCm0Control
+********************************************************************************
+* Summary:
+* This is the interrupt service routine of the control lane. It has a higher
+* priority than Cy_SysIpcPipeIsrCm0 and preempts it, so an RPC request is
+* served while a bulk drain is in progress. It is never held back by the
+* deferred work queue.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Cy_SysIpcPipeIsrCm0Control(void)
+{
+#if IPC_STATS_ENABLE
+    cm0ControlIsrEntry = IPC_STATS_CLOCK();
+#endif /* IPC_STATS_ENABLE */
+    IPC_TRACE(&cm0Trace, CY_IPC_TRACE_ISR, CY_IPC_EP_CYPIPE_CM0_CTL_ADDR, CY_IPC_TRACE_NO_CLIENT, NULL, 0UL);
+
+    Cy_IPC_Pipe_ExecuteCallback(CY_IPC_EP_CYPIPE_CM0_CTL_ADDR);
+
+    /* The LED topic and the state region of CM7_0 notify on this interrupt too */
+    Cm0_ReceiveLedTopic();
+    Cm0_ReadCm7_0State();
 }
 
 /* [] END OF FILE */
@@ -42,76 +42,143 @@
 
 #include "cy_pdl.h"
 #include "cybsp.h"
+#include "ipc_topology.h"
+#include "ipc_stats.h"
+#include "ipc_trace.h"
+#include "ipc_ring.h"
+#include "ipc_batch.h"
+#include "ipc_credit.h"
+#include "ipc_shbuf.h"
+#include "ipc_rpc.h"
+#include "ipc_sched.h"
+#include "ipc_pubsub.h"
+#include "ipc_seqlock.h"
+#include "ipc_handoff.h"
+#include "ipc_pool.h"
+#include "ipc_messages.h"
 
 /****************************************************************************
 * Constants
 *****************************************************************************/
-#define CY_IPC_MAX_ENDPOINTS            (2UL) /* 2 endpoints */
-#define CY_IPC_CYPIPE_CLIENT_CNT        (8UL)
-
-#define CY_IPC_CHAN_CYPIPE_EP0          (CY_IPC_CHAN_USER) /* IPC data channel for CYPIPE EP0 */
-#define CY_IPC_CYPIPE_CHAN_MASK_EP0     (0x0001UL << CY_IPC_CHAN_CYPIPE_EP0)
-#define CY_IPC_INTR_CYPIPE_EP0          (CY_IPC_INTR_USER)   /* IPC Intr for EP0 */
-#define CY_IPC_CYPIPE_INTR_MASK_EP0     (0x0001UL << CY_IPC_INTR_CYPIPE_EP0)   /* IPC Intr Mask for EP0 */
-#define CY_IPC_INTR_CYPIPE_PRIOR_EP0    (1UL)   /* Notifier Priority */
-#define CY_IPC_INTR_CYPIPE_MUX_EP0      (NvicMux3_IRQn)   /* Intr Mux for CM0P */
-#define CY_IPC_EP_CYPIPE_CM0_ADDR       (0UL)   /* EP0 Index of Endpoint Array */
-#define CY_CLIENT_CYPIPE0_CM0_ID0       (0UL)   /* EP0 Pipe0 (CM0 <--> CM7_0) Index of client cb Array */
-
-#define CY_IPC_CHAN_CYPIPE_EP1          (CY_IPC_CHAN_USER + 1UL) /* IPC data channel for CYPIPE EP1 */
-#define CY_IPC_CYPIPE_CHAN_MASK_EP1     (0x0001UL << CY_IPC_CHAN_CYPIPE_EP1)
-#define CY_IPC_INTR_CYPIPE_EP1          (CY_IPC_INTR_USER + 1UL)   /* IPC Intr for EP1 */
-#define CY_IPC_CYPIPE_INTR_MASK_EP1     (0x0001UL << CY_IPC_INTR_CYPIPE_EP1)   /* IPC Intr Mask for EP0 */
-#define CY_IPC_INTR_CYPIPE_PRIOR_EP1    (1UL)   /* Notifier Priority */
-#define CY_IPC_INTR_CYPIPE_MUX_EP1      (NvicMux4_IRQn)   /* Intr Mux for CM7_0 */
-#define CY_IPC_EP_CYPIPE_CM7_0_ADDR     (1UL)   /* EP1 Index of Endpoint Array */
-#define CY_CLIENT_CYPIPE0_CM7_0_ID0     (2UL)   /* EP1 Pipe0 (CM7_0 <--> CM0) Index of client cb Array */
-
-
-/****************************************************************************
-* The pipe configuration defines the IPC channel number, interrupt
-* number, and the pipe interrupt mask for the endpoint.
-*
-* The format of the endPoint configuration
-*   Bits[31:16] Interrupt Mask
-*   Bits[15:8 ] IPC interrupt
-*   Bits[ 7:0 ] IPC channel
-*
-*   Pipe addresses
-*   CyPipe defines
-*****************************************************************************/
-#define CY_IPC_CYPIPE_INTR_MASK   ( CY_IPC_CYPIPE_CHAN_MASK_EP0 | CY_IPC_CYPIPE_CHAN_MASK_EP1)
-
-#define CY_IPC_CYPIPE_CONFIG_EP0  ( (CY_IPC_CYPIPE_INTR_MASK << CY_IPC_PIPE_CFG_IMASK_Pos) \
-                                   | (CY_IPC_INTR_CYPIPE_EP0 << CY_IPC_PIPE_CFG_INTR_Pos) \
-                                    | CY_IPC_CHAN_CYPIPE_EP0)
-
-#define CY_IPC_CYPIPE_CONFIG_EP1  ( (CY_IPC_CYPIPE_INTR_MASK << CY_IPC_PIPE_CFG_IMASK_Pos) \
-                                   | (CY_IPC_INTR_CYPIPE_EP1 << CY_IPC_PIPE_CFG_INTR_Pos) \
-                                    | CY_IPC_CHAN_CYPIPE_EP1)
+#define IPC_RING_TRANSPORT      1       /* Queue messages in a shared ring, the pipe is only a doorbell */
+#define IPC_RING_DEPTH          (16UL)  /* Ring depth, must be a power of two */
+#define IPC_BATCH_THRESHOLD     (4UL)   /* Messages per doorbell, 1 rings on every message */
+#define IPC_BATCH_TIMEOUT_MS    (10UL)  /* Longest time a queued message waits for its doorbell */
+#define IPC_CREDIT_POLICY       CY_IPC_CREDIT_POLICY_QUEUE /* Send without credit from CM0+: BLOCK, QUEUE or DROP */
+#define IPC_CREDIT_BACKLOG      (4UL)   /* Messages held back by CY_IPC_CREDIT_POLICY_QUEUE, must be a power of two */
+#define IPC_SHBUF_SIZE          (64UL * 1024UL) /* Shared buffer pool for zero-copy payloads */
+#define IPC_SHBUF_SLOT_SIZE     (2048UL)        /* Pool allocation granule */
+#define IPC_FRAME_SIZE          (1024UL)        /* Payload sent by descriptor on every period */
+#define IPC_SEND_PERIOD_MS      (500UL)         /* Period of the LED, frame and RPC jobs */
+#define IPC_TOPIC_DEPTH         (4UL)           /* LED states in flight to the subscribers, must be a power of two */
+#define IPC_HANDOFF_MODE        CY_IPC_HANDOFF_CACHED /* LED message: CACHED cleans its lines on send, NONCACHEABLE places it uncached */
+#define IPC_HANDOFF_POOL_SIZE   (256UL)         /* Pool of the LED messages, a power of two for the MPU */
+#define IPC_LED_MSG_BLOCKS      (4UL)           /* LED messages in flight or being built */
 
 /****************************************************************************
 * Global variables
 *****************************************************************************/
-typedef struct
-{
-    uint8_t  clientID;      /* Client ID */
-    uint8_t  pktType;       /* Message Type */
-    uint16_t intrRelMask;   /* Mask */
-} cy_stc_ipc_testmsg_t;
+#if IPC_RING_TRANSPORT
+/* Ring and doorbell are read by CM0+, keep them out of the stack and TCM */
+static cy_stc_ipc_ring_t cm7_0Ring;
+CY_ALIGN(IPC_PORT_CACHE_LINE) static uint8_t cm7_0RingBuf[CY_IPC_RING_STORAGE_SIZE(sizeof(cy_stc_ipc_testmsg_t), IPC_RING_DEPTH)];
+static cy_stc_ipc_doorbellmsg_t cm7_0DoorbellMsg;
+static cy_stc_ipc_batch_t cm7_0Batch;
+static cy_stc_ipc_msg_tx_t cm7_0RingTx;     /* Numbers the messages of the ring */
+static cy_stc_ipc_credit_t cm7_0Credit;     /* Credits granted by CM0+ */
+static cy_stc_ipc_credit_tx_t cm7_0CreditTx;
+static cy_stc_ipc_ring_t cm7_0Backlog;      /* Messages waiting for credit, local to CM7_0 */
+CY_ALIGN(IPC_PORT_CACHE_LINE) static uint8_t cm7_0BacklogBuf[CY_IPC_RING_STORAGE_SIZE(sizeof(cy_stc_ipc_testmsg_t), IPC_CREDIT_BACKLOG)];
+#endif /* IPC_RING_TRANSPORT */
 
+/* Send jobs, a lower ID runs first */
 typedef enum
 {
-    CY_IPC_PKT_FROM_CM0_TO_CM7_0,
-    CY_IPC_PKT_FROM_CM7_0_TO_CM0,
-} cy_en_ipc_pktType_t;
+    CM7_0_JOB_LED,          /* LED state message */
+    CM7_0_JOB_FRAME,        /* Zero-copy payload */
+    CM7_0_JOB_RPC,          /* Checksum query */
+    CM7_0_JOB_TOPIC,        /* Hands the LED topic to CM0+, on demand */
+    CM7_0_JOB_STATE,        /* Hands the state region to CM0+, on demand */
+} cm7_0_job_t;
+
+/* Every message to CM0+ is written back by line before it is sent, unless it
+ * comes from the pool, which is mapped non-cacheable in that mode */
+static cy_stc_ipc_handoff_t cm7_0Handoff;
+CY_ALIGN(IPC_HANDOFF_POOL_SIZE) static uint8_t cm7_0HandoffPool[IPC_HANDOFF_POOL_SIZE];
+
+/* LED messages, one block per send in the handoff pool. Only CM7_0 allocates
+ * and frees, so the blocks may stay cacheable. */
+static cy_stc_ipc_pool_t cm7_0LedMsgPool;
+static cy_stc_ipc_testmsg_t *volatile cm7_0LedInFlight; /* Sent through the pipe, read by CM0+ until its release */
+
+static cy_stc_ipc_sched_t cm7_0Sched;
+static volatile uint32_t cm7_0TickMs;   /* Scheduler time base */
+static uint32_t cm7_0Led;               /* LED state sent last */
+
+/* Zero-copy payloads, owned by CM7_0 until CM0+ releases the descriptor */
+static cy_stc_ipc_shbuf_t cm7_0ShBuf;
+CY_ALIGN(IPC_PORT_CACHE_LINE) static uint8_t cm7_0ShBufMem[IPC_SHBUF_SIZE];
+static cy_stc_ipc_descmsg_t cm7_0DescMsg;
+static volatile bool cm7_0DescInFlight;
+
+/* RPC to CM0+ on the control lane. Both rings are owned by CM7_0, CM0+ learns them from the doorbell */
+static cy_stc_ipc_rpc_client_t cm7_0Rpc;
+static cy_stc_ipc_ring_t cm7_0RpcRequestRing;
+static cy_stc_ipc_ring_t cm7_0RpcResponseRing;
+CY_ALIGN(IPC_PORT_CACHE_LINE) static uint8_t cm7_0RpcRequestBuf[CY_IPC_RING_STORAGE_SIZE(sizeof(cy_stc_ipc_rpc_msg_t), CY_IPC_RPC_MAX_PENDING)];
+CY_ALIGN(IPC_PORT_CACHE_LINE) static uint8_t cm7_0RpcResponseBuf[CY_IPC_RING_STORAGE_SIZE(sizeof(cy_stc_ipc_rpc_msg_t), CY_IPC_RPC_MAX_PENDING)];
+static cy_stc_ipc_rpcdoorbellmsg_t cm7_0RpcDoorbellMsg;
+static volatile uint32_t cm7_0RemoteChecksum;   /* Last checksum reported by CM0+ */
+
+/* LED topic. CM0+ learns it from the topic message and hands it on to CM7_1 */
+static cy_stc_ipc_pubsub_topic_t cm7_0LedTopic;
+CY_ALIGN(IPC_PORT_CACHE_LINE) static uint8_t cm7_0LedTopicMem[CY_IPC_PUBSUB_STORAGE_SIZE(sizeof(cy_stc_ipc_ledstate_t), IPC_TOPIC_DEPTH)];
+static cy_stc_ipc_topicmsg_t cm7_0TopicMsg;
+
+/* State region: CM0+ reads the latest state when the doorbell rings, no message per update */
+static cy_stc_ipc_seqlock_t cm7_0State;
+CY_ALIGN(IPC_PORT_CACHE_LINE) static cy_stc_ipc_cm7_0state_t cm7_0StateData;
+static cy_stc_ipc_statemsg_t cm7_0StateMsg;
+static uint32_t cm7_0LedUpdates;        /* LED states sent since start */
+
+#if IPC_STATS_ENABLE
+/* Latency of the messages sent by CM7_0, one block per lane. CM0+ records its stages here too */
+static cy_stc_ipc_stats_t cm7_0Stats;
+static cy_stc_ipc_stats_t cm7_0ControlStats;
+static uint32_t cm7_0InFlightSent;              /* Send timestamp of the bulk message in flight */
+static uint32_t cm7_0ControlInFlightSent;       /* Send timestamp of the control message in flight */
+#endif /* IPC_STATS_ENABLE */
+
+#if IPC_TRACE_ENABLE
+/* Events of this core, saved by handle_error() */
+static cy_stc_ipc_trace_t cm7_0Trace;
+#endif /* IPC_TRACE_ENABLE */
 
 
 /*******************************************************************************
 * Function Prototypes
 ********************************************************************************/
 void Pipe0_cm7_0_ReleaseCallback(void);
+cy_en_ipc_pipe_status_t Pipe0_cm7_0_Send(void *msg);
+void Pipe0_cm7_0_RingDoorbell(void);
+void Pipe0_cm7_0_FlushBacklog(void);
+bool Pipe0_cm7_0_SendFrame(uint32_t seq);
+cy_en_ipc_sched_result_t Cm7_0_LedJob(void *context);
+cy_en_ipc_sched_result_t Cm7_0_FrameJob(void *context);
+cy_en_ipc_sched_result_t Cm7_0_RpcJob(void *context);
+cy_en_ipc_sched_result_t Cm7_0_TopicJob(void *context);
+cy_en_ipc_sched_result_t Cm7_0_StateJob(void *context);
+void Cm7_0_PublishLed(uint32_t led);
+void Cm7_0_UpdateState(void);
+cy_en_ipc_rpc_status_t Pipe2_cm7_0_Call(uint32_t method, uint32_t arg, cy_ipc_rpc_callback_t callback, void *context, uint32_t *id);
+void Pipe2_cm7_0_ReleaseCallback(void);
+cy_en_ipc_pipe_status_t Pipe2_cm7_0_Send(void *msg);
+void Pipe2_cm7_0_RingRpcDoorbell(void);
+void Pipe2_cm7_0_CompleteRpc(void);
+void Pipe2_cm7_0_ChecksumDone(uint32_t id, cy_en_ipc_rpc_status_t status, uint32_t result, void *context);
+void Cm7_0_SysTickCallback(void);
 void Cy_SysIpcPipeIsrCm7_0(void);
+void Cy_SysIpcPipeIsrCm7_0Control(void);
 void handle_error(void);
 
 /*******************************************************************************
@@ -129,37 +196,25 @@ void handle_error(void);
 *******************************************************************************/
 int main(void)
 {
-    uint32_t  u32Led= 0;
     cy_rslt_t result;
-    cy_en_ipc_pipe_status_t pipeStatus;
-    cy_stc_ipc_testmsg_t cm7_0MsgData0;
+    uint32_t interruptState;
+    cy_stc_ipc_pool_config_t ledPoolConfig =
+    {
+        NULL,                           /* Placed in the handoff pool */
+        sizeof(cy_stc_ipc_testmsg_t),
+        IPC_LED_MSG_BLOCKS,
+        NULL,                           /* CM0+ only releases, it never frees a block */
+        0UL
+    };
     static cy_stc_ipc_pipe_ep_t IpcPipeEpArray[CY_IPC_MAX_ENDPOINTS]; /* Create an array of endpoint structures */
-    static cy_ipc_pipe_callback_ptr_t ep1CbArray[CY_IPC_CYPIPE_CLIENT_CNT]; /* CB Array for EP1 */
 
-    /* Pipe-0 endpoint-1 and endpoint-0. CM7_0 <--> CM0 */
+    /* Pipe-0 endpoint-1 and endpoint-0. CM7_0 <--> CM0, EP1 has no clients */
     static const cy_stc_ipc_pipe_config_t systemIpcPipe0ConfigCm7_0 =
-    {
-        /* receiver endpoint CM7_0 */
-        {
-            CY_IPC_INTR_CYPIPE_EP1,       /* .ipcNotifierNumber    */
-            CY_IPC_INTR_CYPIPE_PRIOR_EP1, /* .ipcNotifierPriority  */
-            CY_IPC_INTR_CYPIPE_MUX_EP1,   /* .ipcNotifierMuxNumber */
-            CY_IPC_EP_CYPIPE_CM7_0_ADDR,  /* .epAddress            */
-            CY_IPC_CYPIPE_CONFIG_EP1      /* .epConfig             */
-        },
-        /* sender endpoint CM0 */
-        {
-            CY_IPC_INTR_CYPIPE_EP0,       /* .ipcNotifierNumber    */
-            CY_IPC_INTR_CYPIPE_PRIOR_EP0, /* .ipcNotifierPriority  */
-            CY_IPC_INTR_CYPIPE_MUX_EP0,   /* .ipcNotifierMuxNumber */
-            CY_IPC_EP_CYPIPE_CM0_ADDR,    /* .epAddress            */
-            CY_IPC_CYPIPE_CONFIG_EP0      /* .epConfig             */
-        },
-
-        CY_IPC_CYPIPE_CLIENT_CNT, /* .endpointClientsCount     */
-        ep1CbArray,               /* .endpointsCallbacksArray  */
-        &Cy_SysIpcPipeIsrCm7_0    /* .userPipeIsrHandler       */
-    };
+        CY_IPC_CYPIPE_PIPE_CONFIG(1, 0, NULL, &Cy_SysIpcPipeIsrCm7_0);
+
+    /* Pipe-2 endpoint-4 and endpoint-3. CM7_0 <--> CM0 control lane, EP4 has no clients */
+    static const cy_stc_ipc_pipe_config_t systemIpcPipe2ConfigCm7_0 =
+        CY_IPC_CYPIPE_PIPE_CONFIG(4, 3, NULL, &Cy_SysIpcPipeIsrCm7_0Control);
 
     /* Initialize the device and board peripherals */
     result = cybsp_init();
@@ -175,31 +230,816 @@ int main(void)
 
 
     Cy_IPC_Pipe_Init(&systemIpcPipe0ConfigCm7_0); /* PIPE-0 EP1 <--> EP0 */
+    Cy_IPC_Pipe_Init(&systemIpcPipe2ConfigCm7_0); /* PIPE-2 EP4 <--> EP3 */
 
-    for (;;)
+#if IPC_STATS_ENABLE
+    Cy_IPC_Stats_Init(&cm7_0Stats);
+    Cy_IPC_Stats_Init(&cm7_0ControlStats);
+#endif /* IPC_STATS_ENABLE */
+
+    if (CY_IPC_HANDOFF_SUCCESS != Cy_IPC_Handoff_Init(&cm7_0Handoff, cm7_0HandoffPool, IPC_HANDOFF_POOL_SIZE, IPC_HANDOFF_MODE))
+    {
+        handle_error();
+    }
+    ledPoolConfig.storage = Cy_IPC_Handoff_Alloc(&cm7_0Handoff,
+                                                 CY_IPC_POOL_STORAGE_SIZE(sizeof(cy_stc_ipc_testmsg_t), IPC_LED_MSG_BLOCKS));
+    if (CY_IPC_POOL_SUCCESS != Cy_IPC_Pool_Init(&cm7_0LedMsgPool, &ledPoolConfig))
+    {
+        handle_error();
+    }
+
+#if IPC_TRACE_ENABLE
+    Cy_IPC_Trace_Init(&cm7_0Trace, CY_IPC_CORE_CM7_0);
+#endif /* IPC_TRACE_ENABLE */
+
+    if (CY_IPC_SHBUF_SUCCESS != Cy_IPC_ShBuf_Init(&cm7_0ShBuf, cm7_0ShBufMem, IPC_SHBUF_SIZE, IPC_SHBUF_SLOT_SIZE))
     {
-        /* Wait 0.5 [s] */
-        Cy_SysLib_Delay(500);
-        u32Led = (u32Led + 1u) % 3u;
-        /* Send message to CM0 in Pipe-0 */
-        cm7_0MsgData0.clientID = CY_CLIENT_CYPIPE0_CM0_ID0;      /* Client CM0_ID0 will process this message */
-        cm7_0MsgData0.pktType = u32Led;
-        cm7_0MsgData0.intrRelMask = CY_IPC_CYPIPE_INTR_MASK_EP1; /* set the interrupt mask for EP1 interrupt number */
+        handle_error();
+    }
+    /* Client CM0_ID2 processes the payload */
+    Cy_IPC_Msg_InitDesc(&cm7_0DescMsg, CY_CLIENT_CYPIPE0_CM0_ID2, CY_IPC_PKT_FROM_CM7_0_TO_CM0, CY_IPC_CYPIPE_INTR_MASK_EP1);
+    cm7_0DescMsg.payload.pool = &cm7_0ShBuf;
+
+    /* Requests and responses travel in rings. The pipe carries the doorbell
+     * of the requests; CM0+ rings EP4 for the responses with a bare notify. */
+    if ((CY_IPC_RING_SUCCESS != Cy_IPC_Ring_Init(&cm7_0RpcRequestRing, cm7_0RpcRequestBuf, sizeof(cy_stc_ipc_rpc_msg_t), CY_IPC_RPC_MAX_PENDING)) ||
+        (CY_IPC_RING_SUCCESS != Cy_IPC_Ring_Init(&cm7_0RpcResponseRing, cm7_0RpcResponseBuf, sizeof(cy_stc_ipc_rpc_msg_t), CY_IPC_RPC_MAX_PENDING)))
+    {
+        handle_error();
+    }
+    Cy_IPC_Rpc_InitClient(&cm7_0Rpc, CY_CLIENT_CYPIPE2_CM0_ID0, CY_IPC_PKT_FROM_CM7_0_TO_CM0, CY_IPC_CYPIPE_INTR_MASK_EP4);
+    /* Client CM0_ID0 of Pipe2 serves the requests */
+    Cy_IPC_Msg_InitRpcDoorbell(&cm7_0RpcDoorbellMsg, CY_CLIENT_CYPIPE2_CM0_ID0, CY_IPC_PKT_FROM_CM7_0_TO_CM0, CY_IPC_CYPIPE_INTR_MASK_EP4);
+    cm7_0RpcDoorbellMsg.payload.request = &cm7_0RpcRequestRing;
+    cm7_0RpcDoorbellMsg.payload.response = &cm7_0RpcResponseRing;
+    Cy_IPC_Msg_Seal(&cm7_0RpcDoorbellMsg, NULL);
+
+    if (CY_IPC_PUBSUB_SUCCESS != Cy_IPC_PubSub_Init(&cm7_0LedTopic, cm7_0LedTopicMem, sizeof(cy_stc_ipc_ledstate_t), IPC_TOPIC_DEPTH))
+    {
+        handle_error();
+    }
+    /* Client CM0_ID1 of Pipe2 subscribes CM0+ */
+    Cy_IPC_Msg_InitTopic(&cm7_0TopicMsg, CY_CLIENT_CYPIPE2_CM0_ID1, CY_IPC_PKT_FROM_CM7_0_TO_CM0, CY_IPC_CYPIPE_INTR_MASK_EP4);
+    cm7_0TopicMsg.payload.topic = &cm7_0LedTopic;
+    cm7_0TopicMsg.payload.subscriber = CY_IPC_TOPIC_LED_SUB_CM0;
+    Cy_IPC_Msg_Seal(&cm7_0TopicMsg, NULL);
 
-        pipeStatus = Cy_IPC_Pipe_SendMessage(CY_IPC_EP_CYPIPE_CM0_ADDR, CY_IPC_EP_CYPIPE_CM7_0_ADDR, (void *) &cm7_0MsgData0, Pipe0_cm7_0_ReleaseCallback);
-        if (pipeStatus !=CY_IPC_PIPE_SUCCESS)
+    /* The doorbell of the state region rings on CM0+'s control interrupt */
+    if (CY_IPC_SEQLOCK_SUCCESS != Cy_IPC_Seqlock_Init(&cm7_0State, &cm7_0StateData, sizeof(cm7_0StateData), CY_IPC_CYPIPE_INTR_MASK_EP3))
+    {
+        handle_error();
+    }
+    /* Client CM0_ID2 of Pipe2 reads the state region */
+    Cy_IPC_Msg_InitState(&cm7_0StateMsg, CY_CLIENT_CYPIPE2_CM0_ID2, CY_IPC_PKT_FROM_CM7_0_TO_CM0, CY_IPC_CYPIPE_INTR_MASK_EP4);
+    cm7_0StateMsg.payload.state = &cm7_0State;
+    Cy_IPC_Msg_Seal(&cm7_0StateMsg, NULL);
+
+#if IPC_RING_TRANSPORT
+    if ((CY_IPC_RING_SUCCESS != Cy_IPC_Ring_Init(&cm7_0Ring, cm7_0RingBuf, sizeof(cy_stc_ipc_testmsg_t), IPC_RING_DEPTH)) ||
+        (CY_IPC_RING_SUCCESS != Cy_IPC_Ring_Init(&cm7_0Backlog, cm7_0BacklogBuf, sizeof(cy_stc_ipc_testmsg_t), IPC_CREDIT_BACKLOG)))
+    {
+        handle_error();
+    }
+
+    /* The whole ring until CM0+ grants its own window */
+    Cy_IPC_Credit_InitTx(&cm7_0CreditTx, &cm7_0Credit, &cm7_0Ring, IPC_CREDIT_POLICY, &cm7_0Backlog, IPC_RING_DEPTH);
+
+    /* Client CM0_ID1 drains the ring */
+    Cy_IPC_Msg_InitDoorbell(&cm7_0DoorbellMsg, CY_CLIENT_CYPIPE0_CM0_ID1, CY_IPC_PKT_FROM_CM7_0_TO_CM0, CY_IPC_CYPIPE_INTR_MASK_EP1);
+    cm7_0DoorbellMsg.payload.ring = &cm7_0Ring;
+    cm7_0DoorbellMsg.payload.credit = &cm7_0Credit;
+    Cy_IPC_Msg_Seal(&cm7_0DoorbellMsg, NULL);
+
+    Cy_IPC_Batch_Init(&cm7_0Batch, IPC_BATCH_THRESHOLD, IPC_BATCH_TIMEOUT_MS);
+#endif /* IPC_RING_TRANSPORT */
+
+    /* 1 ms tick drives the scheduler and flushes partial batches once they time out */
+    Cy_SysTick_Init(CY_SYSTICK_CLOCK_SOURCE_CLK_CPU, (SystemCoreClock / 1000UL) - 1UL);
+    Cy_SysTick_SetCallback(0UL, &Cm7_0_SysTickCallback);
+
+    Cy_IPC_Sched_Init(&cm7_0Sched);
+    (void)Cy_IPC_Sched_AddJob(&cm7_0Sched, CM7_0_JOB_LED, &Cm7_0_LedJob, NULL, IPC_SEND_PERIOD_MS, cm7_0TickMs);
+    (void)Cy_IPC_Sched_AddJob(&cm7_0Sched, CM7_0_JOB_FRAME, &Cm7_0_FrameJob, NULL, IPC_SEND_PERIOD_MS, cm7_0TickMs);
+    (void)Cy_IPC_Sched_AddJob(&cm7_0Sched, CM7_0_JOB_RPC, &Cm7_0_RpcJob, NULL, IPC_SEND_PERIOD_MS, cm7_0TickMs);
+    (void)Cy_IPC_Sched_AddJob(&cm7_0Sched, CM7_0_JOB_TOPIC, &Cm7_0_TopicJob, NULL, CY_IPC_SCHED_ON_DEMAND, cm7_0TickMs);
+    (void)Cy_IPC_Sched_AddJob(&cm7_0Sched, CM7_0_JOB_STATE, &Cm7_0_StateJob, NULL, CY_IPC_SCHED_ON_DEMAND, cm7_0TickMs);
+    Cy_IPC_Sched_Trigger(&cm7_0Sched, CM7_0_JOB_TOPIC);
+    Cy_IPC_Sched_Trigger(&cm7_0Sched, CM7_0_JOB_STATE);
+
+    for (;;)
+    {
+        if (!Cy_IPC_Sched_RunOnce(&cm7_0Sched, cm7_0TickMs))
         {
-            handle_error();
+            /* Sleep until the next tick or pipe interrupt. Checked with
+             * interrupts masked: a pending interrupt still ends WFI. */
+            interruptState = Cy_SysLib_EnterCriticalSection();
+            if (0UL != Cy_IPC_Sched_IdleTime(&cm7_0Sched, cm7_0TickMs))
+            {
+                __WFI();
+            }
+            Cy_SysLib_ExitCriticalSection(interruptState);
         }
     }
 }
 
+/*******************************************************************************
+* Function Name: Cm7_0_LedJob
+********************************************************************************
+* Summary:
+* Sends the next LED state to CM0+. Each message is built in its own block
+* of cm7_0LedMsgPool, so a message still read by CM0+ is never rewritten.
+* The ring or the backlog takes a copy and the block is freed at once; a
+* message sent through the pipe keeps its block until the release. Without
+* credit from CM0+ the message is handled by IPC_CREDIT_POLICY; the job
+* backs off while the pipe is busy, the policy blocks or the pool is empty.
+* The LED state only advances once the message is in the ring or the
+* backlog; a dropped state is retried on the next period. Every new state is
+* also published on the LED topic and in the state region.
+*
+* Parameters:
+*  context: Not used
+*
+* Return:
+*  CY_IPC_SCHED_DONE, or CY_IPC_SCHED_BLOCKED to retry after the release
+*******************************************************************************/
+cy_en_ipc_sched_result_t Cm7_0_LedJob(void *context)
+{
+    uint32_t interruptState;
+    uint32_t u32Led = (cm7_0Led + 1u) % 3u;
+    cy_stc_ipc_testmsg_t *ledMsg;
+#if IPC_RING_TRANSPORT
+    cy_en_ipc_credit_status_t creditStatus;
+    bool doorbellDue;
+#else
+    cy_en_ipc_pipe_status_t pipeStatus;
+#endif /* IPC_RING_TRANSPORT */
+
+    (void)context;
+
+#if !IPC_RING_TRANSPORT
+    /* The send would only fail while the endpoint is busy */
+    if (Cy_IPC_Pipe_EndpointIsBusy(CY_IPC_EP_CYPIPE_CM7_0_ADDR))
+    {
+        return CY_IPC_SCHED_BLOCKED;
+    }
+#endif /* !IPC_RING_TRANSPORT */
+
+    ledMsg = (cy_stc_ipc_testmsg_t *)Cy_IPC_Pool_Alloc(&cm7_0LedMsgPool);
+    if (NULL == ledMsg)
+    {
+        return CY_IPC_SCHED_BLOCKED;
+    }
+
+    /* Send message to CM0 in Pipe-0. Client CM0_ID0 will process this message, the release interrupt is EP1's */
+    Cy_IPC_Msg_InitHeader(&ledMsg->hdr, CY_CLIENT_CYPIPE0_CM0_ID0, u32Led, CY_IPC_CYPIPE_INTR_MASK_EP1, 0UL);
+    IPC_STATS_STAMP(ledMsg, &cm7_0Stats);
+
+#if IPC_RING_TRANSPORT
+    /* Queue the message, the doorbell tells CM0+ to drain the ring. The
+     * release ISR and the tick flush the backlog, keep the sender state
+     * consistent with them. */
+    Cy_IPC_Msg_Seal(ledMsg, &cm7_0RingTx);
+    Pipe0_cm7_0_FlushBacklog();
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    creditStatus = Cy_IPC_Credit_Send(&cm7_0CreditTx, ledMsg);
+    if (CY_IPC_CREDIT_SUCCESS == creditStatus)
+    {
+        (void)Cy_IPC_Batch_Add(&cm7_0Batch, cm7_0TickMs);
+    }
+    doorbellDue = Cy_IPC_Batch_IsDue(&cm7_0Batch, cm7_0TickMs);
+    Cy_SysLib_ExitCriticalSection(interruptState);
+    (void)Cy_IPC_Pool_Free(&cm7_0LedMsgPool, ledMsg);
+
+    if (CY_IPC_CREDIT_BLOCKED == creditStatus)
+    {
+        return CY_IPC_SCHED_BLOCKED;
+    }
+    if (CY_IPC_CREDIT_DROPPED == creditStatus)
+    {
+        return CY_IPC_SCHED_DONE;
+    }
+    Cy_IPC_Msg_Sent(&cm7_0RingTx);
+
+    if (doorbellDue)
+    {
+        Pipe0_cm7_0_RingDoorbell();
+    }
+#else
+    Cy_IPC_Msg_Seal(ledMsg, NULL);
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    pipeStatus = Pipe0_cm7_0_Send(ledMsg);
+    if (pipeStatus == CY_IPC_PIPE_SUCCESS)
+    {
+        cm7_0LedInFlight = ledMsg;
+    }
+    Cy_SysLib_ExitCriticalSection(interruptState);
+
+    if (pipeStatus == CY_IPC_PIPE_ERROR_SEND_BUSY)
+    {
+        (void)Cy_IPC_Pool_Free(&cm7_0LedMsgPool, ledMsg);
+        return CY_IPC_SCHED_BLOCKED;
+    }
+    if (pipeStatus != CY_IPC_PIPE_SUCCESS)
+    {
+        handle_error();
+    }
+#endif /* IPC_RING_TRANSPORT */
+
+    cm7_0Led = u32Led;
+    cm7_0LedUpdates++;
+    Cm7_0_PublishLed(u32Led);
+    Cm7_0_UpdateState();
+    return CY_IPC_SCHED_DONE;
+}
+
+/*******************************************************************************
+* Function Name: Cm7_0_FrameJob
+********************************************************************************
+* Summary:
+* Sends a zero-copy payload. Backs off while the previous payload is owned by
+* CM0+ or the pipe is busy.
+*
+* Parameters:
+*  context: Not used
+*
+* Return:
+*  CY_IPC_SCHED_DONE, or CY_IPC_SCHED_BLOCKED to retry after the release
+*******************************************************************************/
+cy_en_ipc_sched_result_t Cm7_0_FrameJob(void *context)
+{
+    (void)context;
+
+    return Pipe0_cm7_0_SendFrame(cm7_0Led) ? CY_IPC_SCHED_DONE : CY_IPC_SCHED_BLOCKED;
+}
+
+/*******************************************************************************
+* Function Name: Cm7_0_RpcJob
+********************************************************************************
+* Summary:
+* Asks CM0+ what it received, the answer arrives in Pipe2_cm7_0_ChecksumDone().
+* The query is skipped while CY_IPC_RPC_MAX_PENDING requests are outstanding.
+*
+* Parameters:
+*  context: Not used
+*
+* Return:
+*  CY_IPC_SCHED_DONE
+*******************************************************************************/
+cy_en_ipc_sched_result_t Cm7_0_RpcJob(void *context)
+{
+    (void)context;
+    (void)Pipe2_cm7_0_Call(CY_IPC_RPC_METHOD_GET_FRAME_CHECKSUM, 0UL, &Pipe2_cm7_0_ChecksumDone, NULL, NULL);
+
+    return CY_IPC_SCHED_DONE;
+}
+
+/*******************************************************************************
+* Function Name: Cm7_0_TopicJob
+********************************************************************************
+* Summary:
+* Sends the LED topic to CM0+ on the control lane. CM0+ subscribes and hands
+* the topic on to CM7_1. Backs off while the control pipe is busy.
+*
+* Parameters:
+*  context: Not used
+*
+* Return:
+*  CY_IPC_SCHED_DONE, or CY_IPC_SCHED_BLOCKED to retry after the release
+*******************************************************************************/
+cy_en_ipc_sched_result_t Cm7_0_TopicJob(void *context)
+{
+    cy_en_ipc_pipe_status_t pipeStatus;
+    uint32_t interruptState;
+
+    (void)context;
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    pipeStatus = Pipe2_cm7_0_Send(&cm7_0TopicMsg);
+    Cy_SysLib_ExitCriticalSection(interruptState);
+
+    if (pipeStatus == CY_IPC_PIPE_ERROR_SEND_BUSY)
+    {
+        return CY_IPC_SCHED_BLOCKED;
+    }
+    if (pipeStatus != CY_IPC_PIPE_SUCCESS)
+    {
+        handle_error();
+    }
+
+    return CY_IPC_SCHED_DONE;
+}
+
+/*******************************************************************************
+* Function Name: Cm7_0_StateJob
+********************************************************************************
+* Summary:
+* Sends the state region to CM0+ on the control lane. Backs off while the
+* control pipe is busy.
+*
+* Parameters:
+*  context: Not used
+*
+* Return:
+*  CY_IPC_SCHED_DONE, or CY_IPC_SCHED_BLOCKED to retry after the release
+*******************************************************************************/
+cy_en_ipc_sched_result_t Cm7_0_StateJob(void *context)
+{
+    cy_en_ipc_pipe_status_t pipeStatus;
+    uint32_t interruptState;
+
+    (void)context;
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    pipeStatus = Pipe2_cm7_0_Send(&cm7_0StateMsg);
+    Cy_SysLib_ExitCriticalSection(interruptState);
+
+    if (pipeStatus == CY_IPC_PIPE_ERROR_SEND_BUSY)
+    {
+        return CY_IPC_SCHED_BLOCKED;
+    }
+    if (pipeStatus != CY_IPC_PIPE_SUCCESS)
+    {
+        handle_error();
+    }
+
+    return CY_IPC_SCHED_DONE;
+}
+
+/*******************************************************************************
+* Function Name: Cm7_0_UpdateState
+********************************************************************************
+* Summary:
+* Writes the current state of CM7_0 into the state region and rings its
+* doorbell. The update neither blocks nor masks interrupts: a reader that
+* overlaps it retries. Called from the LED job only, the region has a
+* single writer.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Cm7_0_UpdateState(void)
+{
+    cy_stc_ipc_cm7_0state_t *pState = (cy_stc_ipc_cm7_0state_t *)Cy_IPC_Seqlock_BeginWrite(&cm7_0State);
+    uint32_t notifyMask;
+
+    pState->led = cm7_0Led;
+    pState->ledUpdates = cm7_0LedUpdates;
+    pState->remoteChecksum = cm7_0RemoteChecksum;
+    pState->tickMs = cm7_0TickMs;
+    notifyMask = Cy_IPC_Seqlock_EndWrite(&cm7_0State);
+
+    if (0UL != notifyMask)
+    {
+        IPC_TRACE(&cm7_0Trace, CY_IPC_TRACE_NOTIFY, CY_IPC_EP_CYPIPE_CM7_0_CTL_ADDR, CY_IPC_TRACE_NO_CLIENT, &cm7_0State, notifyMask);
+        Cy_IPC_Drv_AcquireNotify(Cy_IPC_Drv_GetIpcBaseAddress(CY_IPC_CHAN_CYPIPE_EP4), notifyMask);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Cm7_0_PublishLed
+********************************************************************************
+* Summary:
+* Publishes an LED state to the subscribers of the LED topic: the state is
+* written once into the topic and every subscriber is woken by the same
+* notify event, whatever their number. The state is skipped while a
+* subscriber still holds the slot it would reuse, the topic counts it as a
+* stall. Called from the LED job only, the topic has a single publisher.
+*
+* Parameters:
+*  led: LED state
+*
+* Return:
+*  None
+*******************************************************************************/
+void Cm7_0_PublishLed(uint32_t led)
+{
+    cy_stc_ipc_ledstate_t *pState = (cy_stc_ipc_ledstate_t *)Cy_IPC_PubSub_Claim(&cm7_0LedTopic);
+    uint32_t notifyMask = 0UL;
+
+    if (NULL == pState)
+    {
+        return;
+    }
+
+    pState->led = led;
+    (void)Cy_IPC_PubSub_Publish(&cm7_0LedTopic, sizeof(*pState), &notifyMask);
+
+    /* Any channel of the topology passes the subscribers' interrupt masks;
+     * the notify comes from CM7_0's own control channel and carries no message */
+    if (0UL != notifyMask)
+    {
+        IPC_TRACE(&cm7_0Trace, CY_IPC_TRACE_NOTIFY, CY_IPC_EP_CYPIPE_CM7_0_CTL_ADDR, CY_IPC_TRACE_NO_CLIENT, &cm7_0LedTopic, notifyMask);
+        Cy_IPC_Drv_AcquireNotify(Cy_IPC_Drv_GetIpcBaseAddress(CY_IPC_CHAN_CYPIPE_EP4), notifyMask);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Pipe2_cm7_0_Call
+********************************************************************************
+* Summary:
+* Issues an RPC to CM0+ without waiting for the response. The result is
+* delivered to the callback, or polled with Cy_IPC_Rpc_Poll() when no
+* callback is given. The doorbells travel on the control lane, so a call is
+* not held up by bulk traffic.
+*
+* Parameters:
+*  method: Method served by CM0+.
+*  arg: Method argument.
+*  callback: Completion callback, runs in the pipe interrupt. Can be NULL.
+*  context: Passed to the callback.
+*  id: Receives the request ID. Can be NULL.
+*
+* Return:
+*  CY_IPC_RPC_SUCCESS if the request was queued
+*******************************************************************************/
+cy_en_ipc_rpc_status_t Pipe2_cm7_0_Call(uint32_t method, uint32_t arg, cy_ipc_rpc_callback_t callback, void *context, uint32_t *id)
+{
+    cy_stc_ipc_rpc_msg_t request;
+    cy_en_ipc_rpc_status_t rpcStatus;
+    uint32_t requestId;
+
+    rpcStatus = Cy_IPC_Rpc_Prepare(&cm7_0Rpc, method, arg, callback, context, &request, &requestId);
+    if (CY_IPC_RPC_SUCCESS != rpcStatus)
+    {
+        return rpcStatus;
+    }
+
+    /* The ring holds CY_IPC_RPC_MAX_PENDING requests, so it only fills if CM0+ stopped draining */
+    if (CY_IPC_RING_SUCCESS != Cy_IPC_Ring_Push(&cm7_0RpcRequestRing, &request))
+    {
+        (void)Cy_IPC_Rpc_Cancel(&cm7_0Rpc, requestId);
+        return CY_IPC_RPC_ERROR_NO_SLOT;
+    }
+
+    if (NULL != id)
+    {
+        *id = requestId;
+    }
+    Pipe2_cm7_0_RingRpcDoorbell();
+
+    return CY_IPC_RPC_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: Pipe2_cm7_0_RingRpcDoorbell
+********************************************************************************
+* Summary:
+* Tells CM0+ to serve the queued requests. A busy pipe is not an error, the
+* control pipe ISR rings again after the release while requests are queued.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Pipe2_cm7_0_RingRpcDoorbell(void)
+{
+    cy_en_ipc_pipe_status_t pipeStatus;
+    uint32_t interruptState;
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    pipeStatus = Pipe2_cm7_0_Send(&cm7_0RpcDoorbellMsg);
+    Cy_SysLib_ExitCriticalSection(interruptState);
+
+    if ((pipeStatus != CY_IPC_PIPE_SUCCESS) && (pipeStatus != CY_IPC_PIPE_ERROR_SEND_BUSY))
+    {
+        handle_error();
+    }
+}
+
+/*******************************************************************************
+* Function Name: Pipe2_cm7_0_CompleteRpc
+********************************************************************************
+* Summary:
+* Called from the control pipe ISR when CM0+ has rung EP4 after pushing
+* responses. Completes every queued response, in whatever order CM0+
+* answered.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Pipe2_cm7_0_CompleteRpc(void)
+{
+    cy_stc_ipc_rpc_msg_t response;
+    IPC_TRACE_TIME(start);
+
+    while (CY_IPC_RING_SUCCESS == Cy_IPC_Ring_Pop(&cm7_0RpcResponseRing, &response))
+    {
+        /* Responses to cancelled requests are dropped */
+        (void)Cy_IPC_Rpc_Complete(&cm7_0Rpc, &response);
+    }
+
+    IPC_TRACE_CALLBACK(&cm7_0Trace, CY_IPC_EP_CYPIPE_CM7_0_CTL_ADDR, CY_IPC_TRACE_NO_CLIENT, NULL, start);
+}
+
+/*******************************************************************************
+* Function Name: Pipe2_cm7_0_ChecksumDone
+********************************************************************************
+* Summary:
+* Completion of CY_IPC_RPC_METHOD_GET_FRAME_CHECKSUM.
+*
+* Parameters:
+*  id: Request ID
+*  status: Status returned by CM0+
+*  result: Checksum
+*  context: Not used
+*
+* Return:
+*  None
+*******************************************************************************/
+void Pipe2_cm7_0_ChecksumDone(uint32_t id, cy_en_ipc_rpc_status_t status, uint32_t result, void *context)
+{
+    if (CY_IPC_RPC_SUCCESS == status)
+    {
+        cm7_0RemoteChecksum = result;
+    }
+    (void)id;
+    (void)context;
+}
+
+/*******************************************************************************
+* Function Name: Pipe0_cm7_0_SendFrame
+********************************************************************************
+* Summary:
+* Fills a payload in the shared buffer pool and passes it to CM0+ by
+* descriptor. CM0+ processes the payload in place; the buffer is returned in
+* Pipe0_cm7_0_ReleaseCallback. Nothing is sent if the previous frame is
+* still owned by CM0+ or the pipe is busy.
+*
+* Parameters:
+*  seq: Value the payload pattern is derived from
+*
+* Return:
+*  true if the frame was sent
+*******************************************************************************/
+bool Pipe0_cm7_0_SendFrame(uint32_t seq)
+{
+    cy_en_ipc_pipe_status_t pipeStatus = CY_IPC_PIPE_ERROR_SEND_BUSY;
+    cy_en_ipc_shbuf_status_t bufStatus;
+    uint32_t interruptState;
+    uint32_t offset = 0UL;
+    uint32_t i;
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    bufStatus = cm7_0DescInFlight ? CY_IPC_SHBUF_ERROR_NO_MEMORY : Cy_IPC_ShBuf_Alloc(&cm7_0ShBuf, IPC_FRAME_SIZE, &offset);
+    Cy_SysLib_ExitCriticalSection(interruptState);
+
+    if (CY_IPC_SHBUF_SUCCESS != bufStatus)
+    {
+        return false;
+    }
+
+    for (i = 0UL; i < IPC_FRAME_SIZE; i++)
+    {
+        cm7_0ShBufMem[offset + i] = (uint8_t)(seq + i);
+    }
+    Cy_IPC_ShBuf_Publish(&cm7_0ShBuf, offset, IPC_FRAME_SIZE);
+
+    cm7_0DescMsg.payload.offset = offset;
+    cm7_0DescMsg.payload.length = IPC_FRAME_SIZE;
+    Cy_IPC_Msg_Seal(&cm7_0DescMsg, NULL);
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    pipeStatus = Pipe0_cm7_0_Send(&cm7_0DescMsg);
+    if (pipeStatus == CY_IPC_PIPE_SUCCESS)
+    {
+        cm7_0DescInFlight = true;
+    }
+    else
+    {
+        Cy_IPC_ShBuf_Free(&cm7_0ShBuf, offset, IPC_FRAME_SIZE);
+    }
+    Cy_SysLib_ExitCriticalSection(interruptState);
+
+    if ((pipeStatus != CY_IPC_PIPE_SUCCESS) && (pipeStatus != CY_IPC_PIPE_ERROR_SEND_BUSY))
+    {
+        handle_error();
+    }
+
+    return (pipeStatus == CY_IPC_PIPE_SUCCESS);
+}
+
+#if IPC_RING_TRANSPORT
+/*******************************************************************************
+* Function Name: Pipe0_cm7_0_RingDoorbell
+********************************************************************************
+* Summary:
+* Notifies CM0+ that the ring has pending messages. If a doorbell is still
+* pending, CM0+ has not finished draining yet and nothing needs to be sent; the
+* batch stays pending and is signalled again from the release ISR or the tick.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Pipe0_cm7_0_RingDoorbell(void)
+{
+    cy_en_ipc_pipe_status_t pipeStatus;
+    uint32_t interruptState;
+
+    /* The release ISR also rings the doorbell, keep the send atomic on this core */
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    pipeStatus = Pipe0_cm7_0_Send(&cm7_0DoorbellMsg);
+    if (pipeStatus == CY_IPC_PIPE_SUCCESS)
+    {
+        Cy_IPC_Batch_Sent(&cm7_0Batch);
+    }
+    Cy_SysLib_ExitCriticalSection(interruptState);
+
+    if ((pipeStatus != CY_IPC_PIPE_SUCCESS) && (pipeStatus != CY_IPC_PIPE_ERROR_SEND_BUSY))
+    {
+        handle_error();
+    }
+}
+
+/*******************************************************************************
+* Function Name: Pipe0_cm7_0_FlushBacklog
+********************************************************************************
+* Summary:
+* Moves the messages that waited for credit into the ring, as far as CM0+
+* has granted more, and adds them to the batch. The caller rings the
+* doorbell if the batch is due.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Pipe0_cm7_0_FlushBacklog(void)
+{
+    uint32_t interruptState;
+    uint32_t moved;
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    for (moved = Cy_IPC_Credit_Flush(&cm7_0CreditTx); 0UL != moved; moved--)
+    {
+        (void)Cy_IPC_Batch_Add(&cm7_0Batch, cm7_0TickMs);
+    }
+    Cy_SysLib_ExitCriticalSection(interruptState);
+}
+
+#endif /* IPC_RING_TRANSPORT */
+
+/*******************************************************************************
+* Function Name: Cm7_0_SysTickCallback
+********************************************************************************
+* Summary:
+* 1 ms tick. Advances the scheduler time, moves messages that waited for
+* credit into the ring and rings the doorbell for a partial batch that
+* timed out. A job can also be blocked by CM7_1 holding
+* the channel of CM0+; no release of CM7_0 follows then, so with no message
+* of its own in flight the tick retries it.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Cm7_0_SysTickCallback(void)
+{
+    cm7_0TickMs++;
+
+#if IPC_RING_TRANSPORT
+    Pipe0_cm7_0_FlushBacklog();
+    if (Cy_IPC_Batch_IsDue(&cm7_0Batch, cm7_0TickMs))
+    {
+        Pipe0_cm7_0_RingDoorbell();
+    }
+#endif /* IPC_RING_TRANSPORT */
+
+    if (!Cy_IPC_Pipe_EndpointIsBusy(CY_IPC_EP_CYPIPE_CM7_0_ADDR))
+    {
+        Cy_IPC_Sched_Unblock(&cm7_0Sched);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Pipe0_cm7_0_Send
+********************************************************************************
+* Summary:
+* Sends a message to CM0+ over Pipe0, after writing back the cache lines it
+* occupies. With IPC_STATS_ENABLE the message is stamped with the send time
+* and the SEND stage is recorded. Must be called
+* with interrupts masked when other contexts send on this endpoint, so that
+* a message still in flight is never restamped.
+*
+* Parameters:
+*  msg: Message to send
+*
+* Return:
+*  Status of Cy_IPC_Pipe_SendMessage
+*******************************************************************************/
+cy_en_ipc_pipe_status_t Pipe0_cm7_0_Send(void *msg)
+{
+    cy_en_ipc_pipe_status_t pipeStatus;
+#if IPC_STATS_ENABLE
+    cy_stc_ipc_msg_t *pStamped = (cy_stc_ipc_msg_t *)msg;
+    bool stamped = !Cy_IPC_Pipe_EndpointIsBusy(CY_IPC_EP_CYPIPE_CM7_0_ADDR);
+
+    if (stamped)
+    {
+        IPC_STATS_STAMP(pStamped, &cm7_0Stats);
+    }
+#endif /* IPC_STATS_ENABLE */
+
+    Cy_IPC_Handoff_SendMsg(&cm7_0Handoff, msg);
+
+    IPC_TRACE_SEND(&cm7_0Trace, CY_IPC_EP_CYPIPE_CM0_ADDR, msg);
+    pipeStatus = Cy_IPC_Pipe_SendMessage(CY_IPC_EP_CYPIPE_CM0_ADDR, CY_IPC_EP_CYPIPE_CM7_0_ADDR, msg, Pipe0_cm7_0_ReleaseCallback);
+    IPC_TRACE_SENT(&cm7_0Trace, CY_IPC_EP_CYPIPE_CM0_ADDR, msg, pipeStatus == CY_IPC_PIPE_SUCCESS);
+
+#if IPC_STATS_ENABLE
+    if (stamped && (pipeStatus == CY_IPC_PIPE_SUCCESS))
+    {
+        IPC_STATS_RECORD(&cm7_0Stats, CY_IPC_STATS_STAGE_SEND, pStamped->stamp.sent);
+        cm7_0InFlightSent = pStamped->stamp.sent;
+    }
+#endif /* IPC_STATS_ENABLE */
+
+    return pipeStatus;
+}
+
+/*******************************************************************************
+* Function Name: Pipe2_cm7_0_Send
+********************************************************************************
+* Summary:
+* Sends a message to CM0+ over the control lane (Pipe2). Same as
+* Pipe0_cm7_0_Send(), but on its own endpoint and stats block, so control
+* latency is measured apart from the bulk traffic.
+*
+* Parameters:
+*  msg: Message to send
+*
+* Return:
+*  Status of Cy_IPC_Pipe_SendMessage
+*******************************************************************************/
+cy_en_ipc_pipe_status_t Pipe2_cm7_0_Send(void *msg)
+{
+    cy_en_ipc_pipe_status_t pipeStatus;
+#if IPC_STATS_ENABLE
+    cy_stc_ipc_msg_t *pStamped = (cy_stc_ipc_msg_t *)msg;
+    bool stamped = !Cy_IPC_Pipe_EndpointIsBusy(CY_IPC_EP_CYPIPE_CM7_0_CTL_ADDR);
+
+    if (stamped)
+    {
+        IPC_STATS_STAMP(pStamped, &cm7_0ControlStats);
+    }
+#endif /* IPC_STATS_ENABLE */
+
+    Cy_IPC_Handoff_SendMsg(&cm7_0Handoff, msg);
+
+    IPC_TRACE_SEND(&cm7_0Trace, CY_IPC_EP_CYPIPE_CM0_CTL_ADDR, msg);
+    pipeStatus = Cy_IPC_Pipe_SendMessage(CY_IPC_EP_CYPIPE_CM0_CTL_ADDR, CY_IPC_EP_CYPIPE_CM7_0_CTL_ADDR, msg, Pipe2_cm7_0_ReleaseCallback);
+    IPC_TRACE_SENT(&cm7_0Trace, CY_IPC_EP_CYPIPE_CM0_CTL_ADDR, msg, pipeStatus == CY_IPC_PIPE_SUCCESS);
+
+#if IPC_STATS_ENABLE
+    if (stamped && (pipeStatus == CY_IPC_PIPE_SUCCESS))
+    {
+        IPC_STATS_RECORD(&cm7_0ControlStats, CY_IPC_STATS_STAGE_SEND, pStamped->stamp.sent);
+        cm7_0ControlInFlightSent = pStamped->stamp.sent;
+    }
+#endif /* IPC_STATS_ENABLE */
+
+    return pipeStatus;
+}
+
+/*******************************************************************************
+* Function Name: Pipe2_cm7_0_ReleaseCallback
+********************************************************************************
+* Summary:
+* CM0+ has served the control message, the control lane is free again.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Pipe2_cm7_0_ReleaseCallback(void)
+{
+    IPC_STATS_RECORD(&cm7_0ControlStats, CY_IPC_STATS_STAGE_RELEASE, cm7_0ControlInFlightSent);
+    IPC_TRACE(&cm7_0Trace, CY_IPC_TRACE_RELEASE, CY_IPC_EP_CYPIPE_CM0_CTL_ADDR, CY_IPC_TRACE_NO_CLIENT, NULL, 0UL);
+}
+
 /*******************************************************************************
 * Function Name: Pipe0_cm7_0_ReleaseCallback
 ********************************************************************************
 * Summary:
 * The sent data is already processed on the receiver side,the pipe is ready for
-* next transactions.
+* next transactions. If the released message was a buffer descriptor, CM0+
+* has handed the payload back and the buffer returns to the pool. A released
+* LED message returns its block to cm7_0LedMsgPool.
 *
 * Parameters:
 *  None
@@ -209,7 +1049,20 @@ int main(void)
 *******************************************************************************/
 void Pipe0_cm7_0_ReleaseCallback(void)
 {
+    IPC_STATS_RECORD(&cm7_0Stats, CY_IPC_STATS_STAGE_RELEASE, cm7_0InFlightSent);
+    IPC_TRACE(&cm7_0Trace, CY_IPC_TRACE_RELEASE, CY_IPC_EP_CYPIPE_CM0_ADDR, CY_IPC_TRACE_NO_CLIENT, NULL, 0UL);
+
+    if (cm7_0DescInFlight)
+    {
+        Cy_IPC_ShBuf_Free(&cm7_0ShBuf, cm7_0DescMsg.payload.offset, cm7_0DescMsg.payload.length);
+        cm7_0DescInFlight = false;
+    }
 
+    if (NULL != cm7_0LedInFlight)
+    {
+        (void)Cy_IPC_Pool_Free(&cm7_0LedMsgPool, cm7_0LedInFlight);
+        cm7_0LedInFlight = NULL;
+    }
 }
 
 /*******************************************************************************
@@ -226,7 +1079,56 @@ void Pipe0_cm7_0_ReleaseCallback(void)
 *******************************************************************************/
 void Cy_SysIpcPipeIsrCm7_0(void)
 {
+    IPC_TRACE(&cm7_0Trace, CY_IPC_TRACE_ISR, CY_IPC_EP_CYPIPE_CM7_0_ADDR, CY_IPC_TRACE_NO_CLIENT, NULL, 0UL);
     Cy_IPC_Pipe_ExecuteCallback(CY_IPC_EP_CYPIPE_CM7_0_ADDR);
+
+#if IPC_RING_TRANSPORT
+    /* The channel is free again once the release was handled, and CM0+
+     * granted credit for what it drained. A batch that filled up while the
+     * doorbell was busy still needs one. */
+    Pipe0_cm7_0_FlushBacklog();
+    if (Cy_IPC_Batch_IsDue(&cm7_0Batch, cm7_0TickMs))
+    {
+        Pipe0_cm7_0_RingDoorbell();
+    }
+#endif /* IPC_RING_TRANSPORT */
+
+    /* Jobs that ran out of credit or found the pipe busy can retry */
+    Cy_IPC_Sched_Unblock(&cm7_0Sched);
+}
+
+/*******************************************************************************
+* Function Name: Cy_SysIpcPipeIsrCm7_0Control
+********************************************************************************
+* Summary:
+* This is the interrupt service routine of the control lane. It has a higher
+* priority than Cy_SysIpcPipeIsrCm7_0, so RPC responses complete while a bulk
+* release is being handled. The responses are rung with a bare notify, taken
+* before the pipe driver looks at the channel, which EP4 shares with EP3. A
+* job that found the control pipe busy can retry after the release.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Cy_SysIpcPipeIsrCm7_0Control(void)
+{
+    IPC_TRACE(&cm7_0Trace, CY_IPC_TRACE_ISR, CY_IPC_EP_CYPIPE_CM7_0_CTL_ADDR, CY_IPC_TRACE_NO_CLIENT, NULL, 0UL);
+    if (Cy_IPC_Cypipe_TakeNotify(CY_IPC_INTR_CYPIPE_EP4))
+    {
+        Pipe2_cm7_0_CompleteRpc();
+    }
+    Cy_IPC_Pipe_ExecuteCallback(CY_IPC_EP_CYPIPE_CM7_0_CTL_ADDR);
+
+    /* CM0+ drains the requests before it releases, anything left was queued since */
+    if (0UL != Cy_IPC_Ring_Count(&cm7_0RpcRequestRing))
+    {
+        Pipe2_cm7_0_RingRpcDoorbell();
+    }
+
+    Cy_IPC_Sched_Unblock(&cm7_0Sched);
 }
 
 /*******************************************************************************
@@ -248,6 +1150,12 @@ void handle_error(void)
      /* Disable all interrupts */
     __disable_irq();
 
+#if IPC_TRACE_ENABLE
+    /* Keep the events that led here for the host tool */
+    IPC_TRACE(&cm7_0Trace, CY_IPC_TRACE_ERROR, 0UL, CY_IPC_TRACE_NO_CLIENT, NULL, 0UL);
+    Cy_IPC_Trace_Save(&cm7_0Trace);
+#endif /* IPC_TRACE_ENABLE */
+
     /* Halt the CPU */
     CY_ASSERT(0);
 }
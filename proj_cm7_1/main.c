@@ -42,13 +42,73 @@
 
 #include "cy_pdl.h"
 #include "cybsp.h"
+#include "ipc_topology.h"
+#include "ipc_stats.h"
+#include "ipc_trace.h"
+#include "ipc_ring.h"
+#include "ipc_batch.h"
+#include "ipc_credit.h"
+#include "ipc_pubsub.h"
+#include "ipc_handoff.h"
+#include "ipc_messages.h"
 
+/****************************************************************************
+* Constants
+*****************************************************************************/
+#define CM7_1_LOAD_PRODUCER     1       /* 1: streams load messages to CM0+; 0: only follows the LED topic, in deep sleep */
+#define IPC_RING_DEPTH          (16UL)  /* Ring depth, must be a power of two */
+#define IPC_BATCH_THRESHOLD     (8UL)   /* Messages per doorbell */
+
+/****************************************************************************
+* Global variables
+*****************************************************************************/
+#if CM7_1_LOAD_PRODUCER
+/* Ring and doorbell are read by CM0+, keep them out of the stack and TCM */
+static cy_stc_ipc_ring_t cm7_1Ring;
+CY_ALIGN(IPC_PORT_CACHE_LINE) static uint8_t cm7_1RingBuf[CY_IPC_RING_STORAGE_SIZE(sizeof(cy_stc_ipc_testmsg_t), IPC_RING_DEPTH)];
+static cy_stc_ipc_credit_t cm7_1Credit;     /* Credits granted by CM0+ */
+static cy_stc_ipc_credit_tx_t cm7_1CreditTx;
+static cy_stc_ipc_doorbellmsg_t cm7_1DoorbellMsg;
+static cy_stc_ipc_batch_t cm7_1Batch;
+static cy_stc_ipc_msg_tx_t cm7_1RingTx;     /* Numbers the messages of the ring */
+#if IPC_STATS_ENABLE
+static cy_stc_ipc_stats_t cm7_1Stats;       /* Latency of the load messages */
+#endif /* IPC_STATS_ENABLE */
+#endif /* CM7_1_LOAD_PRODUCER */
+#if IPC_TRACE_ENABLE
+static cy_stc_ipc_trace_t cm7_1Trace;       /* Events of this core, saved by handle_error() */
+#endif /* IPC_TRACE_ENABLE */
+static cy_stc_ipc_handoff_t cm7_1Handoff;   /* Messages to and from CM0+, maintained by line */
+static cy_stc_ipc_pubsub_sub_t cm7_1LedSub; /* LED topic of CM7_0, handed on by CM0+ */
+static volatile bool cm7_1Subscribed;       /* The LED topic was handed on */
+/* Topic request, answered in place by CM0+. It owns its cache lines, as
+ * CM7_1 invalidates it to read the answer. */
+CY_ALIGN(CY_IPC_HANDOFF_ALIGN) static uint8_t cm7_1TopicBuf[CY_IPC_HANDOFF_SIZE(sizeof(cy_stc_ipc_topicmsg_t))];
+static volatile uint32_t cm7_1Led;          /* LED state published last by CM7_0 */
+
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+#if CM7_1_LOAD_PRODUCER
+void Pipe1_cm7_1_RingDoorbell(void);
+void Pipe1_cm7_1_ReleaseCallback(void);
+#endif /* CM7_1_LOAD_PRODUCER */
+void Cm7_1_ReceiveTopic(void);
+void Cy_SysIpcPipeIsrCm7_1(void);
+void handle_error(void);
 
 /*******************************************************************************
 * Function Name: main
 ********************************************************************************
 * Summary:
-* This is the main function for the CM7_1 core. It put the core into DeepSleep mode.
+* This is the main function for CM7_1 CPU. CM7_1 follows the LED topic of
+* CM7_0 and, with CM7_1_LOAD_PRODUCER, is a second producer next to CM7_0: it
+* streams load messages to CM0+ through its own ring and its own CM0+
+* endpoint as fast as CM0+ grants credits for them, and sleeps while it has
+* none. The stream is loss-free, so a send without credit blocks. Without
+* CM7_1_LOAD_PRODUCER it stays in deep sleep between the notifications of the
+* topic.
 *
 * Parameters:
 *  void
@@ -60,6 +120,18 @@
 int main(void)
 {
     cy_rslt_t result;
+    cy_en_ipc_pipe_status_t pipeStatus;
+    cy_stc_ipc_topicmsg_t *pTopic = (cy_stc_ipc_topicmsg_t *)cm7_1TopicBuf;
+#if CM7_1_LOAD_PRODUCER
+    uint32_t interruptState;
+    cy_en_ipc_credit_status_t creditStatus;
+    cy_stc_ipc_testmsg_t cm7_1MsgData;
+#endif /* CM7_1_LOAD_PRODUCER */
+    static cy_stc_ipc_pipe_ep_t IpcPipeEpArray[CY_IPC_MAX_ENDPOINTS]; /* Create an array of endpoint structures */
+
+    /* Pipe-1 endpoint-2 and endpoint-5. CM7_1 <--> CM0, EP2 has no clients */
+    static const cy_stc_ipc_pipe_config_t systemIpcPipe1ConfigCm7_1 =
+        CY_IPC_CYPIPE_PIPE_CONFIG(2, 5, NULL, &Cy_SysIpcPipeIsrCm7_1);
 
     /* Initialize the device and board peripherals */
     result = cybsp_init();
@@ -71,10 +143,272 @@ int main(void)
     /* enable interrupts */
     __enable_irq();
 
+    Cy_IPC_Pipe_Config(IpcPipeEpArray);
+    if (CY_IPC_HANDOFF_SUCCESS != Cy_IPC_Handoff_Init(&cm7_1Handoff, NULL, 0UL, CY_IPC_HANDOFF_CACHED))
+    {
+        handle_error();
+    }
+
+    Cy_IPC_Pipe_Init(&systemIpcPipe1ConfigCm7_1); /* PIPE-1 EP2 <--> EP5 */
+
+#if IPC_TRACE_ENABLE
+    Cy_IPC_Trace_Init(&cm7_1Trace, CY_IPC_CORE_CM7_1);
+#endif /* IPC_TRACE_ENABLE */
+
+    /* Client CM0_ID6 answers with the LED topic once CM7_0 has handed it out,
+     * and rings EP2. It is the first message on the pipe, which is free. */
+    Cy_IPC_Msg_InitTopic(pTopic, CY_CLIENT_CYPIPE1_CM0_ID6, CY_IPC_PKT_FROM_CM7_1_TO_CM0, CY_IPC_CYPIPE_INTR_MASK_EP2);
+    Cy_IPC_Msg_Seal(pTopic, NULL);
+    Cy_IPC_Handoff_SendMsg(&cm7_1Handoff, pTopic);
+    IPC_TRACE_SEND(&cm7_1Trace, CY_IPC_EP_CYPIPE_CM0_CM7_1_ADDR, pTopic);
+    pipeStatus = Cy_IPC_Pipe_SendMessage(CY_IPC_EP_CYPIPE_CM0_CM7_1_ADDR, CY_IPC_EP_CYPIPE_CM7_1_ADDR, (void *) pTopic, NULL);
+    IPC_TRACE_SENT(&cm7_1Trace, CY_IPC_EP_CYPIPE_CM0_CM7_1_ADDR, pTopic, pipeStatus == CY_IPC_PIPE_SUCCESS);
+    if (CY_IPC_PIPE_SUCCESS != pipeStatus)
+    {
+        handle_error();
+    }
+
+#if CM7_1_LOAD_PRODUCER
+#if IPC_STATS_ENABLE
+    Cy_IPC_Stats_Init(&cm7_1Stats);
+#endif /* IPC_STATS_ENABLE */
+
+    if (CY_IPC_RING_SUCCESS != Cy_IPC_Ring_Init(&cm7_1Ring, cm7_1RingBuf, sizeof(cy_stc_ipc_testmsg_t), IPC_RING_DEPTH))
+    {
+        handle_error();
+    }
+
+    /* Client CM0_ID4 drains the ring */
+    Cy_IPC_Msg_InitDoorbell(&cm7_1DoorbellMsg, CY_CLIENT_CYPIPE1_CM0_ID4, CY_IPC_PKT_FROM_CM7_1_TO_CM0, CY_IPC_CYPIPE_INTR_MASK_EP2);
+    cm7_1DoorbellMsg.payload.ring = &cm7_1Ring;
+    cm7_1DoorbellMsg.payload.credit = &cm7_1Credit;
+    Cy_IPC_Msg_Seal(&cm7_1DoorbellMsg, NULL);
+    /* The doorbell never changes, hand it over once */
+    Cy_IPC_Handoff_SendMsg(&cm7_1Handoff, &cm7_1DoorbellMsg);
+
+    /* The whole ring until CM0+ grants its own window */
+    Cy_IPC_Credit_InitTx(&cm7_1CreditTx, &cm7_1Credit, &cm7_1Ring, CY_IPC_CREDIT_POLICY_BLOCK, NULL, IPC_RING_DEPTH);
+
+    /* The stream never pauses, so batches are closed by size only */
+    Cy_IPC_Batch_Init(&cm7_1Batch, IPC_BATCH_THRESHOLD, UINT32_MAX);
+
+    /* Client CM0_ID5 consumes the load */
+    Cy_IPC_Msg_InitHeader(&cm7_1MsgData.hdr, CY_CLIENT_CYPIPE1_CM0_ID5, CY_IPC_PKT_FROM_CM7_1_TO_CM0, CY_IPC_CYPIPE_INTR_MASK_EP2, 0UL);
+
     for(;;)
     {
-        Cy_SysPm_CpuEnterDeepSleep(CY_SYSPM_WAIT_FOR_INTERRUPT);
+        IPC_STATS_STAMP(&cm7_1MsgData, &cm7_1Stats);
+        Cy_IPC_Msg_Seal(&cm7_1MsgData, &cm7_1RingTx);
+        creditStatus = Cy_IPC_Credit_Send(&cm7_1CreditTx, &cm7_1MsgData);
+        if (CY_IPC_CREDIT_SUCCESS == creditStatus)
+        {
+            Cy_IPC_Msg_Sent(&cm7_1RingTx);
+            interruptState = Cy_SysLib_EnterCriticalSection();
+            if (Cy_IPC_Batch_Add(&cm7_1Batch, 0UL))
+            {
+                Pipe1_cm7_1_RingDoorbell();
+            }
+            Cy_SysLib_ExitCriticalSection(interruptState);
+        }
+        else
+        {
+            /* Out of credit: wait for the release of the doorbell. CM0+
+             * grants before it releases, or right after with
+             * CM0_DEFERRED_WORK, so recheck with interrupts masked; a
+             * pending release still wakes WFI. EP5 is CM7_1's own channel:
+             * a doorbell is only refused while the previous one is not yet
+             * released, so there is always a release to wait for. */
+            interruptState = Cy_SysLib_EnterCriticalSection();
+            Pipe1_cm7_1_RingDoorbell();
+            if ((0UL == Cy_IPC_Credit_Available(&cm7_1CreditTx)) && Cy_IPC_Pipe_EndpointIsBusy(CY_IPC_EP_CYPIPE_CM7_1_ADDR))
+            {
+                __WFI();
+            }
+            Cy_SysLib_ExitCriticalSection(interruptState);
+        }
+    }
+#else
+    /* Only the LED topic notifications wake the core */
+    for(;;)
+    {
+        (void)Cy_SysPm_CpuEnterDeepSleep(CY_SYSPM_WAIT_FOR_INTERRUPT);
+    }
+#endif /* CM7_1_LOAD_PRODUCER */
+}
+
+#if CM7_1_LOAD_PRODUCER
+
+/*******************************************************************************
+* Function Name: Pipe1_cm7_1_RingDoorbell
+********************************************************************************
+* Summary:
+* Tells CM0+ to drain the ring. Must be called with interrupts masked. A busy
+* pipe means a doorbell is already on its way; the pipe ISR rings again after
+* its release if more messages were queued meanwhile.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Pipe1_cm7_1_RingDoorbell(void)
+{
+    cy_en_ipc_pipe_status_t pipeStatus;
+
+    IPC_TRACE_SEND(&cm7_1Trace, CY_IPC_EP_CYPIPE_CM0_CM7_1_ADDR, &cm7_1DoorbellMsg);
+    pipeStatus = Cy_IPC_Pipe_SendMessage(CY_IPC_EP_CYPIPE_CM0_CM7_1_ADDR, CY_IPC_EP_CYPIPE_CM7_1_ADDR, (void *) &cm7_1DoorbellMsg, &Pipe1_cm7_1_ReleaseCallback);
+    IPC_TRACE_SENT(&cm7_1Trace, CY_IPC_EP_CYPIPE_CM0_CM7_1_ADDR, &cm7_1DoorbellMsg, pipeStatus == CY_IPC_PIPE_SUCCESS);
+    if (pipeStatus == CY_IPC_PIPE_SUCCESS)
+    {
+        Cy_IPC_Batch_Sent(&cm7_1Batch);
+    }
+
+    if ((pipeStatus != CY_IPC_PIPE_SUCCESS) && (pipeStatus != CY_IPC_PIPE_ERROR_SEND_BUSY))
+    {
+        handle_error();
+    }
+}
+
+/*******************************************************************************
+* Function Name: Pipe1_cm7_1_ReleaseCallback
+********************************************************************************
+* Summary:
+* CM0+ has taken the doorbell, the channel is free again.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Pipe1_cm7_1_ReleaseCallback(void)
+{
+    IPC_TRACE(&cm7_1Trace, CY_IPC_TRACE_RELEASE, CY_IPC_EP_CYPIPE_CM0_CM7_1_ADDR, CY_IPC_TRACE_NO_CLIENT, NULL, 0UL);
+}
+#endif /* CM7_1_LOAD_PRODUCER */
+
+/*******************************************************************************
+* Function Name: Cm7_1_ReceiveTopic
+********************************************************************************
+* Summary:
+* Reads CM0+'s answer to the topic request: the LED topic of CM7_0 and the
+* slot to subscribe in, notified on the pipe interrupt. Called on every
+* notify until CM7_1 has subscribed. CM0+ seals the answer before it
+* notifies, so an answer that fails its check is an error.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Cm7_1_ReceiveTopic(void)
+{
+    const cy_stc_ipc_topicmsg_t *pTopic;
+
+    Cy_IPC_Handoff_ReceiveMsg(&cm7_1Handoff, cm7_1TopicBuf, CY_IPC_MESSAGES_MAX_LENGTH);
+    if (CY_IPC_MSG_SUCCESS != Cy_IPC_Msg_Check(cm7_1TopicBuf, CY_IPC_MESSAGES_MAX_LENGTH, NULL))
+    {
+        handle_error();
+    }
+
+    pTopic = Cy_IPC_Msg_GetTopic((const uint32_t *)cm7_1TopicBuf);
+    if ((NULL == pTopic) || (NULL == pTopic->payload.topic))
+    {
+        return;
+    }
+
+    if (CY_IPC_PUBSUB_SUCCESS != Cy_IPC_PubSub_Subscribe(&cm7_1LedSub, pTopic->payload.topic, pTopic->payload.subscriber, CY_IPC_CYPIPE_INTR_MASK_EP2))
+    {
+        handle_error();
+    }
+    cm7_1Subscribed = true;
+}
+
+/*******************************************************************************
+* Function Name: Cy_SysIpcPipeIsrCm7_1
+********************************************************************************
+* Summary:
+* This is the interrupt service routine for the pipe. EP2 has no clients and
+* shares its channel with EP5, where CM7_1's own messages wait, so every
+* notify is a bare one: the answer of CM0+ to the topic request, then the
+* notifications of the LED topic. They are taken before the pipe driver
+* looks at the channel, which then only handles the releases.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*******************************************************************************/
+void Cy_SysIpcPipeIsrCm7_1(void)
+{
+    const cy_stc_ipc_ledstate_t *pState;
+    uint32_t length = 0UL;
+    bool notified;
+
+    IPC_TRACE(&cm7_1Trace, CY_IPC_TRACE_ISR, CY_IPC_EP_CYPIPE_CM7_1_ADDR, CY_IPC_TRACE_NO_CLIENT, NULL, 0UL);
+    notified = Cy_IPC_Cypipe_TakeNotify(CY_IPC_INTR_CYPIPE_EP2);
+    Cy_IPC_Pipe_ExecuteCallback(CY_IPC_EP_CYPIPE_CM7_1_ADDR);
+
+    if (notified)
+    {
+        if (!cm7_1Subscribed)
+        {
+            Cm7_1_ReceiveTopic();
+        }
+
+        pState = (const cy_stc_ipc_ledstate_t *)Cy_IPC_PubSub_Receive(&cm7_1LedSub, &length);
+        while (NULL != pState)
+        {
+            if (sizeof(*pState) == length)
+            {
+                cm7_1Led = pState->led;
+            }
+            Cy_IPC_PubSub_Release(&cm7_1LedSub);
+            pState = (const cy_stc_ipc_ledstate_t *)Cy_IPC_PubSub_Receive(&cm7_1LedSub, &length);
+        }
+    }
+
+#if CM7_1_LOAD_PRODUCER
+    /* The channel is free again once the release was handled. Only messages
+     * queued since the last doorbell need one: with CM0_DEFERRED_WORK the
+     * release comes before the drain, and rechecking the ring count would
+     * ring again at once. */
+    if (Cy_IPC_Batch_IsDue(&cm7_1Batch, 0UL))
+    {
+        Pipe1_cm7_1_RingDoorbell();
     }
+#endif /* CM7_1_LOAD_PRODUCER */
+}
+
+/*******************************************************************************
+* Function Name: handle_error
+********************************************************************************
+* Summary:
+* User defined error handling function
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void handle_error(void)
+{
+     /* Disable all interrupts */
+    __disable_irq();
+
+#if IPC_TRACE_ENABLE
+    /* Keep the events that led here for the host tool */
+    IPC_TRACE(&cm7_1Trace, CY_IPC_TRACE_ERROR, 0UL, CY_IPC_TRACE_NO_CLIENT, NULL, 0UL);
+    Cy_IPC_Trace_Save(&cm7_1Trace);
+#endif /* IPC_TRACE_ENABLE */
+
+    /* Halt the CPU */
+    CY_ASSERT(0);
 }
 
 /* [] END OF FILE */
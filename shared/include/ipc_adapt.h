@@ -0,0 +1,112 @@
+/******************************************************************************
+* File Name:   ipc_adapt.h
+*
+* Description: Adaptive receive mode for a message queue. The receiver
+*              takes an interrupt per notify while traffic is light and
+*              switches to a bounded busy-poll of the queue, with the
+*              interrupt masked, while the arrival rate is high.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef IPC_ADAPT_H
+#define IPC_ADAPT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef enum
+{
+    CY_IPC_ADAPT_MODE_IRQ,      /* Interrupt per notify, the receiver sleeps in between */
+    CY_IPC_ADAPT_MODE_POLL,     /* Interrupt masked, the receiver polls the queue */
+    CY_IPC_ADAPT_MODE_CNT
+} cy_en_ipc_adapt_mode_t;
+
+/* Thresholds. The tick unit is chosen by the caller. exitRate below
+ * enterRate keeps a rate near the threshold from flipping the mode every
+ * window.
+ */
+typedef struct
+{
+    uint32_t window;        /* Ticks over which the arrival rate is measured */
+    uint32_t enterRate;     /* Arrivals per window at or above which the receiver polls */
+    uint32_t exitRate;      /* Arrivals per window below which it takes interrupts again */
+    uint32_t pollBudget;    /* Empty polls in a row after which it takes interrupts again */
+} cy_stc_ipc_adapt_config_t;
+
+/* Mode state and counters of one receiver. The structure is local to the
+ * receiving core; Cy_IPC_Adapt_Arrived() may be called from the interrupt
+ * that Cy_IPC_Adapt_Update() masks, so the caller must mask it around
+ * Cy_IPC_Adapt_Update().
+ */
+typedef struct
+{
+    cy_stc_ipc_adapt_config_t config;
+    cy_en_ipc_adapt_mode_t mode;
+    uint32_t arrivals;          /* Total messages counted */
+    uint32_t windowStart;       /* Tick at which the current window started */
+    uint32_t windowArrivals;    /* arrivals when it started */
+    uint32_t lastTick;          /* Tick of the last update */
+    uint32_t lastArrivals;      /* arrivals at the last update */
+    uint32_t idlePolls;         /* Empty polls in a row */
+    uint64_t ticks[CY_IPC_ADAPT_MODE_CNT];    /* Time spent in each mode */
+    uint32_t switches[CY_IPC_ADAPT_MODE_CNT]; /* Switches into each mode */
+    uint32_t polls;             /* Total polls */
+    uint32_t emptyPolls;        /* Polls that found nothing */
+} cy_stc_ipc_adapt_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void Cy_IPC_Adapt_Init(cy_stc_ipc_adapt_t *adapt, const cy_stc_ipc_adapt_config_t *config, uint32_t now);
+void Cy_IPC_Adapt_Arrived(cy_stc_ipc_adapt_t *adapt, uint32_t count);
+cy_en_ipc_adapt_mode_t Cy_IPC_Adapt_Update(cy_stc_ipc_adapt_t *adapt, uint32_t now);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* IPC_ADAPT_H */
+
+/* [] END OF FILE */
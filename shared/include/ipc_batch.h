@@ -0,0 +1,87 @@
+/******************************************************************************
+* File Name:   ipc_batch.h
+*
+* Description: Doorbell coalescing for the shared ring transport. The sender
+*              queues messages and rings the pipe doorbell once per batch,
+*              when a count threshold is reached or the oldest queued
+*              message times out.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef IPC_BATCH_H
+#define IPC_BATCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+/* Batching state of one sender. The tick unit is chosen by the caller. The
+ * structure is local to the sending core; callers that use it from thread and
+ * interrupt context must serialize the calls.
+ */
+typedef struct
+{
+    uint32_t threshold;     /* Doorbell once this many messages are pending, 1 disables batching */
+    uint32_t timeout;       /* Doorbell once the oldest pending message is this many ticks old */
+    uint32_t pending;       /* Messages queued since the last doorbell */
+    uint32_t firstTick;     /* Tick at which the oldest pending message was queued */
+    uint32_t messages;      /* Total messages queued */
+    uint32_t doorbells;     /* Total doorbells sent */
+} cy_stc_ipc_batch_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void Cy_IPC_Batch_Init(cy_stc_ipc_batch_t *batch, uint32_t threshold, uint32_t timeout);
+bool Cy_IPC_Batch_Add(cy_stc_ipc_batch_t *batch, uint32_t now);
+bool Cy_IPC_Batch_IsDue(const cy_stc_ipc_batch_t *batch, uint32_t now);
+void Cy_IPC_Batch_Sent(cy_stc_ipc_batch_t *batch);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* IPC_BATCH_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,138 @@
+/******************************************************************************
+* File Name:   ipc_consumer.h
+*
+* Description: Receive side of the bulk lane on CM0+: the pipe ISR that
+*              serves the endpoint of every producer round-robin, the
+*              drain of the producer rings with their credit, and the
+*              deferred work queue and adaptive polling of the main loop.
+*              The application and the benchmark consume through it.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef IPC_CONSUMER_H
+#define IPC_CONSUMER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ipc_ring.h"
+#include "ipc_credit.h"
+#include "ipc_adapt.h"
+#include "ipc_trace.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+#ifndef CY_IPC_CONSUMER_MAX_PRODUCERS
+#define CY_IPC_CONSUMER_MAX_PRODUCERS   (2UL)   /* Producers of one consumer */
+#endif
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+/* A producer, learned from its doorbell */
+typedef struct
+{
+    cy_stc_ipc_ring_t *ring;        /* Shared ring, NULL until the first doorbell */
+    cy_stc_ipc_credit_rx_t credit;  /* Credits granted, and the producer's stalls and drops */
+    volatile uint32_t messages;     /* Messages drained from the ring */
+} cy_stc_ipc_consumer_producer_t;
+
+/* Handles a message drained from the ring of a producer; received is the
+ * ISR entry time of the doorbell */
+typedef void (*cy_ipc_consumer_msg_t)(void *msg, uint32_t producer, uint32_t received);
+/* Handles a work item taken from the work queue */
+typedef void (*cy_ipc_consumer_work_t)(void *item);
+/* Enables or disables the interrupts of all endpoints */
+typedef void (*cy_ipc_consumer_irq_t)(bool enable);
+/* Called after the pipe ISR served an endpoint */
+typedef void (*cy_ipc_consumer_served_t)(uint32_t ep);
+
+typedef struct
+{
+    const uint32_t *endpoints;                  /* Receive endpoint of each producer */
+    cy_stc_ipc_consumer_producer_t *producers;  /* One per endpoint */
+    uint32_t producerCount;                     /* 1 .. CY_IPC_CONSUMER_MAX_PRODUCERS */
+    uint32_t drainBudget;                       /* Messages taken from one producer before moving to the next */
+    cy_stc_ipc_ring_t *work;                    /* Deferred work queue, NULL if the ISR handles every message */
+    uint32_t workDepth;                         /* Depth of the work queue */
+    void *msg;                                  /* Buffer of one ring message */
+    void *item;                                 /* Buffer of one work item */
+    cy_ipc_consumer_msg_t onMessage;            /* Handler of the ring messages */
+    cy_ipc_consumer_work_t onWork;              /* Handler of the work items, NULL without a work queue */
+    cy_ipc_consumer_irq_t enableIrq;            /* Masks the endpoints while stalled or polling */
+    cy_ipc_consumer_served_t onServed;          /* NULL for none */
+    cy_stc_ipc_trace_t *trace;                  /* ISR events with IPC_TRACE_ENABLE, NULL for none */
+} cy_stc_ipc_consumer_config_t;
+
+/* State of the consumer, local to CM0+ */
+typedef struct
+{
+    const cy_stc_ipc_consumer_config_t *config;
+    uint32_t first;                 /* Index of the endpoint the next ISR serves first */
+    uint32_t received;              /* ISR entry time, set with IPC_STATS_ENABLE */
+    volatile bool stalled;          /* Interrupts disabled until the work queue has room */
+    volatile bool drainDue;         /* A producer rang, the main loop drains */
+    volatile uint32_t drainReceived; /* ISR entry time of that doorbell */
+} cy_stc_ipc_consumer_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void Cy_IPC_Consumer_Init(cy_stc_ipc_consumer_t *consumer, const cy_stc_ipc_consumer_config_t *config);
+void Cy_IPC_Consumer_Isr(cy_stc_ipc_consumer_t *consumer);
+void Cy_IPC_Consumer_Attach(cy_stc_ipc_consumer_t *consumer, uint32_t producer, cy_stc_ipc_ring_t *ring,
+                            cy_stc_ipc_credit_t *credit, uint32_t window);
+void Cy_IPC_Consumer_Drain(cy_stc_ipc_consumer_t *consumer, uint32_t received);
+void Cy_IPC_Consumer_DrainLater(cy_stc_ipc_consumer_t *consumer, uint32_t received);
+bool Cy_IPC_Consumer_Defer(cy_stc_ipc_consumer_t *consumer, const void *item);
+void Cy_IPC_Consumer_RunDeferred(cy_stc_ipc_consumer_t *consumer);
+bool Cy_IPC_Consumer_IsIdle(cy_stc_ipc_consumer_t *consumer);
+void Cy_IPC_Consumer_RunAdaptive(cy_stc_ipc_consumer_t *consumer, cy_stc_ipc_adapt_t *adapt);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* IPC_CONSUMER_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,136 @@
+/******************************************************************************
+* File Name:   ipc_credit.h
+*
+* Description: Credit-based flow control over a shared ring. The receiver
+*              grants the sender credits as it consumes; a sender out of
+*              credits blocks, queues or drops the message by policy, and
+*              both sides count the stalls and drops.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef IPC_CREDIT_H
+#define IPC_CREDIT_H
+
+#include "ipc_port.h"
+#include "ipc_ring.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+/* What a send does when the sender has no credit left */
+typedef enum
+{
+    CY_IPC_CREDIT_POLICY_BLOCK,     /* Nothing is written, the caller retries once credit returns */
+    CY_IPC_CREDIT_POLICY_QUEUE,     /* The message waits in the sender's backlog, dropped if that is full */
+    CY_IPC_CREDIT_POLICY_DROP,      /* The message is discarded */
+} cy_en_ipc_credit_policy_t;
+
+typedef enum
+{
+    CY_IPC_CREDIT_SUCCESS,          /* Message is in the shared ring */
+    CY_IPC_CREDIT_QUEUED,           /* Message is in the backlog, Cy_IPC_Credit_Flush() sends it */
+    CY_IPC_CREDIT_BLOCKED,          /* No credit, nothing was written */
+    CY_IPC_CREDIT_DROPPED,          /* No credit, the message was discarded */
+} cy_en_ipc_credit_status_t;
+
+/* Credit block of one sender/receiver pair. Place it in SRAM visible to both
+ * cores, next to the ring. Each line is written by one core only, like the
+ * head and tail of the ring. All counters are running totals, so a value
+ * read late is only stale, never wrong.
+ */
+typedef struct
+{
+    CY_ALIGN(IPC_PORT_CACHE_LINE) cy_ipc_atomic32_t granted; /* Receiver line: messages the sender may have sent in total */
+
+    CY_ALIGN(IPC_PORT_CACHE_LINE) cy_ipc_atomic32_t stalls;  /* Sender line: times the sender ran out of credit */
+    cy_ipc_atomic32_t queued;                                 /* Sender line: messages that waited in the backlog */
+    cy_ipc_atomic32_t drops;                                  /* Sender line: messages discarded for lack of credit */
+} cy_stc_ipc_credit_t;
+
+/* Sender state, local to the sending core. Callers that use it from thread
+ * and interrupt context must serialize the calls.
+ */
+typedef struct
+{
+    cy_stc_ipc_credit_t *credit;        /* Shared credit block */
+    cy_stc_ipc_ring_t *ring;            /* Shared ring to the receiver */
+    cy_stc_ipc_ring_t *backlog;         /* CY_IPC_CREDIT_POLICY_QUEUE: local ring of the same element size */
+    cy_en_ipc_credit_policy_t policy;
+    uint32_t granted;                   /* Grant last read from the credit block */
+    uint32_t sent;                      /* Messages written to the shared ring */
+    bool stalled;                       /* Out of credit since the last send */
+    uint32_t stalls;                    /* Times the sender ran out of credit */
+    uint32_t queued;                    /* Messages that waited in the backlog */
+    uint32_t drops;                     /* Messages discarded for lack of credit */
+} cy_stc_ipc_credit_tx_t;
+
+/* Receiver state, local to the receiving core */
+typedef struct
+{
+    cy_stc_ipc_credit_t *credit;        /* Shared credit block */
+    uint32_t window;                    /* Messages the sender may have outstanding */
+    uint32_t consumed;                  /* Messages taken from the shared ring */
+    uint32_t grants;                    /* Credit updates published */
+    uint32_t stalls;                    /* Sender stalls, as of the last grant */
+    uint32_t queued;                    /* Sender backlog messages, as of the last grant */
+    uint32_t drops;                     /* Sender drops, as of the last grant */
+} cy_stc_ipc_credit_rx_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void Cy_IPC_Credit_InitTx(cy_stc_ipc_credit_tx_t *tx, cy_stc_ipc_credit_t *credit, cy_stc_ipc_ring_t *ring,
+                          cy_en_ipc_credit_policy_t policy, cy_stc_ipc_ring_t *backlog, uint32_t initial);
+cy_en_ipc_credit_status_t Cy_IPC_Credit_Send(cy_stc_ipc_credit_tx_t *tx, const void *msg);
+uint32_t Cy_IPC_Credit_Flush(cy_stc_ipc_credit_tx_t *tx);
+uint32_t Cy_IPC_Credit_Available(cy_stc_ipc_credit_tx_t *tx);
+void Cy_IPC_Credit_InitRx(cy_stc_ipc_credit_rx_t *rx, cy_stc_ipc_credit_t *credit, uint32_t window);
+void Cy_IPC_Credit_Grant(cy_stc_ipc_credit_rx_t *rx, uint32_t consumed);
+void Cy_IPC_Credit_SetWindow(cy_stc_ipc_credit_rx_t *rx, uint32_t window);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* IPC_CREDIT_H */
+
+/* [] END OF FILE */
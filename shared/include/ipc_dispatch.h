@@ -0,0 +1,117 @@
+/******************************************************************************
+* File Name:   ipc_dispatch.h
+*
+* Description: Receive-side dispatch table indexed by (clientID, pktType).
+*              Handlers are looked up in O(1) from the pipe interrupt and can
+*              be registered or removed at runtime without locking the ISR.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef IPC_DISPATCH_H
+#define IPC_DISPATCH_H
+
+#include "ipc_port.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+#ifndef CY_IPC_DISPATCH_MAX_CLIENTS
+#define CY_IPC_DISPATCH_MAX_CLIENTS     (16UL)  /* Client IDs 0 .. MAX_CLIENTS - 1 */
+#endif
+
+#ifndef CY_IPC_DISPATCH_MAX_TYPES
+#define CY_IPC_DISPATCH_MAX_TYPES       (8UL)   /* Packet types 0 .. MAX_TYPES - 1 */
+#endif
+
+/* Layout of the first message word shared by every pipe message */
+#define CY_IPC_DISPATCH_CLIENT_Pos      (0UL)
+#define CY_IPC_DISPATCH_CLIENT_Msk      (0x000000FFUL)
+#define CY_IPC_DISPATCH_TYPE_Pos        (8UL)
+#define CY_IPC_DISPATCH_TYPE_Msk        (0x0000FF00UL)
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef enum
+{
+    CY_IPC_DISPATCH_SUCCESS,            /* Operation completed */
+    CY_IPC_DISPATCH_ERROR_BAD_PARAM,    /* Client ID or packet type out of range */
+} cy_en_ipc_dispatch_status_t;
+
+/* Message handler. msgData points to the received message, context is the
+ * value given at registration.
+ */
+typedef void (*cy_ipc_dispatch_handler_t)(uint32_t *msgData, void *context);
+
+typedef struct
+{
+    _Atomic(cy_ipc_dispatch_handler_t) handler;   /* NULL when the slot is free */
+    void *context;                                  /* Passed to the handler */
+} cy_stc_ipc_dispatch_slot_t;
+
+/* Dispatch table of one receiving core. The handler pointer is published
+ * after its context, so the ISR never sees a handler with a stale context.
+ */
+typedef struct
+{
+    cy_stc_ipc_dispatch_slot_t slot[CY_IPC_DISPATCH_MAX_CLIENTS][CY_IPC_DISPATCH_MAX_TYPES];
+    cy_ipc_atomic32_t dispatched;       /* Messages delivered to a handler */
+    cy_ipc_atomic32_t unhandled;        /* Messages without a registered handler */
+} cy_stc_ipc_dispatch_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void Cy_IPC_Dispatch_Init(cy_stc_ipc_dispatch_t *table);
+cy_en_ipc_dispatch_status_t Cy_IPC_Dispatch_Register(cy_stc_ipc_dispatch_t *table, uint32_t clientID, uint32_t pktType,
+                                                     cy_ipc_dispatch_handler_t handler, void *context);
+cy_en_ipc_dispatch_status_t Cy_IPC_Dispatch_Unregister(cy_stc_ipc_dispatch_t *table, uint32_t clientID, uint32_t pktType);
+bool Cy_IPC_Dispatch_Message(cy_stc_ipc_dispatch_t *table, uint32_t *msgData);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* IPC_DISPATCH_H */
+
+/* [] END OF FILE */
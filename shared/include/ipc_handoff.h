@@ -0,0 +1,158 @@
+/******************************************************************************
+* File Name:   ipc_handoff.h
+*
+* Description: Cache-aware handoff of message buffers between cores. A
+*              sender writes back only the D-cache lines a message touches
+*              before it is sent, a receiver discards them before reading.
+*              Buffers can instead come from a pool mapped non-cacheable,
+*              which needs no maintenance at all.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef IPC_HANDOFF_H
+#define IPC_HANDOFF_H
+
+#include "ipc_port.h"
+#include "ipc_msg.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+/* A handoff buffer owns its cache lines: it starts on a line and its size is
+ * padded to whole lines, so that no maintenance hits unrelated data */
+#define CY_IPC_HANDOFF_ALIGN            (IPC_PORT_CACHE_LINE)
+#define CY_IPC_HANDOFF_SIZE(size)       (((uint32_t)(size) + CY_IPC_HANDOFF_ALIGN - 1UL) & ~(CY_IPC_HANDOFF_ALIGN - 1UL))
+
+/* Smallest non-cacheable pool, the smallest MPU region */
+#define CY_IPC_HANDOFF_MIN_UNCACHED     (32UL)
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef enum
+{
+    CY_IPC_HANDOFF_SUCCESS,         /* Operation completed */
+    CY_IPC_HANDOFF_ERROR_ALIGN,     /* Pool breaks the alignment rules of its mode */
+    CY_IPC_HANDOFF_ERROR_BAD_PARAM, /* Invalid mode or pool */
+} cy_en_ipc_handoff_status_t;
+
+typedef enum
+{
+    CY_IPC_HANDOFF_CACHED,          /* Clean on send, invalidate on receive, by line */
+    CY_IPC_HANDOFF_NONCACHEABLE,    /* Pool mapped non-cacheable, no maintenance inside it */
+} cy_en_ipc_handoff_mode_t;
+
+/* Handoff context of one core. The pool is optional in cached mode; buffers
+ * outside the pool are always maintained by line. Sender and receiver each
+ * keep their own context over the same pool, as the MPU is per core.
+ */
+typedef struct
+{
+    cy_en_ipc_handoff_mode_t mode;
+    uint8_t  *base;         /* Pool, NULL for none */
+    uint32_t  size;         /* Pool bytes */
+    uint32_t  used;         /* Pool bytes handed out by Cy_IPC_Handoff_Alloc() */
+} cy_stc_ipc_handoff_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_en_ipc_handoff_status_t Cy_IPC_Handoff_Init(cy_stc_ipc_handoff_t *handoff, void *base, uint32_t size, cy_en_ipc_handoff_mode_t mode);
+void *Cy_IPC_Handoff_Alloc(cy_stc_ipc_handoff_t *handoff, uint32_t size);
+void Cy_IPC_Handoff_Send(const cy_stc_ipc_handoff_t *handoff, const void *buf, uint32_t length);
+void Cy_IPC_Handoff_Receive(const cy_stc_ipc_handoff_t *handoff, const void *buf, uint32_t length);
+void Cy_IPC_Handoff_SendMsg(const cy_stc_ipc_handoff_t *handoff, const void *msg);
+void Cy_IPC_Handoff_ReceiveMsg(const cy_stc_ipc_handoff_t *handoff, const void *msg, uint32_t maxLength);
+
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Handoff_Lines
+********************************************************************************
+* Summary:
+* Returns the number of cache lines that [buf, buf + length) touches, which
+* is what a send or a receive of the range maintains in cached mode.
+*
+* Parameters:
+*  buf: Start of the range.
+*  length: Bytes.
+*
+* Return:
+*  Lines.
+*
+*******************************************************************************/
+static inline uint32_t Cy_IPC_Handoff_Lines(const void *buf, uint32_t length)
+{
+    uintptr_t start = (uintptr_t)buf & ~(uintptr_t)(CY_IPC_HANDOFF_ALIGN - 1UL);
+    uintptr_t end = ((uintptr_t)buf + length + CY_IPC_HANDOFF_ALIGN - 1UL) & ~(uintptr_t)(CY_IPC_HANDOFF_ALIGN - 1UL);
+
+    return (uint32_t)((end - start) / CY_IPC_HANDOFF_ALIGN);
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Handoff_OwnsLines
+********************************************************************************
+* Summary:
+* Checks that a buffer starts on a cache line and fills its last line, so
+* that cleaning or discarding it cannot touch data around it.
+*
+* Parameters:
+*  buf: Buffer.
+*  size: Buffer bytes.
+*
+* Return:
+*  true if the buffer owns all the lines it touches.
+*
+*******************************************************************************/
+static inline bool Cy_IPC_Handoff_OwnsLines(const void *buf, uint32_t size)
+{
+    return (0UL == ((uintptr_t)buf & (CY_IPC_HANDOFF_ALIGN - 1UL))) &&
+           (0UL == (size & (CY_IPC_HANDOFF_ALIGN - 1UL)));
+}
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* IPC_HANDOFF_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,142 @@
+/******************************************************************************
+* File Name:   ipc_messages.h
+*
+* Description: Messages exchanged by the CM0+, CM7_0 and CM7_1 projects. Each
+*              line of CY_IPC_MESSAGES declares one typed message in the
+*              format of ipc_msg.h together with its accessors.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef IPC_MESSAGES_H
+#define IPC_MESSAGES_H
+
+#include "ipc_msg.h"
+#include "ipc_ring.h"
+#include "ipc_credit.h"
+#include "ipc_shbuf.h"
+#include "ipc_pubsub.h"
+#include "ipc_seqlock.h"
+#include "ipc_stream.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+/* LED state (pktType is the state) and load messages, no payload */
+typedef cy_stc_ipc_msg_t cy_stc_ipc_testmsg_t;
+
+/****************************************************************************
+* Typed messages, X(Name, type, members). Generates the type and
+* Cy_IPC_Msg_Init<Name>(), Cy_IPC_Msg_Get<Name>() for every line.
+*****************************************************************************/
+#define CY_IPC_MESSAGES(X)                                                                  \
+    /* Ring doorbell: drain the ring */                                                     \
+    X(Doorbell,    cy_stc_ipc_doorbellmsg_t,                                                \
+      cy_stc_ipc_ring_t *ring;          /* Ring holding the queued messages */             \
+      cy_stc_ipc_credit_t *credit;      /* Credits granted by the receiver */)             \
+    /* Buffer descriptor: payload passed in the shared buffer pool */                      \
+    X(Desc,        cy_stc_ipc_descmsg_t,                                                    \
+      cy_stc_ipc_shbuf_t *pool;         /* Pool holding the payload */                     \
+      uint32_t offset;                  /* Payload offset from the pool base */            \
+      uint32_t length;                  /* Payload length in bytes */)                     \
+    /* RPC doorbell: serve the queued requests */                                           \
+    X(RpcDoorbell, cy_stc_ipc_rpcdoorbellmsg_t,                                             \
+      cy_stc_ipc_ring_t *request;       /* Requests from CM7_0 */                          \
+      cy_stc_ipc_ring_t *response;      /* Responses from CM0+ */)                         \
+    /* Topic: subscribe to a topic of the sender */                                         \
+    X(Topic,       cy_stc_ipc_topicmsg_t,                                                   \
+      cy_stc_ipc_pubsub_topic_t *topic; /* Topic owned by the publisher */                 \
+      uint32_t subscriber;              /* Subscriber slot of the receiver */)                 \
+    /* State: read the state region of the sender */                                        \
+    X(State,       cy_stc_ipc_statemsg_t,                                                   \
+      cy_stc_ipc_seqlock_t *state;      /* State region owned by the writer */)             \
+    /* Stream: consume the sample blocks of the sender */                                   \
+    X(Stream,      cy_stc_ipc_streammsg_t,                                                  \
+      cy_stc_ipc_stream_t *stream;      /* Stream owned by the producer */)
+
+CY_IPC_MESSAGES(CY_IPC_MSG_DEFINE)
+
+/* Longest payload of all messages, the receivers check against it */
+#define CY_IPC_X_PAYLOAD(Name, type, members)   struct { members } Name;
+typedef union
+{
+    CY_IPC_MESSAGES(CY_IPC_X_PAYLOAD)
+} cy_un_ipc_payload_t;
+#undef CY_IPC_X_PAYLOAD
+
+#define CY_IPC_MESSAGES_MAX_LENGTH      (sizeof(cy_un_ipc_payload_t))
+
+/* Publication of the LED topic, made by CM7_0 on every LED state change */
+typedef struct
+{
+    uint32_t led;               /* LED state, pktType of the LED message */
+} cy_stc_ipc_ledstate_t;
+
+/* Subscriber slots of the LED topic */
+typedef enum
+{
+    CY_IPC_TOPIC_LED_SUB_CM0,   /* CM0+, notified on EP3 */
+    CY_IPC_TOPIC_LED_SUB_CM7_1, /* CM7_1, notified on EP2 */
+} cy_en_ipc_topic_led_sub_t;
+
+/* Latest state of CM7_0, in its seqlock state region rather than in
+ * messages: a reader only needs the current value */
+typedef struct
+{
+    uint32_t led;               /* LED state sent last */
+    uint32_t ledUpdates;        /* LED states sent since start */
+    uint32_t remoteChecksum;    /* Last frame checksum reported by CM0+ */
+    uint32_t tickMs;            /* CM7_0 time of the update */
+} cy_stc_ipc_cm7_0state_t;
+
+/* Methods served by CM0+ */
+typedef enum
+{
+    CY_IPC_RPC_METHOD_GET_FRAME_COUNT,      /* Payloads received by descriptor */
+    CY_IPC_RPC_METHOD_GET_FRAME_CHECKSUM,   /* Byte sum of the last payload */
+} cy_en_ipc_rpc_method_t;
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* IPC_MESSAGES_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,336 @@
+/******************************************************************************
+* File Name:   ipc_msg.h
+*
+* Description: Versioned wire format of the IPC messages. Every message starts
+*              with a fixed header that the pipe driver can read, followed by
+*              the send timestamp and a typed payload that is decoded in
+*              place. CRC and sequence gap detection are optional and compile
+*              to nothing when disabled.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef IPC_MSG_H
+#define IPC_MSG_H
+
+#include "ipc_port.h"
+#include "ipc_stats.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+/* Senders fill in and receivers check the CRC of the payload. The header
+ * layout does not change, so cores may differ: a receiver built without it
+ * skips the check, a sender built without it does not set the flag. */
+#ifndef IPC_MSG_CRC_ENABLE
+#define IPC_MSG_CRC_ENABLE              (0)
+#endif
+
+/* Senders number the messages of a stream, receivers count the gaps */
+#ifndef IPC_MSG_SEQ_ENABLE
+#define IPC_MSG_SEQ_ENABLE              (0)
+#endif
+
+#define CY_IPC_MSG_VERSION              (1U)    /* Bumped on every incompatible header change */
+#define CY_IPC_MSG_MAX_LENGTH           (0xFFFFUL)
+
+/* Header flags */
+#define CY_IPC_MSG_FLAG_CRC             (0x01U) /* crc holds the CRC-16 of the payload */
+#define CY_IPC_MSG_FLAG_SEQ             (0x02U) /* sequence numbers a stream */
+
+/* The payload starts at the same offset in every message, so the CRC and the
+ * length can be checked without knowing the type. */
+#define CY_IPC_MSG_PAYLOAD_ALIGN        (8UL)
+#define CY_IPC_MSG_PAYLOAD_OFFSET       ((sizeof(cy_stc_ipc_msg_t) + CY_IPC_MSG_PAYLOAD_ALIGN - 1UL) & ~(CY_IPC_MSG_PAYLOAD_ALIGN - 1UL))
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef enum
+{
+    CY_IPC_MSG_SUCCESS,             /* Message is valid */
+    CY_IPC_MSG_GAP,                 /* Message is valid, messages before it were lost */
+    CY_IPC_MSG_ERROR_VERSION,       /* Unknown header version */
+    CY_IPC_MSG_ERROR_LENGTH,        /* Payload length out of range */
+    CY_IPC_MSG_ERROR_CRC,           /* Payload does not match its CRC */
+    CY_IPC_MSG_ERROR_STALE,         /* Sequence already seen: duplicate or reordered */
+} cy_en_ipc_msg_status_t;
+
+/* Fixed header. The first word is the one the pipe driver reads: clientID in
+ * bits [7:0] and the release mask in bits [31:16]. */
+typedef struct
+{
+    uint8_t  clientID;      /* Client ID */
+    uint8_t  pktType;       /* Message Type */
+    uint16_t intrRelMask;   /* Mask */
+    uint8_t  version;       /* CY_IPC_MSG_VERSION */
+    uint8_t  flags;         /* CY_IPC_MSG_FLAG_* */
+    uint16_t length;        /* Payload bytes */
+    uint16_t sequence;      /* Stream sequence, with CY_IPC_MSG_FLAG_SEQ */
+    uint16_t crc;           /* CRC-16/CCITT of the payload, with CY_IPC_MSG_FLAG_CRC */
+} cy_stc_ipc_msg_hdr_t;
+
+IPC_PORT_STATIC_ASSERT(sizeof(cy_stc_ipc_msg_hdr_t) == 12U, "Message header must stay three words");
+
+/* Message without a payload, and the common part of every message */
+typedef struct
+{
+    cy_stc_ipc_msg_hdr_t hdr;
+    IPC_STATS_STAMP_MEMBER          /* Send timestamp, empty unless IPC_STATS_ENABLE */
+} cy_stc_ipc_msg_t;
+
+/* Sender side of a numbered stream */
+typedef struct
+{
+    uint16_t next;                  /* Sequence of the next message */
+} cy_stc_ipc_msg_tx_t;
+
+/* Receiver side of a numbered stream */
+typedef struct
+{
+    bool synced;                    /* First message seen */
+    uint16_t expected;              /* Sequence of the next message */
+    uint32_t gaps;                  /* Gaps detected */
+    uint32_t lost;                  /* Messages missing in the gaps */
+    uint32_t stale;                 /* Duplicate or reordered messages */
+} cy_stc_ipc_msg_rx_t;
+
+
+/*******************************************************************************
+* Typed messages. CY_IPC_MSG_DEFINE(Name, type, members) declares the struct
+* type with the header, the stamp and the payload members, and two inline
+* accessors:
+*   Cy_IPC_Msg_Init##Name(msg, clientID, pktType, intrRelMask)
+*       fills in the header
+*   const type *Cy_IPC_Msg_Get##Name(const uint32_t *msgData)
+*       returns the message in place, or NULL if the header does not
+*       describe a Name message of this version
+* The receiver checks CRC and sequence once per message with
+* Cy_IPC_Msg_Check(), before the handler decodes it.
+*******************************************************************************/
+#define CY_IPC_MSG_DEFINE(Name, type, members)                                                      \
+typedef struct                                                                                      \
+{                                                                                                   \
+    cy_stc_ipc_msg_hdr_t hdr;                                                                       \
+    IPC_STATS_STAMP_MEMBER                                                                          \
+    CY_ALIGN(CY_IPC_MSG_PAYLOAD_ALIGN) struct { members } payload;                                  \
+} type;                                                                                             \
+IPC_PORT_STATIC_ASSERT(offsetof(type, payload) == CY_IPC_MSG_PAYLOAD_OFFSET, #type ": payload offset"); \
+IPC_PORT_STATIC_ASSERT(sizeof(((type *)0)->payload) <= CY_IPC_MSG_MAX_LENGTH, #type ": payload too long"); \
+static inline void Cy_IPC_Msg_Init##Name(type *msg, uint32_t clientID, uint32_t pktType, uint32_t intrRelMask) \
+{                                                                                                   \
+    Cy_IPC_Msg_InitHeader(&msg->hdr, clientID, pktType, intrRelMask, sizeof(msg->payload));        \
+}                                                                                                   \
+static inline const type *Cy_IPC_Msg_Get##Name(const uint32_t *msgData)                             \
+{                                                                                                   \
+    const cy_stc_ipc_msg_hdr_t *hdr = (const cy_stc_ipc_msg_hdr_t *)msgData;                        \
+    return ((CY_IPC_MSG_VERSION == hdr->version) &&                                                 \
+            (sizeof(((type *)0)->payload) == hdr->length)) ? (const type *)msgData : NULL;          \
+}
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void Cy_IPC_Msg_InitHeader(cy_stc_ipc_msg_hdr_t *hdr, uint32_t clientID, uint32_t pktType, uint32_t intrRelMask, uint32_t length);
+uint16_t Cy_IPC_Msg_Crc16(const void *data, uint32_t length);
+cy_en_ipc_msg_status_t Cy_IPC_Msg_CheckSequence(cy_stc_ipc_msg_rx_t *rx, uint32_t sequence);
+
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Msg_Payload
+********************************************************************************
+* Summary:
+* Returns the payload of a message, in place.
+*
+* Parameters:
+*  msg: Message.
+*
+* Return:
+*  First payload byte.
+*
+*******************************************************************************/
+static inline const uint8_t *Cy_IPC_Msg_Payload(const void *msg)
+{
+    return (const uint8_t *)msg + CY_IPC_MSG_PAYLOAD_OFFSET;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Msg_Size
+********************************************************************************
+* Summary:
+* Returns the bytes a message occupies, from its header up to the end of the
+* payload.
+*
+* Parameters:
+*  msg: Message, starting with cy_stc_ipc_msg_hdr_t.
+*
+* Return:
+*  Size in bytes.
+*
+*******************************************************************************/
+static inline uint32_t Cy_IPC_Msg_Size(const void *msg)
+{
+    const cy_stc_ipc_msg_hdr_t *hdr = (const cy_stc_ipc_msg_hdr_t *)msg;
+
+    return (0U == hdr->length) ? (uint32_t)sizeof(cy_stc_ipc_msg_t) : (uint32_t)(CY_IPC_MSG_PAYLOAD_OFFSET + hdr->length);
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Msg_Seal
+********************************************************************************
+* Summary:
+* Finishes a message before it is sent or queued: numbers it in its stream
+* and computes the CRC of the payload, each only when enabled. Call it after
+* the last payload write, and Cy_IPC_Msg_Sent() once the message was
+* accepted; a message that could not be sent keeps its number for the retry.
+* With both options disabled this does nothing.
+*
+* Parameters:
+*  msg: Message, starting with cy_stc_ipc_msg_hdr_t.
+*  tx: Stream the message belongs to. NULL: not numbered.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static inline void Cy_IPC_Msg_Seal(void *msg, cy_stc_ipc_msg_tx_t *tx)
+{
+#if IPC_MSG_SEQ_ENABLE || IPC_MSG_CRC_ENABLE
+    cy_stc_ipc_msg_hdr_t *hdr = (cy_stc_ipc_msg_hdr_t *)msg;
+#endif
+
+#if IPC_MSG_SEQ_ENABLE
+    if (NULL != tx)
+    {
+        hdr->sequence = tx->next;
+        hdr->flags |= CY_IPC_MSG_FLAG_SEQ;
+    }
+#else
+    (void)tx;
+#endif /* IPC_MSG_SEQ_ENABLE */
+
+#if IPC_MSG_CRC_ENABLE
+    hdr->crc = Cy_IPC_Msg_Crc16(Cy_IPC_Msg_Payload(msg), hdr->length);
+#else
+    (void)msg;
+#endif /* IPC_MSG_CRC_ENABLE */
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Msg_Sent
+********************************************************************************
+* Summary:
+* Advances a stream after its sealed message was sent or queued.
+*
+* Parameters:
+*  tx: Stream.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static inline void Cy_IPC_Msg_Sent(cy_stc_ipc_msg_tx_t *tx)
+{
+#if IPC_MSG_SEQ_ENABLE
+    tx->next++;
+#else
+    (void)tx;
+#endif /* IPC_MSG_SEQ_ENABLE */
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Msg_Check
+********************************************************************************
+* Summary:
+* Validates a received message in place: version, payload length and, when
+* enabled and set by the sender, CRC and sequence. Nothing is copied.
+*
+* Parameters:
+*  msg: Message, starting with cy_stc_ipc_msg_hdr_t.
+*  maxLength: Longest payload the receiver accepts; the CRC never reads
+*             beyond it.
+*  rx: Stream the message belongs to. NULL: the sequence is not checked.
+*
+* Return:
+*  CY_IPC_MSG_SUCCESS or CY_IPC_MSG_GAP if the message can be used
+*
+*******************************************************************************/
+static inline cy_en_ipc_msg_status_t Cy_IPC_Msg_Check(const void *msg, uint32_t maxLength, cy_stc_ipc_msg_rx_t *rx)
+{
+    const cy_stc_ipc_msg_hdr_t *hdr = (const cy_stc_ipc_msg_hdr_t *)msg;
+
+    if (CY_IPC_MSG_VERSION != hdr->version)
+    {
+        return CY_IPC_MSG_ERROR_VERSION;
+    }
+    if (hdr->length > maxLength)
+    {
+        return CY_IPC_MSG_ERROR_LENGTH;
+    }
+
+#if IPC_MSG_CRC_ENABLE
+    if ((0U != (hdr->flags & CY_IPC_MSG_FLAG_CRC)) &&
+        (hdr->crc != Cy_IPC_Msg_Crc16(Cy_IPC_Msg_Payload(msg), hdr->length)))
+    {
+        return CY_IPC_MSG_ERROR_CRC;
+    }
+#endif /* IPC_MSG_CRC_ENABLE */
+
+#if IPC_MSG_SEQ_ENABLE
+    if ((NULL != rx) && (0U != (hdr->flags & CY_IPC_MSG_FLAG_SEQ)))
+    {
+        return Cy_IPC_Msg_CheckSequence(rx, hdr->sequence);
+    }
+#else
+    (void)rx;
+#endif /* IPC_MSG_SEQ_ENABLE */
+
+    return CY_IPC_MSG_SUCCESS;
+}
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* IPC_MSG_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,142 @@
+/******************************************************************************
+* File Name:   ipc_pool.h
+*
+* Description: Fixed-block pool allocator for inter-core messages. Blocks are
+*              handed out from a lock-free free list in shared SRAM, so no
+*              heap allocation happens on the message path. One pool is
+*              created per message class.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef IPC_POOL_H
+#define IPC_POOL_H
+
+#include "ipc_port.h"
+#include "ipc_ring.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+#define CY_IPC_POOL_MAX_BLOCKS          (0xFFFFUL)  /* Block indices are 16-bit */
+
+/* Distance between blocks: the block size rounded up to whole cache lines, so
+ * cache maintenance on one block never touches its neighbours.
+ */
+#define CY_IPC_POOL_BLOCK_STRIDE(blockSize) \
+    (((blockSize) + IPC_PORT_CACHE_LINE - 1UL) & ~(IPC_PORT_CACHE_LINE - 1UL))
+
+/* Bytes of storage needed for a pool */
+#define CY_IPC_POOL_STORAGE_SIZE(blockSize, blockCount) \
+    (CY_IPC_POOL_BLOCK_STRIDE(blockSize) * (blockCount))
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef enum
+{
+    CY_IPC_POOL_SUCCESS,            /* Operation completed */
+    CY_IPC_POOL_ERROR_BAD_PARAM,    /* Invalid configuration or block pointer */
+    CY_IPC_POOL_ERROR_FULL,         /* Remote free ring is full */
+} cy_en_ipc_pool_status_t;
+
+typedef struct
+{
+    void     *storage;      /* CY_IPC_POOL_STORAGE_SIZE() bytes, cache line aligned, see cy_stc_ipc_pool_t */
+    uint32_t  blockSize;    /* Usable bytes per block, at least 4 */
+    uint32_t  blockCount;   /* Number of blocks, at most CY_IPC_POOL_MAX_BLOCKS */
+    uint32_t *remoteBuf;    /* Remote free ring storage, cache line aligned, NULL if not used */
+    uint32_t  remoteDepth;  /* Remote free ring depth, power of two >= blockCount */
+} cy_stc_ipc_pool_config_t;
+
+typedef struct
+{
+    uint32_t inUse;         /* Blocks currently allocated */
+    uint32_t highWater;     /* Largest inUse value seen */
+    uint32_t allocFail;     /* Allocations that found the pool empty */
+} cy_stc_ipc_pool_stats_t;
+
+/* Pool control block.
+ *
+ * Cy_IPC_Pool_Alloc() and Cy_IPC_Pool_Free() are lock-free between all cores
+ * with exclusive access instructions (IPC_PORT_HAS_EXCLUSIVE). The free list
+ * links live in the first word of each free block and are read and written
+ * without cache maintenance. When Alloc and Free are used from more than one
+ * CM7, place both the control block and the block storage in non-cacheable
+ * SRAM; a pool used by a single CM7 may stay cacheable. Either way the owner
+ * of a block cleans what it wrote before another core reads it, as with
+ * Cy_IPC_Handoff_SendMsg().
+ * A core without exclusive access (CM0+) returns blocks with
+ * Cy_IPC_Pool_FreeRemote() instead, which goes through a single-producer ring
+ * that the allocating core drains when the free list runs empty.
+ */
+typedef struct
+{
+    uint8_t  *storage;                  /* First block */
+    uint32_t  stride;                   /* Distance between blocks */
+    uint32_t  blockCount;               /* Number of blocks */
+    bool      hasRemote;                /* Remote free ring configured */
+    cy_stc_ipc_ring_t remote;           /* Blocks returned by the remote core */
+
+    CY_ALIGN(IPC_PORT_CACHE_LINE) cy_ipc_atomic32_t freeHead; /* Bits[31:16] ABA tag, Bits[15:0] first free block */
+    cy_ipc_atomic32_t inUse;            /* Blocks currently allocated */
+    cy_ipc_atomic32_t highWater;        /* Largest inUse value seen */
+    cy_ipc_atomic32_t allocFail;        /* Allocations that found the pool empty */
+} cy_stc_ipc_pool_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_en_ipc_pool_status_t Cy_IPC_Pool_Init(cy_stc_ipc_pool_t *pool, const cy_stc_ipc_pool_config_t *config);
+void *Cy_IPC_Pool_Alloc(cy_stc_ipc_pool_t *pool);
+cy_en_ipc_pool_status_t Cy_IPC_Pool_Free(cy_stc_ipc_pool_t *pool, void *block);
+cy_en_ipc_pool_status_t Cy_IPC_Pool_FreeRemote(cy_stc_ipc_pool_t *pool, void *block);
+uint32_t Cy_IPC_Pool_Reclaim(cy_stc_ipc_pool_t *pool);
+void Cy_IPC_Pool_GetStats(cy_stc_ipc_pool_t *pool, cy_stc_ipc_pool_stats_t *stats);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* IPC_POOL_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,330 @@
+/******************************************************************************
+* File Name:   ipc_port.h
+*
+* Description: Portability layer shared by the IPC transport modules. Maps
+*              atomics, memory barriers and data cache maintenance onto the
+*              PDL for the device build and onto the C11 runtime for the
+*              Linux host build.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef IPC_PORT_H
+#define IPC_PORT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+
+/* The host build is selected automatically when compiling for Linux/macOS */
+#if !defined(IPC_HOST_BUILD) && (defined(__linux__) || defined(__APPLE__))
+#define IPC_HOST_BUILD                  (1)
+#endif
+
+#if defined(IPC_HOST_BUILD)
+
+#ifndef CY_ALIGN
+#define CY_ALIGN(align)                 __attribute__((aligned(align)))
+#endif
+
+#define IPC_PORT_CACHE_LINE             (64UL)  /* Typical host L1 line size */
+
+#else
+
+#include "cy_pdl.h"
+
+#define IPC_PORT_CACHE_LINE             (32UL)  /* CM7 L1 D-cache line size */
+
+#endif /* IPC_HOST_BUILD */
+
+
+/* Compile-time check, C11 */
+#if defined(__cplusplus)
+#define IPC_PORT_STATIC_ASSERT(cond, msg)   static_assert((cond), msg)
+#else
+#define IPC_PORT_STATIC_ASSERT(cond, msg)   _Static_assert((cond), msg)
+#endif
+
+
+/*******************************************************************************
+* Atomics
+*******************************************************************************/
+/* 32-bit word shared between cores. Loads and stores of this type are single
+ * LDR/STR instructions on every core, including the CM0+.
+ */
+typedef _Atomic uint32_t cy_ipc_atomic32_t;
+
+#define IPC_PORT_LOAD_RELAXED(ptr)          atomic_load_explicit((ptr), memory_order_relaxed)
+#define IPC_PORT_LOAD_ACQUIRE(ptr)          atomic_load_explicit((ptr), memory_order_acquire)
+#define IPC_PORT_STORE_RELAXED(ptr, val)    atomic_store_explicit((ptr), (val), memory_order_relaxed)
+#define IPC_PORT_STORE_RELEASE(ptr, val)    atomic_store_explicit((ptr), (val), memory_order_release)
+
+/* Order plain data accesses against the atomics around them, for data that
+ * is copied in bulk and checked afterwards rather than read through atomics.
+ */
+#define IPC_PORT_FENCE_ACQUIRE()            atomic_thread_fence(memory_order_acquire)
+#define IPC_PORT_FENCE_RELEASE()            atomic_thread_fence(memory_order_release)
+
+/* Orders an earlier store against a later load, which acquire and release
+ * fences do not. Needed where each of two cores stores a word and then reads
+ * the one the other stores, such as an idle flag against a queue index.
+ */
+#define IPC_PORT_FENCE_FULL()               atomic_thread_fence(memory_order_seq_cst)
+
+/* Read-modify-write operations are lock-free across cores only where the core
+ * has exclusive access instructions (CM7, host). The CM0+ (ARMv6-M) emulates
+ * them by masking interrupts, which is atomic on that core only; structures
+ * updated with them must not be shared between the CM0+ and another core.
+ */
+#if defined(__ARM_ARCH_6M__)
+#define IPC_PORT_HAS_EXCLUSIVE          (0)
+#else
+#define IPC_PORT_HAS_EXCLUSIVE          (1)
+#endif
+
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Port_CompareExchange
+********************************************************************************
+* Summary:
+* Atomically replaces *ptr with desired if it equals *expected. On failure
+* *expected receives the current value. May fail spuriously; call it in a loop.
+*
+* Parameters:
+*  ptr: Word to update.
+*  expected: Expected current value, updated on failure.
+*  desired: New value.
+*
+* Return:
+*  true if the word was updated.
+*
+*******************************************************************************/
+static inline bool Cy_IPC_Port_CompareExchange(cy_ipc_atomic32_t *ptr, uint32_t *expected, uint32_t desired)
+{
+#if IPC_PORT_HAS_EXCLUSIVE
+    return atomic_compare_exchange_weak_explicit(ptr, expected, desired,
+                                                 memory_order_acq_rel, memory_order_acquire);
+#else
+    uint32_t interruptState = Cy_SysLib_EnterCriticalSection();
+    uint32_t current = IPC_PORT_LOAD_ACQUIRE(ptr);
+    bool swapped = (current == *expected);
+
+    if (swapped)
+    {
+        IPC_PORT_STORE_RELEASE(ptr, desired);
+    }
+    else
+    {
+        *expected = current;
+    }
+    Cy_SysLib_ExitCriticalSection(interruptState);
+
+    return swapped;
+#endif /* IPC_PORT_HAS_EXCLUSIVE */
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Port_FetchAdd
+********************************************************************************
+* Summary:
+* Atomically adds value to *ptr.
+*
+* Parameters:
+*  ptr: Word to update.
+*  value: Value to add, use (uint32_t)-1 to decrement.
+*
+* Return:
+*  The value of *ptr before the addition.
+*
+*******************************************************************************/
+static inline uint32_t Cy_IPC_Port_FetchAdd(cy_ipc_atomic32_t *ptr, uint32_t value)
+{
+#if IPC_PORT_HAS_EXCLUSIVE
+    return atomic_fetch_add_explicit(ptr, value, memory_order_acq_rel);
+#else
+    uint32_t previous = IPC_PORT_LOAD_RELAXED(ptr);
+
+    while (!Cy_IPC_Port_CompareExchange(ptr, &previous, previous + value))
+    {
+    }
+
+    return previous;
+#endif /* IPC_PORT_HAS_EXCLUSIVE */
+}
+
+
+/* Data cache maintenance. The CM7 cores maintain their D-cache through CMSIS,
+ * cores without one do nothing. A host harness that defines
+ * IPC_PORT_DCACHE_STUB receives every operation, widened to whole lines as
+ * the hardware sees it, so that the ranges can be checked on Linux. */
+#if defined(IPC_HOST_BUILD)
+#if defined(IPC_PORT_DCACHE_STUB)
+#define IPC_PORT_DCACHE_MAINTAIN        (1)
+#else
+#define IPC_PORT_DCACHE_MAINTAIN        (0)
+#endif
+#elif defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+#define IPC_PORT_DCACHE_MAINTAIN        (1)
+#else
+#define IPC_PORT_DCACHE_MAINTAIN        (0)
+#endif
+
+/* MPU region that Cy_IPC_Port_SetNonCacheable() programs, the highest
+ * number takes precedence over the regions set up by the startup code */
+#ifndef IPC_PORT_MPU_REGION
+#define IPC_PORT_MPU_REGION             (15UL)
+#endif
+
+#if defined(IPC_HOST_BUILD) && defined(IPC_PORT_DCACHE_STUB)
+void Cy_IPC_Port_StubCleanDCache(uintptr_t start, uint32_t size);
+void Cy_IPC_Port_StubInvalidateDCache(uintptr_t start, uint32_t size);
+void Cy_IPC_Port_StubSetNonCacheable(uintptr_t base, uint32_t size);
+#endif
+
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Port_CleanDCache
+********************************************************************************
+* Summary:
+* Writes back the D-cache lines covering [addr, addr + size) so that a core
+* without a data cache (CM0+) observes the data. No operation on cores without
+* a D-cache, and on the host unless the cache stub is built in.
+*
+* Parameters:
+*  addr: Start of the range.
+*  size: Size of the range in bytes.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static inline void Cy_IPC_Port_CleanDCache(const volatile void *addr, uint32_t size)
+{
+#if IPC_PORT_DCACHE_MAINTAIN
+    uintptr_t start = (uintptr_t)addr & ~(uintptr_t)(IPC_PORT_CACHE_LINE - 1UL);
+    uintptr_t end = ((uintptr_t)addr + size + IPC_PORT_CACHE_LINE - 1UL) & ~(uintptr_t)(IPC_PORT_CACHE_LINE - 1UL);
+
+#if defined(IPC_HOST_BUILD)
+    Cy_IPC_Port_StubCleanDCache(start, (uint32_t)(end - start));
+#else
+    SCB_CleanDCache_by_Addr((uint32_t *)start, (int32_t)(end - start));
+#endif /* IPC_HOST_BUILD */
+#else
+    (void)addr;
+    (void)size;
+#endif /* IPC_PORT_DCACHE_MAINTAIN */
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Port_InvalidateDCache
+********************************************************************************
+* Summary:
+* Discards the D-cache lines covering [addr, addr + size) so that the next read
+* fetches data written by another core. The caller must not own dirty data in
+* those lines. No operation on cores without a D-cache, and on the host unless
+* the cache stub is built in.
+*
+* Parameters:
+*  addr: Start of the range.
+*  size: Size of the range in bytes.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static inline void Cy_IPC_Port_InvalidateDCache(const volatile void *addr, uint32_t size)
+{
+#if IPC_PORT_DCACHE_MAINTAIN
+    uintptr_t start = (uintptr_t)addr & ~(uintptr_t)(IPC_PORT_CACHE_LINE - 1UL);
+    uintptr_t end = ((uintptr_t)addr + size + IPC_PORT_CACHE_LINE - 1UL) & ~(uintptr_t)(IPC_PORT_CACHE_LINE - 1UL);
+
+#if defined(IPC_HOST_BUILD)
+    Cy_IPC_Port_StubInvalidateDCache(start, (uint32_t)(end - start));
+#else
+    SCB_InvalidateDCache_by_Addr((uint32_t *)start, (int32_t)(end - start));
+#endif /* IPC_HOST_BUILD */
+#else
+    (void)addr;
+    (void)size;
+#endif /* IPC_PORT_DCACHE_MAINTAIN */
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Port_SetNonCacheable
+********************************************************************************
+* Summary:
+* Maps a region as normal non-cacheable memory on the calling core, with MPU
+* region IPC_PORT_MPU_REGION, after writing back and discarding the lines it
+* may hold. The MPU requires a power of two size of at least 32 bytes and a
+* base aligned to the size; the caller checks both. Every core that accesses
+* the region maps it. No operation on cores without a D-cache.
+*
+* Parameters:
+*  base: Start of the region.
+*  size: Size of the region in bytes.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static inline void Cy_IPC_Port_SetNonCacheable(const volatile void *base, uint32_t size)
+{
+#if IPC_PORT_DCACHE_MAINTAIN
+#if defined(IPC_HOST_BUILD)
+    Cy_IPC_Port_StubSetNonCacheable((uintptr_t)base, size);
+#elif defined(__MPU_PRESENT) && (__MPU_PRESENT == 1U)
+    /* RASR SIZE encodes a region of 2^(SIZE + 1) bytes */
+    uint32_t sizeField = 30UL - (uint32_t)__CLZ(size);
+
+    SCB_CleanInvalidateDCache_by_Addr((uint32_t *)(uintptr_t)base, (int32_t)size);
+    ARM_MPU_Disable();
+    ARM_MPU_SetRegionEx(IPC_PORT_MPU_REGION, (uint32_t)(uintptr_t)base,
+                        ARM_MPU_RASR(1UL, ARM_MPU_AP_FULL, 1UL, 1UL, 0UL, 0UL, 0UL, sizeField));
+    ARM_MPU_Enable(MPU_CTRL_PRIVDEFENA_Msk);
+#else
+    (void)base;
+    (void)size;
+#endif /* IPC_HOST_BUILD */
+#else
+    (void)base;
+    (void)size;
+#endif /* IPC_PORT_DCACHE_MAINTAIN */
+}
+
+#endif /* IPC_PORT_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,152 @@
+/******************************************************************************
+* File Name:   ipc_pubsub.h
+*
+* Description: Topic-based publish/subscribe between cores. The publisher
+*              writes a publication once into a slot of shared memory and
+*              notifies every subscriber through its own IPC interrupt;
+*              each subscriber reads the payload in place. A slot is reused
+*              once the last subscriber has released it.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef IPC_PUBSUB_H
+#define IPC_PUBSUB_H
+
+#include "ipc_port.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+#define CY_IPC_PUBSUB_MAX_SUBSCRIBERS   (4UL)   /* Subscriber slots of a topic */
+
+/* Distance between slots: the slot header and the payload rounded up to whole
+ * cache lines, so cache maintenance on one slot never touches its neighbours.
+ */
+#define CY_IPC_PUBSUB_SLOT_STRIDE(payloadSize) \
+    ((sizeof(cy_stc_ipc_pubsub_slot_t) + (payloadSize) + IPC_PORT_CACHE_LINE - 1UL) & ~(IPC_PORT_CACHE_LINE - 1UL))
+
+/* Bytes of storage needed for a topic */
+#define CY_IPC_PUBSUB_STORAGE_SIZE(payloadSize, depth) \
+    (CY_IPC_PUBSUB_SLOT_STRIDE(payloadSize) * (depth))
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef enum
+{
+    CY_IPC_PUBSUB_SUCCESS,          /* Operation completed */
+    CY_IPC_PUBSUB_ERROR_BAD_PARAM,  /* Invalid configuration, subscriber slot or length */
+    CY_IPC_PUBSUB_ERROR_NOT_CLAIMED, /* Publish without a claimed slot */
+} cy_en_ipc_pubsub_status_t;
+
+/* Header of a slot, the payload follows it */
+typedef struct
+{
+    uint32_t seq;           /* Publication number */
+    uint32_t length;        /* Payload bytes */
+} cy_stc_ipc_pubsub_slot_t;
+
+/* Subscriber line, written by that subscriber only */
+typedef struct
+{
+    CY_ALIGN(IPC_PORT_CACHE_LINE) cy_ipc_atomic32_t request; /* IPC interrupt mask to notify, 0: not subscribed */
+    cy_ipc_atomic32_t released;     /* Publications the subscriber is done with, in total */
+} cy_stc_ipc_pubsub_line_t;
+
+/* Topic control block, owned by the publisher. Place it and its storage in
+ * SRAM visible to every core. Each line is written by one core only, so the
+ * CM0+, which has no atomic read-modify-write across cores, can subscribe:
+ * the reference count of a publication is the number of active subscribers
+ * whose release count has not passed it, and is derived by the publisher
+ * when it needs the slot again rather than kept in a shared counter.
+ */
+typedef struct
+{
+    uint8_t  *storage;              /* First slot */
+    uint32_t  stride;               /* Distance between slots */
+    uint32_t  depth;                /* Slots, power of two */
+    uint32_t  payloadSize;          /* Largest payload */
+
+    CY_ALIGN(IPC_PORT_CACHE_LINE) cy_ipc_atomic32_t published; /* Publisher line: publications made */
+    cy_ipc_atomic32_t active;       /* Publisher line: bit n set, subscriber n receives */
+    uint32_t first[CY_IPC_PUBSUB_MAX_SUBSCRIBERS];  /* Publisher line: first publication of each subscriber */
+    uint32_t notify[CY_IPC_PUBSUB_MAX_SUBSCRIBERS]; /* Publisher line: IPC interrupt mask of each subscriber */
+    cy_ipc_atomic32_t stalls;       /* Publisher line: times the oldest slot was still referenced when claimed */
+    bool     stalled;               /* Publisher line: no slot since the last claim that found one */
+    bool     claimed;               /* Publisher line: the next slot was handed out by Cy_IPC_PubSub_Claim() */
+
+    cy_stc_ipc_pubsub_line_t subscriber[CY_IPC_PUBSUB_MAX_SUBSCRIBERS];
+} cy_stc_ipc_pubsub_topic_t;
+
+/* Subscriber state, local to the subscribing core. Calls made from thread
+ * and interrupt context must be serialized by the caller.
+ */
+typedef struct
+{
+    cy_stc_ipc_pubsub_topic_t *topic;   /* Topic subscribed to */
+    uint32_t index;                     /* Subscriber slot of the topic */
+    bool     active;                    /* The publisher has taken the subscription */
+    uint32_t next;                      /* Publication read next */
+    uint32_t received;                  /* Publications released */
+} cy_stc_ipc_pubsub_sub_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_en_ipc_pubsub_status_t Cy_IPC_PubSub_Init(cy_stc_ipc_pubsub_topic_t *topic, void *storage,
+                                             uint32_t payloadSize, uint32_t depth);
+void *Cy_IPC_PubSub_Claim(cy_stc_ipc_pubsub_topic_t *topic);
+cy_en_ipc_pubsub_status_t Cy_IPC_PubSub_Publish(cy_stc_ipc_pubsub_topic_t *topic, uint32_t length, uint32_t *notifyMask);
+uint32_t Cy_IPC_PubSub_GetRefs(cy_stc_ipc_pubsub_topic_t *topic, uint32_t seq);
+cy_en_ipc_pubsub_status_t Cy_IPC_PubSub_Subscribe(cy_stc_ipc_pubsub_sub_t *sub, cy_stc_ipc_pubsub_topic_t *topic,
+                                                  uint32_t index, uint32_t notifyMask);
+const void *Cy_IPC_PubSub_Receive(cy_stc_ipc_pubsub_sub_t *sub, uint32_t *length);
+void Cy_IPC_PubSub_Release(cy_stc_ipc_pubsub_sub_t *sub);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* IPC_PUBSUB_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,109 @@
+/******************************************************************************
+* File Name:   ipc_ring.h
+*
+* Description: Lock-free single-producer/single-consumer ring buffer used as
+*              the shared-memory transport behind an IPC pipe. The pipe
+*              interrupt only acts as a doorbell; the payload travels
+*              through the ring.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef IPC_RING_H
+#define IPC_RING_H
+
+#include "ipc_port.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+/* Bytes of element storage for a ring, rounded up to whole cache lines so the
+ * invalidate of the last slot never reaches data placed after the buffer
+ */
+#define CY_IPC_RING_STORAGE_SIZE(elemSize, depth) \
+    ((((elemSize) * (depth)) + IPC_PORT_CACHE_LINE - 1UL) & ~(IPC_PORT_CACHE_LINE - 1UL))
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef enum
+{
+    CY_IPC_RING_SUCCESS,            /* Operation completed */
+    CY_IPC_RING_ERROR_BAD_PARAM,    /* Unaligned buffer, invalid element size or depth */
+    CY_IPC_RING_ERROR_FULL,         /* No free slot, nothing was written */
+    CY_IPC_RING_ERROR_EMPTY,        /* No pending element, nothing was read */
+} cy_en_ipc_ring_status_t;
+
+/* Ring control block. Place it in SRAM visible to both cores; it must not be
+ * located in a TCM. The head and tail indices live in separate cache lines so
+ * that each line is written by one core only, which makes the range-based
+ * D-cache maintenance on the CM7 safe.
+ */
+typedef struct
+{
+    uint8_t  *buffer;                                   /* Element storage */
+    uint32_t  elemSize;                                 /* Size of one element in bytes */
+    uint32_t  mask;                                     /* Depth - 1, depth is a power of two */
+
+    CY_ALIGN(IPC_PORT_CACHE_LINE) cy_ipc_atomic32_t head; /* Producer line: next slot to write */
+    uint32_t  tailCache;                                /* Tail last observed by the producer */
+
+    CY_ALIGN(IPC_PORT_CACHE_LINE) cy_ipc_atomic32_t tail; /* Consumer line: next slot to read */
+    uint32_t  headCache;                                /* Head last observed by the consumer */
+} cy_stc_ipc_ring_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_en_ipc_ring_status_t Cy_IPC_Ring_Init(cy_stc_ipc_ring_t *ring, void *buffer, uint32_t elemSize, uint32_t depth);
+cy_en_ipc_ring_status_t Cy_IPC_Ring_Push(cy_stc_ipc_ring_t *ring, const void *elem);
+cy_en_ipc_ring_status_t Cy_IPC_Ring_Pop(cy_stc_ipc_ring_t *ring, void *elem);
+const void *Cy_IPC_Ring_Peek(cy_stc_ipc_ring_t *ring);
+uint32_t Cy_IPC_Ring_Count(cy_stc_ipc_ring_t *ring);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* IPC_RING_H */
+
+/* [] END OF FILE */
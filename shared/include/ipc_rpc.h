@@ -0,0 +1,143 @@
+/******************************************************************************
+* File Name:   ipc_rpc.h
+*
+* Description: Lightweight request/response RPC layer for the IPC pipe. The
+*              caller gets a request ID and completes either through a
+*              callback or by polling; many requests can be outstanding and
+*              responses may arrive in any order.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef IPC_RPC_H
+#define IPC_RPC_H
+
+#include "ipc_port.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+#ifndef CY_IPC_RPC_MAX_PENDING
+#define CY_IPC_RPC_MAX_PENDING          (8UL)   /* Outstanding requests, power of two */
+#endif
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef enum
+{
+    CY_IPC_RPC_SUCCESS,             /* Request completed */
+    CY_IPC_RPC_PENDING,             /* No response yet */
+    CY_IPC_RPC_ERROR_BAD_PARAM,     /* Invalid argument */
+    CY_IPC_RPC_ERROR_NO_SLOT,       /* CY_IPC_RPC_MAX_PENDING requests outstanding */
+    CY_IPC_RPC_ERROR_UNKNOWN_ID,    /* ID is not outstanding (completed, cancelled or stale) */
+    CY_IPC_RPC_ERROR_NO_METHOD,     /* Server has no such method */
+} cy_en_ipc_rpc_status_t;
+
+/* Request and response message. The first word follows the pipe message
+ * layout; code is the method in a request and the status in a response,
+ * value is the argument in a request and the result in a response.
+ */
+typedef struct
+{
+    uint8_t  clientID;      /* Client ID */
+    uint8_t  pktType;       /* Message Type */
+    uint16_t intrRelMask;   /* Mask */
+    uint16_t id;            /* Request ID */
+    uint16_t code;          /* Method or status */
+    uint32_t value;         /* Argument or result */
+} cy_stc_ipc_rpc_msg_t;
+
+/* Completion callback, called in the context that delivers the response */
+typedef void (*cy_ipc_rpc_callback_t)(uint32_t id, cy_en_ipc_rpc_status_t status, uint32_t result, void *context);
+
+typedef struct
+{
+    cy_ipc_atomic32_t state;        /* Slot state */
+    uint16_t id;                    /* ID of the request using the slot */
+    cy_ipc_rpc_callback_t callback; /* NULL: completion is polled */
+    void *context;                  /* Passed to the callback */
+    cy_en_ipc_rpc_status_t status;  /* Response status */
+    uint32_t result;                /* Response value */
+} cy_stc_ipc_rpc_slot_t;
+
+/* Caller side. Lives on the calling core. */
+typedef struct
+{
+    cy_stc_ipc_rpc_slot_t slot[CY_IPC_RPC_MAX_PENDING];
+    uint8_t  clientID;              /* Client ID written into requests */
+    uint8_t  pktType;               /* Packet type written into requests */
+    uint16_t intrRelMask;           /* Release mask written into requests */
+} cy_stc_ipc_rpc_client_t;
+
+/* Server method: returns the status, writes the result */
+typedef cy_en_ipc_rpc_status_t (*cy_ipc_rpc_method_t)(uint32_t arg, uint32_t *result);
+
+/* Server side. Lives on the serving core. */
+typedef struct
+{
+    const cy_ipc_rpc_method_t *methods; /* Indexed by method code */
+    uint32_t methodCount;               /* Entries in methods */
+    uint8_t  clientID;                  /* Client ID written into responses */
+    uint8_t  pktType;                   /* Packet type written into responses */
+    uint16_t intrRelMask;               /* Release mask written into responses */
+} cy_stc_ipc_rpc_server_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void Cy_IPC_Rpc_InitClient(cy_stc_ipc_rpc_client_t *client, uint32_t clientID, uint32_t pktType, uint32_t intrRelMask);
+cy_en_ipc_rpc_status_t Cy_IPC_Rpc_Prepare(cy_stc_ipc_rpc_client_t *client, uint32_t method, uint32_t arg,
+                                          cy_ipc_rpc_callback_t callback, void *context,
+                                          cy_stc_ipc_rpc_msg_t *request, uint32_t *id);
+cy_en_ipc_rpc_status_t Cy_IPC_Rpc_Complete(cy_stc_ipc_rpc_client_t *client, const cy_stc_ipc_rpc_msg_t *response);
+cy_en_ipc_rpc_status_t Cy_IPC_Rpc_Poll(cy_stc_ipc_rpc_client_t *client, uint32_t id, uint32_t *result);
+cy_en_ipc_rpc_status_t Cy_IPC_Rpc_Cancel(cy_stc_ipc_rpc_client_t *client, uint32_t id);
+void Cy_IPC_Rpc_Serve(const cy_stc_ipc_rpc_server_t *server, const cy_stc_ipc_rpc_msg_t *request, cy_stc_ipc_rpc_msg_t *response);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* IPC_RPC_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,124 @@
+/******************************************************************************
+* File Name:   ipc_sched.h
+*
+* Description: Event-driven job scheduler for a producer core. Jobs run
+*              periodically or on demand, back off while the pipe is busy
+*              and resume on its release; the core idles when no job is
+*              due. Time is passed in by the caller, so the scheduler runs
+*              the same against the SysTick and a simulated clock.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef IPC_SCHED_H
+#define IPC_SCHED_H
+
+#include "ipc_port.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+#ifndef CY_IPC_SCHED_MAX_JOBS
+#define CY_IPC_SCHED_MAX_JOBS           (8UL)   /* Job IDs 0 .. MAX_JOBS - 1, at most 32 */
+#endif
+
+#define CY_IPC_SCHED_ON_DEMAND          (0UL)   /* Period of a job that only runs when triggered */
+#define CY_IPC_SCHED_FOREVER            (UINT32_MAX) /* Idle time when no periodic job is armed */
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef enum
+{
+    CY_IPC_SCHED_SUCCESS,           /* Job registered */
+    CY_IPC_SCHED_ERROR_BAD_PARAM,   /* Invalid job ID or function */
+} cy_en_ipc_sched_status_t;
+
+/* Returned by a job */
+typedef enum
+{
+    CY_IPC_SCHED_DONE,              /* Work finished until the next period or trigger */
+    CY_IPC_SCHED_AGAIN,             /* More work, run again after the other jobs */
+    CY_IPC_SCHED_BLOCKED,           /* Pipe busy, run again after Cy_IPC_Sched_Unblock() */
+} cy_en_ipc_sched_result_t;
+
+typedef cy_en_ipc_sched_result_t (*cy_ipc_sched_job_t)(void *context);
+
+typedef struct
+{
+    cy_ipc_sched_job_t job;         /* NULL: slot unused */
+    void *context;                  /* Passed to the job */
+    uint32_t period;                /* Ticks between runs, CY_IPC_SCHED_ON_DEMAND for none */
+    uint32_t due;                   /* Tick of the next periodic run */
+} cy_stc_ipc_sched_job_t;
+
+/* The job table is owned by the thread that calls Cy_IPC_Sched_RunOnce();
+ * the masks are also updated from interrupts.
+ */
+typedef struct
+{
+    cy_stc_ipc_sched_job_t jobs[CY_IPC_SCHED_MAX_JOBS];
+    cy_ipc_atomic32_t pending;      /* Jobs to run */
+    cy_ipc_atomic32_t blocked;      /* Jobs waiting for Cy_IPC_Sched_Unblock() */
+    cy_ipc_atomic32_t releases;     /* Cy_IPC_Sched_Unblock() calls, detects a release during a job */
+    uint32_t runs;                  /* Jobs run */
+    uint32_t backoffs;              /* Jobs that returned CY_IPC_SCHED_BLOCKED */
+} cy_stc_ipc_sched_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void Cy_IPC_Sched_Init(cy_stc_ipc_sched_t *sched);
+cy_en_ipc_sched_status_t Cy_IPC_Sched_AddJob(cy_stc_ipc_sched_t *sched, uint32_t jobId, cy_ipc_sched_job_t job,
+                                             void *context, uint32_t period, uint32_t now);
+void Cy_IPC_Sched_Trigger(cy_stc_ipc_sched_t *sched, uint32_t jobId);
+void Cy_IPC_Sched_Unblock(cy_stc_ipc_sched_t *sched);
+bool Cy_IPC_Sched_RunOnce(cy_stc_ipc_sched_t *sched, uint32_t now);
+uint32_t Cy_IPC_Sched_IdleTime(cy_stc_ipc_sched_t *sched, uint32_t now);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* IPC_SCHED_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,101 @@
+/******************************************************************************
+* File Name:   ipc_seqlock.h
+*
+* Description: Seqlock-protected shared state between cores, for "latest
+*              value wins" data. A single writer updates a snapshot without
+*              blocking and without masking interrupts; readers copy it and
+*              retry when the copy was torn by a concurrent update. An
+*              optional doorbell notifies readers of every update.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef IPC_SEQLOCK_H
+#define IPC_SEQLOCK_H
+
+#include "ipc_port.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+#define CY_IPC_SEQLOCK_MAX_RETRIES      (8UL)   /* Read attempts of Cy_IPC_Seqlock_Read() */
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef enum
+{
+    CY_IPC_SEQLOCK_SUCCESS,         /* Consistent snapshot copied */
+    CY_IPC_SEQLOCK_BUSY,            /* The writer was updating, nothing copied */
+    CY_IPC_SEQLOCK_ERROR_BAD_PARAM, /* Invalid configuration */
+} cy_en_ipc_seqlock_status_t;
+
+/* Shared state region, owned by its writer. Place it and its data in SRAM
+ * visible to every core. Readers only read it, so any core can read,
+ * including the CM0+; there is a single writer.
+ */
+typedef struct
+{
+    CY_ALIGN(IPC_PORT_CACHE_LINE) cy_ipc_atomic32_t seq; /* Updates times two, odd while the writer updates */
+    uint32_t size;              /* Snapshot bytes */
+    uint32_t notifyMask;        /* Doorbell: IPC interrupt mask of the readers to notify, 0 for none */
+    void    *data;              /* Snapshot, cache line aligned */
+} cy_stc_ipc_seqlock_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_en_ipc_seqlock_status_t Cy_IPC_Seqlock_Init(cy_stc_ipc_seqlock_t *lock, void *data, uint32_t size, uint32_t notifyMask);
+void *Cy_IPC_Seqlock_BeginWrite(cy_stc_ipc_seqlock_t *lock);
+uint32_t Cy_IPC_Seqlock_EndWrite(cy_stc_ipc_seqlock_t *lock);
+uint32_t Cy_IPC_Seqlock_Write(cy_stc_ipc_seqlock_t *lock, const void *src);
+cy_en_ipc_seqlock_status_t Cy_IPC_Seqlock_TryRead(cy_stc_ipc_seqlock_t *lock, void *dst, uint32_t *seq);
+cy_en_ipc_seqlock_status_t Cy_IPC_Seqlock_Read(cy_stc_ipc_seqlock_t *lock, void *dst, uint32_t *seq);
+bool Cy_IPC_Seqlock_Changed(cy_stc_ipc_seqlock_t *lock, uint32_t seq);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* IPC_SEQLOCK_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,98 @@
+/******************************************************************************
+* File Name:   ipc_shbuf.h
+*
+* Description: Shared buffer pool for zero-copy transfers. The sender places
+*              a payload in a region both cores can see and passes only its
+*              offset and length in a descriptor message; the receiver works
+*              on the data in place.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef IPC_SHBUF_H
+#define IPC_SHBUF_H
+
+#include "ipc_port.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+#define CY_IPC_SHBUF_MAX_SLOTS          (32UL)  /* Slots tracked by the free mask */
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef enum
+{
+    CY_IPC_SHBUF_SUCCESS,           /* Operation completed */
+    CY_IPC_SHBUF_ERROR_BAD_PARAM,   /* Invalid region, slot size, offset or length */
+    CY_IPC_SHBUF_ERROR_NO_MEMORY,   /* No contiguous free run large enough */
+} cy_en_ipc_shbuf_status_t;
+
+/* Pool control block. The pool is owned by the sending core: only that core
+ * allocates and frees, the receiving core only resolves descriptors. Calls
+ * made from thread and interrupt context must be serialized by the caller.
+ */
+typedef struct
+{
+    uint8_t  *base;         /* Start of the shared region, cache line aligned */
+    uint32_t  slotSize;     /* Allocation granule, multiple of the cache line */
+    uint32_t  slotCount;    /* Number of slots */
+    uint32_t  freeMask;     /* Bit n set: slot n is free */
+} cy_stc_ipc_shbuf_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_en_ipc_shbuf_status_t Cy_IPC_ShBuf_Init(cy_stc_ipc_shbuf_t *pool, void *base, uint32_t size, uint32_t slotSize);
+cy_en_ipc_shbuf_status_t Cy_IPC_ShBuf_Alloc(cy_stc_ipc_shbuf_t *pool, uint32_t length, uint32_t *offset);
+void Cy_IPC_ShBuf_Free(cy_stc_ipc_shbuf_t *pool, uint32_t offset, uint32_t length);
+void Cy_IPC_ShBuf_Publish(const cy_stc_ipc_shbuf_t *pool, uint32_t offset, uint32_t length);
+void *Cy_IPC_ShBuf_Access(const cy_stc_ipc_shbuf_t *pool, uint32_t offset, uint32_t length);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* IPC_SHBUF_H */
+
+/* [] END OF FILE */
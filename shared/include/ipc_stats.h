@@ -0,0 +1,182 @@
+/******************************************************************************
+* File Name:   ipc_stats.h
+*
+* Description: Optional end-to-end latency instrumentation for IPC messages.
+*              Messages carry a send timestamp, and each stage of the path is
+*              recorded in a histogram in a shared stats block. With
+*              IPC_STATS_ENABLE set to 0 all hooks compile to nothing.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef IPC_STATS_H
+#define IPC_STATS_H
+
+#include "ipc_port.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+/* Changes the message layout, so every core must be built with the same value */
+#ifndef IPC_STATS_ENABLE
+#define IPC_STATS_ENABLE                (0)
+#endif
+
+/* Log-linear histogram: CY_IPC_STATS_SUB_BUCKETS buckets per power of two,
+ * so a percentile is reported within 25% of the true value.
+ */
+#define CY_IPC_STATS_SUB_BITS           (2UL)
+#define CY_IPC_STATS_SUB_BUCKETS        (1UL << CY_IPC_STATS_SUB_BITS)
+#define CY_IPC_STATS_BUCKETS            ((32UL - CY_IPC_STATS_SUB_BITS + 1UL) * CY_IPC_STATS_SUB_BUCKETS)
+
+/* Timestamp source: a free-running 32-bit counter that every core reads at
+ * the same rate. On the target this is the TCPWM counter below, started by
+ * CM0+ with Cy_IPC_Stats_StartClock() before the CM7 cores run; its clock
+ * divider is assigned in the BSP. Define IPC_STATS_CLOCK() to use another
+ * source.
+ */
+#ifndef IPC_STATS_CLOCK
+#define IPC_STATS_CLOCK()               Cy_IPC_Stats_Clock()
+#endif
+
+#if !defined(IPC_HOST_BUILD)
+#ifndef IPC_STATS_TCPWM
+#define IPC_STATS_TCPWM                 (TCPWM0)
+#endif
+#ifndef IPC_STATS_TCPWM_NUM
+#define IPC_STATS_TCPWM_NUM             (0UL)   /* 32-bit counter of group 0 */
+#endif
+#endif /* !IPC_HOST_BUILD */
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+/* Stages of a message, all measured from the send timestamp unless noted.
+ * Acquiring the channel lock is part of Cy_IPC_Pipe_SendMessage() and is
+ * included in SEND.
+ */
+typedef enum
+{
+    CY_IPC_STATS_STAGE_SEND,        /* Sender: duration of the send call */
+    CY_IPC_STATS_STAGE_NOTIFY,      /* Send to receiver ISR entry, includes ring queueing */
+    CY_IPC_STATS_STAGE_ISR,         /* Receiver: ISR entry to handler entry */
+    CY_IPC_STATS_STAGE_CALLBACK,    /* Receiver: handler duration */
+    CY_IPC_STATS_STAGE_RELEASE,     /* Send to release callback on the sender */
+    CY_IPC_STATS_STAGE_COUNT,
+} cy_en_ipc_stats_stage_t;
+
+/* Histogram of one stage. Each stage has a single writer and a line of its
+ * own, so the writers never share a cache line.
+ */
+typedef struct
+{
+    CY_ALIGN(IPC_PORT_CACHE_LINE) uint32_t count;   /* Samples recorded */
+    uint32_t min;                                   /* Smallest sample */
+    uint32_t max;                                   /* Largest sample */
+    uint32_t bucket[CY_IPC_STATS_BUCKETS];          /* Samples per bucket */
+} cy_stc_ipc_stats_hist_t;
+
+/* Stats block of one sending core. Receivers find it through the stamp. */
+typedef struct
+{
+    cy_stc_ipc_stats_hist_t stage[CY_IPC_STATS_STAGE_COUNT];
+} cy_stc_ipc_stats_t;
+
+/* Carried by every message right after the header, see cy_stc_ipc_msg_t */
+typedef struct
+{
+    cy_stc_ipc_stats_t *stats;      /* Stats block of the sender */
+    uint32_t sent;                  /* IPC_STATS_CLOCK() at send */
+} cy_stc_ipc_stats_stamp_t;
+
+/* Summary of one stage, in IPC_STATS_CLOCK() ticks */
+typedef struct
+{
+    uint32_t count;
+    uint32_t min;
+    uint32_t p50;
+    uint32_t p99;
+    uint32_t max;
+} cy_stc_ipc_stats_summary_t;
+
+
+/*******************************************************************************
+* Hooks. Use these in the message path; they expand to nothing when
+* IPC_STATS_ENABLE is 0.
+*******************************************************************************/
+#if IPC_STATS_ENABLE
+
+/* Member placed after the header of every message, see ipc_msg.h */
+#define IPC_STATS_STAMP_MEMBER              cy_stc_ipc_stats_stamp_t stamp;
+/* Declares a timestamp variable */
+#define IPC_STATS_TIME(var)                 uint32_t var = IPC_STATS_CLOCK()
+/* Stamps a message with the sender's stats block and the current time */
+#define IPC_STATS_STAMP(msg, block)         do { (msg)->stamp.stats = (block); (msg)->stamp.sent = IPC_STATS_CLOCK(); } while (0)
+/* Records the time elapsed since start */
+#define IPC_STATS_RECORD(block, stage, start) Cy_IPC_Stats_Record((block), (stage), IPC_STATS_CLOCK() - (start))
+
+#else
+
+#define IPC_STATS_STAMP_MEMBER
+#define IPC_STATS_TIME(var)
+#define IPC_STATS_STAMP(msg, block)         do { } while (0)
+#define IPC_STATS_RECORD(block, stage, start) do { } while (0)
+
+#endif /* IPC_STATS_ENABLE */
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void Cy_IPC_Stats_Init(cy_stc_ipc_stats_t *stats);
+void Cy_IPC_Stats_Record(cy_stc_ipc_stats_t *stats, cy_en_ipc_stats_stage_t stage, uint32_t ticks);
+void Cy_IPC_Stats_Received(const uint32_t *msgData, uint32_t isrEntry, uint32_t now);
+void Cy_IPC_Stats_GetSummary(const cy_stc_ipc_stats_t *stats, cy_en_ipc_stats_stage_t stage, cy_stc_ipc_stats_summary_t *summary);
+uint32_t Cy_IPC_Stats_Clock(void);
+void Cy_IPC_Stats_StartClock(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* IPC_STATS_H */
+
+/* [] END OF FILE */
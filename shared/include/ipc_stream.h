@@ -0,0 +1,135 @@
+/******************************************************************************
+* File Name:   ipc_stream.h
+*
+* Description: Streaming channel for continuous sample data between two
+*              cores. The producer fills one of N block buffers (two for
+*              ping-pong) while the consumer processes the others; every
+*              committed block is announced by a doorbell on the pipe
+*              interrupt. Blocks the consumer has no room for are dropped
+*              and counted as overruns, blocks missing when the consumer
+*              needs one as underruns. Host-only for now: no core image
+*              streams yet, host/bench/bench_stream.c drives it.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef IPC_STREAM_H
+#define IPC_STREAM_H
+
+#include "ipc_port.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+#define CY_IPC_STREAM_MAX_BUFFERS       (8UL)   /* Block buffers of a stream */
+
+/* Block size that carries bytesPerSecond with one block every periodUs,
+ * rounded up to whole cache lines */
+#define CY_IPC_STREAM_BLOCK_SIZE(bytesPerSecond, periodUs) \
+    ((uint32_t)((((uint64_t)(bytesPerSecond) * (periodUs)) / 1000000ULL) + IPC_PORT_CACHE_LINE - 1UL) & ~(IPC_PORT_CACHE_LINE - 1UL))
+
+/* Bytes of buffer storage needed for a stream */
+#define CY_IPC_STREAM_STORAGE_SIZE(blockSize, count)    ((blockSize) * (count))
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef enum
+{
+    CY_IPC_STREAM_SUCCESS,          /* Operation completed */
+    CY_IPC_STREAM_OVERRUN,          /* No free buffer, the block was dropped */
+    CY_IPC_STREAM_ERROR_BAD_PARAM,  /* Invalid configuration or block length */
+} cy_en_ipc_stream_status_t;
+
+/* Descriptor of a committed block */
+typedef struct
+{
+    uint32_t seq;           /* Block number, dropped blocks included */
+    uint32_t length;        /* Bytes written by the producer */
+} cy_stc_ipc_stream_block_t;
+
+/* Stream control block, owned by the producer. Place it and its buffers in
+ * SRAM visible to both cores. The producer line is written by the producer
+ * only and the consumer line by the consumer only, so the CM0+ can be
+ * either side. Buffer n holds block n modulo the buffer count: the producer
+ * writes the buffer after the committed ones and may commit while at least
+ * one buffer stays free for it, so with two buffers the consumer has one
+ * block period to release a block.
+ */
+typedef struct
+{
+    uint8_t  *buffers;              /* First buffer */
+    uint32_t  blockSize;            /* Bytes per buffer, whole cache lines */
+    uint32_t  mask;                 /* Buffers - 1, buffers are a power of two */
+    uint32_t  bytesPerSecond;       /* Sustained rate the stream is specified for */
+    uint32_t  notifyMask;           /* Doorbell: IPC interrupt mask of the consumer, 0 for none */
+
+    CY_ALIGN(IPC_PORT_CACHE_LINE) cy_ipc_atomic32_t filled; /* Producer line: blocks committed */
+    uint32_t  seq;                  /* Producer line: number of the block being filled */
+    uint32_t  overruns;             /* Producer line: blocks dropped without a free buffer */
+    cy_stc_ipc_stream_block_t block[CY_IPC_STREAM_MAX_BUFFERS]; /* Producer line: committed blocks by buffer */
+
+    CY_ALIGN(IPC_PORT_CACHE_LINE) cy_ipc_atomic32_t consumed; /* Consumer line: blocks released */
+    uint32_t  underruns;            /* Consumer line: acquires that found no block */
+    uint32_t  next;                 /* Consumer line: block number expected next */
+    uint32_t  lost;                 /* Consumer line: blocks missing between the released ones */
+} cy_stc_ipc_stream_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_en_ipc_stream_status_t Cy_IPC_Stream_Init(cy_stc_ipc_stream_t *stream, void *buffers, uint32_t blockSize,
+                                             uint32_t count, uint32_t bytesPerSecond, uint32_t notifyMask);
+uint32_t Cy_IPC_Stream_PeriodUs(cy_stc_ipc_stream_t const *stream);
+void *Cy_IPC_Stream_Fill(cy_stc_ipc_stream_t *stream);
+cy_en_ipc_stream_status_t Cy_IPC_Stream_Commit(cy_stc_ipc_stream_t *stream, uint32_t length, uint32_t *notifyMask);
+uint32_t Cy_IPC_Stream_Pending(cy_stc_ipc_stream_t *stream);
+const void *Cy_IPC_Stream_Acquire(cy_stc_ipc_stream_t *stream, uint32_t *length, uint32_t *seq);
+void Cy_IPC_Stream_Release(cy_stc_ipc_stream_t *stream);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* IPC_STREAM_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,316 @@
+/******************************************************************************
+* File Name:   ipc_topology.h
+*
+* Description: IPC pipe topology shared by all cores. Every endpoint, its
+*              channel, interrupt and mux, and the client IDs served on it
+*              are described once here, so the cores cannot disagree.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef IPC_TOPOLOGY_H
+#define IPC_TOPOLOGY_H
+
+#include "ipc_port.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/****************************************************************************
+* Endpoints
+*   EP0: CM0+  receives from CM7_0 (Pipe0)
+*   EP1: CM7_0 takes the releases of Pipe0
+*   EP2: CM7_1 takes the releases of Pipe1, the LED topic notifications and
+*        the doorbell of CM0+'s answer to its topic request
+*   EP3: CM0+  receives control messages from CM7_0 (Pipe2), the LED
+*        topic notifications and the CM7_0 state doorbell
+*   EP4: CM7_0 takes the releases of Pipe2 and the doorbell of the RPC
+*        responses
+*   EP5: CM0+  receives from CM7_1 (Pipe1)
+*
+* Pipe0 and Pipe1 are the bulk lane. Each producer has its own CM0+
+* endpoint, so CM7_0 and CM7_1 never wait for each other's channel; EP0 and
+* EP5 share a priority and CM0+ serves them round-robin. Pipe2 is the
+* control lane: its own channel, and interrupts of a higher priority (lower
+* number), so a control message preempts a bulk drain running in the EP0,
+* EP1 or EP5 interrupt.
+*
+* The device leaves fewer IPC channels to the application than there are
+* endpoints. Only the CM0+ endpoints receive pipe messages, each on a
+* channel of its own. The CM7 endpoints have no clients: CM0+ only rings
+* them with a bare notify, and each shares the channel of the CM0+ endpoint
+* it sends to. Every endpoint keeps its own interrupt, as the pipe driver
+* clears all events of an interrupt in one go. A notify on a CM7 endpoint
+* must not reach Cy_IPC_Pipe_ExecuteCallback(), which would take the core's
+* own message out of the shared channel; its ISR takes the notify events
+* with Cy_IPC_Cypipe_TakeNotify() first.
+*
+* Every endpoint is one line of CY_IPC_CYPIPE_ENDPOINTS. The constants of
+* each endpoint, the interrupt mask and the initializers below are generated
+* from it, and the static asserts at the end of this file check the table.
+*   X(arg, ep, name, core, chan, intr, priority, mux, clients)
+*     ep:       Endpoint number, index of the endpoint array, 0 ..
+*               CY_IPC_MAX_ENDPOINTS - 1
+*     name:     Generates CY_IPC_EP_CYPIPE_<name>_ADDR
+*     core:     Core that receives on the endpoint, cy_en_ipc_core_t
+*     chan:     IPC channel, offset from CY_IPC_CHAN_USER
+*     intr:     IPC interrupt, offset from CY_IPC_INTR_USER
+*     priority: Notifier priority, 0 is the highest
+*     mux:      CPU interrupt (NVIC mux) of the receiving core
+*     clients:  Size of the client callback array, 0 for an endpoint that
+*               shares its channel
+*****************************************************************************/
+#define CY_IPC_CYPIPE_ENDPOINTS(X, arg)                                                        \
+    X(arg, 0, CM0,       CY_IPC_CORE_CM0P,  0UL, 0UL, 1UL, NvicMux3_IRQn, 16UL) /* Every client goes through the CM0+ dispatch table */ \
+    X(arg, 1, CM7_0,     CY_IPC_CORE_CM7_0, 0UL, 1UL, 1UL, NvicMux4_IRQn, 0UL)  /* Channel of EP0 */          \
+    X(arg, 2, CM7_1,     CY_IPC_CORE_CM7_1, 1UL, 2UL, 1UL, NvicMux5_IRQn, 0UL)  /* Channel of EP5 */          \
+    X(arg, 3, CM0_CTL,   CY_IPC_CORE_CM0P,  2UL, 3UL, 0UL, NvicMux2_IRQn, 3UL)  /* Preempts EP0 */            \
+    X(arg, 4, CM7_0_CTL, CY_IPC_CORE_CM7_0, 2UL, 4UL, 0UL, NvicMux6_IRQn, 0UL)  /* Channel of EP3, preempts EP1 */ \
+    X(arg, 5, CM0_CM7_1, CY_IPC_CORE_CM0P,  1UL, 5UL, 1UL, NvicMux1_IRQn, 7UL)  /* Same dispatch table as EP0 */
+
+/* Cores that own endpoints */
+#define CY_IPC_CYPIPE_CORES(X, arg)                                     \
+    X(arg, CY_IPC_CORE_CM0P)                                            \
+    X(arg, CY_IPC_CORE_CM7_0)                                           \
+    X(arg, CY_IPC_CORE_CM7_1)
+
+
+/****************************************************************************
+* Clients. Client IDs index the callback array of the receiving endpoint;
+* a static assert checks that no ID is used twice on an endpoint and that it
+* fits its callback array. EP0 and EP5 route through one CM0+ dispatch table
+* by client ID, so the IDs of Pipe0 and Pipe1 must not overlap either. The
+* CM7 endpoints have no clients.
+*   X(arg, name, ep, id)
+*****************************************************************************/
+#define CY_IPC_CYPIPE_CLIENTS(X, arg)                                                          \
+    X(arg, CY_CLIENT_CYPIPE0_CM0_ID0,   0, 0UL) /* EP0 Pipe0 (CM0 <--> CM7_0) LED client */              \
+    X(arg, CY_CLIENT_CYPIPE0_CM0_ID1,   0, 1UL) /* EP0 Pipe0 (CM0 <--> CM7_0) Ring doorbell client */    \
+    X(arg, CY_CLIENT_CYPIPE0_CM0_ID2,   0, 2UL) /* EP0 Pipe0 (CM0 <--> CM7_0) Buffer descriptor client */ \
+    X(arg, CY_CLIENT_CYPIPE1_CM0_ID4,   5, 4UL) /* EP5 Pipe1 (CM0 <--> CM7_1) Ring doorbell client */    \
+    X(arg, CY_CLIENT_CYPIPE1_CM0_ID5,   5, 5UL) /* EP5 Pipe1 (CM0 <--> CM7_1) Load message client */     \
+    X(arg, CY_CLIENT_CYPIPE1_CM0_ID6,   5, 6UL) /* EP5 Pipe1 (CM0 <--> CM7_1) Topic request client */    \
+    X(arg, CY_CLIENT_CYPIPE2_CM0_ID0,   3, 0UL) /* EP3 Pipe2 (CM0 <--> CM7_0) RPC request client */      \
+    X(arg, CY_CLIENT_CYPIPE2_CM0_ID1,   3, 1UL) /* EP3 Pipe2 (CM0 <--> CM7_0) Topic client */           \
+    X(arg, CY_CLIENT_CYPIPE2_CM0_ID2,   3, 2UL) /* EP3 Pipe2 (CM0 <--> CM7_0) State region client */
+
+
+/****************************************************************************
+* Generated constants. For every endpoint n:
+*   CY_IPC_CHAN_CYPIPE_EPn       IPC data channel
+*   CY_IPC_CYPIPE_CHAN_MASK_EPn  Mask of the channel
+*   CY_IPC_INTR_CYPIPE_EPn       IPC interrupt
+*   CY_IPC_CYPIPE_INTR_MASK_EPn  Mask of the interrupt, the release mask of a
+*                                message sent from the endpoint
+*   CY_IPC_INTR_CYPIPE_PRIOR_EPn Notifier priority
+*   CY_IPC_INTR_CYPIPE_MUX_EPn   CPU interrupt, as an integer; use
+*                                CY_IPC_CYPIPE_MUX(n) for the IRQn_Type
+*   CY_IPC_CYPIPE_CLIENT_CNT_EPn Size of the client callback array
+*   CY_IPC_EP_CYPIPE_<name>_ADDR Index of the endpoint array
+*****************************************************************************/
+typedef enum
+{
+#define CY_IPC_X_CORE(arg, core)    core,
+    CY_IPC_CYPIPE_CORES(CY_IPC_X_CORE, ~)
+#undef CY_IPC_X_CORE
+} cy_en_ipc_core_t;
+
+#define CY_IPC_X_ENDPOINT(arg, ep, name, core, chan, intr, priority, mux, clients)            \
+    CY_IPC_CHAN_CYPIPE_EP##ep = CY_IPC_CHAN_USER + (chan),                                     \
+    CY_IPC_CYPIPE_CHAN_MASK_EP##ep = 0x0001UL << (CY_IPC_CHAN_USER + (chan)),                  \
+    CY_IPC_INTR_CYPIPE_EP##ep = CY_IPC_INTR_USER + (intr),                                     \
+    CY_IPC_CYPIPE_INTR_MASK_EP##ep = 0x0001UL << (CY_IPC_INTR_USER + (intr)),                  \
+    CY_IPC_INTR_CYPIPE_PRIOR_EP##ep = (priority),                                              \
+    CY_IPC_INTR_CYPIPE_MUX_EP##ep = (int32_t)(mux),                                            \
+    CY_IPC_CYPIPE_CLIENT_CNT_EP##ep = (clients),                                               \
+    CY_IPC_EP_CYPIPE_##name##_ADDR = (ep),
+#define CY_IPC_X_CLIENT(arg, name, ep, id)  name = (id),
+enum
+{
+    CY_IPC_CYPIPE_ENDPOINTS(CY_IPC_X_ENDPOINT, ~)
+    CY_IPC_CYPIPE_CLIENTS(CY_IPC_X_CLIENT, ~)
+};
+#undef CY_IPC_X_ENDPOINT
+#undef CY_IPC_X_CLIENT
+
+#define CY_IPC_X_COUNT(arg, ...)                + 1UL
+#define CY_IPC_X_CHAN_MASK(arg, ep, ...)        | CY_IPC_CYPIPE_CHAN_MASK_EP##ep
+
+#define CY_IPC_MAX_ENDPOINTS            (0UL CY_IPC_CYPIPE_ENDPOINTS(CY_IPC_X_COUNT, ~)) /* Endpoints of the table */
+#define CY_IPC_CYPIPE_MUX(ep)           ((IRQn_Type)CY_IPC_INTR_CYPIPE_MUX_EP##ep) /* CPU interrupt of endpoint ep */
+
+
+/****************************************************************************
+* The pipe configuration defines the IPC channel number, interrupt
+* number, and the pipe interrupt mask for the endpoint.
+*
+* The format of the endPoint configuration
+*   Bits[31:16] Interrupt Mask
+*   Bits[15:8 ] IPC interrupt
+*   Bits[ 7:0 ] IPC channel
+*
+* Every endpoint accepts notify and release events from every channel of
+* the topology. All cores must use the same mask: each core rewrites the
+* mask of the remote endpoint it sends to.
+*****************************************************************************/
+#define CY_IPC_CYPIPE_INTR_MASK         (0UL CY_IPC_CYPIPE_ENDPOINTS(CY_IPC_X_CHAN_MASK, ~))
+
+#define CY_IPC_CYPIPE_CONFIG(ep)  ( (CY_IPC_CYPIPE_INTR_MASK << CY_IPC_PIPE_CFG_IMASK_Pos) \
+                                   | ((uint32_t)CY_IPC_INTR_CYPIPE_EP##ep << CY_IPC_PIPE_CFG_INTR_Pos) \
+                                    | (uint32_t)CY_IPC_CHAN_CYPIPE_EP##ep)
+
+/* Initializer for cy_stc_ipc_pipe_ep_config_t of endpoint ep */
+#define CY_IPC_CYPIPE_EP_CONFIG(ep)                                     \
+{                                                                       \
+    CY_IPC_INTR_CYPIPE_EP##ep,        /* .ipcNotifierNumber    */       \
+    CY_IPC_INTR_CYPIPE_PRIOR_EP##ep,  /* .ipcNotifierPriority  */       \
+    CY_IPC_CYPIPE_MUX(ep),            /* .ipcNotifierMuxNumber */       \
+    ep##UL,                           /* .epAddress            */       \
+    CY_IPC_CYPIPE_CONFIG(ep)          /* .epConfig             */       \
+}
+
+/* Initializer for cy_stc_ipc_pipe_config_t of the pipe that receives on
+ * endpoint rx and sends to endpoint tx, on the core that owns rx */
+#define CY_IPC_CYPIPE_PIPE_CONFIG(rx, tx, cbArray, isr)                 \
+{                                                                       \
+    /* receiver endpoint */                                             \
+    CY_IPC_CYPIPE_EP_CONFIG(rx),                                        \
+    /* sender endpoint */                                               \
+    CY_IPC_CYPIPE_EP_CONFIG(tx),                                        \
+                                                                        \
+    CY_IPC_CYPIPE_CLIENT_CNT_EP##rx,  /* .endpointClientsCount     */   \
+    (cbArray),                        /* .endpointsCallbacksArray  */   \
+    (isr)                             /* .userPipeIsrHandler       */   \
+}
+
+
+/****************************************************************************
+* Topology checks. A set of bits has no duplicates if OR and sum agree. The
+* channels and interrupts must exist on the device (CY_IPC_CHANNELS and
+* CY_IPC_INTERRUPTS of the PDL) and fit the 16-bit masks of the pipe
+* configuration. Interrupts are never shared; a channel only by endpoints
+* without clients.
+*****************************************************************************/
+#define CY_IPC_X_CHAN_OR(arg, ep, name, core, chan, intr, priority, mux, clients)   | ((0UL != (clients)) ? (1UL << (chan)) : 0UL)
+#define CY_IPC_X_CHAN_SUM(arg, ep, name, core, chan, intr, priority, mux, clients)  + ((0UL != (clients)) ? (1UL << (chan)) : 0UL)
+#define CY_IPC_X_INTR_OR(arg, ep, name, core, chan, intr, ...)      | (1UL << (intr))
+#define CY_IPC_X_INTR_SUM(arg, ep, name, core, chan, intr, ...)     + (1UL << (intr))
+#define CY_IPC_X_EP_OR(arg, ep, ...)                                | (1UL << (ep))
+#define CY_IPC_X_MUX_OR(c, ep, name, core, chan, intr, priority, mux, ...)  | (((core) == (c)) ? (1UL << (uint32_t)(mux)) : 0UL)
+#define CY_IPC_X_MUX_SUM(c, ep, name, core, chan, intr, priority, mux, ...) + (((core) == (c)) ? (1UL << (uint32_t)(mux)) : 0UL)
+#define CY_IPC_X_CLIENT_OR(e, name, ep, id)                         | (((ep) == (e)) ? (1UL << (id)) : 0UL)
+#define CY_IPC_X_CLIENT_SUM(e, name, ep, id)                        + (((ep) == (e)) ? (1UL << (id)) : 0UL)
+
+#define CY_IPC_X_CHECK_ENDPOINT(arg, ep, name, core, chan, intr, priority, mux, clients)               \
+    IPC_PORT_STATIC_ASSERT((CY_IPC_CHAN_USER + (chan)) < CY_IPC_CHANNELS, "EP" #ep ": no such IPC channel on the device"); \
+    IPC_PORT_STATIC_ASSERT((CY_IPC_INTR_USER + (intr)) < CY_IPC_INTERRUPTS, "EP" #ep ": no such IPC interrupt on the device"); \
+    IPC_PORT_STATIC_ASSERT((CY_IPC_CHAN_USER + (chan)) < 16UL, "EP" #ep ": channel beyond the 16-bit interrupt mask"); \
+    IPC_PORT_STATIC_ASSERT((CY_IPC_INTR_USER + (intr)) < 16UL, "EP" #ep ": interrupt beyond the 16-bit release mask"); \
+    IPC_PORT_STATIC_ASSERT((0UL CY_IPC_CYPIPE_CLIENTS(CY_IPC_X_CLIENT_OR, ep)) ==                         \
+                           (0UL CY_IPC_CYPIPE_CLIENTS(CY_IPC_X_CLIENT_SUM, ep)), "EP" #ep ": client ID used twice");
+#define CY_IPC_X_CHECK_CLIENT(arg, name, ep, id)                                                       \
+    IPC_PORT_STATIC_ASSERT((ep) < CY_IPC_MAX_ENDPOINTS, #name ": no such endpoint");                   \
+    IPC_PORT_STATIC_ASSERT((id) < CY_IPC_CYPIPE_CLIENT_CNT_EP##ep, #name ": beyond the callback array");
+#define CY_IPC_X_CHECK_CORE(arg, c)                                                                    \
+    IPC_PORT_STATIC_ASSERT((0UL CY_IPC_CYPIPE_ENDPOINTS(CY_IPC_X_MUX_OR, c)) ==                         \
+                           (0UL CY_IPC_CYPIPE_ENDPOINTS(CY_IPC_X_MUX_SUM, c)), #c ": CPU interrupt used twice");
+
+IPC_PORT_STATIC_ASSERT((0UL CY_IPC_CYPIPE_ENDPOINTS(CY_IPC_X_EP_OR, ~)) == ((1UL << CY_IPC_MAX_ENDPOINTS) - 1UL),
+                       "Endpoints must be numbered 0 .. CY_IPC_MAX_ENDPOINTS - 1");
+IPC_PORT_STATIC_ASSERT((0UL CY_IPC_CYPIPE_ENDPOINTS(CY_IPC_X_INTR_OR, ~)) ==
+                       (0UL CY_IPC_CYPIPE_ENDPOINTS(CY_IPC_X_INTR_SUM, ~)), "IPC interrupt used twice");
+IPC_PORT_STATIC_ASSERT((0UL CY_IPC_CYPIPE_ENDPOINTS(CY_IPC_X_CHAN_OR, ~)) ==
+                       (0UL CY_IPC_CYPIPE_ENDPOINTS(CY_IPC_X_CHAN_SUM, ~)),
+                       "An endpoint with clients must have its IPC channel to itself");
+IPC_PORT_STATIC_ASSERT(((0UL CY_IPC_CYPIPE_CLIENTS(CY_IPC_X_CLIENT_OR, 0)) &
+                        (0UL CY_IPC_CYPIPE_CLIENTS(CY_IPC_X_CLIENT_OR, 5))) == 0UL,
+                       "EP0 and EP5 share the CM0+ dispatch table, their client IDs must not overlap");
+CY_IPC_CYPIPE_ENDPOINTS(CY_IPC_X_CHECK_ENDPOINT, ~)
+CY_IPC_CYPIPE_CLIENTS(CY_IPC_X_CHECK_CLIENT, ~)
+CY_IPC_CYPIPE_CORES(CY_IPC_X_CHECK_CORE, ~)
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef enum
+{
+    CY_IPC_PKT_FROM_CM0_TO_CM7_0,
+    CY_IPC_PKT_FROM_CM7_0_TO_CM0,
+    CY_IPC_PKT_FROM_CM7_1_TO_CM0,
+    CY_IPC_PKT_FROM_CM0_TO_CM7_1,
+} cy_en_ipc_pktType_t;
+
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Cypipe_TakeNotify
+********************************************************************************
+* Summary:
+* Takes the notify events of an endpoint without clients and tells whether
+* there were any. Its channel belongs to the CM0+ endpoint it sends to and
+* may hold the core's own message; Cy_IPC_Pipe_ExecuteCallback() would read
+* that message on a notify event and release it unseen. The ISR of such an
+* endpoint calls this first and handles the doorbell, then
+* Cy_IPC_Pipe_ExecuteCallback() for the releases.
+*
+* Parameters:
+*  intr: IPC interrupt of the endpoint, CY_IPC_INTR_CYPIPE_EPn.
+*
+* Return:
+*  true if the endpoint was notified.
+*
+*******************************************************************************/
+static inline bool Cy_IPC_Cypipe_TakeNotify(uint32_t intr)
+{
+    IPC_INTR_STRUCT_Type *intrBase = Cy_IPC_Drv_GetIntrBaseAddr(intr);
+    uint32_t notify = Cy_IPC_Drv_ExtractAcquireMask(Cy_IPC_Drv_GetInterruptStatusMasked(intrBase));
+
+    if (0UL != notify)
+    {
+        Cy_IPC_Drv_ClearInterrupt(intrBase, CY_IPC_NO_NOTIFICATION, notify);
+    }
+
+    return (0UL != notify);
+}
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* IPC_TOPOLOGY_H */
+
+/* [] END OF FILE */
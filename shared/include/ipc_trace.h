@@ -0,0 +1,236 @@
+/******************************************************************************
+* File Name:   ipc_trace.h
+*
+* Description: Binary event trace of the IPC path. Each core records the
+*              send, lock, notify, ISR, callback and release events of its
+*              messages into a flight recorder ring that the host tool in
+*              host/trace reads offline. With IPC_TRACE_ENABLE set to 0 all
+*              hooks compile to nothing.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef IPC_TRACE_H
+#define IPC_TRACE_H
+
+#include "ipc_port.h"
+#include "ipc_stats.h"
+#include "ipc_msg.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+/* Does not change the message layout; the hooks cost a few cycles each */
+#ifndef IPC_TRACE_ENABLE
+#define IPC_TRACE_ENABLE                (0)
+#endif
+
+/* Records kept per core, must be a power of two. Older records are
+ * overwritten, so the ring holds the events leading up to a failure. */
+#ifndef CY_IPC_TRACE_DEPTH
+#define CY_IPC_TRACE_DEPTH              (512UL)
+#endif
+
+#define CY_IPC_TRACE_MAGIC              (0x54435049UL)  /* "IPCT" */
+#define CY_IPC_TRACE_VERSION            (1U)
+#define CY_IPC_TRACE_NO_CLIENT          (0xFFUL)        /* Event of an endpoint, not of a client */
+
+/* Timestamp source, the clock of ipc_stats.h so that all cores share it.
+ * IPC_TRACE_CLOCK_HZ is stored in the dump for the host tool; 0 makes it
+ * report ticks. On the target, set it to the clock the BSP assigns to the
+ * counter. */
+#ifndef IPC_TRACE_CLOCK
+#define IPC_TRACE_CLOCK()               IPC_STATS_CLOCK()
+#endif
+
+#ifndef IPC_TRACE_CLOCK_HZ
+#if defined(IPC_HOST_BUILD)
+#define IPC_TRACE_CLOCK_HZ              (1000000000UL)
+#else
+#define IPC_TRACE_CLOCK_HZ              (0UL)
+#endif /* IPC_HOST_BUILD */
+#endif
+
+IPC_PORT_STATIC_ASSERT((CY_IPC_TRACE_DEPTH & (CY_IPC_TRACE_DEPTH - 1UL)) == 0UL, "CY_IPC_TRACE_DEPTH must be a power of two");
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+/* Events of a message. The channel lock and the notify of a pipe message are
+ * taken inside Cy_IPC_Pipe_SendMessage(), so LOCK marks the return of a send
+ * that got the channel, with the receiver already notified. NOTIFY is a
+ * doorbell raised without a message. */
+typedef enum
+{
+    CY_IPC_TRACE_SEND,          /* Sender: send call entered, arg: payload bytes */
+    CY_IPC_TRACE_LOCK,          /* Sender: channel locked and receiver notified */
+    CY_IPC_TRACE_BUSY,          /* Sender: send refused, the channel was locked */
+    CY_IPC_TRACE_NOTIFY,        /* Sender: notify without a message, arg: interrupt mask */
+    CY_IPC_TRACE_ISR,           /* Receiver: pipe ISR entry */
+    CY_IPC_TRACE_CALLBACK,      /* Receiver: handler returned, arg: ticks in the handler */
+    CY_IPC_TRACE_RELEASE,       /* Sender: release callback */
+    CY_IPC_TRACE_ERROR,         /* Rejected message or handle_error(), arg: cause */
+    CY_IPC_TRACE_EVENT_COUNT,
+} cy_en_ipc_trace_event_t;
+
+/* One event, 16 bytes. Messages are told apart by their address: a pipe
+ * message is handled in place, so sender and receiver record the same one. */
+typedef struct
+{
+    uint32_t time;              /* IPC_TRACE_CLOCK() */
+    uint8_t event;              /* cy_en_ipc_trace_event_t */
+    uint8_t core;               /* Core that recorded the event, cy_en_ipc_core_t */
+    uint8_t ep;                 /* Endpoint address of the receiver, for NOTIFY of the raising channel */
+    uint8_t client;             /* Client ID, or CY_IPC_TRACE_NO_CLIENT */
+    uint32_t msg;               /* Message address, low 32 bits on the host */
+    uint32_t arg;               /* Event specific */
+} cy_stc_ipc_trace_rec_t;
+
+/* Header of a ring, 32 bytes. The dump of a ring is its memory image, so
+ * the layout is the same on the target and on the host. */
+typedef struct
+{
+    uint32_t magic;             /* CY_IPC_TRACE_MAGIC */
+    uint16_t version;           /* CY_IPC_TRACE_VERSION */
+    uint16_t recordSize;        /* sizeof(cy_stc_ipc_trace_rec_t) */
+    uint32_t depth;             /* CY_IPC_TRACE_DEPTH */
+    uint32_t core;              /* Owner, cy_en_ipc_core_t */
+    cy_ipc_atomic32_t head;     /* Records claimed since Cy_IPC_Trace_Init(), the next is rec[head % depth] */
+    uint32_t clockHz;           /* IPC_TRACE_CLOCK_HZ */
+    uint32_t reserved[2];
+} cy_stc_ipc_trace_hdr_t;
+
+/* Ring of one core. Only its owner records into it, from any context. */
+typedef struct
+{
+    CY_ALIGN(IPC_PORT_CACHE_LINE) cy_stc_ipc_trace_hdr_t hdr;
+    cy_stc_ipc_trace_rec_t rec[CY_IPC_TRACE_DEPTH];
+} cy_stc_ipc_trace_t;
+
+IPC_PORT_STATIC_ASSERT(sizeof(cy_stc_ipc_trace_rec_t) == 16UL, "Trace record layout");
+IPC_PORT_STATIC_ASSERT(sizeof(cy_stc_ipc_trace_hdr_t) == 32UL, "Trace header layout");
+
+/* Byte sink of Cy_IPC_Trace_Dump(), returns false to stop the dump */
+typedef bool (*cy_ipc_trace_write_t)(const void *data, uint32_t size, void *context);
+
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Trace_Record
+********************************************************************************
+* Summary:
+* Appends an event to the ring: one atomic increment to claim a record and
+* four stores, so it can stay enabled under load. The claim makes it safe
+* from thread and interrupt context of the owning core; the ring must not
+* be shared between cores.
+*
+* Parameters:
+*  trace: Ring of the calling core.
+*  event: Event.
+*  ep: Endpoint address of the receiver.
+*  client: Client ID, or CY_IPC_TRACE_NO_CLIENT.
+*  msg: Message, or NULL.
+*  arg: Event specific value.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static inline void Cy_IPC_Trace_Record(cy_stc_ipc_trace_t *trace, cy_en_ipc_trace_event_t event, uint32_t ep,
+                                       uint32_t client, const volatile void *msg, uint32_t arg)
+{
+    cy_stc_ipc_trace_rec_t *rec = &trace->rec[Cy_IPC_Port_FetchAdd(&trace->hdr.head, 1UL) & (CY_IPC_TRACE_DEPTH - 1UL)];
+
+    rec->time = IPC_TRACE_CLOCK();
+    rec->event = (uint8_t)event;
+    rec->core = (uint8_t)trace->hdr.core;
+    rec->ep = (uint8_t)ep;
+    rec->client = (uint8_t)client;
+    rec->msg = (uint32_t)(uintptr_t)msg;
+    rec->arg = arg;
+}
+
+
+/*******************************************************************************
+* Hooks. Use these in the message path; they expand to nothing when
+* IPC_TRACE_ENABLE is 0.
+*******************************************************************************/
+#if IPC_TRACE_ENABLE
+
+/* Records an event */
+#define IPC_TRACE(trace, event, ep, client, msg, arg)   Cy_IPC_Trace_Record((trace), (event), (ep), (client), (msg), (arg))
+/* Records the send of a message in the format of ipc_msg.h, and its outcome */
+#define IPC_TRACE_SEND(trace, ep, msg) \
+    Cy_IPC_Trace_Record((trace), CY_IPC_TRACE_SEND, (ep), ((const cy_stc_ipc_msg_hdr_t *)(msg))->clientID, (msg), \
+                        ((const cy_stc_ipc_msg_hdr_t *)(msg))->length)
+#define IPC_TRACE_SENT(trace, ep, msg, locked) \
+    Cy_IPC_Trace_Record((trace), (locked) ? CY_IPC_TRACE_LOCK : CY_IPC_TRACE_BUSY, (ep), \
+                        ((const cy_stc_ipc_msg_hdr_t *)(msg))->clientID, (msg), 0UL)
+/* Declares a timestamp variable */
+#define IPC_TRACE_TIME(var)                             uint32_t var = IPC_TRACE_CLOCK()
+/* Records the end of a handler, with the time spent in it since start */
+#define IPC_TRACE_CALLBACK(trace, ep, client, msg, start) \
+    Cy_IPC_Trace_Record((trace), CY_IPC_TRACE_CALLBACK, (ep), (client), (msg), IPC_TRACE_CLOCK() - (start))
+
+#else
+
+#define IPC_TRACE(trace, event, ep, client, msg, arg)   do { } while (0)
+#define IPC_TRACE_SEND(trace, ep, msg)                  do { } while (0)
+#define IPC_TRACE_SENT(trace, ep, msg, locked)          do { } while (0)
+#define IPC_TRACE_TIME(var)
+#define IPC_TRACE_CALLBACK(trace, ep, client, msg, start) do { } while (0)
+
+#endif /* IPC_TRACE_ENABLE */
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void Cy_IPC_Trace_Init(cy_stc_ipc_trace_t *trace, uint32_t core);
+uint32_t Cy_IPC_Trace_Dump(const cy_stc_ipc_trace_t *trace, cy_ipc_trace_write_t write, void *context);
+void Cy_IPC_Trace_Save(const cy_stc_ipc_trace_t *trace);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* IPC_TRACE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,182 @@
+/******************************************************************************
+* File Name:   ipc_work.h
+*
+* Description: Work-stealing task queue for offloading jobs to the CM7
+*              cores. Each worker core owns a deque: it pushes jobs at the
+*              bottom and takes them from the top, where idle workers
+*              steal them too. A core without exclusive access submits
+*              through an inbox ring of a worker instead. Sleeping workers
+*              are woken by an IPC doorbell, completions go back to the
+*              submitter through the pipe. Host-only for now: no core image
+*              offloads yet, host/bench/bench_offload.c drives it.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef IPC_WORK_H
+#define IPC_WORK_H
+
+#include "ipc_port.h"
+#include "ipc_ring.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+#define CY_IPC_WORK_MAX_WORKERS         (2UL)   /* CM7_0 and CM7_1 */
+#define CY_IPC_WORK_ANY_WORKER          (0xFFFFFFFFUL) /* Cy_IPC_Work_SubmitRemote(): the queue picks one */
+
+#ifndef CY_IPC_WORK_DEPTH
+#define CY_IPC_WORK_DEPTH               (32UL)  /* Jobs per deque and per inbox, power of two */
+#endif
+
+
+/*******************************************************************************
+* Data types
+*******************************************************************************/
+typedef enum
+{
+    CY_IPC_WORK_SUCCESS,            /* Operation completed */
+    CY_IPC_WORK_EMPTY,              /* No job for this worker */
+    CY_IPC_WORK_ERROR_FULL,         /* Deque or inbox full, the job was not submitted */
+    CY_IPC_WORK_ERROR_BAD_PARAM,    /* Invalid queue, worker or job */
+    CY_IPC_WORK_ERROR_NO_METHOD,    /* Workers have no such method */
+} cy_en_ipc_work_status_t;
+
+/* Job, copied into the queue on submit */
+typedef struct
+{
+    uint16_t method;        /* Index into the method table of the workers */
+    uint8_t  core;          /* Submitting core, cy_en_ipc_core_t: the completion goes there */
+    uint8_t  reserved;
+    uint32_t id;            /* Chosen by the submitter, returned in the completion */
+    uint32_t arg;           /* Argument of the method */
+} cy_stc_ipc_work_job_t;
+
+/* Completion of a job, the payload of the message the worker sends back */
+typedef struct
+{
+    uint32_t id;            /* ID of the job */
+    uint32_t result;        /* Return value of the method */
+    uint16_t method;        /* Method of the job */
+    uint8_t  status;        /* cy_en_ipc_work_status_t: SUCCESS or ERROR_NO_METHOD */
+    uint8_t  core;          /* Submitting core */
+    uint8_t  worker;        /* Worker that ran the job */
+    uint8_t  stolen;        /* Taken from the deque of another worker */
+    uint16_t reserved;
+} cy_stc_ipc_work_done_t;
+
+/* Job method, runs on the worker core */
+typedef uint32_t (*cy_ipc_work_method_t)(uint32_t arg);
+
+/* Deque of one worker. The owner pushes at bottom; it and the other
+ * workers take at top with a compare-exchange, so a job is taken exactly
+ * once and in submission order. The owner line is written by the owner
+ * only.
+ */
+typedef struct
+{
+    CY_ALIGN(IPC_PORT_CACHE_LINE) cy_ipc_atomic32_t top; /* Next job to take */
+
+    CY_ALIGN(IPC_PORT_CACHE_LINE) cy_ipc_atomic32_t bottom; /* Owner line: next free slot */
+    cy_ipc_atomic32_t idle;         /* Owner line: owner out of work, asleep or about to be */
+    uint32_t  notifyMask;           /* Doorbell: IPC interrupt mask of the owner */
+    uint32_t  executed;             /* Owner line: jobs run by the owner */
+    uint32_t  stolen;               /* Owner line: jobs the owner took from other deques */
+    uint32_t  sleeps;               /* Owner line: times the owner ran out of work */
+    uint32_t  rung;                 /* Owner line: doorbells the owner rang for other workers */
+    cy_stc_ipc_work_job_t job[CY_IPC_WORK_DEPTH];
+
+    cy_stc_ipc_ring_t inbox;        /* Jobs from the core without exclusive access */
+    CY_ALIGN(IPC_PORT_CACHE_LINE) cy_stc_ipc_work_job_t inboxBuf[CY_IPC_WORK_DEPTH];
+} cy_stc_ipc_work_deque_t;
+
+/* Shared queue. Place it in SRAM visible to every core and not in a TCM.
+ * Workers steal with compare-exchange, which the D-caches of the two CM7
+ * cores do not keep coherent: map it non-cacheable on both, for example as
+ * a CY_IPC_HANDOFF_NONCACHEABLE pool of ipc_handoff.h.
+ */
+typedef struct
+{
+    uint32_t workers;               /* Worker cores, 1 .. CY_IPC_WORK_MAX_WORKERS */
+    cy_stc_ipc_work_deque_t deque[CY_IPC_WORK_MAX_WORKERS];
+} cy_stc_ipc_work_t;
+
+/* Worker side. Lives on the worker core. */
+typedef struct
+{
+    cy_stc_ipc_work_t *work;        /* Shared queue */
+    uint32_t index;                 /* Deque of this worker */
+    const cy_ipc_work_method_t *methods; /* Indexed by method */
+    uint32_t methodCount;           /* Entries in methods */
+    uint32_t victim;                /* Deque to steal from next */
+} cy_stc_ipc_work_worker_t;
+
+typedef struct
+{
+    uint32_t queued;                /* Jobs in the deque and the inbox */
+    uint32_t executed;              /* Jobs run by the worker */
+    uint32_t stolen;                /* Of those, taken from other deques */
+    uint32_t sleeps;                /* Times the worker ran out of work */
+    uint32_t rung;                  /* Doorbells it rang for other workers */
+} cy_stc_ipc_work_stats_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_en_ipc_work_status_t Cy_IPC_Work_Init(cy_stc_ipc_work_t *work, uint32_t workers, const uint32_t notifyMask[]);
+cy_en_ipc_work_status_t Cy_IPC_Work_InitWorker(cy_stc_ipc_work_worker_t *worker, cy_stc_ipc_work_t *work, uint32_t index,
+                                               const cy_ipc_work_method_t *methods, uint32_t methodCount);
+cy_en_ipc_work_status_t Cy_IPC_Work_Submit(cy_stc_ipc_work_worker_t *worker, const cy_stc_ipc_work_job_t *job,
+                                           uint32_t *notifyMask);
+cy_en_ipc_work_status_t Cy_IPC_Work_SubmitRemote(cy_stc_ipc_work_t *work, uint32_t target,
+                                                 const cy_stc_ipc_work_job_t *job, uint32_t *notifyMask);
+cy_en_ipc_work_status_t Cy_IPC_Work_Run(cy_stc_ipc_work_worker_t *worker, cy_stc_ipc_work_done_t *done,
+                                        uint32_t *notifyMask);
+bool Cy_IPC_Work_Sleep(cy_stc_ipc_work_worker_t *worker);
+void Cy_IPC_Work_GetStats(cy_stc_ipc_work_t *work, uint32_t index, cy_stc_ipc_work_stats_t *stats);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* IPC_WORK_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,196 @@
+/******************************************************************************
+* File Name:   ipc_adapt.c
+*
+* Description: Adaptive receive mode for a message queue. The receiver
+*              takes an interrupt per notify while traffic is light and
+*              switches to a bounded busy-poll of the queue, with the
+*              interrupt masked, while the arrival rate is high.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "ipc_adapt.h"
+
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Adapt_Init
+********************************************************************************
+* Summary:
+* Initializes the receiver in interrupt mode and clears the counters.
+*
+* Parameters:
+*  adapt: Mode state.
+*  config: Thresholds, copied. A window of 0 is treated as 1 tick, and an
+*          exitRate above enterRate as enterRate.
+*  now: Current tick.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Adapt_Init(cy_stc_ipc_adapt_t *adapt, const cy_stc_ipc_adapt_config_t *config, uint32_t now)
+{
+    uint32_t i;
+
+    adapt->config = *config;
+    if (0UL == adapt->config.window)
+    {
+        adapt->config.window = 1UL;
+    }
+    if (adapt->config.exitRate > adapt->config.enterRate)
+    {
+        adapt->config.exitRate = adapt->config.enterRate;
+    }
+
+    adapt->mode = CY_IPC_ADAPT_MODE_IRQ;
+    adapt->arrivals = 0UL;
+    adapt->windowStart = now;
+    adapt->windowArrivals = 0UL;
+    adapt->lastTick = now;
+    adapt->lastArrivals = 0UL;
+    adapt->idlePolls = 0UL;
+    for (i = 0UL; i < (uint32_t)CY_IPC_ADAPT_MODE_CNT; i++)
+    {
+        adapt->ticks[i] = 0ULL;
+        adapt->switches[i] = 0UL;
+    }
+    adapt->polls = 0UL;
+    adapt->emptyPolls = 0UL;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Adapt_Arrived
+********************************************************************************
+* Summary:
+* Counts received messages, in either mode.
+*
+* Parameters:
+*  adapt: Mode state.
+*  count: Number of messages.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Adapt_Arrived(cy_stc_ipc_adapt_t *adapt, uint32_t count)
+{
+    adapt->arrivals += count;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Adapt_Update
+********************************************************************************
+* Summary:
+* Accounts the time since the last update to the current mode and picks the
+* mode for the next pass. Call it after every poll of the queue in poll mode,
+* and on every wake-up in interrupt mode.
+*
+* Once a window has passed, its arrival rate is compared with the thresholds.
+* A window that ran long because the receiver slept is scaled to its real
+* length. In poll mode, pollBudget empty polls in a row also end polling, so
+* a burst followed by silence does not keep the receiver spinning until the
+* end of the window. Every switch starts a new window.
+*
+* Parameters:
+*  adapt: Mode state.
+*  now: Current tick.
+*
+* Return:
+*  Mode for the next pass. The caller masks the interrupt of the queue when
+*  it changes to CY_IPC_ADAPT_MODE_POLL and unmasks it when it changes back.
+*
+*******************************************************************************/
+cy_en_ipc_adapt_mode_t Cy_IPC_Adapt_Update(cy_stc_ipc_adapt_t *adapt, uint32_t now)
+{
+    cy_en_ipc_adapt_mode_t next = adapt->mode;
+    uint32_t elapsed = now - adapt->windowStart;
+    uint32_t rate;
+
+    adapt->ticks[adapt->mode] += (uint64_t)(now - adapt->lastTick);
+    adapt->lastTick = now;
+
+    if (CY_IPC_ADAPT_MODE_POLL == adapt->mode)
+    {
+        adapt->polls++;
+        if (adapt->arrivals == adapt->lastArrivals)
+        {
+            adapt->emptyPolls++;
+            adapt->idlePolls++;
+        }
+        else
+        {
+            adapt->idlePolls = 0UL;
+        }
+    }
+    adapt->lastArrivals = adapt->arrivals;
+
+    if (elapsed >= adapt->config.window)
+    {
+        rate = (uint32_t)(((uint64_t)(adapt->arrivals - adapt->windowArrivals) * adapt->config.window) / elapsed);
+        if ((CY_IPC_ADAPT_MODE_IRQ == adapt->mode) && (rate >= adapt->config.enterRate))
+        {
+            next = CY_IPC_ADAPT_MODE_POLL;
+        }
+        else if ((CY_IPC_ADAPT_MODE_POLL == adapt->mode) && (rate < adapt->config.exitRate))
+        {
+            next = CY_IPC_ADAPT_MODE_IRQ;
+        }
+        else
+        {
+            /* Stays */
+        }
+        adapt->windowStart = now;
+        adapt->windowArrivals = adapt->arrivals;
+    }
+
+    if ((CY_IPC_ADAPT_MODE_POLL == adapt->mode) && (adapt->idlePolls >= adapt->config.pollBudget))
+    {
+        next = CY_IPC_ADAPT_MODE_IRQ;
+    }
+
+    if (next != adapt->mode)
+    {
+        adapt->mode = next;
+        adapt->switches[next]++;
+        adapt->idlePolls = 0UL;
+        adapt->windowStart = now;
+        adapt->windowArrivals = adapt->arrivals;
+    }
+
+    return adapt->mode;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,141 @@
+/******************************************************************************
+* File Name:   ipc_batch.c
+*
+* Description: Doorbell coalescing for the shared ring transport.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "ipc_batch.h"
+
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Batch_Init
+********************************************************************************
+* Summary:
+* Initializes the batching state and clears the counters.
+*
+* Parameters:
+*  batch: Batching state.
+*  threshold: Number of pending messages that triggers a doorbell. Values
+*             below 1 are treated as 1, which rings on every message.
+*  timeout: Age in ticks of the oldest pending message that triggers a
+*           doorbell.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Batch_Init(cy_stc_ipc_batch_t *batch, uint32_t threshold, uint32_t timeout)
+{
+    batch->threshold = (0UL == threshold) ? 1UL : threshold;
+    batch->timeout = timeout;
+    batch->pending = 0UL;
+    batch->firstTick = 0UL;
+    batch->messages = 0UL;
+    batch->doorbells = 0UL;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Batch_Add
+********************************************************************************
+* Summary:
+* Accounts for one message pushed into the ring.
+*
+* Parameters:
+*  batch: Batching state.
+*  now: Current tick.
+*
+* Return:
+*  true if the doorbell should be rung now.
+*
+*******************************************************************************/
+bool Cy_IPC_Batch_Add(cy_stc_ipc_batch_t *batch, uint32_t now)
+{
+    if (0UL == batch->pending)
+    {
+        batch->firstTick = now;
+    }
+    batch->pending++;
+    batch->messages++;
+
+    return Cy_IPC_Batch_IsDue(batch, now);
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Batch_IsDue
+********************************************************************************
+* Summary:
+* Checks whether the pending messages need a doorbell, either because the
+* threshold is reached or because the oldest one timed out. Call it
+* periodically and after each release so that partial batches and doorbells
+* refused with CY_IPC_PIPE_ERROR_SEND_BUSY are not left behind.
+*
+* Parameters:
+*  batch: Batching state.
+*  now: Current tick.
+*
+* Return:
+*  true if the doorbell should be rung now.
+*
+*******************************************************************************/
+bool Cy_IPC_Batch_IsDue(const cy_stc_ipc_batch_t *batch, uint32_t now)
+{
+    return (batch->pending >= batch->threshold) ||
+           ((0UL != batch->pending) && ((now - batch->firstTick) >= batch->timeout));
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Batch_Sent
+********************************************************************************
+* Summary:
+* Marks all pending messages as signalled. Call it only when the doorbell was
+* actually sent.
+*
+* Parameters:
+*  batch: Batching state.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Batch_Sent(cy_stc_ipc_batch_t *batch)
+{
+    batch->pending = 0UL;
+    batch->doorbells++;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,397 @@
+/******************************************************************************
+* File Name:   ipc_consumer.c
+*
+* Description: Receive side of the bulk lane on CM0+.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "cy_pdl.h"
+#include "ipc_consumer.h"
+
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Consumer_Init
+********************************************************************************
+* Summary:
+* Initializes the consumer. The producers are cleared; each is attached by
+* its first doorbell. The work queue, if any, must be initialized with the
+* element size of the work items.
+*
+* Parameters:
+*  consumer: Consumer state.
+*  config: Endpoints, buffers and handlers; must stay valid.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Consumer_Init(cy_stc_ipc_consumer_t *consumer, const cy_stc_ipc_consumer_config_t *config)
+{
+    uint32_t i;
+
+    consumer->config = config;
+    consumer->first = 0UL;
+    consumer->received = 0UL;
+    consumer->stalled = false;
+    consumer->drainDue = false;
+    consumer->drainReceived = 0UL;
+    for (i = 0UL; i < config->producerCount; i++)
+    {
+        config->producers[i].ring = NULL;
+        config->producers[i].credit.credit = NULL;
+        config->producers[i].messages = 0UL;
+    }
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Consumer_Isr
+********************************************************************************
+* Summary:
+* Pipe interrupt of all producer endpoints. They share a priority, and the
+* interrupt controller would always take the lower interrupt number first;
+* instead each entry takes the waiting message of every endpoint, starting
+* with the one served second last time, so a saturating producer cannot
+* starve the other. With a full work queue the interrupts are disabled and
+* the messages stay in their channels, which holds off the senders, until
+* Cy_IPC_Consumer_RunDeferred() has made room. Also called with the
+* interrupts masked by Cy_IPC_Consumer_RunAdaptive() while it polls.
+*
+* Parameters:
+*  consumer: Consumer state.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Consumer_Isr(cy_stc_ipc_consumer_t *consumer)
+{
+    const cy_stc_ipc_consumer_config_t *config = consumer->config;
+    uint32_t first = consumer->first;
+    uint32_t ep;
+    uint32_t i;
+
+#if IPC_STATS_ENABLE
+    consumer->received = IPC_STATS_CLOCK();
+#endif /* IPC_STATS_ENABLE */
+    consumer->first = (first + 1UL) % config->producerCount;
+
+    for (i = 0UL; i < config->producerCount; i++)
+    {
+        ep = config->endpoints[(first + i) % config->producerCount];
+        if (NULL != config->trace)
+        {
+            IPC_TRACE(config->trace, CY_IPC_TRACE_ISR, ep, CY_IPC_TRACE_NO_CLIENT, NULL, 0UL);
+        }
+
+        if ((NULL != config->work) && (config->workDepth == Cy_IPC_Ring_Count(config->work)))
+        {
+            config->enableIrq(false);
+            consumer->stalled = true;
+            return;
+        }
+
+        Cy_IPC_Pipe_ExecuteCallback(ep);
+
+        if (NULL != config->onServed)
+        {
+            config->onServed(ep);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Consumer_Attach
+********************************************************************************
+* Summary:
+* Notes the ring and the credit block from the doorbell of a producer. The
+* first doorbell with a credit block grants the producer its window.
+*
+* Parameters:
+*  consumer: Consumer state.
+*  producer: Producer index.
+*  ring: Shared ring of the producer.
+*  credit: Shared credit block of the producer, NULL for none.
+*  window: Messages the producer may have in its ring.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Consumer_Attach(cy_stc_ipc_consumer_t *consumer, uint32_t producer, cy_stc_ipc_ring_t *ring,
+                            cy_stc_ipc_credit_t *credit, uint32_t window)
+{
+    cy_stc_ipc_consumer_producer_t *pProducer;
+
+    if (producer >= consumer->config->producerCount)
+    {
+        return;
+    }
+
+    pProducer = &consumer->config->producers[producer];
+    pProducer->ring = ring;
+    if ((NULL != credit) && (pProducer->credit.credit != credit))
+    {
+        Cy_IPC_Credit_InitRx(&pProducer->credit, credit, window);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Consumer_Drain
+********************************************************************************
+* Summary:
+* Drains the rings of all producers round-robin, drainBudget messages at a
+* time, so a fast producer cannot hold back a slow one. Only messages queued
+* on entry are taken: a producer that keeps pushing would otherwise keep
+* CM0+ in the ISR forever. Later messages get their own doorbell. The
+* credits of the drained messages go back to each producer at the end.
+*
+* Parameters:
+*  consumer: Consumer state.
+*  received: ISR entry time of the doorbell, passed to the handler.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Consumer_Drain(cy_stc_ipc_consumer_t *consumer, uint32_t received)
+{
+    const cy_stc_ipc_consumer_config_t *config = consumer->config;
+    cy_stc_ipc_consumer_producer_t *pProducer;
+    uint32_t remaining[CY_IPC_CONSUMER_MAX_PRODUCERS];
+    uint32_t drained[CY_IPC_CONSUMER_MAX_PRODUCERS];
+    bool more;
+    uint32_t budget;
+    uint32_t i;
+
+    for (i = 0UL; i < config->producerCount; i++)
+    {
+        pProducer = &config->producers[i];
+        remaining[i] = (NULL != pProducer->ring) ? Cy_IPC_Ring_Count(pProducer->ring) : 0UL;
+        drained[i] = 0UL;
+    }
+
+    do
+    {
+        more = false;
+        for (i = 0UL; i < config->producerCount; i++)
+        {
+            pProducer = &config->producers[i];
+            for (budget = config->drainBudget; (0UL != budget) && (0UL != remaining[i]); budget--)
+            {
+                if (CY_IPC_RING_SUCCESS != Cy_IPC_Ring_Pop(pProducer->ring, config->msg))
+                {
+                    remaining[i] = 0UL;
+                    break;
+                }
+                remaining[i]--;
+                drained[i]++;
+                pProducer->messages++;
+                config->onMessage(config->msg, i, received);
+            }
+            more = more || (0UL != remaining[i]);
+        }
+    } while (more);
+
+    for (i = 0UL; i < config->producerCount; i++)
+    {
+        if (NULL != config->producers[i].credit.credit)
+        {
+            Cy_IPC_Credit_Grant(&config->producers[i].credit, drained[i]);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Consumer_DrainLater
+********************************************************************************
+* Summary:
+* Leaves the drain to Cy_IPC_Consumer_RunDeferred(); called instead of
+* Cy_IPC_Consumer_Drain() by the doorbell handler of a deferred consumer.
+*
+* Parameters:
+*  consumer: Consumer state.
+*  received: ISR entry time of the doorbell.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Consumer_DrainLater(cy_stc_ipc_consumer_t *consumer, uint32_t received)
+{
+    consumer->drainReceived = received;
+    consumer->drainDue = true;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Consumer_Defer
+********************************************************************************
+* Summary:
+* Copies a work item into the work queue; called from a client callback,
+* which releases the channel as soon as it returns. The ISR only runs the
+* callback when the queue has room. Should the push fail anyway, this takes
+* the stall path of the ISR: the interrupts stay disabled until
+* Cy_IPC_Consumer_RunDeferred() has made room. The pipe driver releases
+* the channel after every callback, so the caller must then handle the
+* message in place, while it still holds the channel.
+*
+* Parameters:
+*  consumer: Consumer state.
+*  item: Work item, of the element size of the work queue.
+*
+* Return:
+*  true if the item was queued.
+*
+*******************************************************************************/
+bool Cy_IPC_Consumer_Defer(cy_stc_ipc_consumer_t *consumer, const void *item)
+{
+    if (CY_IPC_RING_SUCCESS == Cy_IPC_Ring_Push(consumer->config->work, item))
+    {
+        return true;
+    }
+
+    consumer->config->enableIrq(false);
+    consumer->stalled = true;
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Consumer_RunDeferred
+********************************************************************************
+* Summary:
+* Bottom half of the ISR, called from the main loop. Runs the handler of
+* every queued work item and drains the rings whose doorbell rang. The
+* interrupts held back for lack of room are enabled again once an item is
+* taken off the queue.
+*
+* Parameters:
+*  consumer: Consumer state.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Consumer_RunDeferred(cy_stc_ipc_consumer_t *consumer)
+{
+    const cy_stc_ipc_consumer_config_t *config = consumer->config;
+
+    while (CY_IPC_RING_SUCCESS == Cy_IPC_Ring_Pop(config->work, config->item))
+    {
+        if (consumer->stalled)
+        {
+            consumer->stalled = false;
+            config->enableIrq(true);
+        }
+        config->onWork(config->item);
+    }
+
+    /* Cleared first: a doorbell that rings during the drain sets it again */
+    if (consumer->drainDue)
+    {
+        consumer->drainDue = false;
+        Cy_IPC_Consumer_Drain(consumer, consumer->drainReceived);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Consumer_IsIdle
+********************************************************************************
+* Summary:
+* Checks that the main loop has nothing left to run. Call it with interrupts
+* masked before WFI, so that work queued by the ISR in between wakes the
+* core.
+*
+* Parameters:
+*  consumer: Consumer state.
+*
+* Return:
+*  true if the work queue is empty and no drain is due.
+*
+*******************************************************************************/
+bool Cy_IPC_Consumer_IsIdle(cy_stc_ipc_consumer_t *consumer)
+{
+    return ((NULL == consumer->config->work) || (0UL == Cy_IPC_Ring_Count(consumer->config->work))) &&
+           !consumer->drainDue;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Consumer_RunAdaptive
+********************************************************************************
+* Summary:
+* One pass of a main loop with adaptive polling. In interrupt mode the core
+* sleeps until the next interrupt. In poll mode the interrupts are masked;
+* each pass runs the ISR by hand, which takes a message waiting in a
+* channel, and drains the producer rings without waiting for a doorbell.
+* adapt switches between the two by the message rate, which the handlers
+* report with Cy_IPC_Adapt_Arrived().
+*
+* Parameters:
+*  consumer: Consumer state.
+*  adapt: Mode state, its ticks are IPC_STATS_CLOCK() ticks.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Consumer_RunAdaptive(cy_stc_ipc_consumer_t *consumer, cy_stc_ipc_adapt_t *adapt)
+{
+    cy_en_ipc_adapt_mode_t mode = adapt->mode;
+    uint32_t interruptState;
+
+    if (CY_IPC_ADAPT_MODE_POLL == mode)
+    {
+        Cy_IPC_Consumer_Isr(consumer);
+        Cy_IPC_Consumer_Drain(consumer, consumer->received);
+    }
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    if (mode != Cy_IPC_Adapt_Update(adapt, IPC_STATS_CLOCK()))
+    {
+        /* A message left in a channel raises the interrupt again once enabled */
+        consumer->config->enableIrq(CY_IPC_ADAPT_MODE_IRQ == adapt->mode);
+    }
+    else if (CY_IPC_ADAPT_MODE_IRQ == mode)
+    {
+        __WFI();
+    }
+    else
+    {
+        /* Keeps polling */
+    }
+    Cy_SysLib_ExitCriticalSection(interruptState);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,370 @@
+/******************************************************************************
+* File Name:   ipc_credit.c
+*
+* Description: Credit-based flow control over a shared ring. The receiver
+*              grants the sender credits as it consumes; a sender out of
+*              credits blocks, queues or drops the message by policy, and
+*              both sides count the stalls and drops.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "ipc_credit.h"
+
+
+/*******************************************************************************
+* Function Name: ipc_credit_load_granted
+********************************************************************************
+* Summary:
+* Reads the grant as published by the receiver.
+*
+*******************************************************************************/
+static inline uint32_t ipc_credit_load_granted(cy_stc_ipc_credit_t *credit)
+{
+    Cy_IPC_Port_InvalidateDCache(&credit->granted, sizeof(credit->granted));
+    return IPC_PORT_LOAD_ACQUIRE(&credit->granted);
+}
+
+/*******************************************************************************
+* Function Name: ipc_credit_publish_tx
+********************************************************************************
+* Summary:
+* Writes the counters of the sender to its line of the credit block, for
+* the receiver to read with its next grant.
+*
+*******************************************************************************/
+static void ipc_credit_publish_tx(cy_stc_ipc_credit_tx_t *tx)
+{
+    IPC_PORT_STORE_RELAXED(&tx->credit->stalls, tx->stalls);
+    IPC_PORT_STORE_RELAXED(&tx->credit->queued, tx->queued);
+    IPC_PORT_STORE_RELAXED(&tx->credit->drops, tx->drops);
+    Cy_IPC_Port_CleanDCache(&tx->credit->stalls, IPC_PORT_CACHE_LINE);
+}
+
+/*******************************************************************************
+* Function Name: ipc_credit_publish_rx
+********************************************************************************
+* Summary:
+* Grants the sender window messages beyond those consumed so far.
+*
+*******************************************************************************/
+static void ipc_credit_publish_rx(cy_stc_ipc_credit_rx_t *rx)
+{
+    IPC_PORT_STORE_RELEASE(&rx->credit->granted, rx->consumed + rx->window);
+    Cy_IPC_Port_CleanDCache(&rx->credit->granted, sizeof(rx->credit->granted));
+    rx->grants++;
+}
+
+/*******************************************************************************
+* Function Name: ipc_credit_push
+********************************************************************************
+* Summary:
+* Writes one message to the shared ring if a credit is left. The grant is
+* only read from the credit block when the cached copy is used up.
+*
+*******************************************************************************/
+static bool ipc_credit_push(cy_stc_ipc_credit_tx_t *tx, const void *msg)
+{
+    /* The grant can fall behind the sent count when the receiver shrinks its window */
+    if ((int32_t)(tx->granted - tx->sent) <= 0)
+    {
+        tx->granted = ipc_credit_load_granted(tx->credit);
+        if ((int32_t)(tx->granted - tx->sent) <= 0)
+        {
+            return false;
+        }
+    }
+
+    /* Only fails if the window is deeper than the ring */
+    if (CY_IPC_RING_SUCCESS != Cy_IPC_Ring_Push(tx->ring, msg))
+    {
+        return false;
+    }
+
+    tx->sent++;
+    tx->stalled = false;
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Credit_InitTx
+********************************************************************************
+* Summary:
+* Initializes the sender and the credit block. Must be called before the
+* receiver learns the block, the initial grant is overwritten by its first
+* one.
+*
+* Parameters:
+*  tx: Sender state.
+*  credit: Credit block shared with the receiver.
+*  ring: Shared ring the messages are written to.
+*  policy: What a send does without credit.
+*  backlog: Local ring with the element size of ring, holds the messages of
+*           CY_IPC_CREDIT_POLICY_QUEUE. NULL for the other policies.
+*  initial: Credits until the receiver grants its own window, at most the
+*           depth of ring.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Credit_InitTx(cy_stc_ipc_credit_tx_t *tx, cy_stc_ipc_credit_t *credit, cy_stc_ipc_ring_t *ring,
+                          cy_en_ipc_credit_policy_t policy, cy_stc_ipc_ring_t *backlog, uint32_t initial)
+{
+    tx->credit = credit;
+    tx->ring = ring;
+    tx->backlog = (CY_IPC_CREDIT_POLICY_QUEUE == policy) ? backlog : NULL;
+    tx->policy = ((CY_IPC_CREDIT_POLICY_QUEUE == policy) && (NULL == backlog)) ? CY_IPC_CREDIT_POLICY_DROP : policy;
+    tx->granted = initial;
+    tx->sent = 0UL;
+    tx->stalled = false;
+    tx->stalls = 0UL;
+    tx->queued = 0UL;
+    tx->drops = 0UL;
+
+    IPC_PORT_STORE_RELEASE(&credit->granted, initial);
+    Cy_IPC_Port_CleanDCache(&credit->granted, sizeof(credit->granted));
+    ipc_credit_publish_tx(tx);
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Credit_Send
+********************************************************************************
+* Summary:
+* Writes one message to the shared ring, using up one credit. Without credit
+* the message is handled by the policy; the first send of every stall is
+* counted. While messages wait in the backlog, new ones queue behind them
+* so the order is kept; call Cy_IPC_Credit_Flush() first to move them on.
+*
+* Parameters:
+*  tx: Sender state.
+*  msg: Message of the ring's element size.
+*
+* Return:
+*  CY_IPC_CREDIT_SUCCESS, or the outcome of the policy: CY_IPC_CREDIT_QUEUED,
+*  CY_IPC_CREDIT_BLOCKED or CY_IPC_CREDIT_DROPPED
+*
+*******************************************************************************/
+cy_en_ipc_credit_status_t Cy_IPC_Credit_Send(cy_stc_ipc_credit_tx_t *tx, const void *msg)
+{
+    cy_en_ipc_credit_status_t status;
+    bool waiting = false;
+
+    if (NULL != tx->backlog)
+    {
+        waiting = (0UL != Cy_IPC_Ring_Count(tx->backlog));
+    }
+
+    if (!waiting && ipc_credit_push(tx, msg))
+    {
+        return CY_IPC_CREDIT_SUCCESS;
+    }
+
+    if (!tx->stalled)
+    {
+        tx->stalled = true;
+        tx->stalls++;
+    }
+
+    switch (tx->policy)
+    {
+        case CY_IPC_CREDIT_POLICY_BLOCK:
+            status = CY_IPC_CREDIT_BLOCKED;
+            break;
+
+        case CY_IPC_CREDIT_POLICY_QUEUE:
+            if (CY_IPC_RING_SUCCESS == Cy_IPC_Ring_Push(tx->backlog, msg))
+            {
+                tx->queued++;
+                status = CY_IPC_CREDIT_QUEUED;
+            }
+            else
+            {
+                tx->drops++;
+                status = CY_IPC_CREDIT_DROPPED;
+            }
+            break;
+
+        default:
+            tx->drops++;
+            status = CY_IPC_CREDIT_DROPPED;
+            break;
+    }
+
+    ipc_credit_publish_tx(tx);
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Credit_Flush
+********************************************************************************
+* Summary:
+* Moves messages from the backlog to the shared ring while credit is left.
+* Call it when credit may have returned, before the doorbell is rung.
+*
+* Parameters:
+*  tx: Sender state.
+*
+* Return:
+*  Number of messages moved
+*
+*******************************************************************************/
+uint32_t Cy_IPC_Credit_Flush(cy_stc_ipc_credit_tx_t *tx)
+{
+    const void *msg;
+    uint32_t moved = 0UL;
+
+    if (NULL == tx->backlog)
+    {
+        return 0UL;
+    }
+
+    while ((NULL != (msg = Cy_IPC_Ring_Peek(tx->backlog))) && ipc_credit_push(tx, msg))
+    {
+        (void)Cy_IPC_Ring_Pop(tx->backlog, NULL);
+        moved++;
+    }
+
+    return moved;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Credit_Available
+********************************************************************************
+* Summary:
+* Returns the number of credits left, read fresh from the credit block. The
+* value is a snapshot: the receiver may grant more at any time.
+*
+* Parameters:
+*  tx: Sender state.
+*
+* Return:
+*  Messages that can be sent without a stall
+*
+*******************************************************************************/
+uint32_t Cy_IPC_Credit_Available(cy_stc_ipc_credit_tx_t *tx)
+{
+    tx->granted = ipc_credit_load_granted(tx->credit);
+
+    return ((int32_t)(tx->granted - tx->sent) > 0) ? (tx->granted - tx->sent) : 0UL;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Credit_InitRx
+********************************************************************************
+* Summary:
+* Initializes the receiver of a credit block learned from the sender, before
+* anything was consumed from its ring, and grants the window.
+*
+* Parameters:
+*  rx: Receiver state.
+*  credit: Credit block shared with the sender.
+*  window: Messages the sender may have outstanding, at most the depth of
+*          its ring.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Credit_InitRx(cy_stc_ipc_credit_rx_t *rx, cy_stc_ipc_credit_t *credit, uint32_t window)
+{
+    rx->credit = credit;
+    rx->window = window;
+    rx->consumed = 0UL;
+    rx->grants = 0UL;
+    rx->stalls = 0UL;
+    rx->queued = 0UL;
+    rx->drops = 0UL;
+
+    ipc_credit_publish_rx(rx);
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Credit_Grant
+********************************************************************************
+* Summary:
+* Returns the credits of consumed messages to the sender and reads its
+* counters. Call it once per drain rather than per message, and before
+* the doorbell is released, so a sender woken by the release finds the
+* credit.
+*
+* Parameters:
+*  rx: Receiver state.
+*  consumed: Messages taken from the ring since the last grant.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Credit_Grant(cy_stc_ipc_credit_rx_t *rx, uint32_t consumed)
+{
+    if (0UL == consumed)
+    {
+        return;
+    }
+
+    rx->consumed += consumed;
+    ipc_credit_publish_rx(rx);
+
+    Cy_IPC_Port_InvalidateDCache(&rx->credit->stalls, IPC_PORT_CACHE_LINE);
+    rx->stalls = IPC_PORT_LOAD_RELAXED(&rx->credit->stalls);
+    rx->queued = IPC_PORT_LOAD_RELAXED(&rx->credit->queued);
+    rx->drops = IPC_PORT_LOAD_RELAXED(&rx->credit->drops);
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Credit_SetWindow
+********************************************************************************
+* Summary:
+* Changes the number of messages the sender may have outstanding. A smaller
+* window takes effect as the sender uses up the credits it already has.
+*
+* Parameters:
+*  rx: Receiver state.
+*  window: New window, at most the depth of the sender's ring.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Credit_SetWindow(cy_stc_ipc_credit_rx_t *rx, uint32_t window)
+{
+    rx->window = window;
+    ipc_credit_publish_rx(rx);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,186 @@
+/******************************************************************************
+* File Name:   ipc_dispatch.c
+*
+* Description: Receive-side dispatch table indexed by (clientID, pktType).
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "ipc_dispatch.h"
+
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Dispatch_Init
+********************************************************************************
+* Summary:
+* Clears all handlers and counters.
+*
+* Parameters:
+*  table: Dispatch table.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Dispatch_Init(cy_stc_ipc_dispatch_t *table)
+{
+    uint32_t client;
+    uint32_t type;
+
+    for (client = 0UL; client < CY_IPC_DISPATCH_MAX_CLIENTS; client++)
+    {
+        for (type = 0UL; type < CY_IPC_DISPATCH_MAX_TYPES; type++)
+        {
+            table->slot[client][type].context = NULL;
+            IPC_PORT_STORE_RELAXED(&table->slot[client][type].handler, NULL);
+        }
+    }
+
+    IPC_PORT_STORE_RELAXED(&table->dispatched, 0UL);
+    IPC_PORT_STORE_RELEASE(&table->unhandled, 0UL);
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Dispatch_Register
+********************************************************************************
+* Summary:
+* Installs the handler for one (clientID, pktType) pair, replacing any
+* previous one. Call it on the core that runs the dispatch; the pipe
+* interrupt may stay enabled. A message that arrives during the call is either
+* reported as unhandled or delivered to the new handler with its context.
+*
+* Parameters:
+*  table: Dispatch table.
+*  clientID: Client ID, below CY_IPC_DISPATCH_MAX_CLIENTS.
+*  pktType: Packet type, below CY_IPC_DISPATCH_MAX_TYPES.
+*  handler: Handler to install.
+*  context: Value passed to the handler.
+*
+* Return:
+*  CY_IPC_DISPATCH_SUCCESS or CY_IPC_DISPATCH_ERROR_BAD_PARAM
+*
+*******************************************************************************/
+cy_en_ipc_dispatch_status_t Cy_IPC_Dispatch_Register(cy_stc_ipc_dispatch_t *table, uint32_t clientID, uint32_t pktType,
+                                                     cy_ipc_dispatch_handler_t handler, void *context)
+{
+    cy_stc_ipc_dispatch_slot_t *slot;
+
+    if ((clientID >= CY_IPC_DISPATCH_MAX_CLIENTS) || (pktType >= CY_IPC_DISPATCH_MAX_TYPES) || (NULL == handler))
+    {
+        return CY_IPC_DISPATCH_ERROR_BAD_PARAM;
+    }
+
+    slot = &table->slot[clientID][pktType];
+
+    /* Retire the old handler before its context changes */
+    IPC_PORT_STORE_RELEASE(&slot->handler, NULL);
+    slot->context = context;
+    IPC_PORT_STORE_RELEASE(&slot->handler, handler);
+
+    return CY_IPC_DISPATCH_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Dispatch_Unregister
+********************************************************************************
+* Summary:
+* Removes the handler of one (clientID, pktType) pair. Once the call returns
+* on the core that runs the dispatch, the handler is no longer called.
+*
+* Parameters:
+*  table: Dispatch table.
+*  clientID: Client ID.
+*  pktType: Packet type.
+*
+* Return:
+*  CY_IPC_DISPATCH_SUCCESS or CY_IPC_DISPATCH_ERROR_BAD_PARAM
+*
+*******************************************************************************/
+cy_en_ipc_dispatch_status_t Cy_IPC_Dispatch_Unregister(cy_stc_ipc_dispatch_t *table, uint32_t clientID, uint32_t pktType)
+{
+    if ((clientID >= CY_IPC_DISPATCH_MAX_CLIENTS) || (pktType >= CY_IPC_DISPATCH_MAX_TYPES))
+    {
+        return CY_IPC_DISPATCH_ERROR_BAD_PARAM;
+    }
+
+    IPC_PORT_STORE_RELEASE(&table->slot[clientID][pktType].handler, NULL);
+
+    return CY_IPC_DISPATCH_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Dispatch_Message
+********************************************************************************
+* Summary:
+* Delivers one message to the handler registered for its clientID and
+* pktType, taken from the first message word. Runs on one core only, which is
+* the single writer of the counters. If that core also dispatches from thread
+* context, an interrupt between the two can lose a count.
+*
+* Parameters:
+*  table: Dispatch table.
+*  msgData: Received message.
+*
+* Return:
+*  true if a handler was called.
+*
+*******************************************************************************/
+bool Cy_IPC_Dispatch_Message(cy_stc_ipc_dispatch_t *table, uint32_t *msgData)
+{
+    uint32_t header = *msgData;
+    uint32_t clientID = (header & CY_IPC_DISPATCH_CLIENT_Msk) >> CY_IPC_DISPATCH_CLIENT_Pos;
+    uint32_t pktType = (header & CY_IPC_DISPATCH_TYPE_Msk) >> CY_IPC_DISPATCH_TYPE_Pos;
+    cy_stc_ipc_dispatch_slot_t *slot;
+    cy_ipc_dispatch_handler_t handler = NULL;
+
+    if ((clientID < CY_IPC_DISPATCH_MAX_CLIENTS) && (pktType < CY_IPC_DISPATCH_MAX_TYPES))
+    {
+        slot = &table->slot[clientID][pktType];
+        handler = IPC_PORT_LOAD_ACQUIRE(&slot->handler);
+        if (NULL != handler)
+        {
+            handler(msgData, slot->context);
+            IPC_PORT_STORE_RELAXED(&table->dispatched, IPC_PORT_LOAD_RELAXED(&table->dispatched) + 1UL);
+            return true;
+        }
+    }
+
+    IPC_PORT_STORE_RELAXED(&table->unhandled, IPC_PORT_LOAD_RELAXED(&table->unhandled) + 1UL);
+
+    return false;
+}
+
+/* [] END OF FILE */
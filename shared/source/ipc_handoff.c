@@ -0,0 +1,266 @@
+/******************************************************************************
+* File Name:   ipc_handoff.c
+*
+* Description: Cache-aware handoff of message buffers between cores. In
+*              cached mode the range a message occupies is widened to whole
+*              lines and written back or discarded; inside a non-cacheable
+*              pool only the memory barrier remains.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "ipc_handoff.h"
+
+
+/*******************************************************************************
+* Function Name: ipc_handoff_uncached
+********************************************************************************
+* Summary:
+* Tells whether [buf, buf + length) lies in the non-cacheable pool.
+*
+*******************************************************************************/
+static inline bool ipc_handoff_uncached(const cy_stc_ipc_handoff_t *handoff, const void *buf, uint32_t length)
+{
+    uintptr_t offset = (uintptr_t)buf - (uintptr_t)handoff->base;
+
+    return (CY_IPC_HANDOFF_NONCACHEABLE == handoff->mode) &&
+           ((uintptr_t)buf >= (uintptr_t)handoff->base) &&
+           (offset <= handoff->size) && (length <= (handoff->size - offset));
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Handoff_Init
+********************************************************************************
+* Summary:
+* Initializes the handoff context of the calling core. A cached pool must
+* own its lines. A non-cacheable pool must be a valid MPU region: a power
+* of two of at least CY_IPC_HANDOFF_MIN_UNCACHED bytes, aligned to its
+* size; it is mapped non-cacheable on the calling core here, so every core
+* that accesses it initializes its own context over it.
+*
+* Parameters:
+*  handoff: Handoff context.
+*  base: Pool, NULL for none in cached mode.
+*  size: Pool bytes, 0 without a pool.
+*  mode: Cache strategy of the pool.
+*
+* Return:
+*  CY_IPC_HANDOFF_SUCCESS, CY_IPC_HANDOFF_ERROR_ALIGN or
+*  CY_IPC_HANDOFF_ERROR_BAD_PARAM
+*
+*******************************************************************************/
+cy_en_ipc_handoff_status_t Cy_IPC_Handoff_Init(cy_stc_ipc_handoff_t *handoff, void *base, uint32_t size, cy_en_ipc_handoff_mode_t mode)
+{
+    if ((NULL == handoff) || ((NULL == base) != (0UL == size)) ||
+        ((CY_IPC_HANDOFF_CACHED != mode) && (CY_IPC_HANDOFF_NONCACHEABLE != mode)) ||
+        ((CY_IPC_HANDOFF_NONCACHEABLE == mode) && (NULL == base)))
+    {
+        return CY_IPC_HANDOFF_ERROR_BAD_PARAM;
+    }
+
+    if (CY_IPC_HANDOFF_NONCACHEABLE == mode)
+    {
+        if ((size < CY_IPC_HANDOFF_MIN_UNCACHED) || (0UL != (size & (size - 1UL))) ||
+            (0UL != ((uintptr_t)base & (size - 1UL))))
+        {
+            return CY_IPC_HANDOFF_ERROR_ALIGN;
+        }
+    }
+    else if ((NULL != base) && !Cy_IPC_Handoff_OwnsLines(base, size))
+    {
+        return CY_IPC_HANDOFF_ERROR_ALIGN;
+    }
+
+    handoff->mode = mode;
+    handoff->base = (uint8_t *)base;
+    handoff->size = size;
+    handoff->used = 0UL;
+
+    if (CY_IPC_HANDOFF_NONCACHEABLE == mode)
+    {
+        Cy_IPC_Port_SetNonCacheable(base, size);
+    }
+
+    return CY_IPC_HANDOFF_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Handoff_Alloc
+********************************************************************************
+* Summary:
+* Places a buffer in the pool. The buffer starts on a line and its size is
+* padded to whole lines, so it owns its lines in either mode. Buffers are
+* placed once, at start-up, and never freed.
+*
+* Parameters:
+*  handoff: Handoff context of the core that owns the pool.
+*  size: Buffer bytes.
+*
+* Return:
+*  Buffer, or NULL if the pool is exhausted or there is none.
+*
+*******************************************************************************/
+void *Cy_IPC_Handoff_Alloc(cy_stc_ipc_handoff_t *handoff, uint32_t size)
+{
+    uint32_t padded = CY_IPC_HANDOFF_SIZE(size);
+    void *buf;
+
+    if ((NULL == handoff->base) || (0UL == size) || (padded > (handoff->size - handoff->used)))
+    {
+        return NULL;
+    }
+
+    buf = &handoff->base[handoff->used];
+    handoff->used += padded;
+
+    return buf;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Handoff_Send
+********************************************************************************
+* Summary:
+* Makes a buffer written by the calling core visible to the receiver. Call
+* it after the last write and before the buffer is sent. Writes back the
+* lines the range touches, unless it lies in the non-cacheable pool.
+*
+* Parameters:
+*  handoff: Handoff context of the sender.
+*  buf: Buffer.
+*  length: Bytes written.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Handoff_Send(const cy_stc_ipc_handoff_t *handoff, const void *buf, uint32_t length)
+{
+    if (!ipc_handoff_uncached(handoff, buf, length))
+    {
+        Cy_IPC_Port_CleanDCache(buf, length);
+    }
+
+    /* The buffer is complete before the notification that follows */
+    IPC_PORT_FENCE_RELEASE();
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Handoff_Receive
+********************************************************************************
+* Summary:
+* Makes a received buffer readable on the calling core. Call it before the
+* first read. Discards the lines the range touches, unless it lies in the
+* non-cacheable pool; the receiver must not have written to those lines.
+*
+* Parameters:
+*  handoff: Handoff context of the receiver.
+*  buf: Buffer.
+*  length: Bytes to read.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Handoff_Receive(const cy_stc_ipc_handoff_t *handoff, const void *buf, uint32_t length)
+{
+    IPC_PORT_FENCE_ACQUIRE();
+
+    if (!ipc_handoff_uncached(handoff, buf, length))
+    {
+        Cy_IPC_Port_InvalidateDCache(buf, length);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Handoff_SendMsg
+********************************************************************************
+* Summary:
+* Cy_IPC_Handoff_Send() for a message in the format of ipc_msg.h, from its
+* header up to the end of its payload. Call it after Cy_IPC_Msg_Seal().
+*
+* Parameters:
+*  handoff: Handoff context of the sender.
+*  msg: Message, starting with cy_stc_ipc_msg_hdr_t.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Handoff_SendMsg(const cy_stc_ipc_handoff_t *handoff, const void *msg)
+{
+    Cy_IPC_Handoff_Send(handoff, msg, Cy_IPC_Msg_Size(msg));
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Handoff_ReceiveMsg
+********************************************************************************
+* Summary:
+* Cy_IPC_Handoff_Receive() for a message in the format of ipc_msg.h. The
+* header is made readable first, then the rest of the lines its length
+* covers, so each line is discarded once. A length beyond maxLength is
+* not trusted; Cy_IPC_Msg_Check() rejects such a message afterwards. The
+* pipe driver has read the first header word already: the client ID and
+* release mask of a message buffer must not change between sends.
+*
+* Parameters:
+*  handoff: Handoff context of the receiver.
+*  msg: Message, starting with cy_stc_ipc_msg_hdr_t.
+*  maxLength: Longest payload the receiver accepts.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Handoff_ReceiveMsg(const cy_stc_ipc_handoff_t *handoff, const void *msg, uint32_t maxLength)
+{
+    uintptr_t start = (uintptr_t)msg;
+    uintptr_t headEnd = (start + sizeof(cy_stc_ipc_msg_hdr_t) + CY_IPC_HANDOFF_ALIGN - 1UL) & ~(uintptr_t)(CY_IPC_HANDOFF_ALIGN - 1UL);
+    uint32_t size;
+
+    Cy_IPC_Handoff_Receive(handoff, msg, sizeof(cy_stc_ipc_msg_hdr_t));
+
+    size = Cy_IPC_Msg_Size(msg);
+    if (size > (CY_IPC_MSG_PAYLOAD_OFFSET + maxLength))
+    {
+        size = CY_IPC_MSG_PAYLOAD_OFFSET + maxLength;
+    }
+    if ((start + size) > headEnd)
+    {
+        Cy_IPC_Handoff_Receive(handoff, (const void *)headEnd, (uint32_t)((start + size) - headEnd));
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,190 @@
+/******************************************************************************
+* File Name:   ipc_msg.c
+*
+* Description: Header setup, CRC-16 and sequence gap detection of the IPC
+*              message format.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "ipc_msg.h"
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+#define IPC_MSG_CRC_INIT                (0xFFFFU)   /* CRC-16/CCITT-FALSE */
+#define IPC_MSG_SEQ_WINDOW              (0x8000UL)  /* Sequences ahead of the expected one count as a gap */
+
+/* CRC-16/CCITT, polynomial 0x1021, one entry per byte value */
+static const uint16_t ipcMsgCrcTable[256] =
+{
+    0x0000U, 0x1021U, 0x2042U, 0x3063U, 0x4084U, 0x50A5U, 0x60C6U, 0x70E7U,
+    0x8108U, 0x9129U, 0xA14AU, 0xB16BU, 0xC18CU, 0xD1ADU, 0xE1CEU, 0xF1EFU,
+    0x1231U, 0x0210U, 0x3273U, 0x2252U, 0x52B5U, 0x4294U, 0x72F7U, 0x62D6U,
+    0x9339U, 0x8318U, 0xB37BU, 0xA35AU, 0xD3BDU, 0xC39CU, 0xF3FFU, 0xE3DEU,
+    0x2462U, 0x3443U, 0x0420U, 0x1401U, 0x64E6U, 0x74C7U, 0x44A4U, 0x5485U,
+    0xA56AU, 0xB54BU, 0x8528U, 0x9509U, 0xE5EEU, 0xF5CFU, 0xC5ACU, 0xD58DU,
+    0x3653U, 0x2672U, 0x1611U, 0x0630U, 0x76D7U, 0x66F6U, 0x5695U, 0x46B4U,
+    0xB75BU, 0xA77AU, 0x9719U, 0x8738U, 0xF7DFU, 0xE7FEU, 0xD79DU, 0xC7BCU,
+    0x48C4U, 0x58E5U, 0x6886U, 0x78A7U, 0x0840U, 0x1861U, 0x2802U, 0x3823U,
+    0xC9CCU, 0xD9EDU, 0xE98EU, 0xF9AFU, 0x8948U, 0x9969U, 0xA90AU, 0xB92BU,
+    0x5AF5U, 0x4AD4U, 0x7AB7U, 0x6A96U, 0x1A71U, 0x0A50U, 0x3A33U, 0x2A12U,
+    0xDBFDU, 0xCBDCU, 0xFBBFU, 0xEB9EU, 0x9B79U, 0x8B58U, 0xBB3BU, 0xAB1AU,
+    0x6CA6U, 0x7C87U, 0x4CE4U, 0x5CC5U, 0x2C22U, 0x3C03U, 0x0C60U, 0x1C41U,
+    0xEDAEU, 0xFD8FU, 0xCDECU, 0xDDCDU, 0xAD2AU, 0xBD0BU, 0x8D68U, 0x9D49U,
+    0x7E97U, 0x6EB6U, 0x5ED5U, 0x4EF4U, 0x3E13U, 0x2E32U, 0x1E51U, 0x0E70U,
+    0xFF9FU, 0xEFBEU, 0xDFDDU, 0xCFFCU, 0xBF1BU, 0xAF3AU, 0x9F59U, 0x8F78U,
+    0x9188U, 0x81A9U, 0xB1CAU, 0xA1EBU, 0xD10CU, 0xC12DU, 0xF14EU, 0xE16FU,
+    0x1080U, 0x00A1U, 0x30C2U, 0x20E3U, 0x5004U, 0x4025U, 0x7046U, 0x6067U,
+    0x83B9U, 0x9398U, 0xA3FBU, 0xB3DAU, 0xC33DU, 0xD31CU, 0xE37FU, 0xF35EU,
+    0x02B1U, 0x1290U, 0x22F3U, 0x32D2U, 0x4235U, 0x5214U, 0x6277U, 0x7256U,
+    0xB5EAU, 0xA5CBU, 0x95A8U, 0x8589U, 0xF56EU, 0xE54FU, 0xD52CU, 0xC50DU,
+    0x34E2U, 0x24C3U, 0x14A0U, 0x0481U, 0x7466U, 0x6447U, 0x5424U, 0x4405U,
+    0xA7DBU, 0xB7FAU, 0x8799U, 0x97B8U, 0xE75FU, 0xF77EU, 0xC71DU, 0xD73CU,
+    0x26D3U, 0x36F2U, 0x0691U, 0x16B0U, 0x6657U, 0x7676U, 0x4615U, 0x5634U,
+    0xD94CU, 0xC96DU, 0xF90EU, 0xE92FU, 0x99C8U, 0x89E9U, 0xB98AU, 0xA9ABU,
+    0x5844U, 0x4865U, 0x7806U, 0x6827U, 0x18C0U, 0x08E1U, 0x3882U, 0x28A3U,
+    0xCB7DU, 0xDB5CU, 0xEB3FU, 0xFB1EU, 0x8BF9U, 0x9BD8U, 0xABBBU, 0xBB9AU,
+    0x4A75U, 0x5A54U, 0x6A37U, 0x7A16U, 0x0AF1U, 0x1AD0U, 0x2AB3U, 0x3A92U,
+    0xFD2EU, 0xED0FU, 0xDD6CU, 0xCD4DU, 0xBDAAU, 0xAD8BU, 0x9DE8U, 0x8DC9U,
+    0x7C26U, 0x6C07U, 0x5C64U, 0x4C45U, 0x3CA2U, 0x2C83U, 0x1CE0U, 0x0CC1U,
+    0xEF1FU, 0xFF3EU, 0xCF5DU, 0xDF7CU, 0xAF9BU, 0xBFBAU, 0x8FD9U, 0x9FF8U,
+    0x6E17U, 0x7E36U, 0x4E55U, 0x5E74U, 0x2E93U, 0x3EB2U, 0x0ED1U, 0x1EF0U
+};
+
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Msg_InitHeader
+********************************************************************************
+* Summary:
+* Fills in the header of a message. The sequence and CRC are set by
+* Cy_IPC_Msg_Seal() before every send.
+*
+* Parameters:
+*  hdr: Header to fill in.
+*  clientID: Client ID of the receiving endpoint.
+*  pktType: Message type.
+*  intrRelMask: Release mask, the interrupt of the sending endpoint.
+*  length: Payload bytes, at most CY_IPC_MSG_MAX_LENGTH.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Msg_InitHeader(cy_stc_ipc_msg_hdr_t *hdr, uint32_t clientID, uint32_t pktType, uint32_t intrRelMask, uint32_t length)
+{
+    hdr->clientID = (uint8_t)clientID;
+    hdr->pktType = (uint8_t)pktType;
+    hdr->intrRelMask = (uint16_t)intrRelMask;
+    hdr->version = CY_IPC_MSG_VERSION;
+    hdr->flags = (IPC_MSG_CRC_ENABLE) ? CY_IPC_MSG_FLAG_CRC : 0U;
+    hdr->length = (uint16_t)length;
+    hdr->sequence = 0U;
+    hdr->crc = 0U;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Msg_Crc16
+********************************************************************************
+* Summary:
+* Computes the CRC-16/CCITT-FALSE of a buffer.
+*
+* Parameters:
+*  data: Buffer.
+*  length: Bytes.
+*
+* Return:
+*  CRC
+*
+*******************************************************************************/
+uint16_t Cy_IPC_Msg_Crc16(const void *data, uint32_t length)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+    uint16_t crc = IPC_MSG_CRC_INIT;
+    uint32_t i;
+
+    for (i = 0UL; i < length; i++)
+    {
+        crc = (uint16_t)((crc << 8) ^ ipcMsgCrcTable[(uint8_t)(crc >> 8) ^ bytes[i]]);
+    }
+
+    return crc;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Msg_CheckSequence
+********************************************************************************
+* Summary:
+* Checks the sequence of a received message against its stream. The first
+* message of a stream sets the expected sequence. A sequence ahead of the
+* expected one is a gap; the missing messages are counted as lost and the
+* stream continues from the message. A sequence behind it is stale.
+*
+* Parameters:
+*  rx: Receiver side of the stream.
+*  sequence: Sequence of the message.
+*
+* Return:
+*  CY_IPC_MSG_SUCCESS, CY_IPC_MSG_GAP or CY_IPC_MSG_ERROR_STALE
+*
+*******************************************************************************/
+cy_en_ipc_msg_status_t Cy_IPC_Msg_CheckSequence(cy_stc_ipc_msg_rx_t *rx, uint32_t sequence)
+{
+    uint32_t ahead = (sequence - rx->expected) & 0xFFFFUL;
+
+    if (!rx->synced)
+    {
+        rx->synced = true;
+        ahead = 0UL;
+    }
+    else if (ahead >= IPC_MSG_SEQ_WINDOW)
+    {
+        rx->stale++;
+        return CY_IPC_MSG_ERROR_STALE;
+    }
+
+    rx->expected = (uint16_t)(sequence + 1UL);
+    if (0UL != ahead)
+    {
+        rx->gaps++;
+        rx->lost += ahead;
+        return CY_IPC_MSG_GAP;
+    }
+
+    return CY_IPC_MSG_SUCCESS;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,347 @@
+/******************************************************************************
+* File Name:   ipc_pool.c
+*
+* Description: Fixed-block pool allocator for inter-core messages.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "ipc_pool.h"
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+#define IPC_POOL_NIL                    (0xFFFFUL)  /* End of the free list */
+#define IPC_POOL_INDEX_Msk              (0x0000FFFFUL)
+#define IPC_POOL_TAG_Pos                (16UL)
+
+
+/*******************************************************************************
+* Function Name: ipc_pool_link
+********************************************************************************
+* Summary:
+* Returns the free list link stored in the first word of a free block. The
+* link is not cache maintained, see cy_stc_ipc_pool_t.
+*
+*******************************************************************************/
+static inline cy_ipc_atomic32_t *ipc_pool_link(const cy_stc_ipc_pool_t *pool, uint32_t index)
+{
+    return (cy_ipc_atomic32_t *)(void *)&pool->storage[index * pool->stride];
+}
+
+/*******************************************************************************
+* Function Name: ipc_pool_index
+********************************************************************************
+* Summary:
+* Converts a block pointer into its index, or IPC_POOL_NIL if the pointer is
+* not the start of a block of this pool.
+*
+*******************************************************************************/
+static inline uint32_t ipc_pool_index(const cy_stc_ipc_pool_t *pool, const void *block)
+{
+    uintptr_t offset = (uintptr_t)block - (uintptr_t)pool->storage;
+
+    if (((uintptr_t)block < (uintptr_t)pool->storage) ||
+        (0UL != (offset % pool->stride)) ||
+        ((offset / pool->stride) >= pool->blockCount))
+    {
+        return IPC_POOL_NIL;
+    }
+
+    return (uint32_t)(offset / pool->stride);
+}
+
+/*******************************************************************************
+* Function Name: ipc_pool_push
+********************************************************************************
+* Summary:
+* Puts a block on the free list.
+*
+*******************************************************************************/
+static void ipc_pool_push(cy_stc_ipc_pool_t *pool, uint32_t index)
+{
+    uint32_t head = IPC_PORT_LOAD_ACQUIRE(&pool->freeHead);
+    uint32_t next;
+
+    do
+    {
+        IPC_PORT_STORE_RELAXED(ipc_pool_link(pool, index), head & IPC_POOL_INDEX_Msk);
+        next = ((head & ~IPC_POOL_INDEX_Msk) + (1UL << IPC_POOL_TAG_Pos)) | index;
+    } while (!Cy_IPC_Port_CompareExchange(&pool->freeHead, &head, next));
+}
+
+/*******************************************************************************
+* Function Name: ipc_pool_pop
+********************************************************************************
+* Summary:
+* Takes a block off the free list. The tag in the upper half of freeHead
+* changes on every update, which defeats the ABA problem when a block is
+* popped and pushed back between the read of its link and the exchange.
+*
+*******************************************************************************/
+static uint32_t ipc_pool_pop(cy_stc_ipc_pool_t *pool)
+{
+    uint32_t head = IPC_PORT_LOAD_ACQUIRE(&pool->freeHead);
+    uint32_t index;
+    uint32_t next;
+
+    do
+    {
+        index = head & IPC_POOL_INDEX_Msk;
+        if (IPC_POOL_NIL == index)
+        {
+            break;
+        }
+        next = ((head & ~IPC_POOL_INDEX_Msk) + (1UL << IPC_POOL_TAG_Pos)) |
+               IPC_PORT_LOAD_RELAXED(ipc_pool_link(pool, index));
+    } while (!Cy_IPC_Port_CompareExchange(&pool->freeHead, &head, next));
+
+    return index;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Pool_Init
+********************************************************************************
+* Summary:
+* Initializes a pool with all blocks free. Must be called before any core
+* uses the pool.
+*
+* Parameters:
+*  pool: Pool control block.
+*  config: Storage and geometry of the pool.
+*
+* Return:
+*  CY_IPC_POOL_SUCCESS or CY_IPC_POOL_ERROR_BAD_PARAM
+*
+*******************************************************************************/
+cy_en_ipc_pool_status_t Cy_IPC_Pool_Init(cy_stc_ipc_pool_t *pool, const cy_stc_ipc_pool_config_t *config)
+{
+    uint32_t i;
+
+    if ((NULL == pool) || (NULL == config) || (NULL == config->storage) ||
+        (0UL != ((uintptr_t)config->storage % IPC_PORT_CACHE_LINE)) ||
+        (config->blockSize < sizeof(uint32_t)) ||
+        (0UL == config->blockCount) || (config->blockCount > CY_IPC_POOL_MAX_BLOCKS))
+    {
+        return CY_IPC_POOL_ERROR_BAD_PARAM;
+    }
+
+    pool->hasRemote = (NULL != config->remoteBuf);
+    if (pool->hasRemote)
+    {
+        if ((config->remoteDepth < config->blockCount) ||
+            (CY_IPC_RING_SUCCESS != Cy_IPC_Ring_Init(&pool->remote, config->remoteBuf, sizeof(uint32_t), config->remoteDepth)))
+        {
+            return CY_IPC_POOL_ERROR_BAD_PARAM;
+        }
+    }
+
+    pool->storage = (uint8_t *)config->storage;
+    pool->stride = CY_IPC_POOL_BLOCK_STRIDE(config->blockSize);
+    pool->blockCount = config->blockCount;
+
+    /* Chain the blocks in address order */
+    for (i = 0UL; i < pool->blockCount; i++)
+    {
+        IPC_PORT_STORE_RELAXED(ipc_pool_link(pool, i), ((i + 1UL) < pool->blockCount) ? (i + 1UL) : IPC_POOL_NIL);
+    }
+
+    IPC_PORT_STORE_RELAXED(&pool->inUse, 0UL);
+    IPC_PORT_STORE_RELAXED(&pool->highWater, 0UL);
+    IPC_PORT_STORE_RELAXED(&pool->allocFail, 0UL);
+    IPC_PORT_STORE_RELEASE(&pool->freeHead, 0UL);
+
+    Cy_IPC_Port_CleanDCache(pool->storage, pool->stride * pool->blockCount);
+    Cy_IPC_Port_CleanDCache(pool, sizeof(*pool));
+
+    return CY_IPC_POOL_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Pool_Alloc
+********************************************************************************
+* Summary:
+* Allocates one block. If the free list is empty, blocks returned through the
+* remote free ring are reclaimed first. Callable from thread and interrupt
+* context. With a remote free ring, allocations must come from a single
+* context (or be serialized by the caller), because the ring has one consumer.
+*
+* Parameters:
+*  pool: Pool control block.
+*
+* Return:
+*  Pointer to the block, or NULL if the pool is exhausted.
+*
+*******************************************************************************/
+void *Cy_IPC_Pool_Alloc(cy_stc_ipc_pool_t *pool)
+{
+    uint32_t index = ipc_pool_pop(pool);
+    uint32_t used;
+    uint32_t high;
+
+    if ((IPC_POOL_NIL == index) && (0UL != Cy_IPC_Pool_Reclaim(pool)))
+    {
+        index = ipc_pool_pop(pool);
+    }
+
+    if (IPC_POOL_NIL == index)
+    {
+        (void)Cy_IPC_Port_FetchAdd(&pool->allocFail, 1UL);
+        return NULL;
+    }
+
+    used = Cy_IPC_Port_FetchAdd(&pool->inUse, 1UL) + 1UL;
+    high = IPC_PORT_LOAD_RELAXED(&pool->highWater);
+    while ((used > high) && !Cy_IPC_Port_CompareExchange(&pool->highWater, &high, used))
+    {
+    }
+
+    return &pool->storage[index * pool->stride];
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Pool_Free
+********************************************************************************
+* Summary:
+* Returns a block to the free list. Callable from thread and interrupt context
+* on cores with exclusive access instructions.
+*
+* Parameters:
+*  pool: Pool control block.
+*  block: Block returned by Cy_IPC_Pool_Alloc().
+*
+* Return:
+*  CY_IPC_POOL_SUCCESS or CY_IPC_POOL_ERROR_BAD_PARAM
+*
+*******************************************************************************/
+cy_en_ipc_pool_status_t Cy_IPC_Pool_Free(cy_stc_ipc_pool_t *pool, void *block)
+{
+    uint32_t index = ipc_pool_index(pool, block);
+
+    if (IPC_POOL_NIL == index)
+    {
+        return CY_IPC_POOL_ERROR_BAD_PARAM;
+    }
+
+    ipc_pool_push(pool, index);
+    (void)Cy_IPC_Port_FetchAdd(&pool->inUse, (uint32_t)-1);
+
+    return CY_IPC_POOL_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Pool_FreeRemote
+********************************************************************************
+* Summary:
+* Returns a block through the remote free ring. Intended for the core without
+* exclusive access instructions; only one core may call it per pool.
+*
+* Parameters:
+*  pool: Pool control block.
+*  block: Block returned by Cy_IPC_Pool_Alloc().
+*
+* Return:
+*  CY_IPC_POOL_SUCCESS, CY_IPC_POOL_ERROR_BAD_PARAM or CY_IPC_POOL_ERROR_FULL
+*
+*******************************************************************************/
+cy_en_ipc_pool_status_t Cy_IPC_Pool_FreeRemote(cy_stc_ipc_pool_t *pool, void *block)
+{
+    uint32_t index = ipc_pool_index(pool, block);
+
+    if ((IPC_POOL_NIL == index) || !pool->hasRemote)
+    {
+        return CY_IPC_POOL_ERROR_BAD_PARAM;
+    }
+
+    return (CY_IPC_RING_SUCCESS == Cy_IPC_Ring_Push(&pool->remote, &index)) ? CY_IPC_POOL_SUCCESS : CY_IPC_POOL_ERROR_FULL;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Pool_Reclaim
+********************************************************************************
+* Summary:
+* Moves every block waiting in the remote free ring back to the free list.
+* Called by Cy_IPC_Pool_Alloc() on an empty free list; the allocating core may
+* also call it from an idle loop.
+*
+* Parameters:
+*  pool: Pool control block.
+*
+* Return:
+*  Number of blocks reclaimed.
+*
+*******************************************************************************/
+uint32_t Cy_IPC_Pool_Reclaim(cy_stc_ipc_pool_t *pool)
+{
+    uint32_t index;
+    uint32_t count = 0UL;
+
+    if (pool->hasRemote)
+    {
+        while (CY_IPC_RING_SUCCESS == Cy_IPC_Ring_Pop(&pool->remote, &index))
+        {
+            ipc_pool_push(pool, index);
+            count++;
+        }
+        (void)Cy_IPC_Port_FetchAdd(&pool->inUse, (uint32_t)0UL - count);
+    }
+
+    return count;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Pool_GetStats
+********************************************************************************
+* Summary:
+* Reads the usage counters. Blocks waiting in the remote free ring still
+* count as in use.
+*
+* Parameters:
+*  pool: Pool control block.
+*  stats: Receives the counters.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Pool_GetStats(cy_stc_ipc_pool_t *pool, cy_stc_ipc_pool_stats_t *stats)
+{
+    stats->inUse = IPC_PORT_LOAD_RELAXED(&pool->inUse);
+    stats->highWater = IPC_PORT_LOAD_RELAXED(&pool->highWater);
+    stats->allocFail = IPC_PORT_LOAD_RELAXED(&pool->allocFail);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,446 @@
+/******************************************************************************
+* File Name:   ipc_pubsub.c
+*
+* Description: Topic-based publish/subscribe between cores. Every line of
+*              the topic has a single writer; the publisher derives the
+*              reference count of a slot from the release counts of the
+*              subscribers before it reuses the slot.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "ipc_pubsub.h"
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+/* Publisher line: from published up to the first subscriber line */
+#define IPC_PUBSUB_PUBLISHER_LINE_SIZE  (offsetof(cy_stc_ipc_pubsub_topic_t, subscriber) - \
+                                         offsetof(cy_stc_ipc_pubsub_topic_t, published))
+
+
+/*******************************************************************************
+* Function Name: ipc_pubsub_slot
+********************************************************************************
+* Summary:
+* Returns the slot that holds publication seq.
+*
+*******************************************************************************/
+static inline cy_stc_ipc_pubsub_slot_t *ipc_pubsub_slot(const cy_stc_ipc_pubsub_topic_t *topic, uint32_t seq)
+{
+    return (cy_stc_ipc_pubsub_slot_t *)(void *)&topic->storage[(seq & (topic->depth - 1UL)) * topic->stride];
+}
+
+/*******************************************************************************
+* Function Name: ipc_pubsub_publish_line
+********************************************************************************
+* Summary:
+* Writes back the publisher line for the subscribers.
+*
+*******************************************************************************/
+static inline void ipc_pubsub_publish_line(cy_stc_ipc_pubsub_topic_t *topic)
+{
+    Cy_IPC_Port_CleanDCache(&topic->published, IPC_PUBSUB_PUBLISHER_LINE_SIZE);
+}
+
+/*******************************************************************************
+* Function Name: ipc_pubsub_admit
+********************************************************************************
+* Summary:
+* Takes the subscriptions requested since the last claim. A new subscriber
+* starts with the publication about to be made; older slots are not
+* referenced by it.
+*
+*******************************************************************************/
+static void ipc_pubsub_admit(cy_stc_ipc_pubsub_topic_t *topic)
+{
+    uint32_t active = IPC_PORT_LOAD_RELAXED(&topic->active);
+    uint32_t admitted = active;
+    uint32_t request;
+    uint32_t i;
+
+    for (i = 0UL; i < CY_IPC_PUBSUB_MAX_SUBSCRIBERS; i++)
+    {
+        if (0UL != (active & (1UL << i)))
+        {
+            continue;
+        }
+
+        Cy_IPC_Port_InvalidateDCache(&topic->subscriber[i], sizeof(topic->subscriber[i]));
+        request = IPC_PORT_LOAD_ACQUIRE(&topic->subscriber[i].request);
+        if (0UL != request)
+        {
+            topic->first[i] = IPC_PORT_LOAD_RELAXED(&topic->published);
+            topic->notify[i] = request;
+            admitted |= 1UL << i;
+        }
+    }
+
+    if (admitted != active)
+    {
+        IPC_PORT_STORE_RELEASE(&topic->active, admitted);
+        ipc_pubsub_publish_line(topic);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_PubSub_Init
+********************************************************************************
+* Summary:
+* Initializes a topic without subscribers. Must be called by the publisher
+* before any subscriber learns the topic.
+*
+* Parameters:
+*  topic: Topic control block.
+*  storage: CY_IPC_PUBSUB_STORAGE_SIZE(payloadSize, depth) bytes, cache line
+*           aligned.
+*  payloadSize: Largest payload of a publication in bytes.
+*  depth: Slots, a power of two. A publication that a subscriber has not
+*         released holds its slot, so depth publications can be in flight.
+*
+* Return:
+*  CY_IPC_PUBSUB_SUCCESS, or CY_IPC_PUBSUB_ERROR_BAD_PARAM
+*
+*******************************************************************************/
+cy_en_ipc_pubsub_status_t Cy_IPC_PubSub_Init(cy_stc_ipc_pubsub_topic_t *topic, void *storage,
+                                             uint32_t payloadSize, uint32_t depth)
+{
+    uint32_t i;
+
+    if ((NULL == topic) || (NULL == storage) ||
+        (0UL != ((uintptr_t)storage & (IPC_PORT_CACHE_LINE - 1UL))) ||
+        (0UL == depth) || (0UL != (depth & (depth - 1UL))))
+    {
+        return CY_IPC_PUBSUB_ERROR_BAD_PARAM;
+    }
+
+    topic->storage = (uint8_t *)storage;
+    topic->stride = CY_IPC_PUBSUB_SLOT_STRIDE(payloadSize);
+    topic->depth = depth;
+    topic->payloadSize = payloadSize;
+
+    IPC_PORT_STORE_RELAXED(&topic->published, 0UL);
+    IPC_PORT_STORE_RELAXED(&topic->active, 0UL);
+    IPC_PORT_STORE_RELAXED(&topic->stalls, 0UL);
+    topic->stalled = false;
+    topic->claimed = false;
+    for (i = 0UL; i < CY_IPC_PUBSUB_MAX_SUBSCRIBERS; i++)
+    {
+        topic->first[i] = 0UL;
+        topic->notify[i] = 0UL;
+        IPC_PORT_STORE_RELAXED(&topic->subscriber[i].request, 0UL);
+        IPC_PORT_STORE_RELAXED(&topic->subscriber[i].released, 0UL);
+    }
+
+    Cy_IPC_Port_CleanDCache(topic, sizeof(*topic));
+
+    return CY_IPC_PUBSUB_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_PubSub_Claim
+********************************************************************************
+* Summary:
+* Returns the payload buffer of the next publication. The publisher writes
+* the payload in place, then calls Cy_IPC_PubSub_Publish(). The slot is
+* free once no active subscriber references the publication it held; until
+* then nothing is claimed, and the first claim of every stall is counted.
+* Subscriptions requested meanwhile are taken here. Claiming again before
+* the publish returns the same buffer.
+*
+* Parameters:
+*  topic: Topic, called by its publisher only.
+*
+* Return:
+*  Payload buffer of payloadSize bytes, or NULL while the slot is referenced
+*
+*******************************************************************************/
+void *Cy_IPC_PubSub_Claim(cy_stc_ipc_pubsub_topic_t *topic)
+{
+    uint32_t published = IPC_PORT_LOAD_RELAXED(&topic->published);
+
+    if (!topic->claimed)
+    {
+        ipc_pubsub_admit(topic);
+
+        /* The slot last held the publication depth before this one */
+        if (0UL != Cy_IPC_PubSub_GetRefs(topic, published - topic->depth))
+        {
+            if (!topic->stalled)
+            {
+                topic->stalled = true;
+                IPC_PORT_STORE_RELAXED(&topic->stalls, IPC_PORT_LOAD_RELAXED(&topic->stalls) + 1UL);
+                ipc_pubsub_publish_line(topic);
+            }
+            return NULL;
+        }
+
+        topic->stalled = false;
+        topic->claimed = true;
+    }
+
+    return ipc_pubsub_slot(topic, published) + 1;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_PubSub_Publish
+********************************************************************************
+* Summary:
+* Publishes the claimed buffer to every active subscriber. The caller then
+* notifies the subscribers, with one IPC notify event on the interrupts of
+* notifyMask.
+*
+* Parameters:
+*  topic: Topic, called by its publisher only.
+*  length: Payload bytes written to the claimed buffer, at most payloadSize.
+*  notifyMask: Receives the IPC interrupt mask of the active subscribers.
+*              Can be NULL.
+*
+* Return:
+*  CY_IPC_PUBSUB_SUCCESS, CY_IPC_PUBSUB_ERROR_NOT_CLAIMED or
+*  CY_IPC_PUBSUB_ERROR_BAD_PARAM
+*
+*******************************************************************************/
+cy_en_ipc_pubsub_status_t Cy_IPC_PubSub_Publish(cy_stc_ipc_pubsub_topic_t *topic, uint32_t length, uint32_t *notifyMask)
+{
+    uint32_t published = IPC_PORT_LOAD_RELAXED(&topic->published);
+    cy_stc_ipc_pubsub_slot_t *slot;
+    uint32_t active;
+    uint32_t mask = 0UL;
+    uint32_t i;
+
+    if (!topic->claimed)
+    {
+        return CY_IPC_PUBSUB_ERROR_NOT_CLAIMED;
+    }
+    if (length > topic->payloadSize)
+    {
+        return CY_IPC_PUBSUB_ERROR_BAD_PARAM;
+    }
+
+    slot = ipc_pubsub_slot(topic, published);
+    slot->seq = published;
+    slot->length = length;
+    Cy_IPC_Port_CleanDCache(slot, sizeof(*slot) + length);
+
+    topic->claimed = false;
+    IPC_PORT_STORE_RELEASE(&topic->published, published + 1UL);
+    ipc_pubsub_publish_line(topic);
+
+    if (NULL != notifyMask)
+    {
+        active = IPC_PORT_LOAD_RELAXED(&topic->active);
+        for (i = 0UL; i < CY_IPC_PUBSUB_MAX_SUBSCRIBERS; i++)
+        {
+            if (0UL != (active & (1UL << i)))
+            {
+                mask |= topic->notify[i];
+            }
+        }
+        *notifyMask = mask;
+    }
+
+    return CY_IPC_PUBSUB_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_PubSub_GetRefs
+********************************************************************************
+* Summary:
+* Returns the reference count of a publication: the active subscribers that
+* started at or before it and have not released it yet.
+*
+* Parameters:
+*  topic: Topic, called by its publisher only.
+*  seq: Publication number.
+*
+* Return:
+*  Subscribers holding the publication, 0 once its slot can be reused
+*
+*******************************************************************************/
+uint32_t Cy_IPC_PubSub_GetRefs(cy_stc_ipc_pubsub_topic_t *topic, uint32_t seq)
+{
+    uint32_t active = IPC_PORT_LOAD_RELAXED(&topic->active);
+    uint32_t refs = 0UL;
+    uint32_t released;
+    uint32_t i;
+
+    for (i = 0UL; i < CY_IPC_PUBSUB_MAX_SUBSCRIBERS; i++)
+    {
+        if ((0UL == (active & (1UL << i))) || ((int32_t)(seq - topic->first[i]) < 0))
+        {
+            continue;
+        }
+
+        Cy_IPC_Port_InvalidateDCache(&topic->subscriber[i], sizeof(topic->subscriber[i]));
+        released = IPC_PORT_LOAD_ACQUIRE(&topic->subscriber[i].released);
+
+        /* A count left from an earlier subscription lags behind the first publication */
+        if ((int32_t)(released - topic->first[i]) < 0)
+        {
+            released = topic->first[i];
+        }
+        if ((int32_t)(seq - released) >= 0)
+        {
+            refs++;
+        }
+    }
+
+    return refs;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_PubSub_Subscribe
+********************************************************************************
+* Summary:
+* Requests a subscription. The publisher takes it with its next claim; from
+* that publication on, the subscriber is notified on the interrupts of
+* notifyMask and every publication waits for its release.
+*
+* Parameters:
+*  sub: Subscriber state.
+*  topic: Topic, as learned from the publisher.
+*  index: Subscriber slot of the topic, 0 .. CY_IPC_PUBSUB_MAX_SUBSCRIBERS - 1,
+*         used by this subscriber only.
+*  notifyMask: IPC interrupt mask of the subscriber's endpoint.
+*
+* Return:
+*  CY_IPC_PUBSUB_SUCCESS, or CY_IPC_PUBSUB_ERROR_BAD_PARAM
+*
+*******************************************************************************/
+cy_en_ipc_pubsub_status_t Cy_IPC_PubSub_Subscribe(cy_stc_ipc_pubsub_sub_t *sub, cy_stc_ipc_pubsub_topic_t *topic,
+                                                  uint32_t index, uint32_t notifyMask)
+{
+    if ((NULL == topic) || (index >= CY_IPC_PUBSUB_MAX_SUBSCRIBERS) || (0UL == notifyMask))
+    {
+        return CY_IPC_PUBSUB_ERROR_BAD_PARAM;
+    }
+
+    sub->topic = topic;
+    sub->index = index;
+    sub->active = false;
+    sub->next = 0UL;
+    sub->received = 0UL;
+
+    /* The control block was written by the publisher before it was handed out */
+    Cy_IPC_Port_InvalidateDCache(topic, sizeof(*topic));
+
+    IPC_PORT_STORE_RELEASE(&topic->subscriber[index].request, notifyMask);
+    Cy_IPC_Port_CleanDCache(&topic->subscriber[index], sizeof(topic->subscriber[index]));
+
+    return CY_IPC_PUBSUB_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_PubSub_Receive
+********************************************************************************
+* Summary:
+* Returns the oldest publication the subscriber has not released, in place.
+* It stays valid until Cy_IPC_PubSub_Release(); receiving again before that
+* returns the same one.
+*
+* Parameters:
+*  sub: Subscriber state.
+*  length: Receives the payload length. Can be NULL.
+*
+* Return:
+*  Payload, or NULL if there is no new publication or the subscription was
+*  not taken yet
+*
+*******************************************************************************/
+const void *Cy_IPC_PubSub_Receive(cy_stc_ipc_pubsub_sub_t *sub, uint32_t *length)
+{
+    cy_stc_ipc_pubsub_topic_t *topic = sub->topic;
+    cy_stc_ipc_pubsub_slot_t *slot;
+
+    if (NULL == topic)
+    {
+        return NULL;
+    }
+
+    Cy_IPC_Port_InvalidateDCache(&topic->published, IPC_PUBSUB_PUBLISHER_LINE_SIZE);
+
+    if (!sub->active)
+    {
+        if (0UL == (IPC_PORT_LOAD_ACQUIRE(&topic->active) & (1UL << sub->index)))
+        {
+            return NULL;
+        }
+        sub->next = topic->first[sub->index];
+        sub->active = true;
+    }
+
+    if (IPC_PORT_LOAD_ACQUIRE(&topic->published) == sub->next)
+    {
+        return NULL;
+    }
+
+    slot = ipc_pubsub_slot(topic, sub->next);
+    Cy_IPC_Port_InvalidateDCache(slot, topic->stride);
+    if (NULL != length)
+    {
+        *length = slot->length;
+    }
+
+    return slot + 1;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_PubSub_Release
+********************************************************************************
+* Summary:
+* Releases the publication returned by Cy_IPC_PubSub_Receive(). The payload
+* must not be accessed afterwards: once the last subscriber released it, the
+* publisher reuses the slot.
+*
+* Parameters:
+*  sub: Subscriber state.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_PubSub_Release(cy_stc_ipc_pubsub_sub_t *sub)
+{
+    cy_stc_ipc_pubsub_line_t *line = &sub->topic->subscriber[sub->index];
+
+    sub->next++;
+    sub->received++;
+    IPC_PORT_STORE_RELEASE(&line->released, sub->next);
+    Cy_IPC_Port_CleanDCache(line, sizeof(*line));
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,252 @@
+/******************************************************************************
+* File Name:   ipc_ring.c
+*
+* Description: Lock-free single-producer/single-consumer ring buffer used as
+*              the shared-memory transport behind an IPC pipe.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+#include "ipc_ring.h"
+
+
+/*******************************************************************************
+* Function Name: ipc_ring_load_head
+********************************************************************************
+* Summary:
+* Reads the producer index as published by the other core.
+*
+*******************************************************************************/
+static inline uint32_t ipc_ring_load_head(cy_stc_ipc_ring_t *ring)
+{
+    Cy_IPC_Port_InvalidateDCache(&ring->head, sizeof(ring->head));
+    return IPC_PORT_LOAD_ACQUIRE(&ring->head);
+}
+
+/*******************************************************************************
+* Function Name: ipc_ring_load_tail
+********************************************************************************
+* Summary:
+* Reads the consumer index as published by the other core.
+*
+*******************************************************************************/
+static inline uint32_t ipc_ring_load_tail(cy_stc_ipc_ring_t *ring)
+{
+    Cy_IPC_Port_InvalidateDCache(&ring->tail, sizeof(ring->tail));
+    return IPC_PORT_LOAD_ACQUIRE(&ring->tail);
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Ring_Init
+********************************************************************************
+* Summary:
+* Initializes an empty ring over the caller-provided storage. Must be called
+* by one core before the other core accesses the ring.
+*
+* Parameters:
+*  ring: Ring control block.
+*  buffer: CY_IPC_RING_STORAGE_SIZE(elemSize, depth) bytes, cache line
+*          aligned. The consumer invalidates slots by whole lines, so a
+*          buffer that shares a line with other data corrupts that data.
+*  elemSize: Size of one element in bytes.
+*  depth: Number of elements, must be a power of two.
+*
+* Return:
+*  CY_IPC_RING_SUCCESS or CY_IPC_RING_ERROR_BAD_PARAM
+*
+*******************************************************************************/
+cy_en_ipc_ring_status_t Cy_IPC_Ring_Init(cy_stc_ipc_ring_t *ring, void *buffer, uint32_t elemSize, uint32_t depth)
+{
+    if ((NULL == ring) || (NULL == buffer) ||
+        (0UL != ((uintptr_t)buffer & (IPC_PORT_CACHE_LINE - 1UL))) || (0UL == elemSize) ||
+        (0UL == depth) || (0UL != (depth & (depth - 1UL))))
+    {
+        return CY_IPC_RING_ERROR_BAD_PARAM;
+    }
+
+    ring->buffer = (uint8_t *)buffer;
+    ring->elemSize = elemSize;
+    ring->mask = depth - 1UL;
+    ring->tailCache = 0UL;
+    ring->headCache = 0UL;
+    IPC_PORT_STORE_RELAXED(&ring->tail, 0UL);
+    IPC_PORT_STORE_RELEASE(&ring->head, 0UL);
+
+    Cy_IPC_Port_CleanDCache(ring, sizeof(*ring));
+
+    return CY_IPC_RING_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Ring_Push
+********************************************************************************
+* Summary:
+* Copies one element into the ring. Producer side only.
+*
+* Parameters:
+*  ring: Ring control block.
+*  elem: Element of ring->elemSize bytes.
+*
+* Return:
+*  CY_IPC_RING_SUCCESS or CY_IPC_RING_ERROR_FULL
+*
+*******************************************************************************/
+cy_en_ipc_ring_status_t Cy_IPC_Ring_Push(cy_stc_ipc_ring_t *ring, const void *elem)
+{
+    uint32_t head = IPC_PORT_LOAD_RELAXED(&ring->head);
+    uint8_t *slot;
+
+    /* Only refresh the shared tail when the cached copy says the ring is full */
+    if ((head - ring->tailCache) > ring->mask)
+    {
+        ring->tailCache = ipc_ring_load_tail(ring);
+        if ((head - ring->tailCache) > ring->mask)
+        {
+            return CY_IPC_RING_ERROR_FULL;
+        }
+    }
+
+    slot = &ring->buffer[(head & ring->mask) * ring->elemSize];
+    (void)memcpy(slot, elem, ring->elemSize);
+    Cy_IPC_Port_CleanDCache(slot, ring->elemSize);
+
+    /* Publish the element */
+    IPC_PORT_STORE_RELEASE(&ring->head, head + 1UL);
+    Cy_IPC_Port_CleanDCache(&ring->head, sizeof(ring->head));
+
+    return CY_IPC_RING_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Ring_Pop
+********************************************************************************
+* Summary:
+* Copies the oldest element out of the ring. Consumer side only.
+*
+* Parameters:
+*  ring: Ring control block.
+*  elem: Destination of ring->elemSize bytes, NULL to discard the element.
+*
+* Return:
+*  CY_IPC_RING_SUCCESS or CY_IPC_RING_ERROR_EMPTY
+*
+*******************************************************************************/
+cy_en_ipc_ring_status_t Cy_IPC_Ring_Pop(cy_stc_ipc_ring_t *ring, void *elem)
+{
+    uint32_t tail = IPC_PORT_LOAD_RELAXED(&ring->tail);
+    const uint8_t *slot;
+
+    /* Only refresh the shared head when the cached copy says the ring is empty */
+    if (tail == ring->headCache)
+    {
+        ring->headCache = ipc_ring_load_head(ring);
+        if (tail == ring->headCache)
+        {
+            return CY_IPC_RING_ERROR_EMPTY;
+        }
+    }
+
+    if (NULL != elem)
+    {
+        slot = &ring->buffer[(tail & ring->mask) * ring->elemSize];
+        Cy_IPC_Port_InvalidateDCache(slot, ring->elemSize);
+        (void)memcpy(elem, slot, ring->elemSize);
+    }
+
+    /* Hand the slot back to the producer */
+    IPC_PORT_STORE_RELEASE(&ring->tail, tail + 1UL);
+    Cy_IPC_Port_CleanDCache(&ring->tail, sizeof(ring->tail));
+
+    return CY_IPC_RING_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Ring_Peek
+********************************************************************************
+* Summary:
+* Returns the oldest element in place, without taking it out of the ring.
+* The element stays valid until it is popped. Consumer side only.
+*
+* Parameters:
+*  ring: Ring control block.
+*
+* Return:
+*  Oldest element, or NULL if the ring is empty
+*
+*******************************************************************************/
+const void *Cy_IPC_Ring_Peek(cy_stc_ipc_ring_t *ring)
+{
+    uint32_t tail = IPC_PORT_LOAD_RELAXED(&ring->tail);
+    const uint8_t *slot;
+
+    if (tail == ring->headCache)
+    {
+        ring->headCache = ipc_ring_load_head(ring);
+        if (tail == ring->headCache)
+        {
+            return NULL;
+        }
+    }
+
+    slot = &ring->buffer[(tail & ring->mask) * ring->elemSize];
+    Cy_IPC_Port_InvalidateDCache(slot, ring->elemSize);
+
+    return slot;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Ring_Count
+********************************************************************************
+* Summary:
+* Returns the number of pending elements. The value is a snapshot and may be
+* stale by the time the caller uses it. Can be called from either side.
+*
+* Parameters:
+*  ring: Ring control block.
+*
+* Return:
+*  Number of elements pushed and not yet popped.
+*
+*******************************************************************************/
+uint32_t Cy_IPC_Ring_Count(cy_stc_ipc_ring_t *ring)
+{
+    uint32_t tail = ipc_ring_load_tail(ring);
+
+    return ipc_ring_load_head(ring) - tail;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,335 @@
+/******************************************************************************
+* File Name:   ipc_rpc.c
+*
+* Description: Lightweight request/response RPC layer for the IPC pipe.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "ipc_rpc.h"
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+/* Slot states */
+#define IPC_RPC_SLOT_FREE               (0UL)   /* Available */
+#define IPC_RPC_SLOT_RESERVED           (1UL)   /* Being filled by Cy_IPC_Rpc_Prepare() */
+#define IPC_RPC_SLOT_PENDING            (2UL)   /* Waiting for the response */
+#define IPC_RPC_SLOT_COMPLETING         (3UL)   /* Response being stored */
+#define IPC_RPC_SLOT_DONE               (4UL)   /* Response stored, waiting for Cy_IPC_Rpc_Poll() */
+
+/* The low bits of an ID select the slot, the high bits count its reuse */
+#define IPC_RPC_ID_SLOT_Msk             (CY_IPC_RPC_MAX_PENDING - 1UL)
+#define IPC_RPC_ID_Msk                  (0xFFFFUL)
+
+
+/*******************************************************************************
+* Function Name: ipc_rpc_slot
+********************************************************************************
+* Summary:
+* Returns the slot of an ID if that ID is the one currently using it.
+*
+*******************************************************************************/
+static inline cy_stc_ipc_rpc_slot_t *ipc_rpc_slot(cy_stc_ipc_rpc_client_t *client, uint32_t id)
+{
+    cy_stc_ipc_rpc_slot_t *slot = &client->slot[id & IPC_RPC_ID_SLOT_Msk];
+
+    return (slot->id == (uint16_t)id) ? slot : NULL;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Rpc_InitClient
+********************************************************************************
+* Summary:
+* Initializes the caller side with no outstanding requests.
+*
+* Parameters:
+*  client: Caller state.
+*  clientID: Client ID that handles the requests on the serving core.
+*  pktType: Packet type written into requests.
+*  intrRelMask: Release mask written into requests.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Rpc_InitClient(cy_stc_ipc_rpc_client_t *client, uint32_t clientID, uint32_t pktType, uint32_t intrRelMask)
+{
+    uint32_t i;
+
+    for (i = 0UL; i < CY_IPC_RPC_MAX_PENDING; i++)
+    {
+        client->slot[i].id = (uint16_t)i;
+        client->slot[i].callback = NULL;
+        client->slot[i].context = NULL;
+        IPC_PORT_STORE_RELEASE(&client->slot[i].state, IPC_RPC_SLOT_FREE);
+    }
+
+    client->clientID = (uint8_t)clientID;
+    client->pktType = (uint8_t)pktType;
+    client->intrRelMask = (uint16_t)intrRelMask;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Rpc_Prepare
+********************************************************************************
+* Summary:
+* Reserves a request ID and builds the request message. The caller then
+* delivers the message to the serving core; if that fails it must call
+* Cy_IPC_Rpc_Cancel() with the returned ID.
+*
+* Parameters:
+*  client: Caller state.
+*  method: Method code on the serving core.
+*  arg: Method argument.
+*  callback: Called with the response, or NULL to poll with Cy_IPC_Rpc_Poll().
+*  context: Passed to the callback.
+*  request: Receives the request message.
+*  id: Receives the request ID.
+*
+* Return:
+*  CY_IPC_RPC_SUCCESS, CY_IPC_RPC_ERROR_BAD_PARAM or CY_IPC_RPC_ERROR_NO_SLOT
+*
+*******************************************************************************/
+cy_en_ipc_rpc_status_t Cy_IPC_Rpc_Prepare(cy_stc_ipc_rpc_client_t *client, uint32_t method, uint32_t arg,
+                                          cy_ipc_rpc_callback_t callback, void *context,
+                                          cy_stc_ipc_rpc_msg_t *request, uint32_t *id)
+{
+    cy_stc_ipc_rpc_slot_t *slot;
+    uint32_t expected;
+    uint32_t i;
+
+    if ((NULL == request) || (NULL == id) || (method > 0xFFFFUL))
+    {
+        return CY_IPC_RPC_ERROR_BAD_PARAM;
+    }
+
+    for (i = 0UL; i < CY_IPC_RPC_MAX_PENDING; i++)
+    {
+        slot = &client->slot[i];
+        expected = IPC_RPC_SLOT_FREE;
+        if (Cy_IPC_Port_CompareExchange(&slot->state, &expected, IPC_RPC_SLOT_RESERVED))
+        {
+            /* New generation of this slot, stale responses to the old ID no longer match */
+            slot->id = (uint16_t)((slot->id + CY_IPC_RPC_MAX_PENDING) & IPC_RPC_ID_Msk);
+            slot->callback = callback;
+            slot->context = context;
+
+            request->clientID = client->clientID;
+            request->pktType = client->pktType;
+            request->intrRelMask = client->intrRelMask;
+            request->id = slot->id;
+            request->code = (uint16_t)method;
+            request->value = arg;
+            *id = slot->id;
+
+            IPC_PORT_STORE_RELEASE(&slot->state, IPC_RPC_SLOT_PENDING);
+            return CY_IPC_RPC_SUCCESS;
+        }
+    }
+
+    return CY_IPC_RPC_ERROR_NO_SLOT;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Rpc_Complete
+********************************************************************************
+* Summary:
+* Delivers a response from the serving core. Calls the completion callback,
+* or stores the result for Cy_IPC_Rpc_Poll(). Typically called from the pipe
+* interrupt of the calling core.
+*
+* Parameters:
+*  client: Caller state.
+*  response: Response message.
+*
+* Return:
+*  CY_IPC_RPC_SUCCESS, or CY_IPC_RPC_ERROR_UNKNOWN_ID for a response to a
+*  cancelled or unknown request.
+*
+*******************************************************************************/
+cy_en_ipc_rpc_status_t Cy_IPC_Rpc_Complete(cy_stc_ipc_rpc_client_t *client, const cy_stc_ipc_rpc_msg_t *response)
+{
+    cy_stc_ipc_rpc_slot_t *slot = ipc_rpc_slot(client, response->id);
+    cy_ipc_rpc_callback_t callback;
+    void *context;
+    uint32_t expected = IPC_RPC_SLOT_PENDING;
+
+    if ((NULL == slot) || !Cy_IPC_Port_CompareExchange(&slot->state, &expected, IPC_RPC_SLOT_COMPLETING))
+    {
+        return CY_IPC_RPC_ERROR_UNKNOWN_ID;
+    }
+
+    /* The slot may have been cancelled and reused between the lookup and the exchange */
+    if (slot->id != response->id)
+    {
+        IPC_PORT_STORE_RELEASE(&slot->state, IPC_RPC_SLOT_PENDING);
+        return CY_IPC_RPC_ERROR_UNKNOWN_ID;
+    }
+
+    slot->status = (cy_en_ipc_rpc_status_t)response->code;
+    slot->result = response->value;
+
+    if (NULL != slot->callback)
+    {
+        callback = slot->callback;
+        context = slot->context;
+        IPC_PORT_STORE_RELEASE(&slot->state, IPC_RPC_SLOT_FREE);
+        callback(response->id, (cy_en_ipc_rpc_status_t)response->code, response->value, context);
+    }
+    else
+    {
+        IPC_PORT_STORE_RELEASE(&slot->state, IPC_RPC_SLOT_DONE);
+    }
+
+    return CY_IPC_RPC_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Rpc_Poll
+********************************************************************************
+* Summary:
+* Checks a request issued without a callback. Once the response is returned
+* the ID is released.
+*
+* Parameters:
+*  client: Caller state.
+*  id: Request ID from Cy_IPC_Rpc_Prepare().
+*  result: Receives the response value when the request completed.
+*
+* Return:
+*  CY_IPC_RPC_PENDING, CY_IPC_RPC_ERROR_UNKNOWN_ID, or the status returned by
+*  the serving core.
+*
+*******************************************************************************/
+cy_en_ipc_rpc_status_t Cy_IPC_Rpc_Poll(cy_stc_ipc_rpc_client_t *client, uint32_t id, uint32_t *result)
+{
+    cy_stc_ipc_rpc_slot_t *slot = ipc_rpc_slot(client, id);
+    cy_en_ipc_rpc_status_t status;
+    uint32_t state;
+
+    if (NULL == slot)
+    {
+        return CY_IPC_RPC_ERROR_UNKNOWN_ID;
+    }
+
+    state = IPC_PORT_LOAD_ACQUIRE(&slot->state);
+    if ((IPC_RPC_SLOT_PENDING == state) || (IPC_RPC_SLOT_COMPLETING == state))
+    {
+        return CY_IPC_RPC_PENDING;
+    }
+    if (IPC_RPC_SLOT_DONE != state)
+    {
+        return CY_IPC_RPC_ERROR_UNKNOWN_ID;
+    }
+
+    status = slot->status;
+    *result = slot->result;
+    IPC_PORT_STORE_RELEASE(&slot->state, IPC_RPC_SLOT_FREE);
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Rpc_Cancel
+********************************************************************************
+* Summary:
+* Abandons an outstanding request. A response that arrives later is ignored.
+*
+* Parameters:
+*  client: Caller state.
+*  id: Request ID from Cy_IPC_Rpc_Prepare().
+*
+* Return:
+*  CY_IPC_RPC_SUCCESS or CY_IPC_RPC_ERROR_UNKNOWN_ID
+*
+*******************************************************************************/
+cy_en_ipc_rpc_status_t Cy_IPC_Rpc_Cancel(cy_stc_ipc_rpc_client_t *client, uint32_t id)
+{
+    cy_stc_ipc_rpc_slot_t *slot = ipc_rpc_slot(client, id);
+    uint32_t expected = IPC_RPC_SLOT_PENDING;
+
+    if (NULL == slot)
+    {
+        return CY_IPC_RPC_ERROR_UNKNOWN_ID;
+    }
+
+    if (Cy_IPC_Port_CompareExchange(&slot->state, &expected, IPC_RPC_SLOT_FREE))
+    {
+        return CY_IPC_RPC_SUCCESS;
+    }
+
+    expected = IPC_RPC_SLOT_DONE;
+    return Cy_IPC_Port_CompareExchange(&slot->state, &expected, IPC_RPC_SLOT_FREE) ?
+           CY_IPC_RPC_SUCCESS : CY_IPC_RPC_ERROR_UNKNOWN_ID;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Rpc_Serve
+********************************************************************************
+* Summary:
+* Runs the method named by a request and builds the response. Servers that
+* complete requests later can fill the response themselves; responses may be
+* returned in any order.
+*
+* Parameters:
+*  server: Server method table.
+*  request: Received request.
+*  response: Receives the response message.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Rpc_Serve(const cy_stc_ipc_rpc_server_t *server, const cy_stc_ipc_rpc_msg_t *request, cy_stc_ipc_rpc_msg_t *response)
+{
+    cy_en_ipc_rpc_status_t status = CY_IPC_RPC_ERROR_NO_METHOD;
+    uint32_t result = 0UL;
+
+    if ((request->code < server->methodCount) && (NULL != server->methods[request->code]))
+    {
+        status = server->methods[request->code](request->value, &result);
+    }
+
+    response->clientID = server->clientID;
+    response->pktType = server->pktType;
+    response->intrRelMask = server->intrRelMask;
+    response->id = request->id;
+    response->code = (uint16_t)status;
+    response->value = result;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,321 @@
+/******************************************************************************
+* File Name:   ipc_sched.c
+*
+* Description: Event-driven job scheduler for a producer core.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "ipc_sched.h"
+
+
+/*******************************************************************************
+* Function Name: ipc_sched_update
+********************************************************************************
+* Summary:
+* Atomically clears and sets bits of a job mask.
+*
+*******************************************************************************/
+static uint32_t ipc_sched_update(cy_ipc_atomic32_t *mask, uint32_t clear, uint32_t set)
+{
+    uint32_t previous = IPC_PORT_LOAD_RELAXED(mask);
+
+    while (!Cy_IPC_Port_CompareExchange(mask, &previous, (previous & ~clear) | set))
+    {
+    }
+
+    return previous;
+}
+
+/*******************************************************************************
+* Function Name: ipc_sched_reached
+********************************************************************************
+* Summary:
+* Returns true once now has reached tick, across counter wrap-around.
+*
+*******************************************************************************/
+static inline bool ipc_sched_reached(uint32_t now, uint32_t tick)
+{
+    return ((int32_t)(now - tick) >= 0);
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Sched_Init
+********************************************************************************
+* Summary:
+* Initializes a scheduler without jobs.
+*
+* Parameters:
+*  sched: Scheduler state.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Sched_Init(cy_stc_ipc_sched_t *sched)
+{
+    uint32_t i;
+
+    for (i = 0UL; i < CY_IPC_SCHED_MAX_JOBS; i++)
+    {
+        sched->jobs[i].job = NULL;
+        sched->jobs[i].context = NULL;
+        sched->jobs[i].period = CY_IPC_SCHED_ON_DEMAND;
+        sched->jobs[i].due = 0UL;
+    }
+    IPC_PORT_STORE_RELAXED(&sched->pending, 0UL);
+    IPC_PORT_STORE_RELAXED(&sched->blocked, 0UL);
+    IPC_PORT_STORE_RELAXED(&sched->releases, 0UL);
+    sched->runs = 0UL;
+    sched->backoffs = 0UL;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Sched_AddJob
+********************************************************************************
+* Summary:
+* Registers a job. Lower job IDs run first within a pass. Call from the
+* thread that runs the scheduler.
+*
+* Parameters:
+*  sched: Scheduler state.
+*  jobId: Job ID, 0 .. CY_IPC_SCHED_MAX_JOBS - 1.
+*  job: Job function.
+*  context: Passed to the job.
+*  period: Ticks between runs, or CY_IPC_SCHED_ON_DEMAND.
+*  now: Current tick; a periodic job first runs one period later.
+*
+* Return:
+*  CY_IPC_SCHED_SUCCESS or CY_IPC_SCHED_ERROR_BAD_PARAM
+*
+*******************************************************************************/
+cy_en_ipc_sched_status_t Cy_IPC_Sched_AddJob(cy_stc_ipc_sched_t *sched, uint32_t jobId, cy_ipc_sched_job_t job,
+                                             void *context, uint32_t period, uint32_t now)
+{
+    if ((jobId >= CY_IPC_SCHED_MAX_JOBS) || (NULL == job))
+    {
+        return CY_IPC_SCHED_ERROR_BAD_PARAM;
+    }
+
+    sched->jobs[jobId].job = job;
+    sched->jobs[jobId].context = context;
+    sched->jobs[jobId].period = period;
+    sched->jobs[jobId].due = now + period;
+
+    return CY_IPC_SCHED_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Sched_Trigger
+********************************************************************************
+* Summary:
+* Requests a run of a job. Can be called from interrupts; several triggers
+* before the job runs result in one run.
+*
+* Parameters:
+*  sched: Scheduler state.
+*  jobId: Job ID.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Sched_Trigger(cy_stc_ipc_sched_t *sched, uint32_t jobId)
+{
+    if (jobId < CY_IPC_SCHED_MAX_JOBS)
+    {
+        (void)ipc_sched_update(&sched->pending, 0UL, 1UL << jobId);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Sched_Unblock
+********************************************************************************
+* Summary:
+* Makes the jobs that backed off runnable again. Call from the pipe release
+* interrupt.
+*
+* Parameters:
+*  sched: Scheduler state.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Sched_Unblock(cy_stc_ipc_sched_t *sched)
+{
+    uint32_t blocked;
+
+    /* Counted first: a job backing off concurrently sees the release */
+    (void)Cy_IPC_Port_FetchAdd(&sched->releases, 1UL);
+    blocked = ipc_sched_update(&sched->blocked, UINT32_MAX, 0UL);
+    if (0UL != blocked)
+    {
+        (void)ipc_sched_update(&sched->pending, 0UL, blocked);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Sched_RunOnce
+********************************************************************************
+* Summary:
+* Runs one pass: every periodic job that is due and every triggered job runs
+* once. A periodic job that falls behind skips the missed periods instead of
+* running back to back. A job that is blocked waits for Cy_IPC_Sched_Unblock()
+* even if it becomes due again.
+*
+* Parameters:
+*  sched: Scheduler state.
+*  now: Current tick.
+*
+* Return:
+*  true if jobs are still pending and the caller must not idle.
+*
+*******************************************************************************/
+bool Cy_IPC_Sched_RunOnce(cy_stc_ipc_sched_t *sched, uint32_t now)
+{
+    cy_stc_ipc_sched_job_t *pJob;
+    cy_en_ipc_sched_result_t result;
+    uint32_t runnable = 0UL;
+    uint32_t releases;
+    uint32_t bit;
+    uint32_t i;
+
+    for (i = 0UL; i < CY_IPC_SCHED_MAX_JOBS; i++)
+    {
+        pJob = &sched->jobs[i];
+        if ((NULL != pJob->job) && (CY_IPC_SCHED_ON_DEMAND != pJob->period) && ipc_sched_reached(now, pJob->due))
+        {
+            pJob->due += pJob->period;
+            if (ipc_sched_reached(now, pJob->due))
+            {
+                pJob->due = now + pJob->period;
+            }
+            runnable |= 1UL << i;
+        }
+    }
+
+    runnable |= ipc_sched_update(&sched->pending, UINT32_MAX, 0UL);
+    runnable &= ~IPC_PORT_LOAD_ACQUIRE(&sched->blocked);
+
+    for (i = 0UL; (i < CY_IPC_SCHED_MAX_JOBS) && (0UL != runnable); i++)
+    {
+        bit = 1UL << i;
+        pJob = &sched->jobs[i];
+        if ((0UL == (runnable & bit)) || (NULL == pJob->job))
+        {
+            continue;
+        }
+        runnable &= ~bit;
+
+        releases = IPC_PORT_LOAD_ACQUIRE(&sched->releases);
+        result = pJob->job(pJob->context);
+        sched->runs++;
+
+        if (CY_IPC_SCHED_AGAIN == result)
+        {
+            (void)ipc_sched_update(&sched->pending, 0UL, bit);
+        }
+        else if (CY_IPC_SCHED_BLOCKED == result)
+        {
+            sched->backoffs++;
+            (void)ipc_sched_update(&sched->blocked, 0UL, bit);
+
+            /* The release may have come while the job ran and found the pipe busy */
+            if (releases != IPC_PORT_LOAD_ACQUIRE(&sched->releases))
+            {
+                (void)ipc_sched_update(&sched->blocked, bit, 0UL);
+                (void)ipc_sched_update(&sched->pending, 0UL, bit);
+            }
+        }
+        else
+        {
+            /* Done until the next period or trigger */
+        }
+    }
+
+    return (0UL != IPC_PORT_LOAD_ACQUIRE(&sched->pending));
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Sched_IdleTime
+********************************************************************************
+* Summary:
+* Returns how long the caller may idle. Check it with interrupts masked right
+* before entering WFI, so that a trigger from an interrupt is not missed.
+*
+* Parameters:
+*  sched: Scheduler state.
+*  now: Current tick.
+*
+* Return:
+*  0 if a job is runnable, ticks until the next periodic job otherwise, or
+*  CY_IPC_SCHED_FOREVER if only interrupts can create work.
+*
+*******************************************************************************/
+uint32_t Cy_IPC_Sched_IdleTime(cy_stc_ipc_sched_t *sched, uint32_t now)
+{
+    const cy_stc_ipc_sched_job_t *pJob;
+    uint32_t blocked = IPC_PORT_LOAD_ACQUIRE(&sched->blocked);
+    uint32_t idle = CY_IPC_SCHED_FOREVER;
+    uint32_t i;
+
+    if (0UL != IPC_PORT_LOAD_ACQUIRE(&sched->pending))
+    {
+        return 0UL;
+    }
+
+    for (i = 0UL; i < CY_IPC_SCHED_MAX_JOBS; i++)
+    {
+        pJob = &sched->jobs[i];
+        if ((NULL == pJob->job) || (CY_IPC_SCHED_ON_DEMAND == pJob->period) || (0UL != (blocked & (1UL << i))))
+        {
+            continue;
+        }
+        if (ipc_sched_reached(now, pJob->due))
+        {
+            return 0UL;
+        }
+        if ((pJob->due - now) < idle)
+        {
+            idle = pJob->due - now;
+        }
+    }
+
+    return idle;
+}
+
+/* [] END OF FILE */
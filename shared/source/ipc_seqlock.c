@@ -0,0 +1,270 @@
+/******************************************************************************
+* File Name:   ipc_seqlock.c
+*
+* Description: Seqlock-protected shared state between cores. The sequence
+*              number is odd while the writer updates the snapshot; a
+*              reader keeps its copy only if the number was even and did
+*              not change while it copied.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+#include "ipc_seqlock.h"
+
+
+/*******************************************************************************
+* Function Name: ipc_seqlock_publish_seq
+********************************************************************************
+* Summary:
+* Stores the sequence number and writes back its line for the readers.
+*
+*******************************************************************************/
+static inline void ipc_seqlock_publish_seq(cy_stc_ipc_seqlock_t *lock, uint32_t seq)
+{
+    IPC_PORT_STORE_RELEASE(&lock->seq, seq);
+    Cy_IPC_Port_CleanDCache(&lock->seq, sizeof(lock->seq));
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Seqlock_Init
+********************************************************************************
+* Summary:
+* Initializes a state region with a zeroed snapshot. Must be called by the
+* writer before any reader learns the region.
+*
+* Parameters:
+*  lock: State region.
+*  data: Snapshot of size bytes, cache line aligned.
+*  size: Snapshot bytes.
+*  notifyMask: IPC interrupt mask the writer raises after every update, 0
+*              for readers that poll.
+*
+* Return:
+*  CY_IPC_SEQLOCK_SUCCESS, or CY_IPC_SEQLOCK_ERROR_BAD_PARAM
+*
+*******************************************************************************/
+cy_en_ipc_seqlock_status_t Cy_IPC_Seqlock_Init(cy_stc_ipc_seqlock_t *lock, void *data, uint32_t size, uint32_t notifyMask)
+{
+    if ((NULL == lock) || (NULL == data) || (0UL == size) ||
+        (0UL != ((uintptr_t)data & (IPC_PORT_CACHE_LINE - 1UL))))
+    {
+        return CY_IPC_SEQLOCK_ERROR_BAD_PARAM;
+    }
+
+    lock->size = size;
+    lock->notifyMask = notifyMask;
+    lock->data = data;
+    (void)memset(data, 0, size);
+    IPC_PORT_STORE_RELAXED(&lock->seq, 0UL);
+
+    Cy_IPC_Port_CleanDCache(data, size);
+    Cy_IPC_Port_CleanDCache(lock, sizeof(*lock));
+
+    return CY_IPC_SEQLOCK_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Seqlock_BeginWrite
+********************************************************************************
+* Summary:
+* Starts an update and returns the snapshot to write in place. Readers
+* retry until Cy_IPC_Seqlock_EndWrite(), so keep the update short. Never
+* blocks; an interrupt that reads the region on the writer's own core
+* while the update is open gets CY_IPC_SEQLOCK_BUSY.
+*
+* Parameters:
+*  lock: State region, called by its writer only.
+*
+* Return:
+*  Snapshot of size bytes
+*
+*******************************************************************************/
+void *Cy_IPC_Seqlock_BeginWrite(cy_stc_ipc_seqlock_t *lock)
+{
+    ipc_seqlock_publish_seq(lock, IPC_PORT_LOAD_RELAXED(&lock->seq) + 1UL);
+
+    /* The odd number is visible before any byte of the snapshot changes */
+    IPC_PORT_FENCE_RELEASE();
+
+    return lock->data;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Seqlock_EndWrite
+********************************************************************************
+* Summary:
+* Completes the update started by Cy_IPC_Seqlock_BeginWrite(). The caller
+* then rings the doorbell, with one IPC notify event on the returned mask.
+*
+* Parameters:
+*  lock: State region, called by its writer only.
+*
+* Return:
+*  IPC interrupt mask of the readers to notify, 0 for none
+*
+*******************************************************************************/
+uint32_t Cy_IPC_Seqlock_EndWrite(cy_stc_ipc_seqlock_t *lock)
+{
+    Cy_IPC_Port_CleanDCache(lock->data, lock->size);
+    ipc_seqlock_publish_seq(lock, IPC_PORT_LOAD_RELAXED(&lock->seq) + 1UL);
+
+    return lock->notifyMask;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Seqlock_Write
+********************************************************************************
+* Summary:
+* Replaces the snapshot with a copy of src.
+*
+* Parameters:
+*  lock: State region, called by its writer only.
+*  src: New snapshot, size bytes.
+*
+* Return:
+*  IPC interrupt mask of the readers to notify, 0 for none
+*
+*******************************************************************************/
+uint32_t Cy_IPC_Seqlock_Write(cy_stc_ipc_seqlock_t *lock, const void *src)
+{
+    (void)memcpy(Cy_IPC_Seqlock_BeginWrite(lock), src, lock->size);
+
+    return Cy_IPC_Seqlock_EndWrite(lock);
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Seqlock_TryRead
+********************************************************************************
+* Summary:
+* Copies the snapshot once. The copy is kept only if no update was open or
+* completed while it was taken; a torn copy is reported as busy and the
+* caller retries. dst may have been overwritten in either case.
+*
+* Parameters:
+*  lock: State region.
+*  dst: Receives the snapshot, size bytes.
+*  seq: Receives the sequence number of the snapshot, even. Can be NULL.
+*
+* Return:
+*  CY_IPC_SEQLOCK_SUCCESS, or CY_IPC_SEQLOCK_BUSY
+*
+*******************************************************************************/
+cy_en_ipc_seqlock_status_t Cy_IPC_Seqlock_TryRead(cy_stc_ipc_seqlock_t *lock, void *dst, uint32_t *seq)
+{
+    uint32_t start;
+
+    Cy_IPC_Port_InvalidateDCache(&lock->seq, sizeof(lock->seq));
+    start = IPC_PORT_LOAD_ACQUIRE(&lock->seq);
+    if (0UL != (start & 1UL))
+    {
+        return CY_IPC_SEQLOCK_BUSY;
+    }
+
+    Cy_IPC_Port_InvalidateDCache(lock->data, lock->size);
+    (void)memcpy(dst, lock->data, lock->size);
+
+    /* The copy is complete before the number is checked again */
+    IPC_PORT_FENCE_ACQUIRE();
+    Cy_IPC_Port_InvalidateDCache(&lock->seq, sizeof(lock->seq));
+    if (start != IPC_PORT_LOAD_RELAXED(&lock->seq))
+    {
+        return CY_IPC_SEQLOCK_BUSY;
+    }
+
+    if (NULL != seq)
+    {
+        *seq = start;
+    }
+
+    return CY_IPC_SEQLOCK_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Seqlock_Read
+********************************************************************************
+* Summary:
+* Copies a consistent snapshot, with up to CY_IPC_SEQLOCK_MAX_RETRIES
+* attempts. The bound keeps a reader that interrupted the writer on its own
+* core from spinning on an update that cannot complete.
+*
+* Parameters:
+*  lock: State region.
+*  dst: Receives the snapshot, size bytes.
+*  seq: Receives the sequence number of the snapshot, even. Can be NULL.
+*
+* Return:
+*  CY_IPC_SEQLOCK_SUCCESS, or CY_IPC_SEQLOCK_BUSY if every attempt was torn
+*
+*******************************************************************************/
+cy_en_ipc_seqlock_status_t Cy_IPC_Seqlock_Read(cy_stc_ipc_seqlock_t *lock, void *dst, uint32_t *seq)
+{
+    uint32_t attempt;
+
+    for (attempt = 0UL; attempt < CY_IPC_SEQLOCK_MAX_RETRIES; attempt++)
+    {
+        if (CY_IPC_SEQLOCK_SUCCESS == Cy_IPC_Seqlock_TryRead(lock, dst, seq))
+        {
+            return CY_IPC_SEQLOCK_SUCCESS;
+        }
+    }
+
+    return CY_IPC_SEQLOCK_BUSY;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Seqlock_Changed
+********************************************************************************
+* Summary:
+* Checks without copying whether the snapshot changed since the one read
+* with sequence number seq, for readers that poll.
+*
+* Parameters:
+*  lock: State region.
+*  seq: Sequence number returned with the last snapshot.
+*
+* Return:
+*  true if an update was made or is open since
+*
+*******************************************************************************/
+bool Cy_IPC_Seqlock_Changed(cy_stc_ipc_seqlock_t *lock, uint32_t seq)
+{
+    Cy_IPC_Port_InvalidateDCache(&lock->seq, sizeof(lock->seq));
+
+    return (seq != IPC_PORT_LOAD_RELAXED(&lock->seq));
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,238 @@
+/******************************************************************************
+* File Name:   ipc_shbuf.c
+*
+* Description: Shared buffer pool for zero-copy transfers.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "ipc_shbuf.h"
+
+
+/*******************************************************************************
+* Function Name: ipc_shbuf_run_mask
+********************************************************************************
+* Summary:
+* Returns the free mask bits covering the slots of [offset, offset + length).
+*
+*******************************************************************************/
+static inline uint32_t ipc_shbuf_run_mask(const cy_stc_ipc_shbuf_t *pool, uint32_t offset, uint32_t length)
+{
+    uint32_t first = offset / pool->slotSize;
+    uint32_t count = (length + pool->slotSize - 1UL) / pool->slotSize;
+    uint32_t run = (count >= CY_IPC_SHBUF_MAX_SLOTS) ? 0xFFFFFFFFUL : ((1UL << count) - 1UL);
+
+    return run << first;
+}
+
+/*******************************************************************************
+* Function Name: ipc_shbuf_in_range
+********************************************************************************
+* Summary:
+* Checks that [offset, offset + length) lies inside the pool.
+*
+*******************************************************************************/
+static inline bool ipc_shbuf_in_range(const cy_stc_ipc_shbuf_t *pool, uint32_t offset, uint32_t length)
+{
+    uint32_t size = pool->slotSize * pool->slotCount;
+
+    return (0UL != length) && (offset < size) && (length <= (size - offset));
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_ShBuf_Init
+********************************************************************************
+* Summary:
+* Initializes a pool over a shared region. Slots beyond
+* CY_IPC_SHBUF_MAX_SLOTS are not used.
+*
+* Parameters:
+*  pool: Pool control block.
+*  base: Region start, aligned to IPC_PORT_CACHE_LINE.
+*  size: Region size in bytes.
+*  slotSize: Allocation granule, a non-zero multiple of IPC_PORT_CACHE_LINE.
+*
+* Return:
+*  CY_IPC_SHBUF_SUCCESS or CY_IPC_SHBUF_ERROR_BAD_PARAM
+*
+*******************************************************************************/
+cy_en_ipc_shbuf_status_t Cy_IPC_ShBuf_Init(cy_stc_ipc_shbuf_t *pool, void *base, uint32_t size, uint32_t slotSize)
+{
+    uint32_t slotCount;
+
+    if ((NULL == pool) || (NULL == base) || (0UL != ((uintptr_t)base % IPC_PORT_CACHE_LINE)) ||
+        (0UL == slotSize) || (0UL != (slotSize % IPC_PORT_CACHE_LINE)) || (size < slotSize))
+    {
+        return CY_IPC_SHBUF_ERROR_BAD_PARAM;
+    }
+
+    slotCount = size / slotSize;
+    if (slotCount > CY_IPC_SHBUF_MAX_SLOTS)
+    {
+        slotCount = CY_IPC_SHBUF_MAX_SLOTS;
+    }
+
+    pool->base = (uint8_t *)base;
+    pool->slotSize = slotSize;
+    pool->slotCount = slotCount;
+    pool->freeMask = (slotCount == CY_IPC_SHBUF_MAX_SLOTS) ? 0xFFFFFFFFUL : ((1UL << slotCount) - 1UL);
+
+    /* The receiver reads base and slot geometry to resolve descriptors */
+    Cy_IPC_Port_CleanDCache(pool, sizeof(*pool));
+
+    return CY_IPC_SHBUF_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_ShBuf_Alloc
+********************************************************************************
+* Summary:
+* Allocates a contiguous run of slots large enough for length bytes
+* (first fit). Owner core only.
+*
+* Parameters:
+*  pool: Pool control block.
+*  length: Payload size in bytes.
+*  offset: Receives the payload offset from pool->base.
+*
+* Return:
+*  CY_IPC_SHBUF_SUCCESS, CY_IPC_SHBUF_ERROR_BAD_PARAM or
+*  CY_IPC_SHBUF_ERROR_NO_MEMORY
+*
+*******************************************************************************/
+cy_en_ipc_shbuf_status_t Cy_IPC_ShBuf_Alloc(cy_stc_ipc_shbuf_t *pool, uint32_t length, uint32_t *offset)
+{
+    uint32_t count;
+    uint32_t run;
+    uint32_t slot;
+
+    if (!ipc_shbuf_in_range(pool, 0UL, length))
+    {
+        return CY_IPC_SHBUF_ERROR_BAD_PARAM;
+    }
+
+    count = (length + pool->slotSize - 1UL) / pool->slotSize;
+    run = ipc_shbuf_run_mask(pool, 0UL, length);
+
+    for (slot = 0UL; (slot + count) <= pool->slotCount; slot++)
+    {
+        if ((pool->freeMask & (run << slot)) == (run << slot))
+        {
+            pool->freeMask &= ~(run << slot);
+            *offset = slot * pool->slotSize;
+            return CY_IPC_SHBUF_SUCCESS;
+        }
+    }
+
+    return CY_IPC_SHBUF_ERROR_NO_MEMORY;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_ShBuf_Free
+********************************************************************************
+* Summary:
+* Returns a payload allocated with Cy_IPC_ShBuf_Alloc to the pool. Owner core
+* only; typically called from the pipe release callback once the receiver has
+* handed ownership back.
+*
+* Parameters:
+*  pool: Pool control block.
+*  offset: Offset returned by Cy_IPC_ShBuf_Alloc.
+*  length: Length passed to Cy_IPC_ShBuf_Alloc.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_ShBuf_Free(cy_stc_ipc_shbuf_t *pool, uint32_t offset, uint32_t length)
+{
+    if (ipc_shbuf_in_range(pool, offset, length))
+    {
+        pool->freeMask |= ipc_shbuf_run_mask(pool, offset, length);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_ShBuf_Publish
+********************************************************************************
+* Summary:
+* Makes a payload written by the sender visible to the receiver. Call it
+* after filling the payload and before sending its descriptor.
+*
+* Parameters:
+*  pool: Pool control block.
+*  offset: Payload offset.
+*  length: Payload length in bytes.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_ShBuf_Publish(const cy_stc_ipc_shbuf_t *pool, uint32_t offset, uint32_t length)
+{
+    Cy_IPC_Port_CleanDCache(&pool->base[offset], length);
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_ShBuf_Access
+********************************************************************************
+* Summary:
+* Resolves a received descriptor to a pointer into the pool, so the payload
+* can be processed in place. The descriptor comes from another core and is
+* validated against the pool bounds.
+*
+* Parameters:
+*  pool: Pool control block.
+*  offset: Payload offset from the descriptor.
+*  length: Payload length from the descriptor.
+*
+* Return:
+*  Pointer to the payload, or NULL if the descriptor is out of range.
+*
+*******************************************************************************/
+void *Cy_IPC_ShBuf_Access(const cy_stc_ipc_shbuf_t *pool, uint32_t offset, uint32_t length)
+{
+    if (!ipc_shbuf_in_range(pool, offset, length))
+    {
+        return NULL;
+    }
+
+    Cy_IPC_Port_InvalidateDCache(&pool->base[offset], length);
+
+    return &pool->base[offset];
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,328 @@
+/******************************************************************************
+* File Name:   ipc_stats.c
+*
+* Description: Optional end-to-end latency instrumentation for IPC messages.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "ipc_stats.h"
+#include "ipc_msg.h"
+
+#if defined(IPC_HOST_BUILD)
+#include <time.h>
+#endif
+
+/* Layout of cy_stc_ipc_msg_t with IPC_STATS_ENABLE, independent of the
+ * value this file is built with */
+typedef struct
+{
+    cy_stc_ipc_msg_hdr_t hdr;
+    cy_stc_ipc_stats_stamp_t stamp;
+} ipc_stats_msg_t;
+
+
+/*******************************************************************************
+* Function Name: ipc_stats_bucket
+********************************************************************************
+* Summary:
+* Returns the histogram bucket of a sample.
+*
+*******************************************************************************/
+static inline uint32_t ipc_stats_bucket(uint32_t ticks)
+{
+    uint32_t msb;
+
+    if (ticks < CY_IPC_STATS_SUB_BUCKETS)
+    {
+        return ticks;
+    }
+
+#if defined(IPC_HOST_BUILD)
+    msb = 31UL - (uint32_t)__builtin_clz(ticks);
+#else
+    msb = 31UL - (uint32_t)__CLZ(ticks);
+#endif
+
+    return ((msb - CY_IPC_STATS_SUB_BITS + 1UL) * CY_IPC_STATS_SUB_BUCKETS) +
+           ((ticks >> (msb - CY_IPC_STATS_SUB_BITS)) & (CY_IPC_STATS_SUB_BUCKETS - 1UL));
+}
+
+/*******************************************************************************
+* Function Name: ipc_stats_bucket_limit
+********************************************************************************
+* Summary:
+* Returns the largest sample that falls into a bucket.
+*
+*******************************************************************************/
+static inline uint32_t ipc_stats_bucket_limit(uint32_t bucket)
+{
+    uint32_t group = bucket / CY_IPC_STATS_SUB_BUCKETS;
+    uint32_t sub = bucket % CY_IPC_STATS_SUB_BUCKETS;
+
+    if (0UL == group)
+    {
+        return bucket;
+    }
+
+    return ((CY_IPC_STATS_SUB_BUCKETS + sub) << (group - 1UL)) + ((1UL << (group - 1UL)) - 1UL);
+}
+
+/*******************************************************************************
+* Function Name: ipc_stats_percentile
+********************************************************************************
+* Summary:
+* Returns the upper limit of the bucket holding the sample of the given rank,
+* capped at the largest sample.
+*
+*******************************************************************************/
+static uint32_t ipc_stats_percentile(const cy_stc_ipc_stats_hist_t *hist, uint32_t count, uint32_t permille)
+{
+    uint32_t rank = (uint32_t)((((uint64_t)count * permille) + 999UL) / 1000UL);
+    uint32_t seen = 0UL;
+    uint32_t i;
+
+    for (i = 0UL; i < CY_IPC_STATS_BUCKETS; i++)
+    {
+        seen += hist->bucket[i];
+        if (seen >= rank)
+        {
+            return (ipc_stats_bucket_limit(i) < hist->max) ? ipc_stats_bucket_limit(i) : hist->max;
+        }
+    }
+
+    return hist->max;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Stats_Init
+********************************************************************************
+* Summary:
+* Clears a stats block and writes it back so that other cores can record
+* into it.
+*
+* Parameters:
+*  stats: Stats block of the sending core.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Stats_Init(cy_stc_ipc_stats_t *stats)
+{
+    uint32_t i;
+    uint32_t j;
+
+    for (i = 0UL; i < CY_IPC_STATS_STAGE_COUNT; i++)
+    {
+        stats->stage[i].count = 0UL;
+        stats->stage[i].min = UINT32_MAX;
+        stats->stage[i].max = 0UL;
+        for (j = 0UL; j < CY_IPC_STATS_BUCKETS; j++)
+        {
+            stats->stage[i].bucket[j] = 0UL;
+        }
+    }
+    Cy_IPC_Port_CleanDCache(stats, sizeof(*stats));
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Stats_Record
+********************************************************************************
+* Summary:
+* Adds a sample to a stage. Each stage must be recorded by one core and one
+* context only.
+*
+* Parameters:
+*  stats: Stats block.
+*  stage: Stage the sample belongs to.
+*  ticks: Duration in IPC_STATS_CLOCK() ticks.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Stats_Record(cy_stc_ipc_stats_t *stats, cy_en_ipc_stats_stage_t stage, uint32_t ticks)
+{
+    cy_stc_ipc_stats_hist_t *hist = &stats->stage[stage];
+    uint32_t bucket = ipc_stats_bucket(ticks);
+
+    hist->count++;
+    if (ticks < hist->min)
+    {
+        hist->min = ticks;
+    }
+    if (ticks > hist->max)
+    {
+        hist->max = ticks;
+    }
+    hist->bucket[bucket]++;
+
+    /* Write back only the lines touched, the block is read by other cores */
+    Cy_IPC_Port_CleanDCache(&hist->count, 3UL * sizeof(uint32_t));
+    Cy_IPC_Port_CleanDCache(&hist->bucket[bucket], sizeof(uint32_t));
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Stats_Received
+********************************************************************************
+* Summary:
+* Records the NOTIFY and ISR stages of a received message into the stats
+* block of its sender. Messages without a stats block are ignored.
+*
+* Parameters:
+*  msgData: Received message, with a stamp after the header.
+*  isrEntry: IPC_STATS_CLOCK() at entry of the pipe ISR.
+*  now: IPC_STATS_CLOCK() at entry of the handler.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Stats_Received(const uint32_t *msgData, uint32_t isrEntry, uint32_t now)
+{
+    const ipc_stats_msg_t *msg = (const ipc_stats_msg_t *)msgData;
+
+    if (NULL != msg->stamp.stats)
+    {
+        Cy_IPC_Stats_Record(msg->stamp.stats, CY_IPC_STATS_STAGE_NOTIFY, isrEntry - msg->stamp.sent);
+        Cy_IPC_Stats_Record(msg->stamp.stats, CY_IPC_STATS_STAGE_ISR, now - isrEntry);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Stats_GetSummary
+********************************************************************************
+* Summary:
+* Computes count, min, p50, p99 and max of a stage. Can be called from any
+* core while samples are recorded; the result may then mix samples from
+* before and after the call.
+*
+* Parameters:
+*  stats: Stats block.
+*  stage: Stage to summarize.
+*  summary: Receives the summary, in IPC_STATS_CLOCK() ticks.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Stats_GetSummary(const cy_stc_ipc_stats_t *stats, cy_en_ipc_stats_stage_t stage, cy_stc_ipc_stats_summary_t *summary)
+{
+    const cy_stc_ipc_stats_hist_t *hist = &stats->stage[stage];
+
+    /* Writers write back after every sample, no line of this core is dirty */
+    Cy_IPC_Port_InvalidateDCache(hist, sizeof(*hist));
+
+    summary->count = hist->count;
+    if (0UL == summary->count)
+    {
+        summary->min = 0UL;
+        summary->p50 = 0UL;
+        summary->p99 = 0UL;
+        summary->max = 0UL;
+        return;
+    }
+
+    summary->min = hist->min;
+    summary->max = hist->max;
+    summary->p50 = ipc_stats_percentile(hist, summary->count, 500UL);
+    summary->p99 = ipc_stats_percentile(hist, summary->count, 990UL);
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Stats_Clock
+********************************************************************************
+* Summary:
+* Reads the shared timestamp counter: the TCPWM counter on the target,
+* nanoseconds on the host.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  Free-running 32-bit timestamp.
+*
+*******************************************************************************/
+uint32_t Cy_IPC_Stats_Clock(void)
+{
+#if defined(IPC_HOST_BUILD)
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec);
+#else
+    return Cy_TCPWM_Counter_GetCounter(IPC_STATS_TCPWM, IPC_STATS_TCPWM_NUM);
+#endif
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Stats_StartClock
+********************************************************************************
+* Summary:
+* Starts the shared timestamp counter. Called once by CM0+ before the CM7
+* cores are enabled. No operation on the host.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Stats_StartClock(void)
+{
+#if !defined(IPC_HOST_BUILD)
+    static const cy_stc_tcpwm_counter_config_t counterConfig =
+    {
+        .period = UINT32_MAX,
+        .clockPrescaler = CY_TCPWM_COUNTER_PRESCALER_DIVBY_1,
+        .runMode = CY_TCPWM_COUNTER_CONTINUOUS,
+        .countDirection = CY_TCPWM_COUNTER_COUNT_UP,
+        .compareOrCapture = CY_TCPWM_COUNTER_MODE_CAPTURE,
+        .countInputMode = CY_TCPWM_INPUT_LEVEL,
+        .countInput = CY_TCPWM_INPUT_1,
+    };
+
+    if (CY_TCPWM_SUCCESS == Cy_TCPWM_Counter_Init(IPC_STATS_TCPWM, IPC_STATS_TCPWM_NUM, &counterConfig))
+    {
+        Cy_TCPWM_Counter_Enable(IPC_STATS_TCPWM, IPC_STATS_TCPWM_NUM);
+        Cy_TCPWM_TriggerStart_Single(IPC_STATS_TCPWM, IPC_STATS_TCPWM_NUM);
+    }
+#endif /* !IPC_HOST_BUILD */
+}
+
+/* [] END OF FILE */
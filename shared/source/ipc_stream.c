@@ -0,0 +1,343 @@
+/******************************************************************************
+* File Name:   ipc_stream.c
+*
+* Description: Streaming channel for continuous sample data between two
+*              cores. Block n goes to buffer n modulo the buffer count; the
+*              producer commits a block while a buffer stays free for the
+*              next one and drops it otherwise, the consumer releases the
+*              blocks in order.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "ipc_stream.h"
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+/* Producer line: from filled up to the consumer line */
+#define IPC_STREAM_PRODUCER_LINE_SIZE   (offsetof(cy_stc_ipc_stream_t, consumed) - \
+                                         offsetof(cy_stc_ipc_stream_t, filled))
+
+/* Consumer line: from consumed to the end */
+#define IPC_STREAM_CONSUMER_LINE_SIZE   (sizeof(cy_stc_ipc_stream_t) - \
+                                         offsetof(cy_stc_ipc_stream_t, consumed))
+
+
+/*******************************************************************************
+* Function Name: ipc_stream_buffer
+********************************************************************************
+* Summary:
+* Returns the buffer that holds block n.
+*
+*******************************************************************************/
+static inline uint8_t *ipc_stream_buffer(const cy_stc_ipc_stream_t *stream, uint32_t n)
+{
+    return &stream->buffers[(n & stream->mask) * stream->blockSize];
+}
+
+/*******************************************************************************
+* Function Name: ipc_stream_publish_line
+********************************************************************************
+* Summary:
+* Writes back the producer line for the consumer.
+*
+*******************************************************************************/
+static inline void ipc_stream_publish_line(cy_stc_ipc_stream_t *stream)
+{
+    Cy_IPC_Port_CleanDCache(&stream->filled, IPC_STREAM_PRODUCER_LINE_SIZE);
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Stream_Init
+********************************************************************************
+* Summary:
+* Initializes an empty stream. Must be called by the producer before the
+* consumer learns the stream. Size the blocks with
+* CY_IPC_STREAM_BLOCK_SIZE() from the sustained rate and the block period
+* the consumer can keep up with.
+*
+* Parameters:
+*  stream: Stream control block.
+*  buffers: CY_IPC_STREAM_STORAGE_SIZE(blockSize, count) bytes, cache line
+*           aligned.
+*  blockSize: Bytes per buffer, a multiple of the cache line.
+*  count: Buffers, a power of two from 2 (ping-pong) to
+*         CY_IPC_STREAM_MAX_BUFFERS.
+*  bytesPerSecond: Sustained rate of the stream.
+*  notifyMask: IPC interrupt mask the producer raises after every committed
+*              block, 0 for a consumer that polls.
+*
+* Return:
+*  CY_IPC_STREAM_SUCCESS, or CY_IPC_STREAM_ERROR_BAD_PARAM
+*
+*******************************************************************************/
+cy_en_ipc_stream_status_t Cy_IPC_Stream_Init(cy_stc_ipc_stream_t *stream, void *buffers, uint32_t blockSize,
+                                             uint32_t count, uint32_t bytesPerSecond, uint32_t notifyMask)
+{
+    if ((NULL == stream) || (NULL == buffers) || (0UL == blockSize) || (0UL == bytesPerSecond) ||
+        (0UL != (blockSize & (IPC_PORT_CACHE_LINE - 1UL))) ||
+        (0UL != ((uintptr_t)buffers & (IPC_PORT_CACHE_LINE - 1UL))) ||
+        (count < 2UL) || (count > CY_IPC_STREAM_MAX_BUFFERS) || (0UL != (count & (count - 1UL))))
+    {
+        return CY_IPC_STREAM_ERROR_BAD_PARAM;
+    }
+
+    stream->buffers = (uint8_t *)buffers;
+    stream->blockSize = blockSize;
+    stream->mask = count - 1UL;
+    stream->bytesPerSecond = bytesPerSecond;
+    stream->notifyMask = notifyMask;
+
+    IPC_PORT_STORE_RELAXED(&stream->filled, 0UL);
+    stream->seq = 0UL;
+    stream->overruns = 0UL;
+
+    IPC_PORT_STORE_RELAXED(&stream->consumed, 0UL);
+    stream->underruns = 0UL;
+    stream->next = 0UL;
+    stream->lost = 0UL;
+
+    Cy_IPC_Port_CleanDCache(stream, sizeof(*stream));
+
+    return CY_IPC_STREAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Stream_PeriodUs
+********************************************************************************
+* Summary:
+* Returns the time a full block takes at the sustained rate. The producer
+* commits a block this often; with two buffers the consumer must release
+* each block within it, with N buffers it may fall behind by N - 2 blocks
+* for a while.
+*
+* Parameters:
+*  stream: Stream.
+*
+* Return:
+*  Block period in us
+*
+*******************************************************************************/
+uint32_t Cy_IPC_Stream_PeriodUs(cy_stc_ipc_stream_t const *stream)
+{
+    return (uint32_t)(((uint64_t)stream->blockSize * 1000000ULL) / stream->bytesPerSecond);
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Stream_Fill
+********************************************************************************
+* Summary:
+* Returns the buffer of the block being filled. It belongs to the producer
+* until Cy_IPC_Stream_Commit() succeeds; after an overrun the same buffer
+* is returned again.
+*
+* Parameters:
+*  stream: Stream, called by its producer only.
+*
+* Return:
+*  Buffer of blockSize bytes
+*
+*******************************************************************************/
+void *Cy_IPC_Stream_Fill(cy_stc_ipc_stream_t *stream)
+{
+    return ipc_stream_buffer(stream, IPC_PORT_LOAD_RELAXED(&stream->filled));
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Stream_Commit
+********************************************************************************
+* Summary:
+* Hands the filled buffer to the consumer. The producer must keep a free
+* buffer for the next block, so if the consumer still holds all others the
+* block is dropped instead: the overrun is counted, and the block number
+* advances anyway so that the consumer sees the gap. The newest block is
+* the one dropped, since every older one may be in use by the consumer.
+* On success the caller rings the doorbell, with one IPC notify event on
+* the returned mask.
+*
+* Parameters:
+*  stream: Stream, called by its producer only.
+*  length: Bytes written to the buffer, at most blockSize.
+*  notifyMask: Receives the IPC interrupt mask of the consumer, 0 if the
+*              block was dropped. Can be NULL.
+*
+* Return:
+*  CY_IPC_STREAM_SUCCESS, CY_IPC_STREAM_OVERRUN or
+*  CY_IPC_STREAM_ERROR_BAD_PARAM
+*
+*******************************************************************************/
+cy_en_ipc_stream_status_t Cy_IPC_Stream_Commit(cy_stc_ipc_stream_t *stream, uint32_t length, uint32_t *notifyMask)
+{
+    uint32_t filled = IPC_PORT_LOAD_RELAXED(&stream->filled);
+    cy_stc_ipc_stream_block_t *block;
+
+    if (NULL != notifyMask)
+    {
+        *notifyMask = 0UL;
+    }
+    if (length > stream->blockSize)
+    {
+        return CY_IPC_STREAM_ERROR_BAD_PARAM;
+    }
+
+    Cy_IPC_Port_InvalidateDCache(&stream->consumed, sizeof(stream->consumed));
+    if ((filled + 1UL - IPC_PORT_LOAD_ACQUIRE(&stream->consumed)) > stream->mask)
+    {
+        stream->seq++;
+        stream->overruns++;
+        ipc_stream_publish_line(stream);
+        return CY_IPC_STREAM_OVERRUN;
+    }
+
+    block = &stream->block[filled & stream->mask];
+    block->seq = stream->seq;
+    block->length = length;
+    stream->seq++;
+    Cy_IPC_Port_CleanDCache(ipc_stream_buffer(stream, filled), length);
+
+    IPC_PORT_STORE_RELEASE(&stream->filled, filled + 1UL);
+    ipc_stream_publish_line(stream);
+
+    if (NULL != notifyMask)
+    {
+        *notifyMask = stream->notifyMask;
+    }
+
+    return CY_IPC_STREAM_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Stream_Pending
+********************************************************************************
+* Summary:
+* Returns the committed blocks the consumer has not released, without
+* counting an underrun. A consumer woken by the doorbell drains this many.
+*
+* Parameters:
+*  stream: Stream, called by its consumer.
+*
+* Return:
+*  Blocks ready, the one acquired included
+*
+*******************************************************************************/
+uint32_t Cy_IPC_Stream_Pending(cy_stc_ipc_stream_t *stream)
+{
+    Cy_IPC_Port_InvalidateDCache(&stream->filled, sizeof(stream->filled));
+
+    return IPC_PORT_LOAD_ACQUIRE(&stream->filled) - IPC_PORT_LOAD_RELAXED(&stream->consumed);
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Stream_Acquire
+********************************************************************************
+* Summary:
+* Returns the oldest block the consumer has not released, in place. It
+* stays valid until Cy_IPC_Stream_Release(); acquiring again before that
+* returns the same one. Call it when a block is due: finding none counts
+* as an underrun. Use Cy_IPC_Stream_Pending() to look without counting.
+*
+* Parameters:
+*  stream: Stream, called by its consumer only.
+*  length: Receives the bytes of the block. Can be NULL.
+*  seq: Receives the block number. Can be NULL.
+*
+* Return:
+*  Block, or NULL on an underrun
+*
+*******************************************************************************/
+const void *Cy_IPC_Stream_Acquire(cy_stc_ipc_stream_t *stream, uint32_t *length, uint32_t *seq)
+{
+    uint32_t consumed = IPC_PORT_LOAD_RELAXED(&stream->consumed);
+    const cy_stc_ipc_stream_block_t *block;
+    uint8_t *buffer;
+
+    Cy_IPC_Port_InvalidateDCache(&stream->filled, IPC_STREAM_PRODUCER_LINE_SIZE);
+    if (IPC_PORT_LOAD_ACQUIRE(&stream->filled) == consumed)
+    {
+        stream->underruns++;
+        Cy_IPC_Port_CleanDCache(&stream->consumed, IPC_STREAM_CONSUMER_LINE_SIZE);
+        return NULL;
+    }
+
+    block = &stream->block[consumed & stream->mask];
+    buffer = ipc_stream_buffer(stream, consumed);
+    Cy_IPC_Port_InvalidateDCache(buffer, block->length);
+    if (NULL != length)
+    {
+        *length = block->length;
+    }
+    if (NULL != seq)
+    {
+        *seq = block->seq;
+    }
+
+    return buffer;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Stream_Release
+********************************************************************************
+* Summary:
+* Returns the acquired block's buffer to the producer, and counts the
+* blocks dropped before it.
+*
+* Parameters:
+*  stream: Stream, called by its consumer only.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Stream_Release(cy_stc_ipc_stream_t *stream)
+{
+    uint32_t consumed = IPC_PORT_LOAD_RELAXED(&stream->consumed);
+    uint32_t seq;
+
+    if (IPC_PORT_LOAD_RELAXED(&stream->filled) == consumed)
+    {
+        return;
+    }
+
+    seq = stream->block[consumed & stream->mask].seq;
+    stream->lost += seq - stream->next;
+    stream->next = seq + 1UL;
+
+    IPC_PORT_STORE_RELEASE(&stream->consumed, consumed + 1UL);
+    Cy_IPC_Port_CleanDCache(&stream->consumed, IPC_STREAM_CONSUMER_LINE_SIZE);
+}
+
+/* [] END OF FILE */
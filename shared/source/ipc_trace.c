@@ -0,0 +1,200 @@
+/******************************************************************************
+* File Name:   ipc_trace.c
+*
+* Description: Binary event trace of the IPC path: ring setup and dump. The
+*              hooks themselves are inline in ipc_trace.h.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "ipc_trace.h"
+
+#if defined(IPC_HOST_BUILD)
+#include <stdio.h>
+#include <stdlib.h>
+#endif
+
+#if defined(IPC_HOST_BUILD)
+/* Ring saved when the host program exits */
+static const cy_stc_ipc_trace_t *ipcTraceAtExit;
+#endif
+
+
+#if defined(IPC_HOST_BUILD)
+/*******************************************************************************
+* Function Name: ipc_trace_write_file
+********************************************************************************
+* Summary:
+* Byte sink of Cy_IPC_Trace_Dump() writing to a stdio file.
+*
+*******************************************************************************/
+static bool ipc_trace_write_file(const void *data, uint32_t size, void *context)
+{
+    return (1U == fwrite(data, size, 1U, (FILE *)context));
+}
+
+/*******************************************************************************
+* Function Name: ipc_trace_save_at_exit
+********************************************************************************
+* Summary:
+* Saves the ring of this image when the host program exits.
+*
+*******************************************************************************/
+static void ipc_trace_save_at_exit(void)
+{
+    Cy_IPC_Trace_Save(ipcTraceAtExit);
+}
+#endif /* IPC_HOST_BUILD */
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Trace_Init
+********************************************************************************
+* Summary:
+* Clears the ring of a core and writes it back, so that it can be read from
+* another core or by a debugger. On the host the ring is also saved with
+* Cy_IPC_Trace_Save() when the program exits.
+*
+* Parameters:
+*  trace: Ring to initialize.
+*  core: Core that owns the ring, cy_en_ipc_core_t.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Trace_Init(cy_stc_ipc_trace_t *trace, uint32_t core)
+{
+    uint32_t i;
+
+    trace->hdr.magic = CY_IPC_TRACE_MAGIC;
+    trace->hdr.version = CY_IPC_TRACE_VERSION;
+    trace->hdr.recordSize = (uint16_t)sizeof(cy_stc_ipc_trace_rec_t);
+    trace->hdr.depth = CY_IPC_TRACE_DEPTH;
+    trace->hdr.core = core;
+    trace->hdr.clockHz = IPC_TRACE_CLOCK_HZ;
+    trace->hdr.reserved[0] = 0UL;
+    trace->hdr.reserved[1] = 0UL;
+    for (i = 0UL; i < CY_IPC_TRACE_DEPTH; i++)
+    {
+        trace->rec[i].time = 0UL;
+        trace->rec[i].event = (uint8_t)CY_IPC_TRACE_EVENT_COUNT;
+        trace->rec[i].core = (uint8_t)core;
+        trace->rec[i].ep = 0U;
+        trace->rec[i].client = (uint8_t)CY_IPC_TRACE_NO_CLIENT;
+        trace->rec[i].msg = 0UL;
+        trace->rec[i].arg = 0UL;
+    }
+    IPC_PORT_STORE_RELEASE(&trace->hdr.head, 0UL);
+    Cy_IPC_Port_CleanDCache(trace, sizeof(*trace));
+
+#if defined(IPC_HOST_BUILD)
+    if (NULL == ipcTraceAtExit)
+    {
+        ipcTraceAtExit = trace;
+        (void)atexit(&ipc_trace_save_at_exit);
+    }
+#endif /* IPC_HOST_BUILD */
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Trace_Dump
+********************************************************************************
+* Summary:
+* Writes the ring through a byte sink: the header, then all CY_IPC_TRACE_DEPTH
+* records in ring order. This is the memory image of the ring, so a
+* debugger can save the same file directly. Records written during the dump
+* may be torn; dump from the owning core with interrupts masked, or after
+* it stopped, for an exact copy.
+*
+* Parameters:
+*  trace: Ring to dump.
+*  write: Byte sink, e.g. a UART or a file.
+*  context: Passed to the sink.
+*
+* Return:
+*  Records in the dump that hold an event, 0 if the sink failed.
+*
+*******************************************************************************/
+uint32_t Cy_IPC_Trace_Dump(const cy_stc_ipc_trace_t *trace, cy_ipc_trace_write_t write, void *context)
+{
+    uint32_t head = IPC_PORT_LOAD_ACQUIRE(&trace->hdr.head);
+
+    if (!write(&trace->hdr, sizeof(trace->hdr), context) ||
+        !write(trace->rec, sizeof(trace->rec), context))
+    {
+        return 0UL;
+    }
+
+    return (head < CY_IPC_TRACE_DEPTH) ? head : CY_IPC_TRACE_DEPTH;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Trace_Save
+********************************************************************************
+* Summary:
+* Makes the ring available after a failure, called from handle_error(). On
+* the target it writes the ring back from the D-cache, so that a debugger
+* or another core reads the latest records from memory. On the host it
+* dumps the ring to ipc_trace_<core>.bin in the directory named by the
+* IPC_TRACE_DIR environment variable, or the working directory.
+*
+* Parameters:
+*  trace: Ring of the calling core.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Trace_Save(const cy_stc_ipc_trace_t *trace)
+{
+#if defined(IPC_HOST_BUILD)
+    const char *dir = getenv("IPC_TRACE_DIR");
+    char path[256];
+    FILE *file;
+
+    (void)snprintf(path, sizeof(path), "%s/ipc_trace_%u.bin", (NULL != dir) ? dir : ".", (unsigned int)trace->hdr.core);
+    file = fopen(path, "wb");
+    if (NULL != file)
+    {
+        (void)Cy_IPC_Trace_Dump(trace, &ipc_trace_write_file, file);
+        (void)fclose(file);
+    }
+#else
+    Cy_IPC_Port_CleanDCache(trace, sizeof(*trace));
+#endif /* IPC_HOST_BUILD */
+}
+
+/* [] END OF FILE */
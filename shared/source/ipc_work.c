@@ -0,0 +1,490 @@
+/******************************************************************************
+* File Name:   ipc_work.c
+*
+* Description: Work-stealing task queue for offloading jobs to the CM7
+*              cores. Jobs are taken from the top of a deque with a
+*              compare-exchange, by its owner in submission order and by
+*              idle workers as steals; the owner pushes at the bottom.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2025, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "ipc_work.h"
+
+/*******************************************************************************
+* Constants
+*******************************************************************************/
+#define IPC_WORK_MASK                   (CY_IPC_WORK_DEPTH - 1UL)
+
+IPC_PORT_STATIC_ASSERT(0UL == (CY_IPC_WORK_DEPTH & IPC_WORK_MASK), "CY_IPC_WORK_DEPTH must be a power of two");
+
+
+/*******************************************************************************
+* Function Name: ipc_work_count
+********************************************************************************
+* Summary:
+* Returns the jobs in a deque. A snapshot, for any core.
+*
+*******************************************************************************/
+static inline uint32_t ipc_work_count(cy_stc_ipc_work_deque_t *deque)
+{
+    uint32_t top = IPC_PORT_LOAD_ACQUIRE(&deque->top);
+    int32_t count = (int32_t)(IPC_PORT_LOAD_ACQUIRE(&deque->bottom) - top);
+
+    return (count > 0) ? (uint32_t)count : 0UL;
+}
+
+/*******************************************************************************
+* Function Name: ipc_work_push
+********************************************************************************
+* Summary:
+* Copies a job to the bottom of a deque. Owner only.
+*
+*******************************************************************************/
+static cy_en_ipc_work_status_t ipc_work_push(cy_stc_ipc_work_deque_t *deque, const cy_stc_ipc_work_job_t *job)
+{
+    uint32_t bottom = IPC_PORT_LOAD_RELAXED(&deque->bottom);
+
+    if ((bottom - IPC_PORT_LOAD_ACQUIRE(&deque->top)) >= CY_IPC_WORK_DEPTH)
+    {
+        return CY_IPC_WORK_ERROR_FULL;
+    }
+
+    deque->job[bottom & IPC_WORK_MASK] = *job;
+    IPC_PORT_STORE_RELEASE(&deque->bottom, bottom + 1UL);
+
+    return CY_IPC_WORK_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: ipc_work_take
+********************************************************************************
+* Summary:
+* Takes the job at the top of a deque, for the owner and thieves alike. The
+* copy is kept only if the compare-exchange claims it: a slot the owner may
+* have refilled lies below a top that has moved on, so the claim fails. A
+* lost claim means another worker got the job; the next one is tried.
+*
+*******************************************************************************/
+static cy_en_ipc_work_status_t ipc_work_take(cy_stc_ipc_work_deque_t *deque, cy_stc_ipc_work_job_t *job)
+{
+    uint32_t top = IPC_PORT_LOAD_ACQUIRE(&deque->top);
+
+    while ((int32_t)(IPC_PORT_LOAD_ACQUIRE(&deque->bottom) - top) > 0)
+    {
+        *job = deque->job[top & IPC_WORK_MASK];
+        if (Cy_IPC_Port_CompareExchange(&deque->top, &top, top + 1UL))
+        {
+            return CY_IPC_WORK_SUCCESS;
+        }
+    }
+
+    return CY_IPC_WORK_EMPTY;
+}
+
+/*******************************************************************************
+* Function Name: ipc_work_wake
+********************************************************************************
+* Summary:
+* Returns the doorbells of the workers other than self that are out of
+* work. The caller has just queued a job, the full fence orders that
+* against the idle flags, which the workers set before they look for work
+* a last time.
+*
+*******************************************************************************/
+static uint32_t ipc_work_wake(cy_stc_ipc_work_t *work, uint32_t self)
+{
+    uint32_t notifyMask = 0UL;
+    uint32_t i;
+
+    IPC_PORT_FENCE_FULL();
+    for (i = 0UL; i < work->workers; i++)
+    {
+        if ((i != self) && (0UL != IPC_PORT_LOAD_RELAXED(&work->deque[i].idle)))
+        {
+            notifyMask |= work->deque[i].notifyMask;
+        }
+    }
+
+    return notifyMask;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Work_Init
+********************************************************************************
+* Summary:
+* Initializes an empty queue. Must be called before any core learns the
+* queue, by any core.
+*
+* Parameters:
+*  work: Queue.
+*  workers: Worker cores, 1 .. CY_IPC_WORK_MAX_WORKERS.
+*  notifyMask: Per worker, the IPC interrupt mask that wakes it.
+*
+* Return:
+*  CY_IPC_WORK_SUCCESS, or CY_IPC_WORK_ERROR_BAD_PARAM
+*
+*******************************************************************************/
+cy_en_ipc_work_status_t Cy_IPC_Work_Init(cy_stc_ipc_work_t *work, uint32_t workers, const uint32_t notifyMask[])
+{
+    cy_stc_ipc_work_deque_t *deque;
+    uint32_t i;
+
+    if ((NULL == work) || (NULL == notifyMask) || (0UL == workers) || (workers > CY_IPC_WORK_MAX_WORKERS))
+    {
+        return CY_IPC_WORK_ERROR_BAD_PARAM;
+    }
+
+    work->workers = workers;
+    for (i = 0UL; i < workers; i++)
+    {
+        deque = &work->deque[i];
+        IPC_PORT_STORE_RELAXED(&deque->top, 0UL);
+        IPC_PORT_STORE_RELAXED(&deque->bottom, 0UL);
+        IPC_PORT_STORE_RELAXED(&deque->idle, 0UL);
+        deque->notifyMask = notifyMask[i];
+        deque->executed = 0UL;
+        deque->stolen = 0UL;
+        deque->sleeps = 0UL;
+        deque->rung = 0UL;
+        (void)Cy_IPC_Ring_Init(&deque->inbox, deque->inboxBuf, sizeof(cy_stc_ipc_work_job_t), CY_IPC_WORK_DEPTH);
+    }
+
+    return CY_IPC_WORK_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Work_InitWorker
+********************************************************************************
+* Summary:
+* Attaches the calling core to a queue as a worker.
+*
+* Parameters:
+*  worker: Worker context.
+*  work: Queue.
+*  index: Deque of the worker, below the workers of the queue.
+*  methods: Methods of the jobs, indexed by cy_stc_ipc_work_job_t.method.
+*  methodCount: Entries in methods.
+*
+* Return:
+*  CY_IPC_WORK_SUCCESS, or CY_IPC_WORK_ERROR_BAD_PARAM
+*
+*******************************************************************************/
+cy_en_ipc_work_status_t Cy_IPC_Work_InitWorker(cy_stc_ipc_work_worker_t *worker, cy_stc_ipc_work_t *work, uint32_t index,
+                                               const cy_ipc_work_method_t *methods, uint32_t methodCount)
+{
+    if ((NULL == worker) || (NULL == work) || (index >= work->workers) || ((NULL == methods) && (0UL != methodCount)))
+    {
+        return CY_IPC_WORK_ERROR_BAD_PARAM;
+    }
+
+    worker->work = work;
+    worker->index = index;
+    worker->methods = methods;
+    worker->methodCount = methodCount;
+    worker->victim = (index + 1UL) % work->workers;
+
+    return CY_IPC_WORK_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Work_Submit
+********************************************************************************
+* Summary:
+* Submits a job from a worker core to its own deque, where an idle worker
+* can steal it. Not from an interrupt that may preempt Cy_IPC_Work_Run()
+* on the same core.
+*
+* Parameters:
+*  worker: Worker context of the calling core.
+*  job: Job, copied.
+*  notifyMask: Receives the doorbells of the idle workers to ring, 0 for
+*              none.
+*
+* Return:
+*  CY_IPC_WORK_SUCCESS, CY_IPC_WORK_ERROR_FULL or CY_IPC_WORK_ERROR_BAD_PARAM
+*
+*******************************************************************************/
+cy_en_ipc_work_status_t Cy_IPC_Work_Submit(cy_stc_ipc_work_worker_t *worker, const cy_stc_ipc_work_job_t *job,
+                                           uint32_t *notifyMask)
+{
+    cy_stc_ipc_work_deque_t *own;
+    cy_en_ipc_work_status_t status;
+
+    *notifyMask = 0UL;
+    if ((NULL == worker) || (NULL == job))
+    {
+        return CY_IPC_WORK_ERROR_BAD_PARAM;
+    }
+
+    own = &worker->work->deque[worker->index];
+    status = ipc_work_push(own, job);
+    if (CY_IPC_WORK_SUCCESS == status)
+    {
+        *notifyMask = ipc_work_wake(worker->work, worker->index);
+        own->rung += (0UL != *notifyMask) ? 1UL : 0UL;
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Work_SubmitRemote
+********************************************************************************
+* Summary:
+* Submits a job from a core that is not a worker, such as the CM0+, which
+* has no exclusive access. The job goes to the inbox of the target worker,
+* or for any worker to the inbox of an idle one, or else of the one with
+* the fewest jobs queued. The worker moves it to its deque, where the
+* others can steal it. Each inbox is a single-producer ring, so only one
+* core may submit this way, from one context at a time.
+*
+* Parameters:
+*  work: Queue.
+*  target: Worker, or CY_IPC_WORK_ANY_WORKER.
+*  job: Job, copied.
+*  notifyMask: Receives the doorbell of the worker to ring, 0 if it is
+*              awake.
+*
+* Return:
+*  CY_IPC_WORK_SUCCESS, CY_IPC_WORK_ERROR_FULL if the inbox of the target,
+*  or every inbox, is full, or CY_IPC_WORK_ERROR_BAD_PARAM
+*
+*******************************************************************************/
+cy_en_ipc_work_status_t Cy_IPC_Work_SubmitRemote(cy_stc_ipc_work_t *work, uint32_t target,
+                                                 const cy_stc_ipc_work_job_t *job, uint32_t *notifyMask)
+{
+    cy_stc_ipc_work_deque_t *deque;
+    uint32_t tries = 1UL;
+    uint32_t least = UINT32_MAX;
+    uint32_t queued;
+    uint32_t i;
+
+    *notifyMask = 0UL;
+    if ((NULL == work) || (NULL == job) || ((CY_IPC_WORK_ANY_WORKER != target) && (target >= work->workers)))
+    {
+        return CY_IPC_WORK_ERROR_BAD_PARAM;
+    }
+
+    if (CY_IPC_WORK_ANY_WORKER == target)
+    {
+        tries = work->workers;
+        for (i = 0UL; i < work->workers; i++)
+        {
+            deque = &work->deque[i];
+            queued = (0UL != IPC_PORT_LOAD_RELAXED(&deque->idle)) ? 0UL :
+                     (1UL + ipc_work_count(deque) + Cy_IPC_Ring_Count(&deque->inbox));
+            if (queued < least)
+            {
+                least = queued;
+                target = i;
+            }
+        }
+    }
+
+    for (i = 0UL; i < tries; i++)
+    {
+        deque = &work->deque[(target + i) % work->workers];
+        if (CY_IPC_RING_SUCCESS == Cy_IPC_Ring_Push(&deque->inbox, job))
+        {
+            IPC_PORT_FENCE_FULL();
+            if (0UL != IPC_PORT_LOAD_RELAXED(&deque->idle))
+            {
+                *notifyMask = deque->notifyMask;
+            }
+            return CY_IPC_WORK_SUCCESS;
+        }
+    }
+
+    return CY_IPC_WORK_ERROR_FULL;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Work_Run
+********************************************************************************
+* Summary:
+* Runs one job on a worker. Moves the inbox into the deque first, so that
+* idle workers can steal from it, and rings them if jobs are left over.
+* Takes the oldest job of its own deque, or else steals the oldest job of
+* another worker, and runs its method. The caller sends the completion to
+* the submitting core through the pipe.
+*
+* Parameters:
+*  worker: Worker context of the calling core.
+*  done: Receives the completion.
+*  notifyMask: Receives the doorbells of the idle workers to ring, 0 for
+*              none.
+*
+* Return:
+*  CY_IPC_WORK_SUCCESS if a job was run, CY_IPC_WORK_EMPTY if none was
+*  found: call Cy_IPC_Work_Sleep() then.
+*
+*******************************************************************************/
+cy_en_ipc_work_status_t Cy_IPC_Work_Run(cy_stc_ipc_work_worker_t *worker, cy_stc_ipc_work_done_t *done,
+                                        uint32_t *notifyMask)
+{
+    cy_stc_ipc_work_t *work = worker->work;
+    cy_stc_ipc_work_deque_t *own = &work->deque[worker->index];
+    cy_en_ipc_work_status_t status;
+    cy_stc_ipc_work_job_t job;
+    bool stolen = false;
+    bool moved = false;
+    uint32_t i;
+
+    *notifyMask = 0UL;
+    IPC_PORT_STORE_RELAXED(&own->idle, 0UL);
+
+    while ((ipc_work_count(own) < CY_IPC_WORK_DEPTH) && (CY_IPC_RING_SUCCESS == Cy_IPC_Ring_Pop(&own->inbox, &job)))
+    {
+        (void)ipc_work_push(own, &job);
+        moved = true;
+    }
+    if (moved && (ipc_work_count(own) > 1UL))
+    {
+        *notifyMask = ipc_work_wake(work, worker->index);
+        own->rung += (0UL != *notifyMask) ? 1UL : 0UL;
+    }
+
+    status = ipc_work_take(own, &job);
+    for (i = 1UL; (CY_IPC_WORK_SUCCESS != status) && (i < work->workers); i++)
+    {
+        status = ipc_work_take(&work->deque[worker->victim], &job);
+        stolen = (CY_IPC_WORK_SUCCESS == status);
+        worker->victim = (worker->victim + 1UL) % work->workers;
+        if (worker->victim == worker->index)
+        {
+            worker->victim = (worker->victim + 1UL) % work->workers;
+        }
+    }
+    if (CY_IPC_WORK_SUCCESS != status)
+    {
+        return CY_IPC_WORK_EMPTY;
+    }
+
+    done->id = job.id;
+    done->method = job.method;
+    done->core = job.core;
+    done->worker = (uint8_t)worker->index;
+    done->stolen = stolen ? 1U : 0U;
+    done->reserved = 0U;
+    if (job.method < worker->methodCount)
+    {
+        done->result = worker->methods[job.method](job.arg);
+        done->status = (uint8_t)CY_IPC_WORK_SUCCESS;
+    }
+    else
+    {
+        done->result = 0UL;
+        done->status = (uint8_t)CY_IPC_WORK_ERROR_NO_METHOD;
+    }
+
+    own->executed++;
+    own->stolen += stolen ? 1UL : 0UL;
+
+    return CY_IPC_WORK_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Work_Sleep
+********************************************************************************
+* Summary:
+* Marks the worker idle and looks for work a last time: in its inbox and
+* in every deque. Returns true if there is none, and the worker may sleep
+* until its doorbell; a submitter that queues a job from now on sees the
+* flag and rings it. Call it with interrupts masked and sleep with WFI
+* before unmasking them, so a doorbell in between still wakes the core.
+* Cy_IPC_Work_Run() clears the flag.
+*
+* Parameters:
+*  worker: Worker context of the calling core.
+*
+* Return:
+*  true if the worker may sleep.
+*
+*******************************************************************************/
+bool Cy_IPC_Work_Sleep(cy_stc_ipc_work_worker_t *worker)
+{
+    cy_stc_ipc_work_t *work = worker->work;
+    cy_stc_ipc_work_deque_t *own = &work->deque[worker->index];
+    bool empty;
+    uint32_t i;
+
+    IPC_PORT_STORE_RELAXED(&own->idle, 1UL);
+    IPC_PORT_FENCE_FULL();
+
+    empty = (0UL == Cy_IPC_Ring_Count(&own->inbox));
+    for (i = 0UL; empty && (i < work->workers); i++)
+    {
+        empty = (0UL == ipc_work_count(&work->deque[i]));
+    }
+
+    if (!empty)
+    {
+        IPC_PORT_STORE_RELAXED(&own->idle, 0UL);
+        return false;
+    }
+
+    own->sleeps++;
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: Cy_IPC_Work_GetStats
+********************************************************************************
+* Summary:
+* Reads the counters of a worker, from any core.
+*
+* Parameters:
+*  work: Queue.
+*  index: Worker.
+*  stats: Receives the counters.
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Cy_IPC_Work_GetStats(cy_stc_ipc_work_t *work, uint32_t index, cy_stc_ipc_work_stats_t *stats)
+{
+    cy_stc_ipc_work_deque_t *deque = &work->deque[index];
+
+    stats->queued = ipc_work_count(deque) + Cy_IPC_Ring_Count(&deque->inbox);
+    stats->executed = deque->executed;
+    stats->stolen = deque->stolen;
+    stats->sleeps = deque->sleeps;
+    stats->rung = deque->rung;
+}
+
+/* [] END OF FILE */